@@ -111,6 +111,11 @@ typedef enum {
 #define ARE_LINK_MGMT_QUEUES_EMPTY(aQueues)	( (que_Size(aQueues[QUEUE_TYPE_MGMT] ) == 0)  &&  \
 											  (que_Size(aQueues[QUEUE_TYPE_EAPOL]) == 0) )
 
+/* Queueing delay statistics types: the 16 mgmt subtypes and all EAPOL-queue packets */
+#define NUM_OF_MGMT_SUBTYPES	16
+#define DELAY_TYPE_EAPOL_QUEUE	NUM_OF_MGMT_SUBTYPES
+#define NUM_OF_DELAY_TYPES		(NUM_OF_MGMT_SUBTYPES + 1)
+
 typedef struct {
 	TI_UINT32 aEnqueuePackets[NUM_OF_MGMT_QUEUES];
 	TI_UINT32 aDequeuePackets[NUM_OF_MGMT_QUEUES];
@@ -118,8 +123,30 @@ typedef struct {
 	TI_UINT32 aDroppedPackets[NUM_OF_MGMT_QUEUES];
 	TI_UINT32 aXmittedPackets[NUM_OF_MGMT_QUEUES];
 	TI_UINT32 uNoResourcesCount;
+	TI_UINT32 uProbeRspDupCount;	/* Duplicate probe responses dropped before enqueue */
+	TI_UINT32 aDelayPackets[NUM_OF_DELAY_TYPES];	/* Xmitted packets per delay type */
+	TI_UINT32 aDelaySumMs[NUM_OF_DELAY_TYPES];		/* Accumulated queueing delay (msec) per delay type */
+	TI_UINT32 aDelayMaxMs[NUM_OF_DELAY_TYPES];		/* Maximum queueing delay (msec) per delay type */
 } TDbgCount;
 
+/* Probe responses with identical DA and body, queued within this window, are dropped */
+#define PROBE_RSP_DEDUP_ENTRIES		8
+#define PROBE_RSP_DEDUP_WINDOW_MS	20
+/* Timestamp, beacon interval and capabilities precede the SSID element in the body */
+#define PROBE_RSP_FIXED_FIELDS_LEN	12
+/* The timestamp is filled by the FW, so it is not compared */
+#define PROBE_RSP_TIMESTAMP_LEN		8
+
+typedef struct {
+	TMacAddr  tDa;							/* The frame destination address */
+	TI_UINT8  aSsid[DOT11_SSID_MAX_LEN];	/* The SSID carried by the frame */
+	TI_UINT32 uSsidLen;						/* The SSID length */
+	TI_UINT32 uBodyLen;						/* The frame body length */
+	TI_UINT32 uBodyHash;					/* Hash of the frame body, excluding the timestamp */
+	TI_UINT32 uTimeMs;						/* The time the frame was queued */
+	TI_BOOL   bValid;						/* The entry holds a queued frame */
+} TProbeRspDedup;
+
 #define LINK_MGMT_QUEUES_DEPTH MGMT_QUEUES_DEPTH
 /* The LinkQ object. */
 typedef struct {
@@ -154,6 +181,9 @@ typedef struct {
 	TI_UINT32       uGlobalHlid;                       /* Generic link id */
 	TI_UINT32       uLastHlid;                         /* Last scheduler visited HLID */
 
+	TProbeRspDedup  aProbeRspDedup[PROBE_RSP_DEDUP_ENTRIES]; /* Recently queued probe responses */
+	TI_UINT32       uProbeRspDedupIdx;                 /* Next entry to replace in aProbeRspDedup */
+
 } TTxMgmtQ;
 
 /* The module internal functions */
@@ -164,6 +194,11 @@ static void updateLinksBusyMap (TTxMgmtQ *pTxMgmtQ, TI_UINT32 uLinkBitMap);
 static void updateQueuesBusyMap (TTxMgmtQ *pTxMgmtQ, TI_UINT32 tidBitMap);
 static void	txMgmtQ_DisableLink (TTxMgmtQ *pTxMgmtQ, TI_UINT32 uHlid);
 static void	txMgmtQ_EnableLink (TTxMgmtQ *pTxMgmtQ, TI_UINT32 uHlid);
+static TI_BOOL getProbeRspSsid (TTxCtrlBlk *pPktCtrlBlk, TI_UINT8 **pSsid, TI_UINT32 *pSsidLen);
+static TI_UINT32 getProbeRspBodyHash (TTxCtrlBlk *pPktCtrlBlk);
+static TI_BOOL isDuplicateProbeRsp (TTxMgmtQ *pTxMgmtQ, TTxCtrlBlk *pPktCtrlBlk, TI_UINT32 *pBodyHash);
+static void    saveProbeRsp (TTxMgmtQ *pTxMgmtQ, TTxCtrlBlk *pPktCtrlBlk, TI_UINT32 uBodyHash);
+static void    updateDelayStatistics (TMgmtLinkQ *pLinkQ, TTxCtrlBlk *pPktCtrlBlk, TI_UINT32 uQueId, TI_UINT32 uDelayMs);
 
 /*******************************************************************************
 *                       PUBLIC  FUNCTIONS  IMPLEMENTATION					   *
@@ -353,6 +388,8 @@ void txMgmtQ_ClearQueues (TI_HANDLE hTxMgmtQ)
  *   to the driver's context (after the packet is enqueued).
  * If the selected queue was empty before the packet insertion, the SM is called
  *   with QUEUES_NOT_EMPTY event (in case of external context, only after the context switch).
+ * A probe response with the same DA and body as one queued in the last
+ *   PROBE_RSP_DEDUP_WINDOW_MS is dropped (e.g. on probe-request retries).
  *
  * \note
  * \param  hTxMgmtQ         - The module's object
@@ -368,6 +405,7 @@ TI_STATUS txMgmtQ_Xmit (TI_HANDLE hTxMgmtQ, TTxCtrlBlk *pPktCtrlBlk, TI_BOOL bEx
 	TI_UINT32 uQueId;
 	TI_UINT32 uQueSize;
 	TI_UINT32 uHlid;
+	TI_UINT32 uBodyHash = 0;
 	TMgmtLinkQ *pLinkQ;
 
 	/* Find link id by destination MAC address, if not found use global link id */
@@ -399,6 +437,17 @@ TI_STATUS txMgmtQ_Xmit (TI_HANDLE hTxMgmtQ, TTxCtrlBlk *pPktCtrlBlk, TI_BOOL bEx
 	/* Enter critical section to protect queue access */
 	context_EnterCriticalSection (pTxMgmtQ->hContext);
 
+	/* Drop the packet if it is a duplicate of a recently queued probe response */
+	if ((uQueId == QUEUE_TYPE_MGMT) && isDuplicateProbeRsp (pTxMgmtQ, pPktCtrlBlk, &uBodyHash)) {
+		pLinkQ->tDbgCounters.aDroppedPackets[uQueId]++;
+		pLinkQ->tDbgCounters.uProbeRspDupCount++;
+		/* Leave critical section */
+		context_LeaveCriticalSection (pTxMgmtQ->hContext);
+
+		txCtrl_FreePacket (pTxMgmtQ->hTxCtrl, pPktCtrlBlk, TI_NOK);
+		return TI_NOK;
+	}
+
 	/* Check resources per LINK and per MGMT AC (VOICE)*/
 	if (txDataQ_AllocCheckResources( pTxMgmtQ->hTxDataQ, pPktCtrlBlk) != TI_OK) {
 		pLinkQ->tDbgCounters.aDroppedPackets[uQueId]++;
@@ -418,6 +467,11 @@ TI_STATUS txMgmtQ_Xmit (TI_HANDLE hTxMgmtQ, TTxCtrlBlk *pPktCtrlBlk, TI_BOOL bEx
 	/* Get number of packets in current queue */
 	uQueSize = que_Size (pLinkQ->aQueues[uQueId]);
 
+	/* Remember only probe responses that were actually queued */
+	if ((eStatus == TI_OK) && (uQueId == QUEUE_TYPE_MGMT)) {
+		saveProbeRsp (pTxMgmtQ, pPktCtrlBlk, uBodyHash);
+	}
+
 	/* Leave critical section */
 	context_LeaveCriticalSection (pTxMgmtQ->hContext);
 
@@ -451,6 +505,157 @@ TI_STATUS txMgmtQ_Xmit (TI_HANDLE hTxMgmtQ, TTxCtrlBlk *pPktCtrlBlk, TI_BOOL bEx
 }
 
 
+/**
+ * \fn     getProbeRspSsid
+ * \brief  Find the SSID of a probe response (static function)
+ *
+ * \param  pPktCtrlBlk - Pointer to the packet CtrlBlk
+ * \param  pSsid       - Returns a pointer to the SSID in the frame body
+ * \param  pSsidLen    - Returns the SSID length
+ * \return TI_TRUE if the packet is a probe response with a valid SSID element, TI_FALSE otherwise
+ * \sa     isDuplicateProbeRsp, saveProbeRsp
+ */
+static TI_BOOL getProbeRspSsid (TTxCtrlBlk *pPktCtrlBlk, TI_UINT8 **pSsid, TI_UINT32 *pSsidLen)
+{
+	dot11_header_t *pHdr = (dot11_header_t *)(pPktCtrlBlk->tTxnStruct.aBuf[0]);
+	TI_UINT8  *pBody = pPktCtrlBlk->tTxnStruct.aBuf[1];
+	TI_UINT32 uLen = pPktCtrlBlk->tTxnStruct.aLen[1];
+	TI_UINT8  *pIe = pBody + PROBE_RSP_FIXED_FIELDS_LEN;
+	TI_UINT16 uFc;
+
+	COPY_WLAN_WORD (&uFc, &pHdr->fc);
+	if ((uFc & DOT11_FC_TYPESUBTYPE_MASK) != DOT11_FC_PROBE_RESP) {
+		return TI_FALSE;
+	}
+
+	/* The SSID is always the first element, check it is fully contained in the body */
+	if ((uLen < PROBE_RSP_FIXED_FIELDS_LEN + 2) ||
+	        (pIe[0] != DOT11_SSID_ELE_ID) ||
+	        (pIe[1] > DOT11_SSID_MAX_LEN) ||
+	        (uLen < PROBE_RSP_FIXED_FIELDS_LEN + 2 + pIe[1])) {
+		return TI_FALSE;
+	}
+
+	*pSsid    = &pIe[2];
+	*pSsidLen = pIe[1];
+
+	return TI_TRUE;
+}
+
+
+/**
+ * \fn     getProbeRspBodyHash
+ * \brief  Hash a probe response body (static function)
+ *
+ * Compute an FNV-1a hash of the frame body, excluding the timestamp that is filled by the FW.
+ * Any change in the response content (e.g. capabilities, new IEs or a channel switch
+ *   announcement) changes the hash, so the response is not taken as a duplicate.
+ *
+ * \note   The body must be at least PROBE_RSP_FIXED_FIELDS_LEN long (see getProbeRspSsid).
+ * \param  pPktCtrlBlk - Pointer to the packet CtrlBlk
+ * \return The body hash
+ * \sa     isDuplicateProbeRsp
+ */
+static TI_UINT32 getProbeRspBodyHash (TTxCtrlBlk *pPktCtrlBlk)
+{
+	TI_UINT8  *pBody = pPktCtrlBlk->tTxnStruct.aBuf[1];
+	TI_UINT32 uLen = pPktCtrlBlk->tTxnStruct.aLen[1];
+	TI_UINT32 uHash = 2166136261u;
+	TI_UINT32 i;
+
+	for (i = PROBE_RSP_TIMESTAMP_LEN; i < uLen; i++) {
+		uHash ^= pBody[i];
+		uHash *= 16777619u;
+	}
+
+	return uHash;
+}
+
+
+/**
+ * \fn     isDuplicateProbeRsp
+ * \brief  Check if a probe response duplicates a recently queued one (static function)
+ *
+ * Look up the DA, SSID and body of a probe response in the table of recently queued
+ *   probe responses. The body is compared by its length and hash.
+ *   The table is updated by saveProbeRsp once the frame is queued.
+ *
+ * \note   Called within the critical section, since packets are queued from external context.
+ * \param  pTxMgmtQ    - The module's object
+ * \param  pPktCtrlBlk - Pointer to the packet CtrlBlk
+ * \param  pBodyHash   - Returns the body hash of a probe response, for saveProbeRsp
+ * \return TI_TRUE if the packet is a duplicate probe response, TI_FALSE otherwise
+ * \sa     txMgmtQ_Xmit, saveProbeRsp
+ */
+static TI_BOOL isDuplicateProbeRsp (TTxMgmtQ *pTxMgmtQ, TTxCtrlBlk *pPktCtrlBlk, TI_UINT32 *pBodyHash)
+{
+	dot11_header_t *pHdr = (dot11_header_t *)(pPktCtrlBlk->tTxnStruct.aBuf[0]);
+	TI_UINT8  *pSsid;
+	TI_UINT32 uSsidLen;
+	TI_UINT32 uBodyLen = pPktCtrlBlk->tTxnStruct.aLen[1];
+	TI_UINT32 uTimeMs;
+	TI_UINT32 i;
+
+	if (!getProbeRspSsid (pPktCtrlBlk, &pSsid, &uSsidLen)) {
+		return TI_FALSE;
+	}
+
+	*pBodyHash = getProbeRspBodyHash (pPktCtrlBlk);
+	uTimeMs = os_timeStampMs (pTxMgmtQ->hOs);
+
+	for (i = 0; i < PROBE_RSP_DEDUP_ENTRIES; i++) {
+		TProbeRspDedup *pEntry = &pTxMgmtQ->aProbeRspDedup[i];
+
+		if (pEntry->bValid &&
+		        (uTimeMs - pEntry->uTimeMs < PROBE_RSP_DEDUP_WINDOW_MS) &&
+		        (pEntry->uBodyLen == uBodyLen) &&
+		        (pEntry->uBodyHash == *pBodyHash) &&
+		        (pEntry->uSsidLen == uSsidLen) &&
+		        MAC_EQUAL (pEntry->tDa, pHdr->address1) &&
+		        (os_memoryCompare (pTxMgmtQ->hOs, pEntry->aSsid, pSsid, uSsidLen) == 0)) {
+			return TI_TRUE;
+		}
+	}
+
+	return TI_FALSE;
+}
+
+
+/**
+ * \fn     saveProbeRsp
+ * \brief  Save a queued probe response in the dedup table (static function)
+ *
+ * Save the DA, SSID and body length and hash of a probe response instead of the oldest table entry.
+ *
+ * \note   Called within the critical section, after the packet was queued successfully.
+ * \param  pTxMgmtQ    - The module's object
+ * \param  pPktCtrlBlk - Pointer to the packet CtrlBlk
+ * \param  uBodyHash   - The body hash returned by isDuplicateProbeRsp
+ * \return void
+ * \sa     txMgmtQ_Xmit, isDuplicateProbeRsp
+ */
+static void saveProbeRsp (TTxMgmtQ *pTxMgmtQ, TTxCtrlBlk *pPktCtrlBlk, TI_UINT32 uBodyHash)
+{
+	dot11_header_t *pHdr = (dot11_header_t *)(pPktCtrlBlk->tTxnStruct.aBuf[0]);
+	TProbeRspDedup *pEntry = &pTxMgmtQ->aProbeRspDedup[pTxMgmtQ->uProbeRspDedupIdx];
+	TI_UINT8  *pSsid;
+	TI_UINT32 uSsidLen;
+
+	if (!getProbeRspSsid (pPktCtrlBlk, &pSsid, &uSsidLen)) {
+		return;
+	}
+
+	MAC_COPY (pEntry->tDa, pHdr->address1);
+	os_memoryCopy (pTxMgmtQ->hOs, pEntry->aSsid, pSsid, uSsidLen);
+	pEntry->uSsidLen = uSsidLen;
+	pEntry->uBodyLen = pPktCtrlBlk->tTxnStruct.aLen[1];
+	pEntry->uBodyHash = uBodyHash;
+	pEntry->uTimeMs  = os_timeStampMs (pTxMgmtQ->hOs);
+	pEntry->bValid   = TI_TRUE;
+	pTxMgmtQ->uProbeRspDedupIdx = (pTxMgmtQ->uProbeRspDedupIdx + 1) % PROBE_RSP_DEDUP_ENTRIES;
+}
+
+
 /**
  * \fn     txMgmtQ_QueuesNotEmpty
  * \brief  Context-Engine Callback
@@ -983,6 +1188,7 @@ static void runScheduler (TTxMgmtQ *pTxMgmtQ)
 	TI_UINT32 uHlid = 0;
 	TI_BOOL bQueueActive;
 	TI_BOOL bLinkActive;
+	TI_UINT32 uDelayMs;
 
 
 	while(1) {
@@ -1005,6 +1211,9 @@ static void runScheduler (TTxMgmtQ *pTxMgmtQ)
 			if (pPktCtrlBlk) {
 				pLinkQ->tDbgCounters.aDequeuePackets[uQueId]++;
 
+				/* Get the queueing delay before the start time is converted for the FW */
+				uDelayMs = os_timeStampMs (pTxMgmtQ->hOs) - pPktCtrlBlk->tTxDescriptor.startTime;
+
 				/* Send the packet */
 				eStatus = txCtrl_XmitMgmt (pTxMgmtQ->hTxCtrl, pPktCtrlBlk);
 
@@ -1023,6 +1232,7 @@ static void runScheduler (TTxMgmtQ *pTxMgmtQ)
 				/* The packet was handled by the lower Tx layers. */
 				else {
 					pLinkQ->tDbgCounters.aXmittedPackets[uQueId]++;
+					updateDelayStatistics (pLinkQ, pPktCtrlBlk, uQueId, uDelayMs);
 
 					/* Successful delivery so start next tx from the high priority queue (mgmt),
 					 *	 giving it strict priority over the lower queue.
@@ -1062,6 +1272,41 @@ static void runScheduler (TTxMgmtQ *pTxMgmtQ)
 }
 
 
+/**
+ * \fn     updateDelayStatistics
+ * \brief  Update queueing delay statistics (static function)
+ *
+ * Update the link queueing delay statistics of a transmitted packet, per mgmt subtype
+ *    for Mgmt-queue packets, and in one entry for all EAPOL-queue packets.
+ *
+ * \note
+ * \param  pLinkQ      - The link queues the packet was sent from
+ * \param  pPktCtrlBlk - The transmitted packet
+ * \param  uQueId      - The queue the packet was sent from
+ * \param  uDelayMs    - The packet queueing delay in msec
+ * \return void
+ * \sa
+ */
+static void updateDelayStatistics (TMgmtLinkQ *pLinkQ, TTxCtrlBlk *pPktCtrlBlk, TI_UINT32 uQueId, TI_UINT32 uDelayMs)
+{
+	TI_UINT16 uFc;
+	TI_UINT32 uType;
+
+	if (uQueId == QUEUE_TYPE_MGMT) {
+		COPY_WLAN_WORD (&uFc, &((dot11_mgmtHeader_t *)(pPktCtrlBlk->aPktHdr))->fc);
+		uType = (uFc & DOT11_FC_SUB_MASK) >> 4;
+	} else {
+		uType = DELAY_TYPE_EAPOL_QUEUE;
+	}
+
+	pLinkQ->tDbgCounters.aDelayPackets[uType]++;
+	pLinkQ->tDbgCounters.aDelaySumMs[uType] += uDelayMs;
+	if (uDelayMs > pLinkQ->tDbgCounters.aDelayMaxMs[uType]) {
+		pLinkQ->tDbgCounters.aDelayMaxMs[uType] = uDelayMs;
+	}
+}
+
+
 /**
  * \fn     updateLinksBusyMap
  * \brief  Update links busy map (static function)
@@ -1235,6 +1480,7 @@ void txMgmtQ_PrintQueueStatistics (TI_HANDLE hTxMgmtQ)
 	TTxMgmtQ *pTxMgmtQ = (TTxMgmtQ *)hTxMgmtQ;
 	TMgmtLinkQ *pLinkQ;
 	TI_UINT32  uHlid;
+	TI_UINT32  uType;
 
 	WLAN_OS_REPORT(("-------------- Mgmt Queues Statistics  -------------------\n"));
 	for (uHlid = 0; uHlid < WLANLINKS_MAX_LINKS; uHlid++) {
@@ -1250,6 +1496,19 @@ void txMgmtQ_PrintQueueStatistics (TI_HANDLE hTxMgmtQ)
 		WLAN_OS_REPORT(("  aXmittedPackets: %8d %8d\n", pLinkQ->tDbgCounters.aXmittedPackets[0], pLinkQ->tDbgCounters.aXmittedPackets[1] ));
 		WLAN_OS_REPORT(("  aDroppedPackets: %8d %8d\n", pLinkQ->tDbgCounters.aDroppedPackets[0], pLinkQ->tDbgCounters.aDroppedPackets[1] ));
 		WLAN_OS_REPORT(("  uNoResourcesCount(before enqueue) = %d \n", pLinkQ->tDbgCounters.uNoResourcesCount));
+		WLAN_OS_REPORT(("  uProbeRspDupCount(before enqueue) = %d \n", pLinkQ->tDbgCounters.uProbeRspDupCount));
+		for (uType = 0; uType < NUM_OF_DELAY_TYPES; uType++) {
+			if (pLinkQ->tDbgCounters.aDelayPackets[uType] == 0)
+				continue;
+			if (uType == DELAY_TYPE_EAPOL_QUEUE)
+				WLAN_OS_REPORT(("  Delay(msec) EAPOL-Que:  "));
+			else
+				WLAN_OS_REPORT(("  Delay(msec) Subtype %2d: ", uType));
+			WLAN_OS_REPORT(("Packets=%d, Avg=%d, Max=%d\n",
+			                pLinkQ->tDbgCounters.aDelayPackets[uType],
+			                pLinkQ->tDbgCounters.aDelaySumMs[uType] / pLinkQ->tDbgCounters.aDelayPackets[uType],
+			                pLinkQ->tDbgCounters.aDelayMaxMs[uType]));
+		}
 	}
 }
 
@@ -98,6 +98,10 @@ VOID CuCmd_ClearBaPolicy(THandle hCuCmd, ConParm_t parm[], U16 nParms);
 VOID CuCmd_PsTrafficPeriod(THandle hCuCmd, ConParm_t parm[], U16 nParms);
 
 VOID CuCmd_ShowStatistics(THandle hCuCmd, ConParm_t parm[], U16 nParms);
+#ifdef TI_DBG
+VOID CuCmd_BenchmarkStatistics(THandle hCuCmd, ConParm_t parm[], U16 nParms);
+#endif
+VOID CuCmd_StreamStatistics(THandle hCuCmd, ConParm_t parm[], U16 nParms);
 VOID CuCmd_ShowTxStatistics(THandle hCuCmd, ConParm_t parm[], U16 nParms);
 VOID CuCmd_ShowAdvancedParams(THandle hCuCmd, ConParm_t parm[], U16 nParms);
 
@@ -184,6 +188,8 @@ VOID CuCmd_SetReport(THandle hCuCmd, ConParm_t parm[], U16 nParms);
 VOID CuCmd_AddReport(THandle hCuCmd, ConParm_t parm[], U16 nParms);
 VOID CuCmd_ClearReport(THandle hCuCmd, ConParm_t parm[], U16 nParms);
 VOID CuCmd_ReportSeverityLevel(THandle hCuCmd, ConParm_t parm[], U16 nParms);
+VOID CuCmd_ReportTracePoint(THandle hCuCmd, ConParm_t parm[], U16 nParms);
+VOID CuCmd_LoggerRingStatistics(THandle hCuCmd, ConParm_t parm[], U16 nParms);
 VOID CuCmd_SetReportLevelCLI(THandle hCuCmd, ConParm_t parm[], U16 nParms);
 
 VOID CuCmd_PrintDriverDebug(THandle hCuCmd, ConParm_t parm[], U16 nParms);
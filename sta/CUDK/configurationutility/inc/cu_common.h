@@ -59,6 +59,9 @@ S32 CuCommon_GetU8(THandle hCuCommon, U32 PrivateIoctlId, PU8 pData);
 S32 CuCommon_SetBuffer(THandle hCuCommon, U32 PrivateIoctlId, PVOID pBuffer, U32 len);
 S32 CuCommon_GetBuffer(THandle hCuCommon, U32 PrivateIoctlId, PVOID pBuffer, U32 len);
 S32 CuCommon_GetSetBuffer(THandle hCuCommon, U32 PrivateIoctlId, PVOID pBuffer, U32 len);
+VOID CuCommon_BatchAddGet(ti_private_cmd_batch_entry_t *pEntries, PU32 pNumEntries, U32 PrivateIoctlId, PVOID pBuffer, U32 len);
+S32 CuCommon_Batch(THandle hCuCommon, ti_private_cmd_batch_entry_t *pEntries, U32 NumEntries);
+U32 CuCommon_GetIoctlCount(THandle hCuCommon);
 
 S32 CuCommon_Start_Scan(THandle hCuCommon, PVOID scanParams, U32 sizeOfScanParams);
 S32 CuCommon_Get_BssidList_Size(THandle hCuCommon, PU32 pSizeOfBssiList);
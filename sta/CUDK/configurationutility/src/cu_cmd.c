@@ -93,6 +93,29 @@ typedef struct CuCmd_t {
 
 } CuCmd_t;
 
+/* Values shown by the statistics command */
+typedef struct {
+	U32 powerMode;
+	TMacAddr Mac;
+	OS_802_11_SSID ssid;
+	U8 desiredChannel;
+	S32 rtsTh;
+	S32 fragTh;
+	S32 txPowerLevel;
+	U8 bssType;
+	U32 desiredPreambleType;
+	TIWLN_COUNTERS driverCounters;
+	U32 AuthMode;
+	U8  CurrentTxRate;
+	U8  CurrentRxRate;
+	U32 DefaultKeyId;
+	U32 WepStatus;
+	S8 dRssi, bRssi;
+#ifdef XCC_MODULE_INCLUDED
+	U32 XCCNetEap;
+#endif
+} CuCmdStatistics_t;
+
 /* local variables */
 /*******************/
 struct CHAN_FREQ {
@@ -159,6 +182,7 @@ static named_value_t event_type[] = {
 	{ IPC_EVENT_SCAN_FAILED,			(PS8)"ScanFailed" },
 	{ IPC_EVENT_WPS_SESSION_OVERLAP,    (PS8)"IPC_EVENT_WPS_SESSION_OVERLAP" },
 	{ IPC_EVENT_RSSI_SNR_TRIGGER,       (PS8)"IPC_EVENT_RSSI_SNR_TRIGGER" },
+	{ IPC_EVENT_SCAN_RESULT_RECORD,     (PS8)"ScanResultRecord" },
 	{ IPC_EVENT_TIMEOUT,                (PS8)"Timeout" }
 };
 
@@ -1831,64 +1855,76 @@ VOID CuCmd_GetRxDataFiltersStatistics(THandle hCuCmd, ConParm_t parm[], U16 nPar
 	os_error_printf(CU_MSG_INFO2, (PS8)"Packets matching filter #4: %u\n", MatchedPacketsCount[3]);
 }
 
-VOID CuCmd_ShowStatistics(THandle hCuCmd, ConParm_t parm[], U16 nParms)
+/* read all the values shown by CuCmd_ShowStatistics, batching the private GETs into one ioctl if requested */
+static S32 CuCmd_ReadStatistics(CuCmd_t* pCuCmd, CuCmdStatistics_t* pStats, U32 bBatch)
 {
-	CuCmd_t* pCuCmd = (CuCmd_t*)hCuCmd;
+	ti_private_cmd_batch_entry_t aEntries[PRIVATE_CMD_BATCH_MAX];
+	U32 uNumEntries = 0;
 
-	U32 powerMode;
-	TMacAddr Mac;
-	OS_802_11_SSID ssid;
-	U8 desiredChannel;
-	S32 rtsTh;
-	S32 fragTh;
-	S32 txPowerLevel;
-	U8 bssType;
-	U32 desiredPreambleType;
-	TIWLN_COUNTERS driverCounters;
-	U32 AuthMode;
-	U8  CurrentTxRate;
-	S8  CurrentTxRateStr[20];
-	U8  CurrentRxRate;
-	S8  CurrentRxRateStr[20];
-	U32 DefaultKeyId;
-	U32 WepStatus;
-	S8 dRssi, bRssi;
+	if (OK != CuOs_Get_SSID(pCuCmd->hCuWext, &pStats->ssid)) return ECUERR_CU_COMMON_ERROR;
+	if (OK != CuOs_GetRtsTh(pCuCmd->hCuWext, &pStats->rtsTh)) return ECUERR_CU_COMMON_ERROR;
+	if (OK != CuOs_GetFragTh(pCuCmd->hCuWext, &pStats->fragTh)) return ECUERR_CU_COMMON_ERROR;
+	if (OK != CuOs_GetTxPowerLevel(pCuCmd->hCuWext, &pStats->txPowerLevel)) return ECUERR_CU_COMMON_ERROR;
+	/* the RSSI is read from the FW (async), so it can't be batched */
+	if (OK != CuCommon_GetRssi(pCuCmd->hCuCommon, &pStats->dRssi, &pStats->bRssi)) return ECUERR_CU_COMMON_ERROR;
+	if (pCuCmd->hWpaCore != NULL) {
+#ifndef NO_WPA_SUPPL
+		if (OK != WpaCore_GetAuthMode(pCuCmd->hWpaCore, &pStats->AuthMode)) return ECUERR_CU_COMMON_ERROR;
+		if (OK != WpaCore_GetDefaultKey(pCuCmd->hWpaCore, &pStats->DefaultKeyId)) return ECUERR_CU_COMMON_ERROR;
+#endif
+	}
+
+	if (!bBatch) {
+		if (OK != CuCommon_GetBuffer(pCuCmd->hCuCommon, CTRL_DATA_MAC_ADDRESS, pStats->Mac, sizeof(TMacAddr))) return ECUERR_CU_COMMON_ERROR;
+		if (OK != CuCommon_GetBuffer(pCuCmd->hCuCommon, TIWLN_802_11_POWER_MODE_GET, &pStats->powerMode, sizeof(U32))) return ECUERR_CU_COMMON_ERROR;
+		if (OK != CuCommon_GetU8(pCuCmd->hCuCommon, SITE_MGR_DESIRED_CHANNEL_PARAM, &pStats->desiredChannel)) return ECUERR_CU_COMMON_ERROR;
+		if (OK != CuCommon_GetU8(pCuCmd->hCuCommon, CTRL_DATA_CURRENT_BSS_TYPE_PARAM, &pStats->bssType)) return ECUERR_CU_COMMON_ERROR;
+		if (OK != CuCommon_GetU32(pCuCmd->hCuCommon, TIWLN_802_11_SHORT_PREAMBLE_GET, &pStats->desiredPreambleType)) return ECUERR_CU_COMMON_ERROR;
+		if (OK != CuCommon_GetBuffer(pCuCmd->hCuCommon, SITE_MGR_TI_WLAN_COUNTERS_PARAM, &pStats->driverCounters, sizeof(TIWLN_COUNTERS))) return ECUERR_CU_COMMON_ERROR;
+		if (OK != CuCommon_GetU32(pCuCmd->hCuCommon, RSN_ENCRYPTION_STATUS_PARAM, &pStats->WepStatus)) return ECUERR_CU_COMMON_ERROR;
+		if (pCuCmd->hWpaCore == NULL) {
+			if (OK != CuCommon_GetU32(pCuCmd->hCuCommon, RSN_EXT_AUTHENTICATION_MODE, &pStats->AuthMode)) return ECUERR_CU_COMMON_ERROR;
+			if (OK != CuCommon_GetU32(pCuCmd->hCuCommon, RSN_DEFAULT_KEY_ID, &pStats->DefaultKeyId)) return ECUERR_CU_COMMON_ERROR;
+		}
+		if (OK != CuCommon_GetU8(pCuCmd->hCuCommon, TIWLN_802_11_CURRENT_RATES_GET, &pStats->CurrentTxRate)) return ECUERR_CU_COMMON_ERROR;
+		if (OK != CuCommon_GetU8(pCuCmd->hCuCommon, TIWLN_GET_RX_DATA_RATE, &pStats->CurrentRxRate)) return ECUERR_CU_COMMON_ERROR;
 #ifdef XCC_MODULE_INCLUDED
-	U32 XCCNetEap;
+		if (OK != CuCommon_GetU32(pCuCmd->hCuCommon, RSN_XCC_NETWORK_EAP, &pStats->XCCNetEap)) return ECUERR_CU_COMMON_ERROR;
 #endif
+		return OK;
+	}
 
-	if (OK != CuCommon_GetBuffer(pCuCmd->hCuCommon, CTRL_DATA_MAC_ADDRESS,
-	                             Mac, sizeof(TMacAddr))) return;
-	if (OK != CuCommon_GetBuffer(pCuCmd->hCuCommon, TIWLN_802_11_POWER_MODE_GET, &powerMode, sizeof(U32))) return;
-	if (OK != CuOs_Get_SSID(pCuCmd->hCuWext, &ssid)) return;
-	if (OK != CuCommon_GetU8(pCuCmd->hCuCommon, SITE_MGR_DESIRED_CHANNEL_PARAM, &desiredChannel)) return;
-	if (OK != CuOs_GetRtsTh(pCuCmd->hCuWext, &rtsTh)) return;
-	if (OK != CuOs_GetFragTh(pCuCmd->hCuWext, &fragTh)) return;
-	if (OK != CuOs_GetTxPowerLevel(pCuCmd->hCuWext, &txPowerLevel)) return;
-	if (OK != CuCommon_GetU8(pCuCmd->hCuCommon, CTRL_DATA_CURRENT_BSS_TYPE_PARAM, &bssType)) return;
-	if (OK != CuCommon_GetU32(pCuCmd->hCuCommon, TIWLN_802_11_SHORT_PREAMBLE_GET, &desiredPreambleType)) return;
-	if (OK != CuCommon_GetBuffer(pCuCmd->hCuCommon, SITE_MGR_TI_WLAN_COUNTERS_PARAM, &driverCounters, sizeof(TIWLN_COUNTERS))) return;
-	if (OK != CuCommon_GetU32(pCuCmd->hCuCommon, RSN_ENCRYPTION_STATUS_PARAM, &WepStatus)) return;
-	if (OK != CuCommon_GetRssi(pCuCmd->hCuCommon, &dRssi, &bRssi)) return;
+	CuCommon_BatchAddGet(aEntries, &uNumEntries, CTRL_DATA_MAC_ADDRESS, pStats->Mac, sizeof(TMacAddr));
+	CuCommon_BatchAddGet(aEntries, &uNumEntries, TIWLN_802_11_POWER_MODE_GET, &pStats->powerMode, sizeof(U32));
+	CuCommon_BatchAddGet(aEntries, &uNumEntries, SITE_MGR_DESIRED_CHANNEL_PARAM, &pStats->desiredChannel, sizeof(U8));
+	CuCommon_BatchAddGet(aEntries, &uNumEntries, CTRL_DATA_CURRENT_BSS_TYPE_PARAM, &pStats->bssType, sizeof(U8));
+	CuCommon_BatchAddGet(aEntries, &uNumEntries, TIWLN_802_11_SHORT_PREAMBLE_GET, &pStats->desiredPreambleType, sizeof(U32));
+	CuCommon_BatchAddGet(aEntries, &uNumEntries, SITE_MGR_TI_WLAN_COUNTERS_PARAM, &pStats->driverCounters, sizeof(TIWLN_COUNTERS));
+	CuCommon_BatchAddGet(aEntries, &uNumEntries, RSN_ENCRYPTION_STATUS_PARAM, &pStats->WepStatus, sizeof(U32));
 	if (pCuCmd->hWpaCore == NULL) {
-		if (OK != CuCommon_GetU32(pCuCmd->hCuCommon, RSN_EXT_AUTHENTICATION_MODE, &AuthMode)) return;
-		if (OK != CuCommon_GetU32(pCuCmd->hCuCommon, RSN_DEFAULT_KEY_ID, &DefaultKeyId)) return;
-	} else {
-#ifndef NO_WPA_SUPPL
-		if (OK != WpaCore_GetAuthMode(pCuCmd->hWpaCore, &AuthMode)) return;
-		if (OK != WpaCore_GetDefaultKey(pCuCmd->hWpaCore, &DefaultKeyId)) return;
-#endif
+		CuCommon_BatchAddGet(aEntries, &uNumEntries, RSN_EXT_AUTHENTICATION_MODE, &pStats->AuthMode, sizeof(U32));
+		CuCommon_BatchAddGet(aEntries, &uNumEntries, RSN_DEFAULT_KEY_ID, &pStats->DefaultKeyId, sizeof(U32));
 	}
+	CuCommon_BatchAddGet(aEntries, &uNumEntries, TIWLN_802_11_CURRENT_RATES_GET, &pStats->CurrentTxRate, sizeof(U8));
+	CuCommon_BatchAddGet(aEntries, &uNumEntries, TIWLN_GET_RX_DATA_RATE, &pStats->CurrentRxRate, sizeof(U8));
+#ifdef XCC_MODULE_INCLUDED
+	CuCommon_BatchAddGet(aEntries, &uNumEntries, RSN_XCC_NETWORK_EAP, &pStats->XCCNetEap, sizeof(U32));
+#endif
 
-	if (OK != CuCommon_GetU8(pCuCmd->hCuCommon, TIWLN_802_11_CURRENT_RATES_GET, &CurrentTxRate)) return;
-	CuCmd_CreateRateStr(CurrentTxRateStr, CurrentTxRate);
+	return CuCommon_Batch(pCuCmd->hCuCommon, aEntries, uNumEntries);
+}
 
-	if (OK != CuCommon_GetU8(pCuCmd->hCuCommon, TIWLN_GET_RX_DATA_RATE, &CurrentRxRate)) return;
-	CuCmd_CreateRateStr(CurrentRxRateStr, CurrentRxRate);
+VOID CuCmd_ShowStatistics(THandle hCuCmd, ConParm_t parm[], U16 nParms)
+{
+	CuCmd_t* pCuCmd = (CuCmd_t*)hCuCmd;
+	CuCmdStatistics_t stats;
+	S8  CurrentTxRateStr[20];
+	S8  CurrentRxRateStr[20];
 
-#ifdef XCC_MODULE_INCLUDED
-	if (OK != CuCommon_GetU32(pCuCmd->hCuCommon, RSN_XCC_NETWORK_EAP, &XCCNetEap)) return;
-#endif
+	if (OK != CuCmd_ReadStatistics(pCuCmd, &stats, TRUE)) return;
+
+	CuCmd_CreateRateStr(CurrentTxRateStr, stats.CurrentTxRate);
+	CuCmd_CreateRateStr(CurrentRxRateStr, stats.CurrentRxRate);
 
 	os_error_printf(CU_MSG_INFO2, (PS8)"******************\n");
 	os_error_printf(CU_MSG_INFO2, (PS8)"Driver Statistics:\n");
@@ -1896,46 +1932,259 @@ VOID CuCmd_ShowStatistics(THandle hCuCmd, ConParm_t parm[], U16 nParms)
 
 	os_error_printf(CU_MSG_INFO2, (PS8)"    dot11CurrentTxRate : %s\n", CurrentTxRateStr);
 	os_error_printf(CU_MSG_INFO2, (PS8)"         CurrentRxRate : %s\n", CurrentRxRateStr);
-	os_error_printf(CU_MSG_INFO2, (PS8)"   dot11DesiredChannel : %d\n", desiredChannel);
-	os_error_printf(CU_MSG_INFO2, (PS8)"     currentMACAddress : %02x.%02x.%02x.%02x.%02x.%02x\n",Mac[0],Mac[1],Mac[2],Mac[3],Mac[4],Mac[5]);
-	os_error_printf(CU_MSG_INFO2, (PS8)"      dot11DesiredSSID : %s\n", ssid.Ssid);
-	os_error_printf(CU_MSG_INFO2, (PS8)"          dot11BSSType : %d\n", bssType);
-	os_error_printf(CU_MSG_INFO2, (PS8)"    AuthenticationMode : %d\n", AuthMode );
-	os_error_printf(CU_MSG_INFO2, (PS8)"    bShortPreambleUsed : %d\n", desiredPreambleType );
-	os_error_printf(CU_MSG_INFO2, (PS8)"          RTSThreshold : %d\n", rtsTh );
-	os_error_printf(CU_MSG_INFO2, (PS8)"FragmentationThreshold : %d\n", fragTh );
-	os_error_printf(CU_MSG_INFO2, (PS8)" bDefaultWEPKeyDefined : %d\n", DefaultKeyId);
-	os_error_printf(CU_MSG_INFO2, (PS8)"             WEPStatus : %d\n", WepStatus);
-	os_error_printf(CU_MSG_INFO2, (PS8)"          TxPowerLevel : %d\n", txPowerLevel );
-	os_error_printf(CU_MSG_INFO2, (PS8)"             PowerMode : %d\n", powerMode );
-	os_error_printf(CU_MSG_INFO2, (PS8)"              dataRssi : %d\n", dRssi);
-	os_error_printf(CU_MSG_INFO2, (PS8)"            beaconRssi : %d\n", bRssi);
+	os_error_printf(CU_MSG_INFO2, (PS8)"   dot11DesiredChannel : %d\n", stats.desiredChannel);
+	os_error_printf(CU_MSG_INFO2, (PS8)"     currentMACAddress : %02x.%02x.%02x.%02x.%02x.%02x\n",stats.Mac[0],stats.Mac[1],stats.Mac[2],stats.Mac[3],stats.Mac[4],stats.Mac[5]);
+	os_error_printf(CU_MSG_INFO2, (PS8)"      dot11DesiredSSID : %s\n", stats.ssid.Ssid);
+	os_error_printf(CU_MSG_INFO2, (PS8)"          dot11BSSType : %d\n", stats.bssType);
+	os_error_printf(CU_MSG_INFO2, (PS8)"    AuthenticationMode : %d\n", stats.AuthMode );
+	os_error_printf(CU_MSG_INFO2, (PS8)"    bShortPreambleUsed : %d\n", stats.desiredPreambleType );
+	os_error_printf(CU_MSG_INFO2, (PS8)"          RTSThreshold : %d\n", stats.rtsTh );
+	os_error_printf(CU_MSG_INFO2, (PS8)"FragmentationThreshold : %d\n", stats.fragTh );
+	os_error_printf(CU_MSG_INFO2, (PS8)" bDefaultWEPKeyDefined : %d\n", stats.DefaultKeyId);
+	os_error_printf(CU_MSG_INFO2, (PS8)"             WEPStatus : %d\n", stats.WepStatus);
+	os_error_printf(CU_MSG_INFO2, (PS8)"          TxPowerLevel : %d\n", stats.txPowerLevel );
+	os_error_printf(CU_MSG_INFO2, (PS8)"             PowerMode : %d\n", stats.powerMode );
+	os_error_printf(CU_MSG_INFO2, (PS8)"              dataRssi : %d\n", stats.dRssi);
+	os_error_printf(CU_MSG_INFO2, (PS8)"            beaconRssi : %d\n", stats.bRssi);
 	/**/
 	/* network layer statistics*/
 	/**/
-	os_error_printf(CU_MSG_INFO2, (PS8)"                RecvOk : %d\n", driverCounters.RecvOk );
-	os_error_printf(CU_MSG_INFO2, (PS8)"             RecvError : %d\n", driverCounters.RecvError );
-	os_error_printf(CU_MSG_INFO2, (PS8)"     DirectedBytesRecv : %d\n", driverCounters.DirectedBytesRecv );
-	os_error_printf(CU_MSG_INFO2, (PS8)"    DirectedFramesRecv : %d\n", driverCounters.DirectedFramesRecv );
-	os_error_printf(CU_MSG_INFO2, (PS8)"    MulticastBytesRecv : %d\n", driverCounters.MulticastBytesRecv );
-	os_error_printf(CU_MSG_INFO2, (PS8)"   MulticastFramesRecv : %d\n", driverCounters.MulticastFramesRecv );
-	os_error_printf(CU_MSG_INFO2, (PS8)"    BroadcastBytesRecv : %d\n", driverCounters.BroadcastBytesRecv );
-	os_error_printf(CU_MSG_INFO2, (PS8)"   BroadcastFramesRecv : %d\n", driverCounters.BroadcastFramesRecv );
-	os_error_printf(CU_MSG_INFO2, (PS8)"             FcsErrors : %d\n", driverCounters.FcsErrors );
-	os_error_printf(CU_MSG_INFO2, (PS8)"           BeaconsRecv : %d\n", driverCounters.BeaconsRecv );
-	os_error_printf(CU_MSG_INFO2, (PS8)"          AssocRejects : %d\n", driverCounters.AssocRejects );
-	os_error_printf(CU_MSG_INFO2, (PS8)"         AssocTimeouts : %d\n", driverCounters.AssocTimeouts );
-	os_error_printf(CU_MSG_INFO2, (PS8)"           AuthRejects : %d\n", driverCounters.AuthRejects );
-	os_error_printf(CU_MSG_INFO2, (PS8)"          AuthTimeouts : %d\n", driverCounters.AuthTimeouts );
+	os_error_printf(CU_MSG_INFO2, (PS8)"                RecvOk : %d\n", stats.driverCounters.RecvOk );
+	os_error_printf(CU_MSG_INFO2, (PS8)"             RecvError : %d\n", stats.driverCounters.RecvError );
+	os_error_printf(CU_MSG_INFO2, (PS8)"     DirectedBytesRecv : %d\n", stats.driverCounters.DirectedBytesRecv );
+	os_error_printf(CU_MSG_INFO2, (PS8)"    DirectedFramesRecv : %d\n", stats.driverCounters.DirectedFramesRecv );
+	os_error_printf(CU_MSG_INFO2, (PS8)"    MulticastBytesRecv : %d\n", stats.driverCounters.MulticastBytesRecv );
+	os_error_printf(CU_MSG_INFO2, (PS8)"   MulticastFramesRecv : %d\n", stats.driverCounters.MulticastFramesRecv );
+	os_error_printf(CU_MSG_INFO2, (PS8)"    BroadcastBytesRecv : %d\n", stats.driverCounters.BroadcastBytesRecv );
+	os_error_printf(CU_MSG_INFO2, (PS8)"   BroadcastFramesRecv : %d\n", stats.driverCounters.BroadcastFramesRecv );
+	os_error_printf(CU_MSG_INFO2, (PS8)"             FcsErrors : %d\n", stats.driverCounters.FcsErrors );
+	os_error_printf(CU_MSG_INFO2, (PS8)"           BeaconsRecv : %d\n", stats.driverCounters.BeaconsRecv );
+	os_error_printf(CU_MSG_INFO2, (PS8)"          AssocRejects : %d\n", stats.driverCounters.AssocRejects );
+	os_error_printf(CU_MSG_INFO2, (PS8)"         AssocTimeouts : %d\n", stats.driverCounters.AssocTimeouts );
+	os_error_printf(CU_MSG_INFO2, (PS8)"           AuthRejects : %d\n", stats.driverCounters.AuthRejects );
+	os_error_printf(CU_MSG_INFO2, (PS8)"          AuthTimeouts : %d\n", stats.driverCounters.AuthTimeouts );
 
 	/**/
 	/* other statistics*/
 	/**/
 #ifdef XCC_MODULE_INCLUDED
-	os_error_printf(CU_MSG_INFO2, (PS8)"        dwSecuritySuit : %d\n", XCCNetEap);
+	os_error_printf(CU_MSG_INFO2, (PS8)"        dwSecuritySuit : %d\n", stats.XCCNetEap);
 #endif
 }
 
+#ifdef TI_DBG
+/* time the statistics refresh with one ioctl per value and with the private GETs batched */
+VOID CuCmd_BenchmarkStatistics(THandle hCuCmd, ConParm_t parm[], U16 nParms)
+{
+	CuCmd_t* pCuCmd = (CuCmd_t*)hCuCmd;
+	CuCmdStatistics_t stats;
+	U32 uIterations = (nParms > 0) ? parm[0].value : 100;
+	U32 bBatch, i, uIoctls, uStartTime, uTime;
+
+	if (uIterations == 0)
+		uIterations = 100;
+
+	for (bBatch = 0; bBatch < 2; bBatch++) {
+		uIoctls = CuCommon_GetIoctlCount(pCuCmd->hCuCommon);
+		uStartTime = os_GetTimeStampUs();
+		for (i = 0; i < uIterations; i++) {
+			if (OK != CuCmd_ReadStatistics(pCuCmd, &stats, bBatch)) {
+				os_error_printf(CU_MSG_ERROR, (PS8)"Error - CuCmd_BenchmarkStatistics - reading statistics failed\n");
+				return;
+			}
+		}
+		uTime = os_GetTimeStampUs() - uStartTime;
+		uIoctls = CuCommon_GetIoctlCount(pCuCmd->hCuCommon) - uIoctls;
+
+		os_error_printf(CU_MSG_INFO2, (PS8)"%s: %d refreshes, %d ioctls per refresh, %d usec per refresh\n",
+		                bBatch ? "batched" : "single ", uIterations, uIoctls / uIterations, uTime / uIterations);
+	}
+}
+#endif /* TI_DBG */
+
+/* statistics snapshot sections, counter names in the driver order (see STADExternalIf.h) */
+static char *StatsWlanNames[] = {
+	"RecvOk", "RecvError", "RecvNoBuffer", "DirectedBytesRecv", "DirectedFramesRecv",
+	"MulticastBytesRecv", "MulticastFramesRecv", "BroadcastBytesRecv", "BroadcastFramesRecv",
+	"FragmentsRecv", "FrameDuplicates", "FcsErrors", "BeaconsXmit", "BeaconsRecv",
+	"AssocRejects", "AssocTimeouts", "AuthRejects", "AuthTimeouts"
+};
+
+static char *StatsTxNames[] = {
+	"XmitOk", "DirectedBytesXmit", "DirectedFramesXmit", "MulticastBytesXmit", "MulticastFramesXmit",
+	"BroadcastBytesXmit", "BroadcastFramesXmit", "RetryFail", "TxTimeout", "NoLink", "OtherFail",
+	"NumPackets", "SumFWDelayUs", "SumMacDelayUs"
+};
+
+static char *StatsXferNames[] = {
+	"FwInterrupts", "RxPackets", "RxXfers", "TxPackets", "TxXfers"
+};
+
+static char *StatsPowerNames[] = {
+	"PowerMode", "PsStatus", "EnterPsOk", "EnterPsFail", "ExitPsOk", "ExitPsFail"
+};
+
+static struct {
+	U16     uId;
+	char    *pName;
+	char    **pCounterNames;
+	U32     uNumNames;
+	U32     uGaugeMask;     /* counters that are printed as is rather than as deltas */
+} StatsSections[] = {
+	{ STATS_SECTION_WLAN,  "wlan",  StatsWlanNames,  SIZE_ARR(StatsWlanNames),  0 },
+	{ STATS_SECTION_TX,    "tx",    StatsTxNames,    SIZE_ARR(StatsTxNames),    0 },
+	{ STATS_SECTION_XFER,  "xfer",  StatsXferNames,  SIZE_ARR(StatsXferNames),  0 },
+	{ STATS_SECTION_POWER, "power", StatsPowerNames, SIZE_ARR(StatsPowerNames),
+	  (1 << STATS_POWER_MODE) | (1 << STATS_POWER_PS_STATUS) }
+};
+
+/* read a statistics snapshot and check that its header and sections are consistent */
+static S32 CuCmd_ReadStatsSnapshot(CuCmd_t* pCuCmd, U32 *pBuf)
+{
+	TStatsSnapshotHdr *pHdr = (TStatsSnapshotHdr *)pBuf;
+	TStatsSnapshotSection *pSection;
+	U32 uPos, i;
+
+	os_memset(pBuf, 0, STATS_SNAPSHOT_MAX_LEN);
+	if (OK != CuCommon_GetSetBuffer(pCuCmd->hCuCommon, SITE_MGR_STATS_SNAPSHOT_PARAM, pBuf, STATS_SNAPSHOT_MAX_LEN))
+		return ECUERR_CU_COMMON_ERROR;
+
+	if ((pHdr->uMagic != STATS_SNAPSHOT_MAGIC) || (pHdr->uVersion < 1) ||
+	    (pHdr->uLength > STATS_SNAPSHOT_MAX_LEN))
+		return ECUERR_CU_COMMON_ERROR;
+
+	uPos = sizeof(TStatsSnapshotHdr);
+	for (i = 0; i < pHdr->uNumSections; i++) {
+		pSection = (TStatsSnapshotSection *)((PU8)pBuf + uPos);
+		uPos += sizeof(TStatsSnapshotSection);
+		if (uPos > pHdr->uLength)
+			return ECUERR_CU_COMMON_ERROR;
+		uPos += pSection->uNumCounters * sizeof(U32);
+		if (uPos > pHdr->uLength)
+			return ECUERR_CU_COMMON_ERROR;
+	}
+
+	return OK;
+}
+
+/* print the CSV header (pPrev is NULL) or one CSV / JSON line of the deltas from pPrev */
+static VOID CuCmd_PrintStatsSnapshot(U32 *pCurr, U32 *pPrev, U32 bJson)
+{
+	TStatsSnapshotHdr *pHdr = (TStatsSnapshotHdr *)pCurr;
+	TStatsSnapshotSection *pSection;
+	U32 *pCounters, *pPrevCounters = NULL;
+	U32 uPos, uSec, uCnt, uEntry, uValue;
+	char *pSecName, *pCntName;
+	S8 aSecName[8], aCntName[8];
+	U32 bOpen;
+
+	if (pPrev == NULL) {
+		if (bJson)
+			return;
+		os_error_printf(CU_MSG_INFO2, (PS8)"time_ms,dt_ms");
+	} else {
+		os_error_printf(CU_MSG_INFO2, (PS8)(bJson ? "{\"time_ms\":%u,\"dt_ms\":%u" : "%u,%u"),
+		                pHdr->uTimestampMs, pHdr->uTimestampMs - ((TStatsSnapshotHdr *)pPrev)->uTimestampMs);
+	}
+
+	uPos = sizeof(TStatsSnapshotHdr);
+	for (uSec = 0; uSec < pHdr->uNumSections; uSec++) {
+		pSection = (TStatsSnapshotSection *)((PU8)pCurr + uPos);
+		pCounters = (U32 *)(pSection + 1);
+		if (pPrev != NULL)
+			pPrevCounters = (U32 *)((PU8)pPrev + uPos + sizeof(TStatsSnapshotSection));
+		uPos += sizeof(TStatsSnapshotSection) + pSection->uNumCounters * sizeof(U32);
+
+		for (uEntry = 0; uEntry < SIZE_ARR(StatsSections); uEntry++) {
+			if (StatsSections[uEntry].uId == pSection->uId)
+				break;
+		}
+		if (uEntry < SIZE_ARR(StatsSections)) {
+			pSecName = StatsSections[uEntry].pName;
+		} else {
+			os_sprintf(aSecName, (PS8)"s%d", pSection->uId);
+			pSecName = (char *)aSecName;
+		}
+
+		bOpen = FALSE;
+		for (uCnt = 0; uCnt < pSection->uNumCounters; uCnt++) {
+			if ((uEntry < SIZE_ARR(StatsSections)) && (uCnt < StatsSections[uEntry].uNumNames)) {
+				pCntName = StatsSections[uEntry].pCounterNames[uCnt];
+			} else {
+				os_sprintf(aCntName, (PS8)"c%d", uCnt);
+				pCntName = (char *)aCntName;
+			}
+
+			if (pPrev == NULL) {
+				os_error_printf(CU_MSG_INFO2, (PS8)",%s.%s", pSecName, pCntName);
+				continue;
+			}
+
+			uValue = pCounters[uCnt];
+			if ((uEntry >= SIZE_ARR(StatsSections)) || (uCnt >= 32) ||
+			    !(StatsSections[uEntry].uGaugeMask & (1 << uCnt))) {
+				/* a counter that went back was reset (driver recovery), so count from zero */
+				if (uValue >= pPrevCounters[uCnt])
+					uValue -= pPrevCounters[uCnt];
+			}
+
+			if (!bJson) {
+				os_error_printf(CU_MSG_INFO2, (PS8)",%u", uValue);
+			} else if (uValue != 0) {
+				/* JSON lines hold only the changed counters, to keep continuous streaming cheap */
+				if (!bOpen)
+					os_error_printf(CU_MSG_INFO2, (PS8)",\"%s\":{", pSecName);
+				os_error_printf(CU_MSG_INFO2, (PS8)"%s\"%s\":%u", bOpen ? "," : "", pCntName, uValue);
+				bOpen = TRUE;
+			}
+		}
+
+		if (bOpen)
+			os_error_printf(CU_MSG_INFO2, (PS8)"}");
+	}
+
+	os_error_printf(CU_MSG_INFO2, (PS8)(((pPrev != NULL) && bJson) ? "}\n" : "\n"));
+}
+
+/* stream statistics snapshot deltas at a fixed interval, as CSV or JSON lines */
+VOID CuCmd_StreamStatistics(THandle hCuCmd, ConParm_t parm[], U16 nParms)
+{
+	CuCmd_t* pCuCmd = (CuCmd_t*)hCuCmd;
+	U32 aBuf[2][STATS_SNAPSHOT_MAX_LEN / sizeof(U32)];
+	U32 uInterval = (nParms > 0) ? parm[0].value : 1000;
+	U32 uCount = (nParms > 1) ? parm[1].value : 0;
+	U32 bJson = (nParms > 2) ? parm[2].value : FALSE;
+	U32 uCurr = 0, i;
+
+	if (uInterval == 0)
+		uInterval = 1000;
+
+	if (OK != CuCmd_ReadStatsSnapshot(pCuCmd, aBuf[uCurr])) {
+		os_error_printf(CU_MSG_ERROR, (PS8)"Error - CuCmd_StreamStatistics - reading statistics snapshot failed\n");
+		return;
+	}
+	CuCmd_PrintStatsSnapshot(aBuf[uCurr], NULL, bJson);
+
+	/* count 0 streams until the utility is stopped */
+	for (i = 0; (uCount == 0) || (i < uCount); i++) {
+		os_SleepMs(uInterval);
+
+		uCurr ^= 1;
+		if (OK != CuCmd_ReadStatsSnapshot(pCuCmd, aBuf[uCurr])) {
+			os_error_printf(CU_MSG_ERROR, (PS8)"Error - CuCmd_StreamStatistics - reading statistics snapshot failed\n");
+			return;
+		}
+
+		/* the layout changed (e.g. driver reloaded), restart from this snapshot */
+		if (((TStatsSnapshotHdr *)aBuf[uCurr])->uLength != ((TStatsSnapshotHdr *)aBuf[uCurr ^ 1])->uLength) {
+			CuCmd_PrintStatsSnapshot(aBuf[uCurr], NULL, bJson);
+			continue;
+		}
+
+		CuCmd_PrintStatsSnapshot(aBuf[uCurr], aBuf[uCurr ^ 1], bJson);
+	}
+}
+
 VOID CuCmd_ShowTxStatistics(THandle hCuCmd, ConParm_t parm[], U16 nParms)
 {
 	CuCmd_t* pCuCmd = (CuCmd_t*)hCuCmd;
@@ -3983,6 +4232,56 @@ VOID CuCmd_ReportSeverityLevel(THandle hCuCmd, ConParm_t parm[], U16 nParms)
 	}
 }
 
+VOID CuCmd_ReportTracePoint(THandle hCuCmd, ConParm_t parm[], U16 nParms)
+{
+	CuCmd_t* pCuCmd = (CuCmd_t*)hCuCmd;
+	TReportTracePointParam tTracePoint;
+
+	tTracePoint.uFileId = (U16)parm[0].value;
+	tTracePoint.uLine = (U16)parm[1].value;
+	tTracePoint.uOverride = parm[2].value;
+
+	if (CuCommon_SetBuffer(pCuCmd->hCuCommon, REPORT_TRACE_POINT_PARAM, &tTracePoint, sizeof(tTracePoint))) {
+		os_error_printf(CU_MSG_ERROR, (PS8)"Error - failed to set the trace point override (max %d overrides)\n", REPORT_TP_MAX_OVERRIDES);
+	}
+}
+
+VOID CuCmd_LoggerRingStatistics(THandle hCuCmd, ConParm_t parm[], U16 nParms)
+{
+	CuCmd_t* pCuCmd = (CuCmd_t*)hCuCmd;
+	TLoggerRingHdr tStart, tEnd;
+	U32 uSeconds = (nParms > 0) ? parm[0].value : 1;
+	U32 uStartUs, uElapsedUs, uMsgs, uWakeups;
+
+	if (IpcEvent_GetLoggerRingStats(pCuCmd->hIpcEvent, &tStart) != OK) {
+		os_error_printf(CU_MSG_ERROR, (PS8)"Error - the driver logger ring is not available\n");
+		return;
+	}
+	uStartUs = os_GetTimeStampUs();
+
+	os_SleepMs(uSeconds * 1000);
+
+	if (IpcEvent_GetLoggerRingStats(pCuCmd->hIpcEvent, &tEnd) != OK) {
+		os_error_printf(CU_MSG_ERROR, (PS8)"Error - the driver logger ring is not available\n");
+		return;
+	}
+	uElapsedUs = os_GetTimeStampUs() - uStartUs;
+	if (uElapsedUs == 0) {
+		uElapsedUs = 1;
+	}
+
+	uMsgs = tEnd.uMsgs - tStart.uMsgs;
+	uWakeups = tEnd.uWakeups - tStart.uWakeups;
+
+	os_error_printf(CU_MSG_INFO2, (PS8)"Logger ring (%d bytes) over %d ms:\n", tEnd.uDataSize, uElapsedUs / 1000);
+	os_error_printf(CU_MSG_INFO2, (PS8)"-------------------------------\n");
+	os_error_printf(CU_MSG_INFO2, (PS8)"Traces/sec         = %d\n", (U32)(((u64)uMsgs * 1000000) / uElapsedUs));
+	os_error_printf(CU_MSG_INFO2, (PS8)"Consumed bytes/sec = %d\n", (U32)(((u64)(tEnd.uTail - tStart.uTail) * 1000000) / uElapsedUs));
+	os_error_printf(CU_MSG_INFO2, (PS8)"Dropped            = %d (total %d)\n", tEnd.uDropped - tStart.uDropped, tEnd.uDropped);
+	os_error_printf(CU_MSG_INFO2, (PS8)"Wakeups            = %d (%d traces per wakeup)\n", uWakeups, uWakeups ? uMsgs / uWakeups : 0);
+	os_error_printf(CU_MSG_INFO2, (PS8)"Backlog bytes      = %d\n", tEnd.uHead - tEnd.uTail);
+}
+
 VOID CuCmd_SetReportLevelCLI(THandle hCuCmd, ConParm_t parm[], U16 nParms)
 {
 #if 0 /* need to create debug logic for CLI */
@@ -206,6 +206,45 @@ S32 CuCommon_GetSetBuffer(THandle hCuCommon, U32 PrivateIoctlId, PVOID pBuffer,
 	return OK;
 }
 
+VOID CuCommon_BatchAddGet(ti_private_cmd_batch_entry_t *pEntries, PU32 pNumEntries, U32 PrivateIoctlId, PVOID pBuffer, U32 len)
+{
+	ti_private_cmd_batch_entry_t *pEntry = &pEntries[*pNumEntries];
+
+	pEntry->cmd.cmd = PrivateIoctlId;
+	pEntry->cmd.flags = PRIVATE_CMD_GET_FLAG;
+	pEntry->cmd.in_buffer = NULL;
+	pEntry->cmd.in_buffer_len = 0;
+	pEntry->cmd.out_buffer = pBuffer;
+	pEntry->cmd.out_buffer_len = len;
+	pEntry->status = OK;
+	(*pNumEntries)++;
+}
+
+S32 CuCommon_Batch(THandle hCuCommon, ti_private_cmd_batch_entry_t *pEntries, U32 NumEntries)
+{
+	CuCommon_t* pCuCommon = (CuCommon_t*)hCuCommon;
+	S32 res;
+	U32 i;
+
+	res = IPC_STA_Private_Batch_Send(pCuCommon->hIpcSta, pEntries, NumEntries);
+	if (res == EOALERR_IPC_STA_ERROR_SENDING_WEXT)
+		return ECUERR_CU_COMMON_ERROR;
+
+	for (i = 0; i < NumEntries; i++) {
+		if (pEntries[i].status != OK)
+			return ECUERR_CU_COMMON_ERROR;
+	}
+
+	return OK;
+}
+
+U32 CuCommon_GetIoctlCount(THandle hCuCommon)
+{
+	CuCommon_t* pCuCommon = (CuCommon_t*)hCuCommon;
+
+	return IPC_STA_GetIoctlCount(pCuCommon->hIpcSta);
+}
+
 S32 CuCommon_Get_BssidList_Size(THandle hCuCommon, PU32 pSizeOfBssiList)
 {
 	CuCommon_t* pCuCommon = (CuCommon_t*)hCuCommon;
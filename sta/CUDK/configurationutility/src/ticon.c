@@ -256,6 +256,21 @@ static S32 TiCon_Init_Console_Menu(TiCon_t* pTiCon)
 	Console_AddToken(pTiCon->hConsole,h, (PS8)"Advanced", (PS8)"Show advanced params", (FuncToken_t) CuCmd_ShowAdvancedParams, NULL );
 
 	Console_AddToken(pTiCon->hConsole,h, (PS8)"Power consumption",  (PS8)"Show power consumption statistics", (FuncToken_t) Cucmd_ShowPowerConsumptionStats, NULL );
+	{
+		ConParm_t aaa[]  = {
+			{(PS8)"interval ms", CON_PARM_OPTIONAL, 0, 0, 0 },
+			{(PS8)"count", CON_PARM_OPTIONAL, 0, 0, 0 },
+			{(PS8)"json", CON_PARM_OPTIONAL | CON_PARM_RANGE, 0, 1, 0 },
+			CON_LAST_PARM
+		};
+		Console_AddToken(pTiCon->hConsole,h, (PS8)"stReam statistics", (PS8)"Stream statistics deltas every interval (count 0 - endless), as CSV or JSON", (FuncToken_t) CuCmd_StreamStatistics, aaa );
+	}
+#ifdef TI_DBG
+	{
+		ConParm_t aaa[]  = { {(PS8)"iterations", CON_PARM_OPTIONAL, 0, 0, 0 }, CON_LAST_PARM };
+		Console_AddToken(pTiCon->hConsole,h, (PS8)"Benchmark statistics", (PS8)"Time statistics refresh with single and batched commands", (FuncToken_t) CuCmd_BenchmarkStatistics, aaa );
+	}
+#endif
 
 	/* -------------------------------------------- Privacy -------------------------------------------- */
 
@@ -954,6 +969,19 @@ static S32 TiCon_Init_Console_Menu(TiCon_t* pTiCon)
 		ConParm_t aaa[]  = { {(PS8)"level", CON_PARM_OPTIONAL , 0, 0, 0 }, CON_LAST_PARM };
 		Console_AddToken(pTiCon->hConsole,h1, (PS8)"Level", (PS8)"set report severity level", (FuncToken_t) CuCmd_ReportSeverityLevel, aaa );
 	}
+	{
+		ConParm_t aaa[]  = {
+			{(PS8)"file", CON_PARM_RANGE, 0, REPORT_FILES_NUM - 1, 0 },
+			{(PS8)"line (0 - all)", CON_PARM_RANGE, 0, 0xFFFF, 0 },
+			{(PS8)"0 - tables, 1 - on, 2 - off", CON_PARM_RANGE, 0, 2, 0 },
+			CON_LAST_PARM
+		};
+		Console_AddToken(pTiCon->hConsole,h1, (PS8)"Point", (PS8)"override the report tables for a site", (FuncToken_t) CuCmd_ReportTracePoint, aaa );
+	}
+	{
+		ConParm_t aaa[]  = { {(PS8)"seconds", CON_PARM_OPTIONAL | CON_PARM_RANGE, 1, 60, 1 }, CON_LAST_PARM };
+		Console_AddToken(pTiCon->hConsole,h1, (PS8)"Ring", (PS8)"logger ring throughput", (FuncToken_t) CuCmd_LoggerRingStatistics, aaa );
+	}
 	/* -------------------------------------------- Debug -------------------------------------------- */
 
 	CHK_NULL(h = (THandle) Console_AddDirExt(pTiCon->hConsole,  (THandle) NULL, (PS8)"dEbug", (PS8)"Debug features" ) );
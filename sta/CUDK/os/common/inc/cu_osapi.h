@@ -128,6 +128,8 @@ VOID os_OsSpecificCmdParams(S32 argc, PS8* argv);
 VOID os_InitOsSpecificModules(VOID);
 VOID os_DeInitOsSpecificModules(VOID);
 TI_SIZE_T os_get_last_error(VOID);
+U32 os_GetTimeStampUs(VOID);
+VOID os_SleepMs(U32 uMsec);
 
 #endif  /* _CUOSAPI_H_ */
 
@@ -34,7 +34,8 @@ typedef enum {
 	EOALERR_IPC_WPA_ERROR_CANT_CONNECT_TO_SUPPL = -6,
 	EOALERR_IPC_WPA_ERROR_CMD_TIMEOUT = -7,
 	EOALERR_IPC_WPA_ERROR_CMD_FAILED = -8,
-	EOALERR_MAX_ERROR = EOALERR_IPC_WPA_ERROR_CMD_FAILED
+	EOALERR_IPC_EVENT_ERROR_LOGGER_RING_UNAVAILABLE = -9,
+	EOALERR_MAX_ERROR = EOALERR_IPC_EVENT_ERROR_LOGGER_RING_UNAVAILABLE
 } EOALError;
 
 typedef enum {
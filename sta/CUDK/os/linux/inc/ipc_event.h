@@ -25,6 +25,10 @@
 #ifndef _IPC_EVENT_H_
 #define _IPC_EVENT_H_
 
+/* includes */
+/************/
+#include "TI_IPC_Api.h"
+
 /* defines */
 /***********/
 
@@ -39,6 +43,7 @@ VOID IpcEvent_Destroy(THandle hIpcEvent);
 S32 IpcEvent_EnableEvent(THandle hIpcEvent, U32 event);
 S32 IpcEvent_DisableEvent(THandle hIpcEvent, U32 event);
 S32 IpcEvent_UpdateDebugLevel(THandle hIpcEvent, S32 debug_level);
+S32 IpcEvent_GetLoggerRingStats(THandle hIpcEvent, TLoggerRingHdr* pStats);
 
 #endif  /* _IPC_EVENT_H_ */
 
@@ -38,6 +38,8 @@
 THandle IpcSta_Create(const PS8 device_name);
 VOID IpcSta_Destroy(THandle hIpcSta);
 S32 IPC_STA_Private_Send(THandle hIpcSta, U32 ioctl_cmd, PVOID bufIn, U32 sizeIn, PVOID bufOut, U32 sizeOut);
+S32 IPC_STA_Private_Batch_Send(THandle hIpcSta, ti_private_cmd_batch_entry_t *pEntries, U32 uNumEntries);
 S32 IPC_STA_Wext_Send(THandle hIpcSta, U32 wext_request_id, PVOID p_iwreq_data, U32 len);
+U32 IPC_STA_GetIoctlCount(THandle hIpcSta);
 #endif  /* _IPC_STA_H_ */
 
@@ -37,12 +37,14 @@
 #include <signal.h>
 #include <sys/mman.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <linux/wireless.h>
 #include "cu_osapi.h"
 #include "oserr.h"
 
 #include "TWDriver.h"
 #include "STADExternalIf.h"
+#include "TI_IPC_Api.h"
 
 #include "ParsEvent.h"
 #include "ipc_event.h"
@@ -56,8 +58,12 @@
 /* IPC evemt messages to child */
 #define IPC_EVENT_MSG_KILL                  "IPC_EVENT_MSG_KILL"
 #define IPC_EVENT_MSG_UPDATE_DEBUG_LEVEL    "IPC_EVENT_MSG_UPDATE_DEBUG_LEVEL"
+#define IPC_EVENT_MSG_UPDATE_LOGGER         "IPC_EVENT_MSG_UPDATE_LOGGER"
 #define IPC_EVENT_MSG_MAX_LEN   50
 
+#define LOGGER_RING_MAP_SIZE    (LOGGER_RING_HDR_SIZE + LOGGER_RING_DATA_SIZE)
+#define LOGGER_RING_RETRY_SEC   1       /* interval for mapping the ring again while the driver has none (logger registered) */
+
 /* Macros */
 #define PRINT_FORMAT_S8_VAL(signedVal) \
 (((U8)signedVal > 127) ? (0xFFFFFF00 | signedVal) : signedVal)
@@ -84,6 +90,8 @@ typedef struct IpcEvent_Child_t {
 	S32 STA_socket;
 	IpcEvent_Shared_Memory_t* p_shared_memory;
 	S32 pipe_from_parent;
+	S32 logger_fd;                  /* trace logger ring device, -1 if not available */
+	TLoggerRingHdr* p_logger_ring;
 } IpcEvent_Child_t;
 
 /* local variables */
@@ -281,6 +289,27 @@ static VOID IpcEvent_PrintEvent(IpcEvent_Child_t* pIpcEventChild, U32 EventId, T
 		case IPC_EVENT_GWSI:
 			os_error_printf(CU_MSG_ERROR, (PS8)"IpcEvent_PrintEvent - received IPC_EVENT_GWSI\n");
 			break;
+		case IPC_EVENT_SCAN_RESULT_RECORD: {
+			TScanResultRecord *pRecord;
+
+			if (NULL == pData) {
+				return;
+			}
+			pRecord = (TScanResultRecord*)pData;
+
+			if (pRecord->uFlags & SCAN_RESULT_RECORD_END) {
+				os_error_printf(CU_MSG_ERROR, (PS8)"CLI Event - Scan result stream %d end, seq %u\n",
+				                pRecord->uStreamId, pRecord->uSequence);
+			} else {
+				os_error_printf(CU_MSG_ERROR, (PS8)"CLI Event - Scan result %s, stream %d, seq %u: %02x:%02x:%02x:%02x:%02x:%02x ch %d rssi %d\n",
+				                (pRecord->uFlags & SCAN_RESULT_RECORD_NEW) ? "new" : "updated",
+				                pRecord->uStreamId, pRecord->uSequence,
+				                pRecord->tBssid[0], pRecord->tBssid[1], pRecord->tBssid[2],
+				                pRecord->tBssid[3], pRecord->tBssid[4], pRecord->tBssid[5],
+				                pRecord->uChannel, pRecord->iRssi);
+			}
+			break;
+		}
 		case IPC_EVENT_LOGGER:
 #ifdef ETH_SUPPORT
 			ProcessLoggerMessage(pData, (U16)DataLen);
@@ -340,6 +369,10 @@ static VOID IpcEvent_wext_event_wireless(IpcEvent_Child_t* pIpcEventChild, PS8 d
 			if (pEvent) {
 				EventId = (U32)pEvent->EvParams.uEventType;
 				IpcEvent_PrintEvent (pIpcEventChild, EventId, pEvent->uBuffer, pEvent->uBufferSize);
+				if (pEvent->uCoalesced != 0) {
+					os_error_printf(CU_MSG_ERROR, (PS8)"CLI Event - event %d (seq %u) also stands for %u earlier events\n",
+					                EventId, pEvent->uSequence, pEvent->uCoalesced);
+				}
 			}
 			break;
 		case SIOCGIWSCAN:
@@ -454,6 +487,100 @@ static VOID IpcEvent_Handle_STA_Event(IpcEvent_Child_t* pIpcEventChild)
 
 }
 
+/*
+ * map the driver trace ring - if the driver has no ring the traces are sent as IPC_EVENT_LOGGER events.
+ * The driver has a ring only while the traces are redirected to the logger and the driver is up,
+ * and the device is held open only while the ring is mapped, so the driver module can be unloaded.
+ * The ring is opened only by a child that registered IPC_EVENT_LOGGER, and the driver allows a single
+ * reader (O_RDWR) at a time, so the records are never consumed by another child.
+ */
+static S32 IpcEvent_LoggerRing_Open(IpcEvent_Child_t* pIpcEventChild)
+{
+	PVOID pMap;
+
+	pIpcEventChild->logger_fd = open(LOGGER_RING_DEVICE, O_RDWR);
+	if (pIpcEventChild->logger_fd < 0) {
+		/* no driver, or another logger is reading the ring */
+		return -1;
+	}
+
+	pMap = mmap(0, LOGGER_RING_MAP_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, pIpcEventChild->logger_fd, 0);
+	if (pMap == MAP_FAILED) {
+		/* no ring right now */
+		close(pIpcEventChild->logger_fd);
+		pIpcEventChild->logger_fd = -1;
+		return -1;
+	}
+	if ((((TLoggerRingHdr*)pMap)->uMagic != LOGGER_RING_MAGIC) ||
+	        (((TLoggerRingHdr*)pMap)->uDataSize != LOGGER_RING_DATA_SIZE)) {
+		os_error_printf(CU_MSG_ERROR, (PS8)"ERROR - IpcEvent_LoggerRing_Open - cant map the logger ring\n");
+		munmap(pMap, LOGGER_RING_MAP_SIZE);
+		close(pIpcEventChild->logger_fd);
+		pIpcEventChild->logger_fd = -1;
+		return -2;
+	}
+
+	pIpcEventChild->p_logger_ring = (TLoggerRingHdr*)pMap;
+
+	return pIpcEventChild->logger_fd;
+}
+
+static VOID IpcEvent_LoggerRing_Close(IpcEvent_Child_t* pIpcEventChild)
+{
+	if (pIpcEventChild->p_logger_ring) {
+		munmap(pIpcEventChild->p_logger_ring, LOGGER_RING_MAP_SIZE);
+		pIpcEventChild->p_logger_ring = NULL;
+	}
+	if (pIpcEventChild->logger_fd >= 0) {
+		close(pIpcEventChild->logger_fd);
+		pIpcEventChild->logger_fd = -1;
+	}
+}
+
+/* consume all the trace records written since the last wakeup */
+static VOID IpcEvent_LoggerRing_Drain(IpcEvent_Child_t* pIpcEventChild)
+{
+	TLoggerRingHdr* pHdr = pIpcEventChild->p_logger_ring;
+	PU8 pData = (PU8)pHdr + LOGGER_RING_HDR_SIZE;
+	U32 uHead = pHdr->uHead;
+	U32 uTail = pHdr->uTail;
+
+	/* the driver freed the ring - release the device, it is mapped again when the ring is back */
+	if (pHdr->uMagic != LOGGER_RING_MAGIC) {
+		IpcEvent_LoggerRing_Close(pIpcEventChild);
+		return;
+	}
+
+	/* read the records only after the head that covers them */
+	__sync_synchronize();
+
+	while ((S32)(uHead - uTail) >= (S32)sizeof(TLoggerRingRec)) {
+		U32 uPos = uTail & (LOGGER_RING_DATA_SIZE - 1);
+		TLoggerRingRec* pRec = (TLoggerRingRec*)(pData + uPos);
+
+		if (pRec->uFlags & LOGGER_REC_WRAP) {
+			uTail += LOGGER_RING_DATA_SIZE - uPos;
+			continue;
+		}
+		if ((uPos + sizeof(TLoggerRingRec) + pRec->uLen > LOGGER_RING_DATA_SIZE) ||
+		        ((S32)(uHead - uTail) < (S32)(sizeof(TLoggerRingRec) + pRec->uLen))) {
+			os_error_printf(CU_MSG_ERROR, (PS8)"ERROR - IpcEvent_LoggerRing_Drain - bad record at %d, resync\n", uPos);
+			uTail = uHead;
+			break;
+		}
+#ifdef ETH_SUPPORT
+		if (pIpcEventChild->p_shared_memory->event_mask & ((u64)1 << IPC_EVENT_LOGGER)) {
+			ProcessLoggerMessage((PU8)(pRec + 1), pRec->uLen);
+		}
+#endif
+		uTail += sizeof(TLoggerRingRec) + LOGGER_REC_ALIGN(pRec->uLen);
+	}
+
+	/* release the space only after the records were consumed */
+	__sync_synchronize();
+	pHdr->uTail = uTail;
+}
+
 static S32 IpcEvent_Handle_Parent_Event(IpcEvent_Child_t* pIpcEventChild)
 {
 	S8 msg[IPC_EVENT_MSG_MAX_LEN];
@@ -475,6 +602,10 @@ static S32 IpcEvent_Handle_Parent_Event(IpcEvent_Child_t* pIpcEventChild)
 	if (!os_strcmp(msg, (PS8)IPC_EVENT_MSG_UPDATE_DEBUG_LEVEL)) {
 		/*        g_debug_level= pIpcEventChild->p_shared_memory->content.debug_level;*/
 		return FALSE;
+	}
+	if (!os_strcmp(msg, (PS8)IPC_EVENT_MSG_UPDATE_LOGGER)) {
+		/* the logger ring is opened or closed at the top of the child loop */
+		return FALSE;
 	} else
 		os_error_printf(CU_MSG_ERROR, (PS8)"ERROR - IpcEvent_Handle_Parent_Event - unknown msgLen=%d msg=|%s| \n",msgLen,msg);
 
@@ -488,6 +619,7 @@ static VOID IpcEvent_Child_Destroy(IpcEvent_Child_t* pIpcEventChild)
 		IpcEvent_Sockets_Close(pIpcEventChild->STA_socket);
 	}
 
+	IpcEvent_LoggerRing_Close(pIpcEventChild);
 }
 
 static VOID IpcEvent_Child(IpcEvent_Child_t* pIpcEventChild)
@@ -502,17 +634,38 @@ static VOID IpcEvent_Child(IpcEvent_Child_t* pIpcEventChild)
 	while (1) {
 		fd_set      read_set;       /* File descriptors for select */
 		S32         ret;
+		S32         max_fd = pIpcEventChild->STA_socket;
+		struct timeval tRetry;
+		struct timeval *pTimeout = NULL;
+		S32         bLogger = (pIpcEventChild->p_shared_memory->event_mask & ((u64)1 << IPC_EVENT_LOGGER)) ? TRUE : FALSE;
+
+		/* the traces are read in bulk from the driver ring when it is available, only if the logger is registered */
+		if (!bLogger && pIpcEventChild->p_logger_ring) {
+			IpcEvent_LoggerRing_Close(pIpcEventChild);
+		}
+		if (bLogger && (pIpcEventChild->p_logger_ring == NULL)) {
+			IpcEvent_LoggerRing_Open(pIpcEventChild);
+		}
+		if (bLogger && (pIpcEventChild->p_logger_ring == NULL)) {
+			tRetry.tv_sec = LOGGER_RING_RETRY_SEC;
+			tRetry.tv_usec = 0;
+			pTimeout = &tRetry;
+		}
 
 		FD_ZERO(&read_set);
 		FD_SET(pIpcEventChild->STA_socket, &read_set);
 		FD_SET(pIpcEventChild->pipe_from_parent, &read_set);
+		if (pIpcEventChild->p_logger_ring) {
+			FD_SET(pIpcEventChild->logger_fd, &read_set);
+			max_fd = max(max_fd, pIpcEventChild->logger_fd);
+		}
 
 #ifndef ANDROID
-		ret = select(max(pIpcEventChild->pipe_from_parent,pIpcEventChild->STA_socket) + 1,
-		             &read_set, NULL, NULL, NULL);
+		ret = select(max(pIpcEventChild->pipe_from_parent,max_fd) + 1,
+		             &read_set, NULL, NULL, pTimeout);
 #else
-		ret = select(pIpcEventChild->STA_socket + 1,
-		             &read_set, NULL, NULL, NULL);
+		ret = select(max_fd + 1,
+		             &read_set, NULL, NULL, pTimeout);
 #endif
 
 		if (ret < 0) {
@@ -525,6 +678,9 @@ static VOID IpcEvent_Child(IpcEvent_Child_t* pIpcEventChild)
 		if (FD_ISSET(pIpcEventChild->STA_socket, &read_set))
 			IpcEvent_Handle_STA_Event(pIpcEventChild);
 
+		if (pIpcEventChild->p_logger_ring && FD_ISSET(pIpcEventChild->logger_fd, &read_set))
+			IpcEvent_LoggerRing_Drain(pIpcEventChild);
+
 #ifndef ANDROID
 		if (FD_ISSET(pIpcEventChild->pipe_from_parent, &read_set)) {
 			S32 exit = IpcEvent_Handle_Parent_Event(pIpcEventChild);
@@ -576,6 +732,7 @@ THandle IpcEvent_Create(VOID)
 		}
 
 		pIpcEventChild->p_shared_memory = pIpcEvent->p_shared_memory;
+		pIpcEventChild->logger_fd = -1;
 
 		pIpcEventChild->pipe_from_parent = pIpcEventChild->p_shared_memory->pipe_fields[PIPE_READ];
 		close(pIpcEventChild->p_shared_memory->pipe_fields[PIPE_WRITE]);
@@ -618,6 +775,11 @@ S32 IpcEvent_EnableEvent(THandle hIpcEvent, U32 event)
 		pIpcEvent->p_shared_memory->event_mask |= ((u64)1 << event);
 	}
 
+	/* let the child map the logger ring */
+	if (event == IPC_EVENT_LOGGER) {
+		IpcEvent_SendMessageToChild(pIpcEvent, (PS8)IPC_EVENT_MSG_UPDATE_LOGGER);
+	}
+
 	return OK;
 
 }
@@ -632,6 +794,11 @@ S32 IpcEvent_DisableEvent(THandle hIpcEvent, U32 event)
 		pIpcEvent->p_shared_memory->event_mask &= ~(1 << event);
 	}
 
+	/* let the child release the logger ring */
+	if (event == IPC_EVENT_LOGGER) {
+		IpcEvent_SendMessageToChild(pIpcEvent, (PS8)IPC_EVENT_MSG_UPDATE_LOGGER);
+	}
+
 	return OK;
 }
 
@@ -645,3 +812,24 @@ S32 IpcEvent_UpdateDebugLevel(THandle hIpcEvent, S32 debug_level)
 	return OK;
 }
 
+S32 IpcEvent_GetLoggerRingStats(THandle hIpcEvent, TLoggerRingHdr* pStats)
+{
+	TLoggerRingHdr* pHdr;
+	S32 fd;
+
+	fd = open(LOGGER_RING_DEVICE, O_RDONLY);
+	if (fd < 0) {
+		return EOALERR_IPC_EVENT_ERROR_LOGGER_RING_UNAVAILABLE;
+	}
+
+	pHdr = (TLoggerRingHdr*)mmap(0, LOGGER_RING_HDR_SIZE, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (pHdr == MAP_FAILED) {
+		return EOALERR_IPC_EVENT_ERROR_LOGGER_RING_UNAVAILABLE;
+	}
+
+	os_memcpy(pStats, pHdr, sizeof(TLoggerRingHdr));
+	munmap(pHdr, LOGGER_RING_HDR_SIZE);
+
+	return OK;
+}
@@ -53,6 +53,7 @@ typedef struct IpcSta_t {
 	struct iwreq    wext_req;
 	ti_private_cmd_t private_cmd;
 	S32 STA_socket;
+	U32 uIoctlCount;	/* number of ioctls sent to the driver */
 
 } IpcSta_t;
 
@@ -160,6 +161,7 @@ S32 IPC_STA_Private_Send(THandle hIpcSta, U32 ioctl_cmd, PVOID bufIn, U32 sizeIn
 	pIpcSta->wext_req.u.data.length = sizeof(ti_private_cmd_t);
 	pIpcSta->wext_req.u.data.flags = 0;
 
+	pIpcSta->uIoctlCount++;
 	res = ioctl(pIpcSta->STA_socket, SIOCIWFIRSTPRIV, &pIpcSta->wext_req);
 	if (res != OK) {
 		os_error_printf(CU_MSG_ERROR, (PS8)"ERROR - IPC_STA_Private_Send - error sending Wext private IOCTL to STA driver (ioctl_cmd = %x,  res = %d, errno = %d)\n", ioctl_cmd,res,errno);
@@ -169,6 +171,40 @@ S32 IPC_STA_Private_Send(THandle hIpcSta, U32 ioctl_cmd, PVOID bufIn, U32 sizeIn
 	return OK;
 }
 
+/*
+ * IPC_STA_Private_Batch_Send - Send several private commands in one ioctl.
+ * The entries are executed in order by the driver, which returns each entry's
+ * status and output length in place. Returns an error only if the batch itself failed.
+ */
+S32 IPC_STA_Private_Batch_Send(THandle hIpcSta, ti_private_cmd_batch_entry_t *pEntries, U32 uNumEntries)
+{
+	IpcSta_t* pIpcSta = (IpcSta_t*)hIpcSta;
+	S32 res;
+
+	if ((uNumEntries == 0) || (uNumEntries > PRIVATE_CMD_BATCH_MAX))
+		return EOALERR_IPC_STA_ERROR_SENDING_WEXT;
+
+	pIpcSta ->private_cmd.cmd = DRIVER_BATCH_PARAM;
+	pIpcSta ->private_cmd.flags = PRIVATE_CMD_SET_FLAG | PRIVATE_CMD_GET_FLAG;
+	pIpcSta ->private_cmd.in_buffer = pEntries;
+	pIpcSta ->private_cmd.in_buffer_len = uNumEntries * sizeof(ti_private_cmd_batch_entry_t);
+	pIpcSta ->private_cmd.out_buffer = pEntries;
+	pIpcSta ->private_cmd.out_buffer_len = uNumEntries * sizeof(ti_private_cmd_batch_entry_t);
+
+	pIpcSta->wext_req.u.data.pointer = &pIpcSta->private_cmd;
+	pIpcSta->wext_req.u.data.length = sizeof(ti_private_cmd_t);
+	pIpcSta->wext_req.u.data.flags = 0;
+
+	pIpcSta->uIoctlCount++;
+	res = ioctl(pIpcSta->STA_socket, SIOCIWFIRSTPRIV, &pIpcSta->wext_req);
+	if (res != OK) {
+		os_error_printf(CU_MSG_ERROR, (PS8)"ERROR - IPC_STA_Private_Batch_Send - error sending Wext private IOCTL to STA driver (%d commands,  res = %d, errno = %d)\n", uNumEntries,res,errno);
+		return EOALERR_IPC_STA_ERROR_SENDING_WEXT;
+	}
+
+	return OK;
+}
+
 S32 IPC_STA_Wext_Send(THandle hIpcSta, U32 wext_request_id, PVOID p_iwreq_data, U32 len)
 {
 	IpcSta_t* pIpcSta = (IpcSta_t*)hIpcSta;
@@ -176,6 +212,7 @@ S32 IPC_STA_Wext_Send(THandle hIpcSta, U32 wext_request_id, PVOID p_iwreq_data,
 
 	os_memcpy(&pIpcSta->wext_req.u.data, p_iwreq_data, len);
 
+	pIpcSta->uIoctlCount++;
 	res = ioctl(pIpcSta->STA_socket, wext_request_id, &pIpcSta->wext_req);
 	if (res != OK) {
 		os_error_printf(CU_MSG_ERROR, (PS8)"ERROR - IPC_STA_Wext_Send - error sending Wext IOCTL to STA driver (wext_request_id = 0x%x, res = %d, errno = %d)\n",wext_request_id,res,errno);
@@ -187,3 +224,12 @@ S32 IPC_STA_Wext_Send(THandle hIpcSta, U32 wext_request_id, PVOID p_iwreq_data,
 	return OK;
 }
 
+/*
+ * IPC_STA_GetIoctlCount - Return the number of ioctls sent to the driver so far.
+ */
+U32 IPC_STA_GetIoctlCount(THandle hIpcSta)
+{
+	IpcSta_t* pIpcSta = (IpcSta_t*)hIpcSta;
+
+	return pIpcSta->uIoctlCount;
+}
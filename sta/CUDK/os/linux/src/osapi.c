@@ -38,6 +38,7 @@
 #include <unistd.h>
 #include <signal.h>
 #include <errno.h>
+#include <sys/time.h>
 #include "cu_os.h"
 #include "cu_osapi.h"
 
@@ -613,3 +614,31 @@ TI_SIZE_T os_get_last_error()
 {
 	return errno;
 }
+
+/************************************************************************
+ *                        os_GetTimeStampUs                             *
+ ************************************************************************
+DESCRIPTION: return a free running time stamp in microseconds (wraps around),
+             used for measuring intervals
+
+CONTEXT:
+************************************************************************/
+U32 os_GetTimeStampUs(VOID)
+{
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	return (U32)(tv.tv_sec * 1000000 + tv.tv_usec);
+}
+
+/************************************************************************
+ *                        os_SleepMs                                    *
+ ************************************************************************
+DESCRIPTION: suspend the calling thread for the given number of milliseconds
+
+CONTEXT:
+************************************************************************/
+VOID os_SleepMs(U32 uMsec)
+{
+	usleep(uMsec * 1000);
+}
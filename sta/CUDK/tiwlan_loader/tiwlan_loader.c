@@ -39,6 +39,7 @@
 #include "WlanDrvCommon.h"
 
 #define TIWLAN_DRV_NAME "tiwlan"
+#define INIT_TABLE_BLOB_MAX_LEN     (64 * 1024)
 
 S8    g_drv_name[IF_NAME_SIZE + 1];
 
@@ -49,12 +50,159 @@ S32 print_usage(VOID)
 	os_error_printf (CU_MSG_INFO1, (PS8)"   -n - no eeprom file\n");
 	os_error_printf (CU_MSG_INFO1, (PS8)"   -i <filename>  - init file name. default=tiwlan.ini\n");
 	os_error_printf (CU_MSG_INFO1, (PS8)"   -f <filename>  - firmware image file name. default=firmware.bin\n");
+	os_error_printf (CU_MSG_INFO1, (PS8)"   -v - only check the init file syntax (the driver is not loaded)\n");
+	os_error_printf (CU_MSG_INFO1, (PS8)"   -c <filename>  - compile the init file to an init table blob file, which may be\n");
+	os_error_printf (CU_MSG_INFO1, (PS8)"                    passed by -i instead of the init file on the next loads\n");
 	return 1;
 }
 
+/* Compare the ini-file keys as the driver does (case insensitive) */
+static S32 init_key_cmp(PS8 key1, PS8 key2, S32 length)
+{
+	S32 i;
+
+	for (i = 0; i < length; i++) {
+		if (os_tolower(key1[i]) != os_tolower(key2[i]))
+			return 1;
+	}
+	return 0;
+}
+
+/*
+ * Check the init file offline. Return the number of errors found.
+ * For a text file, the lines syntax and duplicated keys (the driver uses only the first one) are checked.
+ * The parameters values are checked by the driver when the file is compiled (see -c).
+ * For an init table blob, its header is checked.
+ */
+static S32 check_init_file(PS8 buf, S32 length)
+{
+	TInitTableBlobHdr *pHdr = (TInitTableBlobHdr *)buf;
+	PS8 end_buf = buf + length;
+	PS8 line, next, key, prev_line, prev_next, prev_key, value;
+	S32 key_len, prev_key_len, line_num, errors = 0;
+
+	if (length >= (S32)sizeof(TInitTableBlobHdr) && pHdr->uMagic == INIT_TABLE_BLOB_MAGIC) {
+		os_error_printf(CU_MSG_INFO1, (PS8)"Init table blob: version %d, table size %d, ini-file text %d bytes\n",
+		                pHdr->uVersion, pHdr->uTableSize, pHdr->uIniLength);
+		if ((U32)length != INIT_TABLE_BLOB_LENGTH(pHdr)) {
+			os_error_printf(CU_MSG_ERROR, (PS8)"Init table blob length %d doesn't match its header\n", length);
+			return 1;
+		}
+		return 0;
+	}
+
+	for (line = buf, line_num = 1; line < end_buf; line = next, line_num++) {
+		for (next = line; next < end_buf && *next != '\n'; next++) ;
+		if (next < end_buf)
+			next++;
+
+		for (key = line; key < next && (*key == ' ' || *key == '\t'); key++) ;
+		if (key == next || *key == '#' || *key == '\r' || *key == '\n' || !*key)
+			continue;
+
+		for (key_len = 0; &key[key_len] < next && key[key_len] != '=' &&
+		        key[key_len] != ' ' && key[key_len] != '\t'; key_len++) ;
+		for (value = &key[key_len]; value < next && (*value == ' ' || *value == '\t'); value++) ;
+
+		if (value == next || *value != '=' || key_len == 0) {
+			os_error_printf(CU_MSG_ERROR, (PS8)"Line %d: expected <key> = <value>\n", line_num);
+			errors++;
+			continue;
+		}
+		for (value++; value < next && (*value == ' ' || *value == '\t'); value++) ;
+		if (value == next || *value == '#' || *value == '\r' || *value == '\n') {
+			os_error_printf(CU_MSG_ERROR, (PS8)"Line %d: no value for %.*s\n", line_num, key_len, key);
+			errors++;
+			continue;
+		}
+
+		/* Look for the same key in the previous lines */
+		for (prev_line = buf; prev_line < line; prev_line = prev_next) {
+			for (prev_next = prev_line; *prev_next != '\n'; prev_next++) ;
+			prev_next++;
+			for (prev_key = prev_line; *prev_key == ' ' || *prev_key == '\t'; prev_key++) ;
+			for (prev_key_len = 0; &prev_key[prev_key_len] < prev_next && prev_key[prev_key_len] != '=' &&
+			        prev_key[prev_key_len] != ' ' && prev_key[prev_key_len] != '\t'; prev_key_len++) ;
+			if (prev_key_len == key_len && *prev_key != '#' && !init_key_cmp(prev_key, key, key_len)) {
+				os_error_printf(CU_MSG_ERROR, (PS8)"Line %d: %.*s is already set, this value is ignored\n",
+				                line_num, key_len, key);
+				errors++;
+				break;
+			}
+		}
+	}
+
+	return errors;
+}
+
+/* Check the init file offline (-v). Return '0' if no errors found */
+S32 validate_init_file(PS8 init_file_name)
+{
+	PVOID f;
+	S32 length, errors = -1;
+	PS8 buf;
+
+	if ((f = os_fopen (init_file_name, OS_FOPEN_READ)) == NULL) {
+		os_error_printf(CU_MSG_ERROR, (PS8)"Cannot open init file <%s>\n", init_file_name);
+		return -1;
+	}
+
+	length = os_getFileSize(f);
+	buf = (length > 0) ? (PS8)os_MemoryAlloc(length) : NULL;
+	if (buf && os_fread(buf, 1, length, f) == length) {
+		errors = check_init_file(buf, length);
+		os_error_printf(CU_MSG_INFO1, (PS8)"%s: %d errors\n", init_file_name, errors);
+	} else {
+		os_error_printf(CU_MSG_ERROR, (PS8)"Error reading init file <%s>\n", init_file_name);
+	}
+
+	if (buf)
+		os_MemoryFree(buf);
+	os_fclose(f);
+
+	return errors ? -1 : 0;
+}
+
+/* Get the loaded init file compiled by the driver and save it (-c). Return '0' if success */
+static S32 compile_init_file(THandle hIpcSta, PS8 blob_file_name)
+{
+	TInitTableBlobHdr *pHdr;
+	PVOID f;
+	S32 blob_length, rc = -1;
+
+	pHdr = (TInitTableBlobHdr *)os_MemoryAlloc(INIT_TABLE_BLOB_MAX_LEN);
+	if (!pHdr) {
+		os_error_printf(CU_MSG_ERROR, (PS8)"No memory to allocate init table blob (%d bytes)\n", INIT_TABLE_BLOB_MAX_LEN);
+		return rc;
+	}
+
+	if (OK != IPC_STA_Private_Send(hIpcSta, DRIVER_INIT_TABLE_PARAM, NULL, 0, pHdr, INIT_TABLE_BLOB_MAX_LEN)) {
+		os_error_printf(CU_MSG_ERROR, (PS8)"Wlan_loader: The driver failed compiling the init file (see the driver log)\n");
+		goto compile_init_file_end;
+	}
+
+	blob_length = INIT_TABLE_BLOB_LENGTH(pHdr);
+	if ((f = os_fopen (blob_file_name, OS_FOPEN_WRITE_BINARY)) == NULL) {
+		os_error_printf(CU_MSG_ERROR, (PS8)"Cannot create init table blob file <%s>\n", blob_file_name);
+		goto compile_init_file_end;
+	}
+	if (os_fwrite(pHdr, 1, blob_length, f) == blob_length) {
+		os_error_printf(CU_MSG_INFO1, (PS8)"Init table blob version %d saved to %s (%d bytes)\n",
+		                pHdr->uVersion, blob_file_name, blob_length);
+		rc = 0;
+	} else {
+		os_error_printf(CU_MSG_ERROR, (PS8)"Error writing init table blob file <%s>\n", blob_file_name);
+	}
+	os_fclose(f);
+
+compile_init_file_end:
+	os_MemoryFree(pHdr);
+	return rc;
+}
+
 /*  Return '0' if success */
 S32 init_driver( PS8 adapter_name, PS8 eeprom_file_name,
-                 PS8 init_file_name, PS8 firmware_file_name )
+                 PS8 init_file_name, PS8 firmware_file_name, PS8 blob_file_name )
 {
 	PVOID f1=NULL, f2=NULL, f3 = NULL;
 	S32 eeprom_image_length=0;
@@ -138,6 +286,10 @@ S32 init_driver( PS8 adapter_name, PS8 eeprom_file_name,
 	        (init_file_length &&
 	         os_fread(&init_info->data[eeprom_image_length+firmware_image_length], 1, init_file_length, f3)<init_file_length)) {
 		os_error_printf(CU_MSG_ERROR, (PS8)"Warning: Error in reading init_file %s - Using defaults\n", init_file_name);
+	} else if (blob_file_name &&
+	           check_init_file(&init_info->data[eeprom_image_length+firmware_image_length], init_file_length) != 0) {
+		os_error_printf(CU_MSG_ERROR, (PS8)"Errors found in init_file %s - Aborting...\n", init_file_name);
+		goto init_driver_end;
 	}
 
 	if (NULL != init_info) {
@@ -151,6 +303,11 @@ S32 init_driver( PS8 adapter_name, PS8 eeprom_file_name,
 		goto init_driver_end;
 	}
 
+	/* Compile the init file to a blob if requested */
+	if (blob_file_name && compile_init_file(hIpcSta, blob_file_name) != 0) {
+		goto init_driver_end;
+	}
+
 	/* No Error Found */
 	rc = 0;
 
@@ -196,6 +353,8 @@ S32 user_main(S32 argc, PPS8 argv)
 	PS8 eeprom_file_name = (PS8)"./nvs_map.bin";
 	PS8 init_file_name = (PS8)"tiwlan.ini";
 	PS8 firmware_file_name = (PS8)"firmware.bin";
+	PS8 blob_file_name = NULL;
+	S32 validate_only = 0;
 
 	/* Parse command line parameters */
 	if ( argc > 1 ) {
@@ -214,6 +373,10 @@ S32 user_main(S32 argc, PPS8 argv)
 				init_file_name = argv[++i];
 			} else if (!os_strcmp(argv[i], (PS8)"-n" ) ) {
 				eeprom_file_name = NULL;
+			} else if (!os_strcmp(argv[i], (PS8)"-v" ) ) {
+				validate_only = 1;
+			} else if (!os_strcmp(argv[i], (PS8)"-c") && (i+1<argc)) {
+				blob_file_name = argv[++i];
 			} else {
 				os_error_printf (CU_MSG_ERROR, (PS8)"Loader: unknow parameter '%s'\n", argv[i]);
 #ifdef ANDROID
@@ -224,6 +387,10 @@ S32 user_main(S32 argc, PPS8 argv)
 		}
 	}
 
+	if ( validate_only ) {
+		return validate_init_file(init_file_name);
+	}
+
 	if ( !g_drv_name[0] ) {
 		os_strcpy(g_drv_name, (PS8)TIWLAN_DRV_NAME "0" );
 	}
@@ -232,7 +399,7 @@ S32 user_main(S32 argc, PPS8 argv)
 	acquire_wake_lock(PARTIAL_WAKE_LOCK, PROGRAM_NAME);
 #endif
 
-	if (init_driver (g_drv_name, eeprom_file_name, init_file_name, firmware_file_name) != 0) {
+	if (init_driver (g_drv_name, eeprom_file_name, init_file_name, firmware_file_name, blob_file_name) != 0) {
 #ifdef ANDROID
 		check_and_set_property("wlan.driver.status", "failed");
 		release_wake_lock(PROGRAM_NAME);
@@ -54,6 +54,7 @@
  *****************************************************************************/
 
 static TI_STATUS    cmdQueue_SM (TI_HANDLE hCmdQueue, ECmdQueueSmEvents event);
+static TI_STATUS    cmdQueue_PostCommand (TCmdQueue *pCmdQueue, TCmdQueueNode *pNode);
 static TI_STATUS    cmdQueue_Push (TI_HANDLE  hCmdQueue,
                                    Command_e  cmdType,
                                    TI_UINT8   *pParamsBuf,
@@ -63,6 +64,8 @@ static TI_STATUS    cmdQueue_Push (TI_HANDLE  hCmdQueue,
                                    void       *pCb);
 #ifdef TI_DBG
 static void         cmdQueue_PrintQueue(TCmdQueue  *pCmdQueue);
+static void         cmdQueue_UpdateLatencyHist (TI_UINT32 *pHist, TI_UINT32 uLatency);
+static void         cmdQueue_PrintHistograms (TCmdQueue *pCmdQueue);
 #ifdef REPORT_LOG
 static char *       cmdQueue_GetIEString (TI_INT32 MboxCmdType, TI_UINT16 id);
 static char *       cmdQueue_GetCmdString (TI_INT32 MboxCmdType);
@@ -70,6 +73,12 @@ static char *       cmdQueue_GetCmdString (TI_INT32 MboxCmdType);
 #endif /* TI_DBG */
 
 
+#ifdef TI_DBG
+/* Upper limits (usec) of the latency histogram bins, the last bin counts all the rest */
+static const TI_UINT32 aLatencyHistLimit [CMDQUEUE_LATENCY_HIST_SIZE - 1] = {250, 500, 1000, 2000, 5000, 10000, 50000};
+/* Upper limits of the queue depth histogram bins, the last bin counts all the rest */
+static const TI_UINT32 aDepthHistLimit [CMDQUEUE_DEPTH_HIST_SIZE - 1] = {1, 2, 4, 8, 16};
+#endif
 
 
 /*
@@ -160,6 +169,8 @@ TI_STATUS cmdQueue_Init   (TI_HANDLE hCmdQueue,
 	pCmdQueue->bErrorFlag = TI_FALSE;
 	pCmdQueue->bMboxEnabled = TI_FALSE;
 	pCmdQueue->bAwake = TI_FALSE;
+	pCmdQueue->uPostedCmds = 0;
+	pCmdQueue->bPipelineEnabled = TI_TRUE;
 
 	/* Configure Command Mailbox */
 	cmdMbox_Init (hCmdMbox, hReport, hTwIf,
@@ -193,7 +204,6 @@ static TI_STATUS cmdQueue_SM (TI_HANDLE hCmdQueue, ECmdQueueSmEvents eCmdQueueEv
 	TI_BOOL        bBreakWhile = TI_FALSE;
 	TI_STATUS      rc = TI_OK, status;
 	TCmdQueueNode *pHead;
-	TI_UINT32      uReadLen, uWriteLen;
 
 	while (!bBreakWhile) {
 		switch (pCmdQueue->state) {
@@ -204,10 +214,6 @@ static TI_STATUS cmdQueue_SM (TI_HANDLE hCmdQueue, ECmdQueueSmEvents eCmdQueueEv
 
 				pHead = &pCmdQueue->aCmdQueue[pCmdQueue->head];
 
-#ifdef TI_DBG
-				pCmdQueue->uCmdSendCounter++;
-#endif
-
 				/*
 				 * if bAwake is true, then we reached here because there were more commands
 				 * in the queue after sending a previous command.
@@ -219,27 +225,9 @@ static TI_STATUS cmdQueue_SM (TI_HANDLE hCmdQueue, ECmdQueueSmEvents eCmdQueueEv
 					pCmdQueue->bAwake = TI_TRUE;
 				}
 
-				if (pHead->cmdType == CMD_INTERROGATE) {
-					uWriteLen = CMDQUEUE_INFO_ELEM_HEADER_LEN;
-					/* Will be updated by CmdMbox to count the status response */
-					uReadLen = pHead->uParamsLen;
-				} else if (pHead->cmdType == CMD_TEST) {
-					/* CMD_TEST has configure & interrogate abillities together */
-					uWriteLen = pHead->uParamsLen;
-					/* Will be updated by CmdMbox to count the status response */
-					uReadLen = pHead->uParamsLen;
-				} else { /* CMD_CONFIGURE or others */
-					uWriteLen = pHead->uParamsLen;
-					/* Will be updated by CmdMbox to count the status response */
-					uReadLen = 0;
-
-				}
 				/* send the command to TNET */
-				rc = cmdMbox_SendCommand (pCmdQueue->hCmdMBox,
-				                          pHead->cmdType,
-				                          pHead->aParamsBuf,
-				                          uWriteLen,
-				                          uReadLen);
+				pCmdQueue->uPostedCmds = 1;
+				rc = cmdQueue_PostCommand (pCmdQueue, pHead);
 
 				bBreakWhile = TI_TRUE;
 
@@ -270,6 +258,18 @@ static TI_STATUS cmdQueue_SM (TI_HANDLE hCmdQueue, ECmdQueueSmEvents eCmdQueueEv
 
 				pHead = &pCmdQueue->aCmdQueue[pCmdQueue->head];
 
+#ifdef TI_DBG
+				{
+					TI_UINT32 uNow = os_timeStampUs (pCmdQueue->hOs);
+
+					if (uNow - pHead->uPostTime > pCmdQueue->uMaxMboxLatency) {
+						pCmdQueue->uMaxMboxLatency = uNow - pHead->uPostTime;
+					}
+					cmdQueue_UpdateLatencyHist (pCmdQueue->aMboxLatencyHist, uNow - pHead->uPostTime);
+					cmdQueue_UpdateLatencyHist (pCmdQueue->aTotalLatencyHist, uNow - pHead->uPushTime);
+				}
+#endif
+
 				/* Keep callback parameters in temporary variables */
 				cmdType = pHead->cmdType;
 				uParam  = *(TI_UINT16 *)pHead->aParamsBuf;
@@ -285,6 +285,8 @@ static TI_STATUS cmdQueue_SM (TI_HANDLE hCmdQueue, ECmdQueueSmEvents eCmdQueueEv
 				if (pCmdQueue->head >= CMDQUEUE_QUEUE_DEPTH)
 					pCmdQueue->head = 0;
 				pCmdQueue->uNumberOfCommandInQueue --;
+				if (pCmdQueue->uPostedCmds > 0)
+					pCmdQueue->uPostedCmds --;
 
 #ifdef TI_DBG
 				pCmdQueue->uCmdCompltCounter++;
@@ -324,7 +326,10 @@ static TI_STATUS cmdQueue_SM (TI_HANDLE hCmdQueue, ECmdQueueSmEvents eCmdQueueEv
 				}
 
 				/* Check if there are any more commands in queue */
-				if (pCmdQueue->uNumberOfCommandInQueue > 0) {
+				if (pCmdQueue->uPostedCmds > 0) {
+					/* The next command was already posted (pipelined), wait for its completion */
+					bBreakWhile = TI_TRUE;
+				} else if (pCmdQueue->uNumberOfCommandInQueue > 0) {
 					/* If queue isn't empty, send the next command */
 					pCmdQueue->state = CMDQUEUE_STATE_IDLE;
 					eCmdQueueEvent = CMDQUEUE_EVENT_RUN;
@@ -358,6 +363,99 @@ static TI_STATUS cmdQueue_SM (TI_HANDLE hCmdQueue, ECmdQueueSmEvents eCmdQueueEv
 }
 
 
+/*
+ * \brief	Post a queued command to the cmdMbox
+ *
+ * \param  pCmdQueue - Pointer to TCmdQueue
+ * \param  pNode - The queue node of the command to send
+ * \return The cmdMbox_SendCommand status
+ *
+ * \par Description
+ * Sets the write & read lengths according to the command type and sends it to the mailbox.
+ *
+ * \sa cmdQueue_SM, cmdQueue_ResultPending
+ */
+static TI_STATUS cmdQueue_PostCommand (TCmdQueue *pCmdQueue, TCmdQueueNode *pNode)
+{
+	TI_UINT32 uReadLen, uWriteLen;
+
+#ifdef TI_DBG
+	pCmdQueue->uCmdSendCounter++;
+	pNode->uPostTime = os_timeStampUs (pCmdQueue->hOs);
+#endif
+
+	if (pNode->cmdType == CMD_INTERROGATE) {
+		uWriteLen = CMDQUEUE_INFO_ELEM_HEADER_LEN;
+		/* Will be updated by CmdMbox to count the status response */
+		uReadLen = pNode->uParamsLen;
+	} else if (pNode->cmdType == CMD_TEST) {
+		/* CMD_TEST has configure & interrogate abillities together */
+		uWriteLen = pNode->uParamsLen;
+		/* Will be updated by CmdMbox to count the status response */
+		uReadLen = pNode->uParamsLen;
+	} else { /* CMD_CONFIGURE or others */
+		uWriteLen = pNode->uParamsLen;
+		/* Will be updated by CmdMbox to count the status response */
+		uReadLen = 0;
+	}
+
+	return cmdMbox_SendCommand (pCmdQueue->hCmdMBox,
+	                            pNode->cmdType,
+	                            pNode->aParamsBuf,
+	                            uWriteLen,
+	                            uReadLen);
+}
+
+
+/*
+ * \brief	Notify the CmdQueue that the current command result read was posted.
+ *
+ * \param  hCmdQueue - Handle to CmdQueue
+ * \return TI_OK
+ *
+ * \par Description
+ * The result read is queued on the bus before any later mailbox write, so a configure
+ * command with no readback doesn't have to wait for its status before the next command
+ * is sent. Post the next command now, and check the current one status in the
+ * CMDQUEUE_EVENT_COMPLETE handling when the read is done.
+ * The FW handles one mailbox command at a time, so at most one command is pipelined.
+ *
+ * \sa cmdQueue_ResultReceived, cmdMbox_CommandComplete
+ */
+TI_STATUS cmdQueue_ResultPending (TI_HANDLE hCmdQueue)
+{
+	TCmdQueue     *pCmdQueue = (TCmdQueue*)hCmdQueue;
+	TCmdQueueNode *pHead;
+	TI_UINT32      uNext;
+
+	if ((!pCmdQueue->bPipelineEnabled) ||
+	        (pCmdQueue->state != CMDQUEUE_STATE_WAIT_FOR_COMPLETION) ||
+	        (pCmdQueue->uPostedCmds != 1) ||
+	        (pCmdQueue->uNumberOfCommandInQueue < CMDQUEUE_MAX_POSTED_CMDS)) {
+		return TI_OK;
+	}
+
+	/* Only a configure command with no readback is completed with a deferred status check */
+	pHead = &pCmdQueue->aCmdQueue[pCmdQueue->head];
+	if ((pHead->cmdType != CMD_CONFIGURE) || (pHead->pInterrogateBuf != NULL)) {
+		return TI_OK;
+	}
+
+	uNext = pCmdQueue->head + 1;
+	if (uNext >= CMDQUEUE_QUEUE_DEPTH)
+		uNext = 0;
+
+	pCmdQueue->uPostedCmds = CMDQUEUE_MAX_POSTED_CMDS;
+#ifdef TI_DBG
+	pCmdQueue->uPipelinedCounter++;
+#endif
+
+	cmdQueue_PostCommand (pCmdQueue, &pCmdQueue->aCmdQueue[uNext]);
+
+	return TI_OK;
+}
+
+
 /*
  * \brief	Sends the command to the cmdMbox
  *
@@ -454,6 +552,9 @@ static TI_STATUS cmdQueue_Push (TI_HANDLE  hCmdQueue,
 	               uParamsLen);
 
 	pCmdQueue->aCmdQueue[pCmdQueue->tail].pInterrogateBuf = (TI_UINT8 *)pCb;
+#ifdef TI_DBG
+	pCmdQueue->aCmdQueue[pCmdQueue->tail].uPushTime = os_timeStampUs (pCmdQueue->hOs);
+#endif
 
 	/* Advance the queue tail*/
 	pCmdQueue->tail++;
@@ -467,6 +568,15 @@ static TI_STATUS cmdQueue_Push (TI_HANDLE  hCmdQueue,
 	if (pCmdQueue->uMaxNumberOfCommandInQueue < pCmdQueue->uNumberOfCommandInQueue) {
 		pCmdQueue->uMaxNumberOfCommandInQueue = pCmdQueue->uNumberOfCommandInQueue;
 	}
+	{
+		TI_UINT32 uBin;
+
+		for (uBin = 0; uBin < CMDQUEUE_DEPTH_HIST_SIZE - 1; uBin++) {
+			if (pCmdQueue->uNumberOfCommandInQueue <= aDepthHistLimit[uBin])
+				break;
+		}
+		pCmdQueue->aDepthHist[uBin]++;
+	}
 #endif /* TI_DBG*/
 
 #ifdef CMDQUEUE_DEBUG_PRINT
@@ -531,6 +641,7 @@ TI_STATUS cmdQueue_Restart (TI_HANDLE hCmdQueue)
 	*/
 	pCmdQueue->state = CMDQUEUE_STATE_IDLE;
 	pCmdQueue->bAwake = TI_FALSE;
+	pCmdQueue->uPostedCmds = 0;
 
 
 	/*
@@ -781,6 +892,8 @@ void cmdQueue_Print (TI_HANDLE hCmdQueue)
 	                pCmdQueue->uCmdSendCounter));
 	WLAN_OS_REPORT(("cmdQueue_Print:The Total number of Cmd Completed interrupt= %d\n",
 	                pCmdQueue->uCmdCompltCounter));
+	WLAN_OS_REPORT(("cmdQueue_Print:The Total number of pipelined Cmd = %d, Posted now = %d\n",
+	                pCmdQueue->uPipelinedCounter, pCmdQueue->uPostedCmds));
 
 	cmdQueue_PrintQueue (pCmdQueue);
 }
@@ -861,11 +974,78 @@ void cmdQueue_PrintHistory (TI_HANDLE hCmdQueue, TI_UINT32 uNumOfCmd)
 		}
 	}
 
+	cmdQueue_PrintHistograms (pCmdQueue);
+
 	WLAN_OS_REPORT(("-----------------------------------------------------------------------\n"));
 #endif
 }
 
 
+/*
+ * \brief	Add a command latency sample to a latency histogram
+ *
+ * \param  pHist - The histogram bins
+ * \param  uLatency - The command latency in usec
+ * \return void
+ *
+ * \par Description
+ * Used for debugging purposes
+ *
+ * \sa cmdQueue_PrintHistograms
+ */
+static void cmdQueue_UpdateLatencyHist (TI_UINT32 *pHist, TI_UINT32 uLatency)
+{
+	TI_UINT32 uBin;
+
+	for (uBin = 0; uBin < CMDQUEUE_LATENCY_HIST_SIZE - 1; uBin++) {
+		if (uLatency < aLatencyHistLimit[uBin])
+			break;
+	}
+	pHist[uBin]++;
+}
+
+
+/*
+ * \brief	Print the command latency & queue depth histograms
+ *
+ * \param  pCmdQueue - Pointer to TCmdQueue
+ * \return void
+ *
+ * \par Description
+ * Used for debugging purposes
+ *
+ * \sa cmdQueue_PrintHistory
+ */
+static void cmdQueue_PrintHistograms (TCmdQueue *pCmdQueue)
+{
+	TI_UINT32 uBin;
+
+	WLAN_OS_REPORT(("Sent = %d, Completed = %d, Pipelined = %d, Max Mbox latency = %d usec\n",
+	                pCmdQueue->uCmdSendCounter, pCmdQueue->uCmdCompltCounter,
+	                pCmdQueue->uPipelinedCounter, pCmdQueue->uMaxMboxLatency));
+
+	WLAN_OS_REPORT(("Latency (usec)      Mbox (post-complete)   Total (push-complete)\n"));
+	for (uBin = 0; uBin < CMDQUEUE_LATENCY_HIST_SIZE; uBin++) {
+		if (uBin < CMDQUEUE_LATENCY_HIST_SIZE - 1) {
+			WLAN_OS_REPORT(("  < %6d          %10d             %10d\n", aLatencyHistLimit[uBin],
+			                pCmdQueue->aMboxLatencyHist[uBin], pCmdQueue->aTotalLatencyHist[uBin]));
+		} else {
+			WLAN_OS_REPORT((" >= %6d          %10d             %10d\n", aLatencyHistLimit[uBin - 1],
+			                pCmdQueue->aMboxLatencyHist[uBin], pCmdQueue->aTotalLatencyHist[uBin]));
+		}
+	}
+
+	WLAN_OS_REPORT(("Queue depth on push     Commands\n"));
+	for (uBin = 0; uBin < CMDQUEUE_DEPTH_HIST_SIZE; uBin++) {
+		if (uBin < CMDQUEUE_DEPTH_HIST_SIZE - 1) {
+			WLAN_OS_REPORT(("  <= %2d            %10d\n", aDepthHistLimit[uBin], pCmdQueue->aDepthHist[uBin]));
+		} else {
+			WLAN_OS_REPORT(("   > %2d            %10d\n", aDepthHistLimit[uBin - 1], pCmdQueue->aDepthHist[uBin]));
+		}
+	}
+}
+
+
 #ifdef REPORT_LOG
 /*
  * \brief	Interperts the command's type to the command's name
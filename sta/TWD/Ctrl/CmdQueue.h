@@ -50,6 +50,9 @@
 #define CMDQUEUE_QUEUE_DEPTH          30
 #define CMDQUEUE_HISTORY_DEPTH        5
 #define CMDQUEUE_INFO_ELEM_HEADER_LEN 4
+#define CMDQUEUE_MAX_POSTED_CMDS      2     /* the current command and one pipelined command */
+#define CMDQUEUE_LATENCY_HIST_SIZE    8
+#define CMDQUEUE_DEPTH_HIST_SIZE      6
 
 
 #define RC_CONVERT(rc) \
@@ -88,6 +91,11 @@ typedef struct {
 	TI_UINT8                aParamsBuf[MAX_CMD_PARAMS];
 	/* A returned value buffer */
 	TI_UINT8*               pInterrogateBuf;
+#ifdef TI_DBG
+	/* Timestamps for the latency histograms */
+	TI_UINT32               uPushTime;
+	TI_UINT32               uPostTime;
+#endif
 
 } TCmdQueueNode;
 
@@ -139,9 +147,19 @@ typedef struct {
 	TI_UINT32               uNumberOfCommandInQueue;
 	TI_UINT32               uMaxNumberOfCommandInQueue;
 	TI_UINT32               uNumberOfRecoveryNodes;
+	/* Number of commands from the head that were posted to the mailbox */
+	TI_UINT32               uPostedCmds;
+	/* Post the next configure command while the previous result is read */
+	TI_BOOL                 bPipelineEnabled;
 #ifdef TI_DBG
 	TI_UINT32               uCmdSendCounter;
 	TI_UINT32               uCmdCompltCounter;
+	TI_UINT32               uPipelinedCounter;
+	TI_UINT32               uMaxMboxLatency;
+	/* Mailbox latency (post to complete), total latency (push to complete) and queue depth histograms */
+	TI_UINT32               aMboxLatencyHist [CMDQUEUE_LATENCY_HIST_SIZE];
+	TI_UINT32               aTotalLatencyHist [CMDQUEUE_LATENCY_HIST_SIZE];
+	TI_UINT32               aDepthHist [CMDQUEUE_DEPTH_HIST_SIZE];
 #endif
 
 	/* Error handling */
@@ -206,6 +206,23 @@ TI_STATUS cmdQueue_SendCommand (TI_HANDLE  hCmdQueue,
 TI_STATUS cmdQueue_ResultReceived (TI_HANDLE hCmdQueue);
 
 
+/*
+ * \brief	Notify the CmdQueue that the current command result read was posted.
+ *
+ * \param  hCmdQueue - Handle to CmdQueue
+ * \return TI_OK
+ *
+ * \par Description
+ * Called by the CmdMbox when the result read of the current command is pending on the bus.
+ * If the current command is a configure command with no readback, the next queued command
+ * is posted to the mailbox right away, and the current command status is checked when
+ * the read completes (cmdQueue_ResultReceived).
+ *
+ * \sa cmdQueue_ResultReceived
+ */
+TI_STATUS cmdQueue_ResultPending (TI_HANDLE hCmdQueue);
+
+
 /*
  * \brief	Returns maximum number of commands (ever) in TCmdQueue queue
  *
@@ -67,6 +67,7 @@
  */
 static void cmdMbox_TimeOut (TI_HANDLE hCmdMbox, TI_BOOL bTwdInitOccured);
 static void cmdMbox_ConfigHwCb (TI_HANDLE hCmdMbox, TTxnStruct *pTxn);
+static void cmdMbox_ReadResult (TCmdMbox *pCmdMbox);
 
 /*
  * \brief	Create the mailbox object
@@ -156,6 +157,8 @@ TI_STATUS cmdMbox_Init (TI_HANDLE hCmdMbox,
 	pCmdMbox->uReadLen = 0;
 	pCmdMbox->uWriteLen = 0;
 	pCmdMbox->bCmdInProgress = TI_FALSE;
+	pCmdMbox->bReadPending = TI_FALSE;
+	pCmdMbox->bCompletePending = TI_FALSE;
 	pCmdMbox->fErrorCb = fErrorCb;
 
 	/* allocate OS timer memory */
@@ -258,26 +261,61 @@ TI_STATUS cmdMbox_SendCommand       (TI_HANDLE hCmdMbox, Command_e cmdType, TI_U
 ETxnStatus cmdMbox_CommandComplete (TI_HANDLE hCmdMbox)
 {
 	TCmdMbox   *pCmdMbox = (TCmdMbox *)hCmdMbox;
+
+	/* stop the CmdMbox timer */
+	tmr_StopTimer(pCmdMbox->hCmdMboxTimer);
+
+	/*
+	 * If the previous (pipelined) command result read is still pending, this command
+	 *   result is read when it completes, so the read buffer isn't overrun
+	 */
+	if (pCmdMbox->bReadPending) {
+		pCmdMbox->bCompletePending = TI_TRUE;
+		return TXN_STATUS_COMPLETE;
+	}
+
+	cmdMbox_ReadResult (pCmdMbox);
+
+	return TXN_STATUS_COMPLETE;
+}
+
+
+/*
+ * \brief	Issue the command's result read
+ *
+ * \param  pCmdMbox  - Pointer to CmdMbox
+ * \return void
+ *
+ * \par Description
+ * The read is queued on the bus before any later mailbox write, so once it is issued the
+ * mailbox may take the next command. On an async read the CmdQueue is notified, so it can
+ * post its next command while the read is in progress.
+ *
+ * \sa cmdMbox_CommandComplete, cmdMbox_TransferComplete, cmdQueue_ResultPending
+ */
+static void cmdMbox_ReadResult (TCmdMbox *pCmdMbox)
+{
 	TTxnStruct *pCmdTxn = (TTxnStruct*)&pCmdMbox->aCmdTxn[1].tTxnStruct;
 	Command_t  *pCmd = (Command_t*)&pCmdMbox->aCmdTxn[1].tCmdMbox;
 	ETxnStatus  rc;
 
-	/* stop the CmdMbox timer */
-	tmr_StopTimer(pCmdMbox->hCmdMboxTimer);
+	/* Other commands can be sent to the FW */
+	pCmdMbox->bCmdInProgress = TI_FALSE;
+	pCmdMbox->bReadPending = TI_TRUE;
 
 	/* Build the command TxnStruct */
 	TXN_PARAM_SET(pCmdTxn, TXN_LOW_PRIORITY, TXN_FUNC_ID_WLAN, TXN_DIRECTION_READ, TXN_INC_ADDR)
 	/* Applying a CB in case of an async read */
-	BUILD_TTxnStruct(pCmdTxn, pCmdMbox->uFwAddr, pCmd, pCmdMbox->uReadLen,(TTxnDoneCb)cmdMbox_TransferComplete, hCmdMbox)
+	BUILD_TTxnStruct(pCmdTxn, pCmdMbox->uFwAddr, pCmd, pCmdMbox->uReadLen,(TTxnDoneCb)cmdMbox_TransferComplete, (TI_HANDLE)pCmdMbox)
 	/* Send the command */
 	rc = twIf_Transact(pCmdMbox->hTwIf, pCmdTxn);
 
 	/* In case of a sync read, call the CB directly */
 	if (rc == TXN_STATUS_COMPLETE) {
-		cmdMbox_TransferComplete(hCmdMbox);
+		cmdMbox_TransferComplete((TI_HANDLE)pCmdMbox);
+	} else {
+		cmdQueue_ResultPending(pCmdMbox->hCmdQueue);
 	}
-
-	return TXN_STATUS_COMPLETE;
 }
 
 
@@ -288,21 +326,25 @@ ETxnStatus cmdMbox_CommandComplete (TI_HANDLE hCmdMbox)
  * \return TI_OK
  *
  * \par Description
- * This function is called from cmdMbox_CommandComplete on a sync read, or from TwIf as a CB on an async read.
- * It calls cmdQueue_ResultReceived to continue the result handling procces & switch the bCmdInProgress flag to TI_FALSE,
- * meaning other commands can be sent to the FW.
+ * This function is called from cmdMbox_ReadResult on a sync read, or from TwIf as a CB on an async read.
+ * It calls cmdQueue_ResultReceived to continue the result handling procces, and then reads the
+ * result of a pipelined command that completed meanwhile.
  *
- * \sa cmdMbox_SendCommand, cmdMbox_TransferComplete
+ * \sa cmdMbox_SendCommand, cmdMbox_ReadResult
  */
 TI_STATUS cmdMbox_TransferComplete(TI_HANDLE hCmdMbox)
 {
 	TCmdMbox   *pCmdMbox = (TCmdMbox *)hCmdMbox;
 
-	/* Other commands can be sent to the FW */
-	pCmdMbox->bCmdInProgress = TI_FALSE;
+	pCmdMbox->bReadPending = TI_FALSE;
 
 	cmdQueue_ResultReceived(pCmdMbox->hCmdQueue);
 
+	if (pCmdMbox->bCompletePending) {
+		pCmdMbox->bCompletePending = TI_FALSE;
+		cmdMbox_ReadResult (pCmdMbox);
+	}
+
 	return TI_OK;
 }
 
@@ -406,6 +448,8 @@ TI_STATUS cmdMbox_Restart (TI_HANDLE hCmdMbox)
 	/* Stop the timeout timer if running and reset the state */
 	tmr_StopTimer (pCmdMbox->hCmdMboxTimer);
 	pCmdMbox->bCmdInProgress = TI_FALSE;
+	pCmdMbox->bReadPending   = TI_FALSE;
+	pCmdMbox->bCompletePending = TI_FALSE;
 	pCmdMbox->uReadLen       = 0;
 	pCmdMbox->uWriteLen      = 0;
 
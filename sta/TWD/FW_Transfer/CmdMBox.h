@@ -94,6 +94,10 @@ typedef struct {
 
 	/* Holds the module state */
 	TI_BOOL             bCmdInProgress;
+	/* A result read is pending on the bus */
+	TI_BOOL             bReadPending;
+	/* A command complete arrived while the previous result read was pending */
+	TI_BOOL             bCompletePending;
 	TI_UINT32           uFwAddr;
 	TI_UINT32           uWriteLen;
 	TI_UINT32           uReadLen;
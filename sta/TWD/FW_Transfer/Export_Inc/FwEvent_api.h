@@ -42,6 +42,8 @@
 #ifndef _FW_EVENT_API_H
 #define _FW_EVENT_API_H
 
+#include "TWDriver.h"
+
 /* Public Function Definitions */
 
 /*
@@ -221,6 +223,21 @@ void            fwEvent_EnableExternalEvents(TI_HANDLE hFwEvent);
 void            fwEvent_SetInitMask         (TI_HANDLE hFwEvent);
 
 
+/*
+ * \brief	Get the FW interrupts counter
+ *
+ * \param  hFwEvent  - FwEvent Driver handle
+ * \param  pStats    - The TWD transfer statistics to fill
+ * \return void
+ *
+ * \par Description
+ * Fill the number of FW interrupts handled since the driver was loaded.
+ *
+ * \sa     TWD_GetXferStats
+ */
+void            fwEvent_GetStats            (TI_HANDLE hFwEvent, TTwdXferStats *pStats);
+
+
 
 #ifdef TI_DBG
 
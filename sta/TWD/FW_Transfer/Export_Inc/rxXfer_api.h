@@ -73,6 +73,8 @@ void                rxXfer_RegisterErrCb (TI_HANDLE hRxXfer, void *fErrCb, TI_HA
 
 void                rxXfer_Restart (TI_HANDLE hRxXfer);
 
+void                rxXfer_GetStats (TI_HANDLE hRxXfer, TTwdXferStats *pStats);
+
 
 #ifdef TI_DBG
 
@@ -189,6 +189,21 @@ ETxnStatus txXfer_SendPacket (TI_HANDLE hTxXfer, TTxCtrlBlk *pPktCtrlBlk);
  */
 void txXfer_EndOfBurst (TI_HANDLE hTxXfer);
 
+/**
+ * \fn     txXfer_GetStats
+ * \brief  Get the Tx transfer counters
+ *
+ * Fill the Tx packets and transactions counters of the TWD transfer statistics.
+ * The counters are cleared on recovery (txXfer_Restart).
+ *
+ * \note
+ * \param  hTxXfer - module handle
+ * \param  pStats  - The statistics structure to fill
+ * \return void
+ * \sa     TWD_GetXferStats
+ */
+void txXfer_GetStats (TI_HANDLE hTxXfer, TTwdXferStats *pStats);
+
 
 
 #ifdef TI_DBG
@@ -120,6 +120,7 @@ typedef struct {
 	TI_UINT32           uContextId;     /* Client ID got upon registration to the context module */
 	TI_BOOL             bIntrPending;   /* If TRUE a new interrupt is pending while handling the previous one */
 	TI_UINT32           uNumPendHndlrs; /* Number of event handlers that didn't complete their event processing */
+	TI_UINT32           uNumInterrupts; /* Number of FW interrupts handled in the driver context */
 
 	/* Other modules handles */
 	TI_HANDLE           hOs;
@@ -309,6 +310,8 @@ static void fwEvent_NewEvent (TI_HANDLE hFwEvent)
 {
 	TfwEvent *pFwEvent = (TfwEvent *)hFwEvent;
 
+	pFwEvent->uNumInterrupts++;
+
 	/* If the SM is idle, call it to start handling new events */
 	if (pFwEvent->eSmState == FWEVENT_STATE_IDLE) {
 
@@ -735,6 +738,26 @@ void fwEvent_EnableInterrupts(TI_HANDLE hFwEvent)
 }
 
 
+/*
+ * \brief	Get the FW interrupts counter
+ *
+ * \param  hFwEvent  - FwEvent Driver handle
+ * \param  pStats    - The TWD transfer statistics to fill
+ * \return void
+ *
+ * \par Description
+ * Fill the number of FW interrupts handled since the driver was loaded.
+ *
+ * \sa
+ */
+void fwEvent_GetStats (TI_HANDLE hFwEvent, TTwdXferStats *pStats)
+{
+	TfwEvent  *pFwEvent = (TfwEvent *)hFwEvent;
+
+	pStats->uFwInterrupts = pFwEvent->uNumInterrupts;
+}
+
+
 
 #ifdef TI_DBG
 
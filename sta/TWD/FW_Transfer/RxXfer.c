@@ -109,6 +109,7 @@ typedef struct {
 	TI_UINT32           aRxPktsDesc[NUM_RX_PKT_DESC];           /* Save Rx packets short descriptors from FwStatus */
 	TI_UINT32           uFwRxCntr;                              /* Save last FW packets counter from FwStatus */
 	TI_UINT32           uDrvRxCntr;                             /* The current driver processed packets counter */
+	TI_UINT32           uNumXfers;                              /* Number of Rx read transactions issued */
 	TI_UINT32           uPacketMemoryPoolStart;                 /* The FW mem-blocks area base address */
 	TI_UINT32           uMaxAggregLen;                          /* The max length in bytes of aggregated packets transaction */
 	TI_UINT32           uMaxAggregPkts;                         /* The max number of packets that may be aggregated in one transaction */
@@ -612,6 +613,7 @@ static ETxnStatus rxXfer_IssueTxn (TI_HANDLE hRxXfer, TI_UINT32 uFirstMemBlkAddr
 
 	/* Issue the packet(s) read transaction (prepared in rxXfer_Handle) */
 	pTxn = &pRxXfer->aTxnStruct[uIndex];
+	pRxXfer->uNumXfers++;
 	eStatus = twIf_Transact(pRxXfer->hTwIf, pTxn);
 
 	/* Write driver packets counter to FW. This write automatically generates interrupt to FW */
@@ -719,6 +721,7 @@ void rxXfer_Restart(TI_HANDLE hRxXfer)
 
 	pRxXfer->uFwRxCntr     = 0;
 	pRxXfer->uDrvRxCntr    = 0;
+	pRxXfer->uNumXfers     = 0;
 	pRxXfer->uCurrTxnIndex = 0;
 	pRxXfer->uAvailableTxn = MAX_CONSECUTIVE_READ_TXN - 1;
 
@@ -793,6 +796,27 @@ void rxXfer_RegisterErrCb (TI_HANDLE hRxXfer, void *fErrCb, TI_HANDLE hErrCb)
 }
 
 
+/****************************************************************************
+ *                      rxXfer_GetStats()
+ ****************************************************************************
+ * DESCRIPTION: Fill the Rx part of the TWD transfer statistics
+ *
+ * INPUTS:
+ *          hRxXfer - The object
+ *
+ * OUTPUT:  pStats  - The Rx packets and read transactions counters
+ *
+ * RETURNS: void
+ ****************************************************************************/
+void rxXfer_GetStats (TI_HANDLE hRxXfer, TTwdXferStats *pStats)
+{
+	TRxXfer *pRxXfer = (TRxXfer *)hRxXfer;
+
+	pStats->uRxPkts  = pRxXfer->uDrvRxCntr;
+	pStats->uRxXfers = pRxXfer->uNumXfers;
+}
+
+
 #ifdef TI_DBG
 /****************************************************************************
  *                      rxXfer_ClearStats()
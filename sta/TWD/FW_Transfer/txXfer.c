@@ -80,6 +80,7 @@ typedef struct {
 	TTxnDoneCb              fXferCompleteLocalCb;    /* TxXfer local CB for pkt transfer completion (NULL is not needed!) */
 	TI_UINT32               uPktsCntr;               /* Counts all Tx packets. Written to FW after each packet transaction */
 	TI_UINT32               uPktsCntrTxnIndex;       /* The current indext of the aPktsCntrTxn[] used for the counter workaround transactions */
+	TI_UINT32               uNumXfers;               /* Counts the aggregated packets transactions */
 	TPktsCntrTxn            aPktsCntrTxn[CTRL_BLK_ENTRIES_NUM]; /* Transaction structures for sending the packets counter */
 #ifdef TI_DBG
 	TI_UINT32               aDbgCountPktAggreg[DBG_MAX_AGGREG_PKTS];
@@ -155,6 +156,7 @@ TI_STATUS txXfer_Restart (TI_HANDLE hTxXfer)
 	pTxXfer->uPktsCntr         = 0;
 	pTxXfer->uPktsCntrTxnIndex = 0;
 	pTxXfer->uAggregPktsNum    = 0;
+	pTxXfer->uNumXfers         = 0;
 
 	return TI_OK;
 }
@@ -176,6 +178,15 @@ void txXfer_SetBusParams (TI_HANDLE hTxXfer, TI_UINT32 uDmaBufLen)
 }
 
 
+void txXfer_GetStats (TI_HANDLE hTxXfer, TTwdXferStats *pStats)
+{
+	TTxXferObj *pTxXfer = (TTxXferObj *)hTxXfer;
+
+	pStats->uTxPkts  = pTxXfer->uPktsCntr;
+	pStats->uTxXfers = pTxXfer->uNumXfers;
+}
+
+
 void txXfer_RegisterCb (TI_HANDLE hTxXfer, TI_UINT32 CallBackID, void *CBFunc, TI_HANDLE CBObj)
 {
 	TTxXferObj* pTxXfer = (TTxXferObj*)hTxXfer;
@@ -319,6 +330,7 @@ static ETxnStatus txXfer_SendAggregatedPkts (TTxXferObj *pTxXfer, TI_BOOL bLastP
 	/* Write packet counter to FW (generates an interrupt).
 	   Note: This may be removed once the host-slave HW counter functionality is verified */
 	pTxXfer->uPktsCntr += pTxXfer->uAggregPktsNum;
+	pTxXfer->uNumXfers++;
 	pTxXfer->uPktsCntrTxnIndex++;
 	if (pTxXfer->uPktsCntrTxnIndex == CTRL_BLK_ENTRIES_NUM) {
 		pTxXfer->uPktsCntrTxnIndex = 0;
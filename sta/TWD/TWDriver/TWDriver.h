@@ -1622,6 +1622,23 @@ typedef struct {
 
 } TFwInfo;
 
+/** \struct TTwdXferStats
+ * \brief Bus Transfer Statistics
+ *
+ * \par Description
+ * Free running counters of the FW interface (the Rx/Tx counters are cleared on recovery)
+ *
+ * \sa	TWD_GetXferStats
+ */
+typedef struct {
+	TI_UINT32                           uFwInterrupts;			/**< Number of FW interrupts handled						*/
+	TI_UINT32                           uRxPkts;				/**< Number of Rx packets read from the FW					*/
+	TI_UINT32                           uRxXfers;				/**< Number of Rx read transactions (may aggregate packets)	*/
+	TI_UINT32                           uTxPkts;				/**< Number of Tx packets written to the FW					*/
+	TI_UINT32                           uTxXfers;				/**< Number of Tx write transactions (may aggregate packets)	*/
+
+} TTwdXferStats;
+
 /** \struct TJoinBss
  * \brief Join BSS Parameters
  *
@@ -3570,6 +3587,19 @@ TI_BOOL TWD_GetPsStatus (TI_HANDLE hTWD);
  * \sa TFwInfo
  */
 TFwInfo* TWD_GetFWInfo (TI_HANDLE hTWD);
+/** @ingroup Control
+ * \brief  Get Bus Transfer Statistics
+ *
+ * \param  hTWD    	- TWD module object handle
+ * \param  pStats 	- Pointer to Output Transfer Statistics
+ * \return void
+ *
+ * \par Description
+ * Reads the FW interrupts and Rx/Tx transfer counters of the FwEvent, RxXfer and TxXfer modules
+ *
+ * \sa TTwdXferStats
+ */
+void TWD_GetXferStats (TI_HANDLE hTWD, TTwdXferStats *pStats);
 /** @ingroup BSS
  * \brief	Get Group Address Table
  *
@@ -3898,6 +3928,8 @@ TI_STATUS TWD_CmdApDiscoveryStop (TI_HANDLE hTWD);
  * \brief	Helth Check
  *
  * \param  hTWD    			- TWD module object handle
+ * \param  fCb    			- Command complete callback (TCmdResponseCb), may be NULL
+ * \param  hCb    			- Handle for the callback
  * \return TI_OK on success or TI_NOK on failure
  *
  * \par Description
@@ -3905,7 +3937,7 @@ TI_STATUS TWD_CmdApDiscoveryStop (TI_HANDLE hTWD);
  *
  * \sa
  */
-TI_STATUS TWD_CmdHealthCheck (TI_HANDLE hTWD);
+TI_STATUS TWD_CmdHealthCheck (TI_HANDLE hTWD, void *fCb, TI_HANDLE hCb);
 /** @ingroup UnKnown
  * \brief  AP Discovery
  *
@@ -49,6 +49,7 @@
 #include "TWDriver.h"
 #include "TWDriverInternal.h"
 #include "FwEvent_api.h"
+#include "rxXfer_api.h"
 #include "CmdBld.h"
 #include "RxQueue_api.h"
 
@@ -462,6 +463,16 @@ TFwInfo * TWD_GetFWInfo (TI_HANDLE hTWD)
 	return cmdBld_GetFWInfo (pTWD->hCmdBld);
 }
 
+void TWD_GetXferStats (TI_HANDLE hTWD, TTwdXferStats *pStats)
+{
+	TTwd *pTWD = (TTwd *)hTWD;
+
+
+	fwEvent_GetStats (pTWD->hFwEvent, pStats);
+	rxXfer_GetStats (pTWD->hRxXfer, pStats);
+	txXfer_GetStats (pTWD->hTxXfer, pStats);
+}
+
 TI_STATUS TWD_CmdSwitchChannel (TI_HANDLE hTWD, TSwitchChannelParams *pSwitchChannelCmd)
 {
 	TTwd   *pTWD = (TTwd *)hTWD;
@@ -601,12 +612,12 @@ TI_STATUS TWD_CfgBurstMode (TI_HANDLE hTWD, TI_BOOL bEnabled)
 
 
 
-TI_STATUS TWD_CmdHealthCheck (TI_HANDLE hTWD)
+TI_STATUS TWD_CmdHealthCheck (TI_HANDLE hTWD, void *fCb, TI_HANDLE hCb)
 {
 	TTwd   *pTWD = (TTwd *)hTWD;
 
 
-	return cmdBld_CmdHealthCheck (pTWD->hCmdBld, NULL, NULL);
+	return cmdBld_CmdHealthCheck (pTWD->hCmdBld, fCb, hCb);
 }
 
 TI_STATUS TWD_CfgMacClock (TI_HANDLE hTWD, TI_UINT32 uMacClock)
@@ -134,6 +134,18 @@ void healthMonitorDebugFunction (TStadHandlesList *pStadHandles, TI_UINT32 funcT
 		healthMonitor_sendFailureEvent (hHealthMonitor, RX_XFER_FAILURE);
 		break;
 
+	case DBG_HM_DATA_PATH_RESET_FAIL:
+		healthMonitor_SetDataPathResetFail (hHealthMonitor, (*(TI_UINT32*)pParam) ? TI_TRUE : TI_FALSE);
+		break;
+
+	case DBG_HM_PRINT_RECOVERY_STATS:
+		healthMonitor_printFailureEvents (hHealthMonitor);
+		break;
+
+	case DBG_HM_RESET_RECOVERY_STATS:
+		healthMonitor_ResetRecoveryStats (hHealthMonitor);
+		break;
+
 	default:
 		WLAN_OS_REPORT(("Invalid function type in health monitor debug function: %d\n", funcType));
 		break;
@@ -164,6 +176,9 @@ void printHealthMonitorDbgFunctions(void)
 	WLAN_OS_REPORT(("2009 - Start RECOVERY_FROM_CLI         \n"));
 	WLAN_OS_REPORT(("2010 - Trigger HW_WD_EXPIRE            \n"));
 	WLAN_OS_REPORT(("2011 - Trigger RX_XFER_FAILURE         \n"));
+	WLAN_OS_REPORT(("2012 <0/1> - Fail data-path reset verification\n"));
+	WLAN_OS_REPORT(("2013 - Print recovery statistics       \n"));
+	WLAN_OS_REPORT(("2014 - Reset recovery statistics       \n"));
 }
 
 static void noScanCompleteTimer (TI_HANDLE hTWD)
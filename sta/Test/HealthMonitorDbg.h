@@ -59,6 +59,9 @@
 #define DBG_HM_RECOVERY_FROM_CLI              9
 #define DBG_HM_RECOVERY_FROM_HW_WD_EXPIRE     10
 #define DBG_HM_RECOVERY_RX_XFER_FAILURE       11
+#define DBG_HM_DATA_PATH_RESET_FAIL           12
+#define DBG_HM_PRINT_RECOVERY_STATS           13
+#define DBG_HM_RESET_RECOVERY_STATS           14
 
 /*
  ***********************************************************************
@@ -50,6 +50,7 @@
 #include "PowerMgrDebug.h"
 #include "PowerMgr_API.h"
 #include "PowerMgr.h"
+#include "PowerMgrKeepAlive.h"
 
 
 /*****************************************************************************
@@ -82,6 +83,15 @@ void powerMgrDebugFunction(TI_HANDLE thePowerMgrHandle,
 		PowerMgr_printObject(thePowerMgrHandle);
 		break;
 
+	case POWER_MGR_KEEP_ALIVE_PRINT_STATS:
+		powerMgrKL_printStats(((PowerMgr_t*)thePowerMgrHandle)->hPowerMgrKeepAlive);
+		break;
+
+	case POWER_MGR_KEEP_ALIVE_SIMULATE:
+		powerMgrKL_simulateApTimeout(((PowerMgr_t*)thePowerMgrHandle)->hPowerMgrKeepAlive,
+		                             *(TI_UINT32*)theParameter);
+		break;
+
 	default:
 		WLAN_OS_REPORT(("(%d) - ERROR - Invalid function type in POWER MANAGER DEBUG Function Command: %d\n",
 		                __LINE__,theDebugFunction));
@@ -102,6 +112,8 @@ static void PowerMgrDebug_printAllCommands(void)
 	WLAN_OS_REPORT(("%d -  POWER_MGR_DEBUG_START_PS\n", POWER_MGR_DEBUG_START_PS));
 	WLAN_OS_REPORT(("%d -  POWER_MGR_DEBUG_STOP_PS\n", POWER_MGR_DEBUG_STOP_PS));
 	WLAN_OS_REPORT(("%d -  POWER_MGR_PRINT_OBJECTS\n", POWER_MGR_PRINT_OBJECTS));
+	WLAN_OS_REPORT(("%d -  POWER_MGR_KEEP_ALIVE_PRINT_STATS\n", POWER_MGR_KEEP_ALIVE_PRINT_STATS));
+	WLAN_OS_REPORT(("%d -  POWER_MGR_KEEP_ALIVE_SIMULATE <AP timeout sec, 0 for all>\n", POWER_MGR_KEEP_ALIVE_SIMULATE));
 	WLAN_OS_REPORT(("\n\n"));
 }
 
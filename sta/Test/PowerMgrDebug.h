@@ -63,6 +63,8 @@ enum {
 	POWER_MGR_DEBUG_START_PS,
 	POWER_MGR_DEBUG_STOP_PS,
 	POWER_MGR_PRINT_OBJECTS,
+	POWER_MGR_KEEP_ALIVE_PRINT_STATS,
+	POWER_MGR_KEEP_ALIVE_SIMULATE,
 	POWER_MGR_DEBUG_MAX_COMMANDS
 };
 
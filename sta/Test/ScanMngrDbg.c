@@ -105,6 +105,10 @@ void scanMngrDebugFunction( TI_HANDLE hScanMngr, TI_UINT32 funcType, void *pPara
 		scanMngrDebugPrintObject( hScanMngr );
 		break;
 
+	case DBG_SCAN_MNGR_CHECK_SPS_PLANNER:
+		scanMngrDebugCheckSPSPlanner( hScanMngr, *((TI_UINT32*)pParam) );
+		break;
+
 	default:
 		WLAN_OS_REPORT(("Invalid function type in scan manager debug function: %d\n", funcType));
 		break;
@@ -133,6 +137,7 @@ void printScanMngrDbgFunctions(void)
 	WLAN_OS_REPORT(("1508 - Print neighbor APs list\n"));
 	WLAN_OS_REPORT(("1509 - Print Scan Policy\n"));
 	WLAN_OS_REPORT(("1510 - Print scan manager object\n"));
+	WLAN_OS_REPORT(("1511 - Check SPS planner against the reference <iterations>\n"));
 }
 
 /**
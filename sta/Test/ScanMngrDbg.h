@@ -58,6 +58,7 @@
 #define DBG_SCAN_MNGR_PIRNT_NEIGHBOR_APS        8
 #define DBG_SCAN_MNGR_PRINT_POLICY              9
 #define DBG_SCAN_MNGR_PRINT_OBJECT              10
+#define DBG_SCAN_MNGR_CHECK_SPS_PLANNER         11
 
 /*
  ***********************************************************************
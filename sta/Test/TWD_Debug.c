@@ -919,7 +919,7 @@ TI_STATUS TWD_Debug (TI_HANDLE hTWD, TI_UINT32 funcType, void *pParam)
 	case TWD_CHECK_HW: {
 		int Stt;
 
-		Stt = TWD_CmdHealthCheck (hTWD);
+		Stt = TWD_CmdHealthCheck (hTWD, NULL, NULL);
 		WLAN_OS_REPORT(("CheckHwStatus=%d \n", Stt));
 	}
 	break;
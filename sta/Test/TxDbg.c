@@ -173,6 +173,15 @@ void rxTxDebugFunction(TI_HANDLE hRxTxHandle, TI_UINT32 funcType, void *pParam)
 		rxData_stopRxThroughputTimer (hRxTxHandle);
 		break;
 
+	case PRINT_RX_DATA_FILTERS:
+		WLAN_OS_REPORT(("RX DBG - Print Rx data filters \n\n"));
+		rxData_printRxDataFilter(hRxTxHandle);
+		break;
+
+	case RX_DATA_FILTERS_BENCHMARK:
+		rxData_benchRxDataFilters(hRxTxHandle, *(TI_UINT32*)pParam);
+		break;
+
 	default:
 		WLAN_OS_REPORT(("Invalid function type in Debug Tx Function Command: %d\n\n", funcType));
 		break;
@@ -211,6 +220,8 @@ void printTxRxDbgFunctions(void)
 	WLAN_OS_REPORT(("352 - Reset Rx counters.\n"));
 	WLAN_OS_REPORT(("353 - Start Rx throughput timer.\n"));
 	WLAN_OS_REPORT(("354 - Stop  Rx throughput timer.\n"));
+	WLAN_OS_REPORT(("355 - Print Rx data filters and hit counters.\n"));
+	WLAN_OS_REPORT(("356 - Benchmark Rx data filters lookup with 32 rules (param: iterations, 0 for 10000).\n"));
 }
 
 
@@ -63,7 +63,9 @@ typedef enum {
 	/*	51	*/	PRINT_RX_COUNTERS,
 	/*	52	*/	RESET_RX_COUNTERS,
 	/*	53	*/	PRINT_RX_THROUGHPUT_START,
-	/*	54	*/	PRINT_RX_THROUGHPUT_STOP
+	/*	54	*/	PRINT_RX_THROUGHPUT_STOP,
+	/*	55	*/	PRINT_RX_DATA_FILTERS,
+	/*	56	*/	RX_DATA_FILTERS_BENCHMARK
 
 } ERxTxDbgFunc;
 
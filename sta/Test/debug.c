@@ -68,6 +68,12 @@
 #include "MibDbg.h"
 #include "TwIfDebug.h"
 #include "tracebuf_api.h"
+#include "CmdHndlr.h"
+#include "CmdDispatcher.h"
+#include "CmdInterpret.h"
+#include "EvHandler.h"
+#include "rateDbg.h"
+#include "DrvMain.h"
 
 /* Following are the modules numbers */
 typedef enum {
@@ -108,6 +114,21 @@ typedef enum {
 #define DBG_UTILS_PRINT_CONTEXT_INFO         1
 #define DBG_UTILS_PRINT_TIMER_MODULE_INFO    2
 #define DBG_UTILS_PRINT_TRACE_BUFFER         3
+#define DBG_UTILS_PRINT_CMD_HNDLR_STAT       4
+#define DBG_UTILS_PARAM_DISPATCH_BENCHMARK   5
+#define DBG_UTILS_PRINT_EV_HANDLER_STAT      6
+#define DBG_UTILS_CHECK_EV_COALESCING        7
+#define DBG_UTILS_PRINT_MEMORY_STAT          8
+#define DBG_UTILS_CHECK_RATE_TABLES          9
+#define DBG_UTILS_RATE_BENCHMARK             10
+#define DBG_UTILS_SCAN_CACHE_BENCHMARK       11
+#define DBG_UTILS_PRINT_LOGGER_RING_STAT     12
+#define DBG_UTILS_TRACE_BENCHMARK            13
+#define DBG_UTILS_PRINT_TRACE_POINTS         14
+#define DBG_UTILS_TRACE_POINT_BENCHMARK      15
+#define DBG_UTILS_PRINT_BRINGUP_TIMES        16
+#define DBG_UTILS_PRINT_SUSPEND_STAT         17
+#define DBG_UTILS_INIT_TABLE_BENCHMARK       18
 /* General Parameters Structure */
 typedef struct {
 	TI_UINT32	paramType;
@@ -320,6 +341,66 @@ static void utilsDebugFunction (TStadHandlesList *pStadHandles, TI_UINT32 funcTy
 		/*          tb_printf(); */
 		break;
 
+	case DBG_UTILS_PRINT_CMD_HNDLR_STAT:
+		cmdHndlr_PrintStat (pStadHandles->hCmdHndlr);
+		break;
+
+	case DBG_UTILS_PARAM_DISPATCH_BENCHMARK:
+		cmdDispatch_Benchmark (pStadHandles->hCmdDispatch, *(TI_UINT32 *)pParam, 0);
+		break;
+
+	case DBG_UTILS_PRINT_EV_HANDLER_STAT:
+		EvHandler_PrintStats (pStadHandles->hEvHandler);
+		break;
+
+	case DBG_UTILS_CHECK_EV_COALESCING:
+		EvHandler_DbgCheckCoalescing (pStadHandles->hEvHandler, *(TI_UINT32 *)pParam);
+		break;
+
+	case DBG_UTILS_PRINT_MEMORY_STAT:
+		os_memoryPrintStats (pStadHandles->hOs);
+		break;
+
+	case DBG_UTILS_CHECK_RATE_TABLES:
+		rateDbg_CheckTables (pStadHandles->hOs);
+		break;
+
+	case DBG_UTILS_RATE_BENCHMARK:
+		rateDbg_Benchmark (pStadHandles->hOs, *(TI_UINT32 *)pParam);
+		break;
+
+	case DBG_UTILS_SCAN_CACHE_BENCHMARK:
+		cmdInterpret_ScanCacheBenchmark (pStadHandles->hOs, *(TI_UINT32 *)pParam);
+		break;
+
+	case DBG_UTILS_PRINT_LOGGER_RING_STAT:
+		os_TraceRingPrintStats (pStadHandles->hOs);
+		break;
+
+	case DBG_UTILS_TRACE_BENCHMARK:
+		os_TraceBenchmark (pStadHandles->hOs, *(TI_UINT32 *)pParam);
+		break;
+
+	case DBG_UTILS_PRINT_TRACE_POINTS:
+		report_PrintTracePoints (pStadHandles->hReport);
+		break;
+
+	case DBG_UTILS_TRACE_POINT_BENCHMARK:
+		report_TracePointBenchmark (pStadHandles->hReport, *(TI_UINT32 *)pParam);
+		break;
+
+	case DBG_UTILS_PRINT_BRINGUP_TIMES:
+		drvMain_PrintBringupTimes (pStadHandles->hDrvMain);
+		break;
+
+	case DBG_UTILS_PRINT_SUSPEND_STAT:
+		drvMain_PrintSuspendStats (pStadHandles->hDrvMain);
+		break;
+
+	case DBG_UTILS_INIT_TABLE_BENCHMARK:
+		drvMain_BenchInitTable (pStadHandles->hDrvMain, *(TI_UINT32 *)pParam);
+		break;
+
 	default:
 		WLAN_OS_REPORT(("utilsDebugFunction(): Invalid function type: %d\n", funcType));
 		break;
@@ -339,5 +420,20 @@ static void printUtilsDbgFunctions (void)
 	WLAN_OS_REPORT(("201 - Print Context module info\n"));
 	WLAN_OS_REPORT(("202 - Print Timer module info\n"));
 	WLAN_OS_REPORT(("203 - Print the trace buffer\n"));
+	WLAN_OS_REPORT(("204 - Print Command Handler statistics\n"));
+	WLAN_OS_REPORT(("205 <param type> - Benchmark parameter dispatch (module table vs. descriptor)\n"));
+	WLAN_OS_REPORT(("206 - Print Event Handler statistics\n"));
+	WLAN_OS_REPORT(("207 <events> - Check event coalescing ordering and loss guarantees\n"));
+	WLAN_OS_REPORT(("208 - Print driver memory accounting per call site\n"));
+	WLAN_OS_REPORT(("209 - Check the rate conversion tables against the reference conversions\n"));
+	WLAN_OS_REPORT(("210 <iterations> - Rate conversions benchmark\n"));
+	WLAN_OS_REPORT(("211 <BSSs> - SIOCGIWSCAN results cache benchmark\n"));
+	WLAN_OS_REPORT(("212 - Print the logger ring statistics\n"));
+	WLAN_OS_REPORT(("213 <traces> - Trace throughput benchmark\n"));
+	WLAN_OS_REPORT(("214 - Print the enabled report trace points and overrides\n"));
+	WLAN_OS_REPORT(("215 <packets> - Report sites per packet overhead benchmark\n"));
+	WLAN_OS_REPORT(("216 - Print the last driver bring-up phases timing\n"));
+	WLAN_OS_REPORT(("217 - Print the suspend/resume latency histograms\n"));
+	WLAN_OS_REPORT(("218 <loads> - Init table load benchmark (ini-file text vs. blob)\n"));
 }
 
@@ -58,6 +58,7 @@
 #include "XCCRMMngr.h"
 #endif
 #include "SwitchChannelApi.h"
+#include "regulatoryDomainApi.h"
 #include "TWDriver.h"
 
 
@@ -399,6 +400,10 @@ void measurementDebugFunction(TI_HANDLE hMeasurementMgr, TI_HANDLE hSwitchChanne
 		regDomainPrintValidTables(hRegulatoryDomain);
 		break;
 
+	case DBG_REG_DOMAIN_CHECK_CAP_CACHE:
+		regulatoryDomain_DbgCheckCapCache(hRegulatoryDomain, *(TI_UINT32*)pParam);
+		break;
+
 
 	default:
 		WLAN_OS_REPORT(("Invalid function type in MEASUREMENT Function Command: %d\n", funcType));
@@ -510,6 +515,8 @@ void printMeasurementDbgFunctions(void)
 
 	WLAN_OS_REPORT(("%d - DBG_REG_DOMAIN_PRINT_VALID_CHANNELS\n", DBG_REG_DOMAIN_PRINT_VALID_CHANNELS));
 
+	WLAN_OS_REPORT(("%d - DBG_REG_DOMAIN_CHECK_CAP_CACHE <iterations>\n", DBG_REG_DOMAIN_CHECK_CAP_CACHE));
+
 
 }
 
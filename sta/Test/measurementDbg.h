@@ -60,6 +60,7 @@
 #define DBG_SC_CANCEL_SWITCH_CHANNEL_CMD		37
 
 #define DBG_REG_DOMAIN_PRINT_VALID_CHANNELS		50
+#define DBG_REG_DOMAIN_CHECK_CAP_CACHE			51
 
 
 
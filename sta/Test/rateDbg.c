@@ -0,0 +1,843 @@
+/*
+ * rateDbg.c
+ *
+ * Copyright(c) 1998 - 2010 Texas Instruments. All rights reserved.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ *  * Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  * Neither the name Texas Instruments nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+/** \file   rateDbg.c
+ *  \brief  Rate conversion debug commands
+ *
+ * Checks the table based rate conversions against the original (switch based)
+ * implementations, and compares their run time.
+ *
+ *  \see    rate.c, rate.h
+ */
+
+#include "tidef.h"
+#include "osApi.h"
+#include "report.h"
+#include "rate.h"
+#include "rateDbg.h"
+
+
+/* All the driver rate bitmaps (1M - MCS7) plus one unused bit */
+#define RATE_DBG_DRV_BITMAP_RANGE   (1 << (DRV_RATE_MAX + 1))
+#define RATE_DBG_DEF_ITERATIONS     100000
+
+
+/*
+ * Reference implementations - the rate conversions before the lookup tables
+ */
+
+static ERate rateDbg_RefNetToDrv (TI_UINT32 rate)
+{
+	switch (rate) {
+	case NET_RATE_1M:
+	case NET_RATE_1M_BASIC:
+		return DRV_RATE_1M;
+
+	case NET_RATE_2M:
+	case NET_RATE_2M_BASIC:
+		return DRV_RATE_2M;
+
+	case NET_RATE_5_5M:
+	case NET_RATE_5_5M_BASIC:
+		return DRV_RATE_5_5M;
+
+	case NET_RATE_11M:
+	case NET_RATE_11M_BASIC:
+		return DRV_RATE_11M;
+
+	case NET_RATE_22M:
+	case NET_RATE_22M_BASIC:
+		return DRV_RATE_22M;
+
+	case NET_RATE_6M:
+	case NET_RATE_6M_BASIC:
+		return DRV_RATE_6M;
+
+	case NET_RATE_9M:
+	case NET_RATE_9M_BASIC:
+		return DRV_RATE_9M;
+
+	case NET_RATE_12M:
+	case NET_RATE_12M_BASIC:
+		return DRV_RATE_12M;
+
+	case NET_RATE_18M:
+	case NET_RATE_18M_BASIC:
+		return DRV_RATE_18M;
+
+	case NET_RATE_24M:
+	case NET_RATE_24M_BASIC:
+		return DRV_RATE_24M;
+
+	case NET_RATE_36M:
+	case NET_RATE_36M_BASIC:
+		return DRV_RATE_36M;
+
+	case NET_RATE_48M:
+	case NET_RATE_48M_BASIC:
+		return DRV_RATE_48M;
+
+	case NET_RATE_54M:
+	case NET_RATE_54M_BASIC:
+		return DRV_RATE_54M;
+
+	case NET_RATE_MCS0:
+	case NET_RATE_MCS0_BASIC:
+		return DRV_RATE_MCS_0;
+
+	case NET_RATE_MCS1:
+	case NET_RATE_MCS1_BASIC:
+		return DRV_RATE_MCS_1;
+
+	case NET_RATE_MCS2:
+	case NET_RATE_MCS2_BASIC:
+		return DRV_RATE_MCS_2;
+
+	case NET_RATE_MCS3:
+	case NET_RATE_MCS3_BASIC:
+		return DRV_RATE_MCS_3;
+
+	case NET_RATE_MCS4:
+	case NET_RATE_MCS4_BASIC:
+		return DRV_RATE_MCS_4;
+
+	case NET_RATE_MCS5:
+	case NET_RATE_MCS5_BASIC:
+		return DRV_RATE_MCS_5;
+
+	case NET_RATE_MCS6:
+	case NET_RATE_MCS6_BASIC:
+		return DRV_RATE_MCS_6;
+
+	case NET_RATE_MCS7:
+	case NET_RATE_MCS7_BASIC:
+		return DRV_RATE_MCS_7;
+
+	default:
+		return DRV_RATE_INVALID;
+	}
+}
+
+static ENetRate rateDbg_RefDrvToNet (ERate rate)
+{
+	switch (rate) {
+	case DRV_RATE_AUTO:
+		return NET_RATE_AUTO;
+
+	case DRV_RATE_1M:
+		return NET_RATE_1M;
+
+	case DRV_RATE_2M:
+		return NET_RATE_2M;
+
+	case DRV_RATE_5_5M:
+		return NET_RATE_5_5M;
+
+	case DRV_RATE_11M:
+		return NET_RATE_11M;
+
+	case DRV_RATE_22M:
+		return NET_RATE_22M;
+
+	case DRV_RATE_6M:
+		return NET_RATE_6M;
+
+	case DRV_RATE_9M:
+		return NET_RATE_9M;
+
+	case DRV_RATE_12M:
+		return NET_RATE_12M;
+
+	case DRV_RATE_18M:
+		return NET_RATE_18M;
+
+	case DRV_RATE_24M:
+		return NET_RATE_24M;
+
+	case DRV_RATE_36M:
+		return NET_RATE_36M;
+
+	case DRV_RATE_48M:
+		return NET_RATE_48M;
+
+	case DRV_RATE_54M:
+		return NET_RATE_54M;
+
+	case DRV_RATE_MCS_0:
+		return NET_RATE_MCS0;
+
+	case DRV_RATE_MCS_1:
+		return NET_RATE_MCS1;
+
+	case DRV_RATE_MCS_2:
+		return NET_RATE_MCS2;
+
+	case DRV_RATE_MCS_3:
+		return NET_RATE_MCS3;
+
+	case DRV_RATE_MCS_4:
+		return NET_RATE_MCS4;
+
+	case DRV_RATE_MCS_5:
+		return NET_RATE_MCS5;
+
+	case DRV_RATE_MCS_6:
+		return NET_RATE_MCS6;
+
+	case DRV_RATE_MCS_7:
+		return NET_RATE_MCS7;
+
+	default:
+		return NET_RATE_AUTO;
+	}
+}
+
+static TI_UINT32 rateDbg_RefDrvToNumber (ERate eRate)
+{
+	switch (eRate) {
+	case DRV_RATE_1M:
+		return 1;
+
+	case DRV_RATE_2M:
+		return 2;
+
+	case DRV_RATE_5_5M:
+		return 5;
+
+	case DRV_RATE_11M:
+		return 11;
+
+	case DRV_RATE_22M:
+		return 22;
+
+	case DRV_RATE_6M:
+		return 6;
+
+	case DRV_RATE_9M:
+		return 9;
+
+	case DRV_RATE_12M:
+		return 12;
+
+	case DRV_RATE_18M:
+		return 18;
+
+	case DRV_RATE_24M:
+		return 24;
+
+	case DRV_RATE_36M:
+		return 36;
+
+	case DRV_RATE_48M:
+		return 48;
+
+	case DRV_RATE_54M:
+		return 54;
+
+	case DRV_RATE_MCS_0:
+		return 6;
+
+	case DRV_RATE_MCS_1:
+		return 13;
+
+	case DRV_RATE_MCS_2:
+		return 19;
+
+	case DRV_RATE_MCS_3:
+		return 26;
+
+	case DRV_RATE_MCS_4:
+		return 39;
+
+	case DRV_RATE_MCS_5:
+		return 52;
+
+	case DRV_RATE_MCS_6:
+		return 58;
+
+	case DRV_RATE_MCS_7:
+		return 65;
+
+	default:
+		return 0;
+	}
+}
+
+static ERate rateDbg_RefGetMaxFromDrvBitmap (TI_UINT32 uRateBitMap)
+{
+	if (uRateBitMap & DRV_RATE_MASK_MCS_7_OFDM) {
+		return DRV_RATE_MCS_7;
+	}
+
+	if (uRateBitMap & DRV_RATE_MASK_MCS_6_OFDM) {
+		return DRV_RATE_MCS_6;
+	}
+
+	if (uRateBitMap & DRV_RATE_MASK_MCS_5_OFDM) {
+		return DRV_RATE_MCS_5;
+	}
+
+	if (uRateBitMap & DRV_RATE_MASK_MCS_4_OFDM) {
+		return DRV_RATE_MCS_4;
+	}
+
+	if (uRateBitMap & DRV_RATE_MASK_MCS_3_OFDM) {
+		return DRV_RATE_MCS_3;
+	}
+
+	if (uRateBitMap & DRV_RATE_MASK_MCS_2_OFDM) {
+		return DRV_RATE_MCS_2;
+	}
+
+	if (uRateBitMap & DRV_RATE_MASK_MCS_1_OFDM) {
+		return DRV_RATE_MCS_1;
+	}
+
+	if (uRateBitMap & DRV_RATE_MASK_MCS_0_OFDM) {
+		return DRV_RATE_MCS_0;
+	}
+
+	if (uRateBitMap & DRV_RATE_MASK_54_OFDM) {
+		return DRV_RATE_54M;
+	}
+
+	if (uRateBitMap & DRV_RATE_MASK_48_OFDM) {
+		return DRV_RATE_48M;
+	}
+
+	if (uRateBitMap & DRV_RATE_MASK_36_OFDM) {
+		return DRV_RATE_36M;
+	}
+
+	if (uRateBitMap & DRV_RATE_MASK_24_OFDM) {
+		return DRV_RATE_24M;
+	}
+
+	if (uRateBitMap & DRV_RATE_MASK_22_PBCC) {
+		return DRV_RATE_22M;
+	}
+
+	if (uRateBitMap & DRV_RATE_MASK_18_OFDM) {
+		return DRV_RATE_18M;
+	}
+
+	if (uRateBitMap & DRV_RATE_MASK_12_OFDM) {
+		return DRV_RATE_12M;
+	}
+
+	if (uRateBitMap & DRV_RATE_MASK_11_CCK) {
+		return DRV_RATE_11M;
+	}
+
+	if (uRateBitMap & DRV_RATE_MASK_9_OFDM) {
+		return DRV_RATE_9M;
+	}
+
+	if (uRateBitMap & DRV_RATE_MASK_6_OFDM) {
+		return DRV_RATE_6M;
+	}
+
+	if (uRateBitMap & DRV_RATE_MASK_5_5_CCK) {
+		return DRV_RATE_5_5M;
+	}
+
+	if (uRateBitMap & DRV_RATE_MASK_2_BARKER) {
+		return DRV_RATE_2M;
+	}
+
+	if (uRateBitMap & DRV_RATE_MASK_1_BARKER) {
+		return DRV_RATE_1M;
+	}
+
+	return DRV_RATE_INVALID;
+}
+
+static TI_STATUS rateDbg_RefNetStrToDrvBitmap (TI_UINT32 *pBitMap, TI_UINT8 *string, TI_UINT32 len)
+{
+	TI_UINT32   i;
+
+	*pBitMap = 0;
+
+	for (i = 0; i < len; i++) {
+		switch (string[i]) {
+		case NET_RATE_1M:
+		case NET_RATE_1M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_1_BARKER;
+			break;
+
+		case NET_RATE_2M:
+		case NET_RATE_2M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_2_BARKER;
+			break;
+
+		case NET_RATE_5_5M:
+		case NET_RATE_5_5M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_5_5_CCK;
+			break;
+
+		case NET_RATE_11M:
+		case NET_RATE_11M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_11_CCK;
+			break;
+
+		case NET_RATE_22M:
+		case NET_RATE_22M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_22_PBCC;
+			break;
+
+		case NET_RATE_6M:
+		case NET_RATE_6M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_6_OFDM;
+			break;
+
+		case NET_RATE_9M:
+		case NET_RATE_9M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_9_OFDM;
+			break;
+
+		case NET_RATE_12M:
+		case NET_RATE_12M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_12_OFDM;
+			break;
+
+		case NET_RATE_18M:
+		case NET_RATE_18M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_18_OFDM;
+			break;
+
+		case NET_RATE_24M:
+		case NET_RATE_24M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_24_OFDM;
+			break;
+
+		case NET_RATE_36M:
+		case NET_RATE_36M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_36_OFDM;
+			break;
+
+		case NET_RATE_48M:
+		case NET_RATE_48M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_48_OFDM;
+			break;
+
+		case NET_RATE_54M:
+		case NET_RATE_54M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_54_OFDM;
+			break;
+
+		case NET_RATE_MCS0:
+		case NET_RATE_MCS0_BASIC:
+			*pBitMap |= DRV_RATE_MASK_MCS_0_OFDM;
+			break;
+
+		case NET_RATE_MCS1:
+		case NET_RATE_MCS1_BASIC:
+			*pBitMap |= DRV_RATE_MASK_MCS_1_OFDM;
+			break;
+
+		case NET_RATE_MCS2:
+		case NET_RATE_MCS2_BASIC:
+			*pBitMap |= DRV_RATE_MASK_MCS_2_OFDM;
+			break;
+
+		case NET_RATE_MCS3:
+		case NET_RATE_MCS3_BASIC:
+			*pBitMap |= DRV_RATE_MASK_MCS_3_OFDM;
+			break;
+
+		case NET_RATE_MCS4:
+		case NET_RATE_MCS4_BASIC:
+			*pBitMap |= DRV_RATE_MASK_MCS_4_OFDM;
+			break;
+
+		case NET_RATE_MCS5:
+		case NET_RATE_MCS5_BASIC:
+			*pBitMap |= DRV_RATE_MASK_MCS_5_OFDM;
+			break;
+
+		case NET_RATE_MCS6:
+		case NET_RATE_MCS6_BASIC:
+			*pBitMap |= DRV_RATE_MASK_MCS_6_OFDM;
+			break;
+
+		case NET_RATE_MCS7:
+		case NET_RATE_MCS7_BASIC:
+			*pBitMap |= DRV_RATE_MASK_MCS_7_OFDM;
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	return TI_OK;
+}
+
+static TI_STATUS rateDbg_RefNetBasicStrToDrvBitmap (TI_UINT32 *pBitMap, TI_UINT8 *string, TI_UINT32 len)
+{
+	TI_UINT32   i;
+
+	*pBitMap = 0;
+
+	for (i = 0; i < len; i++) {
+		switch (string[i]) {
+		case NET_RATE_1M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_1_BARKER;
+			break;
+
+		case NET_RATE_2M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_2_BARKER;
+			break;
+
+		case NET_RATE_5_5M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_5_5_CCK;
+			break;
+
+		case NET_RATE_11M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_11_CCK;
+			break;
+
+		case NET_RATE_22M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_22_PBCC;
+			break;
+
+		case NET_RATE_6M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_6_OFDM;
+			break;
+
+		case NET_RATE_9M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_9_OFDM;
+			break;
+
+		case NET_RATE_12M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_12_OFDM;
+			break;
+
+		case NET_RATE_18M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_18_OFDM;
+			break;
+
+		case NET_RATE_24M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_24_OFDM;
+			break;
+
+		case NET_RATE_36M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_36_OFDM;
+			break;
+
+		case NET_RATE_48M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_48_OFDM;
+			break;
+
+		case NET_RATE_54M_BASIC:
+			*pBitMap |= DRV_RATE_MASK_54_OFDM;
+			break;
+
+		case NET_RATE_MCS0_BASIC:
+			*pBitMap |= DRV_RATE_MASK_MCS_0_OFDM;
+			break;
+
+		case NET_RATE_MCS1_BASIC:
+			*pBitMap |= DRV_RATE_MASK_MCS_1_OFDM;
+			break;
+
+		case NET_RATE_MCS2_BASIC:
+			*pBitMap |= DRV_RATE_MASK_MCS_2_OFDM;
+			break;
+
+		case NET_RATE_MCS3_BASIC:
+			*pBitMap |= DRV_RATE_MASK_MCS_3_OFDM;
+			break;
+
+		case NET_RATE_MCS4_BASIC:
+			*pBitMap |= DRV_RATE_MASK_MCS_4_OFDM;
+			break;
+
+		case NET_RATE_MCS5_BASIC:
+			*pBitMap |= DRV_RATE_MASK_MCS_5_OFDM;
+			break;
+
+		case NET_RATE_MCS6_BASIC:
+			*pBitMap |= DRV_RATE_MASK_MCS_6_OFDM;
+			break;
+
+		case NET_RATE_MCS7_BASIC:
+			*pBitMap |= DRV_RATE_MASK_MCS_7_OFDM;
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	return TI_OK;
+}
+
+static TI_STATUS rateDbg_RefDrvBitmapToHwBitmap (TI_UINT32 uDrvBitMap, TI_UINT32 *pHwBitmap)
+{
+	TI_UINT32   uHwBitMap = 0;
+
+	if (uDrvBitMap & DRV_RATE_MASK_1_BARKER) {
+		uHwBitMap |= HW_BIT_RATE_1MBPS;
+	}
+
+	if (uDrvBitMap & DRV_RATE_MASK_2_BARKER) {
+		uHwBitMap |= HW_BIT_RATE_2MBPS;
+	}
+
+	if (uDrvBitMap & DRV_RATE_MASK_5_5_CCK) {
+		uHwBitMap |= HW_BIT_RATE_5_5MBPS;
+	}
+
+	if (uDrvBitMap & DRV_RATE_MASK_11_CCK) {
+		uHwBitMap |= HW_BIT_RATE_11MBPS;
+	}
+
+	if (uDrvBitMap & DRV_RATE_MASK_22_PBCC) {
+		uHwBitMap |= HW_BIT_RATE_22MBPS;
+	}
+
+	if (uDrvBitMap & DRV_RATE_MASK_6_OFDM) {
+		uHwBitMap |= HW_BIT_RATE_6MBPS;
+	}
+
+	if (uDrvBitMap & DRV_RATE_MASK_9_OFDM) {
+		uHwBitMap |= HW_BIT_RATE_9MBPS;
+	}
+
+	if (uDrvBitMap & DRV_RATE_MASK_12_OFDM) {
+		uHwBitMap |= HW_BIT_RATE_12MBPS;
+	}
+
+	if (uDrvBitMap & DRV_RATE_MASK_18_OFDM) {
+		uHwBitMap |= HW_BIT_RATE_18MBPS;
+	}
+
+	if (uDrvBitMap & DRV_RATE_MASK_24_OFDM) {
+		uHwBitMap |= HW_BIT_RATE_24MBPS;
+	}
+
+	if (uDrvBitMap & DRV_RATE_MASK_36_OFDM) {
+		uHwBitMap |= HW_BIT_RATE_36MBPS;
+	}
+
+	if (uDrvBitMap & DRV_RATE_MASK_48_OFDM) {
+		uHwBitMap |= HW_BIT_RATE_48MBPS;
+	}
+
+	if (uDrvBitMap & DRV_RATE_MASK_54_OFDM) {
+		uHwBitMap |= HW_BIT_RATE_54MBPS;
+	}
+
+	if (uDrvBitMap & DRV_RATE_MASK_MCS_0_OFDM) {
+		uHwBitMap |= HW_BIT_RATE_MCS_0;
+	}
+
+	if (uDrvBitMap & DRV_RATE_MASK_MCS_1_OFDM) {
+		uHwBitMap |= HW_BIT_RATE_MCS_1;
+	}
+
+	if (uDrvBitMap & DRV_RATE_MASK_MCS_2_OFDM) {
+		uHwBitMap |= HW_BIT_RATE_MCS_2;
+	}
+
+	if (uDrvBitMap & DRV_RATE_MASK_MCS_3_OFDM) {
+		uHwBitMap |= HW_BIT_RATE_MCS_3;
+	}
+
+	if (uDrvBitMap & DRV_RATE_MASK_MCS_4_OFDM) {
+		uHwBitMap |= HW_BIT_RATE_MCS_4;
+	}
+
+	if (uDrvBitMap & DRV_RATE_MASK_MCS_5_OFDM) {
+		uHwBitMap |= HW_BIT_RATE_MCS_5;
+	}
+
+	if (uDrvBitMap & DRV_RATE_MASK_MCS_6_OFDM) {
+		uHwBitMap |= HW_BIT_RATE_MCS_6;
+	}
+
+	if (uDrvBitMap & DRV_RATE_MASK_MCS_7_OFDM) {
+		uHwBitMap |= HW_BIT_RATE_MCS_7;
+	}
+
+	*pHwBitmap = uHwBitMap;
+
+	return TI_OK;
+}
+
+
+/**
+ * \fn     rateDbg_CheckTables
+ * \brief  Check the rate conversion tables
+ *
+ * Compares the table based rate conversions with the reference implementations,
+ * for every network rate byte, every driver rate and every driver rates bitmap.
+ *
+ * \note
+ * \param  hOs - handle to the OS object
+ * \return void
+ * \sa     rateDbg_Benchmark
+ */
+void rateDbg_CheckTables (TI_HANDLE hOs)
+{
+	TI_UINT32 uVal, uBitmap, uRefBitmap;
+	TI_UINT32 uChecks = 0, uMismatches = 0;
+	TI_UINT8  uNetRate;
+
+	/* Network rate (16 bit, to cover the out of range values) to driver rate */
+	for (uVal = 0; uVal <= 0xFFFF; uVal++) {
+		if (rate_NetToDrv (uVal) != rateDbg_RefNetToDrv (uVal)) {
+			if (uMismatches++ < 5) {
+				WLAN_OS_REPORT(("rate_NetToDrv(0x%x) = %d, reference %d\n", uVal, rate_NetToDrv (uVal), rateDbg_RefNetToDrv (uVal)));
+			}
+		}
+		uChecks++;
+	}
+
+	/* Network rates string (a single rate) to driver bitmap */
+	for (uVal = 0; uVal <= 0xFF; uVal++) {
+		uNetRate = (TI_UINT8)uVal;
+
+		rate_NetStrToDrvBitmap (&uBitmap, &uNetRate, 1);
+		rateDbg_RefNetStrToDrvBitmap (&uRefBitmap, &uNetRate, 1);
+		if (uBitmap != uRefBitmap) {
+			if (uMismatches++ < 5) {
+				WLAN_OS_REPORT(("rate_NetStrToDrvBitmap(0x%x) = 0x%x, reference 0x%x\n", uVal, uBitmap, uRefBitmap));
+			}
+		}
+
+		rate_NetBasicStrToDrvBitmap (&uBitmap, &uNetRate, 1);
+		rateDbg_RefNetBasicStrToDrvBitmap (&uRefBitmap, &uNetRate, 1);
+		if (uBitmap != uRefBitmap) {
+			if (uMismatches++ < 5) {
+				WLAN_OS_REPORT(("rate_NetBasicStrToDrvBitmap(0x%x) = 0x%x, reference 0x%x\n", uVal, uBitmap, uRefBitmap));
+			}
+		}
+		uChecks += 2;
+	}
+
+	/* Driver rate (including out of range values) to network rate and number */
+	for (uVal = 0; uVal <= 0xFF; uVal++) {
+		if ((rate_DrvToNet ((ERate)uVal) != rateDbg_RefDrvToNet ((ERate)uVal)) ||
+		        (rate_DrvToNumber ((ERate)uVal) != rateDbg_RefDrvToNumber ((ERate)uVal))) {
+			if (uMismatches++ < 5) {
+				WLAN_OS_REPORT(("Driver rate %d: net 0x%x (reference 0x%x), number %d (reference %d)\n", uVal,
+				                rate_DrvToNet ((ERate)uVal), rateDbg_RefDrvToNet ((ERate)uVal),
+				                rate_DrvToNumber ((ERate)uVal), rateDbg_RefDrvToNumber ((ERate)uVal)));
+			}
+		}
+		uChecks += 2;
+	}
+
+	/* Every driver rates bitmap to max rate and HW bitmap */
+	for (uVal = 0; uVal < RATE_DBG_DRV_BITMAP_RANGE; uVal++) {
+		if (rate_GetMaxFromDrvBitmap (uVal) != rateDbg_RefGetMaxFromDrvBitmap (uVal)) {
+			if (uMismatches++ < 5) {
+				WLAN_OS_REPORT(("rate_GetMaxFromDrvBitmap(0x%x) = %d, reference %d\n", uVal,
+				                rate_GetMaxFromDrvBitmap (uVal), rateDbg_RefGetMaxFromDrvBitmap (uVal)));
+			}
+		}
+
+		rate_DrvBitmapToHwBitmap (uVal, &uBitmap);
+		rateDbg_RefDrvBitmapToHwBitmap (uVal, &uRefBitmap);
+		if (uBitmap != uRefBitmap) {
+			if (uMismatches++ < 5) {
+				WLAN_OS_REPORT(("rate_DrvBitmapToHwBitmap(0x%x) = 0x%x, reference 0x%x\n", uVal, uBitmap, uRefBitmap));
+			}
+		}
+		uChecks += 2;
+	}
+
+	WLAN_OS_REPORT(("Rate tables check: %d checks, %d mismatches\n", uChecks, uMismatches));
+}
+
+
+/**
+ * \fn     rateDbg_Benchmark
+ * \brief  Compare the rate conversions run time
+ *
+ * Runs the table based rate conversions and the reference implementations
+ * over the same inputs, and prints the run time of each.
+ *
+ * \note
+ * \param  hOs         - handle to the OS object
+ * \param  uIterations - number of iterations (0 for the default)
+ * \return void
+ * \sa     rateDbg_CheckTables
+ */
+void rateDbg_Benchmark (TI_HANDLE hOs, TI_UINT32 uIterations)
+{
+	/* A typical supported rates IE (11b/g, some rates basic) */
+	TI_UINT8  aRatesStr[] = { NET_RATE_1M_BASIC, NET_RATE_2M_BASIC, NET_RATE_5_5M_BASIC, NET_RATE_11M_BASIC,
+	                          NET_RATE_6M, NET_RATE_9M, NET_RATE_12M, NET_RATE_18M,
+	                          NET_RATE_24M, NET_RATE_36M, NET_RATE_48M, NET_RATE_54M
+	                        };
+	TI_UINT32 uTableTime, uRefTime, uStart;
+	TI_UINT32 uIter, uBitmap;
+	volatile TI_UINT32 uSink = 0;
+
+	if (uIterations == 0) {
+		uIterations = RATE_DBG_DEF_ITERATIONS;
+	}
+
+	uStart = os_timeStampUs (hOs);
+	for (uIter = 0; uIter < uIterations; uIter++) {
+		rate_NetStrToDrvBitmap (&uBitmap, aRatesStr, sizeof(aRatesStr));
+		uSink += rate_GetMaxFromDrvBitmap (uBitmap & (uIter | DRV_RATE_MASK_1_BARKER));
+		rate_DrvBitmapToHwBitmap (uBitmap ^ uIter, &uBitmap);
+		uSink += uBitmap;
+		uSink += rate_NetToDrv (aRatesStr[uIter % sizeof(aRatesStr)]);
+		uSink += rate_DrvToNet ((ERate)(uIter % (DRV_RATE_MAX + 1)));
+		uSink += rate_DrvToNumber ((ERate)(uIter % (DRV_RATE_MAX + 1)));
+	}
+	uTableTime = os_timeStampUs (hOs) - uStart;
+
+	uStart = os_timeStampUs (hOs);
+	for (uIter = 0; uIter < uIterations; uIter++) {
+		rateDbg_RefNetStrToDrvBitmap (&uBitmap, aRatesStr, sizeof(aRatesStr));
+		uSink += rateDbg_RefGetMaxFromDrvBitmap (uBitmap & (uIter | DRV_RATE_MASK_1_BARKER));
+		rateDbg_RefDrvBitmapToHwBitmap (uBitmap ^ uIter, &uBitmap);
+		uSink += uBitmap;
+		uSink += rateDbg_RefNetToDrv (aRatesStr[uIter % sizeof(aRatesStr)]);
+		uSink += rateDbg_RefDrvToNet ((ERate)(uIter % (DRV_RATE_MAX + 1)));
+		uSink += rateDbg_RefDrvToNumber ((ERate)(uIter % (DRV_RATE_MAX + 1)));
+	}
+	uRefTime = os_timeStampUs (hOs) - uStart;
+
+	WLAN_OS_REPORT(("Rate conversions benchmark: %d iterations\n", uIterations));
+	WLAN_OS_REPORT(("  Tables:    %d usec\n", uTableTime));
+	WLAN_OS_REPORT(("  Reference: %d usec\n", uRefTime));
+}
@@ -57,6 +57,7 @@
 #include "healthMonitor.h"
 #include "conn.h"
 #include "connApi.h"
+#include "currBss.h"
 
 #ifdef XCC_MODULE_INCLUDED
 #include "XCCMngr.h"
@@ -302,6 +303,10 @@ void siteMgrDebugFunction (TI_HANDLE         hSiteMgr,
 		printSiteTable(pSiteMgr, (char*)pParam);
 		break;
 
+	case PRINT_CURR_BSS_BEACON_STATS:
+		currBss_DbgPrintBeaconStats(pStadHandles->hCurrBss);
+		break;
+
 	case SET_DESIRED_CHANNEL:
 		param.paramType = SITE_MGR_DESIRED_CHANNEL_PARAM;
 		param.content.siteMgrDesiredChannel = *(TI_UINT8*)pParam;
@@ -1194,6 +1199,7 @@ void printSiteMgrHelpMenu(void)
 	WLAN_OS_REPORT(("        %03d - TOGGLE_LNA_OFF \n", TEST_TOGGLE_LNA_OFF));
 
 	WLAN_OS_REPORT(("        %03d - PRINT_SITE_TABLE_PER_SSID\n", PRINT_SITE_TABLE_PER_SSID));
+	WLAN_OS_REPORT(("        %03d - PRINT_CURR_BSS_BEACON_STATS\n", PRINT_CURR_BSS_BEACON_STATS));
 
 	WLAN_OS_REPORT(("        %03d - SET_DESIRED_CHANNEL\n", SET_DESIRED_CHANNEL));
 
@@ -99,6 +99,7 @@
 #define TEST_TOGGLE_LNA_OFF   								61
 
 #define PRINT_SITE_TABLE_PER_SSID							70
+#define PRINT_CURR_BSS_BEACON_STATS							71
 
 #define ROAM_TEST1											81
 #define ROAM_TEST2											82
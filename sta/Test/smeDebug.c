@@ -107,6 +107,10 @@ void smeDebugFunction (TI_HANDLE hSme, TI_UINT32 funcType, void *pParam)
 		sme_printBssidList( hSme );
 		break;
 
+	case DBG_SME_SELECT_BENCHMARK:
+		sme_SelectBenchmark( hSme, *(TI_UINT32*)pParam );
+		break;
+
 	default:
 		WLAN_OS_REPORT(("Invalid function type in SME debug function: %d\n", funcType));
 		break;
@@ -162,6 +166,7 @@ void printSmeDbgFunctions(void)
 	WLAN_OS_REPORT(("1902 - Print the SME statistics\n"));
 	WLAN_OS_REPORT(("1903 - Reset the SME statistics\n"));
 	WLAN_OS_REPORT(("1904 - Print BSSID list\n"));
+	WLAN_OS_REPORT(("1905 <number of sites> - Benchmark site selection\n"));
 }
 
 #ifdef REPORT_LOG
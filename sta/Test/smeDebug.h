@@ -54,6 +54,7 @@
 #define DBG_SME_PRINT_STATS             2
 #define DBG_SME_CLEAR_STATS             3
 #define DBG_SME_BSSID_LIST              4
+#define DBG_SME_SELECT_BENCHMARK        5
 
 /*
  ***********************************************************************
@@ -36,6 +36,7 @@
 #include <linux/kernel.h>
 #include <asm/io.h>
 #include <linux/delay.h>
+#include <linux/jiffies.h>
 #include <linux/platform_device.h>
 #include "host_platform.h"
 #include "ioctl_init.h"
@@ -71,6 +72,11 @@
 struct platform_device *sdioDrv_get_platform_device(void);
 static int wakeup_state = 0;
 
+/* Chip power-up settle time, and the start of the current power-up */
+#define DEVICE_POWER_ON_SETTLE_MS	30
+static unsigned long power_on_jiffies = 0;
+static int power_on_err = 0;
+
 
 int wifi_power(int on)
 {
@@ -145,18 +151,35 @@ int hPlatform_DevicePowerOffSetLongerDelay (void *tnet_drv)
 }
 
 int hPlatform_DevicePowerOn (void *tnet_drv)
+{
+	hPlatform_DevicePowerOnStart(tnet_drv);
+
+	return hPlatform_DevicePowerOnComplete(tnet_drv);
+}
+
+/* Turn the chip power on without waiting for it to settle */
+int hPlatform_DevicePowerOnStart (void *tnet_drv)
+{
+	power_on_err = wifi_power(1);
+	power_on_jiffies = jiffies;
+
+	return power_on_err;
+}
+
+/* Wait for the rest of the power-up settle time (the caller may have used part of it) */
+int hPlatform_DevicePowerOnComplete (void *tnet_drv)
 {
 	TWlanDrvIfObj *drv = tnet_drv;
-	int err = 0;
+	long remain = (long)(power_on_jiffies + msecs_to_jiffies(DEVICE_POWER_ON_SETTLE_MS) + 1 - jiffies);
 
-	err = wifi_power(1);
-	msleep(30);
-	if (!err && !wakeup_state) {
+	if (remain > 0)
+		msleep(jiffies_to_msecs(remain));
+	if (!power_on_err && !wakeup_state) {
 		set_irq_wake(drv->irq, 1);
 		wakeup_state = 1;
 	}
 
-	return err;
+	return power_on_err;
 }
 
 int hPlatform_Wlan_Hardware_Init(void *tnet_drv)
@@ -82,4 +82,6 @@ void hPlatform_Wlan_Hardware_DeInit(void);
 int  hPlatform_DevicePowerOff(void *tnet_drv);
 int  hPlatform_DevicePowerOffSetLongerDelay(void *tnet_drv);
 int  hPlatform_DevicePowerOn(void *tnet_drv);
+int  hPlatform_DevicePowerOnStart(void *tnet_drv);
+int  hPlatform_DevicePowerOnComplete(void *tnet_drv);
 #endif /* __HOST_PLATFORM_SDIO__H__ */
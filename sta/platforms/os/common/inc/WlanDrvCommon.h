@@ -114,6 +114,34 @@ typedef struct {
 } TLoaderFilesData;
 
 
+/*
+ * The init file may be passed either as text or as a pre-parsed init table blob (see drvMain_CompileIniFile).
+ * The blob is the TInitTableBlobHdr followed by the TInitTable image and the NUL terminated ini-file text
+ *     it was compiled from. The image is used only if its version and table size match the driver,
+ *     otherwise the driver parses the embedded ini-file text. A blob is never parsed as text.
+ * INIT_TABLE_BLOB_VERSION is set by the build (see common.inc) from a checksum of the init table sources
+ *     and the build defines. If not set, the driver version is used (see drvMain_InitTableBlobVersion).
+ */
+#define INIT_TABLE_BLOB_MAGIC               (0x42495754)	/* "TWIB" */
+
+typedef struct {
+	TI_UINT32 uMagic;       /* INIT_TABLE_BLOB_MAGIC */
+	TI_UINT32 uVersion;     /* Init table blob version of the driver that compiled the blob */
+	TI_UINT32 uTableSize;   /* sizeof(TInitTable) of the driver that compiled the blob */
+	TI_UINT32 uChecksum;    /* Adler-32 of the init table image and the ini-file text (with its NUL) */
+	TI_UINT32 uDbgState;    /* OsDbgState read from the ini-file (debug builds only) */
+	TI_UINT32 uIniLength;   /* Ini-file text length, not including its terminating NUL */
+	/* init table image follows */
+	/* ini-file text follows   */
+} TInitTableBlobHdr;
+
+/* The length of a blob by its header */
+#define INIT_TABLE_BLOB_LENGTH(pHdr)        (sizeof(TInitTableBlobHdr) + (pHdr)->uTableSize + (pHdr)->uIniLength + 1)
+
+/* The blob buffer length needed for compiling an ini-file of the given length (text or blob) */
+#define INIT_TABLE_BLOB_MAX_LENGTH(uLen)    (sizeof(TInitTableBlobHdr) + sizeof(TInitTable) + (uLen) + 1)
+
+
 /** \brief WLAN Driver I/F Update Driver State
  *
  * \param  hOs          - OS module object handle
@@ -95,6 +95,8 @@
 #define TIWLN_ENABLE_DISABLE_RX_DATA_FILTERS            RX_DATA_ENABLE_DISABLE_RX_DATA_FILTERS
 #define TIWLN_ADD_RX_DATA_FILTER                        RX_DATA_ADD_RX_DATA_FILTER
 #define TIWLN_REMOVE_RX_DATA_FILTER                     RX_DATA_REMOVE_RX_DATA_FILTER
+#define TIWLN_ADD_RX_DATA_FILTER_RULE                   RX_DATA_ADD_RX_DATA_FILTER_RULE
+#define TIWLN_REMOVE_RX_DATA_FILTER_RULE                RX_DATA_REMOVE_RX_DATA_FILTER_RULE
 #define TIWLN_GET_RX_DATA_FILTERS_STATISTICS            RX_DATA_GET_RX_DATA_FILTERS_STATISTICS
 #define TIWLN_GET_RX_DATA_RATE                          SITE_MGR_CURRENT_RX_RATE_PARAM
 #define TIWLN_REPORT_MODULE_SET                         REPORT_MODULE_TABLE_PARAM
@@ -113,6 +115,8 @@
 #define TIWLN_ENABLE_DISABLE_RX_DATA_FILTERS            RX_DATA_ENABLE_DISABLE_RX_DATA_FILTERS
 #define TIWLN_ADD_RX_DATA_FILTER                        RX_DATA_ADD_RX_DATA_FILTER
 #define TIWLN_REMOVE_RX_DATA_FILTER                     RX_DATA_REMOVE_RX_DATA_FILTER
+#define TIWLN_ADD_RX_DATA_FILTER_RULE                   RX_DATA_ADD_RX_DATA_FILTER_RULE
+#define TIWLN_REMOVE_RX_DATA_FILTER_RULE                RX_DATA_REMOVE_RX_DATA_FILTER_RULE
 #define TIWLN_GET_RX_DATA_FILTERS_STATISTICS            RX_DATA_GET_RX_DATA_FILTERS_STATISTICS /* not implemented in CUDK */
 #define TIWLN_802_11_START_APP_SCAN_SET                 SCAN_CNCN_START_APP_SCAN
 #define TIWLN_802_11_STOP_APP_SCAN_SET                  SCAN_CNCN_STOP_APP_SCAN
@@ -322,6 +322,39 @@ extern "C" {
 	 */
 	void os_memory4HwDmaFree (TI_HANDLE pOsContext, void *pMem_ptr, TI_UINT32 Size);
 
+	/** \brief  OS Memory Init
+	 *
+	 * \par Description
+	 * This function creates the size class memory caches and resets the memory accounting.
+	 * It is called once when the driver is loaded, before any other memory allocation
+	 *
+	 * \sa	os_memoryDestroy
+	 */
+	void os_memoryInit (void);
+
+	/** \brief  OS Memory Destroy
+	 *
+	 * \par Description
+	 * This function reports the memory blocks that were not released (with their allocating
+	 * file ID and line) and destroys the memory caches. It is called once when the driver is unloaded
+	 *
+	 * \sa	os_memoryInit
+	 */
+	void os_memoryDestroy (void);
+
+	/** \brief  OS Memory Print Statistics
+	 *
+	 * \param  OsContext 	- Handle to the OS object
+	 * \return void
+	 *
+	 * \par Description
+	 * This function prints the memory accounting: live and peak bytes, and per allocation
+	 * call site (file ID and line) the live blocks and bytes and the allocation rate since the last print
+	 *
+	 * \sa
+	 */
+	void os_memoryPrintStats (TI_HANDLE OsContext);
+
 	/** \brief  OS Memory Copy from User
 	 *
 	 * \param  OsContext 	- Handle to the OS object
@@ -693,6 +726,71 @@ extern "C" {
 	 */
 	void os_Trace (TI_HANDLE OsContext, TI_UINT32 uLevel, TI_UINT32 uFileId, TI_UINT32 uLineNum, TI_UINT32 uParamsNum, ...);
 
+	/** \brief  OS Trace Ring Create
+	 *
+	 * \param  OsContext 	- Handle to the OS object
+	 * \return 0 on success
+	 *
+	 * \par Description
+	 * This function registers the device of the ring shared with the logger, to which os_Trace writes the
+	 * trace messages. The ring is allocated only while the trace messages are redirected to the logger and
+	 * the driver is up. Without the ring the trace messages are sent to the logger one by one as events
+	 *
+	 * \sa		os_TraceRingDestroy, os_TraceRingSetDriverUp
+	 */
+	int os_TraceRingCreate (TI_HANDLE OsContext);
+
+	/** \brief  OS Trace Ring Set Driver Up
+	 *
+	 * \param  OsContext 	- Handle to the OS object
+	 * \param  bDriverUp 	- TI_TRUE when the driver is started, TI_FALSE when it is stopped
+	 * \return void
+	 *
+	 * \par Description
+	 * This function frees the ring when the driver goes down, so that the logger closes the ring device
+	 * and doesn't prevent the module unload, and allocates it again when the driver comes up
+	 *
+	 * \sa		os_TraceRingCreate
+	 */
+	void os_TraceRingSetDriverUp (TI_HANDLE OsContext, TI_BOOL bDriverUp);
+
+	/** \brief  OS Trace Ring Destroy
+	 *
+	 * \param  OsContext 	- Handle to the OS object
+	 * \return void
+	 *
+	 * \sa		os_TraceRingCreate
+	 */
+	void os_TraceRingDestroy (TI_HANDLE OsContext);
+
+#ifdef TI_DBG
+	/** \brief  OS Trace Ring Print Statistics
+	 *
+	 * \param  OsContext 	- Handle to the OS object
+	 * \return void
+	 *
+	 * \par Description
+	 * This function prints the trace ring backlog and its written, dropped and reader wakeup counters
+	 *
+	 * \sa
+	 */
+	void os_TraceRingPrintStats (TI_HANDLE OsContext);
+
+	/** \brief  OS Trace Benchmark
+	 *
+	 * \param  OsContext 	- Handle to the OS object
+	 * \param  uTraces   	- Number of trace messages to send (0 for 100000)
+	 * \return void
+	 *
+	 * \par Description
+	 * This function sends trace messages back to back and prints the traces per second
+	 * and the number of traces dropped because the logger fell behind
+	 *
+	 * \sa
+	 */
+	void os_TraceBenchmark (TI_HANDLE OsContext, TI_UINT32 uTraces);
+#endif
+
 	/**
 	 * \fn     os_SetDrvThreadPriority
 	 * \brief  Called upon init to set WLAN driver thread priority.
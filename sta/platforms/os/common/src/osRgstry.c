@@ -679,6 +679,8 @@ NDIS_STRING STRSnrPacketAverageWeight  = NDIS_STRING_CONST("SnrPacketAverageWeig
 NDIS_STRING STRMinimumDurationBetweenOsScans     = NDIS_STRING_CONST( "MinimumDurationBetweenOsScans" );
 NDIS_STRING STRDfsPassiveDwellTimeMs             = NDIS_STRING_CONST( "DfsPassiveDwellTimeMs" );
 NDIS_STRING STRScanPushMode                      = NDIS_STRING_CONST( "ScanPushMode" );
+NDIS_STRING STRScanResultStreaming               = NDIS_STRING_CONST( "ScanResultStreaming" );
+NDIS_STRING STREventBatchInterval                = NDIS_STRING_CONST( "EventBatchInterval" );
 
 NDIS_STRING STRScanResultAging                   = NDIS_STRING_CONST( "ScanResultAging" );
 NDIS_STRING STRScanCncnRssiThreshold             = NDIS_STRING_CONST( "ScanCncnRssiThreshold" );
@@ -689,6 +691,8 @@ NDIS_STRING STRParseWSCInBeacons      = NDIS_STRING_CONST( "ParseWSCInBeacons" )
 /*      Current BSS parameters       */
 /*-----------------------------------*/
 NDIS_STRING STRNullDataKeepAliveDefaultPeriod  = NDIS_STRING_CONST("NullDataKeepAliveDefaultPeriod");
+NDIS_STRING STRKeepAliveAdaptive  = NDIS_STRING_CONST("KeepAliveAdaptive");
+NDIS_STRING STRKeepAliveMaxPeriod  = NDIS_STRING_CONST("KeepAliveMaxPeriod");
 
 /*-----------------------------------*/
 /*      Context-Engine parameters    */
@@ -3808,6 +3812,16 @@ regFillInitTable(
 	                         sizeof p->tScanCncnInitParams.bPushMode,
 	                         (TI_UINT8*)&p->tScanCncnInitParams.bPushMode);
 
+	regReadIntegerParameter (pAdapter, &STRScanResultStreaming,
+	                         SCAN_CNCN_APP_RESULT_STREAMING_DEF, SCAN_CNCN_APP_RESULT_STREAMING_MIN, SCAN_CNCN_APP_RESULT_STREAMING_MAX,
+	                         sizeof p->tScanCncnInitParams.bResultStreaming,
+	                         (TI_UINT8*)&p->tScanCncnInitParams.bResultStreaming);
+
+	regReadIntegerParameter (pAdapter, &STREventBatchInterval,
+	                         EV_HANDLER_BATCH_INTERVAL_DEF, EV_HANDLER_BATCH_INTERVAL_MIN, EV_HANDLER_BATCH_INTERVAL_MAX,
+	                         sizeof p->tEvHandlerInitParams.uBatchIntervalMs,
+	                         (TI_UINT8*)&p->tEvHandlerInitParams.uBatchIntervalMs);
+
 	regReadIntegerParameter(pAdapter, &STRScanResultAging,
 	                        SCAN_CNCN_APP_SRA_DEF, SCAN_CNCN_APP_SRA_MIN, SCAN_CNCN_APP_SRA_MAX,
 	                        sizeof p->tScanCncnInitParams.uSraThreshold,
@@ -3835,6 +3849,16 @@ regFillInitTable(
 	                         sizeof p->tCurrBssInitParams.uNullDataKeepAlivePeriod,
 	                         (TI_UINT8*)&p->tCurrBssInitParams.uNullDataKeepAlivePeriod );
 
+	regReadIntegerParameter( pAdapter, &STRKeepAliveAdaptive,
+	                         KEEP_ALIVE_ADAPTIVE_DEF, KEEP_ALIVE_ADAPTIVE_MIN, KEEP_ALIVE_ADAPTIVE_MAX,
+	                         sizeof p->PowerMgrInitParams.bKeepAliveAdaptive,
+	                         (TI_UINT8*)&p->PowerMgrInitParams.bKeepAliveAdaptive );
+
+	regReadIntegerParameter( pAdapter, &STRKeepAliveMaxPeriod,
+	                         KEEP_ALIVE_MAX_PERIOD_DEF, KEEP_ALIVE_MAX_PERIOD_MIN, KEEP_ALIVE_MAX_PERIOD_MAX,
+	                         sizeof p->PowerMgrInitParams.uKeepAliveMaxPeriod,
+	                         (TI_UINT8*)&p->PowerMgrInitParams.uKeepAliveMaxPeriod );
+
 	/*----------------------------------
 	 Context Engine
 	------------------------------------*/
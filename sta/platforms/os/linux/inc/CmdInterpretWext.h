@@ -57,6 +57,11 @@ typedef struct {
 	TConfigCommand         *pAsyncCmd;       /* Pointer to the command currently being processed */
 	void                   *pAllocatedBuffer;
 	TI_UINT32              AllocatedBufferSize;
+	void                   *pScanCache;         /* SIOCGIWSCAN results, encoded as wireless events */
+	TI_UINT32              uScanCacheSize;      /* Allocated size of the scan results cache */
+	TI_UINT32              uScanCacheLen;       /* Length of the encoded scan results */
+	TI_UINT32              uScanCacheGeneration;/* Scan result table generation the cache was built from */
+	TI_BOOL                bScanCacheValid;     /* Whether the scan results cache holds the encoded results */
 } cmdInterpret_t;
 
 #define WLAN_PROTOCOL_NAME    "IEEE 802.11ABG"
@@ -116,6 +116,11 @@ TI_STATUS cmdInterpret_Destroy (TI_HANDLE hCmdInterpret, TI_HANDLE hEvHandler)
 {
 	cmdInterpret_t *pCmdInterpret = (cmdInterpret_t *)hCmdInterpret;
 
+	/* Release the scan results cache */
+	if (pCmdInterpret->pScanCache) {
+		os_memoryFree (pCmdInterpret->hOs, pCmdInterpret->pScanCache, pCmdInterpret->uScanCacheSize);
+	}
+
 	/* Release allocated memory */
 	os_memoryFree (pCmdInterpret->hOs, pCmdInterpret, sizeof(cmdInterpret_t));
 
@@ -136,6 +141,557 @@ void cmdInterpret_Init (TI_HANDLE hCmdInterpret, TStadHandlesList *pStadHandles)
 }
 
 
+/*
+ * Scan results cache.
+ * SIOCGIWSCAN results are encoded once to an iw_event stream and kept with the generation of the
+ *   scan result table they were built from. Following requests (e.g. the supplicant retrying with
+ *   a larger buffer) copy the stream as is, until the table generation changes.
+ */
+
+/* Upper bound of the events encoded for a BSS, apart from its variable IEs */
+#define SCAN_EVENT_CUSTOM_LEN   30
+#define SCAN_EVENT_FIXED_LEN    (IW_EV_ADDR_LEN + IW_EV_POINT_LEN + IW_ESSID_MAX_SIZE + IW_EV_CHAR_LEN + \
+                                 IW_EV_UINT_LEN + IW_EV_FREQ_LEN + IW_EV_QUAL_LEN + IW_EV_POINT_LEN + \
+                                 IW_EV_LCP_LEN + IW_EV_POINT_LEN + SCAN_EVENT_CUSTOM_LEN)
+
+/* Returns the buffer size required to encode the BSSID list and rate list to wireless events */
+static TI_UINT32 cmdInterpret_ScanEventsSize (OS_802_11_BSSID_LIST_EX *pList, OS_802_11_N_RATES *pRateList)
+{
+	OS_802_11_BSSID_EX *pBssid = &pList->Bssid[0];
+	OS_802_11_VARIABLE_IEs *pIE;
+	TI_UINT32 uSize = 0;
+	TI_UINT32 uBss, uOffset, uRate;
+
+	for (uBss = 0; uBss < pList->NumberOfItems; uBss++) {
+		uSize += SCAN_EVENT_FIXED_LEN;
+		for (uRate = 0; uRate < sizeof(OS_802_11_N_RATES); uRate++) {
+			if (pRateList[uBss][uRate]) {
+				uSize += IW_EV_PARAM_LEN;
+			}
+		}
+		uOffset = sizeof(OS_802_11_FIXED_IEs);
+		while (uOffset < pBssid->IELength) {
+			pIE = (OS_802_11_VARIABLE_IEs*)&(pBssid->IEs[uOffset]);
+			uSize += IW_EV_POINT_LEN + pIE->Length + 2;
+			uOffset += pIE->Length + 2;
+		}
+		pBssid = (OS_802_11_BSSID_EX *) (((char *) pBssid) + pBssid->Length);
+	}
+
+	return uSize;
+}
+
+/* Encodes the BSSID list to a stream of wireless events, a set of events per BSS. Returns the stream length */
+static TI_UINT32 cmdInterpret_EncodeScanEvents (TI_HANDLE hOs, OS_802_11_BSSID_LIST_EX *pList,
+        OS_802_11_N_RATES *pRateList, char *pBuf, TI_UINT32 uBufSize)
+{
+	char buf[SCAN_EVENT_CUSTOM_LEN];
+	char *event = pBuf;
+	char *end_buf = pBuf + uBufSize;
+	char *current_val;
+	struct iw_event iwe;
+	OS_802_11_BSSID_EX *my_current = &pList->Bssid[0];
+	TI_UINT8 *current_rates;
+	TI_UINT32 i;
+	int j, offset;
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,27)
+	struct iw_request_info info;
+	info.cmd = SIOCGIWSCAN;
+	info.flags = 0;
+#endif
+
+	for (i = 0; i < pList->NumberOfItems; i++) {
+		/* The first entry MUST be the AP BSSID */
+		os_memorySet (hOs, &iwe, 0, sizeof(iwe));
+		iwe.cmd = SIOCGIWAP;
+		iwe.u.ap_addr.sa_family = ARPHRD_ETHER;
+		iwe.len = IW_EV_ADDR_LEN;
+		os_memoryCopy(hOs, iwe.u.ap_addr.sa_data, &my_current->MacAddress, ETH_ALEN);
+
+#if LINUX_VERSION_CODE < KERNEL_VERSION(2,6,27)
+		event = iwe_stream_add_event(event, end_buf, &iwe, IW_EV_ADDR_LEN);
+#else
+		event = iwe_stream_add_event(&info,event, end_buf, &iwe, IW_EV_ADDR_LEN);
+#endif
+
+		/* Add SSID */
+		iwe.cmd = SIOCGIWESSID;
+		iwe.u.data.flags = 1;
+		iwe.u.data.length = min((TI_UINT8)my_current->Ssid.SsidLength, (TI_UINT8)32);
+
+#if LINUX_VERSION_CODE < KERNEL_VERSION(2,6,27)
+		event = iwe_stream_add_point(event, end_buf, &iwe, my_current->Ssid.Ssid);
+#else
+		event = iwe_stream_add_point(&info,event, end_buf, &iwe, my_current->Ssid.Ssid);
+#endif
+
+		/* Add the protocol name (BSS support for A/B/G) */
+		os_memorySet (hOs, &iwe, 0, sizeof(iwe));
+		iwe.cmd = SIOCGIWNAME;
+		os_memoryCopy(hOs, (void*)iwe.u.name, (void*)ieee80211_modes[my_current->NetworkTypeInUse], IFNAMSIZ);
+
+#if LINUX_VERSION_CODE < KERNEL_VERSION(2,6,27)
+		event = iwe_stream_add_event(event, end_buf, &iwe, IW_EV_CHAR_LEN);
+#else
+		event = iwe_stream_add_event(&info,event, end_buf, &iwe, IW_EV_CHAR_LEN);
+#endif
+
+		/* add mode (infrastructure or Adhoc) */
+		os_memorySet (hOs, &iwe, 0, sizeof(iwe));
+		iwe.cmd = SIOCGIWMODE;
+		if (my_current->InfrastructureMode == os802_11IBSS)
+			iwe.u.mode = IW_MODE_ADHOC;
+		else if (my_current->InfrastructureMode == os802_11Infrastructure)
+			iwe.u.mode = IW_MODE_INFRA;
+		else
+			iwe.u.mode = IW_MODE_AUTO;
+
+#if LINUX_VERSION_CODE < KERNEL_VERSION(2,6,27)
+		event = iwe_stream_add_event(event, end_buf, &iwe, IW_EV_UINT_LEN);
+#else
+		event = iwe_stream_add_event(&info,event, end_buf, &iwe, IW_EV_UINT_LEN);
+#endif
+
+		/* add freq */
+		os_memorySet (hOs, &iwe, 0, sizeof(iwe));
+		iwe.cmd = SIOCGIWFREQ;
+		iwe.u.freq.m = my_current->Configuration.Union.channel;
+		iwe.u.freq.e = 3; /* Frequency divider */
+		iwe.u.freq.i = 0;
+		iwe.len = IW_EV_FREQ_LEN;
+
+#if LINUX_VERSION_CODE < KERNEL_VERSION(2,6,27)
+		event = iwe_stream_add_event(event, end_buf, &iwe, IW_EV_FREQ_LEN);
+#else
+		event = iwe_stream_add_event(&info,event, end_buf, &iwe, IW_EV_FREQ_LEN);
+#endif
+
+		/* Add quality statistics */
+		iwe.cmd = IWEVQUAL;
+		iwe.u.qual.updated = IW_QUAL_LEVEL_UPDATED | IW_QUAL_QUAL_INVALID | IW_QUAL_NOISE_INVALID | IW_QUAL_DBM;
+		iwe.u.qual.qual = 0;
+		iwe.u.qual.level = my_current->Rssi;
+		iwe.u.qual.noise = 0;
+
+#if LINUX_VERSION_CODE < KERNEL_VERSION(2,6,27)
+		event = iwe_stream_add_event(event, end_buf, &iwe, IW_EV_QUAL_LEN);
+#else
+		event = iwe_stream_add_event(&info,event, end_buf, &iwe, IW_EV_QUAL_LEN);
+#endif
+
+		/* Add encryption capability */
+		iwe.cmd = SIOCGIWENCODE;
+		if ((my_current->Capabilities >> CAP_PRIVACY_SHIFT) & CAP_PRIVACY_MASK)
+			iwe.u.data.flags = IW_ENCODE_ENABLED | IW_ENCODE_NOKEY;
+		else
+			iwe.u.data.flags = IW_ENCODE_DISABLED;
+		iwe.u.data.length = 0;
+
+#if LINUX_VERSION_CODE < KERNEL_VERSION(2,6,27)
+		event = iwe_stream_add_point(event, end_buf, &iwe, NULL);
+#else
+		event = iwe_stream_add_point(&info,event, end_buf, &iwe, NULL);
+#endif
+
+		/* add rate */
+		os_memorySet (hOs, &iwe, 0, sizeof(iwe));
+		iwe.cmd = SIOCGIWRATE;
+		current_val = event + IW_EV_LCP_LEN;
+
+		current_rates = (TI_UINT8 *)(pRateList[i]);
+
+		for (j=0; j<32; j++) {
+			if (current_rates[j]) {
+				if ((current_rates[j] & 0x7f) == NET_RATE_MCS7) {
+					iwe.u.bitrate.value = WEXT_MAX_RATE_REAL_VALUE;  /* convert the special code 0x7f to 65Mbps */
+				} else {
+					iwe.u.bitrate.value = CALCULATE_RATE_VALUE(current_rates[j])
+				}
+#if LINUX_VERSION_CODE < KERNEL_VERSION(2,6,27)
+				current_val = iwe_stream_add_value(event, current_val, end_buf, &iwe,IW_EV_PARAM_LEN);
+#else
+				current_val = iwe_stream_add_value(&info,event, current_val,end_buf, &iwe,IW_EV_PARAM_LEN);
+#endif
+			}
+		}
+
+		/* skip the rates event header if no rate was added */
+		if ((current_val - event) > IW_EV_LCP_LEN) {
+			event = current_val;
+		}
+
+		/* CUSTOM - Add beacon interval */
+		os_memorySet (hOs, &iwe, 0, sizeof(iwe));
+		iwe.cmd = IWEVCUSTOM;
+		snprintf(buf, sizeof(buf), "Bcn int = %d ms ", my_current->Configuration.BeaconPeriod);
+		iwe.u.data.length = strlen(buf);
+
+#if LINUX_VERSION_CODE < KERNEL_VERSION(2,6,27)
+		event = iwe_stream_add_point(event, end_buf, &iwe, buf);
+#else
+		event = iwe_stream_add_point(&info,event, end_buf, &iwe, buf);
+#endif
+		/* add ALL variable IEs */
+		os_memorySet (hOs, &iwe, 0, sizeof(iwe));
+		iwe.cmd = IWEVGENIE;
+		offset = sizeof(OS_802_11_FIXED_IEs);
+		while (offset < my_current->IELength) {
+			OS_802_11_VARIABLE_IEs *pIE;
+			pIE = (OS_802_11_VARIABLE_IEs*)&(my_current->IEs[offset]);
+			iwe.u.data.flags = 1;
+			iwe.u.data.length = pIE->Length + 2;
+
+#if LINUX_VERSION_CODE < KERNEL_VERSION(2,6,27)
+			event = iwe_stream_add_point(event, end_buf, &iwe, (char *)&(my_current->IEs[offset]));
+#else
+			event = iwe_stream_add_point(&info, event, end_buf, &iwe, (char *)&(my_current->IEs[offset]));
+#endif
+			offset += pIE->Length + 2;
+		}
+
+		my_current = (OS_802_11_BSSID_EX *) (((char *) my_current) + my_current->Length);
+	}
+
+	return (TI_UINT32)(event - pBuf);
+}
+
+/* Retrieves the BSSID list and rebuilds the scan results cache for the given table generation */
+static int cmdInterpret_BuildScanCache (cmdInterpret_t *pCmdInterpret, paramInfo_t *pParam, TI_UINT32 uGeneration)
+{
+	OS_802_11_BSSID_LIST_EX *my_list = NULL;
+	OS_802_11_N_RATES *rate_list = NULL;
+	TI_UINT32 allocated_size, rates_allocated_size = 0;
+	TI_UINT32 uCacheSize;
+	TI_STATUS res;
+	int ret = WEXT_OK;
+
+	pCmdInterpret->bScanCacheValid = TI_FALSE;
+
+	/* First get the amount of memory required to hold the entire BSSID list */
+	pParam->paramType = SCAN_CNCN_BSSID_LIST_SIZE_PARAM;
+	pParam->paramLength = 0;
+	res = cmdDispatch_GetParam (pCmdInterpret->hCmdDispatch, pParam );
+	if (res != TI_OK) {
+		return WEXT_INVALID_PARAMETER;
+	}
+	allocated_size = pParam->content.uBssidListSize;
+
+	/* Allocate required memory and retrieve the list */
+	my_list = os_memoryAlloc (pCmdInterpret->hOs, allocated_size);
+	if (!my_list) {
+		return -ENOMEM;
+	}
+	pParam->paramType = SCAN_CNCN_BSSID_LIST_PARAM;
+	pParam->content.pBssidList = my_list;
+	pParam->paramLength = allocated_size;
+	res = cmdDispatch_GetParam (pCmdInterpret->hCmdDispatch, pParam );
+	if (res != TI_OK) {
+		ret = WEXT_INVALID_PARAMETER;
+		goto build_end;
+	}
+
+	/* Retrieve the rate list of every entry. This rate list is extended to include 11n rates */
+	rates_allocated_size = my_list->NumberOfItems * sizeof(OS_802_11_N_RATES);
+	if (rates_allocated_size) {
+		rate_list = os_memoryAlloc (pCmdInterpret->hOs, rates_allocated_size);
+		if (!rate_list) {
+			ret = -ENOMEM;
+			goto build_end;
+		}
+		pParam->paramType = SCAN_CNCN_BSSID_RATE_LIST_PARAM;
+		pParam->content.pRateList = rate_list;
+		pParam->paramLength = rates_allocated_size;
+		res = cmdDispatch_GetParam (pCmdInterpret->hCmdDispatch, pParam );
+		if (res != TI_OK) {
+			ret = WEXT_INVALID_PARAMETER;
+			goto build_end;
+		}
+	}
+
+	/* Grow the cache if the encoded list may not fit in it */
+	uCacheSize = cmdInterpret_ScanEventsSize (my_list, rate_list);
+	if (uCacheSize > pCmdInterpret->uScanCacheSize) {
+		if (pCmdInterpret->pScanCache) {
+			os_memoryFree (pCmdInterpret->hOs, pCmdInterpret->pScanCache, pCmdInterpret->uScanCacheSize);
+		}
+		pCmdInterpret->uScanCacheSize = 0;
+		pCmdInterpret->pScanCache = os_memoryAlloc (pCmdInterpret->hOs, uCacheSize);
+		if (!pCmdInterpret->pScanCache) {
+			ret = -ENOMEM;
+			goto build_end;
+		}
+		pCmdInterpret->uScanCacheSize = uCacheSize;
+	}
+
+	/* Now encode a wireless event per BSSID with "tokens" describing it */
+	pCmdInterpret->uScanCacheLen = cmdInterpret_EncodeScanEvents (pCmdInterpret->hOs, my_list, rate_list,
+	                               pCmdInterpret->pScanCache, pCmdInterpret->uScanCacheSize);
+	pCmdInterpret->uScanCacheGeneration = uGeneration;
+	pCmdInterpret->bScanCacheValid = TI_TRUE;
+
+build_end:
+	os_memoryFree (pCmdInterpret->hOs, my_list, allocated_size);
+	if (rate_list) {
+		os_memoryFree (pCmdInterpret->hOs, rate_list, rates_allocated_size);
+	}
+	return ret;
+}
+
+
+#ifdef TI_DBG
+
+#define SCAN_CACHE_BENCHMARK_DEF_BSS        200
+#define SCAN_CACHE_BENCHMARK_ITERATIONS     100
+
+/* Variable IEs of a typical 11n beacon: SSID, rates, DS, TIM, extended rates, RSN, WMM, HT capabilities and HT information */
+static const TI_UINT8 aScanCacheBenchmarkIEs[] = {
+	0x00, 0x08, 'b', 'e', 'n', 'c', 'h', 'm', 'r', 'k',
+	0x01, 0x08, 0x82, 0x84, 0x8b, 0x96, 0x0c, 0x12, 0x18, 0x24,
+	0x03, 0x01, 0x06,
+	0x05, 0x04, 0x00, 0x01, 0x00, 0x00,
+	0x32, 0x04, 0x30, 0x48, 0x60, 0x6c,
+	0x30, 0x14, 0x01, 0x00, 0x00, 0x0f, 0xac, 0x04, 0x01, 0x00, 0x00, 0x0f, 0xac, 0x04, 0x01, 0x00, 0x00, 0x0f, 0xac, 0x02, 0x00, 0x00,
+	0xdd, 0x18, 0x00, 0x50, 0xf2, 0x02, 0x01, 0x01, 0x00, 0x00, 0x03, 0xa4, 0x00, 0x00, 0x27, 0xa4,
+	0x00, 0x00, 0x42, 0x43, 0x5e, 0x00, 0x62, 0x32, 0x2f, 0x00,
+	0x2d, 0x1a, 0x6e, 0x10, 0x1b, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x3d, 0x16, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+/*
+ * Compare the SIOCGIWSCAN cost with and without the scan results cache, over a synthetic
+ *   BSSID list: encoding the list on every request, vs. copying the cached stream.
+ */
+void cmdInterpret_ScanCacheBenchmark (TI_HANDLE hOs, TI_UINT32 uNumBss)
+{
+	OS_802_11_BSSID_LIST_EX *pList;
+	OS_802_11_BSSID_EX *pBssid;
+	OS_802_11_N_RATES *pRateList;
+	char *pCache, *pUserBuf;
+	TI_UINT32 uEntryLen, uListSize, uRatesSize, uCacheSize, uCacheLen = 0;
+	TI_UINT32 uEncodeTime, uCopyTime, uStart;
+	TI_UINT32 uBss, uIter;
+
+	if (uNumBss == 0) {
+		uNumBss = SCAN_CACHE_BENCHMARK_DEF_BSS;
+	}
+
+	uEntryLen = (offsetof(OS_802_11_BSSID_EX, IEs) + sizeof(OS_802_11_FIXED_IEs) + sizeof(aScanCacheBenchmarkIEs) + 3) & ~3;
+	uListSize = sizeof(TI_UINT32) + uNumBss * uEntryLen;
+	uRatesSize = uNumBss * sizeof(OS_802_11_N_RATES);
+
+	pList = os_memoryAlloc (hOs, uListSize);
+	pRateList = os_memoryAlloc (hOs, uRatesSize);
+	if (!pList || !pRateList) {
+		WLAN_OS_REPORT(("Scan cache benchmark: memory allocation failed\n"));
+		goto bench_end_list;
+	}
+
+	/* Build the synthetic list */
+	os_memoryZero (hOs, pList, uListSize);
+	os_memoryZero (hOs, pRateList, uRatesSize);
+	pList->NumberOfItems = uNumBss;
+	pBssid = &pList->Bssid[0];
+	for (uBss = 0; uBss < uNumBss; uBss++) {
+		pBssid->Length = uEntryLen;
+		pBssid->MacAddress[0] = 0x02;
+		pBssid->MacAddress[4] = (TI_UINT8)(uBss >> 8);
+		pBssid->MacAddress[5] = (TI_UINT8)uBss;
+		pBssid->Capabilities = (TI_UINT16)(uBss & 1) << CAP_PRIVACY_SHIFT;
+		pBssid->Ssid.SsidLength = 8;
+		os_memoryCopy (hOs, pBssid->Ssid.Ssid, "benchmrk", 8);
+		pBssid->Rssi = -40 - (TI_INT32)(uBss % 50);
+		pBssid->NetworkTypeInUse = os802_11OFDM24;
+		pBssid->Configuration.BeaconPeriod = 100;
+		pBssid->Configuration.Union.channel = 2412 + 5 * (uBss % 11);
+		pBssid->InfrastructureMode = os802_11Infrastructure;
+		pBssid->IELength = sizeof(OS_802_11_FIXED_IEs) + sizeof(aScanCacheBenchmarkIEs);
+		os_memoryCopy (hOs, &pBssid->IEs[sizeof(OS_802_11_FIXED_IEs)], (void *)aScanCacheBenchmarkIEs, sizeof(aScanCacheBenchmarkIEs));
+		os_memoryCopy (hOs, pRateList[uBss], &aScanCacheBenchmarkIEs[12], 8);
+		os_memoryCopy (hOs, &pRateList[uBss][8], &aScanCacheBenchmarkIEs[31], 4);
+		pBssid = (OS_802_11_BSSID_EX *) (((char *) pBssid) + pBssid->Length);
+	}
+
+	uCacheSize = cmdInterpret_ScanEventsSize (pList, pRateList);
+	pCache = os_memoryAlloc (hOs, uCacheSize);
+	pUserBuf = os_memoryAlloc (hOs, uCacheSize);
+	if (!pCache || !pUserBuf) {
+		WLAN_OS_REPORT(("Scan cache benchmark: memory allocation failed\n"));
+		goto bench_end;
+	}
+
+	/* Without the cache: every request encodes the list again */
+	uStart = os_timeStampUs (hOs);
+	for (uIter = 0; uIter < SCAN_CACHE_BENCHMARK_ITERATIONS; uIter++) {
+		uCacheLen = cmdInterpret_EncodeScanEvents (hOs, pList, pRateList, pUserBuf, uCacheSize);
+	}
+	uEncodeTime = os_timeStampUs (hOs) - uStart;
+
+	/* With the cache: the list is encoded once, and every request copies the stream */
+	uStart = os_timeStampUs (hOs);
+	uCacheLen = cmdInterpret_EncodeScanEvents (hOs, pList, pRateList, pCache, uCacheSize);
+	for (uIter = 0; uIter < SCAN_CACHE_BENCHMARK_ITERATIONS; uIter++) {
+		os_memoryCopy (hOs, pUserBuf, pCache, uCacheLen);
+	}
+	uCopyTime = os_timeStampUs (hOs) - uStart;
+
+	WLAN_OS_REPORT(("Scan cache benchmark: %d BSSs, %d requests, %d bytes of events (bound %d)\n",
+	                uNumBss, SCAN_CACHE_BENCHMARK_ITERATIONS, uCacheLen, uCacheSize));
+	WLAN_OS_REPORT(("  Encode per request: %d usec\n", uEncodeTime));
+	WLAN_OS_REPORT(("  Cached:             %d usec\n", uCopyTime));
+
+bench_end:
+	if (pCache) {
+		os_memoryFree (hOs, pCache, uCacheSize);
+	}
+	if (pUserBuf) {
+		os_memoryFree (hOs, pUserBuf, uCacheSize);
+	}
+bench_end_list:
+	if (pList) {
+		os_memoryFree (hOs, pList, uListSize);
+	}
+	if (pRateList) {
+		os_memoryFree (hOs, pRateList, uRatesSize);
+	}
+}
+
+#endif /* TI_DBG */
+
+/* Execute a single private command on the given parameter structure */
+static TI_STATUS cmdInterpret_PrivateCmd (cmdInterpret_t *pCmdInterpret, paramInfo_t *pParam,
+                                          ti_private_cmd_t *my_command, TConfigCommand *cmdObj)
+{
+	TI_STATUS res = TI_NOK;
+	void     *pAlloc = NULL;
+	TI_UINT32 uAllocLen = 0;
+
+	/*
+	os_printf ("cmd =  0x%x     flags = 0x%x\n",(unsigned int)my_command->cmd,(unsigned int)my_command->flags);
+	os_printf ("in_buffer =  0x%x (len = %d)\n",my_command->in_buffer,(unsigned int)my_command->in_buffer_len);
+	os_printf ("out_buffer =  0x%x (len = %d)\n",my_command->out_buffer,(unsigned int)my_command->out_buffer_len);
+	*/
+
+	pParam->paramType = my_command->cmd;
+
+	if (IS_PARAM_ASYNC(my_command->cmd)) {
+
+		/* os_printf ("Detected ASYNC command - setting CB \n"); */
+		pParam->content.interogateCmdCBParams.hCb  =  (TI_HANDLE)pCmdInterpret;
+		pParam->content.interogateCmdCBParams.fCb  =  (void*)cmdInterpret_ServiceCompleteCB;
+		pParam->content.interogateCmdCBParams.pCb  =  my_command->out_buffer;
+		if (my_command->out_buffer) {
+			/* the next copy is need for PLT commands */
+			os_memoryCopy(pCmdInterpret->hOs,  my_command->out_buffer, my_command->in_buffer, min(my_command->in_buffer_len,my_command->out_buffer_len));
+		}
+	} else if (IS_ALLOC_NEEDED_PARAM(my_command->cmd)) {
+
+		/*
+		this cmd doesnt have the structure allocated as part of the paramInfo_t structure.
+		as a result we need to allocate the memory internally.
+		GET handlers bound their writes by paramLength (the output length), so the buffer
+		must hold the larger of the input and the output.
+		*/
+		uAllocLen = max(my_command->in_buffer_len, my_command->out_buffer_len);
+		if (uAllocLen) {
+			pAlloc = os_memoryAlloc(pCmdInterpret->hOs, uAllocLen);
+			if (!pAlloc) {
+				return TI_NOK;
+			}
+			os_memoryZero(pCmdInterpret->hOs, pAlloc, uAllocLen);
+			if (my_command->in_buffer) {
+				os_memoryCopy(pCmdInterpret->hOs, pAlloc, my_command->in_buffer, my_command->in_buffer_len);
+			}
+		}
+		*(void **)&pParam->content = pAlloc;
+	} else if ((my_command->in_buffer) && (my_command->in_buffer_len)) {
+		os_memoryCopy(pCmdInterpret->hOs,&pParam->content,my_command->in_buffer,my_command->in_buffer_len);
+	}
+
+	if (my_command->flags & PRIVATE_CMD_SET_FLAG) {
+		/* os_printf ("Calling setParam\n"); */
+		pParam->paramLength = my_command->in_buffer_len;
+		res = cmdDispatch_SetParam (pCmdInterpret->hCmdDispatch,pParam);
+	} else if (my_command->flags & PRIVATE_CMD_GET_FLAG) {
+		/* os_printf ("Calling getParam\n"); */
+		pParam->paramLength = my_command->out_buffer_len;
+		res = cmdDispatch_GetSnapshotParam (pCmdInterpret->hCmdDispatch,pParam);
+		if (res == EXTERNAL_GET_PARAM_DENIED) {
+			if (pAlloc) {
+				os_memoryFree(pCmdInterpret->hOs, pAlloc, uAllocLen);
+			}
+			return res;
+		}
+
+		/*
+		this is for cmd that want to check the size of memory that they need to
+		allocate for the actual data.
+		*/
+		if (pParam->paramLength && (my_command->out_buffer_len == 0)) {
+			my_command->out_buffer_len = pParam->paramLength;
+		}
+	} else {
+		res = TI_NOK;
+	}
+
+	if (res == TI_OK) {
+		if (IS_PARAM_ASYNC(my_command->cmd)) {
+			pCmdInterpret->pAsyncCmd = cmdObj; /* Save command handle for completion CB */
+			res = COMMAND_PENDING;
+		} else {
+			if ((my_command->out_buffer) && (my_command->out_buffer_len)) {
+				if (IS_ALLOC_NEEDED_PARAM(my_command->cmd)) {
+					if (pAlloc) {
+						os_memoryCopy(pCmdInterpret->hOs,my_command->out_buffer,pAlloc,min(my_command->out_buffer_len,uAllocLen));
+					}
+				} else {
+					os_memoryCopy(pCmdInterpret->hOs,my_command->out_buffer,&pParam->content,my_command->out_buffer_len);
+				}
+			}
+		}
+	}
+
+	/* need to free the allocated memory */
+	if (pAlloc) {
+		os_memoryFree(pCmdInterpret->hOs, pAlloc, uAllocLen);
+	}
+
+	return res;
+}
+
+/*
+ * Execute the entries of a DRIVER_BATCH_PARAM private command in order, keeping a WEXT status per entry.
+ * Async and driver level commands can't complete in this pass, so they are rejected.
+ */
+static TI_STATUS cmdInterpret_BatchCmd (cmdInterpret_t *pCmdInterpret, paramInfo_t *pParam,
+                                        ti_private_cmd_t *my_command, TConfigCommand *cmdObj)
+{
+	ti_private_cmd_batch_entry_t *pEntries = (ti_private_cmd_batch_entry_t *)my_command->in_buffer;
+	TI_UINT32 uNum = my_command->in_buffer_len / sizeof(ti_private_cmd_batch_entry_t);
+	TI_UINT32 i;
+	TI_STATUS res;
+
+	for (i = 0; i < uNum; i++) {
+		if (IS_PARAM_ASYNC(pEntries[i].cmd.cmd) || IS_PARAM_FOR_MODULE(pEntries[i].cmd.cmd, DRIVER_MODULE_PARAM)) {
+			pEntries[i].status = WEXT_NOT_SUPPORTED;
+			continue;
+		}
+
+		res = cmdInterpret_PrivateCmd (pCmdInterpret, pParam, &pEntries[i].cmd, cmdObj);
+		if (res == TI_OK) {
+			pEntries[i].status = WEXT_OK;
+		} else if (res == EXTERNAL_GET_PARAM_DENIED) {
+			pEntries[i].status = WEXT_INVALID_PARAMETER;
+		} else {
+			pEntries[i].status = WEXT_NOT_SUPPORTED;
+		}
+	}
+
+	return TI_OK;
+}
+
 /* Handle a single command */
 int cmdInterpret_convertAndExecute(TI_HANDLE hCmdInterpret, TConfigCommand *cmdObj)
 {
@@ -577,253 +1133,33 @@ int cmdInterpret_convertAndExecute(TI_HANDLE hCmdInterpret, TConfigCommand *cmdO
 
 	/* get scanning results */
 	case SIOCGIWSCAN: {
-		unsigned char buf[30];
-		char *event = (char *)cmdObj->buffer2;
-		struct iw_event iwe;
-		char *end_buf, *current_val;
-		int allocated_size, rates_allocated_size;
-		OS_802_11_BSSID_LIST_EX *my_list;
-		OS_802_11_BSSID_EX *my_current;
-		OS_802_11_N_RATES *rate_list;
-		TI_UINT8 *current_rates;
-		int offset;
-
-#if LINUX_VERSION_CODE >= KERNEL_VERSION(2,6,27)
-		struct iw_request_info info;
-		info.cmd = SIOCGIWSCAN;
-		info.flags = 0;
-#endif
-		end_buf = (char *)(cmdObj->buffer2 + wrqu->data.length);
-
-		/* First get the amount of memory required to hold the entire BSSID list by setting the length to 0 */
-		pParam->paramType = SCAN_CNCN_BSSID_LIST_SIZE_PARAM;
+		/* Get the scan result table generation. The results are encoded again only if the table has changed */
+		pParam->paramType = SCAN_CNCN_BSSID_LIST_GENERATION_PARAM;
 		pParam->paramLength = 0;
 		res = cmdDispatch_GetParam (pCmdInterpret->hCmdDispatch, pParam );
 		CHECK_PENDING_RESULT(res,pParam)
 
-		allocated_size = pParam->content.uBssidListSize;
+		if ((TI_FALSE == pCmdInterpret->bScanCacheValid) ||
+		        (pParam->content.uBssidListGeneration != pCmdInterpret->uScanCacheGeneration)) {
+			res = cmdInterpret_BuildScanCache (pCmdInterpret, pParam, pParam->content.uBssidListGeneration);
+			if (res != WEXT_OK) {
+				goto cmd_end;
+			}
+		}
 
-		/* allocated_size contains the required buffersize. If this value is
-		   larger than the buffer provided by the supplicant, then return
-		   the required size and exit */
-		if (allocated_size > wrqu->data.length) {
-			wrqu->data.length = allocated_size;
+		/* If the results are larger than the buffer provided by the supplicant, then return
+		   the required size and exit. The cache is kept for the following request */
+		if (pCmdInterpret->uScanCacheLen > wrqu->data.length) {
+			wrqu->data.length = pCmdInterpret->uScanCacheLen;
 			cmdObj->return_code = WEXT_OK;
 			break;
 		}
 
-		/* Allocate required memory */
-		my_list = os_memoryAlloc (pCmdInterpret->hOs, allocated_size);
-		if (!my_list) {
-			res = -ENOMEM;
-			goto cmd_end;
+		if (pCmdInterpret->uScanCacheLen) {
+			os_memoryCopy (pCmdInterpret->hOs, cmdObj->buffer2, pCmdInterpret->pScanCache, pCmdInterpret->uScanCacheLen);
 		}
-
-		/* And retrieve the list */
-		pParam->paramType = SCAN_CNCN_BSSID_LIST_PARAM;
-		pParam->content.pBssidList = my_list;
-		pParam->paramLength = allocated_size;
-		res = cmdDispatch_GetParam (pCmdInterpret->hCmdDispatch, pParam );
-		CHECK_PENDING_RESULT(res,pParam)
-
-		/* Get the number of entries in the scan result list and allocate enough memory to hold rate list
-		   for every entry. This rate list is extended to include 11n rates */
-		pParam->paramType = SCAN_CNCN_NUM_BSSID_IN_LIST_PARAM;
-		pParam->paramLength = 0;
-		res = cmdDispatch_GetParam (pCmdInterpret->hCmdDispatch, pParam );
-		CHECK_PENDING_RESULT(res,pParam)
-
-		rates_allocated_size = pParam->content.uNumBssidInList * sizeof(OS_802_11_N_RATES);
-
-		/* Allocate required memory */
-		rate_list = os_memoryAlloc (pCmdInterpret->hOs, rates_allocated_size);
-		if (!rate_list) {
-			os_memoryFree (pCmdInterpret->hOs, my_list, allocated_size);
-			res = -ENOMEM;
-			goto cmd_end;
-		}
-
-		/* And retrieve the list */
-		pParam->paramType = SCAN_CNCN_BSSID_RATE_LIST_PARAM;
-		pParam->content.pRateList = rate_list;
-		pParam->paramLength = rates_allocated_size;
-		res = cmdDispatch_GetParam (pCmdInterpret->hCmdDispatch, pParam );
-		CHECK_PENDING_RESULT(res,pParam)
-
-
-		my_current = &my_list->Bssid[0];
-		i = 0;
-		if (wrqu->data.flags) {
-			for (i=0; i<wrqu->data.flags; i++)
-				my_current = (OS_802_11_BSSID_EX *) (((char *) my_current) + my_current->Length);
-		}
-		/* Now send a wireless event per BSSID with "tokens" describing it */
-
-		for (; i<my_list->NumberOfItems; i++) {
-			int remain = end_buf - (event + my_current->Length);
-			if (remain < 0) {
-				wrqu->data.length += -remain;
-				goto giwscan_end;
-			}
-
-			/* The first entry MUST be the AP BSSID */
-			os_memorySet (pCmdInterpret->hOs, &iwe, 0, sizeof(iwe));
-			iwe.cmd = SIOCGIWAP;
-			iwe.u.ap_addr.sa_family = ARPHRD_ETHER;
-			iwe.len = IW_EV_ADDR_LEN;
-			os_memoryCopy(pCmdInterpret->hOs, iwe.u.ap_addr.sa_data, &my_current->MacAddress, ETH_ALEN);
-
-#if LINUX_VERSION_CODE < KERNEL_VERSION(2,6,27)
-			event = iwe_stream_add_event(event, end_buf, &iwe, IW_EV_ADDR_LEN);
-#else
-			event = iwe_stream_add_event(&info,event, end_buf, &iwe, IW_EV_ADDR_LEN);
-#endif
-
-			/* Add SSID */
-			iwe.cmd = SIOCGIWESSID;
-			iwe.u.data.flags = 1;
-			iwe.u.data.length = min((TI_UINT8)my_current->Ssid.SsidLength, (TI_UINT8)32);
-
-#if LINUX_VERSION_CODE < KERNEL_VERSION(2,6,27)
-			event = iwe_stream_add_point(event, end_buf, &iwe, my_current->Ssid.Ssid);
-#else
-			event = iwe_stream_add_point(&info,event, end_buf, &iwe, my_current->Ssid.Ssid);
-#endif
-
-			/* Add the protocol name (BSS support for A/B/G) */
-			os_memorySet (pCmdInterpret->hOs, &iwe, 0, sizeof(iwe));
-			iwe.cmd = SIOCGIWNAME;
-			os_memoryCopy(pCmdInterpret->hOs, (void*)iwe.u.name, (void*)ieee80211_modes[my_current->NetworkTypeInUse], IFNAMSIZ);
-
-#if LINUX_VERSION_CODE < KERNEL_VERSION(2,6,27)
-			event = iwe_stream_add_event(event, end_buf, &iwe, IW_EV_CHAR_LEN);
-#else
-			event = iwe_stream_add_event(&info,event, end_buf, &iwe, IW_EV_CHAR_LEN);
-#endif
-
-			/* add mode (infrastructure or Adhoc) */
-			os_memorySet (pCmdInterpret->hOs, &iwe, 0, sizeof(iwe));
-			iwe.cmd = SIOCGIWMODE;
-			if (my_current->InfrastructureMode == os802_11IBSS)
-				iwe.u.mode = IW_MODE_ADHOC;
-			else if (my_current->InfrastructureMode == os802_11Infrastructure)
-				iwe.u.mode = IW_MODE_INFRA;
-			else
-				iwe.u.mode = IW_MODE_AUTO;
-
-#if LINUX_VERSION_CODE < KERNEL_VERSION(2,6,27)
-			event = iwe_stream_add_event(event, end_buf, &iwe, IW_EV_UINT_LEN);
-#else
-			event = iwe_stream_add_event(&info,event, end_buf, &iwe, IW_EV_UINT_LEN);
-#endif
-
-			/* add freq */
-			os_memorySet (pCmdInterpret->hOs, &iwe, 0, sizeof(iwe));
-			iwe.cmd = SIOCGIWFREQ;
-			iwe.u.freq.m = my_current->Configuration.Union.channel;
-			iwe.u.freq.e = 3; /* Frequency divider */
-			iwe.u.freq.i = 0;
-			iwe.len = IW_EV_FREQ_LEN;
-
-#if LINUX_VERSION_CODE < KERNEL_VERSION(2,6,27)
-			event = iwe_stream_add_event(event, end_buf, &iwe, IW_EV_FREQ_LEN);
-#else
-			event = iwe_stream_add_event(&info,event, end_buf, &iwe, IW_EV_FREQ_LEN);
-#endif
-
-			/* Add quality statistics */
-			iwe.cmd = IWEVQUAL;
-			iwe.u.qual.updated = IW_QUAL_LEVEL_UPDATED | IW_QUAL_QUAL_INVALID | IW_QUAL_NOISE_INVALID | IW_QUAL_DBM;
-			iwe.u.qual.qual = 0;
-			iwe.u.qual.level = my_current->Rssi;
-			iwe.u.qual.noise = 0;
-
-#if LINUX_VERSION_CODE < KERNEL_VERSION(2,6,27)
-			event = iwe_stream_add_event(event, end_buf, &iwe, IW_EV_QUAL_LEN);
-#else
-			event = iwe_stream_add_event(&info,event, end_buf, &iwe, IW_EV_QUAL_LEN);
-#endif
-
-			/* Add encryption capability */
-			iwe.cmd = SIOCGIWENCODE;
-			if ((my_current->Capabilities >> CAP_PRIVACY_SHIFT) & CAP_PRIVACY_MASK)
-				iwe.u.data.flags = IW_ENCODE_ENABLED | IW_ENCODE_NOKEY;
-			else
-				iwe.u.data.flags = IW_ENCODE_DISABLED;
-			iwe.u.data.length = 0;
-
-#if LINUX_VERSION_CODE < KERNEL_VERSION(2,6,27)
-			event = iwe_stream_add_point(event, end_buf, &iwe, NULL);
-#else
-			event = iwe_stream_add_point(&info,event, end_buf, &iwe, NULL);
-#endif
-
-			/* add rate */
-			os_memorySet (pCmdInterpret->hOs, &iwe, 0, sizeof(iwe));
-			iwe.cmd = SIOCGIWRATE;
-			current_val = event + IW_EV_LCP_LEN;
-
-			current_rates = (TI_UINT8 *)(rate_list[i]);
-
-			for (j=0; j<32; j++) {
-				if (current_rates[j]) {
-					if ((current_rates[j] & 0x7f) == NET_RATE_MCS7) {
-						iwe.u.bitrate.value = WEXT_MAX_RATE_REAL_VALUE;  /* convert the special code 0x7f to 65Mbps */
-					} else {
-						iwe.u.bitrate.value = CALCULATE_RATE_VALUE(current_rates[j])
-					                      }
-#if LINUX_VERSION_CODE < KERNEL_VERSION(2,6,27)
-					                      current_val = iwe_stream_add_value(event, current_val, end_buf, &iwe,IW_EV_PARAM_LEN);
-#else
-					                      current_val = iwe_stream_add_value(&info,event, current_val,end_buf, &iwe,IW_EV_PARAM_LEN);
-#endif
-				}
-			}
-
-			event = current_val;
-
-			/* CUSTOM - Add beacon interval */
-			os_memorySet (pCmdInterpret->hOs, &iwe, 0, sizeof(iwe));
-			iwe.cmd = IWEVCUSTOM;
-			sprintf(buf, "Bcn int = %d ms ", my_current->Configuration.BeaconPeriod);
-			iwe.u.data.length = strlen(buf);
-
-#if LINUX_VERSION_CODE < KERNEL_VERSION(2,6,27)
-			event = iwe_stream_add_point(event, end_buf, &iwe, buf);
-#else
-			event = iwe_stream_add_point(&info,event, end_buf, &iwe, buf);
-#endif
-			/* add ALL variable IEs */
-			os_memorySet (pCmdInterpret->hOs, &iwe, 0, sizeof(iwe));
-			iwe.cmd = IWEVGENIE;
-			offset = sizeof(OS_802_11_FIXED_IEs);
-			while (offset < my_current->IELength) {
-				OS_802_11_VARIABLE_IEs *pIE;
-				pIE = (OS_802_11_VARIABLE_IEs*)&(my_current->IEs[offset]);
-				iwe.u.data.flags = 1;
-				iwe.u.data.length = pIE->Length + 2;
-
-#if LINUX_VERSION_CODE < KERNEL_VERSION(2,6,27)
-				event = iwe_stream_add_point(event, end_buf, &iwe, (char *)&(my_current->IEs[offset]));
-#else
-				event = iwe_stream_add_point(&info, event, end_buf, &iwe, (char *)&(my_current->IEs[offset]));
-#endif
-				offset += pIE->Length + 2;
-			}
-
-			my_current = (OS_802_11_BSSID_EX *) (((char *) my_current) + my_current->Length);
-		}
-
-		wrqu->data.length = event - ((char *)cmdObj->buffer2);
-		if (i == my_list->NumberOfItems) {
-			wrqu->data.flags = 0;
-		} else {
-			wrqu->data.flags = i;
-		}
-
-giwscan_end:
-		os_memoryFree (pCmdInterpret->hOs, my_list, allocated_size);
-		os_memoryFree (pCmdInterpret->hOs, rate_list, rates_allocated_size);
+		wrqu->data.length = pCmdInterpret->uScanCacheLen;
+		wrqu->data.flags = 0;
 		cmdObj->return_code = WEXT_OK;
 	}
 
@@ -1292,80 +1628,15 @@ giwscan_end:
 	case SIOCIWFIRSTPRIV: {
 		ti_private_cmd_t *my_command = (ti_private_cmd_t *)cmdObj->param3;
 
-		/*
-		os_printf ("cmd =  0x%x     flags = 0x%x\n",(unsigned int)my_command->cmd,(unsigned int)my_command->flags);
-		os_printf ("in_buffer =  0x%x (len = %d)\n",my_command->in_buffer,(unsigned int)my_command->in_buffer_len);
-		os_printf ("out_buffer =  0x%x (len = %d)\n",my_command->out_buffer,(unsigned int)my_command->out_buffer_len);
-		*/
-
-		pParam->paramType = my_command->cmd;
-
-		if (IS_PARAM_ASYNC(my_command->cmd)) {
-
-			/* os_printf ("Detected ASYNC command - setting CB \n"); */
-			pParam->content.interogateCmdCBParams.hCb  =  (TI_HANDLE)pCmdInterpret;
-			pParam->content.interogateCmdCBParams.fCb  =  (void*)cmdInterpret_ServiceCompleteCB;
-			pParam->content.interogateCmdCBParams.pCb  =  my_command->out_buffer;
-			if (my_command->out_buffer) {
-				/* the next copy is need for PLT commands */
-				os_memoryCopy(pCmdInterpret->hOs,  my_command->out_buffer, my_command->in_buffer, min(my_command->in_buffer_len,my_command->out_buffer_len));
-			}
-		} else if ((my_command->in_buffer) && (my_command->in_buffer_len)) {
-
-			/*
-			this cmd doesnt have the structure allocated as part of the paramInfo_t structure.
-			as a result we need to allocate the memory internally.
-			*/
-			if (IS_ALLOC_NEEDED_PARAM(my_command->cmd)) {
-
-				*(void **)&pParam->content = os_memoryAlloc(pCmdInterpret->hOs, my_command->in_buffer_len);
-				os_memoryCopy(pCmdInterpret->hOs, *(void **)&pParam->content, my_command->in_buffer, my_command->in_buffer_len);
-			} else
-				os_memoryCopy(pCmdInterpret->hOs,&pParam->content,my_command->in_buffer,my_command->in_buffer_len);
-		}
-
-		if (my_command->flags & PRIVATE_CMD_SET_FLAG) {
-			/* os_printf ("Calling setParam\n"); */
-			pParam->paramLength = my_command->in_buffer_len;
-			res = cmdDispatch_SetParam (pCmdInterpret->hCmdDispatch,pParam);
-		} else if (my_command->flags & PRIVATE_CMD_GET_FLAG) {
-			/* os_printf ("Calling getParam\n"); */
-			pParam->paramLength = my_command->out_buffer_len;
-			res = cmdDispatch_GetParam (pCmdInterpret->hCmdDispatch,pParam);
-			if (res == EXTERNAL_GET_PARAM_DENIED) {
-				cmdObj->return_code  = WEXT_INVALID_PARAMETER;
-				goto cmd_end;
-			}
-
-			/*
-			this is for cmd that want to check the size of memory that they need to
-			allocate for the actual data.
-			*/
-			if (pParam->paramLength && (my_command->out_buffer_len == 0)) {
-				my_command->out_buffer_len = pParam->paramLength;
-			}
-		} else {
-			res = TI_NOK;
-		}
-
-		if (res == TI_OK) {
-			if (IS_PARAM_ASYNC(my_command->cmd)) {
-				pCmdInterpret->pAsyncCmd = cmdObj; /* Save command handle for completion CB */
-				res = COMMAND_PENDING;
-			} else {
-				if ((my_command->out_buffer) && (my_command->out_buffer_len)) {
-					if (IS_ALLOC_NEEDED_PARAM(my_command->cmd)) {
-						os_memoryCopy(pCmdInterpret->hOs,my_command->out_buffer,*(void **)&pParam->content,my_command->out_buffer_len);
-					} else {
-						os_memoryCopy(pCmdInterpret->hOs,my_command->out_buffer,&pParam->content,my_command->out_buffer_len);
-					}
-				}
-			}
+		if (my_command->cmd == DRIVER_BATCH_PARAM) {
+			res = cmdInterpret_BatchCmd (pCmdInterpret, pParam, my_command, cmdObj);
+			break;
 		}
 
-		/* need to free the allocated memory */
-		if (IS_ALLOC_NEEDED_PARAM(my_command->cmd)) {
-			os_memoryFree(pCmdInterpret->hOs, *(void **)&pParam->content, my_command->in_buffer_len);
+		res = cmdInterpret_PrivateCmd (pCmdInterpret, pParam, my_command, cmdObj);
+		if (res == EXTERNAL_GET_PARAM_DENIED) {
+			cmdObj->return_code  = WEXT_INVALID_PARAMETER;
+			goto cmd_end;
 		}
 	}
 
@@ -1390,6 +1661,52 @@ cmd_end:
 
 
 
+/*
+ * Check if a command is a read-only GET that is served from the driver's memory, so it may be
+ *   executed directly in the caller context (as done for the wireless statistics in cmdInterpret_GetStat).
+ * Private commands are checked against the CmdDispatcher parameters descriptors.
+ */
+TI_BOOL cmdInterpret_IsSyncGet (TI_HANDLE hCmdInterpret, TConfigCommand *cmdObj)
+{
+	cmdInterpret_t   *pCmdInterpret = (cmdInterpret_t *)hCmdInterpret;
+	ti_private_cmd_t *my_command;
+
+	switch (cmdObj->cmd) {
+	case SIOCGIWNAME:
+		return TI_TRUE;
+
+	case SIOCIWFIRSTPRIV:
+		my_command = (ti_private_cmd_t *)cmdObj->param3;
+		if (my_command == NULL) {
+			return TI_FALSE;
+		}
+
+		/* A batch is sync only if all its entries are */
+		if (my_command->cmd == DRIVER_BATCH_PARAM) {
+			ti_private_cmd_batch_entry_t *pEntries = (ti_private_cmd_batch_entry_t *)my_command->in_buffer;
+			TI_UINT32 i;
+
+			for (i = 0; i < my_command->in_buffer_len / sizeof(ti_private_cmd_batch_entry_t); i++) {
+				if (!(pEntries[i].cmd.flags & PRIVATE_CMD_GET_FLAG) || IS_PARAM_ASYNC(pEntries[i].cmd.cmd) ||
+				    !cmdDispatch_IsSyncParam (pCmdInterpret->hCmdDispatch, pEntries[i].cmd.cmd)) {
+					return TI_FALSE;
+				}
+			}
+			return TI_TRUE;
+		}
+
+		if (!(my_command->flags & PRIVATE_CMD_GET_FLAG) || IS_PARAM_ASYNC(my_command->cmd)) {
+			return TI_FALSE;
+		}
+
+		return cmdDispatch_IsSyncParam (pCmdInterpret->hCmdDispatch, my_command->cmd);
+
+	default:
+		return TI_FALSE;
+	}
+}
+
+
 /* This routine is called by the command mailbox module to signal an ASYNC command has complete */
 int cmdInterpret_ServiceCompleteCB (TI_HANDLE hCmdInterpret, int status, void *buffer)
 {
@@ -1420,8 +1737,9 @@ static int cmdInterpret_initEvents(TI_HANDLE hCmdInterpret)
 	IPC_EVENT_PARAMS evParams;
 	int i = 0;
 
+	/* The events are passed to the CU, which handles merged events (batching is enabled by EventBatchInterval) */
 	for (i=0; i<IPC_EVENT_MAX; i++) {
-		evParams.uDeliveryType    = DELIVERY_PUSH;
+		evParams.uDeliveryType    = DELIVERY_PUSH_COALESCED;
 		evParams.uProcessID       = 0;
 		evParams.uEventID         = 0;
 		evParams.hUserParam       = hCmdInterpret;
@@ -1816,7 +2134,7 @@ void *cmdInterpret_GetStat (TI_HANDLE hCmdInterpret)
 			return NULL;
 
 		pParam->paramType = SITE_MGR_GET_STATS;
-		res = cmdDispatch_GetParam ( pCmdInterpret->hCmdDispatch, pParam );
+		res = cmdDispatch_GetSnapshotParam ( pCmdInterpret->hCmdDispatch, pParam );
 
 		if (res == TI_OK) {
 			pCmdInterpret->wstats.qual.level = (TI_UINT8)pParam->content.siteMgrCurrentRssi;
@@ -512,6 +512,68 @@ int wlanDrvIf_LoadFiles (TWlanDrvIfObj *drv, TLoaderFilesData *pInitFiles)
 }
 
 
+/**
+ * \fn     wlanDrvIf_CompileIniFile
+ * \brief  Compile the loaded ini-file to an init table blob
+ *
+ * This function is called from the loader context after the files were loaded
+ *     (see wlanDrvIf_LoadFiles) and before the driver is started.
+ * It parses the ini-file, reporting its errors, and copies the init table blob
+ *     to the loader, which saves it to be loaded instead of the ini-file text.
+ *
+ * \note
+ * \param  drv      - The driver object handle
+ * \param  pUserBuf - The loader buffer for the blob
+ * \param  uLength  - The loader buffer length
+ * \return 0 if the ini-file was compiled, error code otherwise
+ * \sa     drvMain_CompileIniFile
+ */
+int wlanDrvIf_CompileIniFile (TWlanDrvIfObj *drv, void *pUserBuf, unsigned long uLength)
+{
+	TI_UINT32 uBlobLength;
+	TI_UINT32 uCopyLength;
+	TI_UINT8 *pBlob;
+	int       rc = 0;
+
+	if (drv->tCommon.eDriverState != DRV_STATE_IDLE) {
+		ti_dprintf (TIWLAN_LOG_ERROR, "Trying to compile the ini-file not in IDLE state!\n");
+		return -EINVAL;
+	}
+	if (!drv->tCommon.tIniFile.pImage) {
+		ti_dprintf (TIWLAN_LOG_ERROR, "No Ini-File loaded!\n");
+		return -EINVAL;
+	}
+	if (!pUserBuf) {
+		ti_dprintf (TIWLAN_LOG_ERROR, "No init table blob buffer!\n");
+		return -EINVAL;
+	}
+
+	uBlobLength = INIT_TABLE_BLOB_MAX_LENGTH(drv->tCommon.tIniFile.uSize);
+	pBlob = os_memoryAlloc (drv, uBlobLength);
+	if (!pBlob) {
+		ti_dprintf (TIWLAN_LOG_ERROR, "Cannot allocate buffer for init table blob\n");
+		return -ENOMEM;
+	}
+
+	if (drvMain_CompileIniFile (drv, drv->tCommon.tIniFile.pImage, drv->tCommon.tIniFile.uSize,
+	                            pBlob, uBlobLength) != TI_OK) {
+		rc = -EINVAL;
+	} else {
+		uCopyLength = INIT_TABLE_BLOB_LENGTH((TInitTableBlobHdr *)pBlob);
+		if (uLength < uCopyLength) {
+			ti_dprintf (TIWLAN_LOG_ERROR, "Init table blob buffer too short (%lu < %u)\n", uLength, uCopyLength);
+			rc = -EINVAL;
+		} else if (os_memoryCopyToUser (drv, pUserBuf, pBlob, uCopyLength)) {
+			rc = -EFAULT;
+		}
+	}
+
+	os_memoryFree (drv, pBlob, uBlobLength);
+
+	return rc;
+}
+
+
 /**
  * \fn     wlanDrvIf_GetFile
  * \brief  Provides access to a requested init file
@@ -682,6 +744,8 @@ int wlanDrvIf_Start (struct net_device *dev)
 		return -ENODEV;
 	}
 
+	os_TraceRingSetDriverUp (drv, TI_TRUE);
+
 	return 0;
 }
 
@@ -744,6 +808,9 @@ int wlanDrvIf_Stop (struct net_device *dev)
 	 */
 	os_wake_lock_timeout_enable(drv);
 
+	/* free the trace ring, so the logger lets go of the device while the driver is down */
+	os_TraceRingSetDriverUp (drv, TI_FALSE);
+
 	if (TI_OK != drvMain_InsertAction (drv->tCommon.hDrvMain, ACTION_TYPE_STOP)) {
 		return -ENODEV;
 	}
@@ -922,6 +989,11 @@ static int wlanDrvIf_Create (void)
 		goto drv_create_end_3;
 	}
 
+	/* Register the trace logger ring device (without it the traces are sent as events) */
+	if (os_TraceRingCreate (drv)) {
+		ti_dprintf (TIWLAN_LOG_ERROR, "wlanDrvIf_Create(): Failed to create the logger ring, using events\n");
+	}
+
 	/* Create all driver modules and link their handles */
 	rc = drvMain_Create (drv,
 	                     &drv->tCommon.hDrvMain,
@@ -966,6 +1038,8 @@ drv_create_end_5:
 		drvMain_Destroy (drv->tCommon.hDrvMain);
 	}
 drv_create_end_4:
+	os_TraceRingDestroy (drv);
+
 	if (drv->wl_sock) {
 		sock_release (drv->wl_sock->sk_socket);
 	}
@@ -1034,6 +1108,8 @@ static void wlanDrvIf_Destroy (TWlanDrvIfObj *drv)
 		drvMain_Destroy (drv->tCommon.hDrvMain);
 	}
 
+	os_TraceRingDestroy (drv);
+
 	/* close the ipc_kernel socket*/
 	if (drv && drv->wl_sock) {
 		sock_release (drv->wl_sock->sk_socket);
@@ -1093,13 +1169,26 @@ static void wlanDrvIf_Destroy (TWlanDrvIfObj *drv)
  */
 static int __init wlanDrvIf_ModuleInit (void)
 {
+	int rc;
+
 	printk(KERN_INFO "TIWLAN: driver init\n");
-	return wlanDrvIf_Create ();
+
+	/* The memory caches and accounting must be ready before the first driver allocation */
+	os_memoryInit ();
+
+	rc = wlanDrvIf_Create ();
+	if (rc != 0) {
+		os_memoryDestroy ();
+	}
+	return rc;
 }
 
 static void __exit wlanDrvIf_ModuleExit (void)
 {
 	wlanDrvIf_Destroy (pDrvStaticHandle);
+
+	/* Report any memory the driver didn't release and destroy the memory caches */
+	os_memoryDestroy ();
 	printk (KERN_INFO "TI WLAN: driver unloaded\n");
 }
 
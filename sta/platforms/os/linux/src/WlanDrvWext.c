@@ -63,6 +63,7 @@ int wlanDrvWext_Handler (struct net_device *dev,
 static struct iw_statistics *wlanDrvWext_GetWirelessStats (struct net_device *dev);
 
 extern int wlanDrvIf_LoadFiles (TWlanDrvIfObj *drv, TLoaderFilesData *pInitInfo);
+extern int wlanDrvIf_CompileIniFile (TWlanDrvIfObj *drv, void *pUserBuf, unsigned long uLength);
 extern int wlanDrvIf_Start (struct net_device *dev);
 extern int wlanDrvIf_Stop (struct net_device *dev);
 
@@ -250,6 +251,128 @@ static int calcLinkSpeed(TWlanDrvIfObj *drv)
 	return newSpeed;
 }
 
+/*
+ * Execute a batch of private commands in one driver task pass.
+ * The user's entries array is copied in, each entry's in/out buffers are replaced by kernel
+ *   buffers, and the whole batch is passed to the command handler as one command.
+ * The entries are copied back with a status and updated output length per entry.
+ */
+static int wlanDrvWext_BatchCmd (TWlanDrvIfObj *drv,
+                                 struct iw_request_info *info,
+                                 void *iw_req,
+                                 void *extra,
+                                 ti_private_cmd_t *pBatchCmd)
+{
+	ti_private_cmd_batch_entry_t *pEntries;
+	void      *aUserIn[PRIVATE_CMD_BATCH_MAX];
+	void      *aUserOut[PRIVATE_CMD_BATCH_MAX];
+	TI_UINT32  aOutLen[PRIVATE_CMD_BATCH_MAX];
+	TI_UINT32  uNum = pBatchCmd->in_buffer_len / sizeof(ti_private_cmd_batch_entry_t);
+	TI_UINT32  i;
+	void      *pUserEntries = pBatchCmd->in_buffer;
+	int        rc = TI_OK;
+
+	if ((uNum == 0) || (uNum > PRIVATE_CMD_BATCH_MAX) ||
+	    (pBatchCmd->in_buffer_len != uNum * sizeof(ti_private_cmd_batch_entry_t)) ||
+	    (pBatchCmd->out_buffer != pBatchCmd->in_buffer) || (pBatchCmd->out_buffer_len != pBatchCmd->in_buffer_len)) {
+		return TI_NOK;
+	}
+	if (drv->tCommon.eDriverState != DRV_STATE_RUNNING) {
+		return TI_NOK;
+	}
+
+	pEntries = os_memoryAlloc(drv, pBatchCmd->in_buffer_len);
+	if (pEntries == NULL) {
+		return TI_NOK;
+	}
+	if (os_memoryCopyFromUser(drv, pEntries, pUserEntries, pBatchCmd->in_buffer_len)) {
+		os_printf("wlanDrvWext_BatchCmd() os_memoryCopyFromUser FAILED !!!\n");
+		os_memoryFree(drv, pEntries, pBatchCmd->in_buffer_len);
+		return TI_NOK;
+	}
+
+	/* Replace the user buffers of each entry with kernel buffers */
+	for (i = 0; i < uNum; i++) {
+		ti_private_cmd_t *pCmd = &pEntries[i].cmd;
+
+		aUserIn[i]  = pCmd->in_buffer;
+		aUserOut[i] = pCmd->out_buffer;
+		aOutLen[i]  = 0;
+		pCmd->in_buffer  = NULL;
+		pCmd->out_buffer = NULL;
+		pEntries[i].status = WEXT_OK;
+
+		if (IS_PARAM_FOR_MODULE(pCmd->cmd, DRIVER_MODULE_PARAM)) {
+			pEntries[i].status = WEXT_NOT_SUPPORTED;
+			continue;
+		}
+		if ((aUserIn[i]) && (pCmd->in_buffer_len)) {
+			pCmd->in_buffer = os_memoryAlloc(drv, pCmd->in_buffer_len);
+			if ((pCmd->in_buffer == NULL) ||
+			    os_memoryCopyFromUser(drv, pCmd->in_buffer, aUserIn[i], pCmd->in_buffer_len)) {
+				os_printf("wlanDrvWext_BatchCmd() os_memoryCopyFromUser 1 FAILED !!!\n");
+				rc = TI_NOK;
+				uNum = i + 1;
+				break;
+			}
+		}
+		if ((aUserOut[i]) && (pCmd->out_buffer_len)) {
+			aOutLen[i] = pCmd->out_buffer_len;
+			pCmd->out_buffer = os_memoryAlloc(drv, aOutLen[i]);
+			if (pCmd->out_buffer == NULL) {
+				rc = TI_NOK;
+				uNum = i + 1;
+				break;
+			}
+		}
+	}
+
+	if (rc == TI_OK) {
+		ti_private_cmd_t tKernelCmd = *pBatchCmd;
+
+		tKernelCmd.in_buffer  = pEntries;
+		tKernelCmd.out_buffer = pEntries;
+
+		/* Call the Cmd module once for all the entries */
+		rc = cmdHndlr_InsertCommand(drv->tCommon.hCmdHndlr,
+		                            info->cmd,
+		                            info->flags,
+		                            iw_req,
+		                            0,
+		                            extra,
+		                            0,
+		                            &tKernelCmd,
+		                            NULL);
+	}
+
+	/* Copy the results to the user buffers and restore the user pointers */
+	for (i = 0; i < uNum; i++) {
+		ti_private_cmd_t *pCmd = &pEntries[i].cmd;
+
+		if (pCmd->in_buffer) {
+			os_memoryFree(drv, pCmd->in_buffer, pCmd->in_buffer_len);
+		}
+		if (pCmd->out_buffer) {
+			if ((rc == TI_OK) && (pEntries[i].status == WEXT_OK) &&
+			    os_memoryCopyToUser(drv, aUserOut[i], pCmd->out_buffer, min(aOutLen[i], pCmd->out_buffer_len))) {
+				os_printf("wlanDrvWext_BatchCmd() os_memoryCopyToUser FAILED !!!\n");
+				rc = TI_NOK;
+			}
+			os_memoryFree(drv, pCmd->out_buffer, aOutLen[i]);
+		}
+		pCmd->in_buffer  = aUserIn[i];
+		pCmd->out_buffer = aUserOut[i];
+	}
+
+	if ((rc == TI_OK) && os_memoryCopyToUser(drv, pUserEntries, pEntries, pBatchCmd->in_buffer_len)) {
+		os_printf("wlanDrvWext_BatchCmd() os_memoryCopyToUser 1 FAILED !!!\n");
+		rc = TI_NOK;
+	}
+	os_memoryFree(drv, pEntries, pBatchCmd->in_buffer_len);
+
+	return rc;
+}
+
 /* Generic callback for WEXT commands */
 int wlanDrvWext_Handler (struct net_device *dev,
                          struct iw_request_info *info,
@@ -282,6 +405,9 @@ int wlanDrvWext_Handler (struct net_device *dev,
 			case DRIVER_INIT_PARAM:
 				return wlanDrvIf_LoadFiles(drv, my_command.in_buffer);
 
+			case DRIVER_INIT_TABLE_PARAM:
+				return wlanDrvIf_CompileIniFile(drv, my_command.out_buffer, my_command.out_buffer_len);
+
 			case DRIVER_START_PARAM:
 				return wlanDrvIf_Start(dev);
 
@@ -292,6 +418,9 @@ int wlanDrvWext_Handler (struct net_device *dev,
 				*(TI_UINT32 *)my_command.out_buffer =
 				    (drv->tCommon.eDriverState == DRV_STATE_RUNNING) ? TI_TRUE : TI_FALSE;
 				return TI_OK;
+
+			case DRIVER_BATCH_PARAM:
+				return wlanDrvWext_BatchCmd(drv, info, iw_req, extra, &my_command);
 			}
 		}
 		/* if we are still here handle a normal private command*/
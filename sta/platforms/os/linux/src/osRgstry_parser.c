@@ -44,6 +44,8 @@ extern void regReadLastDbgState(TWlanDrvIfObjPtr pAdapter);
 static char *init_file      = NULL;
 static int init_file_length = 0;
 static PNDIS_CONFIGURATION_PARAMETER pNdisParm;
+static char *init_file_hits = NULL;   /* Marks the ini-file keys read by the parser (check mode only) */
+static int init_file_errors = 0;
 
 int osInitTable_IniFile (TI_HANDLE hOs, TInitTable *InitTable, char *file_buf, int file_length)
 {
@@ -63,6 +65,51 @@ int osInitTable_IniFile (TI_HANDLE hOs, TInitTable *InitTable, char *file_buf, i
 	return 0;
 }
 
+/*
+ * Parse the ini-file as osInitTable_IniFile does, and report the invalid values and lines.
+ * Keys not read by the parser (misspelled, or not used in this driver configuration) are warned.
+ * Returns the number of errors found.
+ */
+int osInitTable_IniFileCheck (TI_HANDLE hOs, TInitTable *InitTable, char *file_buf, int file_length)
+{
+	char *line, *next, *key, *end_buf = file_buf + file_length;
+	int  key_len;
+
+	init_file_hits = kmalloc (file_length, GFP_KERNEL);
+	if (!init_file_hits) {
+		print_err("osInitTable_IniFileCheck: no memory for %d bytes\n", file_length);
+		return -1;
+	}
+	memset (init_file_hits, 0, file_length);
+	init_file_errors = 0;
+
+	osInitTable_IniFile (hOs, InitTable, file_buf, file_length);
+
+	for (line = file_buf; line < end_buf; line = next) {
+		next = memchr(line, '\n', end_buf - line);
+		next = next ? next + 1 : end_buf;
+
+		for (key = line; key < next && (*key == ' ' || *key == '\t'); key++) ;
+		if (key == next || *key == '#' || *key == '\r' || *key == '\n' || !*key)
+			continue;
+
+		for (key_len = 0; &key[key_len] < next && key[key_len] != '=' &&
+		        key[key_len] != ' ' && key[key_len] != '\t'; key_len++) ;
+
+		if (!memchr(key, '=', next - key)) {
+			print_err("...init_config err: delim not found (=): %.*s\n", key_len, key);
+			init_file_errors++;
+		} else if (!init_file_hits[key - file_buf]) {
+			print_err("...init_config warning: parameter <%.*s> not used\n", key_len, key);
+		}
+	}
+
+	kfree (init_file_hits);
+	init_file_hits = NULL;
+
+	return init_file_errors;
+}
+
 unsigned long TiDebugFlag;
 
 /* void PRINT( char * type, char *format, ... )*/
@@ -92,14 +139,14 @@ char *mem_str(char *buf, char *str, char *end_buf)
 {
 	int i;
 
-	for ( ; buf <= end_buf; buf++ ) {
+	for ( ; buf < end_buf; buf++ ) {
 		if ( *buf == '#' ) {
-			buf = strchr(buf+1, '\n' );
+			buf = memchr(buf+1, '\n', end_buf - (buf+1));
 			if ( !buf )
 				return NULL;
 
 		}
-		for ( i=0; &buf[i] <= end_buf && buf[i] && str[i] && (tolower(buf[i]) == tolower(str[i])); i++ ) ;
+		for ( i=0; &buf[i] < end_buf && buf[i] && str[i] && (tolower(buf[i]) == tolower(str[i])); i++ ) ;
 
 		if ((!str[i]) && (!((tolower(*(buf-1))>='a') && (tolower(*(buf-1))<='z'))))
 			return buf;
@@ -140,9 +187,11 @@ void NdisReadConfiguration( OUT PNDIS_STATUS  status, OUT PNDIS_CONFIGURATION_PA
 			break;
 
 		buf = ltrim(s + strlen(name));
-		if ( *buf == '=' )
+		if ( *buf == '=' ) {
+			if ( init_file_hits )
+				init_file_hits[s - init_file] = 1;
 			buf++;
-		else {
+		} else {
 			/*print_err("\n...init_config err: delim not found (=): ** %s **\n", buf );*/
 			buf = s + 1; /*strlen(name);*/
 			continue;
@@ -179,6 +228,7 @@ void NdisReadConfiguration( OUT PNDIS_STATUS  status, OUT PNDIS_CONFIGURATION_PA
 			if (end_p && *end_p && *end_p!=' ' && *end_p!='\n'
 			        && *end_p!='\r' && *end_p!='\t') {
 				print_err("\n...init_config: invalid int value for <%s> : %s\n", name, buf );
+				init_file_errors++;
 				return;
 			}
 			/*print_deb(" NdisReadConfiguration(): buf = %p (%.20s)\n", buf, buf );*/
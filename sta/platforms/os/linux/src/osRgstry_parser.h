@@ -56,6 +56,7 @@ void regFillInitTable ( TWlanDrvIfObjPtr pAdapter, void* pInitTable);
 
 extern void osInitTable (TInitTable *InitTable);
 extern  int osInitTable_IniFile (TI_HANDLE hOs, TInitTable *InitTable, char *file_buf, int file_length);
+extern  int osInitTable_IniFileCheck (TI_HANDLE hOs, TInitTable *InitTable, char *file_buf, int file_length);
 
 
 #endif /* _OS_RGSTRY_PARSER_ */
@@ -55,6 +55,14 @@
 #include <linux/delay.h>
 #include <linux/time.h>
 #include <linux/list.h>
+#include <linux/fs.h>
+#include <linux/mm.h>
+#include <linux/miscdevice.h>
+#include <linux/poll.h>
+#include <linux/wait.h>
+#include <linux/spinlock.h>
+#include <linux/math64.h>
+#include <linux/mutex.h>
 #include <stdarg.h>
 #include <asm/io.h>
 #include "RxBuf_linux.h"
@@ -68,6 +76,7 @@
 #include "osApi.h"
 #include "txMgmtQueue_Api.h"
 #include "EvHandler.h"
+#include "report.h"
 
 #ifdef ESTA_TIMER_DEBUG
 #define esta_timer_log(fmt,args...)  printk(fmt, ## args)
@@ -96,10 +105,362 @@ static void SendLoggerData (TI_HANDLE OsContext, TI_UINT8 *pMsg, TI_UINT16 len)
 	}
 }
 
+/*
+ * Trace logger ring (see TLoggerRingHdr in TI_IPC_Api.h).
+ * The traces are copied into a ring mapped by the logger through a misc device, and the
+ * reader is woken once per LOGGER_RING_WAKEUP_MSGS traces or LOGGER_RING_WAKEUP_USEC,
+ * instead of sending an event per trace.
+ * The ring exists only while the redirection to the logger is on and the driver is up.
+ * Freeing it clears the magic number and hangs up the poll, so the reader unmaps and
+ * closes the device and doesn't keep the module in use.
+ */
+typedef struct {
+	TLoggerRingHdr      *pHdr;          /* header page followed by the ring data, NULL if no ring */
+	TI_UINT8            *pData;
+	spinlock_t          lock;
+	wait_queue_head_t   tWaitQ;
+	struct timer_list   tWakeupTimer;
+	TI_UINT32           uPendingMsgs;   /* traces written since the last reader wakeup */
+	TI_BOOL             bTimerArmed;
+	TI_BOOL             bRegistered;    /* the device is registered */
+	TI_BOOL             bDriverUp;
+} TTraceRing;
+
+static TTraceRing tTraceRing;
+static DEFINE_MUTEX(tTraceRingMapLock);    /* serializes the ring allocation, free, mmap and poll */
+
+static void TraceRing_Update (TTraceRing *pRing);
+
 void os_setDebugOutputToLogger(TI_BOOL value)
 {
 	bRedirectOutputToLogger = value;
+	TraceRing_Update (&tTraceRing);
+}
+
+/* called with the ring lock held */
+static void TraceRing_Wakeup (TTraceRing *pRing)
+{
+	pRing->uPendingMsgs = 0;
+	pRing->pHdr->uWakeups++;
+	wake_up_interruptible (&pRing->tWaitQ);
+}
+
+static void TraceRing_WakeupTimer (unsigned long data)
+{
+	TTraceRing    *pRing = (TTraceRing *)data;
+	unsigned long  flags;
+
+	spin_lock_irqsave (&pRing->lock, flags);
+	pRing->bTimerArmed = TI_FALSE;
+	if (pRing->pHdr && pRing->uPendingMsgs) {
+		TraceRing_Wakeup (pRing);
+	}
+	spin_unlock_irqrestore (&pRing->lock, flags);
+}
+
+/* returns TI_FALSE if there is no ring (the trace should be sent as an event) */
+static TI_BOOL TraceRing_Write (TI_UINT8 *pMsg, TI_UINT32 uLen)
+{
+	TTraceRing      *pRing = &tTraceRing;
+	TLoggerRingHdr  *pHdr;
+	TLoggerRingRec  *pRec;
+	unsigned long    flags;
+	TI_UINT32        uRecLen = sizeof(TLoggerRingRec) + LOGGER_REC_ALIGN(uLen);
+	TI_UINT32        uHead, uPos, uPad;
+
+	spin_lock_irqsave (&pRing->lock, flags);
+
+	pHdr = pRing->pHdr;
+	if (!pHdr) {
+		spin_unlock_irqrestore (&pRing->lock, flags);
+		return TI_FALSE;
+	}
+
+	uHead = pHdr->uHead;
+	uPos  = uHead & (LOGGER_RING_DATA_SIZE - 1);
+
+	/* a record is never split - if it doesn't fit until the ring end, continue from the start */
+	uPad = (uPos + uRecLen > LOGGER_RING_DATA_SIZE) ? (LOGGER_RING_DATA_SIZE - uPos) : 0;
+
+	/* the reader fell behind - drop the trace */
+	if (uHead - pHdr->uTail + uPad + uRecLen > LOGGER_RING_DATA_SIZE) {
+		pHdr->uDropped++;
+		spin_unlock_irqrestore (&pRing->lock, flags);
+		return TI_TRUE;
+	}
+
+	if (uPad) {
+		pRec = (TLoggerRingRec *)(pRing->pData + uPos);
+		pRec->uLen   = 0;
+		pRec->uFlags = LOGGER_REC_WRAP;
+		uHead += uPad;
+		uPos   = 0;
+	}
+
+	pRec = (TLoggerRingRec *)(pRing->pData + uPos);
+	pRec->uLen   = (TI_UINT16)uLen;
+	pRec->uFlags = 0;
+	memcpy (pRec + 1, pMsg, uLen);
+
+	/* the record must be visible before the head that covers it */
+	smp_wmb ();
+	pHdr->uHead = uHead + uRecLen;
+	pHdr->uMsgs++;
+
+	if (++pRing->uPendingMsgs >= LOGGER_RING_WAKEUP_MSGS) {
+		TraceRing_Wakeup (pRing);
+	} else if (!pRing->bTimerArmed) {
+		pRing->bTimerArmed = TI_TRUE;
+		mod_timer (&pRing->tWakeupTimer, jiffies + usecs_to_jiffies (LOGGER_RING_WAKEUP_USEC));
+	}
+
+	spin_unlock_irqrestore (&pRing->lock, flags);
+	return TI_TRUE;
+}
+
+/* a single reader (opened for write, to move the tail) consumes the ring, others may only read the header */
+static unsigned long uTraceRingReader;
+
+static int TraceRing_Open (struct inode *inode, struct file *file)
+{
+	if ((file->f_mode & FMODE_WRITE) && test_and_set_bit (0, &uTraceRingReader)) {
+		return -EBUSY;
+	}
+	return 0;
+}
+
+static int TraceRing_Release (struct inode *inode, struct file *file)
+{
+	if (file->f_mode & FMODE_WRITE) {
+		clear_bit (0, &uTraceRingReader);
+	}
+	return 0;
+}
+
+static int TraceRing_Mmap (struct file *file, struct vm_area_struct *vma)
+{
+	int rc = -ENODEV;
+
+	mutex_lock (&tTraceRingMapLock);
+	if (tTraceRing.pHdr) {
+		rc = remap_vmalloc_range (vma, tTraceRing.pHdr, vma->vm_pgoff);
+	}
+	mutex_unlock (&tTraceRingMapLock);
+
+	return rc;
+}
+
+static unsigned int TraceRing_Poll (struct file *file, poll_table *wait)
+{
+	TLoggerRingHdr *pHdr;
+	unsigned int    mask;
+
+	poll_wait (file, &tTraceRing.tWaitQ, wait);
+
+	/* the ring may be freed by TraceRing_Update, so it is only accessed under the map lock */
+	mutex_lock (&tTraceRingMapLock);
+	pHdr = tTraceRing.pHdr;
+	if (!pHdr) {
+		mask = POLLERR | POLLHUP;
+	} else {
+		mask = (pHdr->uHead != pHdr->uTail) ? (POLLIN | POLLRDNORM) : 0;
+	}
+	mutex_unlock (&tTraceRingMapLock);
+
+	return mask;
+}
+
+static const struct file_operations tTraceRingFops = {
+	.owner   = THIS_MODULE,
+	.open    = TraceRing_Open,
+	.release = TraceRing_Release,
+	.mmap    = TraceRing_Mmap,
+	.poll    = TraceRing_Poll,
+};
+
+static struct miscdevice tTraceRingDev = {
+	.minor = MISC_DYNAMIC_MINOR,
+	.name  = "tiwlan_log",
+	.fops  = &tTraceRingFops,
+};
+
+/*
+ * Allocate the ring if the traces are redirected to the logger and the driver is up,
+ * otherwise free it. Called in process context.
+ */
+static void TraceRing_Update (TTraceRing *pRing)
+{
+	TLoggerRingHdr  *pHdr;
+	unsigned long    flags;
+	TI_BOOL          bNeeded = pRing->bRegistered && pRing->bDriverUp && bRedirectOutputToLogger;
+
+	mutex_lock (&tTraceRingMapLock);
+
+	if (bNeeded && !pRing->pHdr) {
+		pHdr = vmalloc_user (LOGGER_RING_HDR_SIZE + LOGGER_RING_DATA_SIZE);
+		if (pHdr) {
+			pHdr->uMagic    = LOGGER_RING_MAGIC;
+			pHdr->uDataSize = LOGGER_RING_DATA_SIZE;
+
+			spin_lock_irqsave (&pRing->lock, flags);
+			pRing->uPendingMsgs = 0;
+			pRing->bTimerArmed  = TI_FALSE;
+			pRing->pData = (TI_UINT8 *)pHdr + LOGGER_RING_HDR_SIZE;
+			pRing->pHdr  = pHdr;
+			spin_unlock_irqrestore (&pRing->lock, flags);
+		}
+	} else if (!bNeeded && pRing->pHdr) {
+		spin_lock_irqsave (&pRing->lock, flags);
+		pHdr = pRing->pHdr;
+		pRing->pHdr = NULL;
+		spin_unlock_irqrestore (&pRing->lock, flags);
+
+		del_timer_sync (&pRing->tWakeupTimer);
+
+		/* a reader that still maps the pages sees the cleared magic number and lets go */
+		pHdr->uMagic = 0;
+		wake_up_interruptible (&pRing->tWaitQ);
+		vfree (pHdr);
+	}
+
+	mutex_unlock (&tTraceRingMapLock);
+}
+
+/****************************************************************************************
+ *                        os_TraceRingCreate()
+ ****************************************************************************************
+DESCRIPTION:    Register the trace logger ring device (LOGGER_RING_DEVICE). The ring itself
+                is allocated when the traces are redirected to the logger and the driver is up.
+
+RETURN:         0 on success. On failure the traces are sent to the logger as events.
+****************************************************************************************/
+int os_TraceRingCreate (TI_HANDLE OsContext)
+{
+	TTraceRing      *pRing = &tTraceRing;
+	int              rc;
+
+	spin_lock_init (&pRing->lock);
+	init_waitqueue_head (&pRing->tWaitQ);
+	init_timer (&pRing->tWakeupTimer);
+	pRing->tWakeupTimer.function = TraceRing_WakeupTimer;
+	pRing->tWakeupTimer.data     = (unsigned long)pRing;
+	pRing->pHdr         = NULL;
+	pRing->uPendingMsgs = 0;
+	pRing->bTimerArmed  = TI_FALSE;
+	pRing->bDriverUp    = TI_FALSE;
+
+	rc = misc_register (&tTraceRingDev);
+	if (rc) {
+		return rc;
+	}
+
+	pRing->bRegistered = TI_TRUE;
+	TraceRing_Update (pRing);
+
+	return 0;
+}
+
+/****************************************************************************************
+ *                        os_TraceRingSetDriverUp()
+ ****************************************************************************************
+DESCRIPTION:    Tell the trace ring whether the driver is up. The ring is freed when the
+                driver goes down, so the logger drops its reference to the device and the
+                module can be unloaded. It is allocated again when the driver comes up.
+
+RETURN:         None
+****************************************************************************************/
+void os_TraceRingSetDriverUp (TI_HANDLE OsContext, TI_BOOL bDriverUp)
+{
+	tTraceRing.bDriverUp = bDriverUp;
+	TraceRing_Update (&tTraceRing);
 }
+
+/****************************************************************************************
+ *                        os_TraceRingDestroy()
+ ****************************************************************************************
+DESCRIPTION:    Free the ring and unregister the trace logger ring device.
+
+RETURN:         None
+****************************************************************************************/
+void os_TraceRingDestroy (TI_HANDLE OsContext)
+{
+	TTraceRing      *pRing = &tTraceRing;
+
+	if (!pRing->bRegistered) {
+		return;
+	}
+
+	pRing->bRegistered = TI_FALSE;
+	TraceRing_Update (pRing);
+
+	del_timer_sync (&pRing->tWakeupTimer);
+	misc_deregister (&tTraceRingDev);
+}
+
+#ifdef TI_DBG
+/****************************************************************************************
+ *                        os_TraceRingPrintStats()
+ ****************************************************************************************
+DESCRIPTION:    Print the trace logger ring state and counters.
+
+RETURN:         None
+****************************************************************************************/
+void os_TraceRingPrintStats (TI_HANDLE OsContext)
+{
+	TLoggerRingHdr *pHdr = tTraceRing.pHdr;
+
+	if (!pHdr) {
+		printk("Logger ring: not allocated (redirection %s, driver %s), traces are sent as events\n",
+		       bRedirectOutputToLogger ? "on" : "off", tTraceRing.bDriverUp ? "up" : "down");
+		return;
+	}
+
+	printk("Logger ring: %u bytes, redirection %s\n", pHdr->uDataSize, bRedirectOutputToLogger ? "on" : "off");
+	printk("  head %u, tail %u, backlog %u bytes\n", pHdr->uHead, pHdr->uTail, pHdr->uHead - pHdr->uTail);
+	printk("  traces %u, dropped %u, wakeups %u\n", pHdr->uMsgs, pHdr->uDropped, pHdr->uWakeups);
+}
+
+/****************************************************************************************
+ *                        os_TraceBenchmark()
+ ****************************************************************************************
+DESCRIPTION:    Send uTraces trace messages back to back (with logger redirection forced on)
+                and print the sustained rate and the traces dropped by the ring.
+
+RETURN:         None
+****************************************************************************************/
+void os_TraceBenchmark (TI_HANDLE OsContext, TI_UINT32 uTraces)
+{
+	TI_BOOL    bRedirect = bRedirectOutputToLogger;
+	TI_BOOL    bRing;
+	TI_UINT32  uDropped;
+	TI_UINT32  uStartUs, uElapsedUs, i;
+
+	if (uTraces == 0) {
+		uTraces = 100000;
+	}
+
+	/* the ring is allocated with the redirection */
+	os_setDebugOutputToLogger (TI_TRUE);
+	bRing    = (tTraceRing.pHdr != NULL);
+	uDropped = bRing ? tTraceRing.pHdr->uDropped : 0;
+
+	uStartUs = os_timeStampUs (OsContext);
+	for (i = 0; i < uTraces; i++) {
+		os_Trace (OsContext, REPORT_SEVERITY_INFORMATION, __FILE_ID__, __LINE__, 3, i, uStartUs, 0x1234);
+	}
+	uElapsedUs = os_timeStampUs (OsContext) - uStartUs;
+	uDropped = bRing ? tTraceRing.pHdr->uDropped - uDropped : 0;
+
+	os_setDebugOutputToLogger (bRedirect);
+
+	if (uElapsedUs == 0) {
+		uElapsedUs = 1;
+	}
+	printk("Trace benchmark: %u traces in %u us, %u traces/sec, %u dropped (%s)\n",
+	       uTraces, uElapsedUs, (TI_UINT32)div_u64 ((TI_UINT64)uTraces * 1000000, uElapsedUs),
+	       uDropped, bRing ? "ring" : "events");
+}
+#endif /* TI_DBG */
 /****************************************************************************************
  *                        os_setDebugMode()
  ****************************************************************************************
@@ -918,8 +1279,10 @@ void os_Trace (TI_HANDLE OsContext, TI_UINT32 uLevel, TI_UINT32 uFileId, TI_UINT
 
 	va_end(list);
 
-	/* Send the trace message to the logger */
-	SendLoggerData(OsContext, aMsg, (TI_UINT16)uMsgLen);
+	/* Write the trace message to the logger ring, or send it if there is no ring */
+	if (!TraceRing_Write(aMsg, uMsgLen)) {
+		SendLoggerData(OsContext, aMsg, (TI_UINT16)uMsgLen);
+	}
 }
 
 /*--------------------------------------------------------------------------------------*/
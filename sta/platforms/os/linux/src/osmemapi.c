@@ -53,6 +53,9 @@
 #include <linux/delay.h>
 #include <linux/time.h>
 #include <linux/list.h>
+#include <linux/slab.h>
+#include <linux/spinlock.h>
+#include <linux/jiffies.h>
 
 #include "osApi.h"
 #include "tidef.h"
@@ -67,11 +70,362 @@ struct os_mem_block {
 	__u32 deallocFile;
 	__u32 deallocLine;
 	__u32 size;
+	__u16 site;
+	__u8  cache;
+	__u8  accounted;
 	__u32 signature;
 };
 #define MEM_BLOCK_START  (('m'<<24) | ('e'<<16) | ('m'<<8) | 's')
 #define MEM_BLOCK_END    (('m'<<24) | ('e'<<16) | ('m'<<8) | 'e')
 
+/*
+ * Size classes of the driver slab caches. The class is chosen by the total block
+ *   size (header and end signature included), so most of the small control blocks,
+ *   timers and queues allocated at run time are served without going to kmalloc.
+ */
+static const __u32 aMemCacheSize[] = { 64, 128, 256, 512, 1024, 2048, 4096 };
+static const char *aMemCacheName[] = { "tiwlan_mem_64", "tiwlan_mem_128", "tiwlan_mem_256",
+                                       "tiwlan_mem_512", "tiwlan_mem_1024", "tiwlan_mem_2048",
+                                       "tiwlan_mem_4096"
+                                     };
+#define MEM_CACHE_NUM            (sizeof(aMemCacheSize) / sizeof(__u32))
+#define MEM_CACHE_NONE           0xFF
+
+/*
+ * Call site accounting - one entry per allocating file ID and line, kept in an
+ *   open addressing hash table. The file ID is the module tag (see FILE_ID_x).
+ */
+#define MEM_SITE_TABLE_SIZE      512  /* must be a power of 2 */
+#define MEM_SITE_NONE            0xFFFF
+#define MEM_LEAK_REPORT_MAX      64   /* max leaked blocks listed on unload */
+
+struct os_mem_site {
+	__u32 file;
+	__u32 line;         /* 0 - free entry */
+	__u32 liveBlocks;
+	__u32 liveBytes;
+	__u32 peakBytes;
+	__u32 allocs;       /* total allocations */
+	__u32 reportAllocs; /* allocations at the last statistics print */
+};
+
+static struct {
+	spinlock_t          lock;
+	TI_BOOL             bInitialized;
+	struct kmem_cache  *caches[MEM_CACHE_NUM];
+	struct list_head    blocks;       /* live blocks, for the leak report */
+	struct os_mem_site  sites[MEM_SITE_TABLE_SIZE];
+	__u32               numSites;
+	__u32               siteOverflow; /* allocations whose site did not fit in the table */
+	__u32               liveBlocks;
+	__u32               liveBytes;
+	__u32               peakBytes;
+	__u32               cacheAllocs[MEM_CACHE_NUM];
+	__u32               kmallocAllocs;
+	__u32               vmallocAllocs;
+	__u32               allocFailures;
+	unsigned long       reportJiffies;
+} tMem;
+
+
+/****************************************************************************************
+ *                        os_memFindSite()
+ ****************************************************************************************
+DESCRIPTION:    Finds (or adds) the accounting entry of an allocation call site.
+				Must be called with the accounting lock held.
+
+ARGUMENTS:		FileNbr		- the file ID of the caller.
+				LineNbr		- the line of the caller.
+
+RETURN:			The site index, MEM_SITE_NONE if the table is full.
+
+NOTES:
+*****************************************************************************************/
+static __u16 os_memFindSite (__u32 FileNbr, __u32 LineNbr)
+{
+	__u32 index = ((FileNbr * 2654435761U) ^ (LineNbr * 40503U)) & (MEM_SITE_TABLE_SIZE - 1);
+	__u32 probe;
+
+	for (probe = 0; probe < MEM_SITE_TABLE_SIZE; probe++) {
+		struct os_mem_site *site = &tMem.sites[index];
+
+		if ((site->line == LineNbr) && (site->file == FileNbr))
+			return (__u16)index;
+
+		if (site->line == 0) {
+			/* Keep the table at most 3/4 full so the probe sequences stay short */
+			if (tMem.numSites >= (MEM_SITE_TABLE_SIZE * 3) / 4)
+				return MEM_SITE_NONE;
+			site->file = FileNbr;
+			site->line = LineNbr;
+			tMem.numSites++;
+			return (__u16)index;
+		}
+
+		index = (index + 1) & (MEM_SITE_TABLE_SIZE - 1);
+	}
+
+	return MEM_SITE_NONE;
+}
+
+
+/****************************************************************************************
+ *                        os_memAccountAlloc()
+ ****************************************************************************************
+DESCRIPTION:    Charges a new block to its call site and links it to the live blocks list.
+
+ARGUMENTS:		blk			- the new memory block (size and allocation site already set).
+
+RETURN:			None
+
+NOTES:
+*****************************************************************************************/
+static void os_memAccountAlloc (struct os_mem_block *blk)
+{
+	unsigned long flags;
+
+	blk->accounted = 0;
+	blk->site = MEM_SITE_NONE;
+	if (!tMem.bInitialized)
+		return;
+
+	spin_lock_irqsave(&tMem.lock, flags);
+
+	/* os_memoryDestroy may have run meanwhile */
+	if (!tMem.bInitialized) {
+		spin_unlock_irqrestore(&tMem.lock, flags);
+		return;
+	}
+
+	blk->site = (blk->allocLine != 0) ? os_memFindSite(blk->allocFile, blk->allocLine) : MEM_SITE_NONE;
+	if (blk->site != MEM_SITE_NONE) {
+		struct os_mem_site *site = &tMem.sites[blk->site];
+
+		site->liveBlocks++;
+		site->liveBytes += blk->size;
+		site->allocs++;
+		if (site->liveBytes > site->peakBytes)
+			site->peakBytes = site->liveBytes;
+	} else {
+		tMem.siteOverflow++;
+	}
+
+	tMem.liveBlocks++;
+	tMem.liveBytes += blk->size;
+	if (tMem.liveBytes > tMem.peakBytes)
+		tMem.peakBytes = tMem.liveBytes;
+
+	list_add(&blk->blk_list, &tMem.blocks);
+	blk->accounted = 1;
+
+	spin_unlock_irqrestore(&tMem.lock, flags);
+}
+
+
+/****************************************************************************************
+ *                        os_memAccountFree()
+ ****************************************************************************************
+DESCRIPTION:    Removes a block from its call site accounting and from the live blocks list.
+
+ARGUMENTS:		blk			- the memory block being released.
+
+RETURN:			None
+
+NOTES:
+*****************************************************************************************/
+static void os_memAccountFree (struct os_mem_block *blk)
+{
+	unsigned long flags;
+
+	if (!tMem.bInitialized || !blk->accounted)
+		return;
+
+	spin_lock_irqsave(&tMem.lock, flags);
+
+	/* os_memoryDestroy may have run meanwhile and already released the list */
+	if (!tMem.bInitialized) {
+		spin_unlock_irqrestore(&tMem.lock, flags);
+		return;
+	}
+
+	if (blk->site != MEM_SITE_NONE) {
+		struct os_mem_site *site = &tMem.sites[blk->site];
+
+		site->liveBlocks--;
+		site->liveBytes -= blk->size;
+	}
+	tMem.liveBlocks--;
+	tMem.liveBytes -= blk->size;
+
+	list_del(&blk->blk_list);
+
+	spin_unlock_irqrestore(&tMem.lock, flags);
+}
+
+
+/****************************************************************************************
+ *                        os_memoryInit()
+ ****************************************************************************************
+DESCRIPTION:    Creates the driver slab caches and resets the memory accounting.
+				Called once on module load, before any driver allocation.
+
+ARGUMENTS:		None
+
+RETURN:			None
+
+NOTES:         	If a cache can't be created its size class falls back to kmalloc.
+*****************************************************************************************/
+void os_memoryInit (void)
+{
+	__u32 i;
+
+	memset(&tMem, 0, sizeof(tMem));
+	spin_lock_init(&tMem.lock);
+	INIT_LIST_HEAD(&tMem.blocks);
+
+	for (i = 0; i < MEM_CACHE_NUM; i++) {
+		tMem.caches[i] = kmem_cache_create(aMemCacheName[i], aMemCacheSize[i], 0, SLAB_HWCACHE_ALIGN, NULL);
+		if (!tMem.caches[i]) {
+			printk(KERN_WARNING "%s: failed to create %s, using kmalloc\n", __func__, aMemCacheName[i]);
+		}
+	}
+
+	tMem.reportJiffies = jiffies;
+	tMem.bInitialized = TI_TRUE;
+}
+
+
+/****************************************************************************************
+ *                        os_memoryDestroy()
+ ****************************************************************************************
+DESCRIPTION:    Prints the leak report and destroys the driver slab caches.
+				Called once on module unload, after all the driver objects were released.
+
+ARGUMENTS:		None
+
+RETURN:			None
+
+NOTES:         	The leaked blocks of the slab caches are released, so every cache is
+				destroyed and can be created again on the next load. Leaked kmalloc and
+				vmalloc blocks are left allocated. The report is done under the allocator lock.
+*****************************************************************************************/
+void os_memoryDestroy (void)
+{
+	struct os_mem_block *blk, *next;
+	unsigned long flags;
+	__u32 uListed = 0;
+	__u32 i;
+
+	spin_lock_irqsave(&tMem.lock, flags);
+
+	if (!tMem.bInitialized) {
+		spin_unlock_irqrestore(&tMem.lock, flags);
+		return;
+	}
+	tMem.bInitialized = TI_FALSE;
+
+	if (tMem.liveBlocks != 0) {
+		printk(KERN_ERR "%s: memory leak - %u blocks, %u bytes still allocated\n",
+		       __func__, tMem.liveBlocks, tMem.liveBytes);
+
+		list_for_each_entry(blk, &tMem.blocks, blk_list) {
+			if (uListed < MEM_LEAK_REPORT_MAX) {
+				printk(KERN_ERR "  leaked block %p: size %u, allocated at file %u line %u\n",
+				       (char *)blk + sizeof(struct os_mem_block), blk->size, blk->allocFile, blk->allocLine);
+				uListed++;
+			}
+		}
+		if (uListed < tMem.liveBlocks)
+			printk(KERN_ERR "  ... %u more leaked blocks\n", tMem.liveBlocks - uListed);
+
+		printk(KERN_ERR "  leaking call sites:\n");
+		for (i = 0; i < MEM_SITE_TABLE_SIZE; i++) {
+			if ((tMem.sites[i].line != 0) && (tMem.sites[i].liveBlocks != 0)) {
+				printk(KERN_ERR "  file %3u line %5u: %u blocks, %u bytes\n", tMem.sites[i].file,
+				       tMem.sites[i].line, tMem.sites[i].liveBlocks, tMem.sites[i].liveBytes);
+			}
+		}
+	}
+
+	/* Release the leaked cache blocks, the driver that could use them is being unloaded */
+	list_for_each_entry_safe(blk, next, &tMem.blocks, blk_list) {
+		list_del(&blk->blk_list);
+		if (blk->cache != MEM_CACHE_NONE)
+			kmem_cache_free(tMem.caches[blk->cache], blk);
+	}
+	tMem.liveBlocks = 0;
+	tMem.liveBytes = 0;
+
+	spin_unlock_irqrestore(&tMem.lock, flags);
+
+	for (i = 0; i < MEM_CACHE_NUM; i++) {
+		if (tMem.caches[i])
+			kmem_cache_destroy(tMem.caches[i]);
+		tMem.caches[i] = NULL;
+	}
+}
+
+
+/****************************************************************************************
+ *                        os_memoryPrintStats()
+ ****************************************************************************************
+DESCRIPTION:    Prints the memory accounting - the allocator totals and, for each call site,
+				its live blocks and bytes, peak bytes and allocation rate since the last print.
+
+ARGUMENTS:		OsContext	- our adapter context.
+
+RETURN:			None
+
+NOTES:         	The file ID of a site is the module tag (FILE_ID_x).
+*****************************************************************************************/
+void os_memoryPrintStats (TI_HANDLE OsContext)
+{
+	struct os_mem_site tSite;
+	unsigned long flags;
+	unsigned long now = jiffies;
+	__u32 uElapsedMs;
+	__u32 uNewAllocs;
+	__u32 i;
+
+	if (!tMem.bInitialized) {
+		printk("Memory accounting is not initialized\n");
+		return;
+	}
+
+	uElapsedMs = jiffies_to_msecs(now - tMem.reportJiffies);
+	tMem.reportJiffies = now;
+
+	printk("------------------------  Driver Memory  ------------------------\n");
+	printk("Live blocks = %u, live bytes = %u, peak bytes = %u\n",
+	       tMem.liveBlocks, tMem.liveBytes, tMem.peakBytes);
+	printk("kmalloc allocations = %u, vmalloc allocations = %u, failures = %u\n",
+	       tMem.kmallocAllocs, tMem.vmallocAllocs, tMem.allocFailures);
+	for (i = 0; i < MEM_CACHE_NUM; i++) {
+		printk("%-16s allocations = %u%s\n", aMemCacheName[i], tMem.cacheAllocs[i],
+		       tMem.caches[i] ? "" : " (not created)");
+	}
+	printk("Call sites = %u, untracked allocations = %u, interval = %u ms\n",
+	       tMem.numSites, tMem.siteOverflow, uElapsedMs);
+	printk("File Line   LiveBlks  LiveBytes  PeakBytes     Allocs  NewAllocs  Allocs/s\n");
+
+	for (i = 0; i < MEM_SITE_TABLE_SIZE; i++) {
+		/* Snapshot one site at a time, so the lock isn't held while printing */
+		spin_lock_irqsave(&tMem.lock, flags);
+		tSite = tMem.sites[i];
+		tMem.sites[i].reportAllocs = tSite.allocs;
+		spin_unlock_irqrestore(&tMem.lock, flags);
+
+		if (tSite.line == 0)
+			continue;
+
+		uNewAllocs = tSite.allocs - tSite.reportAllocs;
+		printk("%4u %5u %9u %10u %10u %10u %10u %9u\n", tSite.file, tSite.line,
+		       tSite.liveBlocks, tSite.liveBytes, tSite.peakBytes, tSite.allocs, uNewAllocs,
+		       (uElapsedMs != 0) ? (__u32)(((unsigned long long)uNewAllocs * 1000) / uElapsedMs) : 0);
+	}
+	printk("-----------------------------------------------------------------\n");
+}
+
 /****************************************************************************************
  *                        																*
  *						OS Memory API													*
@@ -107,7 +461,30 @@ _os_memoryAlloc(
 	struct os_mem_block *blk;
 	__u32 total_size = Size + sizeof(struct os_mem_block) + sizeof(__u32);
 	gfp_t flags = (in_atomic()) ? GFP_ATOMIC : GFP_KERNEL;
+	__u8 cache = MEM_CACHE_NONE;
+	__u32 i;
+
+	/* Hot sizes are served from the size class caches */
+	if (tMem.bInitialized) {
+		for (i = 0; i < MEM_CACHE_NUM; i++) {
+			if (total_size <= aMemCacheSize[i]) {
+				if (tMem.caches[i])
+					cache = (__u8)i;
+				break;
+			}
+		}
+	}
 
+	if (cache != MEM_CACHE_NONE) {
+		blk = kmem_cache_alloc(tMem.caches[cache], flags);
+		if (!blk) {
+			printk(KERN_ERR "%s: NULL from %s\n",__func__, aMemCacheName[cache]);
+			tMem.allocFailures++;
+			return NULL;
+		}
+		blk->f_free = NULL;
+		tMem.cacheAllocs[cache]++;
+	}
 	/*
 	Memory optimization issue. Allocate up to 2 pages (8k) from the SLAB
 	    allocator (2^n), otherwise allocate from virtual pool.
@@ -115,17 +492,19 @@ _os_memoryAlloc(
 	  memory, so the TxCtrlBlk table can be transacted over DMA.
 	*/
 #ifdef FULL_ASYNC_MODE
-	if (total_size < 6 * 4096)
+	else if (total_size < 6 * 4096)
 #else
-	if (total_size < 2 * 4096)
+	else if (total_size < 2 * 4096)
 #endif
 	{
 		blk = kmalloc(total_size, flags);
 		if (!blk) {
 			printk(KERN_ERR "%s: NULL from kmalloc\n",__func__);
+			tMem.allocFailures++;
 			return NULL;
 		}
 		blk->f_free = (os_free)kfree;
+		tMem.kmallocAllocs++;
 	} else {
 		/* We expect that the big allocations should be made outside
 		     the interrupt, otherwise fail
@@ -137,18 +516,23 @@ _os_memoryAlloc(
 		blk = vmalloc(total_size);
 		if (!blk) {
 			printk(KERN_ERR "%s: NULL from vmalloc\n",__func__);
+			tMem.allocFailures++;
 			return NULL;
 		}
 		blk->f_free = (os_free)vfree;
+		tMem.vmallocAllocs++;
 	}
 
 	os_profile (OsContext, 4, total_size);
 
-	/*list_add(&blk->blk_list, &drv->mem_blocks);*/
 	blk->size = Size;
+	blk->cache = cache;
 	blk->signature = MEM_BLOCK_START;
 	blk->allocFile = FileNbr;
 	blk->allocLine = LineNbr;
+	blk->deallocFile = 0;
+	blk->deallocLine = 0;
+	os_memAccountAlloc(blk);
 	*(__u32 *)((unsigned char *)blk + total_size - sizeof(__u32)) = MEM_BLOCK_END;
 	return (void *)((char *)blk + sizeof(struct os_mem_block));
 }
@@ -243,7 +627,12 @@ _os_memoryFree(
 		       __FUNCTION__, blk->size, blk->allocFile, blk->allocLine, blk->deallocFile, blk->deallocLine);
 	}
 
-	blk->f_free(blk);
+	os_memAccountFree(blk);
+
+	if (blk->cache != MEM_CACHE_NONE)
+		kmem_cache_free(tMem.caches[blk->cache], blk);
+	else
+		blk->f_free(blk);
 }
 
 
@@ -317,6 +706,9 @@ os_memoryAlloc4HwDma(
 		return NULL;
 	}
 	blk->size = Size;
+	blk->cache = MEM_CACHE_NONE;
+	blk->site = MEM_SITE_NONE;
+	blk->accounted = 0;
 	blk->signature = MEM_BLOCK_START;
 	*(__u32 *)((unsigned char *)blk + total_size - sizeof(__u32)) = MEM_BLOCK_END;
 
@@ -169,6 +169,7 @@ typedef enum {
 	REGULATORY_DOMAIN_GET_SCAN_CAPABILITIES             =           GET_BIT | REGULATORY_DOMAIN_MODULE_PARAM | 0x1C,
 	REGULATORY_DOMAIN_IS_COUNTRY_FOUND                  =           GET_BIT | REGULATORY_DOMAIN_MODULE_PARAM | 0x1D,
 	REGULATORY_DOMAIN_TIME_TO_COUNTRY_EXPIRY            =           GET_BIT | REGULATORY_DOMAIN_MODULE_PARAM | 0x1E,
+	REGULATORY_DOMAIN_SERVING_CHANNEL_CHANGED_PARAM     = SET_BIT |           REGULATORY_DOMAIN_MODULE_PARAM | 0x1F,
 	/* measurement section */
 
 #ifdef XCC_MODULE_INCLUDED
@@ -273,6 +273,34 @@ typedef struct {
 	TI_UINT8       pattern[RX_DATA_FILTER_MAX_PATTERN_SIZE];/**< Data Filter PAttern												*/
 } TRxDataFilterRequest;
 
+#define RX_DATA_FILTER_MAX_RULES                32
+
+#define RX_DATA_FILTER_RULE_MATCH_PATTERN       0x01
+#define RX_DATA_FILTER_RULE_MATCH_ETHERTYPE     0x02
+#define RX_DATA_FILTER_RULE_MATCH_IP_PROTO      0x04
+#define RX_DATA_FILTER_RULE_MATCH_SRC_PORT      0x08
+#define RX_DATA_FILTER_RULE_MATCH_DST_PORT      0x10
+
+/** \struct TRxDataFilterRule
+ * \brief RX Data Filter Rule
+ *
+ * \par Description
+ * A host RX data filter rule. All the fields selected in uMatch must match.
+ * Rules are checked in the order they were added and the first matching rule decides.
+ * An IP protocol or port match implies an IPv4 ethertype, and a port match needs a TCP or UDP protocol.
+ *
+ * \sa
+ */
+typedef struct {
+	TI_UINT8       uMatch;                                  /**< RX_DATA_FILTER_RULE_MATCH_xxx bits									*/
+	TI_UINT8       uAction;                                 /**< FILTER_SIGNAL to pass the frame or FILTER_DROP to drop it				*/
+	TI_UINT16      uEtherType;                              /**< Ethertype (host order)												*/
+	TI_UINT8       uIpProto;                                /**< IPv4 protocol														*/
+	TI_UINT16      uSrcPort;                                /**< TCP/UDP source port (host order)									*/
+	TI_UINT16      uDstPort;                                /**< TCP/UDP destination port (host order)								*/
+	TRxDataFilterRequest tPattern;                          /**< Offset/mask/pattern match, offsets are relative to the 802.3 header	*/
+} TRxDataFilterRule;
+
 /** \struct TIWLN_COUNTERS
  * \brief TI WLAN Counters
  *
@@ -305,6 +333,131 @@ typedef struct {
 
 } TIWLN_COUNTERS;
 
+/* Statistics snapshot blob (SITE_MGR_STATS_SNAPSHOT_PARAM) */
+#define STATS_SNAPSHOT_MAGIC			0x54495353	/* "TISS" */
+#define STATS_SNAPSHOT_VERSION			1
+#define STATS_SNAPSHOT_MAX_LEN			512
+
+/** \enum EStatsSnapshotSection
+ * \brief Statistics Snapshot Section ID
+ *
+ * \par Description
+ * Identifies the counters group of a snapshot section.
+ * New sections get new IDs, so readers skip sections they don't know
+ *
+ * \sa	TStatsSnapshotSection
+ */
+typedef enum
+{
+	STATS_SECTION_WLAN				= 1,	/**< The TIWLN_COUNTERS fields, in the structure order	*/
+	STATS_SECTION_TX				= 2,	/**< Tx data counters summed over all ACs (EStatsTxCounter)	*/
+	STATS_SECTION_XFER				= 3,	/**< Bus transfer and FW interrupt counters (EStatsXferCounter)	*/
+	STATS_SECTION_POWER				= 4		/**< Power save state and counters (EStatsPowerCounter)	*/
+
+} EStatsSnapshotSection;
+
+/** \enum EStatsTxCounter
+ * \brief Tx Section Counters
+ *
+ * \par Description
+ * The counters order in the STATS_SECTION_TX section. New counters are only appended
+ *
+ * \sa
+ */
+typedef enum
+{
+	STATS_TX_XMIT_OK = 0,
+	STATS_TX_DIRECTED_BYTES,
+	STATS_TX_DIRECTED_FRAMES,
+	STATS_TX_MULTICAST_BYTES,
+	STATS_TX_MULTICAST_FRAMES,
+	STATS_TX_BROADCAST_BYTES,
+	STATS_TX_BROADCAST_FRAMES,
+	STATS_TX_RETRY_FAIL,
+	STATS_TX_TIMEOUT,
+	STATS_TX_NO_LINK,
+	STATS_TX_OTHER_FAIL,
+	STATS_TX_NUM_PACKETS,
+	STATS_TX_SUM_FW_DELAY_US,
+	STATS_TX_SUM_MAC_DELAY_US,
+	STATS_TX_NUM_COUNTERS
+
+} EStatsTxCounter;
+
+/** \enum EStatsXferCounter
+ * \brief Transfer Section Counters
+ *
+ * \par Description
+ * The counters order in the STATS_SECTION_XFER section. New counters are only appended
+ *
+ * \sa
+ */
+typedef enum
+{
+	STATS_XFER_FW_INTERRUPTS = 0,
+	STATS_XFER_RX_PACKETS,
+	STATS_XFER_RX_XFERS,
+	STATS_XFER_TX_PACKETS,
+	STATS_XFER_TX_XFERS,
+	STATS_XFER_NUM_COUNTERS
+
+} EStatsXferCounter;
+
+/** \enum EStatsPowerCounter
+ * \brief Power Section Counters
+ *
+ * \par Description
+ * The counters order in the STATS_SECTION_POWER section. New counters are only appended
+ *
+ * \sa
+ */
+typedef enum
+{
+	STATS_POWER_MODE = 0,					/**< Desired power mode (PowerMgr_PowerMode_e)	*/
+	STATS_POWER_PS_STATUS,					/**< 1 if the FW is in 802.11 power save	*/
+	STATS_POWER_ENTER_PS_OK,
+	STATS_POWER_ENTER_PS_FAIL,
+	STATS_POWER_EXIT_PS_OK,
+	STATS_POWER_EXIT_PS_FAIL,
+	STATS_POWER_NUM_COUNTERS
+
+} EStatsPowerCounter;
+
+/** \struct TStatsSnapshotHdr
+ * \brief Statistics Snapshot Header
+ *
+ * \par Description
+ * Starts the statistics snapshot blob. It is followed by uNumSections sections, each
+ * a TStatsSnapshotSection followed by its uNumCounters 32 bit counters.
+ * All the counters are collected in one driver context pass, so they are consistent with each other
+ *
+ * \sa	TStatsSnapshotSection
+ */
+typedef struct
+{
+	TI_UINT32  uMagic;				/**< STATS_SNAPSHOT_MAGIC			*/
+	TI_UINT16  uVersion;			/**< STATS_SNAPSHOT_VERSION			*/
+	TI_UINT16  uLength;				/**< Total blob length in bytes, including this header	*/
+	TI_UINT32  uTimestampMs;		/**< Driver time of the snapshot (ms)	*/
+	TI_UINT32  uNumSections;		/**< Number of sections following the header	*/
+
+} TStatsSnapshotHdr;
+
+/** \struct TStatsSnapshotSection
+ * \brief Statistics Snapshot Section Header
+ *
+ * \par Description
+ * Readers must use uNumCounters to skip to the next section, since sections may grow
+ *
+ * \sa	EStatsSnapshotSection
+ */
+typedef struct
+{
+	TI_UINT16  uId;					/**< Section ID (EStatsSnapshotSection)	*/
+	TI_UINT16  uNumCounters;		/**< Number of 32 bit counters following	*/
+
+} TStatsSnapshotSection;
+
 /** \struct TPowerMgr_PowerMode
  * \brief Power Mode Parameters
  *
@@ -107,13 +107,15 @@ extern "C" {
 		IPC_EVENT_RE_AUTH_TERMINATED,
 		IPC_EVENT_TIMEOUT,
 		IPC_EVENT_GWSI,
+		IPC_EVENT_SCAN_RESULT_RECORD,
 		IPC_EVENT_MAX
 	};
 
 	enum
 	{
 		DELIVERY_PUSH =0,
-		DELIVERY_GET_DATA
+		DELIVERY_GET_DATA,
+		DELIVERY_PUSH_COALESCED     /* push, the listener accepts batched and merged events (see IPC_EV_DATA) */
 	};
 
 	enum
@@ -123,6 +125,71 @@ extern "C" {
 		SCAN_STATUS_FAILED = 2
 	};
 
+	/* IPC_EVENT_SCAN_RESULT_RECORD flags */
+#define SCAN_RESULT_RECORD_NEW          0x01    /* first frame of this BSS in the result table */
+#define SCAN_RESULT_RECORD_UPDATED      0x02    /* a BSS already in the result table was refreshed */
+#define SCAN_RESULT_RECORD_END          0x04    /* scan is over, no BSS data - the table is now stable */
+
+#define SCAN_RESULT_RECORD_SSID_LEN     32
+
+	/*
+	 * Incremental scan result record, sent with IPC_EVENT_SCAN_RESULT_RECORD for every result table
+	 * update when ScanResultStreaming is enabled. uSequence is incremented for every record (including
+	 * the end record), so a gap means records were lost and the client should re-read the whole table
+	 * once the end record of the current stream (uStreamId) arrives.
+	 */
+	typedef struct {
+		TI_UINT32   uSequence;          /* record sequence number */
+		TI_UINT16   uStreamId;          /* incremented after every scan end record */
+		TI_UINT8    uFlags;             /* SCAN_RESULT_RECORD_xxx */
+		TI_UINT8    uBand;              /* ERadioBand */
+		TMacAddr    tBssid;
+		TI_UINT8    uChannel;
+		TI_INT8     iRssi;
+		TI_UINT16   uBeaconInterval;
+		TI_UINT16   uCapabilities;
+		TI_INT8     iSnr;
+		TI_UINT8    uBssType;           /* ScanBssType_e */
+		TI_UINT8    uSsidLen;
+		TI_UINT8    uReserved;
+		TI_UINT8    aSsid[ SCAN_RESULT_RECORD_SSID_LEN ];
+		TI_UINT32   uSupportedRatesMask;
+	} TScanResultRecord;
+
+	/*
+	 * Trace logger ring, mapped read/write by the logger from LOGGER_RING_DEVICE.
+	 * The first page holds TLoggerRingHdr and the trace records follow it. uHead is advanced by the
+	 * driver and uTail by the reader; both are free running byte offsets (the position in the ring is
+	 * offset & (uDataSize - 1)). Each record is a TLoggerRingRec followed by uLen bytes of TTraceMsg,
+	 * padded to 4 bytes. A record never wraps - a LOGGER_REC_WRAP record tells the reader to continue
+	 * from the ring start. When the reader falls behind, new traces are dropped and counted.
+	 * The reader is woken (poll) after LOGGER_RING_WAKEUP_MSGS records or LOGGER_RING_WAKEUP_USEC.
+	 */
+#define LOGGER_RING_DEVICE              "/dev/tiwlan_log"
+#define LOGGER_RING_MAGIC               0x544C4F47  /* "TLOG" */
+#define LOGGER_RING_HDR_SIZE            4096
+#define LOGGER_RING_DATA_SIZE           (64 * 1024) /* must be a power of 2 */
+#define LOGGER_RING_WAKEUP_MSGS         64
+#define LOGGER_RING_WAKEUP_USEC         20000
+
+#define LOGGER_REC_WRAP                 0x0001      /* no data, continue from the ring start */
+#define LOGGER_REC_ALIGN(len)           (((len) + 3) & ~3)
+
+	typedef struct {
+		TI_UINT32   uMagic;             /* LOGGER_RING_MAGIC */
+		TI_UINT32   uDataSize;          /* ring data size in bytes */
+		volatile TI_UINT32 uHead;       /* written by the driver */
+		volatile TI_UINT32 uTail;       /* written by the reader */
+		TI_UINT32   uMsgs;              /* traces written since the ring was created */
+		TI_UINT32   uDropped;           /* traces dropped since the ring was full */
+		TI_UINT32   uWakeups;           /* reader wakeups */
+	} TLoggerRingHdr;
+
+	typedef struct {
+		TI_UINT16   uLen;               /* trace message length, not including this header */
+		TI_UINT16   uFlags;             /* LOGGER_REC_xxx */
+	} TLoggerRingRec;
+
 	/************************* IOCTLs Functions *******************************/
 
 	TI_HANDLE   IPC_Init(void);
@@ -163,6 +230,8 @@ extern "C" {
 		IPC_EVENT_PARAMS    EvParams;
 		TI_UINT32            uBufferSize;
 		TI_UINT8             uBuffer[MAX_EVENT_DATA_SIZE];
+		TI_UINT32            uSequence;  /* per listener delivery sequence number of push events */
+		TI_UINT32            uCoalesced; /* number of newer/repeated events merged into this one (DELIVERY_PUSH_COALESCED) */
 	} IPC_EV_DATA;
 
 
@@ -47,6 +47,8 @@
  ***********************************************************************
  */
 #define MAX_NUM_OF_NEIGHBOR_APS     30
+
+/* Number of BSSes in the exported BSS list - part of the user-space interface, do not change */
 #define MAX_SIZE_OF_BSS_TRACK_LIST  16
 
 
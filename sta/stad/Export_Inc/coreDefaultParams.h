@@ -918,6 +918,16 @@ IP&Port classification table  */
 #define SCAN_CNCN_APP_PUSH_MODE_MIN             TI_FALSE
 #define SCAN_CNCN_APP_PUSH_MODE_MAX             TI_TRUE
 
+#define SCAN_CNCN_APP_RESULT_STREAMING_DEF      TI_FALSE
+#define SCAN_CNCN_APP_RESULT_STREAMING_MIN      TI_FALSE
+#define SCAN_CNCN_APP_RESULT_STREAMING_MAX      TI_TRUE
+
+/* Event handler - push events batching interval in msec for the listeners registered with DELIVERY_PUSH_COALESCED,
+   0 delivers every event immediately */
+#define EV_HANDLER_BATCH_INTERVAL_DEF           0
+#define EV_HANDLER_BATCH_INTERVAL_MIN           0
+#define EV_HANDLER_BATCH_INTERVAL_MAX           1000
+
 #define SCAN_CNCN_APP_SRA_DEF                   20
 #define SCAN_CNCN_APP_SRA_MIN                   0
 #define SCAN_CNCN_APP_SRA_MAX                   1000
@@ -931,6 +941,15 @@ IP&Port classification table  */
 #define NULL_KL_PERIOD_MIN      0
 #define NULL_KL_PERIOD_MAX      3600
 
+/* Power manager init paramaters - adaptive null-data keep-alive */
+#define KEEP_ALIVE_ADAPTIVE_DEF     TI_FALSE
+#define KEEP_ALIVE_ADAPTIVE_MIN     TI_FALSE
+#define KEEP_ALIVE_ADAPTIVE_MAX     TI_TRUE
+
+#define KEEP_ALIVE_MAX_PERIOD_DEF   60
+#define KEEP_ALIVE_MAX_PERIOD_MIN   1
+#define KEEP_ALIVE_MAX_PERIOD_MAX   3600
+
 /* Context-Engine init paramaters */
 #define CONTEXT_SWITCH_REQUIRED_DEF     TI_TRUE
 #define CONTEXT_SWITCH_REQUIRED_MIN     TI_FALSE
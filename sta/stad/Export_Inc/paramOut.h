@@ -523,6 +523,7 @@ typedef struct {
 		signal_t                			siteMgrCurrentSignal;
 		TI_UINT8                			siteMgrNumberOfSites;
 		TIWLN_COUNTERS          			siteMgrTiWlanCounters;
+		TI_UINT8                			*pSiteMgrStatsSnapshot;
 		TI_BOOL                 			siteMgrBuiltInTestStatus;
 		TI_UINT8                			siteMgrFwVersion[FW_VERSION_LEN]; /* Firmware version - null terminated string*/
 		TI_UINT32               			siteMgrDisAssocReason;
@@ -602,6 +603,7 @@ typedef struct {
 		rxDataCounters_t        			rxDataCounters;
 		TI_BOOL                    			rxDataFilterEnableDisable;
 		TRxDataFilterRequest    			rxDataFilterRequest;
+		TRxDataFilterRule       			rxDataFilterRule;
 		TI_UINT16                           rxGenericEthertype;
 
 		/* Tx Data section */
@@ -710,6 +712,7 @@ typedef struct {
 		TPeriodicScanParams         		*pPeriodicScanParams;
 		TI_UINT32                   		uBssidListSize;
 		TI_UINT32                   		uNumBssidInList;
+		TI_UINT32                   		uBssidListGeneration;
 		OS_802_11_BSSID_LIST_EX     		*pBssidList;
 		OS_802_11_N_RATES					*pRateList;
 		TSsid                   			tScanDesiredSSID;
@@ -1047,6 +1050,10 @@ typedef struct {
 	TI_UINT32						PsPollDeliveryFailureRecoveryPeriod;
 
 	TI_BOOL							reAuthActivePriority;
+
+	/* adaptive null-data keep-alive */
+	TI_BOOL							bKeepAliveAdaptive;
+	TI_UINT32						uKeepAliveMaxPeriod;	/* in seconds */
 } PowerMgrInitParams_t;
 
 typedef struct {
@@ -1062,11 +1069,16 @@ typedef struct {
 	TI_UINT32       uMinimumDurationBetweenOsScans;
 	TI_UINT32       uDfsPassiveDwellTimeMs;
 	TI_BOOL	        bPushMode; /*  True means Push mode. False is the default mode, storing scan results in table. */
+	TI_BOOL         bResultStreaming; /* True means every app result table update is also sent as a record event */
 	TI_UINT32       uSraThreshold;
 	TI_INT32        nRssiThreshold;
 
 } TScanCncnInitParams;
 
+typedef struct {
+	TI_UINT32       uBatchIntervalMs;   /* DELIVERY_PUSH_COALESCED events batching interval, 0 disables events coalescing */
+} TEvHandlerInitParams;
+
 typedef struct {
 	TI_UINT8       uNullDataKeepAlivePeriod;
 	TI_UINT8	   RoamingOperationalMode;
@@ -1121,6 +1133,7 @@ typedef struct {
 	TMlmeInitParams                 tMlmeInitParams;
 	TDrvMainParams                  tDrvMainParams;
 	TRoamScanMngrInitParams         tRoamScanMngrInitParams;
+	TEvHandlerInitParams            tEvHandlerInitParams;
 } TInitTable;
 
 
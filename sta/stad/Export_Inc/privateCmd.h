@@ -64,6 +64,10 @@
  * \brief Bitmaks of bit which indicates that the Command is GET Command
  */
 #define PRIVATE_CMD_GET_FLAG	0x00000002
+/** \def PRIVATE_CMD_BATCH_MAX
+ * \brief Maximal number of Commands carried by one DRIVER_BATCH_PARAM Private Command
+ */
+#define PRIVATE_CMD_BATCH_MAX	32
 
 
 /*********/
@@ -87,6 +91,21 @@ typedef struct {
 	TI_UINT32	out_buffer_len;	/**< Output buffer length 												*/
 } ti_private_cmd_t;
 
+/** \struct ti_private_cmd_batch_entry_t
+ * \brief TI Private Command Batch Entry
+ *
+ * \par Description
+ * One Command of a DRIVER_BATCH_PARAM Private Command. The batch input and output buffers both point
+ * to an array of these entries, which are executed in order in one driver task pass.
+ * The driver returns each entry's status and updated output length in place.
+ *
+ * \sa	ti_private_cmd_t
+ */
+typedef struct {
+	ti_private_cmd_t	cmd;		/**< The Private Command to execute (may not be an Async or Driver Module Command)	*/
+	TI_INT32			status;		/**< Command's WEXT return code (0 on success), set by the driver					*/
+} ti_private_cmd_batch_entry_t;
+
 
 /*************/
 /* functions */
@@ -87,9 +87,15 @@ static TI_STATUS setSupportedChannelsAccording2CountryIe(regulatoryDomain_t *pRe
 
 static void setSupportedChannelsAccording2ScanControlTable(regulatoryDomain_t  *pRegulatoryDomain);
 
+static void regulatoryDomain_compileChannelCap(regulatoryDomain_t *pRegulatoryDomain, ERadioBand eBand, TI_UINT8 uIndex);
+
+static void regulatoryDomain_compileCapCache(regulatoryDomain_t *pRegulatoryDomain);
+
+#ifdef TI_DBG
 static TI_STATUS regulatoryDomain_getChannelCapability(regulatoryDomain_t *pRegulatoryDomain,
         channelCapabilityReq_t channelCapabilityReq,
         channelCapabilityRet_t *channelCapabilityRet);
+#endif
 
 static void regulatoryDomain_updateChannelsTs(regulatoryDomain_t *pRegulatoryDomain, TI_UINT8 channel);
 
@@ -166,6 +172,8 @@ void regulatoryDomain_init (TStadHandlesList *pStadHandles)
 	pRegulatoryDomain->country_5_WasFound		= TI_FALSE;
 	pRegulatoryDomain->uExternTxPowerPreferred	= MAX_TX_POWER;	/* i.e. no restriction */
 	pRegulatoryDomain->uPowerConstraint			= MIN_TX_POWER;	/* i.e. no restriction */
+	pRegulatoryDomain->bCapCacheValid			= TI_FALSE;
+	pRegulatoryDomain->bCapServingValid			= TI_FALSE;
 
 	/* Init handlers */
 	pRegulatoryDomain->hSiteMgr       = pStadHandles->hSiteMgr;
@@ -273,6 +281,7 @@ TI_STATUS regulatoryDomain_setParam(TI_HANDLE hRegulatoryDomain,
 			/* Update powerConstraint */
 			if ( pRegulatoryDomain->uPowerConstraint != uNewPowerConstraint ) {
 				pRegulatoryDomain->uPowerConstraint = uNewPowerConstraint;
+				pRegulatoryDomain->bCapCacheValid = TI_FALSE;
 				/* Set new Tx power to TWD - only if needed ! */
 				regulatoryDomain_updateCurrTxPower(pRegulatoryDomain);
 			}
@@ -288,6 +297,7 @@ TI_STATUS regulatoryDomain_setParam(TI_HANDLE hRegulatoryDomain,
 
 		if ( uNewTPC != pRegulatoryDomain->uExternTxPowerPreferred ) {
 			pRegulatoryDomain->uExternTxPowerPreferred = uNewTPC;
+			pRegulatoryDomain->bCapCacheValid = TI_FALSE;
 			/* Set new Tx power to TWD - only if needed ! */
 			regulatoryDomain_updateCurrTxPower(pRegulatoryDomain);
 		}
@@ -305,6 +315,7 @@ TI_STATUS regulatoryDomain_setParam(TI_HANDLE hRegulatoryDomain,
 		/* This case is called when the desired Tx Power Level in Dbm is changed by the user */
 		if (pRegulatoryDomain->uUserMaxTxPower != pParam->content.desiredTxPower) {
 			pRegulatoryDomain->uUserMaxTxPower = pParam->content.desiredTxPower;
+			pRegulatoryDomain->bCapCacheValid = TI_FALSE;
 			/* Set new Tx power to TWD - only if needed ! */
 			regulatoryDomain_updateCurrTxPower(pRegulatoryDomain);
 		}
@@ -314,6 +325,7 @@ TI_STATUS regulatoryDomain_setParam(TI_HANDLE hRegulatoryDomain,
 	case REGULATORY_DOMAIN_TX_POWER_AFTER_SELECTION_PARAM:
 		/* Called after joining BSS, set Tx power to TWD */
 
+		pRegulatoryDomain->bCapServingValid = TI_FALSE;
 
 		/* setting the Tx Power according to the selected channel */
 		regulatoryDomain_updateCurrTxPower(pRegulatoryDomain);
@@ -324,6 +336,8 @@ TI_STATUS regulatoryDomain_setParam(TI_HANDLE hRegulatoryDomain,
 
 		pRegulatoryDomain->uExternTxPowerPreferred = MAX_TX_POWER;	/* i.e. no restriction */
 		pRegulatoryDomain->uPowerConstraint		   = MIN_TX_POWER;	/* i.e. no restriction */
+		pRegulatoryDomain->bCapCacheValid          = TI_FALSE;
+		pRegulatoryDomain->bCapServingValid        = TI_FALSE;
 
 		/* Update the last time a country code was used.
 		After uTimeOutToResetCountryMs the country code will be deleted     */
@@ -336,6 +350,11 @@ TI_STATUS regulatoryDomain_setParam(TI_HANDLE hRegulatoryDomain,
 		regulatoryDomain_updateChannelsTs(pRegulatoryDomain, pParam->content.channel);
 		break;
 
+	case REGULATORY_DOMAIN_SERVING_CHANNEL_CHANGED_PARAM:
+		/* Called when the serving channel is switched */
+		pRegulatoryDomain->bCapServingValid = TI_FALSE;
+		break;
+
 	case REGULATORY_DOMAIN_TEMPORARY_TX_ATTENUATION_PARAM:
 		/* Temporary Tx Power control */
 
@@ -357,6 +376,7 @@ TI_STATUS regulatoryDomain_setParam(TI_HANDLE hRegulatoryDomain,
 		/* Mark that no country was found - applies for both enabling and disabling of 11d */
 		pRegulatoryDomain->country_2_4_WasFound = TI_FALSE;
 		pRegulatoryDomain->country_5_WasFound = TI_FALSE;
+		pRegulatoryDomain->bCapCacheValid = TI_FALSE;
 
 		if (!pRegulatoryDomain->regulatoryDomainEnabled) {  /* Set regulatory Domain according to scan control table */
 			setSupportedChannelsAccording2ScanControlTable(pRegulatoryDomain);
@@ -370,6 +390,7 @@ TI_STATUS regulatoryDomain_setParam(TI_HANDLE hRegulatoryDomain,
 		if (pParam->content.enableDisable_802_11h) {  /* If 802_11h is enabled, enable 802_11d as well */
 			pRegulatoryDomain->regulatoryDomainEnabled = TI_TRUE;
 		}
+		pRegulatoryDomain->bCapCacheValid = TI_FALSE;
 		switchChannel_enableDisableSpectrumMngmt(pRegulatoryDomain->hSwitchChannel, pRegulatoryDomain->spectrumManagementEnabled);
 		break;
 
@@ -393,6 +414,7 @@ TI_STATUS regulatoryDomain_setParam(TI_HANDLE hRegulatoryDomain,
 		}
 		pRegulatoryDomain->minDFS_channelNum = (TI_UINT8)pParam->content.DFS_ChannelRange.minDFS_channelNum;
 		pRegulatoryDomain->maxDFS_channelNum = (TI_UINT8)pParam->content.DFS_ChannelRange.maxDFS_channelNum;
+		pRegulatoryDomain->bCapCacheValid = TI_FALSE;
 
 		break;
 
@@ -437,7 +459,9 @@ TI_STATUS regulatoryDomain_getParam(TI_HANDLE hRegulatoryDomain,
 		channelCapabilityReq.channelNum = pParam->content.channelCapabilityReq.channelNum;
 		channelCapabilityReq.scanOption = pParam->content.channelCapabilityReq.scanOption;
 
-		regulatoryDomain_getChannelCapability(pRegulatoryDomain, channelCapabilityReq, &pParam->content.channelCapabilityRet);
+		regulatoryDomain_GetChannelCapability(hRegulatoryDomain, channelCapabilityReq.band,
+		                                      channelCapabilityReq.channelNum, channelCapabilityReq.scanOption,
+		                                      &pParam->content.channelCapabilityRet);
 	}
 	break;
 
@@ -723,6 +747,7 @@ static TI_STATUS setSupportedChannelsAccording2CountryIe(regulatoryDomain_t *pRe
 
 	/* Mark the time of the received country IE */
 	pRegulatoryDomain->uLastCountryReceivedTS = os_timeStampMs(pRegulatoryDomain->hOs);
+	pRegulatoryDomain->bCapCacheValid = TI_FALSE;
 
 	/* First clear the validity of all channels
 		Overwrite the ScanControlTable */
@@ -806,7 +831,11 @@ static TI_BOOL regulatoryDomain_isChannelSupprted(regulatoryDomain_t *pRegulator
 	        && ((os_timeStampMs(pRegulatoryDomain->hOs)-pSupportedChannels[channelIndex].timestamp) >=CHANNEL_VALIDITY_TS_THRESHOLD )) {	/* If 802.11h is enabled, a DFS channel is valid only for 10 sec
 			from the last Beacon/ProbeResponse */
 		pSupportedChannels[channelIndex].channelValidityActive = TI_FALSE;
-
+		if (pRegulatoryDomain->bCapCacheValid) {
+			regulatoryDomain_compileChannelCap(pRegulatoryDomain,
+			                                   (channel >= A_5G_BAND_MIN_CHANNEL) ? RADIO_BAND_5_0_GHZ : RADIO_BAND_2_4_GHZ,
+			                                   channelIndex);
+		}
 	}
 
 	return (pSupportedChannels[channelIndex].channelValidityActive);
@@ -866,6 +895,11 @@ static void regulatoryDomain_setChannelValidity(regulatoryDomain_t *pRegulatoryD
 
 
 	pSupportedChannels[channelIndex].channelValidityActive = channelValidity;
+	if (pRegulatoryDomain->bCapCacheValid) {
+		regulatoryDomain_compileChannelCap(pRegulatoryDomain,
+		                                   (channelNum <= NUM_OF_CHANNELS_24) ? RADIO_BAND_2_4_GHZ : RADIO_BAND_5_0_GHZ,
+		                                   channelIndex);
+	}
 }
 
 
@@ -899,6 +933,7 @@ static void setSupportedChannelsAccording2ScanControlTable(regulatoryDomain_t  *
 		return;
 	}
 
+	pRegulatoryDomain->bCapCacheValid = TI_FALSE;
 
 	for (channelIndex=0; channelIndex<NUM_OF_CHANNELS_24; channelIndex++) {
 		channelMask = pRegulatoryDomain->scanControlTable.ScanControlTable24.tableString[channelIndex];
@@ -954,10 +989,13 @@ static void setSupportedChannelsAccording2ScanControlTable(regulatoryDomain_t  *
 }
 
 
+#ifdef TI_DBG
 /***********************************************************************
 *                        regulatoryDomain_getChannelCapability
 ***********************************************************************
-DESCRIPTION:	This function returns the channel capability information
+DESCRIPTION:	This function returns the channel capability information, calculated
+				from the channels table. Used as a reference for the compiled
+				capabilities (see regulatoryDomain_DbgCheckCapCache).
 
 INPUT:      pRegulatoryDomain		-	RegulatoryDomain pointer.
 			channelCapabilityReq	-	Channels parameters
@@ -1052,11 +1090,196 @@ static TI_STATUS regulatoryDomain_getChannelCapability(regulatoryDomain_t *pRegu
 			from the last Beacon/ProbeResponse */
 		pSupportedChannels[channelIndex].channelValidityActive = TI_FALSE;
 		channelCapabilityRet->channelValidity = TI_FALSE;
+		if (pRegulatoryDomain->bCapCacheValid) {
+			regulatoryDomain_compileChannelCap(pRegulatoryDomain, channelCapabilityReq.band, channelIndex);
+		}
 	}
 
 	return TI_OK;
 
 }
+#endif /* TI_DBG */
+
+
+/***********************************************************************
+*                        regulatoryDomain_compileChannelCap
+***********************************************************************
+DESCRIPTION:	Compile the capability of one channel from the channels table
+				and the current 802.11d/h and Tx power settings.
+
+INPUT:      pRegulatoryDomain	-	RegulatoryDomain pointer.
+			eBand				-	The channel band
+			uIndex				-	The channel index in the band
+
+RETURN:     void
+
+************************************************************************/
+static void regulatoryDomain_compileChannelCap(regulatoryDomain_t *pRegulatoryDomain, ERadioBand eBand, TI_UINT8 uIndex)
+{
+	TChannelCapCache    *pEntry = &pRegulatoryDomain->aCapCache[eBand][uIndex];
+	channelCapability_t *pChannel;
+	TI_UINT8            uChannel;
+	TI_BOOL             bCountryWasFound;
+
+	pEntry->uFlags = 0;
+	pEntry->uMaxTxPower = 0;
+	pEntry->uServingMaxTxPower = 0;
+
+	if (eBand == RADIO_BAND_2_4_GHZ) {
+		if (uIndex >= NUM_OF_CHANNELS_24) {
+			return;
+		}
+		pChannel = &pRegulatoryDomain->supportedChannels_band_2_4[uIndex];
+		uChannel = uIndex + BG_24G_BAND_MIN_CHANNEL;
+		bCountryWasFound = pRegulatoryDomain->country_2_4_WasFound;
+	} else {
+		pChannel = &pRegulatoryDomain->supportedChannels_band_5[uIndex];
+		uChannel = uIndex + A_5G_BAND_MIN_CHANNEL;
+		bCountryWasFound = pRegulatoryDomain->country_5_WasFound;
+	}
+
+	pEntry->uFlags = REG_CAP_IN_BAND;
+
+	if ((pRegulatoryDomain->regulatoryDomainEnabled) && (!bCountryWasFound)) {
+		/* 11d enabled and no country IE was found - invalid for active scan, valid for passive scan */
+		pEntry->uFlags |= REG_CAP_PASSIVE;
+	} else {
+		if (pChannel->channelValidityActive) {
+			pEntry->uFlags |= REG_CAP_ACTIVE;
+		}
+		if (pChannel->channelValidityPassive) {
+			pEntry->uFlags |= REG_CAP_PASSIVE;
+		}
+		pEntry->uMaxTxPower = regulatoryDomain_getMaxPowerAllowed(pRegulatoryDomain, uChannel, eBand, TI_FALSE);
+		pEntry->uServingMaxTxPower = regulatoryDomain_getMaxPowerAllowed(pRegulatoryDomain, uChannel, eBand, TI_TRUE);
+	}
+
+	if ((pRegulatoryDomain->spectrumManagementEnabled) &&
+	        (uChannel >= pRegulatoryDomain->minDFS_channelNum) &&
+	        (uChannel <= pRegulatoryDomain->maxDFS_channelNum)) {
+		pEntry->uFlags |= REG_CAP_DFS;
+	}
+}
+
+
+/***********************************************************************
+*                        regulatoryDomain_compileCapCache
+***********************************************************************
+DESCRIPTION:	Compile the capabilities of all channels in both bands.
+
+INPUT:      pRegulatoryDomain	-	RegulatoryDomain pointer.
+
+RETURN:     void
+
+************************************************************************/
+static void regulatoryDomain_compileCapCache(regulatoryDomain_t *pRegulatoryDomain)
+{
+	TI_UINT8 uIndex;
+
+	for (uIndex = 0; uIndex < A_5G_BAND_NUM_CHANNELS; uIndex++) {
+		regulatoryDomain_compileChannelCap(pRegulatoryDomain, RADIO_BAND_2_4_GHZ, uIndex);
+		regulatoryDomain_compileChannelCap(pRegulatoryDomain, RADIO_BAND_5_0_GHZ, uIndex);
+	}
+
+	pRegulatoryDomain->bCapCacheValid = TI_TRUE;
+}
+
+
+/***********************************************************************
+*                        regulatoryDomain_getCachedChannelCapability
+***********************************************************************
+DESCRIPTION:	Get the channel capability from the compiled capabilities, rebuilding
+				them if needed. Handles the cases not served by the inline
+				regulatoryDomain_GetChannelCapability: DFS channels validity expiry
+				and the serving channel Tx power.
+
+INPUT:      hRegulatoryDomain	-	RegulatoryDomain handle.
+			eBand				-	The channel band
+			uChannel			-	The channel number
+			eScanOption			-	Active or passive scan
+
+OUTPUT:		pCapability			-   Channel capability information
+
+RETURN:     TI_OK if information was retrieved, TI_NOK otherwise.
+
+************************************************************************/
+TI_STATUS regulatoryDomain_getCachedChannelCapability (TI_HANDLE hRegulatoryDomain,
+                                                       ERadioBand eBand,
+                                                       TI_UINT8 uChannel,
+                                                       regulatoryDomain_scanOption_e eScanOption,
+                                                       channelCapabilityRet_t *pCapability)
+{
+	regulatoryDomain_t  *pRegulatoryDomain = (regulatoryDomain_t *)hRegulatoryDomain;
+	TChannelCapCache    *pEntry;
+	channelCapability_t *pSupportedChannels;
+	paramInfo_t         *pParam;
+	TI_UINT32           uIndex;
+	TI_STATUS           eStatus;
+
+	pCapability->channelValidity = TI_FALSE;
+	pCapability->maxTxPowerDbm = 0;
+
+	if (!pRegulatoryDomain->bCapCacheValid) {
+		regulatoryDomain_compileCapCache(pRegulatoryDomain);
+	}
+
+	if (eBand == RADIO_BAND_2_4_GHZ) {
+		pSupportedChannels = pRegulatoryDomain->supportedChannels_band_2_4;
+		uIndex = (TI_UINT32)uChannel - BG_24G_BAND_MIN_CHANNEL;
+	} else if (eBand == RADIO_BAND_5_0_GHZ) {
+		pSupportedChannels = pRegulatoryDomain->supportedChannels_band_5;
+		uIndex = (TI_UINT32)uChannel - A_5G_BAND_MIN_CHANNEL;
+	} else {
+		return TI_NOK;
+	}
+
+	if (uIndex >= A_5G_BAND_NUM_CHANNELS) {
+		return TI_NOK;
+	}
+	pEntry = &pRegulatoryDomain->aCapCache[eBand][uIndex];
+	if (!(pEntry->uFlags & REG_CAP_IN_BAND)) {
+		return TI_NOK;
+	}
+
+	if (eScanOption != ACTIVE_SCANNING) {
+		pCapability->channelValidity = (pEntry->uFlags & REG_CAP_PASSIVE) ? TI_TRUE : TI_FALSE;
+		return TI_OK;
+	}
+
+	/* If 802.11h is enabled, a DFS channel is valid only for 10 sec from the last Beacon/ProbeResponse */
+	if ((pEntry->uFlags & REG_CAP_DFS) &&
+	        ((os_timeStampMs(pRegulatoryDomain->hOs) - pSupportedChannels[uIndex].timestamp) >= CHANNEL_VALIDITY_TS_THRESHOLD)) {
+		pSupportedChannels[uIndex].channelValidityActive = TI_FALSE;
+		pEntry->uFlags &= ~REG_CAP_ACTIVE;
+	}
+
+	pCapability->channelValidity = (pEntry->uFlags & REG_CAP_ACTIVE) ? TI_TRUE : TI_FALSE;
+	pCapability->maxTxPowerDbm = pEntry->uMaxTxPower;
+
+	/* The serving channel may have a lower Tx power (11h power constraint or XCC TPC) */
+	if (pEntry->uServingMaxTxPower != pEntry->uMaxTxPower) {
+		/* Get the serving channel only once per join or channel switch */
+		if (!pRegulatoryDomain->bCapServingValid) {
+			pParam = (paramInfo_t *)os_memoryAlloc(pRegulatoryDomain->hOs, sizeof(paramInfo_t));
+			if (!pParam) {
+				return TI_NOK;
+			}
+
+			pParam->paramType = SITE_MGR_CURRENT_CHANNEL_PARAM;
+			eStatus = siteMgr_getParam(pRegulatoryDomain->hSiteMgr, pParam);
+			pRegulatoryDomain->uCapServingChannel = (eStatus == TI_OK) ? pParam->content.siteMgrCurrentChannel : 0;
+			pRegulatoryDomain->bCapServingValid = TI_TRUE;
+
+			os_memoryFree(pRegulatoryDomain->hOs, pParam, sizeof(paramInfo_t));
+		}
+
+		if (pRegulatoryDomain->uCapServingChannel == uChannel) {
+			pCapability->maxTxPowerDbm = pEntry->uServingMaxTxPower;
+		}
+	}
+
+	return TI_OK;
+}
 
 
 static void regulatoryDomain_updateChannelsTs(regulatoryDomain_t *pRegulatoryDomain, TI_UINT8 channel)
@@ -1089,6 +1312,11 @@ static void regulatoryDomain_updateChannelsTs(regulatoryDomain_t *pRegulatoryDom
 
 	pSupportedChannels[channelIndex].timestamp = os_timeStampMs(pRegulatoryDomain->hOs);
 	pSupportedChannels[channelIndex].channelValidityActive = TI_TRUE;
+	if (pRegulatoryDomain->bCapCacheValid) {
+		regulatoryDomain_compileChannelCap(pRegulatoryDomain,
+		                                   (channel >= A_5G_BAND_MIN_CHANNEL) ? RADIO_BAND_5_0_GHZ : RADIO_BAND_2_4_GHZ,
+		                                   channelIndex);
+	}
 
 }
 
@@ -1321,6 +1549,170 @@ static void regulatoryDomain_getPowerTableMinMax (regulatoryDomain_t *pRegulator
 	}
 }
 
+#ifdef TI_DBG
+#define REG_DOMAIN_DBG_RAND(uSeed)   ((uSeed) = (uSeed) * 1103515245 + 12345, ((uSeed) >> 16) & 0x7FFF)
+
+/**
+ * \fn     regulatoryDomain_DbgCheckCapCache
+ * \brief  Verify the compiled channel capabilities against the channels table
+ *
+ * Randomize the 802.11d/h settings, scan control tables, country IEs, Tx power
+ *   limits, DFS range and channels timestamps, and compare the capabilities of all
+ *   channels as returned by the compiled and the reference calculations.
+ * The module state is restored when done.
+ *
+ * \note   The serving channel is taken from the site manager as is
+ * \param  hRegulatoryDomain - Handle to the regulatory domain object
+ * \param  uIterations       - Number of random configurations to check (0 for 100)
+ * \return void
+ * \sa     regulatoryDomain_GetChannelCapability
+ */
+void regulatoryDomain_DbgCheckCapCache (TI_HANDLE hRegulatoryDomain, TI_UINT32 uIterations)
+{
+	regulatoryDomain_t      *pRegulatoryDomain = (regulatoryDomain_t *)hRegulatoryDomain;
+	regulatoryDomain_t      *pSaved;
+	TCountry                *pCountry;
+	channelCapabilityReq_t  tReq;
+	channelCapabilityRet_t  tRefCap, tCachedCap;
+	TI_STATUS               eRefStatus, eCachedStatus;
+	TI_UINT32               uSeed = os_timeStampMs(pRegulatoryDomain->hOs);
+	TI_UINT32               uIter, uPass, uBand, uChannel, uOption, uTriplets, i;
+	TI_UINT32               uNow, uChecks = 0, uMismatches = 0;
+
+	if (uIterations == 0) {
+		uIterations = 100;
+	}
+
+	pSaved = (regulatoryDomain_t *)os_memoryAlloc(pRegulatoryDomain->hOs, sizeof(regulatoryDomain_t));
+	if (!pSaved) {
+		return;
+	}
+	pCountry = (TCountry *)os_memoryAlloc(pRegulatoryDomain->hOs, sizeof(TCountry));
+	if (!pCountry) {
+		os_memoryFree(pRegulatoryDomain->hOs, pSaved, sizeof(regulatoryDomain_t));
+		return;
+	}
+	os_memoryCopy(pRegulatoryDomain->hOs, pSaved, pRegulatoryDomain, sizeof(regulatoryDomain_t));
+
+	WLAN_OS_REPORT(("Checking compiled channel capabilities: %d iterations, seed %u\n", uIterations, uSeed));
+
+	for (uIter = 0; uIter < uIterations; uIter++) {
+		/* 802.11d/h settings and scan control tables */
+		pRegulatoryDomain->spectrumManagementEnabled = (REG_DOMAIN_DBG_RAND(uSeed) & 3) ? TI_FALSE : TI_TRUE;
+		pRegulatoryDomain->regulatoryDomainEnabled = (REG_DOMAIN_DBG_RAND(uSeed) & 1) ? TI_TRUE : TI_FALSE;
+		if (pRegulatoryDomain->spectrumManagementEnabled) {
+			pRegulatoryDomain->regulatoryDomainEnabled = TI_TRUE;
+		}
+		pRegulatoryDomain->country_2_4_WasFound = TI_FALSE;
+		pRegulatoryDomain->country_5_WasFound = TI_FALSE;
+		for (i = 0; i < NUM_OF_CHANNELS_24; i++) {
+			pRegulatoryDomain->scanControlTable.ScanControlTable24.tableString[i] = (TI_UINT8)REG_DOMAIN_DBG_RAND(uSeed);
+		}
+		for (i = 0; i < A_5G_BAND_NUM_CHANNELS; i++) {
+			pRegulatoryDomain->scanControlTable.ScanControlTable5.tableString[i] = (TI_UINT8)REG_DOMAIN_DBG_RAND(uSeed);
+		}
+		setSupportedChannelsAccording2ScanControlTable(pRegulatoryDomain);
+
+		/* Country IEs */
+		for (uBand = 0; uBand < RADIO_BAND_NUM_OF_BANDS; uBand++) {
+			if (REG_DOMAIN_DBG_RAND(uSeed) & 1) {
+				continue;
+			}
+			uTriplets = 1 + REG_DOMAIN_DBG_RAND(uSeed) % 8;
+			pCountry->elementId = DOT11_COUNTRY_ELE_ID;
+			pCountry->len = DOT11_COUNTRY_STRING_LEN + (3 * uTriplets);
+			pCountry->countryIE.CountryString[0] = 'X';
+			pCountry->countryIE.CountryString[1] = 'X';
+			pCountry->countryIE.CountryString[2] = ' ';
+			for (i = 0; i < uTriplets; i++) {
+				dot11_TripletChannel_t *pTriplet = &pCountry->countryIE.tripletChannels[i];
+
+				if (uBand == RADIO_BAND_2_4_GHZ) {
+					pTriplet->firstChannelNumber = BG_24G_BAND_MIN_CHANNEL + REG_DOMAIN_DBG_RAND(uSeed) % NUM_OF_CHANNELS_24;
+					pTriplet->numberOfChannels = 1 + REG_DOMAIN_DBG_RAND(uSeed) % NUM_OF_CHANNELS_24;
+				} else {
+					pTriplet->firstChannelNumber = A_5G_BAND_MIN_CHANNEL + 4 * (REG_DOMAIN_DBG_RAND(uSeed) % 33);
+					pTriplet->numberOfChannels = 1 + REG_DOMAIN_DBG_RAND(uSeed) % 8;
+				}
+				pTriplet->maxTxPowerLevel = REG_DOMAIN_DBG_RAND(uSeed) % 30;
+			}
+			setSupportedChannelsAccording2CountryIe(pRegulatoryDomain, pCountry, (uBand == RADIO_BAND_2_4_GHZ) ? TI_TRUE : TI_FALSE);
+		}
+
+		/* Tx power limits and DFS range */
+		pRegulatoryDomain->uPowerConstraint = REG_DOMAIN_DBG_RAND(uSeed) % 60;
+		pRegulatoryDomain->uExternTxPowerPreferred = (REG_DOMAIN_DBG_RAND(uSeed) & 1) ? MAX_TX_POWER : REG_DOMAIN_DBG_RAND(uSeed) % MAX_TX_POWER;
+		pRegulatoryDomain->uUserMaxTxPower = REG_DOMAIN_DBG_RAND(uSeed) % MAX_TX_POWER;
+		pRegulatoryDomain->minDFS_channelNum = A_5G_BAND_MIN_CHANNEL + REG_DOMAIN_DBG_RAND(uSeed) % A_5G_BAND_NUM_CHANNELS;
+		pRegulatoryDomain->maxDFS_channelNum = pRegulatoryDomain->minDFS_channelNum +
+		                                       REG_DOMAIN_DBG_RAND(uSeed) % (A_5G_BAND_MAX_CHANNEL - pRegulatoryDomain->minDFS_channelNum + 1);
+		pRegulatoryDomain->bCapCacheValid = TI_FALSE;
+
+		/* Channels timestamps - either fresh or expired */
+		uNow = os_timeStampMs(pRegulatoryDomain->hOs);
+		for (i = 0; i < NUM_OF_CHANNELS_24; i++) {
+			pRegulatoryDomain->supportedChannels_band_2_4[i].timestamp = (REG_DOMAIN_DBG_RAND(uSeed) & 1) ? uNow : uNow - 2 * CHANNEL_VALIDITY_TS_THRESHOLD;
+		}
+		for (i = 0; i < A_5G_BAND_NUM_CHANNELS; i++) {
+			pRegulatoryDomain->supportedChannels_band_5[i].timestamp = (REG_DOMAIN_DBG_RAND(uSeed) & 1) ? uNow : uNow - 2 * CHANNEL_VALIDITY_TS_THRESHOLD;
+		}
+
+		/* Compare before and after some incremental changes to the compiled capabilities */
+		for (uPass = 0; uPass < 2; uPass++) {
+			if (uPass == 1) {
+				for (i = 0; i < 8; i++) {
+					uChannel = (REG_DOMAIN_DBG_RAND(uSeed) & 1) ?
+					           BG_24G_BAND_MIN_CHANNEL + REG_DOMAIN_DBG_RAND(uSeed) % NUM_OF_CHANNELS_24 :
+					           A_5G_BAND_MIN_CHANNEL + REG_DOMAIN_DBG_RAND(uSeed) % A_5G_BAND_NUM_CHANNELS;
+					if (REG_DOMAIN_DBG_RAND(uSeed) & 1) {
+						regulatoryDomain_setChannelValidity(pRegulatoryDomain, (TI_UINT16)uChannel,
+						                                    (REG_DOMAIN_DBG_RAND(uSeed) & 1) ? TI_TRUE : TI_FALSE);
+					} else {
+						regulatoryDomain_updateChannelsTs(pRegulatoryDomain, (TI_UINT8)uChannel);
+					}
+				}
+			}
+
+			for (uBand = 0; uBand < RADIO_BAND_NUM_OF_BANDS; uBand++) {
+				for (uChannel = 0; uChannel <= A_5G_BAND_MAX_CHANNEL + 1; uChannel++) {
+					for (uOption = ACTIVE_SCANNING; uOption <= PASSIVE_SCANNING; uOption++) {
+						eCachedStatus = regulatoryDomain_GetChannelCapability(hRegulatoryDomain, (ERadioBand)uBand, (TI_UINT8)uChannel,
+						                (regulatoryDomain_scanOption_e)uOption, &tCachedCap);
+
+						tReq.band = (ERadioBand)uBand;
+						tReq.channelNum = (TI_UINT8)uChannel;
+						tReq.scanOption = (regulatoryDomain_scanOption_e)uOption;
+						eRefStatus = regulatoryDomain_getChannelCapability(pRegulatoryDomain, tReq, &tRefCap);
+
+						uChecks++;
+						if ((eCachedStatus != eRefStatus) ||
+						        (tCachedCap.channelValidity != tRefCap.channelValidity) ||
+						        (tCachedCap.maxTxPowerDbm != tRefCap.maxTxPowerDbm)) {
+							if (uMismatches < 10) {
+								WLAN_OS_REPORT(("Mismatch: iteration %d, band %d, channel %d, %s: cached %d/%d/%d, reference %d/%d/%d\n",
+								                uIter, uBand, uChannel, (uOption == ACTIVE_SCANNING) ? "active" : "passive",
+								                eCachedStatus, tCachedCap.channelValidity, tCachedCap.maxTxPowerDbm,
+								                eRefStatus, tRefCap.channelValidity, tRefCap.maxTxPowerDbm));
+							}
+							uMismatches++;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	/* Restore the module state */
+	os_memoryCopy(pRegulatoryDomain->hOs, pRegulatoryDomain, pSaved, sizeof(regulatoryDomain_t));
+	pRegulatoryDomain->bCapCacheValid = TI_FALSE;
+
+	os_memoryFree(pRegulatoryDomain->hOs, pCountry, sizeof(TCountry));
+	os_memoryFree(pRegulatoryDomain->hOs, pSaved, sizeof(regulatoryDomain_t));
+
+	WLAN_OS_REPORT(("Compiled channel capabilities check: %d checks, %d mismatches\n", uChecks, uMismatches));
+}
+#endif /* TI_DBG */
+
 /* for debug */
 void regDomainPrintValidTables(TI_HANDLE hRegulatoryDomain)
 {
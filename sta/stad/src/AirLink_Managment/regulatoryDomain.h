@@ -60,6 +60,12 @@
 #define A_5G_BAND_MIN_UPPER_BAND_DFS_CHANNEL    100
 #define A_5G_BAND_MAX_UPPER_BAND_DFS_CHANNEL    140
 
+/* Compiled channel capability flags */
+#define REG_CAP_IN_BAND             0x01    /* The channel exists in the band */
+#define REG_CAP_ACTIVE              0x02    /* Valid for active scan */
+#define REG_CAP_PASSIVE             0x04    /* Valid for passive scan */
+#define REG_CAP_DFS                 0x08    /* Active scan validity expires if no frame was received lately (802.11h) */
+
 
 typedef struct {
 	TI_BOOL    channelValidityPassive; /*TI_TRUE-valid, TI_FALSE-invalid */
@@ -75,6 +81,14 @@ typedef struct {
 }   channelCapability_t;
 
 
+/* Compiled channel capability, derived from channelCapability_t and the current 802.11d/h and power settings */
+typedef struct {
+	TI_UINT8   uFlags;                /* REG_CAP_xxx */
+	TI_UINT8   uMaxTxPower;           /* Max Tx power for active scan in Dbm/10, on a non-serving channel */
+	TI_UINT8   uServingMaxTxPower;    /* Max Tx power for active scan in Dbm/10, on the serving channel */
+}   TChannelCapCache;
+
+
 typedef struct {
 	/* Variables read from registry */
 	/********************************/
@@ -119,6 +133,15 @@ typedef struct {
 	   will be unaligned accesses.  Expect it might now be +1 since 2 UINT8 variable
 	   have been added in 4.03 (max and min DFS_channelNum above) */
 
+	/* Compiled channel capabilities per band, indexed by (channel - band min channel).
+	   Rebuilt on the next query after bCapCacheValid is cleared */
+	TChannelCapCache                	aCapCache[RADIO_BAND_NUM_OF_BANDS][A_5G_BAND_NUM_CHANNELS];
+	TI_BOOL                         	bCapCacheValid;
+	/* Serving channel for the aCapCache serving Tx power (0 if not joined).
+	   Read from the site manager on the next query after bCapServingValid is cleared */
+	TI_UINT8                        	uCapServingChannel;
+	TI_BOOL                         	bCapServingValid;
+
 
 	/* Handles to other objects */
 	TI_HANDLE                       	hSiteMgr;
@@ -92,6 +92,68 @@ TI_STATUS regulatoryDomain_getParam(TI_HANDLE hRegulatoryDomain, paramInfo_t *pP
 
 TI_STATUS regulatoryDomain_destroy(TI_HANDLE hRegulatoryDomain);
 
+TI_STATUS regulatoryDomain_getCachedChannelCapability (TI_HANDLE hRegulatoryDomain,
+                                                       ERadioBand eBand,
+                                                       TI_UINT8 uChannel,
+                                                       regulatoryDomain_scanOption_e eScanOption,
+                                                       channelCapabilityRet_t *pCapability);
+
+#ifdef TI_DBG
+void      regulatoryDomain_DbgCheckCapCache (TI_HANDLE hRegulatoryDomain, TI_UINT32 uIterations);
+#endif
+
+/**
+ * \brief	Get channel scan capability
+ *
+ * \param  hRegulatoryDomain	-	Handle to the regulatory domain object
+ * \param  eBand				-	The channel band
+ * \param  uChannel				-	The channel number
+ * \param  eScanOption			-	Active or passive scan
+ * \param  pCapability			-	Output - the channel validity and max Tx power
+ * \return TI_OK on success, TI_NOK if the channel is not in the band
+ *
+ * \par Description
+ * Same as REGULATORY_DOMAIN_GET_SCAN_CAPABILITIES, without the paramInfo_t.
+ * Served from the compiled capabilities, unless they need to be rebuilt, the channel is a
+ * DFS channel or it may be the serving channel with a different max Tx power.
+ *
+ * \sa
+ */
+static INLINE TI_STATUS regulatoryDomain_GetChannelCapability (TI_HANDLE hRegulatoryDomain,
+                                                              ERadioBand eBand,
+                                                              TI_UINT8 uChannel,
+                                                              regulatoryDomain_scanOption_e eScanOption,
+                                                              channelCapabilityRet_t *pCapability)
+{
+	regulatoryDomain_t *pRegulatoryDomain = (regulatoryDomain_t *)hRegulatoryDomain;
+	TChannelCapCache   *pEntry;
+	TI_UINT32          uIndex;
+
+	if (pRegulatoryDomain->bCapCacheValid && ((TI_UINT32)eBand < RADIO_BAND_NUM_OF_BANDS)) {
+		uIndex = (TI_UINT32)uChannel - ((eBand == RADIO_BAND_2_4_GHZ) ? BG_24G_BAND_MIN_CHANNEL : A_5G_BAND_MIN_CHANNEL);
+
+		if (uIndex < A_5G_BAND_NUM_CHANNELS) {
+			pEntry = &pRegulatoryDomain->aCapCache[eBand][uIndex];
+
+			if (pEntry->uFlags & REG_CAP_IN_BAND) {
+				if (eScanOption == PASSIVE_SCANNING) {
+					pCapability->channelValidity = (pEntry->uFlags & REG_CAP_PASSIVE) ? TI_TRUE : TI_FALSE;
+					pCapability->maxTxPowerDbm = 0;
+					return TI_OK;
+				}
+
+				if (!(pEntry->uFlags & REG_CAP_DFS) && (pEntry->uMaxTxPower == pEntry->uServingMaxTxPower)) {
+					pCapability->channelValidity = (pEntry->uFlags & REG_CAP_ACTIVE) ? TI_TRUE : TI_FALSE;
+					pCapability->maxTxPowerDbm = pEntry->uMaxTxPower;
+					return TI_OK;
+				}
+			}
+		}
+	}
+
+	return regulatoryDomain_getCachedChannelCapability (hRegulatoryDomain, eBand, uChannel, eScanOption, pCapability);
+}
+
 #endif /* __REGULATORY_DOMAIN_API_H__*/
 
 
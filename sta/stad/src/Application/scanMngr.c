@@ -94,7 +94,316 @@ static TI_UINT32 reminder64( TI_UINT64 dividee, TI_UINT32 divider )
 	return ( partB + (divideeLow % divider)) % divider;
 }
 
+/***************************************************************************
+*                           reminder32                                     *
+****************************************************************************
+DESCRIPTION:    returns the reminder of a 32 bit number division by a 32
+                bit number, using a precomputed reciprocal of the divider
+                instead of a division.
+
+INPUT:      The dividee (32 bit number to divide)
+            The divider (32 bit number to divide by)
+            The reciprocal (0xFFFFFFFF / divider)
+
+OUTPUT:
+
+
+RETURN:     The reminder
+****************************************************************************/
+static TI_UINT32 reminder32( TI_UINT32 dividee, TI_UINT32 divider, TI_UINT32 reciprocal )
+{
+	TI_UINT32 quotient, reminder;
+
+	/* the estimated quotient is smaller than the real quotient by at most 2 */
+	quotient = (TI_UINT32)((((TI_UINT64)dividee) * reciprocal) >> 32);
+	reminder = dividee - (quotient * divider);
+	while ( reminder >= divider ) {
+		reminder -= divider;
+	}
+
+	return reminder;
+}
+
+/***************************************************************************
+*                           scanMngrBSSReminder                            *
+****************************************************************************
+DESCRIPTION:    returns the time passed (in usec) from the last beacon
+                transmission of a tracked AP to the given remote TSF value.
+                The reminder is calculated from the AP TBTT anchor using the
+                beacon interval reciprocal. These are recalculated (with
+                reminder64) when the beacon interval changes, the remote TSF
+                is before the anchor (AP TSF reset) or too far from it.
+
+INPUT:      pScanMngr - the scan manager object
+            BSSList - the track list
+            entryIndex - index of the AP in the track list
+            remoteTSF - the remote TSF value
+
+OUTPUT:
+
+
+RETURN:     The reminder
+****************************************************************************/
+static TI_UINT32 scanMngrBSSReminder( scanMngr_t* pScanMngr, scan_BSSList_t* BSSList, TI_UINT8 entryIndex, TI_UINT64 remoteTSF )
+{
+	scan_BSSEntry_t* pScanBSS = &(BSSList->scanBSSList[ entryIndex ]);
+	TI_UINT32 beaconIntervalUsec = BSSList->BSSList[ entryIndex ].beaconInterval * 1024;
+	TI_UINT64 usecFromAnchor;
+	TI_UINT32 reminder;
+
+#ifdef TI_DBG
+	if ( TI_TRUE == pScanMngr->bSPSReferenceCalc ) {
+		return reminder64( remoteTSF, beaconIntervalUsec );
+	}
+#endif
+
+	usecFromAnchor = remoteTSF - pScanBSS->remoteTBTTAnchor;
+	if ( (beaconIntervalUsec == pScanBSS->bcnIntervalUsec) &&
+	        (remoteTSF >= pScanBSS->remoteTBTTAnchor) &&
+	        (0 == INT64_HIGHER( usecFromAnchor ))) {
+		reminder = reminder32( INT64_LOWER( usecFromAnchor ), beaconIntervalUsec, pScanBSS->bcnIntervalRecip );
+	} else {
+		reminder = reminder64( remoteTSF, beaconIntervalUsec );
+		if ( beaconIntervalUsec != pScanBSS->bcnIntervalUsec ) {
+			pScanBSS->bcnIntervalUsec = beaconIntervalUsec;
+			pScanBSS->bcnIntervalRecip = 0xFFFFFFFF / beaconIntervalUsec;
+		}
+	}
+
+	/* keep the anchor close to the next calculations */
+	pScanBSS->remoteTBTTAnchor = remoteTSF - reminder;
+
+	return reminder;
+}
+
+/***************************************************************************
+*                           scanMngrUpdateDTIMReciprocal                   *
+****************************************************************************
+DESCRIPTION:    recalculates the current BSS DTIM period (in usec) and its
+                reciprocal, used for SPS DTIM collision detection, if the
+                current BSS beacon interval or DTIM period had changed.
+
+INPUT:      pScanMngr - the scan manager object
+
+OUTPUT:
+
+
+RETURN:     void
+****************************************************************************/
+static void scanMngrUpdateDTIMReciprocal( scanMngr_t* pScanMngr )
+{
+	TI_UINT32 DTIMPeriodInUsec = pScanMngr->currentBSSBeaconInterval * 1024 * pScanMngr->currentBSSDtimPeriod;
+
+	if ( (0 != DTIMPeriodInUsec) && (DTIMPeriodInUsec != pScanMngr->currentBSSDtimPeriodUsec)) {
+		pScanMngr->currentBSSDtimPeriodUsec = DTIMPeriodInUsec;
+		pScanMngr->currentBSSDtimPeriodRecip = 0xFFFFFFFF / DTIMPeriodInUsec;
+	}
+}
+
+/* whether SPS event a is to be scheduled before SPS event b (same TSF events by track list index) */
+#define SPS_EVENT_EARLIER( a, b )                                                   \
+    (((a).nextEventTSF < (b).nextEventTSF) ||                                       \
+     (((a).nextEventTSF == (b).nextEventTSF) && ((a).trackListIndex < (b).trackListIndex)))
+
+/***************************************************************************
+*                           scanMngrSPSHeapSiftUp                          *
+****************************************************************************
+DESCRIPTION:    moves an SPS event heap entry up to its place.
+
+INPUT:      heap - the SPS event heap
+            index - the entry index
+
+OUTPUT:
+
+
+RETURN:     void
+****************************************************************************/
+static void scanMngrSPSHeapSiftUp( scan_SPSHelper_t* heap, int index )
+{
+	scan_SPSHelper_t entry = heap[ index ];
+	int parent;
+
+	while ( index > 0 ) {
+		parent = (index - 1) >> 1;
+		if ( !SPS_EVENT_EARLIER( entry, heap[ parent ] )) {
+			break;
+		}
+		heap[ index ] = heap[ parent ];
+		index = parent;
+	}
+	heap[ index ] = entry;
+}
+
+/***************************************************************************
+*                           scanMngrSPSHeapSiftDown                        *
+****************************************************************************
+DESCRIPTION:    moves an SPS event heap entry down to its place.
+
+INPUT:      heap - the SPS event heap
+            index - the entry index
+            size - number of entries in the heap
+
+OUTPUT:
+
+
+RETURN:     void
+****************************************************************************/
+static void scanMngrSPSHeapSiftDown( scan_SPSHelper_t* heap, int index, int size )
+{
+	scan_SPSHelper_t entry = heap[ index ];
+	int child;
+
+	while ( (child = (index << 1) + 1) < size ) {
+		if ( (child + 1 < size) && SPS_EVENT_EARLIER( heap[ child + 1 ], heap[ child ] )) {
+			child++;
+		}
+		if ( !SPS_EVENT_EARLIER( heap[ child ], entry )) {
+			break;
+		}
+		heap[ index ] = heap[ child ];
+		index = child;
+	}
+	heap[ index ] = entry;
+}
+
+/***************************************************************************
+*                           scanMngrHashLink                               *
+****************************************************************************
+DESCRIPTION:    adds a list entry to the end of its BSSID hash bucket chain,
+                so that the chain is searched by entry insertion order.
+
+INPUT:      pBucketHead - the bucket chain head
+            pNext - the list next entry array
+            index - the entry index
+
+OUTPUT:
+
+
+RETURN:     void
+****************************************************************************/
+static void scanMngrHashLink( TI_INT8* pBucketHead, TI_INT8* pNext, TI_UINT8 index )
+{
+	TI_INT8* pLink = pBucketHead;
+
+	while ( -1 != *pLink ) {
+		pLink = &(pNext[ (TI_UINT8)*pLink ]);
+	}
+	*pLink = (TI_INT8)index;
+	pNext[ index ] = -1;
+}
+
+/***************************************************************************
+*                           scanMngrHashUnlink                             *
+****************************************************************************
+DESCRIPTION:    removes a list entry from its BSSID hash bucket chain.
+
+INPUT:      pBucketHead - the bucket chain head
+            pNext - the list next entry array
+            index - the entry index
+
+OUTPUT:
+
+
+RETURN:     void
+****************************************************************************/
+static void scanMngrHashUnlink( TI_INT8* pBucketHead, TI_INT8* pNext, TI_UINT8 index )
+{
+	TI_INT8* pLink = pBucketHead;
+
+	while ( -1 != *pLink ) {
+		if ( (TI_INT8)index == *pLink ) {
+			*pLink = pNext[ index ];
+			return;
+		}
+		pLink = &(pNext[ (TI_UINT8)*pLink ]);
+	}
+}
+
+/***************************************************************************
+*                           scanMngrTrackHashReset                         *
+****************************************************************************
+DESCRIPTION:    empties the track list BSSID hash index.
+
+INPUT:      pScanMngr - the scan manager object
+
+OUTPUT:
+
+
+RETURN:     void
+****************************************************************************/
+static void scanMngrTrackHashReset( scanMngr_t* pScanMngr )
+{
+	os_memorySet( pScanMngr->hOS, pScanMngr->trackHashHead, -1, sizeof(pScanMngr->trackHashHead));
+}
+
+/***************************************************************************
+*                           scanMngrNeighborHashReset                      *
+****************************************************************************
+DESCRIPTION:    empties the neighbor AP lists BSSID hash indexes.
+
+INPUT:      pScanMngr - the scan manager object
+
+OUTPUT:
+
 
+RETURN:     void
+****************************************************************************/
+static void scanMngrNeighborHashReset( scanMngr_t* pScanMngr )
+{
+	os_memorySet( pScanMngr->hOS, pScanMngr->neighborHashHead, -1, sizeof(pScanMngr->neighborHashHead));
+}
+
+#define TRACK_HASH_BUCKET( pScanMngr, index ) \
+    (&((pScanMngr)->trackHashHead[ SCAN_MNGR_BSSID_HASH( (pScanMngr)->BSSList.BSSList[ index ].BSSID ) ]))
+
+
+
+/**
+ * \\n
+ * \brief Copies the track list to the fixed size exported BSS list.\n
+ *
+ * If more BSSes are tracked than the exported list can hold, the strongest
+ * (by average RSSI) are exported, in their track list order.\n
+ * \param pScanMngr - handle to the scan manager object.\n
+ * \return a pointer to the exported BSS list.\n
+ */
+static bssList_t* scanMngrExportBSSList( scanMngr_t* pScanMngr )
+{
+	bssList_t* pExport = &(pScanMngr->exportBSSList);
+	TI_UINT8 numOfEntries = pScanMngr->BSSList.numOfEntries;
+	TI_BOOL bSelected[ SCAN_MNGR_TRACK_LIST_SIZE ];
+	TI_UINT8 i, j;
+	TI_INT8 best;
+
+	if ( numOfEntries <= MAX_SIZE_OF_BSS_TRACK_LIST ) {
+		os_memoryCopy( pScanMngr->hOS, pExport->BSSList, pScanMngr->BSSList.BSSList, numOfEntries * sizeof(bssEntry_t) );
+		pExport->numOfEntries = numOfEntries;
+		return pExport;
+	}
+
+	/* select the strongest entries */
+	os_memoryZero( pScanMngr->hOS, bSelected, sizeof(bSelected) );
+	for ( i = 0; i < MAX_SIZE_OF_BSS_TRACK_LIST; i++ ) {
+		best = -1;
+		for ( j = 0; j < numOfEntries; j++ ) {
+			if ( (TI_FALSE == bSelected[ j ]) &&
+			        ((-1 == best) || (pScanMngr->BSSList.BSSList[ j ].RSSI > pScanMngr->BSSList.BSSList[ best ].RSSI)) ) {
+				best = j;
+			}
+		}
+		bSelected[ best ] = TI_TRUE;
+	}
+
+	/* and copy them keeping the track list order */
+	for ( i = 0, j = 0; j < numOfEntries; j++ ) {
+		if ( TI_TRUE == bSelected[ j ] ) {
+			pExport->BSSList[ i++ ] = pScanMngr->BSSList.BSSList[ j ];
+		}
+	}
+	pExport->numOfEntries = i;
+
+	return pExport;
+}
 
 static void scanMngr_setManualScanDefaultParams(TI_HANDLE hScanMngr)
 {
@@ -137,7 +446,7 @@ void scanMngrFreeMem (TI_HANDLE hScanMngr)
 	TI_UINT8 i;
 
 	/* free frame storage space */
-	for (i = 0; i < MAX_SIZE_OF_BSS_TRACK_LIST; i++) {
+	for (i = 0; i < SCAN_MNGR_TRACK_LIST_SIZE; i++) {
 		if (pScanMngr->BSSList.BSSList[i].pBuffer) {
 			os_memoryFree (pScanMngr->hOS, pScanMngr->BSSList.BSSList[i].pBuffer, MAX_BEACON_BODY_LENGTH);
 		}
@@ -333,7 +642,7 @@ void scanMngr_contScanCB( TI_HANDLE hScanMngr, EScanCncnResultStatus resultStatu
 		{
 			pScanMngr->bNewBSSFound = TI_FALSE;
 			pScanMngr->consecNotFound = 0;
-			roamingMngr_updateNewBssList( pScanMngr->hRoamingMngr, (bssList_t*)&(pScanMngr->BSSList));
+			roamingMngr_updateNewBssList( pScanMngr->hRoamingMngr, scanMngrExportBSSList( pScanMngr ));
 
 			if (SCANNING_OPERATIONAL_MODE_MANUAL == pScanMngr->scanningOperationalMode) {
 				scanMngr_reportContinuousScanResults(hScanMngr, resultStatus);
@@ -659,6 +968,7 @@ void scanMngrPerformContinuousScan( TI_HANDLE hScanMngr )
 	if ( (0 == pScanMngr->currentBSSBeaconInterval) || (0 == pScanMngr->currentBSSDtimPeriod)) {
 		return;
 	}
+	scanMngrUpdateDTIMReciprocal( pScanMngr );
 
 	/* increase the consecutive not found counter */
 	pScanMngr->consecNotFound++;
@@ -765,7 +1075,7 @@ void scanMngrPerformAging( TI_HANDLE hScanMngr )
 	TI_UINT8 BSSEntryIndex;
 
 	/* It looks like it never happens. Anyway decided to check */
-	if (pScanMngr->BSSList.numOfEntries > MAX_SIZE_OF_BSS_TRACK_LIST) {
+	if (pScanMngr->BSSList.numOfEntries > SCAN_MNGR_TRACK_LIST_SIZE) {
 		handleRunProblem(PROBLEM_BUF_SIZE_VIOLATION);
 		return;
 	}
@@ -832,7 +1142,7 @@ void scanMngrUpdateReceivedFrame( TI_HANDLE hScanMngr, TScanFrameInfo* frameInfo
 	BSSListIndex = scanMngrGetTrackIndexByBssid( hScanMngr, frameInfo->bssId );
 
 	/* if the frame received from an AP in the track list */
-	if (( -1 != BSSListIndex ) && (BSSListIndex < MAX_SIZE_OF_BSS_TRACK_LIST )) {
+	if (( -1 != BSSListIndex ) && (BSSListIndex < SCAN_MNGR_TRACK_LIST_SIZE )) {
 		scanMngrUpdateBSSInfo( hScanMngr, BSSListIndex, frameInfo );
 	}
 	/* otherwise, if the list is not full and AP is either a neighbor AP or on a policy defined channel: */
@@ -896,7 +1206,7 @@ void scanMngrInsertNewBSSToTrackingList( TI_HANDLE hScanMngr, TScanFrameInfo* fr
 	pScanMngr->bNewBSSFound = TI_TRUE;
 
 	/* It looks like it never happens. Anyway decided to check */
-	if ( pScanMngr->BSSList.numOfEntries > MAX_SIZE_OF_BSS_TRACK_LIST ) {
+	if ( pScanMngr->BSSList.numOfEntries > SCAN_MNGR_TRACK_LIST_SIZE ) {
 		handleRunProblem(PROBLEM_BUF_SIZE_VIOLATION);
 		return;
 	}
@@ -906,6 +1216,8 @@ void scanMngrInsertNewBSSToTrackingList( TI_HANDLE hScanMngr, TScanFrameInfo* fr
 	      TI_FALSE :
 	      TI_TRUE );
 	MAC_COPY (pScanMngr->BSSList.BSSList[pScanMngr->BSSList.numOfEntries].BSSID, *(frameInfo->bssId));
+	scanMngrHashLink( TRACK_HASH_BUCKET( pScanMngr, pScanMngr->BSSList.numOfEntries ), pScanMngr->trackHashNext,
+	                  pScanMngr->BSSList.numOfEntries );
 
 	/* initialize average RSSI value */
 	pScanMngr->BSSList.BSSList[ pScanMngr->BSSList.numOfEntries ].RSSI = frameInfo->rssi;
@@ -920,6 +1232,9 @@ void scanMngrInsertNewBSSToTrackingList( TI_HANDLE hScanMngr, TScanFrameInfo* fr
 	}
 #endif
 
+	/* the beacon interval reciprocal and TBTT anchor are calculated on first SPS use */
+	pScanMngr->BSSList.scanBSSList[ pScanMngr->BSSList.numOfEntries ].bcnIntervalUsec = 0;
+
 	/* update regular fields */
 	pScanMngr->BSSList.scanBSSList[ pScanMngr->BSSList.numOfEntries ].trackFailCount = 0; /* for correct statistics update */
 	scanMngrUpdateBSSInfo( hScanMngr, pScanMngr->BSSList.numOfEntries, frameInfo );
@@ -1037,10 +1352,11 @@ void scanMngrUpdateBSSInfo( TI_HANDLE hScanMngr, TI_UINT8 BSSListIndex, TScanFra
 TI_INT8 scanMngrGetTrackIndexByBssid( TI_HANDLE hScanMngr, TMacAddr* bssId )
 {
 	scanMngr_t* pScanMngr = (scanMngr_t*)hScanMngr;
-	int i;
+	TI_INT8 i;
 
-	for ( i = 0; i < pScanMngr->BSSList.numOfEntries; i++ ) {
-		if (MAC_EQUAL(*bssId, pScanMngr->BSSList.BSSList[ i ].BSSID)) {
+	/* walk the BSSID hash bucket chain */
+	for ( i = pScanMngr->trackHashHead[ SCAN_MNGR_BSSID_HASH( *bssId ) ]; -1 != i; i = pScanMngr->trackHashNext[ (TI_UINT8)i ] ) {
+		if (MAC_EQUAL(*bssId, pScanMngr->BSSList.BSSList[ (TI_UINT8)i ].BSSID)) {
 			return i;
 		}
 	}
@@ -1230,7 +1546,8 @@ void scanMngrBuildImmediateScanCommand( TI_HANDLE hScanMngr, TScanBandPolicy* ba
 {
 	scanMngr_t* pScanMngr = (scanMngr_t*)hScanMngr;
 	int channelIndex;
-	paramInfo_t param;
+	channelCapabilityRet_t channelCapability;
+	regulatoryDomain_scanOption_e eScanOption;
 	TMacAddr broadcastAddress;
 	int i;
 
@@ -1253,25 +1570,22 @@ void scanMngrBuildImmediateScanCommand( TI_HANDLE hScanMngr, TScanBandPolicy* ba
 		while ( (channelIndex < pScanMngr->neighborAPsDiscoveryList[ bandPolicy->band ].numOfEntries) &&
 		        (pScanMngr->scanParams.numOfChannels < SCAN_MAX_NUM_OF_NORMAL_CHANNELS_PER_COMMAND)) {
 			/* verify channel with reg domain */
-			param.paramType = REGULATORY_DOMAIN_GET_SCAN_CAPABILITIES;
-			param.content.channelCapabilityReq.band = bandPolicy->band;
 			if ( (bandPolicy->immediateScanMethod.scanType == SCAN_TYPE_NORMAL_PASSIVE) ||
 			        (bandPolicy->immediateScanMethod.scanType == SCAN_TYPE_TRIGGERED_PASSIVE) ||
 			        (bandPolicy->immediateScanMethod.scanType == SCAN_TYPE_SPS)) {
-				param.content.channelCapabilityReq.scanOption = PASSIVE_SCANNING;
+				eScanOption = PASSIVE_SCANNING;
 			} else {
-				param.content.channelCapabilityReq.scanOption = ACTIVE_SCANNING;
+				eScanOption = ACTIVE_SCANNING;
 			}
-			param.content.channelCapabilityReq.channelNum =
-			    pScanMngr->neighborAPsDiscoveryList[ bandPolicy->band ].APListPtr[ channelIndex ].channel;
-			regulatoryDomain_getParam( pScanMngr->hRegulatoryDomain, &param );
+			regulatoryDomain_GetChannelCapability( pScanMngr->hRegulatoryDomain, bandPolicy->band, pScanMngr->neighborAPsDiscoveryList[ bandPolicy->band ].APListPtr[ channelIndex ].channel,
+			                                       eScanOption, &channelCapability );
 
 			/* if the channel is allowed, insert it to the scan command */
-			if (param.content.channelCapabilityRet.channelValidity) {
+			if (channelCapability.channelValidity) {
 				scanMngrAddNormalChannel( hScanMngr, &(bandPolicy->immediateScanMethod),
 				                          pScanMngr->neighborAPsDiscoveryList[ bandPolicy->band ].APListPtr[ channelIndex ].channel,
 				                          &(pScanMngr->neighborAPsDiscoveryList[ bandPolicy->band ].APListPtr[ channelIndex ].BSSID),
-				                          param.content.channelCapabilityRet.maxTxPowerDbm );
+				                          channelCapability.maxTxPowerDbm );
 			}
 			channelIndex++;
 		}
@@ -1288,24 +1602,22 @@ void scanMngrBuildImmediateScanCommand( TI_HANDLE hScanMngr, TScanBandPolicy* ba
 		while ( (channelIndex < bandPolicy->numOfChannles) &&
 		        (pScanMngr->scanParams.numOfChannels < SCAN_MAX_NUM_OF_NORMAL_CHANNELS_PER_COMMAND)) {
 			/* verify channel with reg domain */
-			param.paramType = REGULATORY_DOMAIN_GET_SCAN_CAPABILITIES;
-			param.content.channelCapabilityReq.band = bandPolicy->band;
 			if ( (bandPolicy->immediateScanMethod.scanType == SCAN_TYPE_NORMAL_PASSIVE) ||
 			        (bandPolicy->immediateScanMethod.scanType == SCAN_TYPE_TRIGGERED_PASSIVE) ||
 			        (bandPolicy->immediateScanMethod.scanType == SCAN_TYPE_SPS)) {
-				param.content.channelCapabilityReq.scanOption = PASSIVE_SCANNING;
+				eScanOption = PASSIVE_SCANNING;
 			} else {
-				param.content.channelCapabilityReq.scanOption = ACTIVE_SCANNING;
+				eScanOption = ACTIVE_SCANNING;
 			}
-			param.content.channelCapabilityReq.channelNum = bandPolicy->channelList[ channelIndex ];
-			regulatoryDomain_getParam( pScanMngr->hRegulatoryDomain, &param );
+			regulatoryDomain_GetChannelCapability( pScanMngr->hRegulatoryDomain, bandPolicy->band, bandPolicy->channelList[ channelIndex ],
+			                                       eScanOption, &channelCapability );
 
 			/* if the channel is allowed, insert it to the scan command */
-			if (param.content.channelCapabilityRet.channelValidity) {
+			if (channelCapability.channelValidity) {
 				scanMngrAddNormalChannel( hScanMngr, &(bandPolicy->immediateScanMethod),
 				                          bandPolicy->channelList[ channelIndex ],
 				                          &broadcastAddress,
-				                          param.content.channelCapabilityRet.maxTxPowerDbm );
+				                          channelCapability.maxTxPowerDbm );
 			}
 			channelIndex++;
 		}
@@ -1326,7 +1638,8 @@ void scanMngrBuildTrackScanCommand( TI_HANDLE hScanMngr, TScanBandPolicy* bandPo
 {
 	scanMngr_t* pScanMngr = (scanMngr_t*)hScanMngr;
 	int BSSListIndex;
-	paramInfo_t param;
+	channelCapabilityRet_t channelCapability;
+	regulatoryDomain_scanOption_e eScanOption;
 	TScanMethod* scanMethod;
 
 	/* SPS is performed differently from all other scan types, and only if TSF error has not occured */
@@ -1353,7 +1666,7 @@ void scanMngrBuildTrackScanCommand( TI_HANDLE hScanMngr, TScanBandPolicy* bandPo
 	scanMngrBuildScanCommandHeader( hScanMngr, scanMethod, band );
 
 	/* It looks like it never happens. Anyway decided to check */
-	if ( pScanMngr->BSSList.numOfEntries > MAX_SIZE_OF_BSS_TRACK_LIST ) {
+	if ( pScanMngr->BSSList.numOfEntries > SCAN_MNGR_TRACK_LIST_SIZE ) {
 		handleRunProblem(PROBLEM_BUF_SIZE_VIOLATION);
 		return;
 	}
@@ -1368,23 +1681,21 @@ void scanMngrBuildTrackScanCommand( TI_HANDLE hScanMngr, TScanBandPolicy* bandPo
 		/* if BSS is on the right band */
 		if ( band == pScanMngr->BSSList.BSSList[ BSSListIndex ].band ) {
 			/* verify the channel with the reg domain */
-			param.paramType = REGULATORY_DOMAIN_GET_SCAN_CAPABILITIES;
-			param.content.channelCapabilityReq.band = band;
 			if ( (scanMethod->scanType == SCAN_TYPE_NORMAL_PASSIVE) ||
 			        (scanMethod->scanType == SCAN_TYPE_TRIGGERED_PASSIVE)) {
-				param.content.channelCapabilityReq.scanOption = PASSIVE_SCANNING;
+				eScanOption = PASSIVE_SCANNING;
 			} else {
-				param.content.channelCapabilityReq.scanOption = ACTIVE_SCANNING;
+				eScanOption = ACTIVE_SCANNING;
 			}
-			param.content.channelCapabilityReq.channelNum = pScanMngr->BSSList.BSSList[ BSSListIndex ].channel;
-			regulatoryDomain_getParam( pScanMngr->hRegulatoryDomain, &param );
+			regulatoryDomain_GetChannelCapability( pScanMngr->hRegulatoryDomain, band, pScanMngr->BSSList.BSSList[ BSSListIndex ].channel,
+			                                       eScanOption, &channelCapability );
 
 			/* if channel is verified for requested scan type */
-			if ( param.content.channelCapabilityRet.channelValidity ) {
+			if ( channelCapability.channelValidity ) {
 				scanMngrAddNormalChannel( hScanMngr, scanMethod,
 				                          pScanMngr->BSSList.BSSList[ BSSListIndex ].channel,
 				                          &(pScanMngr->BSSList.BSSList[ BSSListIndex ].BSSID),
-				                          param.content.channelCapabilityRet.maxTxPowerDbm );
+				                          channelCapability.maxTxPowerDbm );
 
 				/* increase AP track attempts counter */
 				if ( (SCAN_TYPE_SPS == bandPolicy->trackingMethod.scanType) && (TI_FALSE == pScanMngr->bSynchronized)) {
@@ -1613,7 +1924,8 @@ void scanMngrAddNeighborAPsForDiscovery( TI_HANDLE hScanMngr, TScanBandPolicy* b
 {
 	scanMngr_t* pScanMngr = (scanMngr_t*)hScanMngr;
 	int neighborAPIndex;
-	paramInfo_t param;
+	channelCapabilityRet_t channelCapability;
+	regulatoryDomain_scanOption_e eScanOption;
 
 	/* It looks like it never happens. Anyway decided to check */
 	if ( bandPolicy->band >= RADIO_BAND_NUM_OF_BANDS ) {
@@ -1629,25 +1941,22 @@ void scanMngrAddNeighborAPsForDiscovery( TI_HANDLE hScanMngr, TScanBandPolicy* b
 		if ( SCAN_NDS_NOT_DISCOVERED ==
 		        pScanMngr->neighborAPsDiscoveryList[ bandPolicy->band ].trackStatusList[ neighborAPIndex ] ) {
 			/* verify channel with reg domain */
-			param.paramType = REGULATORY_DOMAIN_GET_SCAN_CAPABILITIES;
-			param.content.channelCapabilityReq.band = bandPolicy->band;
 			if ( (bandPolicy->discoveryMethod.scanType == SCAN_TYPE_NORMAL_PASSIVE) ||
 			        (bandPolicy->discoveryMethod.scanType == SCAN_TYPE_TRIGGERED_PASSIVE) ||
 			        (bandPolicy->discoveryMethod.scanType == SCAN_TYPE_SPS)) {
-				param.content.channelCapabilityReq.scanOption = PASSIVE_SCANNING;
+				eScanOption = PASSIVE_SCANNING;
 			} else {
-				param.content.channelCapabilityReq.scanOption = ACTIVE_SCANNING;
+				eScanOption = ACTIVE_SCANNING;
 			}
-			param.content.channelCapabilityReq.channelNum =
-			    pScanMngr->neighborAPsDiscoveryList[ bandPolicy->band ].APListPtr[ neighborAPIndex ].channel;
-			regulatoryDomain_getParam( pScanMngr->hRegulatoryDomain, &param );
+			regulatoryDomain_GetChannelCapability( pScanMngr->hRegulatoryDomain, bandPolicy->band, pScanMngr->neighborAPsDiscoveryList[ bandPolicy->band ].APListPtr[ neighborAPIndex ].channel,
+			                                       eScanOption, &channelCapability );
 
 			/* if the channel is allowed, insert it to the scan command */
-			if (param.content.channelCapabilityRet.channelValidity) {
+			if (channelCapability.channelValidity) {
 				scanMngrAddNormalChannel( hScanMngr, &(bandPolicy->discoveryMethod),
 				                          pScanMngr->neighborAPsDiscoveryList[ bandPolicy->band ].APListPtr[ neighborAPIndex ].channel,
 				                          &(pScanMngr->neighborAPsDiscoveryList[ bandPolicy->band ].APListPtr[ neighborAPIndex ].BSSID),
-				                          param.content.channelCapabilityRet.maxTxPowerDbm );
+				                          channelCapability.maxTxPowerDbm );
 			}
 		}
 		neighborAPIndex++;
@@ -1675,7 +1984,8 @@ void scanMngrAddNeighborAPsForDiscovery( TI_HANDLE hScanMngr, TScanBandPolicy* b
 void scanMngrAddChannelListForDiscovery( TI_HANDLE hScanMngr, TScanBandPolicy* bandPolicy )
 {
 	scanMngr_t* pScanMngr = (scanMngr_t*)hScanMngr;
-	paramInfo_t param;
+	channelCapabilityRet_t channelCapability;
+	regulatoryDomain_scanOption_e eScanOption;
 	TMacAddr broadcastAddress;
 	int i, channelListIndex;
 
@@ -1700,25 +2010,22 @@ void scanMngrAddChannelListForDiscovery( TI_HANDLE hScanMngr, TScanBandPolicy* b
 	        (pScanMngr->scanParams.numOfChannels < SCAN_MAX_NUM_OF_NORMAL_CHANNELS_PER_COMMAND) &&
 	        (channelListIndex < bandPolicy->numOfChannles)) {
 		/* verify channel with reg domain */
-		param.paramType = REGULATORY_DOMAIN_GET_SCAN_CAPABILITIES;
-		param.content.channelCapabilityReq.band = bandPolicy->band;
 		if ( (bandPolicy->discoveryMethod.scanType == SCAN_TYPE_NORMAL_PASSIVE) ||
 		        (bandPolicy->discoveryMethod.scanType == SCAN_TYPE_TRIGGERED_PASSIVE) ||
 		        (bandPolicy->discoveryMethod.scanType == SCAN_TYPE_SPS)) {
-			param.content.channelCapabilityReq.scanOption = PASSIVE_SCANNING;
+			eScanOption = PASSIVE_SCANNING;
 		} else {
-			param.content.channelCapabilityReq.scanOption = ACTIVE_SCANNING;
+			eScanOption = ACTIVE_SCANNING;
 		}
-		param.content.channelCapabilityReq.channelNum =
-		    bandPolicy->channelList[ channelListIndex ];
-		regulatoryDomain_getParam( pScanMngr->hRegulatoryDomain, &param );
+		regulatoryDomain_GetChannelCapability( pScanMngr->hRegulatoryDomain, bandPolicy->band, bandPolicy->channelList[ channelListIndex ],
+		                                       eScanOption, &channelCapability );
 
 		/* if the channel is allowed, insert it to the scan command */
-		if (param.content.channelCapabilityRet.channelValidity) {
+		if (channelCapability.channelValidity) {
 			scanMngrAddNormalChannel( hScanMngr, &(bandPolicy->discoveryMethod),
 			                          bandPolicy->channelList[ channelListIndex ],
 			                          &broadcastAddress,
-			                          param.content.channelCapabilityRet.maxTxPowerDbm );
+			                          channelCapability.maxTxPowerDbm );
 		}
 		channelListIndex++;
 	}
@@ -1738,6 +2045,7 @@ void scanMngrAddChannelListForDiscovery( TI_HANDLE hScanMngr, TScanBandPolicy* b
  * \date 02-Mar-2005\n
  * \brief Add SPS channels to scan command on the object workspace.\n
  *
+ * The tracked APs are ordered by their next event TSF in a min-heap.\n
  * Function Scope \e Private.\n
  * \param hScanMngr - handle to the scan manager object.\n
  * \param scanMethod - The scan method (and parameters) to use.\n
@@ -1749,35 +2057,31 @@ void scanMngrAddSPSChannels( TI_HANDLE hScanMngr, TScanMethod* scanMethod, ERadi
 	TI_UINT64 EarliestTSFToInsert;
 	TI_UINT32 timeToStartInAdvance = scanMethod->method.spsMethodParams.scanDuration /
 	                                 SCAN_SPS_DURATION_PART_IN_ADVANCE;
-	scan_SPSHelper_t nextEventArray[ MAX_SIZE_OF_BSS_TRACK_LIST ];
-	int BSSListIndex, i, j, nextEventArrayHead, nextEventArraySize;
-	paramInfo_t param;
+	scan_SPSHelper_t* nextEventHeap = pScanMngr->SPSEventHeap;
+	int BSSListIndex, nextEventHeapSize;
+	channelCapabilityRet_t channelCapability;
 
 	/* initialize latest TSF value */
 	pScanMngr->scanParams.latestTSFValue = 0;
 
-	/* initialize the next event arry */
-	nextEventArrayHead = -1;
-	nextEventArraySize = 0;
+	/* initialize the next event heap */
+	nextEventHeapSize = 0;
 
 	/* It looks like it never happens. Anyway decided to check */
-	if ( pScanMngr->BSSList.numOfEntries > MAX_SIZE_OF_BSS_TRACK_LIST ) {
+	if ( pScanMngr->BSSList.numOfEntries > SCAN_MNGR_TRACK_LIST_SIZE ) {
 		handleRunProblem(PROBLEM_BUF_SIZE_VIOLATION);
 		return;
 	}
-	/* insert channels from tracking list to next event array according to requested band */
+	/* insert channels from tracking list to next event heap according to requested band */
 	for ( BSSListIndex = 0; BSSListIndex < pScanMngr->BSSList.numOfEntries; BSSListIndex++ ) {
 		/* if BSS is on the right band */
 		if ( band == pScanMngr->BSSList.BSSList[ BSSListIndex ].band ) {
 			/* verify the channel with the reg domain */
-			param.paramType = REGULATORY_DOMAIN_GET_SCAN_CAPABILITIES;
-			param.content.channelCapabilityReq.band = band;
-			param.content.channelCapabilityReq.scanOption = PASSIVE_SCANNING;
-			param.content.channelCapabilityReq.channelNum = pScanMngr->BSSList.BSSList[ BSSListIndex ].channel;
-			regulatoryDomain_getParam( pScanMngr->hRegulatoryDomain, &param );
+			regulatoryDomain_GetChannelCapability( pScanMngr->hRegulatoryDomain, band, pScanMngr->BSSList.BSSList[ BSSListIndex ].channel,
+			                                       PASSIVE_SCANNING, &channelCapability );
 
 			/* if channel is verified for requested scan type */
-			if ( param.content.channelCapabilityRet.channelValidity ) {
+			if ( channelCapability.channelValidity ) {
 				/* if this AP local TSF value is greater that latest TSF value, change it */
 				if ( pScanMngr->BSSList.scanBSSList[ BSSListIndex ].localTSF > pScanMngr->scanParams.latestTSFValue ) {
 					/* the latest TSF value is used by the FW to detect TSF error (an AP recovery). When a TSF
@@ -1788,37 +2092,16 @@ void scanMngrAddSPSChannels( TI_HANDLE hScanMngr, TScanMethod* scanMethod, ERadi
 
 				/* calculate the TSF of the next event for tracked AP. Scan should start
 				   SCAN_SPS_DURATION_PART_IN_ADVANCE before the calculated event */
-				nextEventArray[ nextEventArraySize ].nextEventTSF =
+				nextEventHeap[ nextEventHeapSize ].nextEventTSF =
 				    scanMngrCalculateNextEventTSF( hScanMngr, &(pScanMngr->BSSList), BSSListIndex,
 				                                   pScanMngr->currentTSF + SCAN_SPS_GUARD_FROM_CURRENT_TSF +
 				                                   timeToStartInAdvance ) - timeToStartInAdvance;
-				nextEventArray[ nextEventArraySize ].trackListIndex = BSSListIndex;
+				nextEventHeap[ nextEventHeapSize ].trackListIndex = BSSListIndex;
+				nextEventHeap[ nextEventHeapSize ].nextAPIndex = -1;
 
-				/* insert it, sorted, to the next event array */
-				/* if need to insert as head (either because list is empty or because it has earliest TSF) */
-				if ( (-1 == nextEventArrayHead) ||
-				        (nextEventArray[ nextEventArraySize ].nextEventTSF < nextEventArray[ nextEventArrayHead ].nextEventTSF)) {
-					/* link the newly inserted AP to the current head */
-					nextEventArray[ nextEventArraySize ].nextAPIndex = nextEventArrayHead;
-					/* make current head point to newly inserted AP */
-					nextEventArrayHead = nextEventArraySize;
-					nextEventArraySize++;
-				}
-				/* insert into the list */
-				else {
-					/* start with list head */
-					i = nextEventArrayHead;
-					/* while the new AP TSF is larger and list end had not been reached */
-					while ( (nextEventArray[ i ].nextAPIndex != -1) && /* list end had not been reached */
-					        (nextEventArray[ nextEventArray[ i ].nextAPIndex ].nextEventTSF < nextEventArray[ nextEventArraySize ].nextEventTSF)) { /* next event TSF of the next AP in the list is smaller than that of the AP being inserted */
-						/* proceed to the next AP */
-						i = nextEventArray[ i ].nextAPIndex;
-					}
-					/* insert this AP to the list, right after the next event entry found */
-					nextEventArray[ nextEventArraySize ].nextAPIndex = nextEventArray[ i ].nextAPIndex;
-					nextEventArray[ i ].nextAPIndex = nextEventArraySize;
-					nextEventArraySize++;
-				}
+				/* insert it to the next event heap */
+				scanMngrSPSHeapSiftUp( nextEventHeap, nextEventHeapSize );
+				nextEventHeapSize++;
 			}
 			/* if for some reason a channel on which an AP was found is not valid for passive scan,
 			   the AP should be removed. */
@@ -1835,18 +2118,18 @@ void scanMngrAddSPSChannels( TI_HANDLE hScanMngr, TScanMethod* scanMethod, ERadi
 		}
 	}
 
-	/* insert channels from next event array to scan command */
+	/* insert channels from next event heap to scan command */
 	EarliestTSFToInsert = pScanMngr->currentTSF + SCAN_SPS_GUARD_FROM_CURRENT_TSF;
 	/* insert all APs to scan command (as long as command is not full) */
-	while ( (nextEventArraySize > 0) &&
+	while ( (nextEventHeapSize > 0) &&
 	        (pScanMngr->scanParams.numOfChannels < SCAN_MAX_NUM_OF_SPS_CHANNELS_PER_COMMAND)) {
-		/* if first list entry fits, and it doesn't collide with current AP DTIM */
-		if ( EarliestTSFToInsert < nextEventArray[ nextEventArrayHead ].nextEventTSF ) {
-			if ( TI_FALSE == scanMngrDTIMInRange( hScanMngr, nextEventArray[ nextEventArrayHead ].nextEventTSF,
-			                                      nextEventArray[ nextEventArrayHead ].nextEventTSF + scanMethod->method.spsMethodParams.scanDuration )) {
+		/* if earliest event fits, and it doesn't collide with current AP DTIM */
+		if ( EarliestTSFToInsert < nextEventHeap[ 0 ].nextEventTSF ) {
+			if ( TI_FALSE == scanMngrDTIMInRange( hScanMngr, nextEventHeap[ 0 ].nextEventTSF,
+			                                      nextEventHeap[ 0 ].nextEventTSF + scanMethod->method.spsMethodParams.scanDuration )) {
 				/* insert it to scan command */
 				pScanMngr->scanParams.channelEntry[ pScanMngr->scanParams.numOfChannels ].SPSChannelEntry.scanStartTime =
-				    INT64_LOWER( (nextEventArray[ nextEventArrayHead ].nextEventTSF));
+				    INT64_LOWER( (nextEventHeap[ 0 ].nextEventTSF));
 				pScanMngr->scanParams.channelEntry[ pScanMngr->scanParams.numOfChannels ].SPSChannelEntry.scanDuration =
 				    scanMethod->method.spsMethodParams.scanDuration;
 				pScanMngr->scanParams.channelEntry[ pScanMngr->scanParams.numOfChannels ].SPSChannelEntry.ETMaxNumOfAPframes =
@@ -1854,36 +2137,38 @@ void scanMngrAddSPSChannels( TI_HANDLE hScanMngr, TScanMethod* scanMethod, ERadi
 				pScanMngr->scanParams.channelEntry[ pScanMngr->scanParams.numOfChannels ].SPSChannelEntry.earlyTerminationEvent =
 				    scanMethod->method.spsMethodParams.earlyTerminationEvent;
 				pScanMngr->scanParams.channelEntry[ pScanMngr->scanParams.numOfChannels ].SPSChannelEntry.channel =
-				    pScanMngr->BSSList.BSSList[ nextEventArray[ nextEventArrayHead ].trackListIndex ].channel;
+				    pScanMngr->BSSList.BSSList[ nextEventHeap[ 0 ].trackListIndex ].channel;
 				MAC_COPY (pScanMngr->scanParams.channelEntry[ pScanMngr->scanParams.numOfChannels ].SPSChannelEntry.bssId,
-				          pScanMngr->BSSList.BSSList[ nextEventArray[ nextEventArrayHead ].trackListIndex ].BSSID);
+				          pScanMngr->BSSList.BSSList[ nextEventHeap[ 0 ].trackListIndex ].BSSID);
 				/* increase the AP track attempts counter */
-				pScanMngr->BSSList.scanBSSList[ nextEventArray[ nextEventArrayHead ].trackListIndex ].trackFailCount++;
+				pScanMngr->BSSList.scanBSSList[ nextEventHeap[ 0 ].trackListIndex ].trackFailCount++;
 				/* increase number of channels in scan command */
 				pScanMngr->scanParams.numOfChannels++;
 				/* set earliest TSF that would fit in scan command */
-				EarliestTSFToInsert = nextEventArray[ nextEventArrayHead ].nextEventTSF +
+				EarliestTSFToInsert = nextEventHeap[ 0 ].nextEventTSF +
 				                      scanMethod->method.spsMethodParams.scanDuration +
 				                      SCAN_SPS_GUARD_FROM_LAST_BSS;
-				/* remove it from next event array */
-				nextEventArrayHead = nextEventArray[ nextEventArrayHead ].nextAPIndex;
-				nextEventArraySize--;
+				/* remove it from next event heap */
+				nextEventHeapSize--;
+				nextEventHeap[ 0 ] = nextEventHeap[ nextEventHeapSize ];
+				scanMngrSPSHeapSiftDown( nextEventHeap, 0, nextEventHeapSize );
 			} else {
 				TI_UINT32 beaconIntervalUsec =
-				    pScanMngr->BSSList.BSSList[ nextEventArray[ nextEventArrayHead ].trackListIndex ].beaconInterval * 1024;
+				    pScanMngr->BSSList.BSSList[ nextEventHeap[ 0 ].trackListIndex ].beaconInterval * 1024;
 
 				/* if the next beacon also collide with DTIM */
-				if ( TI_TRUE == scanMngrDTIMInRange( hScanMngr, nextEventArray[ nextEventArrayHead ].nextEventTSF + beaconIntervalUsec,
-				                                     nextEventArray[ nextEventArrayHead ].nextEventTSF + scanMethod->method.spsMethodParams.scanDuration + beaconIntervalUsec )) {
+				if ( TI_TRUE == scanMngrDTIMInRange( hScanMngr, nextEventHeap[ 0 ].nextEventTSF + beaconIntervalUsec,
+				                                     nextEventHeap[ 0 ].nextEventTSF + scanMethod->method.spsMethodParams.scanDuration + beaconIntervalUsec )) {
 					/* An AP whose two consecutive beacons collide with current AP DTIM is not trackable by SPS!!!
 					   Shouldn't happen at a normal setup, but checked to avoid endless loop.
 					   First, remove it from the tracking list (by increasing it's track count above the maximum) */
-					pScanMngr->BSSList.scanBSSList[ nextEventArray[ nextEventArrayHead ].trackListIndex ].trackFailCount =
+					pScanMngr->BSSList.scanBSSList[ nextEventHeap[ 0 ].trackListIndex ].trackFailCount =
 					    pScanMngr->scanPolicy.maxTrackFailures + 1;
 
-					/* and also remove it from the SPS list */
-					nextEventArrayHead = nextEventArray[ nextEventArrayHead ].nextAPIndex;
-					nextEventArraySize--;
+					/* and also remove it from the SPS heap */
+					nextEventHeapSize--;
+					nextEventHeap[ 0 ] = nextEventHeap[ nextEventHeapSize ];
+					scanMngrSPSHeapSiftDown( nextEventHeap, 0, nextEventHeapSize );
 
 #ifdef TI_DBG
 					/* update statistics */
@@ -1891,32 +2176,14 @@ void scanMngrAddSPSChannels( TI_HANDLE hScanMngr, TScanMethod* scanMethod, ERadi
 #endif
 				} else {
 					/* calculate next event TSF - will get the next beacon, since timeToStartInAdvance is added to current beacon TSF */
-					nextEventArray[ nextEventArrayHead ].nextEventTSF =
+					nextEventHeap[ 0 ].nextEventTSF =
 					    scanMngrCalculateNextEventTSF( hScanMngr, &(pScanMngr->BSSList),
-					                                   nextEventArray[ nextEventArrayHead ].trackListIndex,
-					                                   nextEventArray[ nextEventArrayHead ].nextEventTSF + timeToStartInAdvance + 1)
+					                                   nextEventHeap[ 0 ].trackListIndex,
+					                                   nextEventHeap[ 0 ].nextEventTSF + timeToStartInAdvance + 1)
 					    - timeToStartInAdvance;
 
-					/* reinsert to the next event array, sorted */
-					/* if still needs to be head, do nothing (because it's still head). otherwise: */
-					if ( (1 < nextEventArraySize) && /* list has more than one entry */
-					        (nextEventArray[ nextEventArrayHead ].nextEventTSF > nextEventArray[ nextEventArray[ nextEventArrayHead ].nextAPIndex ].nextEventTSF)) { /* first event in list is earlier */
-						/* first remove the head from the list */
-						j = nextEventArrayHead;
-						nextEventArrayHead = nextEventArray[ nextEventArrayHead ].nextAPIndex;
-
-						/* start with list head */
-						i = nextEventArrayHead;
-						/* while the new AP TSF is larger and list end had not been reached */
-						while ( (nextEventArray[ i ].nextAPIndex != -1) && /* list end had not been reached */
-						        (nextEventArray[ nextEventArray[ i ].nextAPIndex ].nextEventTSF < nextEventArray[ j ].nextEventTSF)) { /* next event TSF of the next AP in the list is smaller than that of the AP being inserted */
-							/* proceed to the next AP */
-							i = nextEventArray[ i ].nextAPIndex;
-						}
-						/* insert this AP to the list, right after the next event entry found */
-						nextEventArray[ j ].nextAPIndex = nextEventArray[ i ].nextAPIndex;
-						nextEventArray[ i ].nextAPIndex = j;
-					}
+					/* the event was postponed - move it down the heap */
+					scanMngrSPSHeapSiftDown( nextEventHeap, 0, nextEventHeapSize );
 
 #ifdef TI_DBG
 					/* update statistics */
@@ -1926,32 +2193,13 @@ void scanMngrAddSPSChannels( TI_HANDLE hScanMngr, TScanMethod* scanMethod, ERadi
 			}
 		} else {
 			/* calculate next event TSF */
-			nextEventArray[ nextEventArrayHead ].nextEventTSF =
+			nextEventHeap[ 0 ].nextEventTSF =
 			    scanMngrCalculateNextEventTSF( hScanMngr, &(pScanMngr->BSSList),
-			                                   nextEventArray[ nextEventArrayHead ].trackListIndex,
+			                                   nextEventHeap[ 0 ].trackListIndex,
 			                                   EarliestTSFToInsert + timeToStartInAdvance ) - timeToStartInAdvance;
 
-			/* reinsert to the next event array, sorted */
-			/* if still needs to be head, do nothing (because it's still head). otherwise: */
-			if ( (1 < nextEventArraySize) && /* list has more than one entry */
-			        (nextEventArray[ nextEventArrayHead ].nextEventTSF > nextEventArray[ nextEventArray[ nextEventArrayHead ].nextAPIndex ].nextEventTSF)) { /* first event in list is earlier */
-				/* first remove the head from the list */
-				j = nextEventArrayHead;
-				nextEventArrayHead = nextEventArray[ nextEventArrayHead ].nextAPIndex;
-
-				/* start with list head */
-				i = nextEventArrayHead;
-				/* while the new AP TSF is larger and list end had not been reached */
-				while ( (nextEventArray[ i ].nextAPIndex != -1) && /* list end had not been reached */
-				        (nextEventArray[ nextEventArray[ i ].nextAPIndex ].nextEventTSF < nextEventArray[ j ].nextEventTSF)) { /* next event TSF of the next AP in the list is smaller than that of the AP being inserted */
-					/* proceed to the next AP */
-					i = nextEventArray[ i ].nextAPIndex;
-				}
-				/* insert this AP to the list, right after the next event entry found */
-				nextEventArray[ j ].nextAPIndex = nextEventArray[ i ].nextAPIndex;
-				nextEventArray[ i ].nextAPIndex = j;
-			}
-
+			/* the event was postponed - move it down the heap */
+			scanMngrSPSHeapSiftDown( nextEventHeap, 0, nextEventHeapSize );
 		}
 	}
 	/* For SPS scan, the scan duration is added to the command, since later on current TSF cannot be
@@ -2027,7 +2275,7 @@ TI_UINT64 scanMngrCalculateNextEventTSF( TI_HANDLE hScanMngr, scan_BSSList_t* BS
 	/* find last remote beacon transmission by subtracting the reminder of current remote TSF divided
 	   by the beacon interval (indicating how much time passed since last beacon) from current remote
 	   TSF */
-	reminder = reminder64( remoteBeaconTSF, BSSList->BSSList[ entryIndex ].beaconInterval * 1024 );
+	reminder = scanMngrBSSReminder( (scanMngr_t*)hScanMngr, BSSList, entryIndex, remoteBeaconTSF );
 	remoteBeaconTSF -= reminder;
 
 	/* advance from last beacon to next beacon */
@@ -2120,7 +2368,14 @@ TI_BOOL scanMngrDTIMInRange( TI_HANDLE hScanMngr, TI_UINT64 rangeStart, TI_UINT6
 		TI_UINT64 usecDiffFromRangeStartToLastDTIM = rangeStart - DTIMEventStart;
 		/* get the reminder from the usec difference divided by the DTIM period - the time (in usec) from last DTIM
 		   to SPS start */
-		TI_UINT32 reminder = reminder64( usecDiffFromRangeStartToLastDTIM, DTIMPeriodInUsec );
+		TI_UINT32 reminder;
+		if ( (DTIMPeriodInUsec == pScanMngr->currentBSSDtimPeriodUsec) &&
+		        (0 == INT64_HIGHER( usecDiffFromRangeStartToLastDTIM ))) {
+			reminder = reminder32( INT64_LOWER( usecDiffFromRangeStartToLastDTIM ), DTIMPeriodInUsec,
+			                       pScanMngr->currentBSSDtimPeriodRecip );
+		} else {
+			reminder = reminder64( usecDiffFromRangeStartToLastDTIM, DTIMPeriodInUsec );
+		}
 		/* get the next DTIM start time by adding DTIM period to the last DTIM before the SPS range start */
 		DTIMEventStart = rangeStart - reminder + DTIMPeriodInUsec;
 		/* get DTIM end time */
@@ -2215,6 +2470,8 @@ void scanMngrRemoveBSSListEntry( TI_HANDLE hScanMngr, TI_UINT8 BSSEntryIndex )
 		pScanMngr->stats.ConsecutiveTrackFailCountHistogram[ pScanMngr->BSSList.scanBSSList[ BSSEntryIndex ].trackFailCount ]++;
 	}
 #endif
+	scanMngrHashUnlink( TRACK_HASH_BUCKET( pScanMngr, BSSEntryIndex ), pScanMngr->trackHashNext, BSSEntryIndex );
+
 	/* if no more entries are available, simply reduce the number of entries.
 	   As this is the last entry, it won't be accessed any more. */
 	if ( (pScanMngr->BSSList.numOfEntries-1) == BSSEntryIndex ) {
@@ -2222,6 +2479,9 @@ void scanMngrRemoveBSSListEntry( TI_HANDLE hScanMngr, TI_UINT8 BSSEntryIndex )
 
 		pScanMngr->BSSList.numOfEntries--;
 	} else {
+		/* the last entry moves to the removed entry index */
+		scanMngrHashUnlink( TRACK_HASH_BUCKET( pScanMngr, pScanMngr->BSSList.numOfEntries-1 ), pScanMngr->trackHashNext,
+		                    pScanMngr->BSSList.numOfEntries-1 );
 		/* keep the scan result buffer pointer */
 		tempResultBuffer = pScanMngr->BSSList.BSSList[ BSSEntryIndex ].pBuffer;
 		/* copy the last entry over this one */
@@ -2233,6 +2493,7 @@ void scanMngrRemoveBSSListEntry( TI_HANDLE hScanMngr, TI_UINT8 BSSEntryIndex )
 		               sizeof(scan_BSSEntry_t));
 		/* replace the scan result buffer of the last entry */
 		pScanMngr->BSSList.BSSList[ pScanMngr->BSSList.numOfEntries-1 ].pBuffer = tempResultBuffer;
+		scanMngrHashLink( TRACK_HASH_BUCKET( pScanMngr, BSSEntryIndex ), pScanMngr->trackHashNext, BSSEntryIndex );
 		/* decrease the number of BSS entries */
 		pScanMngr->BSSList.numOfEntries--;
 	}
@@ -2254,7 +2515,7 @@ void scanMngrUpdateBSSList( TI_HANDLE hScanMngr, TI_BOOL bCheckNeighborAPs, TI_B
 	int BSSEntryIndex;
 
 	/* It looks like it never happens. Anyway decided to check */
-	if (pScanMngr->BSSList.numOfEntries > MAX_SIZE_OF_BSS_TRACK_LIST) {
+	if (pScanMngr->BSSList.numOfEntries > SCAN_MNGR_TRACK_LIST_SIZE) {
 		handleRunProblem(PROBLEM_BUF_SIZE_VIOLATION);
 		return;
 	}
@@ -2308,11 +2569,11 @@ void scanMngrUpdateBSSList( TI_HANDLE hScanMngr, TI_BOOL bCheckNeighborAPs, TI_B
 TI_INT8 scanMngrGetNeighborAPIndex( TI_HANDLE hScanMngr, ERadioBand band, TMacAddr* bssId )
 {
 	scanMngr_t* pScanMngr = (scanMngr_t*)hScanMngr;
-	int i;
+	TI_INT8 i;
 
-	/* loop on all neighbor APS for this AP's band, and compare BSSID's */
-	for ( i = 0; i < pScanMngr->neighborAPsDiscoveryList[ band ].numOfEntries; i++ ) {
-		if (MAC_EQUAL (*bssId, pScanMngr->neighborAPsDiscoveryList[ band ].APListPtr[ i ].BSSID)) {
+	/* walk the BSSID hash bucket chain of this AP's band (in neighbor AP list order), and compare BSSID's */
+	for ( i = pScanMngr->neighborHashHead[ band ][ SCAN_MNGR_BSSID_HASH( *bssId ) ]; -1 != i; i = pScanMngr->neighborHashNext[ band ][ (TI_UINT8)i ] ) {
+		if (MAC_EQUAL (*bssId, pScanMngr->neighborAPsDiscoveryList[ band ].APListPtr[ (TI_UINT8)i ].BSSID)) {
 			return i;
 		}
 	}
@@ -2698,9 +2959,9 @@ void scanMngrDebugPrintBSSList( TI_HANDLE hScanMngr )
 	}
 	limit = pScanMngr->BSSList.numOfEntries;
 	/* It looks like it never happens. Anyway decided to check */
-	if (pScanMngr->BSSList.numOfEntries > MAX_SIZE_OF_BSS_TRACK_LIST) {
+	if (pScanMngr->BSSList.numOfEntries > SCAN_MNGR_TRACK_LIST_SIZE) {
 		handleRunProblem(PROBLEM_BUF_SIZE_VIOLATION);
-		limit = MAX_SIZE_OF_BSS_TRACK_LIST;
+		limit = SCAN_MNGR_TRACK_LIST_SIZE;
 	}
 
 	WLAN_OS_REPORT(("-------------------------------- BSS List--------------------------------\n"));
@@ -2786,7 +3047,7 @@ TI_HANDLE scanMngr_create( TI_HANDLE hOS )
 	pScanMngr->hOS = hOS;
 
 	/* allocate frame storage space for BSS list */
-	for (i = 0; i < MAX_SIZE_OF_BSS_TRACK_LIST; i++) {
+	for (i = 0; i < SCAN_MNGR_TRACK_LIST_SIZE; i++) {
 		pScanMngr->BSSList.BSSList[i].pBuffer = os_memoryAlloc (hOS, MAX_BEACON_BODY_LENGTH);
 		if (pScanMngr->BSSList.BSSList[i].pBuffer == NULL) {
 			WLAN_OS_REPORT( ("scanMngr_create: Failed allocating scan result buffer for index %d.\n", i));
@@ -2833,6 +3094,7 @@ void scanMngr_init (TStadHandlesList *pStadHandles)
 
 	/* initialize the BSS list to empty list */
 	pScanMngr->BSSList.numOfEntries = 0;
+	scanMngrTrackHashReset( pScanMngr );
 
 	/* mark no continuous and immediate scans are currently running */
 	pScanMngr->contScanState = SCAN_CSS_IDLE;
@@ -2846,6 +3108,7 @@ void scanMngr_init (TStadHandlesList *pStadHandles)
 	/* mark no neighbor APs */
 	pScanMngr->neighborAPsDiscoveryList[ RADIO_BAND_2_4_GHZ ].numOfEntries = 0;
 	pScanMngr->neighborAPsDiscoveryList[ RADIO_BAND_5_0_GHZ ].numOfEntries = 0;
+	scanMngrNeighborHashReset( pScanMngr );
 
 	/* mark no discovery process */
 	pScanMngr->currentDiscoveryPart = SCAN_SDP_NO_DISCOVERY;
@@ -3053,6 +3316,7 @@ void scanMngr_startContScan( TI_HANDLE hScanMngr, TMacAddr* currentBSS, ERadioBa
 
 	/* clear the BSS tracking list */
 	pScanMngr->BSSList.numOfEntries = 0;
+	scanMngrTrackHashReset( pScanMngr );
 
 	/* start timer (if timeout is configured) */
 	if ( ((ROAMING_QUALITY_NORMAL == pScanMngr->eQuality) && (0 < pScanMngr->scanPolicy.normalScanInterval)) ||
@@ -3116,6 +3380,7 @@ void scanMngr_stopContScan( TI_HANDLE hScanMngr )
 	/* clear current neighbor APs */
 	pScanMngr->neighborAPsDiscoveryList[ RADIO_BAND_2_4_GHZ ].numOfEntries = 0;
 	pScanMngr->neighborAPsDiscoveryList[ RADIO_BAND_5_0_GHZ ].numOfEntries = 0;
+	scanMngrNeighborHashReset( pScanMngr );
 
 	/* clear current BSS field .This is for the case that scanMngr_setNeighborAPs() is called before scanMngr_startcontScan() */
 	for ( i = 0; i < MAC_ADDR_LEN; i++ ) {
@@ -3128,28 +3393,25 @@ bssList_t* scanMngr_getBSSList( TI_HANDLE hScanMngr )
 {
 	scanMngr_t* pScanMngr = (scanMngr_t*)hScanMngr;
 	TI_UINT8 BSSIndex;
-	paramInfo_t param;
+	channelCapabilityRet_t channelCapability;
 
 
 	/* It looks like it never happens. Anyway decided to check */
-	if (pScanMngr->BSSList.numOfEntries > MAX_SIZE_OF_BSS_TRACK_LIST) {
+	if (pScanMngr->BSSList.numOfEntries > SCAN_MNGR_TRACK_LIST_SIZE) {
 		handleRunProblem(PROBLEM_BUF_SIZE_VIOLATION);
 		/* Returning here a NULL pointer can cause problems because the calling procedures
 		 use the returned pointer without checking it for correctness. */
-		pScanMngr->BSSList.numOfEntries = MAX_SIZE_OF_BSS_TRACK_LIST;
+		pScanMngr->BSSList.numOfEntries = SCAN_MNGR_TRACK_LIST_SIZE;
 	}
 	/* loop on all BSS'es */
 	for ( BSSIndex = 0; BSSIndex < pScanMngr->BSSList.numOfEntries; ) {
 		/* verify channel validity with the reg domain - for active scan!
 		   (because connection will be attempted on the channel... */
-		param.paramType = REGULATORY_DOMAIN_GET_SCAN_CAPABILITIES;
-		param.content.channelCapabilityReq.band = pScanMngr->BSSList.BSSList[ BSSIndex ].band;
-		param.content.channelCapabilityReq.scanOption = ACTIVE_SCANNING;
-		param.content.channelCapabilityReq.channelNum = pScanMngr->BSSList.BSSList[ BSSIndex ].channel;
-		regulatoryDomain_getParam( pScanMngr->hRegulatoryDomain, &param );
+		regulatoryDomain_GetChannelCapability( pScanMngr->hRegulatoryDomain, pScanMngr->BSSList.BSSList[ BSSIndex ].band, pScanMngr->BSSList.BSSList[ BSSIndex ].channel,
+		                                       ACTIVE_SCANNING, &channelCapability );
 
 		/* if channel is not valid */
-		if ( !param.content.channelCapabilityRet.channelValidity ) {
+		if ( !channelCapability.channelValidity ) {
 			/* will replace this entry with one further down the array, if any. Therefore, index is not increased
 			   (because a new entry will be placed in the same index). If this is the last entry - the number of
 			   BSSes will be decreased, and thus the loop will exit */
@@ -3160,13 +3422,14 @@ bssList_t* scanMngr_getBSSList( TI_HANDLE hScanMngr )
 	}
 
 	/* return the BSS list */
-	return (bssList_t*)&(pScanMngr->BSSList);
+	return scanMngrExportBSSList( pScanMngr );
 }
 
 void scanMngr_setNeighborAPs( TI_HANDLE hScanMngr, neighborAPList_t* neighborAPList )
 {
 	scanMngr_t* pScanMngr = (scanMngr_t*)hScanMngr;
 	int neighborAPIndex, currentBSSNeighborIndex;
+	ERadioBand band;
 
 #ifdef TI_DBG
 	scanMngrTracePrintNeighborAPsList( hScanMngr, neighborAPList );
@@ -3184,6 +3447,7 @@ void scanMngr_setNeighborAPs( TI_HANDLE hScanMngr, neighborAPList_t* neighborAPL
 	/* clear current neighbor APs */
 	pScanMngr->neighborAPsDiscoveryList[ RADIO_BAND_2_4_GHZ ].numOfEntries = 0;
 	pScanMngr->neighborAPsDiscoveryList[ RADIO_BAND_5_0_GHZ ].numOfEntries = 0;
+	scanMngrNeighborHashReset( pScanMngr );
 
 	/* copy new neighbor APs, according to band */
 	for ( neighborAPIndex = 0; neighborAPIndex < neighborAPList->numOfEntries; neighborAPIndex++ ) {
@@ -3210,6 +3474,11 @@ void scanMngr_setNeighborAPs( TI_HANDLE hScanMngr, neighborAPList_t* neighborAPL
 			    SCAN_NDS_NOT_DISCOVERED;
 		}
 
+		/* add it to the band BSSID hash index */
+		band = neighborAPList->APListPtr[ neighborAPIndex ].band;
+		scanMngrHashLink( &(pScanMngr->neighborHashHead[ band ][ SCAN_MNGR_BSSID_HASH( neighborAPList->APListPtr[ neighborAPIndex ].BSSID ) ]),
+		                  pScanMngr->neighborHashNext[ band ], pScanMngr->neighborAPsDiscoveryList[ band ].numOfEntries );
+
 		/* increase neighbor AP count */
 		pScanMngr->neighborAPsDiscoveryList[ neighborAPList->APListPtr[ neighborAPIndex ].band  ].numOfEntries++;
 	}
@@ -3334,7 +3603,7 @@ void scanMngr_handoverDone( TI_HANDLE hScanMngr, TMacAddr* macAddress, ERadioBan
 
 	/* if the new AP is in the track list */
 	i = scanMngrGetTrackIndexByBssid( hScanMngr, macAddress );
-	if (( i != -1 ) && ( i < MAX_SIZE_OF_BSS_TRACK_LIST)) {
+	if (( i != -1 ) && ( i < SCAN_MNGR_TRACK_LIST_SIZE)) {
 		/* remove it */
 		scanMngrRemoveBSSListEntry( hScanMngr, i );
 	}
@@ -4047,4 +4316,403 @@ void scanMngrDebugPrintObject( TI_HANDLE hScanMngr )
 	                pScanMngr->hReport, pScanMngr->hRoamingMngr, pScanMngr->hScanCncn));
 }
 
+/**
+ * \\n
+ * \brief Add SPS channels to scan command on the object workspace, using a sorted list.\n
+ *
+ * The original SPS planner, used as a reference for scanMngrDebugCheckSPSPlanner.\n
+ * Function Scope \e Private.\n
+ * \param hScanMngr - handle to the scan manager object.\n
+ * \param scanMethod - The scan method (and parameters) to use.\n
+ * \param band - the band to scan.\n
+ */
+static void scanMngrDebugAddSPSChannelsReference( TI_HANDLE hScanMngr, TScanMethod* scanMethod, ERadioBand band )
+{
+	scanMngr_t* pScanMngr = (scanMngr_t*)hScanMngr;
+	TI_UINT64 EarliestTSFToInsert;
+	TI_UINT32 timeToStartInAdvance = scanMethod->method.spsMethodParams.scanDuration /
+	                                 SCAN_SPS_DURATION_PART_IN_ADVANCE;
+	scan_SPSHelper_t nextEventArray[ SCAN_MNGR_TRACK_LIST_SIZE ];
+	int BSSListIndex, i, j, nextEventArrayHead, nextEventArraySize;
+	channelCapabilityRet_t channelCapability;
+
+	/* initialize latest TSF value */
+	pScanMngr->scanParams.latestTSFValue = 0;
+
+	/* initialize the next event arry */
+	nextEventArrayHead = -1;
+	nextEventArraySize = 0;
+
+	/* It looks like it never happens. Anyway decided to check */
+	if ( pScanMngr->BSSList.numOfEntries > SCAN_MNGR_TRACK_LIST_SIZE ) {
+		handleRunProblem(PROBLEM_BUF_SIZE_VIOLATION);
+		return;
+	}
+	/* insert channels from tracking list to next event array according to requested band */
+	for ( BSSListIndex = 0; BSSListIndex < pScanMngr->BSSList.numOfEntries; BSSListIndex++ ) {
+		/* if BSS is on the right band */
+		if ( band == pScanMngr->BSSList.BSSList[ BSSListIndex ].band ) {
+			/* verify the channel with the reg domain */
+			regulatoryDomain_GetChannelCapability( pScanMngr->hRegulatoryDomain, band, pScanMngr->BSSList.BSSList[ BSSListIndex ].channel,
+			                                       PASSIVE_SCANNING, &channelCapability );
+
+			/* if channel is verified for requested scan type */
+			if ( channelCapability.channelValidity ) {
+				/* if this AP local TSF value is greater that latest TSF value, change it */
+				if ( pScanMngr->BSSList.scanBSSList[ BSSListIndex ].localTSF > pScanMngr->scanParams.latestTSFValue ) {
+					/* the latest TSF value is used by the FW to detect TSF error (an AP recovery). When a TSF
+					   error occurs, the latest TSF value should be in the future (because the AP TSF was
+					   reset). */
+					pScanMngr->scanParams.latestTSFValue = pScanMngr->BSSList.scanBSSList[ BSSListIndex ].localTSF;
+				}
+
+				/* calculate the TSF of the next event for tracked AP. Scan should start
+				   SCAN_SPS_DURATION_PART_IN_ADVANCE before the calculated event */
+				nextEventArray[ nextEventArraySize ].nextEventTSF =
+				    scanMngrCalculateNextEventTSF( hScanMngr, &(pScanMngr->BSSList), BSSListIndex,
+				                                   pScanMngr->currentTSF + SCAN_SPS_GUARD_FROM_CURRENT_TSF +
+				                                   timeToStartInAdvance ) - timeToStartInAdvance;
+				nextEventArray[ nextEventArraySize ].trackListIndex = BSSListIndex;
+
+				/* insert it, sorted, to the next event array */
+				/* if need to insert as head (either because list is empty or because it has earliest TSF) */
+				if ( (-1 == nextEventArrayHead) ||
+				        (nextEventArray[ nextEventArraySize ].nextEventTSF < nextEventArray[ nextEventArrayHead ].nextEventTSF)) {
+					/* link the newly inserted AP to the current head */
+					nextEventArray[ nextEventArraySize ].nextAPIndex = nextEventArrayHead;
+					/* make current head point to newly inserted AP */
+					nextEventArrayHead = nextEventArraySize;
+					nextEventArraySize++;
+				}
+				/* insert into the list */
+				else {
+					/* start with list head */
+					i = nextEventArrayHead;
+					/* while the new AP TSF is larger and list end had not been reached */
+					while ( (nextEventArray[ i ].nextAPIndex != -1) && /* list end had not been reached */
+					        (nextEventArray[ nextEventArray[ i ].nextAPIndex ].nextEventTSF < nextEventArray[ nextEventArraySize ].nextEventTSF)) { /* next event TSF of the next AP in the list is smaller than that of the AP being inserted */
+						/* proceed to the next AP */
+						i = nextEventArray[ i ].nextAPIndex;
+					}
+					/* insert this AP to the list, right after the next event entry found */
+					nextEventArray[ nextEventArraySize ].nextAPIndex = nextEventArray[ i ].nextAPIndex;
+					nextEventArray[ i ].nextAPIndex = nextEventArraySize;
+					nextEventArraySize++;
+				}
+			}
+			/* if for some reason a channel on which an AP was found is not valid for passive scan,
+			   the AP should be removed. */
+			else {
+				/* removing the AP is done by increasing its track count to maximum - and since it is
+				   not tracked it will not be discovered, and thus will be deleted when the scan is complete */
+				pScanMngr->BSSList.scanBSSList[ BSSListIndex ].trackFailCount =
+				    pScanMngr->scanPolicy.maxTrackFailures + 1;
+#ifdef TI_DBG
+				/*update statistics */
+				pScanMngr->stats.APsRemovedInvalidChannel++;
+#endif
+			}
+		}
+	}
+
+	/* insert channels from next event array to scan command */
+	EarliestTSFToInsert = pScanMngr->currentTSF + SCAN_SPS_GUARD_FROM_CURRENT_TSF;
+	/* insert all APs to scan command (as long as command is not full) */
+	while ( (nextEventArraySize > 0) &&
+	        (pScanMngr->scanParams.numOfChannels < SCAN_MAX_NUM_OF_SPS_CHANNELS_PER_COMMAND)) {
+		/* if first list entry fits, and it doesn't collide with current AP DTIM */
+		if ( EarliestTSFToInsert < nextEventArray[ nextEventArrayHead ].nextEventTSF ) {
+			if ( TI_FALSE == scanMngrDTIMInRange( hScanMngr, nextEventArray[ nextEventArrayHead ].nextEventTSF,
+			                                      nextEventArray[ nextEventArrayHead ].nextEventTSF + scanMethod->method.spsMethodParams.scanDuration )) {
+				/* insert it to scan command */
+				pScanMngr->scanParams.channelEntry[ pScanMngr->scanParams.numOfChannels ].SPSChannelEntry.scanStartTime =
+				    INT64_LOWER( (nextEventArray[ nextEventArrayHead ].nextEventTSF));
+				pScanMngr->scanParams.channelEntry[ pScanMngr->scanParams.numOfChannels ].SPSChannelEntry.scanDuration =
+				    scanMethod->method.spsMethodParams.scanDuration;
+				pScanMngr->scanParams.channelEntry[ pScanMngr->scanParams.numOfChannels ].SPSChannelEntry.ETMaxNumOfAPframes =
+				    scanMethod->method.spsMethodParams.ETMaxNumberOfApFrames;
+				pScanMngr->scanParams.channelEntry[ pScanMngr->scanParams.numOfChannels ].SPSChannelEntry.earlyTerminationEvent =
+				    scanMethod->method.spsMethodParams.earlyTerminationEvent;
+				pScanMngr->scanParams.channelEntry[ pScanMngr->scanParams.numOfChannels ].SPSChannelEntry.channel =
+				    pScanMngr->BSSList.BSSList[ nextEventArray[ nextEventArrayHead ].trackListIndex ].channel;
+				MAC_COPY (pScanMngr->scanParams.channelEntry[ pScanMngr->scanParams.numOfChannels ].SPSChannelEntry.bssId,
+				          pScanMngr->BSSList.BSSList[ nextEventArray[ nextEventArrayHead ].trackListIndex ].BSSID);
+				/* increase the AP track attempts counter */
+				pScanMngr->BSSList.scanBSSList[ nextEventArray[ nextEventArrayHead ].trackListIndex ].trackFailCount++;
+				/* increase number of channels in scan command */
+				pScanMngr->scanParams.numOfChannels++;
+				/* set earliest TSF that would fit in scan command */
+				EarliestTSFToInsert = nextEventArray[ nextEventArrayHead ].nextEventTSF +
+				                      scanMethod->method.spsMethodParams.scanDuration +
+				                      SCAN_SPS_GUARD_FROM_LAST_BSS;
+				/* remove it from next event array */
+				nextEventArrayHead = nextEventArray[ nextEventArrayHead ].nextAPIndex;
+				nextEventArraySize--;
+			} else {
+				TI_UINT32 beaconIntervalUsec =
+				    pScanMngr->BSSList.BSSList[ nextEventArray[ nextEventArrayHead ].trackListIndex ].beaconInterval * 1024;
+
+				/* if the next beacon also collide with DTIM */
+				if ( TI_TRUE == scanMngrDTIMInRange( hScanMngr, nextEventArray[ nextEventArrayHead ].nextEventTSF + beaconIntervalUsec,
+				                                     nextEventArray[ nextEventArrayHead ].nextEventTSF + scanMethod->method.spsMethodParams.scanDuration + beaconIntervalUsec )) {
+					/* An AP whose two consecutive beacons collide with current AP DTIM is not trackable by SPS!!!
+					   Shouldn't happen at a normal setup, but checked to avoid endless loop.
+					   First, remove it from the tracking list (by increasing it's track count above the maximum) */
+					pScanMngr->BSSList.scanBSSList[ nextEventArray[ nextEventArrayHead ].trackListIndex ].trackFailCount =
+					    pScanMngr->scanPolicy.maxTrackFailures + 1;
+
+					/* and also remove it from the SPS list */
+					nextEventArrayHead = nextEventArray[ nextEventArrayHead ].nextAPIndex;
+					nextEventArraySize--;
+
+#ifdef TI_DBG
+					/* update statistics */
+					pScanMngr->stats.APsRemovedDTIMOverlap++;
+#endif
+				} else {
+					/* calculate next event TSF - will get the next beacon, since timeToStartInAdvance is added to current beacon TSF */
+					nextEventArray[ nextEventArrayHead ].nextEventTSF =
+					    scanMngrCalculateNextEventTSF( hScanMngr, &(pScanMngr->BSSList),
+					                                   nextEventArray[ nextEventArrayHead ].trackListIndex,
+					                                   nextEventArray[ nextEventArrayHead ].nextEventTSF + timeToStartInAdvance + 1)
+					    - timeToStartInAdvance;
+
+					/* reinsert to the next event array, sorted */
+					/* if still needs to be head, do nothing (because it's still head). otherwise: */
+					if ( (1 < nextEventArraySize) && /* list has more than one entry */
+					        (nextEventArray[ nextEventArrayHead ].nextEventTSF > nextEventArray[ nextEventArray[ nextEventArrayHead ].nextAPIndex ].nextEventTSF)) { /* first event in list is earlier */
+						/* first remove the head from the list */
+						j = nextEventArrayHead;
+						nextEventArrayHead = nextEventArray[ nextEventArrayHead ].nextAPIndex;
+
+						/* start with list head */
+						i = nextEventArrayHead;
+						/* while the new AP TSF is larger and list end had not been reached */
+						while ( (nextEventArray[ i ].nextAPIndex != -1) && /* list end had not been reached */
+						        (nextEventArray[ nextEventArray[ i ].nextAPIndex ].nextEventTSF < nextEventArray[ j ].nextEventTSF)) { /* next event TSF of the next AP in the list is smaller than that of the AP being inserted */
+							/* proceed to the next AP */
+							i = nextEventArray[ i ].nextAPIndex;
+						}
+						/* insert this AP to the list, right after the next event entry found */
+						nextEventArray[ j ].nextAPIndex = nextEventArray[ i ].nextAPIndex;
+						nextEventArray[ i ].nextAPIndex = j;
+					}
+
+#ifdef TI_DBG
+					/* update statistics */
+					pScanMngr->stats.SPSSavedByDTIMCheck++;
+#endif
+				}
+			}
+		} else {
+			/* calculate next event TSF */
+			nextEventArray[ nextEventArrayHead ].nextEventTSF =
+			    scanMngrCalculateNextEventTSF( hScanMngr, &(pScanMngr->BSSList),
+			                                   nextEventArray[ nextEventArrayHead ].trackListIndex,
+			                                   EarliestTSFToInsert + timeToStartInAdvance ) - timeToStartInAdvance;
+
+			/* reinsert to the next event array, sorted */
+			/* if still needs to be head, do nothing (because it's still head). otherwise: */
+			if ( (1 < nextEventArraySize) && /* list has more than one entry */
+			        (nextEventArray[ nextEventArrayHead ].nextEventTSF > nextEventArray[ nextEventArray[ nextEventArrayHead ].nextAPIndex ].nextEventTSF)) { /* first event in list is earlier */
+				/* first remove the head from the list */
+				j = nextEventArrayHead;
+				nextEventArrayHead = nextEventArray[ nextEventArrayHead ].nextAPIndex;
+
+				/* start with list head */
+				i = nextEventArrayHead;
+				/* while the new AP TSF is larger and list end had not been reached */
+				while ( (nextEventArray[ i ].nextAPIndex != -1) && /* list end had not been reached */
+				        (nextEventArray[ nextEventArray[ i ].nextAPIndex ].nextEventTSF < nextEventArray[ j ].nextEventTSF)) { /* next event TSF of the next AP in the list is smaller than that of the AP being inserted */
+					/* proceed to the next AP */
+					i = nextEventArray[ i ].nextAPIndex;
+				}
+				/* insert this AP to the list, right after the next event entry found */
+				nextEventArray[ j ].nextAPIndex = nextEventArray[ i ].nextAPIndex;
+				nextEventArray[ i ].nextAPIndex = j;
+			}
+
+		}
+	}
+	/* For SPS scan, the scan duration is added to the command, since later on current TSF cannot be
+	   reevaluated. The scan duration is TSF at end of scan minus current TSF, divided by 1000 (convert
+	   to milliseconds) plus 1 (for the division reminder). */
+	pScanMngr->scanParams.SPSScanDuration =
+	    (((TI_UINT32)(EarliestTSFToInsert - SCAN_SPS_GUARD_FROM_LAST_BSS - pScanMngr->currentTSF)) / 1000) + 1;
+}
+
+/**
+ * \\n
+ * \brief Returns the next pseudo random number for the SPS planner verification.\n
+ *
+ * Function Scope \e Private.\n
+ * \param pSeed - the generator state.\n
+ */
+static TI_UINT32 scanMngrDebugRand( TI_UINT32* pSeed )
+{
+	*pSeed = (*pSeed * 1664525) + 1013904223;
+	return (*pSeed >> 8);
+}
+
+/**
+ * \\n
+ * \brief Verify the SPS planner against the reference algorithm.\n
+ *
+ * Function Scope \e Public.\n
+ * \param hScanMngr - handle to the scan manager object.\n
+ * \param uIterations - number of random tracking lists to check (0 for 100).\n
+ */
+void scanMngrDebugCheckSPSPlanner( TI_HANDLE hScanMngr, TI_UINT32 uIterations )
+{
+	scanMngr_t* pScanMngr = (scanMngr_t*)hScanMngr;
+	scanMngr_t *pSaved, *pInput, *pReference;
+	TScanMethod scanMethod;
+	TScanSpsChannelEntry *pEntry, *pRefEntry;
+	TI_UINT32 uSeed = os_timeStampMs( pScanMngr->hOS );
+	TI_UINT32 uIter, uPass, uAdvance, uChannels = 0, uMismatches = 0;
+	TI_BOOL bMismatch;
+	int i;
+
+	if ( 0 == uIterations ) {
+		uIterations = 100;
+	}
+
+	pSaved = os_memoryAlloc( pScanMngr->hOS, sizeof(scanMngr_t));
+	pInput = os_memoryAlloc( pScanMngr->hOS, sizeof(scanMngr_t));
+	pReference = os_memoryAlloc( pScanMngr->hOS, sizeof(scanMngr_t));
+	if ( (NULL == pSaved) || (NULL == pInput) || (NULL == pReference)) {
+		WLAN_OS_REPORT(("SPS planner check: memory allocation failed\n"));
+		if ( NULL != pSaved ) {
+			os_memoryFree( pScanMngr->hOS, pSaved, sizeof(scanMngr_t));
+		}
+		if ( NULL != pInput ) {
+			os_memoryFree( pScanMngr->hOS, pInput, sizeof(scanMngr_t));
+		}
+		if ( NULL != pReference ) {
+			os_memoryFree( pScanMngr->hOS, pReference, sizeof(scanMngr_t));
+		}
+		return;
+	}
+	os_memoryCopy( pScanMngr->hOS, pSaved, pScanMngr, sizeof(scanMngr_t));
+
+	WLAN_OS_REPORT(("Checking SPS planner: %d iterations, seed %u\n", uIterations, uSeed));
+
+	for ( uIter = 0; uIter < uIterations; uIter++ ) {
+		/* current BSS timing */
+		pScanMngr->currentBSSBeaconInterval = 20 + (scanMngrDebugRand( &uSeed ) % 300);
+		pScanMngr->currentBSSDtimPeriod = 1 + (scanMngrDebugRand( &uSeed ) % 3);
+		scanMngrUpdateDTIMReciprocal( pScanMngr );
+		INT64_HIGHER( pScanMngr->currentTSF ) = scanMngrDebugRand( &uSeed ) % 16;
+		INT64_LOWER( pScanMngr->currentTSF ) = scanMngrDebugRand( &uSeed ) ^ (scanMngrDebugRand( &uSeed ) << 24);
+		pScanMngr->lastLocalBcnTSF = pScanMngr->currentTSF -
+		                             (scanMngrDebugRand( &uSeed ) % (pScanMngr->currentBSSBeaconInterval * 1024));
+		pScanMngr->lastLocalBcnDTIMCount = (TI_UINT8)(scanMngrDebugRand( &uSeed ) % pScanMngr->currentBSSDtimPeriod);
+
+		/* SPS method */
+		scanMethod.scanType = SCAN_TYPE_SPS;
+		scanMethod.method.spsMethodParams.scanDuration = 1000 + (scanMngrDebugRand( &uSeed ) % 20000);
+		scanMethod.method.spsMethodParams.ETMaxNumberOfApFrames = 1;
+		scanMethod.method.spsMethodParams.earlyTerminationEvent = SCAN_ET_COND_DISABLE;
+
+		/* tracking list - distinct beacon intervals make same TSF events (ordered differently) unlikely */
+		pScanMngr->BSSList.numOfEntries = 1 + (scanMngrDebugRand( &uSeed ) % SCAN_MNGR_TRACK_LIST_SIZE);
+		for ( i = 0; i < pScanMngr->BSSList.numOfEntries; i++ ) {
+			bssEntry_t* pBSS = &(pScanMngr->BSSList.BSSList[ i ]);
+			scan_BSSEntry_t* pScanBSS = &(pScanMngr->BSSList.scanBSSList[ i ]);
+
+			pBSS->band = RADIO_BAND_2_4_GHZ;
+			pBSS->channel = 1 + (scanMngrDebugRand( &uSeed ) % 11);
+			pBSS->BSSID[ 0 ] = 0;
+			pBSS->BSSID[ 1 ] = (TI_UINT8)uIter;
+			pBSS->BSSID[ 2 ] = (TI_UINT8)i;
+			pBSS->BSSID[ 3 ] = (TI_UINT8)scanMngrDebugRand( &uSeed );
+			pBSS->BSSID[ 4 ] = (TI_UINT8)scanMngrDebugRand( &uSeed );
+			pBSS->BSSID[ 5 ] = (TI_UINT8)scanMngrDebugRand( &uSeed );
+			pBSS->beaconInterval = 20 + (scanMngrDebugRand( &uSeed ) % 1000);
+			INT64_HIGHER( pBSS->lastRxTSF ) = scanMngrDebugRand( &uSeed ) % 16;
+			INT64_LOWER( pBSS->lastRxTSF ) = scanMngrDebugRand( &uSeed ) ^ (scanMngrDebugRand( &uSeed ) << 24);
+			pScanBSS->localTSF = pScanMngr->currentTSF - (scanMngrDebugRand( &uSeed ) % 10000000);
+			pScanBSS->trackFailCount = 0;
+			pScanBSS->bcnIntervalUsec = 0;
+#ifdef SCAN_SPS_USE_DRIFT_COMPENSATION
+			pScanBSS->prevTSFDelta = 0;
+			pScanBSS->deltaChangeArrayIndex = 0;
+			os_memoryZero( pScanMngr->hOS, pScanBSS->deltaChangeArray, sizeof(pScanBSS->deltaChangeArray));
+#endif
+		}
+
+		/* the second pass uses the TBTT anchors and drift history of the first */
+		for ( uPass = 0; uPass < 2; uPass++ ) {
+			if ( 1 == uPass ) {
+				uAdvance = 1 + (scanMngrDebugRand( &uSeed ) % 5000000);
+				pScanMngr->currentTSF += uAdvance;
+				pScanMngr->lastLocalBcnTSF += uAdvance;
+				for ( i = 0; i < pScanMngr->BSSList.numOfEntries; i++ ) {
+					pScanMngr->BSSList.scanBSSList[ i ].trackFailCount = 0;
+				}
+			}
+			pScanMngr->scanParams.numOfChannels = 0;
+			os_memoryCopy( pScanMngr->hOS, pInput, pScanMngr, sizeof(scanMngr_t));
+
+			/* reference planner */
+			pScanMngr->bSPSReferenceCalc = TI_TRUE;
+			pScanMngr->currentBSSDtimPeriodUsec = 0;
+			scanMngrDebugAddSPSChannelsReference( hScanMngr, &scanMethod, RADIO_BAND_2_4_GHZ );
+			os_memoryCopy( pScanMngr->hOS, pReference, pScanMngr, sizeof(scanMngr_t));
+
+			/* heap planner */
+			os_memoryCopy( pScanMngr->hOS, pScanMngr, pInput, sizeof(scanMngr_t));
+			scanMngrAddSPSChannels( hScanMngr, &scanMethod, RADIO_BAND_2_4_GHZ );
+
+			bMismatch = TI_FALSE;
+			if ( (pScanMngr->scanParams.numOfChannels != pReference->scanParams.numOfChannels) ||
+			        (pScanMngr->scanParams.SPSScanDuration != pReference->scanParams.SPSScanDuration) ||
+			        (pScanMngr->scanParams.latestTSFValue != pReference->scanParams.latestTSFValue) ||
+			        (pScanMngr->stats.SPSSavedByDTIMCheck != pReference->stats.SPSSavedByDTIMCheck) ||
+			        (pScanMngr->stats.APsRemovedDTIMOverlap != pReference->stats.APsRemovedDTIMOverlap) ||
+			        (pScanMngr->stats.APsRemovedInvalidChannel != pReference->stats.APsRemovedInvalidChannel)) {
+				bMismatch = TI_TRUE;
+			}
+			for ( i = 0; (TI_FALSE == bMismatch) && (i < pScanMngr->scanParams.numOfChannels); i++ ) {
+				pEntry = &(pScanMngr->scanParams.channelEntry[ i ].SPSChannelEntry);
+				pRefEntry = &(pReference->scanParams.channelEntry[ i ].SPSChannelEntry);
+				if ( (pEntry->scanStartTime != pRefEntry->scanStartTime) ||
+				        (pEntry->scanDuration != pRefEntry->scanDuration) ||
+				        (pEntry->channel != pRefEntry->channel) ||
+				        !MAC_EQUAL( pEntry->bssId, pRefEntry->bssId )) {
+					bMismatch = TI_TRUE;
+				}
+			}
+			for ( i = 0; (TI_FALSE == bMismatch) && (i < pScanMngr->BSSList.numOfEntries); i++ ) {
+				if ( pScanMngr->BSSList.scanBSSList[ i ].trackFailCount != pReference->BSSList.scanBSSList[ i ].trackFailCount ) {
+					bMismatch = TI_TRUE;
+				}
+			}
+
+			uChannels += pScanMngr->scanParams.numOfChannels;
+			if ( TI_TRUE == bMismatch ) {
+				if ( uMismatches < 5 ) {
+					WLAN_OS_REPORT(("Mismatch: iteration %d, pass %d, %d APs: %d channels (reference %d), duration %d (reference %d)\n",
+					                uIter, uPass, pScanMngr->BSSList.numOfEntries,
+					                pScanMngr->scanParams.numOfChannels, pReference->scanParams.numOfChannels,
+					                pScanMngr->scanParams.SPSScanDuration, pReference->scanParams.SPSScanDuration));
+					scanMngrDebugPrintScanCommand( &(pScanMngr->scanParams));
+					scanMngrDebugPrintScanCommand( &(pReference->scanParams));
+				}
+				uMismatches++;
+			}
+		}
+	}
+
+	/* restore the scan manager state */
+	os_memoryCopy( pScanMngr->hOS, pScanMngr, pSaved, sizeof(scanMngr_t));
+
+	os_memoryFree( pScanMngr->hOS, pReference, sizeof(scanMngr_t));
+	os_memoryFree( pScanMngr->hOS, pInput, sizeof(scanMngr_t));
+	os_memoryFree( pScanMngr->hOS, pSaved, sizeof(scanMngr_t));
+
+	WLAN_OS_REPORT(("SPS planner check: %d commands, %d SPS channels, %d mismatches\n",
+	                uIterations * 2, uChannels, uMismatches));
+}
+
 #endif /* TI_DBG */
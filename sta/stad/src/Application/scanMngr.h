@@ -70,6 +70,21 @@
 #define MAX_DESC_LENGTH                         50 /* max characters for a description string */
 #define SCAN_MNGR_STAT_MAX_TRACK_FAILURE        10 /* max track filures for statistics histogram */
 
+/* BSSID hash index over the track and neighbor AP lists */
+#define SCAN_MNGR_BSSID_HASH_SIZE               64 /* number of hash buckets, must be a power of 2 */
+#define SCAN_MNGR_BSSID_HASH( bssId )           \
+    ((((TI_UINT8*)(bssId))[ 3 ] ^ (((TI_UINT8*)(bssId))[ 4 ] << 1) ^ (((TI_UINT8*)(bssId))[ 5 ] << 2)) & \
+     (SCAN_MNGR_BSSID_HASH_SIZE - 1))
+
+/* Number of BSSes tracked internally - may be set by the build (BSS_TRACK_LIST_SIZE).
+   Only the strongest MAX_SIZE_OF_BSS_TRACK_LIST of them are exported in bssList_t */
+#ifndef SCAN_MNGR_TRACK_LIST_SIZE
+#define SCAN_MNGR_TRACK_LIST_SIZE               MAX_SIZE_OF_BSS_TRACK_LIST
+#endif
+#if (SCAN_MNGR_TRACK_LIST_SIZE < 1) || (SCAN_MNGR_TRACK_LIST_SIZE > 127)
+#error "SCAN_MNGR_TRACK_LIST_SIZE must be 1..127 (track list indexes are TI_INT8)"
+#endif
+
 #ifdef TI_DBG
 /*#define SCAN_MNGR_DBG 1
 #define SCAN_MNGR_SPS_DBG 1
@@ -164,6 +179,15 @@ typedef struct {
                                                              * the TSF of the AP the station is connected to at the
                                                              * reception of the last frame from this AP
                                                              */
+	TI_UINT32                   bcnIntervalUsec;                /**<
+                                                             * the beacon interval (in usec) for which the reciprocal
+                                                             * and TBTT anchor below were calculated (0 - not calculated)
+                                                             */
+	TI_UINT32                   bcnIntervalRecip;               /**< 0xFFFFFFFF / bcnIntervalUsec, for division-free reminder */
+	TI_UINT64                   remoteTBTTAnchor;               /**<
+                                                             * a remote TSF value of a beacon transmission (a whole
+                                                             * number of beacon intervals), advanced on each calculation
+                                                             */
 #ifdef SCAN_SPS_USE_DRIFT_COMPENSATION
 	TI_INT64               prevTSFDelta;                                               /**< Previous TSF delta */
 	TI_INT32               deltaChangeArray[ SCAN_SPS_NUM_OF_TSF_DELTA_ENTRIES ];      /**<
@@ -183,8 +207,8 @@ typedef struct {
  */
 typedef struct {
 	TI_UINT8               numOfEntries;                                               /**< Number of entries in the list */
-	bssEntry_t          BSSList[ MAX_SIZE_OF_BSS_TRACK_LIST ];                      /**< BSS public information */
-	scan_BSSEntry_t     scanBSSList[ MAX_SIZE_OF_BSS_TRACK_LIST ];                  /**<
+	bssEntry_t          BSSList[ SCAN_MNGR_TRACK_LIST_SIZE ];                       /**< BSS public information */
+	scan_BSSEntry_t     scanBSSList[ SCAN_MNGR_TRACK_LIST_SIZE ];                   /**<
                                                                                      * BSS scan manager private
                                                                                      * information
                                                                                      */
@@ -199,7 +223,7 @@ typedef struct {
                                                                                      * transmission
                                                                                      */
 	int                             trackListIndex;                                 /**< index to BSS info in the track list */
-	int                             nextAPIndex;                                    /**< index of next AP entry */
+	int                             nextAPIndex;                                    /**< index of next AP entry (list based reference planner only) */
 } scan_SPSHelper_t;
 
 #ifdef TI_DBG
@@ -330,6 +354,16 @@ typedef struct {
 	 * List of neighbor APs and their
 	 * discovery status
 	 */
+	TI_INT8                         neighborHashHead[ RADIO_BAND_NUM_OF_BANDS ][ SCAN_MNGR_BSSID_HASH_SIZE ];
+	/**<
+	 * First neighbor AP list entry in
+	 * each BSSID hash bucket (-1 - none)
+	 */
+	TI_INT8                         neighborHashNext[ RADIO_BAND_NUM_OF_BANDS ][ MAX_NUM_OF_NEIGHBOR_APS ];
+	/**<
+	 * Next neighbor AP list entry in
+	 * the same BSSID hash bucket
+	 */
 	TI_UINT8                        neighborAPsDiscoveryIndex[ RADIO_BAND_NUM_OF_BANDS ];
 	/**<
 	 * Indexes for the neighbor APs
@@ -360,6 +394,14 @@ typedef struct {
 	ERadioBand                      currentBSSBand;                                 /**< band of current BSS */
 	TI_UINT32                       currentBSSBeaconInterval;                       /**< Beacon interval of current BSS */
 	TI_UINT32                       currentBSSDtimPeriod;                           /**< DTIM period of current BSS */
+	TI_UINT32                       currentBSSDtimPeriodUsec;                       /**<
+                                                                                     * DTIM period of current BSS in usec
+                                                                                     * (0 - not calculated)
+                                                                                     */
+	TI_UINT32                       currentBSSDtimPeriodRecip;                      /**<
+                                                                                     * 0xFFFFFFFF / currentBSSDtimPeriodUsec,
+                                                                                     * for division-free reminder
+                                                                                     */
 	TI_BOOL                         bNewBSSFound;                                   /**<
                                                                                      * Indicates whether a new BSS was
                                                                                      * found during the last discovery
@@ -372,6 +414,23 @@ typedef struct {
                                                                                      */
 	TScanParams                     scanParams;                                     /**< temporary storage for scan command */
 	scan_BSSList_t                  BSSList;                                        /**< BSS list (also used for tracking) */
+	bssList_t                       exportBSSList;                                  /**<
+                                                                                     * fixed size copy of the BSS list
+                                                                                     * handed to the roaming manager and
+                                                                                     * to user space
+                                                                                     */
+	TI_INT8                         trackHashHead[ SCAN_MNGR_BSSID_HASH_SIZE ];     /**<
+                                                                                     * first BSS list entry in each BSSID
+                                                                                     * hash bucket (-1 - none)
+                                                                                     */
+	TI_INT8                         trackHashNext[ SCAN_MNGR_TRACK_LIST_SIZE ];     /**<
+                                                                                     * next BSS list entry in the same
+                                                                                     * BSSID hash bucket
+                                                                                     */
+	scan_SPSHelper_t                SPSEventHeap[ SCAN_MNGR_TRACK_LIST_SIZE ];      /**<
+                                                                                     * min-heap of tracked APs next SPS
+                                                                                     * events, by event TSF
+                                                                                     */
 
 	scanMngr_connStatus_e           connStatus;                                /* save the connection status during manual roaming */
 	TI_UINT8                        scanningOperationalMode;                   /* 0 - manual ,  1 - auto */
@@ -385,6 +444,10 @@ typedef struct {
                                                                                      * For statistics: the band on which
                                                                                      * discovery was last performed.
                                                                                      */
+	TI_BOOL                         bSPSReferenceCalc;                              /**<
+                                                                                     * For SPS planner verification: use
+                                                                                     * the reference (reminder64) calculations
+                                                                                     */
 #endif
 
 } scanMngr_t;
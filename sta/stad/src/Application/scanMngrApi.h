@@ -407,6 +407,21 @@ void scanMngrDebugPrintNeighborAPList( TI_HANDLE hScanMngr );
  * \sa
  */
 void scanMngrDebugPrintObject( TI_HANDLE hScanMngr );
+/**
+ * \brief  Verify the SPS planner against the reference algorithm
+ *
+ * \param hScanMngr - handle to the scan manager object.\n
+ * \param uIterations - number of random tracking lists to check (0 for 100).\n
+ * \return void
+ *
+ * \par Description
+ * Builds SPS scan commands for random tracking lists and current BSS timing with both the heap based
+ * planner and the reference list based planner (using reminder64), and reports any difference.
+ * The scan manager state is restored when done.
+ *
+ * \sa
+ */
+void scanMngrDebugCheckSPSPlanner( TI_HANDLE hScanMngr, TI_UINT32 uIterations );
 
 
 
@@ -214,6 +214,7 @@ typedef struct _apConn_t {
 	TI_HANDLE               hAssoc;
 	TI_HANDLE               hRegulatoryDomain;
 	TI_HANDLE               hMlme;
+	TI_HANDLE               hPowerMgr;
 
 	/* Counters for statistics */
 	TI_UINT32               roamingTriggerEvents[MAX_ROAMING_TRIGGERS];
@@ -476,6 +477,7 @@ void apConn_init (TStadHandlesList *pStadHandles)
 	pAPConnection->hAssoc       = pStadHandles->hAssoc;
 	pAPConnection->hMlme        = pStadHandles->hMlmeSm;
 	pAPConnection->hRegulatoryDomain = pStadHandles->hRegulatoryDomain;
+	pAPConnection->hPowerMgr    = pStadHandles->hPowerMgr;
 
 	pAPConnection->currentState = AP_CONNECT_STATE_IDLE;
 	pAPConnection->firstAttempt2Roam = TI_TRUE;
@@ -1165,6 +1167,9 @@ TI_STATUS apConn_reportRoamingEvent(TI_HANDLE hAPConnection,
 			pAPConnection->APDisconnect.uStatusCode     = pRoamingEventData->APDisconnect.uStatusCode;
 			pAPConnection->APDisconnect.bDeAuthenticate = pRoamingEventData->APDisconnect.bDeAuthenticate;
 			reasonCode = pRoamingEventData->APDisconnect.uStatusCode;
+
+			/* let the keep-alive learn the AP inactivity timeout */
+			PowerMgr_ReportApDisconnect (pAPConnection->hPowerMgr, reasonCode);
 		}
 		if ((pAPConnection->ignoreDeauthReason0) && (pRoamingEventData!=NULL) &&
 		        (pAPConnection->APDisconnect.uStatusCode == 0)) {   /* This is required for Rogue AP test,
@@ -91,6 +91,15 @@ TI_HANDLE sme_Create (TI_HANDLE hOS)
 		return NULL;
 	}
 
+	/* Allocate the select candidate heap */
+	pSme->pCandHeap = (TSiteEntry **)os_memoryAlloc (hOS, sizeof (TSiteEntry *) * SME_SELECT_CAND_HEAP_SIZE);
+	if (NULL == pSme->pCandHeap) {
+		WLAN_OS_REPORT (("sme_Create: unable to allocate candidate heap. SME creation failed\n"));
+		sme_Destroy ((TI_HANDLE)pSme);
+		return NULL;
+	}
+	pSme->uCandHeapCapacity = SME_SELECT_CAND_HEAP_SIZE;
+
 	return (TI_HANDLE)pSme;
 }
 
@@ -225,6 +234,11 @@ void sme_Destroy (TI_HANDLE hSme)
 		scanResultTable_Destroy (pSme->hSmeScanResultTable);
 	}
 
+	/* free the select candidate heap */
+	if (NULL != pSme->pCandHeap) {
+		os_memoryFree (pSme->hOS, pSme->pCandHeap, sizeof (TSiteEntry *) * pSme->uCandHeapCapacity);
+	}
+
 	/* destroy the SME generic state machine */
 	if (NULL != pSme->hSmeSm) {
 		genSM_Unload (pSme->hSmeSm);
@@ -45,6 +45,10 @@
 #include "TWDriver.h"
 #include "sme.h"
 #include "scanResultTable.h"
+#include "ScanCncn.h"
+
+/* candidate heap size - the larger of the SME and application scan result tables */
+#define SME_SELECT_CAND_HEAP_SIZE   SCAN_CNCN_APP_SCAN_TABLE_ENTRIES
 
 typedef struct {
 	mgmtStatus_e    eMgmtStatus;     /* Contains the last DisAssociation reason towards upper layer                  */
@@ -94,9 +98,23 @@ typedef struct {
 	TSmeInitParams  tInitParams;
 	TPeriodicScanParams	tScanParams; /* temporary storage for scan command */
 
+	/* cached candidate selection (see sme_Select) */
+	TI_UINT32       uSelectProfileGen;  /* desired profile generation, keys the sites cached match verdicts */
+	TSiteEntry      **pCandHeap;        /* matching sites not yet attempted, max-heap by RSSI */
+	TI_UINT32       uCandHeapSize;      /* number of sites in the candidate heap */
+	TI_UINT32       uCandHeapCapacity;  /* number of entries allocated for the candidate heap */
+	TI_BOOL         bCandHeapValid;     /* the heap reflects hCandTable at uCandLayoutCount and uCandProfileGen */
+	TI_HANDLE       hCandTable;         /* scan result table the heap was built from */
+	TI_UINT32       uCandLayoutCount;   /* table layout count when the heap was built */
+	TI_UINT32       uCandProfileGen;    /* profile generation when the heap was built */
+
 } TSme;
 
 TSiteEntry *sme_Select (TI_HANDLE hSme);
+void        sme_SelectNewProfile (TI_HANDLE hSme);
+#ifdef TI_DBG
+void        sme_SelectBenchmark (TI_HANDLE hSme, TI_UINT32 uNumOfSites);
+#endif
 
 
 #endif /* __SME_PRIVATE_H__ */
@@ -55,6 +55,20 @@ static TI_BOOL sme_SelectBssTypeMatch (ScanBssType_e eSiteBssType, ScanBssType_e
 static TI_BOOL sme_SelectWscMatch (TI_HANDLE hSme, TSiteEntry *pCurrentSite,
                                    TI_BOOL *pbWscPbAbort, TI_BOOL *pbWscPbApFound);
 static TI_BOOL sme_SelectRsnMatch (TI_HANDLE hSme, TSiteEntry *pCurrentSite);
+static TSiteEntry *sme_SelectWalkTable (TI_HANDLE hSme, TI_BOOL *pbWscPbAbort);
+static TI_BOOL sme_SelectSiteMatch (TI_HANDLE hSme, TSiteEntry *pCurrentSite);
+static TSiteEntry *sme_SelectPopCandidate (TI_HANDLE hSme);
+static void sme_SelectBuildCandHeap (TI_HANDLE hSme);
+static void sme_SelectUpdateCandHeap (TI_HANDLE hSme);
+static void sme_SelectSiftDown (TSme *pSme, TI_UINT32 uIndex);
+static TI_UINT32 sme_SelectSiftUp (TSme *pSme, TI_UINT32 uIndex);
+
+/* minimum RSSI - a site must have a higher RSSI to be selected */
+#define SME_SELECT_MIN_RSSI     -127
+
+/* a site is a better candidate if it has a higher RSSI, or the same RSSI and an earlier table entry */
+#define SME_SELECT_IS_BETTER(pSite1, pSite2)  (((pSite1)->rssi > (pSite2)->rssi) || \
+                                               (((pSite1)->rssi == (pSite2)->rssi) && ((pSite1) < (pSite2))))
 
 /**
  * \fn     sme_Select
@@ -66,6 +80,12 @@ static TI_BOOL sme_SelectRsnMatch (TI_HANDLE hSme, TSiteEntry *pCurrentSite);
  * RSSI level from all matching sites, and connection was not attempted to it in this SME cycle
  * (since last scan was completed)
  *
+ * When WSC is off, the candidate is taken from a heap of matching sites. Sites inserted or updated
+ * in the scan result table are re-evaluated and moved in the heap one by one. The heap is only
+ * rebuilt when sites are removed from the table or the desired profile changes. Each site match
+ * verdict is cached in the site entry, so a rebuild only evaluates sites updated since the last one.
+ * When WSC is on, the whole table is checked, since PB overlap detection depends on all sites.
+ *
  * \param  hSme - handle to the SME object
  * \return A pointer to the selected site, NULL if no site macthes the selection criteria
  */
@@ -73,9 +93,7 @@ TSiteEntry *sme_Select (TI_HANDLE hSme)
 {
 	TSme            *pSme = (TSme*)hSme;
 	TSiteEntry      *pCurrentSite, *pSelectedSite = NULL;
-	TI_INT8         iSelectedSiteRssi = -127; /* minimum RSSI */
-	TI_BOOL         bWscPbAbort, pWscPbApFound = TI_FALSE;
-	int             apFoundCtr =0;
+	TI_BOOL         bWscPbAbort = TI_FALSE;
 	TIWLN_SIMPLE_CONFIG_MODE eWscMode;
 
 
@@ -101,6 +119,93 @@ TSiteEntry *sme_Select (TI_HANDLE hSme)
 
 	}
 
+	siteMgr_getParamWSC(pSme->hSiteMgr, &eWscMode);
+
+	if (TIWLN_SIMPLE_CONFIG_OFF == eWscMode) {
+		/* take the best candidate from the heap */
+		pSelectedSite = sme_SelectPopCandidate (hSme);
+	} else {
+		/* check all sites */
+		pSelectedSite = sme_SelectWalkTable (hSme, &bWscPbAbort);
+		if (TI_TRUE == bWscPbAbort) {
+			/* send event to user mode to indicate this */
+			EvHandlerSendEvent (pSme->hEvHandler, IPC_EVENT_WPS_SESSION_OVERLAP, NULL, 0);
+			/* select failed - will rescan in time */
+			return NULL;
+		}
+	}
+
+	/* if a matching site was found */
+	if (NULL != pSelectedSite) {
+		/* mark that a connection to this site was (actually is) attempted */
+		pSelectedSite->bConsideredForSelect = TI_TRUE;
+
+		/* hope this is the correct place for siteMgr_changeBandParams */
+		siteMgr_changeBandParams (pSme->hSiteMgr, pSelectedSite->eBand);
+
+		/*
+		 * Coordinate between SME module site table and Site module site Table
+		 * copy candidate AP to Site module site Table.
+		 */
+		siteMgr_CopyToPrimarySite(pSme->hSiteMgr, pSelectedSite);
+
+		/* copy the result, rather than returning a pointer to the entry in the scan result table.
+		 * This is done since the table might change durring the connection process, and the pointer
+		 * will point to the wrong entry in the table, causing connection/disconnection problems */
+		os_memoryCopy(pSme->hOS, &(pSme->tCandidate), pSelectedSite, sizeof(TSiteEntry));
+
+		return &(pSme->tCandidate);
+	}
+
+	/* return NULL if no site was selected */
+	return NULL;
+}
+
+/**
+ * \fn     sme_SelectNewProfile
+ * \brief  Invalidates the cached site match verdicts
+ *
+ * Starts a new desired profile generation, so that all sites are evaluated again on the next
+ * select. Called when a connection attempt starts, since the desired profile may have changed.
+ *
+ * \param  hSme - handle to the SME object
+ * \return None
+ * \sa     sme_Select
+ */
+void sme_SelectNewProfile (TI_HANDLE hSme)
+{
+	TSme            *pSme = (TSme*)hSme;
+
+	/* generation 0 marks a site that was not evaluated yet */
+	pSme->uSelectProfileGen++;
+	if (0 == pSme->uSelectProfileGen) {
+		pSme->uSelectProfileGen = 1;
+	}
+}
+
+/**
+ * \fn     sme_SelectWalkTable
+ * \brief  Find the best connection candidate by checking all sites in the scan result table
+ *
+ * Find the best connection candidate by checking all sites in the scan result table.
+ * Sites that don't match are marked so they are not checked again in this SME cycle.
+ *
+ * \param  hSme - handle to the SME object
+ * \param  pbWscPbAbort - set to TI_TRUE if more than one AP in WSC PB mode was found
+ * \return A pointer to the best matching site, NULL if no site matches or on WSC PB abort
+ * \sa     sme_Select
+ */
+static TSiteEntry *sme_SelectWalkTable (TI_HANDLE hSme, TI_BOOL *pbWscPbAbort)
+{
+	TSme            *pSme = (TSme*)hSme;
+	TSiteEntry      *pCurrentSite, *pSelectedSite = NULL;
+	TI_INT8         iSelectedSiteRssi = SME_SELECT_MIN_RSSI;
+	TI_BOOL         bWscPbAbort, pWscPbApFound = TI_FALSE;
+	int             apFoundCtr =0;
+	TIWLN_SIMPLE_CONFIG_MODE eWscMode;
+
+	*pbWscPbAbort = TI_FALSE;
+
 	/* get the first site from the scan result table */
 	pCurrentSite = scanResultTable_GetFirst (pSme->hScanResultTable);
 
@@ -158,9 +263,8 @@ TSiteEntry *sme_Select (TI_HANDLE hSme)
 		{
 			/* also check if abort was indicated */
 			if (TI_TRUE == bWscPbAbort) {
-				/* send event to user mode to indicate this */
-				EvHandlerSendEvent (pSme->hEvHandler, IPC_EVENT_WPS_SESSION_OVERLAP, NULL, 0);
 				/* select failed - will rescan in time */
+				*pbWscPbAbort = TI_TRUE;
 				return NULL;
 			}
 			pCurrentSite->bConsideredForSelect = TI_TRUE; /* don't try this site again */
@@ -211,36 +315,261 @@ TSiteEntry *sme_Select (TI_HANDLE hSme)
 		pCurrentSite = scanResultTable_GetNext (pSme->hScanResultTable);
 	}
 
+	return pSelectedSite;
+}
 
+/**
+ * \fn     sme_SelectSiteMatch
+ * \brief  Checks if a site matches the desired profile, when WSC is off
+ *
+ * Checks if a site matches the desired SSID, BSSID, BSS type, security settings and rates,
+ * and has no channel switch pending. The result only depends on the site data and the
+ * desired profile, so it is cached in the site entry.
+ *
+ * \param  hSme - handle to the SME object
+ * \param  pCurrentSite - the site to check
+ * \return TI_TRUE if the site matches, TI_FALSE if it doesn't
+ * \sa     sme_SelectBuildCandHeap
+ */
+static TI_BOOL sme_SelectSiteMatch (TI_HANDLE hSme, TSiteEntry *pCurrentSite)
+{
+	TSme            *pSme = (TSme*)hSme;
 
+	return ((TI_TRUE == sme_SelectSsidMatch (hSme, &(pCurrentSite->ssid), &(pSme->tSsid), pSme->eSsidType)) &&
+	        (TI_TRUE == sme_SelectBssidMatch (&(pCurrentSite->bssid), &(pSme->tBssid))) &&
+	        (TI_TRUE == sme_SelectBssTypeMatch (pCurrentSite->bssType, pSme->eBssType)) &&
+	        (TI_TRUE == sme_SelectRsnMatch (hSme, pCurrentSite)) &&
+	        (TI_TRUE == siteMgr_SelectRateMatch (pSme->hSiteMgr, pCurrentSite)) &&
+	        (TI_FALSE == pCurrentSite->bChannelSwitchAnnoncIEFound));
+}
 
+/**
+ * \fn     sme_SelectPopCandidate
+ * \brief  Retrieves the best connection candidate from the candidate heap
+ *
+ * Retrieves the best connection candidate from the candidate heap, and removes it from the heap.
+ * The heap is rebuilt first if table sites were removed or moved, or the desired profile changed
+ * since it was built. Otherwise, only the sites changed since the last selection are updated.
+ *
+ * \param  hSme - handle to the SME object
+ * \return A pointer to the best matching site, NULL if no site matches
+ * \sa     sme_Select, sme_SelectBuildCandHeap
+ */
+static TSiteEntry *sme_SelectPopCandidate (TI_HANDLE hSme)
+{
+	TSme            *pSme = (TSme*)hSme;
+	TSiteEntry      *pSite;
 
-	/* if a matching site was found */
-	if (NULL != pSelectedSite) {
-		/* mark that a connection to this site was (actually is) attempted */
-		pSelectedSite->bConsideredForSelect = TI_TRUE;
-
-		/* hope this is the correct place for siteMgr_changeBandParams */
-		siteMgr_changeBandParams (pSme->hSiteMgr, pSelectedSite->eBand);
+	if (0 == pSme->uSelectProfileGen) {
+		sme_SelectNewProfile (hSme);
+	}
 
-		/*
-		 * Coordinate between SME module site table and Site module site Table
-		 * copy candidate AP to Site module site Table.
-		 */
-		siteMgr_CopyToPrimarySite(pSme->hSiteMgr, pSelectedSite);
+	if ((TI_FALSE == pSme->bCandHeapValid) ||
+	        (pSme->hCandTable != pSme->hScanResultTable) ||
+	        (pSme->uCandLayoutCount != scanResultTable_GetLayoutCount (pSme->hScanResultTable)) ||
+	        (pSme->uCandProfileGen != pSme->uSelectProfileGen)) {
+		sme_SelectBuildCandHeap (hSme);
+	} else {
+		sme_SelectUpdateCandHeap (hSme);
+	}
 
-		/* copy the result, rather than returning a pointer to the entry in the scan result table.
-		 * This is done since the table might change durring the connection process, and the pointer
-		 * will point to the wrong entry in the table, causing connection/disconnection problems */
-		os_memoryCopy(pSme->hOS, &(pSme->tCandidate), pSelectedSite, sizeof(TSiteEntry));
+	while (pSme->uCandHeapSize > 0) {
+		/* remove the best site from the heap */
+		pSite = pSme->pCandHeap[ 0 ];
+		pSme->uCandHeapSize--;
+		if (pSme->uCandHeapSize > 0) {
+			pSme->pCandHeap[ 0 ] = pSme->pCandHeap[ pSme->uCandHeapSize ];
+			pSme->pCandHeap[ 0 ]->uCandHeapIndex = 0;
+			sme_SelectSiftDown (pSme, 0);
+		}
 
-		return &(pSme->tCandidate);
+		/* and return it, unless a connection was already attempted to it in this SME cycle */
+		if (TI_FALSE == pSite->bConsideredForSelect) {
+			return pSite;
+		}
 	}
 
-	/* return NULL if no site was selected */
 	return NULL;
 }
 
+/**
+ * \fn     sme_SelectBuildCandHeap
+ * \brief  Builds the candidate heap from the scan result table
+ *
+ * Builds a heap of all matching sites a connection was not attempted to in this SME cycle.
+ * Match verdicts cached in the current profile generation are used, other sites are evaluated
+ * and their verdict is cached. Sites that don't match are marked so they are not checked again
+ * in this SME cycle.
+ *
+ * \param  hSme - handle to the SME object
+ * \return None
+ * \sa     sme_SelectPopCandidate
+ */
+static void sme_SelectBuildCandHeap (TI_HANDLE hSme)
+{
+	TSme            *pSme = (TSme*)hSme;
+	TSiteEntry      *pCurrentSite;
+	TI_UINT32       uIndex;
+
+	pSme->uCandHeapSize = 0;
+
+	/* all sites are checked, so the changed sites need no further handling */
+	while (NULL != scanResultTable_GetDirtySite (pSme->hScanResultTable)) {}
+
+	/* check all sites */
+	pCurrentSite = scanResultTable_GetFirst (pSme->hScanResultTable);
+	while (NULL != pCurrentSite) {
+		if (TI_FALSE == pCurrentSite->bConsideredForSelect) {
+			/* evaluate the site if it was updated or the profile changed since it was last evaluated */
+			if (pCurrentSite->uSelectProfileGen != pSme->uSelectProfileGen) {
+				pCurrentSite->bSelectMatch = sme_SelectSiteMatch (hSme, pCurrentSite);
+				pCurrentSite->uSelectProfileGen = pSme->uSelectProfileGen;
+			}
+
+			if (TI_FALSE == pCurrentSite->bSelectMatch) {
+				pCurrentSite->bConsideredForSelect = TI_TRUE; /* don't try this site again */
+			}
+			/* the heap is as large as the largest scan result table */
+			else if ((pCurrentSite->rssi > SME_SELECT_MIN_RSSI) && (pSme->uCandHeapSize < pSme->uCandHeapCapacity)) {
+				pSme->pCandHeap[ pSme->uCandHeapSize ] = pCurrentSite;
+				pCurrentSite->uCandHeapIndex = pSme->uCandHeapSize;
+				pSme->uCandHeapSize++;
+			}
+		}
+
+		pCurrentSite = scanResultTable_GetNext (pSme->hScanResultTable);
+	}
+
+	/* order the heap */
+	for (uIndex = pSme->uCandHeapSize / 2; uIndex > 0; uIndex--) {
+		sme_SelectSiftDown (pSme, uIndex - 1);
+	}
+
+	pSme->bCandHeapValid = TI_TRUE;
+	pSme->hCandTable = pSme->hScanResultTable;
+	pSme->uCandLayoutCount = scanResultTable_GetLayoutCount (pSme->hScanResultTable);
+	pSme->uCandProfileGen = pSme->uSelectProfileGen;
+}
+
+/**
+ * \fn     sme_SelectUpdateCandHeap
+ * \brief  Updates the candidate heap with the sites changed since it was last updated
+ *
+ * Each site inserted or updated in the scan result table is evaluated again, and is then added to
+ * the heap, moved to its new place (its RSSI may have changed) or removed from the heap.
+ * Other sites keep their cached verdicts and heap places.
+ *
+ * \param  hSme - handle to the SME object
+ * \return None
+ * \sa     sme_SelectPopCandidate, sme_SelectBuildCandHeap
+ */
+static void sme_SelectUpdateCandHeap (TI_HANDLE hSme)
+{
+	TSme            *pSme = (TSme*)hSme;
+	TSiteEntry      *pSite, *pLastSite;
+	TI_UINT32       uIndex;
+	TI_BOOL         bInHeap;
+
+	while (NULL != (pSite = scanResultTable_GetDirtySite (pSme->hScanResultTable))) {
+		pSite->bSelectMatch = sme_SelectSiteMatch (hSme, pSite);
+		pSite->uSelectProfileGen = pSme->uSelectProfileGen;
+		if (TI_FALSE == pSite->bSelectMatch) {
+			pSite->bConsideredForSelect = TI_TRUE; /* don't try this site again */
+		}
+
+		uIndex = pSite->uCandHeapIndex;
+		bInHeap = ((uIndex < pSme->uCandHeapSize) && (pSme->pCandHeap[ uIndex ] == pSite)) ? TI_TRUE : TI_FALSE;
+
+		if ((TI_FALSE == pSite->bConsideredForSelect) && (pSite->rssi > SME_SELECT_MIN_RSSI)) {
+			if (TI_TRUE == bInHeap) {
+				/* move the site to its new place */
+				uIndex = sme_SelectSiftUp (pSme, uIndex);
+				sme_SelectSiftDown (pSme, uIndex);
+			} else if (pSme->uCandHeapSize < pSme->uCandHeapCapacity) {
+				/* add the site */
+				pSme->pCandHeap[ pSme->uCandHeapSize ] = pSite;
+				pSite->uCandHeapIndex = pSme->uCandHeapSize;
+				pSme->uCandHeapSize++;
+				sme_SelectSiftUp (pSme, pSite->uCandHeapIndex);
+			}
+		} else if (TI_TRUE == bInHeap) {
+			/* remove the site, putting the last heap entry in its place */
+			pSme->uCandHeapSize--;
+			if (uIndex < pSme->uCandHeapSize) {
+				pLastSite = pSme->pCandHeap[ pSme->uCandHeapSize ];
+				pSme->pCandHeap[ uIndex ] = pLastSite;
+				pLastSite->uCandHeapIndex = uIndex;
+				uIndex = sme_SelectSiftUp (pSme, uIndex);
+				sme_SelectSiftDown (pSme, uIndex);
+			}
+		}
+	}
+}
+
+/**
+ * \fn     sme_SelectSiftDown
+ * \brief  Moves a candidate heap entry down to its place
+ *
+ * \param  pSme - the SME object
+ * \param  uIndex - the index of the entry to move
+ * \return None
+ * \sa     sme_SelectBuildCandHeap, sme_SelectPopCandidate
+ */
+static void sme_SelectSiftDown (TSme *pSme, TI_UINT32 uIndex)
+{
+	TSiteEntry      *pSite = pSme->pCandHeap[ uIndex ];
+	TI_UINT32       uChild;
+
+	while ((uChild = (2 * uIndex) + 1) < pSme->uCandHeapSize) {
+		/* select the better child */
+		if ((uChild + 1 < pSme->uCandHeapSize) &&
+		        SME_SELECT_IS_BETTER (pSme->pCandHeap[ uChild + 1 ], pSme->pCandHeap[ uChild ])) {
+			uChild++;
+		}
+
+		if (!SME_SELECT_IS_BETTER (pSme->pCandHeap[ uChild ], pSite)) {
+			break;
+		}
+
+		pSme->pCandHeap[ uIndex ] = pSme->pCandHeap[ uChild ];
+		pSme->pCandHeap[ uIndex ]->uCandHeapIndex = uIndex;
+		uIndex = uChild;
+	}
+
+	pSme->pCandHeap[ uIndex ] = pSite;
+	pSite->uCandHeapIndex = uIndex;
+}
+
+/**
+ * \fn     sme_SelectSiftUp
+ * \brief  Moves a candidate heap entry up to its place
+ *
+ * \param  pSme - the SME object
+ * \param  uIndex - the index of the entry to move
+ * \return The new index of the entry
+ * \sa     sme_SelectUpdateCandHeap
+ */
+static TI_UINT32 sme_SelectSiftUp (TSme *pSme, TI_UINT32 uIndex)
+{
+	TSiteEntry      *pSite = pSme->pCandHeap[ uIndex ];
+	TI_UINT32       uParent;
+
+	while (uIndex > 0) {
+		uParent = (uIndex - 1) / 2;
+		if (!SME_SELECT_IS_BETTER (pSite, pSme->pCandHeap[ uParent ])) {
+			break;
+		}
+
+		pSme->pCandHeap[ uIndex ] = pSme->pCandHeap[ uParent ];
+		pSme->pCandHeap[ uIndex ]->uCandHeapIndex = uIndex;
+		uIndex = uParent;
+	}
+
+	pSme->pCandHeap[ uIndex ] = pSite;
+	pSite->uCandHeapIndex = uIndex;
+	return uIndex;
+}
+
 /**
  * \fn     sme_SelectSsidMatch
  * \brief  Check if a site SSID matches the desired SSID for selection
@@ -435,3 +764,167 @@ TI_BOOL sme_SelectRsnMatch (TI_HANDLE hSme, TSiteEntry *pCurrentSite)
 	}
 }
 
+
+#ifdef TI_DBG
+
+/* number of consecutive selections measured by the select benchmark (as in connection retries) */
+#define SME_SELECT_BENCH_ROUNDS         16
+#define SME_SELECT_BENCH_DEFAULT_SITES  256
+
+/**
+ * \fn     sme_SelectBenchmark
+ * \brief  Measures selection latency over a synthetic scan result table (debug)
+ *
+ * Builds a synthetic scan result table, and measures consecutive selections from it by
+ * checking all sites (as when WSC is on), by building the candidate heap with no cached
+ * verdicts, by rebuilding it with cached verdicts (as after sites were aged out) and by heap pops.
+ * The connection state is not changed: the SME scan result table and candidate heap are
+ * restored when done.
+ *
+ * \param  hSme - handle to the SME object
+ * \param  uNumOfSites - number of sites in the synthetic table (0 for default)
+ * \return None
+ * \sa     sme_Select
+ */
+void sme_SelectBenchmark (TI_HANDLE hSme, TI_UINT32 uNumOfSites)
+{
+	TSme            *pSme = (TSme*)hSme;
+	TStadHandlesList *pHandles;
+	TI_HANDLE       hBenchTable, hSavedTable;
+	TSiteEntry      **pSavedHeap;
+	TI_UINT32       uSavedHeapCapacity;
+	TSiteEntry      *pSite;
+	TI_BOOL         bWscPbAbort;
+	TI_UINT32       uIndex, uWalkCount, uPopCount;
+	TI_UINT32       uStartUs, uWalkUs, uColdUs, uRebuildUs, uPopUs;
+	static const char aBenchSsid[] = "TiSmeBenchSite";
+
+	if (0 == uNumOfSites) {
+		uNumOfSites = SME_SELECT_BENCH_DEFAULT_SITES;
+	}
+
+	/* create and fill the synthetic table */
+	pHandles = (TStadHandlesList *)os_memoryAlloc (pSme->hOS, sizeof (TStadHandlesList));
+	if (NULL == pHandles) {
+		WLAN_OS_REPORT(("sme_SelectBenchmark: unable to allocate memory\n"));
+		return;
+	}
+	os_memoryZero (pSme->hOS, pHandles, sizeof (TStadHandlesList));
+	pHandles->hReport = pSme->hReport;
+	pHandles->hSiteMgr = pSme->hSiteMgr;
+
+	hBenchTable = scanResultTable_Create (pSme->hOS, uNumOfSites);
+	if (NULL == hBenchTable) {
+		WLAN_OS_REPORT(("sme_SelectBenchmark: unable to create scan result table\n"));
+		os_memoryFree (pSme->hOS, pHandles, sizeof (TStadHandlesList));
+		return;
+	}
+	scanResultTable_Init (hBenchTable, pHandles, SCAN_RESULT_TABLE_DONT_CLEAR);
+	os_memoryFree (pSme->hOS, pHandles, sizeof (TStadHandlesList));
+
+	for (uIndex = 0; uIndex < uNumOfSites; uIndex++) {
+		pSite = scanResultTable_AllocateDbgEntry (hBenchTable);
+		if (NULL == pSite) {
+			break;
+		}
+
+		/* one of every four sites has the desired SSID */
+		if ((0 == (uIndex % 4)) && (SSID_TYPE_SPECIFIC == pSme->eSsidType)) {
+			os_memoryCopy (pSme->hOS, &(pSite->ssid), &(pSme->tSsid), sizeof (TSsid));
+		} else {
+			pSite->ssid.len = sizeof (aBenchSsid) - 1;
+			os_memoryCopy (pSme->hOS, &(pSite->ssid.str[ 0 ]), (void *)aBenchSsid, pSite->ssid.len);
+		}
+		pSite->bssid[ 0 ] = 0x02;
+		pSite->bssid[ 4 ] = (TI_UINT8)(uIndex >> 8);
+		pSite->bssid[ 5 ] = (TI_UINT8)uIndex;
+		pSite->bssType = BSS_INFRASTRUCTURE;
+		pSite->eBand = RADIO_BAND_2_4_GHZ;
+		pSite->channel = (TI_UINT8)(1 + (uIndex % 11));
+		pSite->rssi = -40 - (TI_INT32)((uIndex * 7) % 50);
+		pSite->maxBasicRate = DRV_RATE_1M;
+		pSite->maxActiveRate = DRV_RATE_54M;
+		pSite->rateMask.basicRateMask = DRV_RATE_MASK_1_BARKER;
+		pSite->rateMask.supportedRateMask = DRV_RATE_MASK_54_OFDM;
+		pSite->WSCSiteMode = TIWLN_SIMPLE_CONFIG_OFF;
+	}
+
+	/* use the synthetic table and a large enough candidate heap */
+	pSavedHeap = pSme->pCandHeap;
+	uSavedHeapCapacity = pSme->uCandHeapCapacity;
+	pSme->pCandHeap = (TSiteEntry **)os_memoryAlloc (pSme->hOS, sizeof (TSiteEntry *) * uNumOfSites);
+	if (NULL == pSme->pCandHeap) {
+		WLAN_OS_REPORT(("sme_SelectBenchmark: unable to allocate candidate heap\n"));
+		pSme->pCandHeap = pSavedHeap;
+		scanResultTable_Destroy (hBenchTable);
+		return;
+	}
+	pSme->uCandHeapCapacity = uNumOfSites;
+	hSavedTable = pSme->hScanResultTable;
+	pSme->hScanResultTable = hBenchTable;
+
+	/* check all sites for every selection */
+	uWalkCount = 0;
+	uStartUs = os_timeStampUs (pSme->hOS);
+	for (uIndex = 0; uIndex < SME_SELECT_BENCH_ROUNDS; uIndex++) {
+		pSite = sme_SelectWalkTable (hSme, &bWscPbAbort);
+		if (NULL == pSite) {
+			break;
+		}
+		pSite->bConsideredForSelect = TI_TRUE;
+		uWalkCount++;
+	}
+	uWalkUs = os_timeStampUs (pSme->hOS) - uStartUs;
+
+	/* build the heap with no cached verdicts */
+	for (pSite = scanResultTable_GetFirst (hBenchTable); NULL != pSite; pSite = scanResultTable_GetNext (hBenchTable)) {
+		pSite->bConsideredForSelect = TI_FALSE;
+	}
+	sme_SelectNewProfile (hSme);
+	pSme->bCandHeapValid = TI_FALSE;
+	uStartUs = os_timeStampUs (pSme->hOS);
+	sme_SelectBuildCandHeap (hSme);
+	uColdUs = os_timeStampUs (pSme->hOS) - uStartUs;
+
+	/* rebuild it with cached verdicts */
+	for (pSite = scanResultTable_GetFirst (hBenchTable); NULL != pSite; pSite = scanResultTable_GetNext (hBenchTable)) {
+		pSite->bConsideredForSelect = TI_FALSE;
+	}
+	uStartUs = os_timeStampUs (pSme->hOS);
+	sme_SelectBuildCandHeap (hSme);
+	uRebuildUs = os_timeStampUs (pSme->hOS) - uStartUs;
+
+	/* and pop the candidates */
+	uPopCount = 0;
+	uStartUs = os_timeStampUs (pSme->hOS);
+	for (uIndex = 0; uIndex < SME_SELECT_BENCH_ROUNDS; uIndex++) {
+		pSite = sme_SelectPopCandidate (hSme);
+		if (NULL == pSite) {
+			break;
+		}
+		pSite->bConsideredForSelect = TI_TRUE;
+		uPopCount++;
+	}
+	uPopUs = os_timeStampUs (pSme->hOS) - uStartUs;
+
+	WLAN_OS_REPORT(("-------------- SME Select Benchmark ----------------------\n"));
+	WLAN_OS_REPORT(("Sites = %d, Matching sites = %d\n", uNumOfSites, pSme->uCandHeapSize + uPopCount));
+	WLAN_OS_REPORT(("Table walk:         %d selections, %d us (%d us per selection)\n",
+	                uWalkCount, uWalkUs, (uWalkCount ? uWalkUs / uWalkCount : 0)));
+	WLAN_OS_REPORT(("Heap build (cold):  %d us\n", uColdUs));
+	WLAN_OS_REPORT(("Heap build (cached verdicts): %d us\n", uRebuildUs));
+	WLAN_OS_REPORT(("Heap pop:           %d selections, %d us (%d us per selection)\n",
+	                uPopCount, uPopUs, (uPopCount ? uPopUs / uPopCount : 0)));
+	WLAN_OS_REPORT(("==========================================================\n"));
+
+	/* restore the SME table and candidate heap */
+	pSme->hScanResultTable = hSavedTable;
+	os_memoryFree (pSme->hOS, pSme->pCandHeap, sizeof (TSiteEntry *) * uNumOfSites);
+	pSme->pCandHeap = pSavedHeap;
+	pSme->uCandHeapCapacity = uSavedHeapCapacity;
+	pSme->uCandHeapSize = 0;
+	pSme->bCandHeapValid = TI_FALSE;
+	scanResultTable_Destroy (hBenchTable);
+}
+
+#endif /* TI_DBG */
@@ -247,6 +247,12 @@ void smeSm_PreConnect (TI_HANDLE hSme)
 	/* mark that no authentication/assocaition was yet sent */
 	pSme->bAuthSent = TI_FALSE;
 
+	/*
+	 * desired SSID, BSSID, BSS type, security and rates may have changed since the last attempt,
+	 * so cached site match verdicts are not used for this connection attempt
+	 */
+	sme_SelectNewProfile (hSme);
+
 	/* try to find a connection candidate (manual mode have already performed scann */
 	pSme->pCandidate = sme_Select (hSme);
 	if (NULL != pSme->pCandidate) {
@@ -60,6 +60,7 @@
 #include "CmdDispatcher.h"
 #include "healthMonitor.h"
 #include "currBssApi.h"
+#include "context.h"
 #ifdef XCC_MODULE_INCLUDED
 #include "XCCMngr.h"
 #endif
@@ -75,6 +76,50 @@ typedef struct {
 
 } TParamAccess;
 
+/* Parameter descriptor flags */
+#define PARAM_DESC_SYNC             0x01    /* Read from driver memory only, may be served in the caller context */
+#define PARAM_DESC_CACHEABLE        0x02    /* May be served from the parameters snapshot */
+
+/* Size of the descriptors hash table (power of 2, larger than the number of descriptors) */
+#define PARAM_DESC_HASH_SIZE        32
+#define PARAM_DESC_HASH(type)       (((type) ^ ((type) >> 8)) & (PARAM_DESC_HASH_SIZE - 1))
+
+/* Maximum age of a snapshot value before it is read again from its module */
+#define PARAM_SNAPSHOT_MAX_AGE_MS   100
+
+/* The largest value kept in the parameters snapshot */
+#define PARAM_SNAPSHOT_MAX_SIZE     sizeof(TIWLN_COUNTERS)
+
+/* Parameter descriptor */
+typedef struct {
+	TI_UINT32           uParamType;     /* The parameter type */
+	TI_UINT32           uValueSize;     /* Size of the parameter value in paramInfo_t content */
+	TI_UINT32           uFlags;         /* PARAM_DESC_xxx flags */
+
+} TParamDesc;
+
+/* Descriptors of the parameters polled by user applications (statistics, signal and rates) */
+static const TParamDesc aParamDescTable[] = {
+	{ SITE_MGR_GET_STATS,               sizeof(TI_INT32),       PARAM_DESC_SYNC | PARAM_DESC_CACHEABLE },
+	{ SITE_MGR_CURRENT_SIGNAL_PARAM,    sizeof(signal_t),       PARAM_DESC_SYNC | PARAM_DESC_CACHEABLE },
+	{ SITE_MGR_CURRENT_TX_RATE_PARAM,   sizeof(TI_UINT8),       PARAM_DESC_SYNC | PARAM_DESC_CACHEABLE },
+	{ SITE_MGR_CURRENT_RX_RATE_PARAM,   sizeof(TI_UINT8),       PARAM_DESC_SYNC | PARAM_DESC_CACHEABLE },
+	{ SITE_MGR_TI_WLAN_COUNTERS_PARAM,  sizeof(TIWLN_COUNTERS), PARAM_DESC_SYNC | PARAM_DESC_CACHEABLE },
+	{ CTRL_DATA_MAC_ADDRESS,            sizeof(TMacAddr),       PARAM_DESC_SYNC }
+};
+
+#define PARAM_DESC_NUM              (sizeof(aParamDescTable) / sizeof(TParamDesc))
+
+/* Descriptors hash table entry, holding the resolved handler and the parameter snapshot */
+typedef struct {
+	const TParamDesc   *pDesc;          /* The parameter descriptor (NULL if entry is free) */
+	TParamAccess       *pAccess;        /* The parameter owner module access functions */
+	TI_BOOL             bSnapshotValid; /* Indicates if the snapshot holds a value */
+	TI_UINT32           uSnapshotTs;    /* Time stamp (msec) of the snapshot value */
+	TI_UINT8            aSnapshot[PARAM_SNAPSHOT_MAX_SIZE]; /* The parameter value snapshot */
+
+} TParamDescEntry;
+
 /* The module's object */
 typedef struct {
 	/* Other modules handles */
@@ -101,6 +146,7 @@ typedef struct {
 	TI_HANDLE    hHealthMonitor;
 	TI_HANDLE    hTWD;
 	TI_HANDLE    hCurrBss;
+	TI_HANDLE    hContext;
 #ifdef XCC_MODULE_INCLUDED
 	TI_HANDLE    hXCCMngr;
 #endif
@@ -108,6 +154,9 @@ typedef struct {
 	/* Table of params set/get functions */
 	TParamAccess paramAccessTable[MAX_PARAM_MODULE_NUMBER];
 
+	/* Parameters descriptors hash table */
+	TParamDescEntry aParamDescHash[PARAM_DESC_HASH_SIZE];
+
 #ifdef TI_DBG
 	TStadHandlesList *pStadHandles;  /* Save modules list pointer just for the debug functions */
 #endif
@@ -117,6 +166,8 @@ typedef struct {
 
 /* Internal functions prototypes */
 static void      cmdDispatch_ConfigParamsAccessTable (TCmdDispatchObj *pCmdDispatch);
+static void      cmdDispatch_ConfigParamsDescTable (TCmdDispatchObj *pCmdDispatch);
+static TParamDescEntry *cmdDispatch_FindParamDesc (TCmdDispatchObj *pCmdDispatch, TI_UINT32 uParamType);
 static TI_STATUS cmdDispatch_SetTwdParam  (TI_HANDLE hCmdDispatch, paramInfo_t *pParam);
 static TI_STATUS cmdDispatch_GetTwdParam  (TI_HANDLE hCmdDispatch, paramInfo_t *pParam);
 
@@ -198,6 +249,7 @@ void cmdDispatch_Init (TStadHandlesList *pStadHandles)
 	pCmdDispatch->hHealthMonitor    = pStadHandles->hHealthMonitor;
 	pCmdDispatch->hTWD              = pStadHandles->hTWD;
 	pCmdDispatch->hCurrBss          = pStadHandles->hCurrBss;
+	pCmdDispatch->hContext          = pStadHandles->hContext;
 #ifdef XCC_MODULE_INCLUDED
 	pCmdDispatch->hXCCMngr          = pStadHandles->hXCCMngr;
 #endif
@@ -208,6 +260,9 @@ void cmdDispatch_Init (TStadHandlesList *pStadHandles)
 
 	/* Fill the configuration table with the Get/Set functions */
 	cmdDispatch_ConfigParamsAccessTable (pCmdDispatch);
+
+	/* Index the parameters descriptors and resolve their handlers */
+	cmdDispatch_ConfigParamsDescTable (pCmdDispatch);
 }
 
 
@@ -434,6 +489,217 @@ TI_STATUS cmdDispatch_GetParam (TI_HANDLE hCmdDispatch, void *param)
 }
 
 
+/**
+ * \fn     cmdDispatch_ConfigParamsDescTable
+ * \brief  Index the parameters descriptors
+ *
+ * Insert each descriptor of aParamDescTable to the descriptors hash table,
+ *     and resolve its owner module access functions from the params access table.
+ *
+ * \note   Must be called after cmdDispatch_ConfigParamsAccessTable
+ * \param  pCmdDispatch - The object
+ * \return void
+ * \sa
+ */
+static void cmdDispatch_ConfigParamsDescTable (TCmdDispatchObj *pCmdDispatch)
+{
+	TParamDescEntry *pEntry;
+	TI_UINT32        uModule;
+	TI_UINT32        uHash;
+	TI_UINT32        i;
+
+	for (i = 0; i < PARAM_DESC_NUM; i++) {
+		uModule = GET_PARAM_MODULE_NUMBER(aParamDescTable[i].uParamType);
+
+		/* Find a free entry (linear probing) */
+		uHash = PARAM_DESC_HASH(aParamDescTable[i].uParamType);
+		while (pCmdDispatch->aParamDescHash[uHash].pDesc != NULL) {
+			uHash = (uHash + 1) & (PARAM_DESC_HASH_SIZE - 1);
+		}
+
+		pEntry = &pCmdDispatch->aParamDescHash[uHash];
+		pEntry->pDesc = &aParamDescTable[i];
+		pEntry->pAccess = &pCmdDispatch->paramAccessTable[uModule - 1];
+		pEntry->bSnapshotValid = TI_FALSE;
+	}
+}
+
+
+/**
+ * \fn     cmdDispatch_FindParamDesc
+ * \brief  Find a parameter descriptor
+ *
+ * \note
+ * \param  pCmdDispatch - The object
+ * \param  uParamType   - The parameter type
+ * \return The parameter descriptors hash entry, or NULL if the parameter has no descriptor
+ * \sa
+ */
+static TParamDescEntry *cmdDispatch_FindParamDesc (TCmdDispatchObj *pCmdDispatch, TI_UINT32 uParamType)
+{
+	TI_UINT32 uHash = PARAM_DESC_HASH(uParamType);
+	TI_UINT32 i;
+
+	for (i = 0; i < PARAM_DESC_HASH_SIZE; i++) {
+		if (pCmdDispatch->aParamDescHash[uHash].pDesc == NULL) {
+			return NULL;
+		}
+		if (pCmdDispatch->aParamDescHash[uHash].pDesc->uParamType == uParamType) {
+			return &pCmdDispatch->aParamDescHash[uHash];
+		}
+		uHash = (uHash + 1) & (PARAM_DESC_HASH_SIZE - 1);
+	}
+
+	return NULL;
+}
+
+
+/**
+ * \fn     cmdDispatch_IsSyncParam
+ * \brief  Check if a parameter may be read in the caller context
+ *
+ * Used by the OS abstraction layer to decide if a GET command may be executed
+ *     directly in the user context, without switching to the driver task.
+ *
+ * \note
+ * \param  hCmdDispatch - The object
+ * \param  uParamType   - The parameter type
+ * \return TI_TRUE if the parameter is read from driver memory only
+ * \sa     cmdDispatch_GetSnapshotParam
+ */
+TI_BOOL cmdDispatch_IsSyncParam (TI_HANDLE hCmdDispatch, TI_UINT32 uParamType)
+{
+	TParamDescEntry *pEntry = cmdDispatch_FindParamDesc ((TCmdDispatchObj *)hCmdDispatch, uParamType);
+
+	return ((pEntry != NULL) && (pEntry->pDesc->uFlags & PARAM_DESC_SYNC)) ? TI_TRUE : TI_FALSE;
+}
+
+
+/**
+ * \fn     cmdDispatch_GetSnapshotParam
+ * \brief  Get a driver parameter through its descriptor
+ *
+ * Get a described parameter directly from its resolved handler.
+ * Cacheable parameters are served from the parameters snapshot if it is not older than
+ *     PARAM_SNAPSHOT_MAX_AGE_MS, and the snapshot is refreshed whenever the value is read from its module
+ *     successfully. A value the module doesn't fill is returned and cached as zero.
+ * Parameters with no descriptor are passed to cmdDispatch_GetParam.
+ *
+ * \note   May be called from the user context (protected by the context critical section)
+ * \param  hCmdDispatch - The object
+ * \param  param        - The parameter information
+ * \return result of parameter getting
+ * \sa     cmdDispatch_GetParam
+ */
+TI_STATUS cmdDispatch_GetSnapshotParam (TI_HANDLE hCmdDispatch, void *param)
+{
+	TCmdDispatchObj *pCmdDispatch = (TCmdDispatchObj *) hCmdDispatch;
+	paramInfo_t     *pParam = (paramInfo_t *) param;
+	TParamDescEntry *pEntry;
+	const TParamDesc *pDesc;
+	TI_UINT32        uNow;
+	TI_STATUS        status;
+
+	pEntry = cmdDispatch_FindParamDesc (pCmdDispatch, pParam->paramType);
+	if ((pEntry == NULL) || (pEntry->pAccess->get == NULL)) {
+		return cmdDispatch_GetParam (hCmdDispatch, param);
+	}
+	pDesc = pEntry->pDesc;
+
+	if (!(pDesc->uFlags & PARAM_DESC_CACHEABLE)) {
+		return pEntry->pAccess->get (pEntry->pAccess->handle, pParam);
+	}
+
+	uNow = os_timeStampMs (pCmdDispatch->hOs);
+
+	/* Serve the value from the snapshot if it is recent enough */
+	context_EnterCriticalSection (pCmdDispatch->hContext);
+	if (pEntry->bSnapshotValid && (uNow - pEntry->uSnapshotTs < PARAM_SNAPSHOT_MAX_AGE_MS)) {
+		os_memoryCopy (pCmdDispatch->hOs, &pParam->content, pEntry->aSnapshot, pDesc->uValueSize);
+		context_LeaveCriticalSection (pCmdDispatch->hContext);
+		return TI_OK;
+	}
+	context_LeaveCriticalSection (pCmdDispatch->hContext);
+
+	/*
+	 * Read the value from its module (which may change the paramType) and save it in the snapshot.
+	 * The value is cleared first, since some handlers return TI_OK without writing it
+	 *     (e.g. SITE_MGR_GET_STATS with no primary site), and stale caller data must not be cached.
+	 */
+	os_memoryZero (pCmdDispatch->hOs, &pParam->content, pDesc->uValueSize);
+	status = pEntry->pAccess->get (pEntry->pAccess->handle, pParam);
+	pParam->paramType = pDesc->uParamType;
+
+	if (status == TI_OK) {
+		context_EnterCriticalSection (pCmdDispatch->hContext);
+		os_memoryCopy (pCmdDispatch->hOs, pEntry->aSnapshot, &pParam->content, pDesc->uValueSize);
+		pEntry->uSnapshotTs = uNow;
+		pEntry->bSnapshotValid = TI_TRUE;
+		context_LeaveCriticalSection (pCmdDispatch->hContext);
+	}
+
+	return status;
+}
+
+
+#ifdef TI_DBG
+/**
+ * \fn     cmdDispatch_Benchmark
+ * \brief  Compare the parameters dispatch cost
+ *
+ * Get a parameter repeatedly through the module-ID dispatch (cmdDispatch_GetParam)
+ *     and through its descriptor (cmdDispatch_GetSnapshotParam), and print the total time of each.
+ *
+ * \note
+ * \param  hCmdDispatch - The object
+ * \param  uParamType   - The parameter type (SITE_MGR_GET_STATS if 0)
+ * \param  uIterations  - Number of calls per method (1000 if 0)
+ * \return void
+ * \sa
+ */
+void cmdDispatch_Benchmark (TI_HANDLE hCmdDispatch, TI_UINT32 uParamType, TI_UINT32 uIterations)
+{
+	TCmdDispatchObj *pCmdDispatch = (TCmdDispatchObj *) hCmdDispatch;
+	paramInfo_t     *pParam;
+	TI_UINT32        uStart, uModuleTime, uDescTime;
+	TI_UINT32        i;
+
+	if (uParamType == 0) {
+		uParamType = SITE_MGR_GET_STATS;
+	}
+	if (uIterations == 0) {
+		uIterations = 1000;
+	}
+
+	pParam = (paramInfo_t *)os_memoryAlloc (pCmdDispatch->hOs, sizeof(paramInfo_t));
+	if (!pParam) {
+		return;
+	}
+
+	uStart = os_timeStampUs (pCmdDispatch->hOs);
+	for (i = 0; i < uIterations; i++) {
+		pParam->paramType = uParamType;
+		cmdDispatch_GetParam (hCmdDispatch, pParam);
+	}
+	uModuleTime = os_timeStampUs (pCmdDispatch->hOs) - uStart;
+
+	uStart = os_timeStampUs (pCmdDispatch->hOs);
+	for (i = 0; i < uIterations; i++) {
+		pParam->paramType = uParamType;
+		cmdDispatch_GetSnapshotParam (hCmdDispatch, pParam);
+	}
+	uDescTime = os_timeStampUs (pCmdDispatch->hOs) - uStart;
+
+	WLAN_OS_REPORT(("cmdDispatch_Benchmark: param 0x%x, %d iterations\n", uParamType, uIterations));
+	WLAN_OS_REPORT(("  module dispatch:     %d usec\n", uModuleTime));
+	WLAN_OS_REPORT(("  descriptor dispatch: %d usec (%s)\n", uDescTime,
+	                cmdDispatch_FindParamDesc (pCmdDispatch, uParamType) ? "described" : "not described"));
+
+	os_memoryFree (pCmdDispatch->hOs, pParam, sizeof(paramInfo_t));
+}
+#endif /* TI_DBG */
+
+
 /**
  * \fn     cmdDispatch_SetTwdParam / cmdDispatch_GetParam
  * \brief  Set/Get a TWD parameter
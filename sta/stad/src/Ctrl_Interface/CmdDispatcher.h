@@ -52,6 +52,11 @@ void      cmdDispatch_Init     (TStadHandlesList *pStadHandles);
 TI_STATUS cmdDispatch_Destroy  (TI_HANDLE hCmdDispatch);
 TI_STATUS cmdDispatch_SetParam (TI_HANDLE hCmdDispatch, void *param);
 TI_STATUS cmdDispatch_GetParam (TI_HANDLE hCmdDispatch, void *param);
+TI_STATUS cmdDispatch_GetSnapshotParam (TI_HANDLE hCmdDispatch, void *param);
+TI_BOOL   cmdDispatch_IsSyncParam (TI_HANDLE hCmdDispatch, TI_UINT32 uParamType);
+#ifdef TI_DBG
+void      cmdDispatch_Benchmark (TI_HANDLE hCmdDispatch, TI_UINT32 uParamType, TI_UINT32 uIterations);
+#endif
 
 
 #endif  /* _CMD_DISPATCHER_H_ */
@@ -54,6 +54,21 @@
 /* The queue may contain only one command per configuration application but set as unlimited */
 #define COMMANDS_QUE_SIZE   QUE_UNLIMITED_SIZE
 
+/* Number of preallocated command slots (if all are busy, commands are allocated dynamically) */
+#define CMD_POOL_SIZE       8
+
+/* Number of different command types tracked by the latency statistics */
+#define CMD_STAT_TYPES      32
+
+/* Per command type latency statistics */
+typedef struct {
+	TI_UINT32       uCmd;            /* The command code (0 = free entry) */
+	TI_UINT32       uCount;          /* Number of completed commands */
+	TI_UINT32       uSyncCount;      /* Number of commands completed inline in the caller context */
+	TI_UINT32       uTotalUs;        /* Accumulated latency in usec */
+	TI_UINT32       uMaxUs;          /* Maximum latency in usec */
+} TCmdLatencyStat;
+
 /* Command module internal data */
 typedef struct {
 	TI_HANDLE       hOs;
@@ -66,11 +81,22 @@ typedef struct {
 	TI_BOOL         bProcessingCmds; /* Indicates if currently processing commands */
 	TI_UINT32       uContextId;      /* ID allocated to this module on registration to context module */
 	TConfigCommand *pCurrCmd;        /* Pointer to the command currently being processed */
+
+	TConfigCommand  aCmdPool[CMD_POOL_SIZE];      /* Preallocated commands with persistent signal objects */
+	TI_BOOL         aCmdPoolBusy[CMD_POOL_SIZE];  /* Indicates if a pool slot is in use */
+	TI_UINT32       uPoolMissCount;               /* Commands allocated dynamically since the pool was busy */
+	TI_UINT32       uTimeoutCount;                /* Commands that timed out (released on their late completion) */
+	TCmdLatencyStat aLatencyStat[CMD_STAT_TYPES]; /* Per command type latency statistics */
 } TCmdHndlrObj;
 
 /* External functions prototypes */
 extern void wlanDrvIf_CommandDone (TI_HANDLE hOs, void *pSignalObject, TI_UINT8 *CmdResp_p);
 
+static TConfigCommand *cmdHndlr_AllocCmd (TCmdHndlrObj *pCmdHndlr);
+static void            cmdHndlr_FreeCmd (TCmdHndlrObj *pCmdHndlr, TConfigCommand *pCmd);
+static void            cmdHndlr_SignalCmd (TCmdHndlrObj *pCmdHndlr, TConfigCommand *pCmd);
+static void            cmdHndlr_UpdateStat (TCmdHndlrObj *pCmdHndlr, TConfigCommand *pCmd, TI_BOOL bSync);
+
 /**
  * \fn     cmdHndlr_Create
  * \brief  Create the module
@@ -85,6 +111,7 @@ extern void wlanDrvIf_CommandDone (TI_HANDLE hOs, void *pSignalObject, TI_UINT8
 TI_HANDLE cmdHndlr_Create (TI_HANDLE hOs, TI_HANDLE hEvHandler)
 {
 	TCmdHndlrObj *pCmdHndlr = (TCmdHndlrObj *) os_memoryAlloc (hOs, sizeof(TCmdHndlrObj));
+	TI_UINT32     i;
 
 	if (pCmdHndlr == NULL) {
 		return NULL;
@@ -94,6 +121,16 @@ TI_HANDLE cmdHndlr_Create (TI_HANDLE hOs, TI_HANDLE hEvHandler)
 
 	pCmdHndlr->hOs = hOs;
 
+	/* Create the pool commands signal objects once, they are reused by all following commands */
+	for (i = 0; i < CMD_POOL_SIZE; i++) {
+		pCmdHndlr->aCmdPool[i].pSignalObject = os_SignalObjectCreate (hOs);
+		if (pCmdHndlr->aCmdPool[i].pSignalObject == NULL) {
+			cmdHndlr_Destroy ((TI_HANDLE) pCmdHndlr, (TI_HANDLE) hEvHandler);
+			return NULL;
+		}
+		pCmdHndlr->aCmdPool[i].bPooled = TI_TRUE;
+	}
+
 	pCmdHndlr->hCmdInterpret = cmdInterpret_Create (hOs);
 
 	if (pCmdHndlr->hCmdInterpret == NULL) {
@@ -119,11 +156,18 @@ TI_HANDLE cmdHndlr_Create (TI_HANDLE hOs, TI_HANDLE hEvHandler)
 TI_STATUS cmdHndlr_Destroy (TI_HANDLE hCmdHndlr, TI_HANDLE hEvHandler)
 {
 	TCmdHndlrObj *pCmdHndlr = (TCmdHndlrObj *)hCmdHndlr;
+	TI_UINT32     i;
 
 	if (pCmdHndlr->hCmdInterpret) {
 		cmdInterpret_Destroy (pCmdHndlr->hCmdInterpret, hEvHandler);
 	}
 
+	for (i = 0; i < CMD_POOL_SIZE; i++) {
+		if (pCmdHndlr->aCmdPool[i].pSignalObject) {
+			os_SignalObjectFree (pCmdHndlr->hOs, pCmdHndlr->aCmdPool[i].pSignalObject);
+		}
+	}
+
 
 	if (pCmdHndlr->hCmdQueue) {
 		que_Destroy (pCmdHndlr->hCmdQueue);
@@ -237,12 +281,12 @@ TI_STATUS cmdHndlr_InsertCommand (TI_HANDLE     hCmdHndlr,
 	TConfigCommand   *pNewCmd;
 	TI_STATUS         eStatus;
 
-	/* Allocated command structure */
-	pNewCmd = os_memoryAlloc (pCmdHndlr->hOs, sizeof (TConfigCommand));
+	/* Get a command structure (from the pool if available) */
+	pNewCmd = cmdHndlr_AllocCmd (pCmdHndlr);
 	if (pNewCmd == NULL) {
+		os_printf("cmdPerform: Failed to allocate command\n");
 		return TI_NOK;
 	}
-	os_memoryZero (pCmdHndlr->hOs, (void *)pNewCmd, sizeof(TConfigCommand));
 
 	/* Copy user request into local structure */
 	pNewCmd->cmd = cmd;
@@ -253,14 +297,18 @@ TI_STATUS cmdHndlr_InsertCommand (TI_HANDLE     hCmdHndlr,
 	pNewCmd->buffer2_len = buffer2_len;
 	pNewCmd->param3 = param3;
 	pNewCmd->param4 = param4;
-	pNewCmd->pSignalObject = os_SignalObjectCreate (pCmdHndlr->hOs); /* initialize "complete-flag" */
+	pNewCmd->uStartTimeUs = os_timeStampUs (pCmdHndlr->hOs);
 
-	/* If creating the signal object failed */
-	if (pNewCmd->pSignalObject == NULL) {
-		os_printf("cmdPerform: Failed to create signalling object\n");
-		/* free allocated memory and return error */
-		os_memoryFree (pCmdHndlr->hOs, pNewCmd, sizeof (TConfigCommand));
-		return TI_NOK;
+	/*
+	 * Read-only GET commands that are served from the driver's memory (same as the wireless
+	 *   statistics in cmdHndlr_GetStat) are completed inline, without waking the driver task.
+	 */
+	if (cmdInterpret_IsSyncGet (pCmdHndlr->hCmdInterpret, pNewCmd)) {
+		pNewCmd->eCmdStatus = cmdInterpret_convertAndExecute (pCmdHndlr->hCmdInterpret, pNewCmd);
+		eStatus = pNewCmd->return_code;
+		cmdHndlr_UpdateStat (pCmdHndlr, pNewCmd, TI_TRUE);
+		cmdHndlr_FreeCmd (pCmdHndlr, pNewCmd);
+		return eStatus;
 	}
 
 	/* Indicate the start of command process, from adding it to the queue until get return status form it */
@@ -272,11 +320,9 @@ TI_STATUS cmdHndlr_InsertCommand (TI_HANDLE     hCmdHndlr,
 	/* Enqueue the command (if failed, release memory and return NOK) */
 	eStatus = que_Enqueue (pCmdHndlr->hCmdQueue, (TI_HANDLE)pNewCmd);
 	if (eStatus != TI_OK) {
-		os_printf("cmdPerform: Failed to enqueue new command\n");
-		os_SignalObjectFree (pCmdHndlr->hOs, pNewCmd->pSignalObject);
-		pNewCmd->pSignalObject = NULL;
-		os_memoryFree (pCmdHndlr->hOs, pNewCmd, sizeof (TConfigCommand));
 		context_LeaveCriticalSection (pCmdHndlr->hContext);  /* Leave critical section */
+		os_printf("cmdPerform: Failed to enqueue new command\n");
+		cmdHndlr_FreeCmd (pCmdHndlr, pNewCmd);
 		return TI_NOK;
 	}
 
@@ -306,11 +352,25 @@ TI_STATUS cmdHndlr_InsertCommand (TI_HANDLE     hCmdHndlr,
 	/* Wait until the command is executed */
 	if(os_SignalObjectWait (pCmdHndlr->hOs, pNewCmd->pSignalObject) == TI_NOK)
 	{
-		/* Command did not complete within 10 seconds but can still be queued or running.
-		   Cannot free memory and signalobject */
-		healthMonitor_sendFailureEvent (pCmdHndlr->hHealthMonitor,
-						HW_AWAKE_FAILURE);
-		return TI_NOK;
+		/*
+		 * Command did not complete within 10 seconds but can still be queued or running.
+		 * Mark it as abandoned, so it is released (and its pool slot reused) when it completes
+		 *     or is dequeued. If its completion is already being signalled, just wait for it.
+		 */
+		context_EnterCriticalSection (pCmdHndlr->hContext);
+		if (!pNewCmd->bSignalled) {
+			pNewCmd->bAbandoned = TI_TRUE;
+		}
+		context_LeaveCriticalSection (pCmdHndlr->hContext);
+
+		if (pNewCmd->bAbandoned) {
+			pCmdHndlr->uTimeoutCount++;
+			healthMonitor_sendFailureEvent (pCmdHndlr->hHealthMonitor,
+							HW_AWAKE_FAILURE);
+			return TI_NOK;
+		}
+
+		os_SignalObjectWait (pCmdHndlr->hOs, pNewCmd->pSignalObject);
 	}
 
 	/* After "wait" - the command has already been processed by the drivers' context */
@@ -320,13 +380,11 @@ TI_STATUS cmdHndlr_InsertCommand (TI_HANDLE     hCmdHndlr,
 	/* Copy the return code */
 	eStatus = pNewCmd->return_code;
 
-	/* Free signalling object and command structure */
-	os_SignalObjectFree (pCmdHndlr->hOs, pNewCmd->pSignalObject);
-	pNewCmd->pSignalObject = NULL;
+	cmdHndlr_UpdateStat (pCmdHndlr, pNewCmd, TI_FALSE);
 
 	/* If command not completed in this context (Async) don't free the command memory */
 	if (COMMAND_PENDING != pNewCmd->eCmdStatus) {
-		os_memoryFree (pCmdHndlr->hOs, pNewCmd, sizeof (TConfigCommand));
+		cmdHndlr_FreeCmd (pCmdHndlr, pNewCmd);
 	}
 
 	/* Return to calling process with command return code */
@@ -361,8 +419,17 @@ void cmdHndlr_HandleCommands (TI_HANDLE hCmdHndlr)
 		/* Dequeue a command */
 		pCmdHndlr->pCurrCmd = (TConfigCommand *) que_Dequeue (pCmdHndlr->hCmdQueue);
 
+		/* If we have got a command whose caller stopped waiting, release it without executing it */
+		if (pCmdHndlr->pCurrCmd && pCmdHndlr->pCurrCmd->bAbandoned) {
+			/* Leave critical section */
+			context_LeaveCriticalSection (pCmdHndlr->hContext);
+
+			cmdHndlr_FreeCmd (pCmdHndlr, pCmdHndlr->pCurrCmd);
+			pCmdHndlr->pCurrCmd = NULL;
+		}
+
 		/* If we have got a command */
-		if (pCmdHndlr->pCurrCmd) {
+		else if (pCmdHndlr->pCurrCmd) {
 			/* Leave critical section */
 			context_LeaveCriticalSection (pCmdHndlr->hContext);
 
@@ -378,7 +445,7 @@ void cmdHndlr_HandleCommands (TI_HANDLE hCmdHndlr)
 			}
 
 			/* Command was completed so free the wait signal and continue to next command */
-			wlanDrvIf_CommandDone(pCmdHndlr->hOs, pCmdHndlr->pCurrCmd->pSignalObject, pCmdHndlr->pCurrCmd->CmdRespBuffer);
+			cmdHndlr_SignalCmd (pCmdHndlr, pCmdHndlr->pCurrCmd);
 
 			pCmdHndlr->pCurrCmd = NULL;
 
@@ -424,12 +491,13 @@ void cmdHndlr_Complete (TI_HANDLE hCmdHndlr)
 		/* save the wait flag before free semaphore */
 		bLocalWaitFlag = pCmdHndlr->pCurrCmd->bWaitFlag;
 
-		wlanDrvIf_CommandDone(pCmdHndlr->hOs, pCmdHndlr->pCurrCmd->pSignalObject, pCmdHndlr->pCurrCmd->CmdRespBuffer);
+		/* signal the caller (or release the command if the caller timed out) */
+		cmdHndlr_SignalCmd (pCmdHndlr, pCmdHndlr->pCurrCmd);
 
 		/* if cmdHndlr_InsertCommand() not wait to cmd complete? */
 		if (TI_FALSE == bLocalWaitFlag) {
 			/* no wait, free the command memory */
-			os_memoryFree (pCmdHndlr->hOs, pCmdHndlr->pCurrCmd, sizeof (TConfigCommand));
+			cmdHndlr_FreeCmd (pCmdHndlr, pCmdHndlr->pCurrCmd);
 		}
 
 		pCmdHndlr->pCurrCmd = NULL;
@@ -459,6 +527,202 @@ void * cmdHndlr_GetStat (TI_HANDLE hCmdHndlr)
 }
 
 
+/**
+ * \fn     cmdHndlr_PrintStat
+ * \brief  Print the commands statistics
+ *
+ * Print the commands pool usage and the per command type latency statistics.
+ *
+ * \note
+ * \param  hCmdHndlr - The object
+ * \return void
+ * \sa
+ */
+void cmdHndlr_PrintStat (TI_HANDLE hCmdHndlr)
+{
+#ifdef REPORT_LOG
+	TCmdHndlrObj    *pCmdHndlr = (TCmdHndlrObj *)hCmdHndlr;
+	TCmdLatencyStat *pStat;
+	TI_UINT32        i;
+
+	WLAN_OS_REPORT(("Command Handler Statistics:\n"));
+	WLAN_OS_REPORT(("===========================\n"));
+	WLAN_OS_REPORT(("Pool size = %d, Pool misses = %d, Timeouts = %d\n",
+	                CMD_POOL_SIZE, pCmdHndlr->uPoolMissCount, pCmdHndlr->uTimeoutCount));
+	WLAN_OS_REPORT(("Command     Count     Inline    Avg(us)   Max(us)\n"));
+
+	for (i = 0; i < CMD_STAT_TYPES; i++) {
+		pStat = &pCmdHndlr->aLatencyStat[i];
+		if (pStat->uCount == 0) {
+			continue;
+		}
+		WLAN_OS_REPORT(("0x%08x  %-8d  %-8d  %-8d  %-8d\n",
+		                pStat->uCmd, pStat->uCount, pStat->uSyncCount,
+		                pStat->uTotalUs / pStat->uCount, pStat->uMaxUs));
+	}
+#endif
+}
+
+
+/**
+ * \fn     cmdHndlr_AllocCmd
+ * \brief  Get a command structure
+ *
+ * Take a free slot from the commands pool, or allocate a new command and its
+ *     signal object if all the pool slots are in use.
+ *
+ * \note
+ * \param  pCmdHndlr - The object
+ * \return Pointer to a cleared command structure (NULL if failed)
+ * \sa     cmdHndlr_FreeCmd
+ */
+static TConfigCommand *cmdHndlr_AllocCmd (TCmdHndlrObj *pCmdHndlr)
+{
+	TConfigCommand *pCmd = NULL;
+	void           *pSignalObject;
+	TI_UINT32       i;
+
+	context_EnterCriticalSection (pCmdHndlr->hContext);
+	for (i = 0; i < CMD_POOL_SIZE; i++) {
+		if (!pCmdHndlr->aCmdPoolBusy[i]) {
+			pCmdHndlr->aCmdPoolBusy[i] = TI_TRUE;
+			pCmd = &pCmdHndlr->aCmdPool[i];
+			break;
+		}
+	}
+	if (pCmd == NULL) {
+		pCmdHndlr->uPoolMissCount++;
+	}
+	context_LeaveCriticalSection (pCmdHndlr->hContext);
+
+	/* Pool slot - clear it but keep its signal object */
+	if (pCmd != NULL) {
+		pSignalObject = pCmd->pSignalObject;
+		os_memoryZero (pCmdHndlr->hOs, (void *)pCmd, sizeof(TConfigCommand));
+		pCmd->pSignalObject = pSignalObject;
+		pCmd->bPooled = TI_TRUE;
+		return pCmd;
+	}
+
+	/* The pool is exhausted - allocate the command structure and its signal object */
+	pCmd = os_memoryAlloc (pCmdHndlr->hOs, sizeof (TConfigCommand));
+	if (pCmd == NULL) {
+		return NULL;
+	}
+	os_memoryZero (pCmdHndlr->hOs, (void *)pCmd, sizeof(TConfigCommand));
+
+	pCmd->pSignalObject = os_SignalObjectCreate (pCmdHndlr->hOs); /* initialize "complete-flag" */
+	if (pCmd->pSignalObject == NULL) {
+		os_printf("cmdPerform: Failed to create signalling object\n");
+		os_memoryFree (pCmdHndlr->hOs, pCmd, sizeof (TConfigCommand));
+		return NULL;
+	}
+
+	return pCmd;
+}
+
+
+/**
+ * \fn     cmdHndlr_FreeCmd
+ * \brief  Release a command structure
+ *
+ * Return a pool slot to the pool, or free a dynamically allocated command and its signal object.
+ *
+ * \note
+ * \param  pCmdHndlr - The object
+ * \param  pCmd      - The command to release
+ * \return void
+ * \sa     cmdHndlr_AllocCmd
+ */
+static void cmdHndlr_FreeCmd (TCmdHndlrObj *pCmdHndlr, TConfigCommand *pCmd)
+{
+	if (pCmd->bPooled) {
+		context_EnterCriticalSection (pCmdHndlr->hContext);
+		pCmdHndlr->aCmdPoolBusy[pCmd - pCmdHndlr->aCmdPool] = TI_FALSE;
+		context_LeaveCriticalSection (pCmdHndlr->hContext);
+		return;
+	}
+
+	os_SignalObjectFree (pCmdHndlr->hOs, pCmd->pSignalObject);
+	pCmd->pSignalObject = NULL;
+	os_memoryFree (pCmdHndlr->hOs, pCmd, sizeof (TConfigCommand));
+}
+
+
+/**
+ * \fn     cmdHndlr_SignalCmd
+ * \brief  Signal a command completion
+ *
+ * Signal the command completion to its caller, or release the command if its caller
+ *     timed out and stopped waiting (so a pool slot is not left busy).
+ *
+ * \note   The abandoned indication is checked and the signalling is indicated in critical
+ *             section, so either the caller keeps waiting for the signal or it never comes.
+ * \param  pCmdHndlr - The object
+ * \param  pCmd      - The completed command
+ * \return void
+ * \sa     cmdHndlr_HandleCommands, cmdHndlr_Complete
+ */
+static void cmdHndlr_SignalCmd (TCmdHndlrObj *pCmdHndlr, TConfigCommand *pCmd)
+{
+	TI_BOOL bAbandoned;
+
+	context_EnterCriticalSection (pCmdHndlr->hContext);
+	bAbandoned = pCmd->bAbandoned;
+	if (!bAbandoned) {
+		pCmd->bSignalled = TI_TRUE;
+	}
+	context_LeaveCriticalSection (pCmdHndlr->hContext);
+
+	if (bAbandoned) {
+		cmdHndlr_FreeCmd (pCmdHndlr, pCmd);
+		return;
+	}
+
+	wlanDrvIf_CommandDone (pCmdHndlr->hOs, pCmd->pSignalObject, pCmd->CmdRespBuffer);
+}
+
+
+/**
+ * \fn     cmdHndlr_UpdateStat
+ * \brief  Update the command type latency statistics
+ *
+ * \note   Called from the user context so the statistics are updated in critical section.
+ * \param  pCmdHndlr - The object
+ * \param  pCmd      - The completed command
+ * \param  bSync     - TRUE if the command was completed inline in the caller context
+ * \return void
+ * \sa     cmdHndlr_PrintStat
+ */
+static void cmdHndlr_UpdateStat (TCmdHndlrObj *pCmdHndlr, TConfigCommand *pCmd, TI_BOOL bSync)
+{
+	TCmdLatencyStat *pStat;
+	TI_UINT32        uLatency = os_timeStampUs (pCmdHndlr->hOs) - pCmd->uStartTimeUs;
+	TI_UINT32        i;
+
+	context_EnterCriticalSection (pCmdHndlr->hContext);
+
+	/* Find the command type entry, or the first free one (commands beyond the table size are not counted) */
+	for (i = 0; i < CMD_STAT_TYPES; i++) {
+		pStat = &pCmdHndlr->aLatencyStat[i];
+		if (pStat->uCmd == pCmd->cmd || pStat->uCmd == 0) {
+			pStat->uCmd = pCmd->cmd;
+			pStat->uCount++;
+			pStat->uTotalUs += uLatency;
+			if (uLatency > pStat->uMaxUs) {
+				pStat->uMaxUs = uLatency;
+			}
+			if (bSync) {
+				pStat->uSyncCount++;
+			}
+			break;
+		}
+	}
+
+	context_LeaveCriticalSection (pCmdHndlr->hContext);
+}
+
+
 /**
  * \fn     cmdHndlr_Enable & cmdHndlr_Disable
  * \brief  Enable/Disable invoking CmdHndlr module from driver-task
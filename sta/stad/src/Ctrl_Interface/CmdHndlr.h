@@ -56,6 +56,10 @@ typedef struct {
 	TI_UINT32   return_code;
 	TI_STATUS	eCmdStatus;                             /* (PEND / COMPLETE) */
 	TI_BOOL	    bWaitFlag; 	                            /* (TRUE / FALSE) */
+	TI_BOOL     bPooled;                                /* Taken from the preallocated commands pool */
+	TI_BOOL     bSignalled;                             /* The completion is being signalled to the caller */
+	TI_BOOL     bAbandoned;                             /* The caller timed out, release the command on completion */
+	TI_UINT32   uStartTimeUs;                           /* Insertion time stamp for latency statistics */
 	/*
 	 * TCmdRespUnion is defined for each OS:
 	 * For Linx and WM that defined is empty.
@@ -81,6 +85,7 @@ TI_STATUS cmdHndlr_InsertCommand (TI_HANDLE     hCmdHndlr,
 void      cmdHndlr_HandleCommands (TI_HANDLE hCmdHndlr);
 void      cmdHndlr_Complete (TI_HANDLE hCmdHndlr);
 void     *cmdHndlr_GetStat (TI_HANDLE hCmdHndlr);
+void      cmdHndlr_PrintStat (TI_HANDLE hCmdHndlr);
 void      cmdHndlr_Enable  (TI_HANDLE hCmdHndlr);
 void      cmdHndlr_Disable (TI_HANDLE hCmdHndlr);
 
@@ -52,4 +52,10 @@ void cmdInterpret_convertToOs (TI_HANDLE hCmdInterpret, TConfigCommand *cmdPtr);
 
 void *cmdInterpret_GetStat (TI_HANDLE hCmdInterpret);
 
+TI_BOOL cmdInterpret_IsSyncGet (TI_HANDLE hCmdInterpret, TConfigCommand *cmdObj);
+
+#ifdef TI_DBG
+void cmdInterpret_ScanCacheBenchmark (TI_HANDLE hOs, TI_UINT32 uNumBss);
+#endif
+
 #endif
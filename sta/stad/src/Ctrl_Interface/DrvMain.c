@@ -78,6 +78,10 @@
 #include "CmdDispatcher.h"
 #include "queue.h"
 #include "smeApi.h"
+#include "version.h"
+#ifdef TI_DBG
+#include "osDebug.h"
+#endif
 
 #include <linux/timer.h>
 
@@ -92,6 +96,12 @@
 
 #define PS_FAILED_COUNT_MAX	5
 
+#ifdef TI_DBG
+/* Suspend/resume latency histograms */
+#define SUSPEND_LATENCY_HIST_SIZE   8
+static const TI_UINT32 aSuspendLatencyHistLimit [SUSPEND_LATENCY_HIST_SIZE - 1] = {1000, 2000, 5000, 10000, 20000, 50000, 100000};
+#endif
+
 /* Handle failure status from the SM callbacks by triggering the SM with FAILURE event */
 #define HANDLE_CALLBACKS_FAILURE_STATUS(hDrvMain, eStatus)      \
             if (eStatus != TI_OK) { drvMain_SmEvent (hDrvMain, SM_EVENT_FAILURE);  return; }
@@ -139,6 +149,19 @@ typedef enum {
 
 } ESmEvent;
 
+/* The driver bring-up phases (time stamped for measuring the enable time) */
+typedef enum {
+	/*  0 */ DRV_PHASE_START,
+	/*  1 */ DRV_PHASE_INI_PARSED,
+	/*  2 */ DRV_PHASE_POWER_ON,
+	/*  3 */ DRV_PHASE_BUS_CONNECTED,
+	/*  4 */ DRV_PHASE_HW_INIT,
+	/*  5 */ DRV_PHASE_FW_DOWNLOAD,
+	/*  6 */ DRV_PHASE_FW_CONFIG,
+	DRV_PHASE_NUM
+
+} EDrvPhase;
+
 /* Action structure */
 typedef struct {
 	TQueNodeHdr     tQueNodeHdr;    /* The header used for queueing the action */
@@ -167,6 +190,16 @@ typedef struct {
 	TI_HANDLE         hPMTimer;     /* safety timer for suspend */
 	TI_UINT32         uLastStates;   /* The 4 last states visited by this SM */
 	TI_UINT32         uPSFailedCount; /* Number of consecutive PS_FAILED events when trying to suspend */
+	TI_UINT32         aPhaseTimeUs[DRV_PHASE_NUM]; /* Time stamps of the last bring-up phases */
+	TI_UINT32         uPhasesDone;  /* Bitmap of the phases time stamped in the last bring-up */
+	TI_BOOL           bIniBlob;     /* The last bring-up defaults were loaded from an init table blob */
+#ifdef TI_DBG
+	TI_UINT32         uSuspendFailures; /* Number of suspend actions that failed */
+	TI_UINT32         aSuspendLatencyHist[SUSPEND_LATENCY_HIST_SIZE]; /* Suspend action latency (usec) */
+	TI_UINT32         aResumeLatencyHist[SUSPEND_LATENCY_HIST_SIZE];  /* Resume action latency (usec) */
+	TI_UINT32         uMaxSuspendLatency;
+	TI_UINT32         uMaxResumeLatency;
+#endif
 } TDrvMain;
 
 
@@ -181,6 +214,14 @@ static void drvMain_ClearActionQueue (TDrvMain *pDrvMain);
 static void drvMain_SmEvent (TI_HANDLE hDrvMain, ESmEvent eEvent);
 static void drvMain_Sm (TI_HANDLE hDrvMain, ESmEvent eEvent);
 static void drvMain_ClearQueuedEvents (TDrvMain *pDrvMain);
+static void drvMain_BringupStart (TDrvMain *pDrvMain);
+static void drvMain_PhaseDone (TDrvMain *pDrvMain, EDrvPhase ePhase);
+static TI_BOOL drvMain_LoadInitTableBlob (TI_HANDLE hOs, TInitTable *pInitTable, TI_UINT8 *pBuf, TI_UINT32 uLength,
+                                          TI_UINT8 **ppIniText, TI_UINT32 *pIniLength);
+static TI_UINT32 drvMain_InitTableBlobVersion (void);
+#ifdef TI_DBG
+static void drvMain_UpdateSuspendStats (TDrvMain *pDrvMain, EActionType eAction, TI_STATUS eStatus, TI_UINT32 uLatency);
+#endif
 /* External functions prototypes */
 
 /** \brief WLAN Driver I/F Get file
@@ -235,6 +276,21 @@ extern void wlanDrvIf_SetMacAddress (TI_HANDLE hOs, TI_UINT8 *pMacAddr);
  * \sa
  */
 extern int  osInitTable_IniFile (TI_HANDLE hOs, TInitTable *InitTable, char *file_buf, int file_length);
+/** \brief OS Init Table INI File Check
+ *
+ * \param  hOs              - OS module object handle
+ * \param  InitTable        - Pointer to initialization table
+ * \param  file_buf         - Pointer to Input buffer from INI file
+ * \param  file_length      - Length of input buffer from INI file
+ * \return The number of errors found in the INI file
+ *
+ * \par Description
+ * This function parses the INI file as osInitTable_IniFile, reports its invalid values and lines,
+ * and warns on the parameters not read by the driver
+ *
+ * \sa
+ */
+extern int  osInitTable_IniFileCheck (TI_HANDLE hOs, TInitTable *InitTable, char *file_buf, int file_length);
 
 
 
@@ -799,6 +855,7 @@ static void drvMain_Init (TI_HANDLE hDrvMain)
 	 */
 	context_Init (pModules->hContext, pModules->hOs, pModules->hReport, hDrvMain);
 	tmr_Init (pModules->hTimer, pModules->hOs, pModules->hReport, pModules->hContext);
+	EvHandler_Init (pModules->hEvHandler, pModules->hTimer);
 	txnQ_Init (pModules->hTxnQ, pModules->hOs, pModules->hReport, pModules->hContext);
 	scr_init (pModules);
 	conn_init (pModules);
@@ -867,7 +924,9 @@ static void drvMain_Init (TI_HANDLE hDrvMain)
  * Configure all STAD and TWD modules with their default settings from the ini-file.
  * Timers creation is also done at this stage.
  *
- * \note
+ * \note   If the ini-file is a valid init table blob (see drvMain_CompileIniFile) its image is copied as is.
+ *         The ini-file text embedded in a blob of another driver build is parsed instead of its image.
+ *         A corrupted blob is never parsed, the driver defaults are used and TI_NOK is returned.
  * \param  hDrvMain - The DrvMain object
  * \param  pBuf     - The ini-file data.
  * \param  uLength  - The ini-file length.
@@ -878,6 +937,8 @@ static TI_STATUS drvMain_SetDefaults (TI_HANDLE hDrvMain, TI_UINT8 *pBuf, TI_UIN
 {
 	TDrvMain   *pDrvMain = (TDrvMain *) hDrvMain;
 	TInitTable *pInitTable;
+	TI_UINT8   *pIniText;
+	TI_UINT32   uIniLength;
 	TI_STATUS   eStatus;
 
 	pInitTable = os_memoryAlloc (pDrvMain->tStadHandles.hOs, sizeof(TInitTable));
@@ -887,8 +948,18 @@ static TI_STATUS drvMain_SetDefaults (TI_HANDLE hDrvMain, TI_UINT8 *pBuf, TI_UIN
 		return TI_NOK;
 	}
 
-	/* Parse defaults */
-	eStatus = osInitTable_IniFile (pDrvMain->tStadHandles.hOs, pInitTable, (char*)pBuf, (int)uLength);
+	/* Load the pre-parsed defaults if provided, or parse the ini-file text */
+	pDrvMain->bIniBlob = drvMain_LoadInitTableBlob (pDrvMain->tStadHandles.hOs, pInitTable, pBuf, uLength,
+	                     &pIniText, &uIniLength);
+	if (pDrvMain->bIniBlob) {
+		eStatus = TI_OK;
+	} else if (pIniText != NULL) {
+		eStatus = osInitTable_IniFile (pDrvMain->tStadHandles.hOs, pInitTable, (char*)pIniText, (int)uIniLength);
+	} else {
+		WLAN_OS_REPORT(("drvMain_SetDefaults: Corrupted init table blob, using the driver defaults. Reload the ini-file!\n"));
+		osInitTable_IniFile (pDrvMain->tStadHandles.hOs, pInitTable, NULL, 0);
+		eStatus = TI_NOK;
+	}
 
 	/*
 	 *  Configure modules with their default settings
@@ -900,6 +971,7 @@ static TI_STATUS drvMain_SetDefaults (TI_HANDLE hDrvMain, TI_UINT8 *pBuf, TI_UIN
 	ctrlData_SetDefaults (pDrvMain->tStadHandles.hCtrlData, &pInitTable->ctrlDataInitParams);
 	regulatoryDomain_SetDefaults (pDrvMain->tStadHandles.hRegulatoryDomain, &pInitTable->regulatoryDomainInitParams);
 	scanCncn_SetDefaults (pDrvMain->tStadHandles.hScanCncn, &pInitTable->tScanCncnInitParams);
+	EvHandler_SetDefaults (pDrvMain->tStadHandles.hEvHandler, &pInitTable->tEvHandlerInitParams);
 	auth_SetDefaults (pDrvMain->tStadHandles.hAuth, &pInitTable->authInitParams);
 	assoc_SetDefaults (pDrvMain->tStadHandles.hAssoc, &pInitTable->assocInitParams);
 	rxData_SetDefaults (pDrvMain->tStadHandles.hRxData, &pInitTable->rxDataInitParams);
@@ -938,6 +1010,201 @@ static TI_STATUS drvMain_SetDefaults (TI_HANDLE hDrvMain, TI_UINT8 *pBuf, TI_UIN
 }
 
 
+/*
+ * \fn     drvMain_InitTableChecksum
+ * \brief  Calculate the Adler-32 checksum of an init table image
+ *
+ * \note
+ * \param  pBuf    - The init table image
+ * \param  uLength - The image length
+ * \return The checksum
+ * \sa     drvMain_LoadInitTableBlob, drvMain_CompileIniFile
+ */
+static TI_UINT32 drvMain_InitTableChecksum (TI_UINT8 *pBuf, TI_UINT32 uLength)
+{
+	TI_UINT32 uA = 1;
+	TI_UINT32 uB = 0;
+	TI_UINT32 uBlock;
+
+	while (uLength) {
+		/* Defer the modulo for as many bytes as the sums can't overflow */
+		uBlock = (uLength < 5552) ? uLength : 5552;
+		uLength -= uBlock;
+		while (uBlock--) {
+			uA += *pBuf++;
+			uB += uA;
+		}
+		uA %= 65521;
+		uB %= 65521;
+	}
+
+	return (uB << 16) | uA;
+}
+
+/*
+ * \fn     drvMain_InitTableBlobVersion
+ * \brief  Get the init table blob version of this driver build
+ *
+ * The build sets INIT_TABLE_BLOB_VERSION from a checksum of the init table sources and the build defines.
+ * Otherwise the version is derived from the driver SW version and the debug configuration.
+ *
+ * \note
+ * \return The blob version
+ * \sa     drvMain_LoadInitTableBlob, drvMain_CompileIniFile
+ */
+static TI_UINT32 drvMain_InitTableBlobVersion (void)
+{
+#ifdef INIT_TABLE_BLOB_VERSION
+	return INIT_TABLE_BLOB_VERSION;
+#else
+#ifdef TI_DBG
+	static const char aVersion[] = SW_VERSION_STR "-dbg";
+#else
+	static const char aVersion[] = SW_VERSION_STR;
+#endif
+
+	return drvMain_InitTableChecksum ((TI_UINT8 *)aVersion, sizeof(aVersion) - 1);
+#endif
+}
+
+/*
+ * \fn     drvMain_LoadInitTableBlob
+ * \brief  Load the defaults from an init table blob
+ *
+ * Check if the ini-file is an init table blob compiled by this driver build.
+ * If so, copy its init table image. Otherwise provide the ini-file text to parse:
+ *     the ini-file itself if it isn't a blob, or the text embedded in a blob of another driver build.
+ *
+ * \note   A blob is never provided as text. If the blob is corrupted no text is provided.
+ * \param  hOs        - The OS object
+ * \param  pInitTable - The init table to fill
+ * \param  pBuf       - The ini-file data
+ * \param  uLength    - The ini-file length
+ * \param  ppIniText  - Output: The ini-file text to parse if the image wasn't loaded, NULL if none
+ * \param  pIniLength - Output: The ini-file text length
+ * \return TI_TRUE if the init table was loaded from the blob, TI_FALSE otherwise
+ * \sa     drvMain_SetDefaults, drvMain_CompileIniFile
+ */
+static TI_BOOL drvMain_LoadInitTableBlob (TI_HANDLE hOs, TInitTable *pInitTable, TI_UINT8 *pBuf, TI_UINT32 uLength,
+                                          TI_UINT8 **ppIniText, TI_UINT32 *pIniLength)
+{
+	TInitTableBlobHdr tHdr;
+	TI_UINT8         *pImage = pBuf + sizeof(TInitTableBlobHdr);
+
+	*ppIniText  = pBuf;
+	*pIniLength = uLength;
+
+	if ((pBuf == NULL) || (uLength < sizeof(TInitTableBlobHdr))) {
+		return TI_FALSE;
+	}
+
+	os_memoryCopy (hOs, &tHdr, pBuf, sizeof(TInitTableBlobHdr));
+	if (tHdr.uMagic != INIT_TABLE_BLOB_MAGIC) {
+		return TI_FALSE;
+	}
+
+	/* From here on the ini-file is a blob, so it's never parsed as text */
+	*ppIniText  = NULL;
+	*pIniLength = 0;
+
+	if ((tHdr.uTableSize > uLength) || (tHdr.uIniLength > uLength) || (uLength != INIT_TABLE_BLOB_LENGTH(&tHdr))) {
+		WLAN_OS_REPORT(("drvMain_LoadInitTableBlob: Blob length %d doesn't match its header\n", uLength));
+		return TI_FALSE;
+	}
+
+	if ((drvMain_InitTableChecksum (pImage, tHdr.uTableSize + tHdr.uIniLength + 1) != tHdr.uChecksum) ||
+	        (pImage[tHdr.uTableSize + tHdr.uIniLength] != '\0')) {
+		WLAN_OS_REPORT(("drvMain_LoadInitTableBlob: Blob checksum error\n"));
+		return TI_FALSE;
+	}
+
+	if ((tHdr.uVersion != drvMain_InitTableBlobVersion ()) || (tHdr.uTableSize != sizeof(TInitTable))) {
+		WLAN_OS_REPORT(("drvMain_LoadInitTableBlob: Blob version 0x%x size %d doesn't match driver version 0x%x size %d, parsing its ini-file text\n",
+		                tHdr.uVersion, tHdr.uTableSize, drvMain_InitTableBlobVersion (), sizeof(TInitTable)));
+		*ppIniText  = pImage + tHdr.uTableSize;
+		*pIniLength = tHdr.uIniLength;
+		return TI_FALSE;
+	}
+
+	os_memoryCopy (hOs, pInitTable, pImage, sizeof(TInitTable));
+
+#ifdef TI_DBG
+	/* The debug flags are not part of the init table, so restore them as the text parser would */
+	TiDebugFlag = tHdr.uDbgState;
+#endif
+
+	return TI_TRUE;
+}
+
+/*
+ * \fn     drvMain_CompileIniFile
+ * \brief  Compile an ini-file to an init table blob
+ *
+ * Parse the ini-file, reporting its errors and the parameters not read by the driver,
+ *     and build the init table blob that drvMain_SetDefaults loads instead of parsing the text.
+ * The ini-file text is embedded in the blob, so a driver of another build can still parse it.
+ * A blob of this driver build is copied as is, and a blob of another build is recompiled from its text.
+ *
+ * \note   Called by the loader before the driver is started (the ini-file parser is not reentrant).
+ * \param  hOs          - The OS object
+ * \param  pIniFile     - The ini-file data
+ * \param  uIniLength   - The ini-file length
+ * \param  pBlob        - The output blob buffer, at least INIT_TABLE_BLOB_MAX_LENGTH(uIniLength) bytes
+ * \param  uBlobLength  - The output buffer length
+ * \return TI_OK if the ini-file was compiled with no errors, TI_NOK otherwise
+ * \sa     drvMain_LoadInitTableBlob
+ */
+TI_STATUS drvMain_CompileIniFile (TI_HANDLE hOs, TI_UINT8 *pIniFile, TI_UINT32 uIniLength, TI_UINT8 *pBlob, TI_UINT32 uBlobLength)
+{
+	TInitTableBlobHdr  tHdr;
+	TInitTable        *pInitTable;
+	TI_UINT8          *pIniText;
+	TI_UINT32          uTextLength;
+	int                iErrors;
+
+	if (uBlobLength < INIT_TABLE_BLOB_MAX_LENGTH(uIniLength)) {
+		WLAN_OS_REPORT(("drvMain_CompileIniFile: Blob buffer too short (%d < %d)\n",
+		                uBlobLength, INIT_TABLE_BLOB_MAX_LENGTH(uIniLength)));
+		return TI_NOK;
+	}
+
+	pInitTable = (TInitTable *)(pBlob + sizeof(TInitTableBlobHdr));
+
+	if (drvMain_LoadInitTableBlob (hOs, pInitTable, pIniFile, uIniLength, &pIniText, &uTextLength)) {
+		os_memoryCopy (hOs, pBlob, pIniFile, uIniLength);
+		return TI_OK;
+	}
+	if (pIniText == NULL) {
+		WLAN_OS_REPORT(("drvMain_CompileIniFile: Corrupted init table blob, load the ini-file text\n"));
+		return TI_NOK;
+	}
+
+	iErrors = osInitTable_IniFileCheck (hOs, pInitTable, (char*)pIniText, (int)uTextLength);
+	if (iErrors != 0) {
+		WLAN_OS_REPORT(("drvMain_CompileIniFile: %d errors found in the ini-file\n", iErrors));
+		return TI_NOK;
+	}
+
+	/* Append the ini-file text (it may be in the input blob, which is not the output buffer) */
+	os_memoryCopy (hOs, (TI_UINT8 *)pInitTable + sizeof(TInitTable), pIniText, uTextLength);
+	((TI_UINT8 *)pInitTable)[sizeof(TInitTable) + uTextLength] = '\0';
+
+	tHdr.uMagic     = INIT_TABLE_BLOB_MAGIC;
+	tHdr.uVersion   = drvMain_InitTableBlobVersion ();
+	tHdr.uTableSize = sizeof(TInitTable);
+	tHdr.uIniLength = uTextLength;
+	tHdr.uChecksum  = drvMain_InitTableChecksum ((TI_UINT8 *)pInitTable, sizeof(TInitTable) + uTextLength + 1);
+#ifdef TI_DBG
+	tHdr.uDbgState  = (TI_UINT32)TiDebugFlag; /* Read from the ini-file by the parser */
+#else
+	tHdr.uDbgState  = 0;
+#endif
+	os_memoryCopy (hOs, pBlob, &tHdr, sizeof(TInitTableBlobHdr));
+
+	return TI_OK;
+}
+
+
 /*
  * \fn     drvMain_xxx...Cb
  * \brief  Callback functions for the init/stop stages completion
@@ -1095,6 +1362,8 @@ static void drvMain_InitLocals (TDrvMain *pDrvMain)
 	pDrvMain->bWasOperational       = TI_FALSE;
 	pDrvMain->uLastStates           = 0;
 	pDrvMain->uPSFailedCount        = 0;
+	pDrvMain->uPhasesDone           = 0;
+	pDrvMain->bIniBlob              = TI_FALSE;
 
 	/* Create and initialize the actions queue */
 	pDrvMain->hActionQueue = que_Create (pDrvMain->tStadHandles.hOs,
@@ -1115,6 +1384,40 @@ static void drvMain_InitLocals (TDrvMain *pDrvMain)
 	}
 
 
+/*
+ * \fn     drvMain_BringupStart
+ * \brief  Start a bring-up sequence
+ *
+ * Restart the phases time stamps.
+ *
+ * \note
+ * \param  pDrvMain - The DrvMain object
+ * \return void
+ * \sa     drvMain_Sm
+ */
+static void drvMain_BringupStart (TDrvMain *pDrvMain)
+{
+	pDrvMain->uPhasesDone = 0;
+	drvMain_PhaseDone (pDrvMain, DRV_PHASE_START);
+}
+
+/*
+ * \fn     drvMain_PhaseDone
+ * \brief  Time stamp a bring-up phase completion
+ *
+ * \note
+ * \param  pDrvMain - The DrvMain object
+ * \param  ePhase   - The completed phase
+ * \return void
+ * \sa     drvMain_PrintBringupTimes
+ */
+static void drvMain_PhaseDone (TDrvMain *pDrvMain, EDrvPhase ePhase)
+{
+	pDrvMain->aPhaseTimeUs[ePhase] = os_timeStampUs (pDrvMain->tStadHandles.hOs);
+	pDrvMain->uPhasesDone |= (1 << ePhase);
+}
+
+
 /*
  * \fn     drvMain_InitHw & drvMain_InitFw
  * \brief  Init HW and Init FW sequences
@@ -1310,6 +1613,10 @@ TI_STATUS drvMain_InsertAction (TI_HANDLE hDrvMain, EActionType eAction)
 {
 	TDrvMain      *pDrvMain = (TDrvMain *)hDrvMain;
 	TActionObject *pNewAction;
+	TI_STATUS      eStatus = TI_OK;
+#ifdef TI_DBG
+	TI_UINT32      uStartTime = os_timeStampUs (pDrvMain->tStadHandles.hOs);
+#endif
 
 
 	/* Can't suspend if recovery is in progress */
@@ -1363,20 +1670,102 @@ TI_STATUS drvMain_InsertAction (TI_HANDLE hDrvMain, EActionType eAction)
 
 	/* Driver is still in operational mode after a suspend action. This means that the
            suspend failed. Tell caller that suspend failed */
-	if (eAction == ACTION_TYPE_SUSPEND && pDrvMain->eSmState == SM_STATE_OPERATIONAL)
-		return TI_NOK;
+	if (eAction == ACTION_TYPE_SUSPEND && pDrvMain->eSmState == SM_STATE_OPERATIONAL) {
+		eStatus = TI_NOK;
+	}
 
 	if (pDrvMain->eSmState == SM_STATE_FAILED) {
-		return TI_NOK;
+		eStatus = TI_NOK;
 	}
 
 	/* If recovery happened while trying to suspend return an error */
 	if (eAction == ACTION_TYPE_SUSPEND && pDrvMain->bRecovery) {
-		return TI_NOK;
+		eStatus = TI_NOK;
 	}
 
-	return TI_OK;
+#ifdef TI_DBG
+	drvMain_UpdateSuspendStats (pDrvMain, eAction, eStatus,
+	                            os_timeStampUs (pDrvMain->tStadHandles.hOs) - uStartTime);
+#endif
+
+	return eStatus;
+}
+
+
+#ifdef TI_DBG
+/*
+ * \fn     drvMain_UpdateSuspendStats
+ * \brief  Update the suspend/resume latency histograms
+ *
+ * The latency is measured from the action insertion until the caller is released.
+ *
+ * \note
+ * \param  pDrvMain - The DrvMain object
+ * \param  eAction  - The completed action (only suspend and resume are accounted)
+ * \param  eStatus  - The action result
+ * \param  uLatency - The action latency in usec
+ * \return void
+ * \sa     drvMain_PrintSuspendStats
+ */
+static void drvMain_UpdateSuspendStats (TDrvMain *pDrvMain, EActionType eAction, TI_STATUS eStatus, TI_UINT32 uLatency)
+{
+	TI_UINT32 *pHist;
+	TI_UINT32 *pMax;
+	TI_UINT32  uBin;
+
+	if (eAction == ACTION_TYPE_SUSPEND) {
+		if (eStatus != TI_OK) {
+			pDrvMain->uSuspendFailures++;
+			return;
+		}
+		pHist = pDrvMain->aSuspendLatencyHist;
+		pMax  = &pDrvMain->uMaxSuspendLatency;
+	} else if (eAction == ACTION_TYPE_RESUME) {
+		pHist = pDrvMain->aResumeLatencyHist;
+		pMax  = &pDrvMain->uMaxResumeLatency;
+	} else {
+		return;
+	}
+
+	for (uBin = 0; uBin < SUSPEND_LATENCY_HIST_SIZE - 1; uBin++) {
+		if (uLatency < aSuspendLatencyHistLimit[uBin])
+			break;
+	}
+	pHist[uBin]++;
+	if (uLatency > *pMax) {
+		*pMax = uLatency;
+	}
+}
+
+/*
+ * \fn     drvMain_PrintSuspendStats
+ * \brief  Print the suspend/resume latency histograms
+ *
+ * \note
+ * \param  hDrvMain - The DrvMain object
+ * \return void
+ * \sa     drvMain_UpdateSuspendStats
+ */
+void drvMain_PrintSuspendStats (TI_HANDLE hDrvMain)
+{
+	TDrvMain  *pDrvMain = (TDrvMain *)hDrvMain;
+	TI_UINT32  uBin;
+
+	WLAN_OS_REPORT(("Latency (usec)         Suspend     Resume\n"));
+	WLAN_OS_REPORT(("-----------------------------------------\n"));
+	for (uBin = 0; uBin < SUSPEND_LATENCY_HIST_SIZE; uBin++) {
+		if (uBin < SUSPEND_LATENCY_HIST_SIZE - 1) {
+			WLAN_OS_REPORT(("  < %6d          %10d %10d\n", aSuspendLatencyHistLimit[uBin],
+			                pDrvMain->aSuspendLatencyHist[uBin], pDrvMain->aResumeLatencyHist[uBin]));
+		} else {
+			WLAN_OS_REPORT((" >= %6d          %10d %10d\n", aSuspendLatencyHistLimit[uBin - 1],
+			                pDrvMain->aSuspendLatencyHist[uBin], pDrvMain->aResumeLatencyHist[uBin]));
+		}
+	}
+	WLAN_OS_REPORT(("  max             %10d %10d\n", pDrvMain->uMaxSuspendLatency, pDrvMain->uMaxResumeLatency));
+	WLAN_OS_REPORT(("Failed suspends: %d\n", pDrvMain->uSuspendFailures));
 }
+#endif
 
 
 /*
@@ -1413,6 +1802,44 @@ TI_STATUS drvMain_Recovery (TI_HANDLE hDrvMain)
 }
 
 
+/*
+ * \fn     drvMain_DataPathReset
+ * \brief  Reset the host Tx data-path without stopping the FW
+ *
+ * Lightweight recovery for data-path failures (Tx stuck), used by the
+ *   Health-Monitor before escalating to a full recovery:
+ *   - Free all packets queued in the host Tx queues (they are stale by now).
+ *   - Request FW status read, so pending Tx results are handled and the Tx-HW-Queue
+ *       free blocks are resynchronized with the FW counters.
+ * The caller verifies that the FW still responds (see healthMonitor_StartDataPathReset).
+ * The bus transactions queue is not restarted, since in-flight transactions can't be
+ *   dropped while the FW is running.
+ *
+ * \note
+ * \param  hDrvMain - The DrvMain object
+ * \return TI_OK if the data-path was reset, TI_NOK if the driver is not operational
+ *         or a recovery is in progress (a full recovery is needed).
+ * \sa     drvMain_Recovery
+ */
+TI_STATUS drvMain_DataPathReset (TI_HANDLE hDrvMain)
+{
+	TDrvMain         *pDrvMain = (TDrvMain *) hDrvMain;
+
+	if (pDrvMain->bRecovery || (pDrvMain->eSmState != SM_STATE_OPERATIONAL)) {
+		return TI_NOK;
+	}
+
+	WLAN_OS_REPORT((".....drvMain_DataPathReset, ts=%d\n", os_timeStampMs(pDrvMain->tStadHandles.hOs)));
+
+	txMgmtQ_ClearQueues (pDrvMain->tStadHandles.hTxMgmtQ);
+	txDataQ_ClearQueues (pDrvMain->tStadHandles.hTxDataQ);
+
+	TWD_InterruptRequest (pDrvMain->tStadHandles.hTWD);
+
+	return TI_OK;
+}
+
+
 /*
  * \fn     drvMain_RecoveryNotify
  * \brief  Notify STAD modules about recovery
@@ -1429,6 +1856,7 @@ static void drvMain_RecoveryNotify (TDrvMain *pDrvMain)
 	txCtrl_NotifyFwReset (pDrvMain->tStadHandles.hTxCtrl);
 	scr_notifyFWReset (pDrvMain->tStadHandles.hSCR);
 	PowerMgr_notifyFWReset (pDrvMain->tStadHandles.hPowerMgr);
+	healthMonitor_RecoveryComplete (pDrvMain->tStadHandles.hHealthMonitor, TI_TRUE);
 
 	WLAN_OS_REPORT((".....drvMain_RecoveryNotify: End Of Recovery, ts=%d\n", os_timeStampMs(pDrvMain->tStadHandles.hOs)));
 }
@@ -1549,6 +1977,7 @@ static void drvMain_Sm (TI_HANDLE hDrvMain, ESmEvent eEvent)
 	 *         option of completion in a later context is only for future use.
 	 *  4) All processes (Start, Stop, Relcovery) are protected by a watchdog timer to let
 	 *         the user free the driver in case of deadlock during the process.
+	 *  5) The ini-file is parsed while the device powers up, since they don't depend on each other.
 	 */
 
 	switch (pDrvMain->eSmState) {
@@ -1560,6 +1989,7 @@ static void drvMain_Sm (TI_HANDLE hDrvMain, ESmEvent eEvent)
 		if (eEvent == SM_EVENT_START) {
 			drvMain_ChangeState(pDrvMain,SM_STATE_WAIT_INI_FILE);
 			context_DisableClient (pDrvMain->tStadHandles.hContext, pDrvMain->uContextId);
+			drvMain_BringupStart (pDrvMain);
 			pDrvMain->tFileInfo.eFileType = FILE_TYPE_INI;
 			eStatus = wlanDrvIf_GetFile (hOs, &pDrvMain->tFileInfo);
 		}
@@ -1567,13 +1997,16 @@ static void drvMain_Sm (TI_HANDLE hDrvMain, ESmEvent eEvent)
 	case SM_STATE_WAIT_INI_FILE:
 		/*
 		 * We've got the ini-file.
-		 * Set STAD and TWD modules defaults according to the ini-file,
-		 *     turn on the device and request for the NVS file.
+		 * Turn on the device, and while it settles set STAD and TWD modules defaults
+		 *     according to the ini-file. Then request for the NVS file.
 		 */
 		if (eEvent == SM_EVENT_INI_FILE_READY) {
 			drvMain_ChangeState(pDrvMain,SM_STATE_WAIT_NVS_FILE);
+			hPlatform_DevicePowerOnStart (pDrvMain->tStadHandles.hOs);
 			drvMain_SetDefaults (hDrvMain, pDrvMain->tFileInfo.pBuffer, pDrvMain->tFileInfo.uLength);
-			hPlatform_DevicePowerOn (pDrvMain->tStadHandles.hOs);
+			drvMain_PhaseDone (pDrvMain, DRV_PHASE_INI_PARSED);
+			hPlatform_DevicePowerOnComplete (pDrvMain->tStadHandles.hOs);
+			drvMain_PhaseDone (pDrvMain, DRV_PHASE_POWER_ON);
 
 			pDrvMain->tFileInfo.eFileType = FILE_TYPE_NVS;
 			eStatus = wlanDrvIf_GetFile (hOs, &pDrvMain->tFileInfo);
@@ -1610,6 +2043,7 @@ static void drvMain_Sm (TI_HANDLE hDrvMain, ESmEvent eEvent)
 			 * Start HW-Init process providing the NVS file.
 			 */
 			if (eEvent == SM_EVENT_NVS_FILE_READY) {
+				drvMain_PhaseDone (pDrvMain, DRV_PHASE_BUS_CONNECTED);
 				drvMain_ChangeState(pDrvMain,SM_STATE_HW_INIT);
 				eStatus = drvMain_InitHw (hDrvMain, pDrvMain->tFileInfo.pBuffer, pDrvMain->tFileInfo.uLength);
 			}
@@ -1622,6 +2056,7 @@ static void drvMain_Sm (TI_HANDLE hDrvMain, ESmEvent eEvent)
 		 */
 		if (eEvent == SM_EVENT_HW_INIT_COMPLETE) {
 			pDrvMain->tFileInfo.eFileType = FILE_TYPE_FW;
+			drvMain_PhaseDone (pDrvMain, DRV_PHASE_HW_INIT);
 			drvMain_ChangeState(pDrvMain,SM_STATE_DOWNLOAD_FW_FILE);
 			eStatus = wlanDrvIf_GetFile (hOs, &pDrvMain->tFileInfo);
 		}
@@ -1658,6 +2093,7 @@ static void drvMain_Sm (TI_HANDLE hDrvMain, ESmEvent eEvent)
 		 *     interrupts, and the interrupts are needed for the configuration process!
 		 */
 		if (eEvent == SM_EVENT_FW_INIT_COMPLETE) {
+			drvMain_PhaseDone (pDrvMain, DRV_PHASE_FW_DOWNLOAD);
 			drvMain_ChangeState(pDrvMain,SM_STATE_FW_CONFIG);
 			if (!pDrvMain->bRecovery) {
 				/*update the state before unblocking the application so command will not be rejected*/
@@ -1684,6 +2120,11 @@ static void drvMain_Sm (TI_HANDLE hDrvMain, ESmEvent eEvent)
 		 */
 
 		if (eEvent == SM_EVENT_FW_CONFIG_COMPLETE) {
+			drvMain_PhaseDone (pDrvMain, DRV_PHASE_FW_CONFIG);
+#ifdef TI_DBG
+			WLAN_OS_REPORT(("Driver enable time: %d ms\n",
+			                (pDrvMain->aPhaseTimeUs[DRV_PHASE_FW_CONFIG] - pDrvMain->aPhaseTimeUs[DRV_PHASE_START]) / 1000));
+#endif
 			drvMain_ChangeState(pDrvMain,SM_STATE_OPERATIONAL);
 			if (pDrvMain->bRecovery) {
 				pDrvMain->uNumOfRecoveryAttempts = 0;
@@ -1796,6 +2237,7 @@ static void drvMain_Sm (TI_HANDLE hDrvMain, ESmEvent eEvent)
 			txnQ_DisconnectBus (pDrvMain->tStadHandles.hTxnQ);
 			hPlatform_DevicePowerOff (pDrvMain->tStadHandles.hOs);
 			if (pDrvMain->bRecovery) {
+				drvMain_BringupStart (pDrvMain);
 				hPlatform_DevicePowerOn(
 					pDrvMain->tStadHandles.hOs);
 				drvMain_ChangeState(pDrvMain,SM_STATE_WAIT_NVS_FILE);
@@ -1822,6 +2264,7 @@ static void drvMain_Sm (TI_HANDLE hDrvMain, ESmEvent eEvent)
 		 */
 		if (eEvent == SM_EVENT_START) {
 			context_DisableClient (pDrvMain->tStadHandles.hContext, pDrvMain->uContextId);
+			drvMain_BringupStart (pDrvMain);
 			hPlatform_DevicePowerOn (pDrvMain->tStadHandles.hOs);
 			drvMain_ChangeState(pDrvMain,SM_STATE_WAIT_NVS_FILE);
 			pDrvMain->tFileInfo.eFileType = FILE_TYPE_NVS;
@@ -1838,6 +2281,7 @@ static void drvMain_Sm (TI_HANDLE hDrvMain, ESmEvent eEvent)
 
 				/* we have to start the chip, to be OPERATIONAL again */
 				context_DisableClient (pDrvMain->tStadHandles.hContext, pDrvMain->uContextId);
+				drvMain_BringupStart (pDrvMain);
 				hPlatform_DevicePowerOn(
 					pDrvMain->tStadHandles.hOs);
 				drvMain_ChangeState(pDrvMain,SM_STATE_WAIT_NVS_FILE);
@@ -1868,9 +2312,10 @@ static void drvMain_Sm (TI_HANDLE hDrvMain, ESmEvent eEvent)
 			pDrvMain->uNumOfRecoveryAttempts++;
 			drvMain_ChangeState(pDrvMain,SM_STATE_STOPPING);
 			eStatus = drvMain_StopActivities (pDrvMain);
-		}
-		else
+		} else {
+			healthMonitor_RecoveryComplete (pDrvMain->tStadHandles.hHealthMonitor, TI_FALSE);
 			WLAN_OS_REPORT(("[WLAN] Exit application\n"));
+		}
 		break;
 	case SM_STATE_FAILED:
 		/* Nothing to do except waiting for Destroy */
@@ -1985,3 +2430,136 @@ static void drvMain_Sm (TI_HANDLE hDrvMain, ESmEvent eEvent)
 
 
 
+
+#ifdef TI_DBG
+/*
+ * \fn     drvMain_PrintBringupTimes
+ * \brief  Print the last bring-up phases time stamps
+ *
+ * Print each phase completion time relative to the bring-up start and to the previous phase.
+ * Phases not passed in the last bring-up (e.g. the ini-file parsing on recovery) are skipped.
+ *
+ * \note
+ * \param  hDrvMain - The DrvMain object
+ * \return void
+ * \sa     drvMain_PhaseDone
+ */
+void drvMain_PrintBringupTimes (TI_HANDLE hDrvMain)
+{
+	TDrvMain  *pDrvMain = (TDrvMain *)hDrvMain;
+	static const char *aPhaseName[DRV_PHASE_NUM] = {
+		"Start", "Ini parsed", "Power on", "Bus connected", "HW init", "FW download", "FW config"
+	};
+	TI_UINT32  uPrevTime;
+	TI_UINT32  uPhase;
+
+	if (!(pDrvMain->uPhasesDone & (1 << DRV_PHASE_START))) {
+		WLAN_OS_REPORT(("No bring-up was done\n"));
+		return;
+	}
+
+	WLAN_OS_REPORT(("Bring-up phases (usec):   Total    Delta\n"));
+	WLAN_OS_REPORT(("---------------------------------------\n"));
+	uPrevTime = pDrvMain->aPhaseTimeUs[DRV_PHASE_START];
+	for (uPhase = DRV_PHASE_START + 1; uPhase < DRV_PHASE_NUM; uPhase++) {
+		if (pDrvMain->uPhasesDone & (1 << uPhase)) {
+			WLAN_OS_REPORT(("%-22s %8d %8d\n", aPhaseName[uPhase],
+			                pDrvMain->aPhaseTimeUs[uPhase] - pDrvMain->aPhaseTimeUs[DRV_PHASE_START],
+			                pDrvMain->aPhaseTimeUs[uPhase] - uPrevTime));
+			uPrevTime = pDrvMain->aPhaseTimeUs[uPhase];
+		}
+	}
+	if (pDrvMain->uPhasesDone & (1 << DRV_PHASE_INI_PARSED)) {
+		WLAN_OS_REPORT(("Defaults loaded from the ini-file %s\n", pDrvMain->bIniBlob ? "blob" : "text"));
+	}
+	if (!(pDrvMain->uPhasesDone & (1 << DRV_PHASE_FW_CONFIG))) {
+		WLAN_OS_REPORT(("Bring-up not completed, SM state %d\n", pDrvMain->eSmState));
+	}
+}
+
+/*
+ * \fn     drvMain_BenchInitTable
+ * \brief  Measure the defaults loading time from the ini-file text and from its blob
+ *
+ * Load the current ini-file defaults the given number of times by parsing the text,
+ *     then compile it to a blob and load the blob the same number of times.
+ * The init table is only filled, the modules defaults are not changed.
+ *
+ * \note   Don't use while the driver is being started (the ini-file parser is not reentrant).
+ * \param  hDrvMain    - The DrvMain object
+ * \param  uIterations - Number of loads per path
+ * \return void
+ * \sa     drvMain_SetDefaults, drvMain_CompileIniFile
+ */
+void drvMain_BenchInitTable (TI_HANDLE hDrvMain, TI_UINT32 uIterations)
+{
+	TDrvMain   *pDrvMain = (TDrvMain *)hDrvMain;
+	TI_HANDLE   hOs = pDrvMain->tStadHandles.hOs;
+	TFileInfo   tIniFile;
+	TInitTable *pInitTable;
+	TI_UINT8   *pBlob;
+	TI_UINT32   uBlobLength;
+	TI_UINT8   *pIniText;
+	TI_UINT32   uIniLength;
+	TI_UINT32   uTextTime;
+	TI_UINT32   uBlobTime;
+	TI_UINT32   uStartTime;
+	TI_UINT32   i;
+
+	if (uIterations == 0) {
+		uIterations = 100;
+	}
+
+	tIniFile.eFileType = FILE_TYPE_INI;
+	tIniFile.fCbFunc   = NULL;
+	tIniFile.hCbHndl   = NULL;
+	if ((wlanDrvIf_GetFile (hOs, &tIniFile) != TI_OK) || (tIniFile.pBuffer == NULL)) {
+		WLAN_OS_REPORT(("No ini-file was loaded\n"));
+		return;
+	}
+
+	uBlobLength = INIT_TABLE_BLOB_MAX_LENGTH(tIniFile.uLength);
+	pInitTable = os_memoryAlloc (hOs, sizeof(TInitTable));
+	pBlob = os_memoryAlloc (hOs, uBlobLength);
+	if ((pInitTable == NULL) || (pBlob == NULL)) {
+		WLAN_OS_REPORT(("drvMain_BenchInitTable: memory allocation failed\n"));
+		if (pInitTable) {
+			os_memoryFree (hOs, pInitTable, sizeof(TInitTable));
+		}
+		if (pBlob) {
+			os_memoryFree (hOs, pBlob, uBlobLength);
+		}
+		return;
+	}
+
+	if (drvMain_CompileIniFile (hOs, tIniFile.pBuffer, tIniFile.uLength, pBlob, uBlobLength) != TI_OK) {
+		WLAN_OS_REPORT(("Failed compiling the ini-file\n"));
+		os_memoryFree (hOs, pBlob, uBlobLength);
+		os_memoryFree (hOs, pInitTable, sizeof(TInitTable));
+		return;
+	}
+
+	/* The text path parses the ini-file text embedded in the blob, so it's measured even if a blob was loaded */
+	uIniLength = ((TInitTableBlobHdr *)pBlob)->uIniLength;
+	pIniText   = pBlob + sizeof(TInitTableBlobHdr) + sizeof(TInitTable);
+	uStartTime = os_timeStampUs (hOs);
+	for (i = 0; i < uIterations; i++) {
+		osInitTable_IniFile (hOs, pInitTable, (char*)pIniText, (int)uIniLength);
+	}
+	uTextTime = os_timeStampUs (hOs) - uStartTime;
+
+	uStartTime = os_timeStampUs (hOs);
+	for (i = 0; i < uIterations; i++) {
+		drvMain_LoadInitTableBlob (hOs, pInitTable, pBlob, INIT_TABLE_BLOB_LENGTH((TInitTableBlobHdr *)pBlob),
+		                           &pIniText, &uIniLength);
+	}
+	uBlobTime = os_timeStampUs (hOs) - uStartTime;
+
+	WLAN_OS_REPORT(("Init table load (usec per load, %d loads):\n", uIterations));
+	WLAN_OS_REPORT(("  Ini-file text (%6d bytes): %8d\n", ((TInitTableBlobHdr *)pBlob)->uIniLength, uTextTime / uIterations));
+	WLAN_OS_REPORT(("  Blob          (%6d bytes): %8d\n", INIT_TABLE_BLOB_LENGTH((TInitTableBlobHdr *)pBlob), uBlobTime / uIterations));
+
+	os_memoryFree (hOs, pBlob, uBlobLength);
+	os_memoryFree (hOs, pInitTable, sizeof(TInitTable));
+}
+#endif
@@ -57,6 +57,13 @@ TI_STATUS drvMain_Create 			(TI_HANDLE  hOs,
 TI_STATUS drvMain_Destroy           (TI_HANDLE  hDrvMain);
 TI_STATUS drvMain_InsertAction      (TI_HANDLE  hDrvMain, EActionType eAction);
 TI_STATUS drvMain_Recovery          (TI_HANDLE  hDrvMain);
+TI_STATUS drvMain_DataPathReset     (TI_HANDLE  hDrvMain);
 void      drvMain_SmeStop           (TI_HANDLE hDrvMain);
 void      drvMain_PowerMgrSuspended (TI_HANDLE hDrvMain, TI_BOOL success);
+TI_STATUS drvMain_CompileIniFile    (TI_HANDLE hOs, TI_UINT8 *pIniFile, TI_UINT32 uIniLength, TI_UINT8 *pBlob, TI_UINT32 uBlobLength);
+#ifdef TI_DBG
+void      drvMain_PrintBringupTimes (TI_HANDLE hDrvMain);
+void      drvMain_PrintSuspendStats (TI_HANDLE hDrvMain);
+void      drvMain_BenchInitTable    (TI_HANDLE hDrvMain, TI_UINT32 uIterations);
+#endif
 #endif
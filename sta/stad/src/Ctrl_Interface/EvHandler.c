@@ -36,6 +36,8 @@
 #include "EvHandler.h"
 #include "osApi.h"
 #include "osDebug.h"
+#include "timer.h"
+#include "coreDefaultParams.h"
 
 #ifndef _WINDOWS
 #include "windows_types.h"
@@ -47,11 +49,44 @@
 TI_HANDLE ghEvHandler; /* for debug, remove later*/
 #endif
 
+/* Default push events coalescing rules (events not listed are delivered immediately) */
+typedef struct {
+	TI_UINT32           uEventType;
+	TEvCoalesceRule     tRule;
+} TEvDefaultRule;
+
+static const TEvDefaultRule aDefaultRules[] = {
+	{ IPC_EVENT_LINK_SPEED,                         { EV_POLICY_LATEST, 0, 0 } },
+	{ IPC_EVENT_LOW_RSSI,                           { EV_POLICY_LATEST, 0, 0 } },
+	{ IPC_EVENT_RSSI_SNR_TRIGGER,                   { EV_POLICY_LATEST, 2, 2 } }, /* triggerDataEx_t clientID */
+	{ IPC_EVENT_RSSI_SNR_TRIGGER_0,                 { EV_POLICY_LATEST, 0, 0 } },
+	{ IPC_EVENT_RSSI_SNR_TRIGGER_1,                 { EV_POLICY_LATEST, 0, 0 } },
+	{ IPC_EVENT_TRAFFIC_INTENSITY_THRESHOLD_CROSSED,{ EV_POLICY_LATEST, 0, 4 } }, /* threshold (high or low) */
+	{ IPC_EVENT_MEDIUM_TIME_CROSS,                  { EV_POLICY_LATEST, 0, 4 } }, /* AC */
+	{ IPC_EVENT_TX_RETRY_FALIURE,                   { EV_POLICY_COUNT,  0, 0 } },
+	{ IPC_EVENT_MEDIA_SPECIFIC,                     { EV_POLICY_BATCH,  0, 0 } },
+	{ IPC_EVENT_IMMEDIATE_SCAN_REPORT,              { EV_POLICY_BATCH,  0, 0 } },
+	{ IPC_EVENT_CONTINUOUS_SCAN_REPORT,             { EV_POLICY_BATCH,  0, 0 } },
+	{ IPC_EVENT_SCAN_RESULT_RECORD,                 { EV_POLICY_BATCH,  0, 0 } }
+};
+
+/* Push registrations, with or without coalescing */
+#define EV_IS_PUSH(uDeliveryType)   (((uDeliveryType) == DELIVERY_PUSH) || ((uDeliveryType) == DELIVERY_PUSH_COALESCED))
+
+#ifdef TI_DBG
+#define EV_DBG_BATCH_INTERVAL_MS    50  /* batch interval of the coalescing check if batching is disabled */
+#endif
+
+static TEvListener *evHandler_GetListener (TEvHandlerObj *pEvHandler, IPC_EVENT_PARAMS *pEvParams, TI_BOOL bCreate);
+static void         evHandler_FlushListener (TEvHandlerObj *pEvHandler, TEvListener *pListener);
+static void         evHandler_BatchTimeout (TI_HANDLE hEvHandler, TI_BOOL bTwdInitOccured);
+
 /* ************************** Upper Interface **********************************/
 
 TI_HANDLE EvHandler_Create (TI_HANDLE hOs)
 {
 	TEvHandlerObj *pEvHandler;
+	TI_UINT32      i;
 
 	PRINT(DBG_INIT_LOUD, (" EvHandlerInit\n"));
 	pEvHandler = os_memoryAlloc(hOs,sizeof(TEvHandlerObj));
@@ -72,9 +107,102 @@ TI_HANDLE EvHandler_Create (TI_HANDLE hOs)
 
 	pEvHandler->LastUMEventType = 0xFFFFFFFF;
 
+	/* all events are immediate until the defaults are set (the rules table is zeroed) */
+	for (i = 0; i < sizeof(aDefaultRules) / sizeof(TEvDefaultRule); i++) {
+		pEvHandler->aRules[aDefaultRules[i].uEventType] = aDefaultRules[i].tRule;
+	}
+
 	return (TI_HANDLE) pEvHandler;
 }
 
+/**
+ * \fn     EvHandler_Init
+ * \brief  Init the events handler timer
+ *
+ * Creates the push events batch timer.
+ *
+ * \param  hEvHandler - handle to the events handler object
+ * \param  hTimer     - handle to the timer module
+ * \return None
+ */
+void EvHandler_Init (TI_HANDLE hEvHandler, TI_HANDLE hTimer)
+{
+	TEvHandlerObj *pEvHandler = (TEvHandlerObj *)hEvHandler;
+
+	pEvHandler->hBatchTimer = tmr_CreateTimer (hTimer);
+	if (pEvHandler->hBatchTimer == NULL) {
+		PRINT(DBG_INIT_ERROR, "EvHandler_Init(): Failed to create hBatchTimer! events will not be coalesced\n");
+	}
+}
+
+/**
+ * \fn     EvHandler_SetDefaults
+ * \brief  Set the events handler configuration from the init table
+ *
+ * \param  hEvHandler  - handle to the events handler object
+ * \param  pInitParams - the events handler init parameters
+ * \return None
+ */
+void EvHandler_SetDefaults (TI_HANDLE hEvHandler, TEvHandlerInitParams *pInitParams)
+{
+	TEvHandlerObj *pEvHandler = (TEvHandlerObj *)hEvHandler;
+
+	EvHandler_FlushEvents (hEvHandler);
+
+	pEvHandler->uBatchIntervalMs = (pEvHandler->hBatchTimer != NULL) ? pInitParams->uBatchIntervalMs : 0;
+}
+
+/**
+ * \fn     EvHandler_SetCoalesceRule
+ * \brief  Set the coalescing rule of a push event type
+ *
+ * Pending events of the type are delivered first, so the new rule only applies to new events.
+ *
+ * \param  hEvHandler - handle to the events handler object
+ * \param  uEventType - the IPC event type
+ * \param  pRule      - the new coalescing rule
+ * \return TI_OK on success, TI_NOK on invalid event type or rule
+ */
+TI_STATUS EvHandler_SetCoalesceRule (TI_HANDLE hEvHandler, TI_UINT32 uEventType, TEvCoalesceRule *pRule)
+{
+	TEvHandlerObj *pEvHandler = (TEvHandlerObj *)hEvHandler;
+
+	if ((uEventType >= IPC_EVENT_MAX) || (pRule->ePolicy >= EV_POLICY_NUM) ||
+	        (pRule->uKeyOffset + pRule->uKeyLen > MAX_EVENT_DATA_SIZE)) {
+		return TI_NOK;
+	}
+
+	EvHandler_FlushEvents (hEvHandler);
+
+	pEvHandler->aRules[uEventType] = *pRule;
+
+	return TI_OK;
+}
+
+/**
+ * \fn     EvHandler_FlushEvents
+ * \brief  Deliver all pending push events now
+ *
+ * \param  hEvHandler - handle to the events handler object
+ * \return None
+ */
+void EvHandler_FlushEvents (TI_HANDLE hEvHandler)
+{
+	TEvHandlerObj *pEvHandler = (TEvHandlerObj *)hEvHandler;
+	TI_UINT32      i;
+
+	if (pEvHandler->bBatchTimerRunning) {
+		tmr_StopTimer (pEvHandler->hBatchTimer);
+		pEvHandler->bBatchTimerRunning = TI_FALSE;
+	}
+
+	for (i = 0; i < MAX_REGISTERED_MODULES; i++) {
+		if (pEvHandler->aListeners[i].bInUse) {
+			evHandler_FlushListener (pEvHandler, &pEvHandler->aListeners[i]);
+		}
+	}
+}
+
 TI_UINT32 EvHandlerUnload (TI_HANDLE hEvHandler)
 {
 
@@ -83,6 +211,10 @@ TI_UINT32 EvHandlerUnload (TI_HANDLE hEvHandler)
 	PRINT(DBG_INIT_LOUD, (" ev_handler_unLoad\n"));
 	pEvHandler = (TEvHandlerObj *)hEvHandler;
 
+	if (pEvHandler->hBatchTimer) {
+		tmr_DestroyTimer (pEvHandler->hBatchTimer);
+	}
+
 	os_memoryFree(pEvHandler->hOs,pEvHandler,sizeof(TEvHandlerObj));
 
 	return TI_OK;
@@ -149,6 +281,11 @@ TI_UINT32 EvHandlerRegisterEvent(TI_HANDLE hEvHandler, TI_UINT8* pData, TI_UINT3
 
 	pEvHandler->RegistrationArray[pEvParams->uEventType][ModuleIndex].uEventID = pEvParams->uEventID;
 
+	if (EV_IS_PUSH(pEvParams->uDeliveryType)) {
+		/* if the listeners table is full, the events of this registration are not coalesced */
+		evHandler_GetListener (pEvHandler, pEvParams, TI_TRUE);
+	}
+
 	PRINT(DBG_INIT_LOUD, " EvHandlerRegisterEvent Out \n");
 
 	return STATUS_SUCCESS;
@@ -160,7 +297,10 @@ TI_UINT32 EvHandlerUnRegisterEvent(TI_HANDLE hEvHandler, TI_HANDLE uEventID)
 {
 	TEvHandlerObj *pEvHandler;
 	IPC_EVENT_PARAMS *pEvParams;
+	IPC_EVENT_PARAMS *pReg;
+	TEvListener *pListener;
 	TI_UINT32 ModuleIndex;
+	TI_UINT32 EvType;
 
 #ifdef EV_HANDLER_DEBUG
 	if (ghEvHandler !=  hEvHandler ) {
@@ -199,8 +339,28 @@ TI_UINT32 EvHandlerUnRegisterEvent(TI_HANDLE hEvHandler, TI_HANDLE uEventID)
 		return (TI_UINT32)STATUS_INVALID_PARAMETER;
 	}
 
+	/* deliver what is pending for the listener while the registration is still valid */
+	pListener = evHandler_GetListener (pEvHandler, pEvParams, TI_FALSE);
+	if (pListener != NULL) {
+		evHandler_FlushListener (pEvHandler, pListener);
+	}
+
 	pEvHandler->RegistrationArray[pEvParams->uEventType][ModuleIndex].uEventID = NULL;
 
+	/* release the listener with its last registration */
+	if (pListener != NULL) {
+		for (EvType = 0; EvType < IPC_EVENT_MAX; EvType++) {
+			for (ModuleIndex = 0; ModuleIndex < MAX_REGISTERED_MODULES; ModuleIndex++) {
+				pReg = &pEvHandler->RegistrationArray[EvType][ModuleIndex];
+				if ((pReg->uEventID != NULL) && EV_IS_PUSH(pReg->uDeliveryType) &&
+				        (pReg->uProcessID == pListener->uProcessID) && (pReg->hUserParam == pListener->hUserParam)) {
+					return STATUS_SUCCESS;
+				}
+			}
+		}
+		pListener->bInUse = TI_FALSE;
+	}
+
 	return STATUS_SUCCESS;
 }
 
@@ -208,6 +368,218 @@ TI_UINT32 EvHandlerUnRegisterEvent(TI_HANDLE hEvHandler, TI_HANDLE uEventID)
 
 /* ************************** Bottom Interface **********************************/
 
+/**
+ * \fn     evHandler_GetListener
+ * \brief  Find the push listener of a registration
+ *
+ * \param  pEvHandler - the events handler object
+ * \param  pEvParams  - the event registration parameters
+ * \param  bCreate    - allocate a new listener if not found
+ * \return The listener, NULL if not found (or no free listener)
+ */
+static TEvListener *evHandler_GetListener (TEvHandlerObj *pEvHandler, IPC_EVENT_PARAMS *pEvParams, TI_BOOL bCreate)
+{
+	TEvListener *pFree = NULL;
+	TI_UINT32    i;
+
+	for (i = 0; i < MAX_REGISTERED_MODULES; i++) {
+		TEvListener *pListener = &pEvHandler->aListeners[i];
+
+		if (!pListener->bInUse) {
+			if (pFree == NULL) {
+				pFree = pListener;
+			}
+		} else if ((pListener->uProcessID == pEvParams->uProcessID) && (pListener->hUserParam == pEvParams->hUserParam)) {
+			return pListener;
+		}
+	}
+
+	if (!bCreate || (pFree == NULL)) {
+		return NULL;
+	}
+
+	os_memoryZero (pEvHandler->hOs, pFree, sizeof(TEvListener));
+	pFree->bInUse = TI_TRUE;
+	pFree->uProcessID = pEvParams->uProcessID;
+	pFree->hUserParam = pEvParams->hUserParam;
+
+	return pFree;
+}
+
+/**
+ * \fn     evHandler_BuildEvent
+ * \brief  Fill an event from its registration and data
+ */
+static void evHandler_BuildEvent (TEvHandlerObj *pEvHandler, IPC_EV_DATA *pEvent, IPC_EVENT_PARAMS *pEvParams,
+                                  TI_UINT8 *pData, TI_UINT32 Length)
+{
+	/* copy the event parameters and data */
+	os_memoryCopy(pEvHandler->hOs, (TI_UINT8*)&pEvent->EvParams, (TI_UINT8*)pEvParams, sizeof(IPC_EVENT_PARAMS));
+
+	os_memoryZero(pEvHandler->hOs, (TI_UINT8*)pEvent->uBuffer, sizeof(pEvent->uBuffer));
+
+	os_memoryCopy(pEvHandler->hOs, (TI_UINT8*)pEvent->uBuffer, (TI_UINT8*)pData, Length);
+
+	pEvent->uBufferSize = Length;
+	pEvent->uSequence = 0;
+	pEvent->uCoalesced = 0;
+}
+
+/**
+ * \fn     evHandler_Deliver
+ * \brief  Send a push event to its listener with the next listener sequence number
+ */
+static void evHandler_Deliver (TEvHandlerObj *pEvHandler, TEvListener *pListener, IPC_EV_DATA *pEvent)
+{
+	if (pListener != NULL) {
+		pEvent->uSequence = ++pListener->uSequence;
+		pListener->uDelivered++;
+	}
+
+	PRINTF(DBG_INIT_LOUD, (" EvHandlerSendEvent %d to OS \n", pEvent->EvParams.uEventType));
+
+	if ((IPC_EventSend (pEvHandler->hOs, (TI_UINT8*)pEvent, sizeof(IPC_EV_DATA)) != 0) && (pListener != NULL)) {
+		pListener->uSendFailures++;
+	}
+}
+
+/**
+ * \fn     evHandler_FlushListener
+ * \brief  Deliver all pending events of a listener, oldest first
+ *
+ * The event is removed from the ring before it is delivered, so a listener callback that sends
+ * new events sees a consistent ring.
+ */
+static void evHandler_FlushListener (TEvHandlerObj *pEvHandler, TEvListener *pListener)
+{
+	IPC_EV_DATA tEvent;
+
+	while (pListener->uCount > 0) {
+		os_memoryCopy (pEvHandler->hOs, &tEvent, &pListener->aRing[pListener->uHead], sizeof(IPC_EV_DATA));
+		pListener->uHead = (pListener->uHead + 1) % EV_LISTENER_RING_SIZE;
+		pListener->uCount--;
+
+		evHandler_Deliver (pEvHandler, pListener, &tEvent);
+	}
+}
+
+/**
+ * \fn     evHandler_BatchTimeout
+ * \brief  Batch timer expiry - deliver all pending events
+ */
+static void evHandler_BatchTimeout (TI_HANDLE hEvHandler, TI_BOOL bTwdInitOccured)
+{
+	TEvHandlerObj *pEvHandler = (TEvHandlerObj *)hEvHandler;
+
+	pEvHandler->bBatchTimerRunning = TI_FALSE;
+	pEvHandler->uBatchFlushes++;
+
+	EvHandler_FlushEvents (hEvHandler);
+}
+
+/**
+ * \fn     evHandler_QueueEvent
+ * \brief  Add a push event to its listener ring according to the event coalescing rule
+ *
+ * A LATEST event overwrites a pending event with the same key, and a COUNT event that is identical
+ * to a pending event is only counted. The merged event keeps the position of the pending one, and
+ * uCoalesced tells the listener how many events were merged into it. If the ring is full it is
+ * flushed, so events are never dropped.
+ */
+static void evHandler_QueueEvent (TEvHandlerObj *pEvHandler, TEvListener *pListener, TEvCoalesceRule *pRule,
+                                  IPC_EVENT_PARAMS *pEvParams, TI_UINT8 *pData, TI_UINT32 Length)
+{
+	IPC_EV_DATA *pEvent;
+	TI_UINT32    i;
+
+	pListener->uQueued++;
+
+	/* look for a pending event this one can be merged into */
+	if ((pRule->ePolicy == EV_POLICY_LATEST) || (pRule->ePolicy == EV_POLICY_COUNT)) {
+		for (i = 0; i < pListener->uCount; i++) {
+			pEvent = &pListener->aRing[(pListener->uHead + i) % EV_LISTENER_RING_SIZE];
+
+			if ((pEvent->EvParams.uEventType != pEvParams->uEventType) ||
+			        (pEvent->EvParams.uEventID != pEvParams->uEventID)) {
+				continue;
+			}
+
+			if (pRule->ePolicy == EV_POLICY_LATEST) {
+				if ((pRule->uKeyLen != 0) &&
+				        ((pRule->uKeyOffset + pRule->uKeyLen > Length) ||
+				         (pRule->uKeyOffset + pRule->uKeyLen > pEvent->uBufferSize) ||
+				         (os_memoryCompare (pEvHandler->hOs, &pEvent->uBuffer[pRule->uKeyOffset],
+				                            &pData[pRule->uKeyOffset], pRule->uKeyLen) != 0))) {
+					continue;
+				}
+
+				/* latest value wins */
+				os_memoryZero (pEvHandler->hOs, pEvent->uBuffer, sizeof(pEvent->uBuffer));
+				os_memoryCopy (pEvHandler->hOs, pEvent->uBuffer, pData, Length);
+				pEvent->uBufferSize = Length;
+			} else if ((pEvent->uBufferSize != Length) ||
+			           ((Length != 0) && (os_memoryCompare (pEvHandler->hOs, pEvent->uBuffer, pData, Length) != 0))) {
+				continue;
+			}
+
+			pEvent->uCoalesced++;
+			pListener->uCoalesced++;
+			return;
+		}
+	}
+
+	/* ring full - deliver the pending events now rather than losing any */
+	if (pListener->uCount == EV_LISTENER_RING_SIZE) {
+		pListener->uOverflowFlushes++;
+		evHandler_FlushListener (pEvHandler, pListener);
+	}
+
+	pEvent = &pListener->aRing[(pListener->uHead + pListener->uCount) % EV_LISTENER_RING_SIZE];
+	evHandler_BuildEvent (pEvHandler, pEvent, pEvParams, pData, Length);
+	pListener->uCount++;
+
+	if (pEvHandler->bBatchTimerRunning) {
+		/* don't hold events forever if the timer expiry was lost (e.g. the driver was stopped) */
+		if (os_timeStampMs (pEvHandler->hOs) - pEvHandler->uBatchStartTime > 2 * pEvHandler->uBatchIntervalMs) {
+			EvHandler_FlushEvents ((TI_HANDLE)pEvHandler);
+		}
+	} else {
+		pEvHandler->bBatchTimerRunning = TI_TRUE;
+		pEvHandler->uBatchStartTime = os_timeStampMs (pEvHandler->hOs);
+		tmr_StartTimer (pEvHandler->hBatchTimer, evHandler_BatchTimeout, (TI_HANDLE)pEvHandler,
+		                pEvHandler->uBatchIntervalMs, TI_FALSE);
+	}
+}
+
+/**
+ * \fn     evHandler_PushEvent
+ * \brief  Deliver or queue a push event to a registered listener
+ *
+ * Events of a listener are always delivered in the order they were sent: an immediate event first
+ * delivers everything pending for its listener.
+ * Only the registrations that opted in with DELIVERY_PUSH_COALESCED are coalesced.
+ */
+static void evHandler_PushEvent (TEvHandlerObj *pEvHandler, IPC_EVENT_PARAMS *pEvParams, TI_UINT8 *pData, TI_UINT32 Length)
+{
+	TEvCoalesceRule *pRule = &pEvHandler->aRules[pEvParams->uEventType];
+	TEvListener     *pListener = evHandler_GetListener (pEvHandler, pEvParams, TI_FALSE);
+	IPC_EV_DATA      tEvent;
+
+	if ((pListener != NULL) && (pEvParams->uDeliveryType == DELIVERY_PUSH_COALESCED) &&
+	        (pEvHandler->uBatchIntervalMs != 0) && (pRule->ePolicy != EV_POLICY_IMMEDIATE)) {
+		evHandler_QueueEvent (pEvHandler, pListener, pRule, pEvParams, pData, Length);
+		return;
+	}
+
+	if (pListener != NULL) {
+		pListener->uQueued++;
+		evHandler_FlushListener (pEvHandler, pListener);
+	}
+
+	evHandler_BuildEvent (pEvHandler, &tEvent, pEvParams, pData, Length);
+	evHandler_Deliver (pEvHandler, pListener, &tEvent);
+}
+
 TI_UINT32 EvHandlerSendEvent(TI_HANDLE hEvHandler, TI_UINT32 EvType, TI_UINT8* pData, TI_UINT32 Length)
 {
 	TEvHandlerObj *pEvHandler;
@@ -230,10 +602,29 @@ TI_UINT32 EvHandlerSendEvent(TI_HANDLE hEvHandler, TI_UINT32 EvType, TI_UINT8* p
 
 	pEvHandler  = (TEvHandlerObj *)hEvHandler;
 
+	if (EvType >= IPC_EVENT_MAX) {
+		PRINTF(DBG_INIT_ERROR, (" EvHandlerSendEvent Error - Invalid Event Type = %d \n", EvType));
+		return TI_NOK;
+	}
+
+	/* the event data is truncated to the IPC event buffer */
+	if (Length > MAX_EVENT_DATA_SIZE) {
+		PRINTF(DBG_INIT_WARNING, (" EvHandlerSendEvent %d data truncated (%d bytes)\n", EvType, (int)Length));
+		Length = MAX_EVENT_DATA_SIZE;
+	}
+
 	TailIndex   = pEvHandler->SendEventArray.TailIndex;
 
-	while ((ModuleIndex < MAX_REGISTERED_MODULES) && (EvType <= IPC_EVENT_MAX)) {
+	while (ModuleIndex < MAX_REGISTERED_MODULES) {
 		if (pEvHandler->RegistrationArray[EvType][ModuleIndex].uEventID != NULL ) {
+			if (EV_IS_PUSH(pEvHandler->RegistrationArray[EvType][ModuleIndex].uDeliveryType)) {
+				PRINTF(DBG_INIT_LOUD, ("EvHandlerSendEvent Matching OS Registered event found at EvType = %d,"
+				                       "ModuleIndex = %d  \n", EvType, ModuleIndex));
+				evHandler_PushEvent (pEvHandler, &pEvHandler->RegistrationArray[EvType][ModuleIndex], pData, Length);
+				ModuleIndex++;
+				continue;
+			}
+
 			if (pEvHandler->SendEventArray.Counter == MAX_SEND_EVENTS) {
 				PRINT(DBG_INIT_ERROR, " EvHandlerSendEvent Array Full u Fool! \n");
 				return TI_NOK;
@@ -242,36 +633,17 @@ TI_UINT32 EvHandlerSendEvent(TI_HANDLE hEvHandler, TI_UINT32 EvType, TI_UINT8* p
 			pNewEvent = &pEvHandler->SendEventArray.Array[TailIndex];
 
 			/* copy the event parameters and data to the events queue*/
-			os_memoryCopy(pEvHandler->hOs,(TI_UINT8*)&pNewEvent->EvParams,
-			              (TI_UINT8*)&pEvHandler->RegistrationArray[EvType][ModuleIndex],
-			              sizeof(IPC_EVENT_PARAMS));
-
-			os_memoryZero(pEvHandler->hOs,(TI_UINT8*)pNewEvent->uBuffer, sizeof(pNewEvent->uBuffer));
-
-			os_memoryCopy(pEvHandler->hOs,
-			              (TI_UINT8*)pNewEvent->uBuffer,
-			              (TI_UINT8*)pData,
-			              Length);
-
-			pNewEvent->uBufferSize = Length;
-
-			if (pNewEvent->EvParams.uDeliveryType ==  DELIVERY_PUSH) {
-				PRINTF(DBG_INIT_LOUD, (" EvHandlerSendEvent %d to OS \n", EvType));
-				PRINTF(DBG_INIT_LOUD, ("EvHandlerSendEvent Matching OS Registered event found at EvType = %d,"
-				                       "ModuleIndex = %d  \n", EvType, ModuleIndex));
-				IPC_EventSend (pEvHandler->hOs,(TI_UINT8*)pNewEvent,sizeof(IPC_EV_DATA));
-			} else {
-
-				pEvHandler->LastUMEventType = EvType;
-				pEvHandler->SendEventArray.TailIndex = (TailIndex+1) % MAX_SEND_EVENTS;
-				pEvHandler->SendEventArray.Counter++;
-				TailIndex   = pEvHandler->SendEventArray.TailIndex;
-				PRINTF(DBG_INIT_LOUD, (" EvHandlerSendEvent %d to User Mode \n", EvType));
-				PRINTF(DBG_INIT_LOUD, ("EvHandlerSendEvent Matching User Mode Registered event found at EvType = %d,"
-				                       "ModuleIndex = %d  \n", EvType, ModuleIndex));
-				if (pEvHandler->SendEventArray.Counter == 1) {
-					IPC_EventSend (pEvHandler->hOs,NULL,0);
-				}
+			evHandler_BuildEvent (pEvHandler, pNewEvent, &pEvHandler->RegistrationArray[EvType][ModuleIndex], pData, Length);
+
+			pEvHandler->LastUMEventType = EvType;
+			pEvHandler->SendEventArray.TailIndex = (TailIndex+1) % MAX_SEND_EVENTS;
+			pEvHandler->SendEventArray.Counter++;
+			TailIndex   = pEvHandler->SendEventArray.TailIndex;
+			PRINTF(DBG_INIT_LOUD, (" EvHandlerSendEvent %d to User Mode \n", EvType));
+			PRINTF(DBG_INIT_LOUD, ("EvHandlerSendEvent Matching User Mode Registered event found at EvType = %d,"
+			                       "ModuleIndex = %d  \n", EvType, ModuleIndex));
+			if (pEvHandler->SendEventArray.Counter == 1) {
+				IPC_EventSend (pEvHandler->hOs,NULL,0);
 			}
 		} /* end if*/
 
@@ -282,4 +654,200 @@ TI_UINT32 EvHandlerSendEvent(TI_HANDLE hEvHandler, TI_UINT32 EvType, TI_UINT8* p
 	return TI_OK;
 }
 
+#ifdef TI_DBG
+/**
+ * \fn     EvHandler_PrintStats
+ * \brief  Print the push listeners coalescing statistics
+ *
+ * \param  hEvHandler - handle to the events handler object
+ * \return None
+ */
+void EvHandler_PrintStats (TI_HANDLE hEvHandler)
+{
+	TEvHandlerObj *pEvHandler = (TEvHandlerObj *)hEvHandler;
+	TI_UINT32      i;
+
+	WLAN_OS_REPORT(("------------- Event Handler Statistics -------------\n"));
+	WLAN_OS_REPORT(("Batch interval = %d ms, batch timer running = %d, batch flushes = %d\n",
+	                pEvHandler->uBatchIntervalMs, pEvHandler->bBatchTimerRunning, pEvHandler->uBatchFlushes));
+	for (i = 0; i < MAX_REGISTERED_MODULES; i++) {
+		TEvListener *pListener = &pEvHandler->aListeners[i];
+
+		if (!pListener->bInUse) {
+			continue;
+		}
+		WLAN_OS_REPORT(("Listener %d (pid %d): pending = %d, sent = %d, delivered = %d, coalesced = %d, "
+		                "overflow flushes = %d, send failures = %d, last sequence = %d\n",
+		                i, pListener->uProcessID, pListener->uCount, pListener->uQueued, pListener->uDelivered,
+		                pListener->uCoalesced, pListener->uOverflowFlushes, pListener->uSendFailures,
+		                pListener->uSequence));
+	}
+}
+
+/* Coalescing check listener state */
+typedef struct {
+	TEvHandlerObj   *pEvHandler;
+	TI_UINT32       uLastSequence;
+	TI_UINT32       uAccounted;     /* sent events accounted for by delivered events */
+	TI_UINT32       uLastBatchIndex;
+	TI_UINT32       uReceived;
+	TI_UINT32       uErrors;
+} TEvDbgListener;
+
+#define EV_DBG_NO_INDEX     0xFFFFFFFF
+#define EV_DBG_RAND(seed)   ((seed) = ((seed) * 1664525) + 1013904223, (seed) >> 8)
+
+static TEvDbgListener *pEvDbgListener = NULL;
+
+/**
+ * \fn     evHandler_DbgListenerCB
+ * \brief  Coalescing check listener - verifies the sequence and ordering of every delivered event
+ */
+static TI_INT32 evHandler_DbgListenerCB (PIPC_EV_DATA pData)
+{
+	TEvDbgListener *pDbg = pEvDbgListener;
+	EEvPolicy       ePolicy = pDbg->pEvHandler->aRules[pData->EvParams.uEventType].ePolicy;
+	TI_UINT32       uIndex;
+
+	os_memoryCopy (pDbg->pEvHandler->hOs, &uIndex, &pData->uBuffer[4], sizeof(TI_UINT32));
+
+	pDbg->uReceived++;
+	pDbg->uAccounted += 1 + pData->uCoalesced;
+
+	/* no event is lost or delivered twice */
+	if (pData->uSequence != pDbg->uLastSequence + 1) {
+		WLAN_OS_REPORT(("Event check: sequence %d after %d\n", pData->uSequence, pDbg->uLastSequence));
+		pDbg->uErrors++;
+	}
+	pDbg->uLastSequence = pData->uSequence;
+
+	switch (ePolicy) {
+	case EV_POLICY_IMMEDIATE:
+		/* everything sent before an immediate event was delivered before it */
+		if (pDbg->uAccounted != uIndex + 1) {
+			WLAN_OS_REPORT(("Event check: immediate event %d delivered after %d events\n", uIndex, pDbg->uAccounted));
+			pDbg->uErrors++;
+		}
+		break;
+
+	case EV_POLICY_BATCH:
+		/* batched events are neither merged nor reordered */
+		if ((pData->uCoalesced != 0) ||
+		        ((pDbg->uLastBatchIndex != EV_DBG_NO_INDEX) && (uIndex <= pDbg->uLastBatchIndex))) {
+			WLAN_OS_REPORT(("Event check: batched event %d after %d (coalesced %d)\n",
+			                uIndex, pDbg->uLastBatchIndex, pData->uCoalesced));
+			pDbg->uErrors++;
+		}
+		pDbg->uLastBatchIndex = uIndex;
+		break;
+
+	default:
+		break;
+	}
+
+	return 0;
+}
+
+/**
+ * \fn     EvHandler_DbgCheckCoalescing
+ * \brief  Verify the push events ordering and loss guarantees
+ *
+ * Temporarily replaces all the registrations with a single check listener, sends it random bursts
+ * of events of the coalesced and immediate types (with random flushes in between, standing for the
+ * batch timer), and verifies that the listener sees consecutive sequence numbers, that every sent
+ * event is accounted for, and that immediate and batched events keep their order.
+ *
+ * \param  hEvHandler - handle to the events handler object
+ * \param  uEvents    - number of events to send (0 for 1000)
+ * \return None
+ */
+void EvHandler_DbgCheckCoalescing (TI_HANDLE hEvHandler, TI_UINT32 uEvents)
+{
+	static const TI_UINT32 aEventTypes[] = { IPC_EVENT_LINK_SPEED, IPC_EVENT_RSSI_SNR_TRIGGER, IPC_EVENT_MEDIUM_TIME_CROSS,
+	                                         IPC_EVENT_TX_RETRY_FALIURE, IPC_EVENT_MEDIA_SPECIFIC, IPC_EVENT_BSS_LOSS
+	                                       };
+	TEvHandlerObj   *pEvHandler = (TEvHandlerObj *)hEvHandler;
+	TEvHandlerObj   *pSaved;
+	TEvDbgListener  tDbg;
+	IPC_EVENT_PARAMS tEvParams;
+	TEvListener     *pListener;
+	TI_UINT8        aData[8];
+	TI_UINT32       uSeed = os_timeStampMs (pEvHandler->hOs);
+	TI_UINT32       i, uType, uIndex;
+
+	if (uEvents == 0) {
+		uEvents = 1000;
+	}
+
+	pSaved = os_memoryAlloc (pEvHandler->hOs, sizeof(TEvHandlerObj));
+	if (pSaved == NULL) {
+		WLAN_OS_REPORT(("Event check: memory allocation failed\n"));
+		return;
+	}
+
+	/* deliver the real pending events and keep the real registrations aside */
+	EvHandler_FlushEvents (hEvHandler);
+	os_memoryCopy (pEvHandler->hOs, pSaved, pEvHandler, sizeof(TEvHandlerObj));
+	os_memoryZero (pEvHandler->hOs, pEvHandler->RegistrationArray, sizeof(pEvHandler->RegistrationArray));
+	os_memoryZero (pEvHandler->hOs, pEvHandler->aListeners, sizeof(pEvHandler->aListeners));
+	if (pEvHandler->uBatchIntervalMs == 0) {
+		pEvHandler->uBatchIntervalMs = EV_DBG_BATCH_INTERVAL_MS;
+	}
+
+	os_memoryZero (pEvHandler->hOs, &tDbg, sizeof(TEvDbgListener));
+	tDbg.pEvHandler = pEvHandler;
+	tDbg.uLastBatchIndex = EV_DBG_NO_INDEX;
+	pEvDbgListener = &tDbg;
+
+	/* register the check listener */
+	for (i = 0; i < sizeof(aEventTypes) / sizeof(TI_UINT32); i++) {
+		os_memoryZero (pEvHandler->hOs, &tEvParams, sizeof(IPC_EVENT_PARAMS));
+		tEvParams.uDeliveryType = DELIVERY_PUSH_COALESCED;
+		tEvParams.hUserParam = (TI_HANDLE)&tDbg;
+		tEvParams.pfEventCallback = evHandler_DbgListenerCB;
+		tEvParams.uEventType = aEventTypes[i];
+		EvHandlerRegisterEvent (hEvHandler, (TI_UINT8 *)&tEvParams, sizeof(IPC_EVENT_PARAMS));
+	}
+	pListener = evHandler_GetListener (pEvHandler, &tEvParams, TI_FALSE);
+
+	WLAN_OS_REPORT(("Checking event coalescing: %d events, seed %u\n", uEvents, uSeed));
+
+	for (i = 0; i < uEvents; i++) {
+		uType = aEventTypes[EV_DBG_RAND(uSeed) % (sizeof(aEventTypes) / sizeof(TI_UINT32))];
+
+		/* a small key range (bytes 0-3) makes merges likely, identical events carry no index */
+		os_memoryZero (pEvHandler->hOs, aData, sizeof(aData));
+		aData[0] = (TI_UINT8)(EV_DBG_RAND(uSeed) % 2);
+		aData[2] = (TI_UINT8)(EV_DBG_RAND(uSeed) % 3);
+		uIndex = (pEvHandler->aRules[uType].ePolicy == EV_POLICY_COUNT) ? EV_DBG_NO_INDEX : i;
+		os_memoryCopy (pEvHandler->hOs, &aData[4], &uIndex, sizeof(TI_UINT32));
+
+		EvHandlerSendEvent (hEvHandler, uType, aData, sizeof(aData));
+
+		/* stands for the batch timer expiry */
+		if ((EV_DBG_RAND(uSeed) % 64) == 0) {
+			EvHandler_FlushEvents (hEvHandler);
+		}
+	}
+	EvHandler_FlushEvents (hEvHandler);
+
+	if (tDbg.uAccounted != uEvents) {
+		WLAN_OS_REPORT(("Event check: %d events sent, %d accounted for\n", uEvents, tDbg.uAccounted));
+		tDbg.uErrors++;
+	}
+	if ((pListener == NULL) || (pListener->uDelivered != tDbg.uReceived) || (pListener->uQueued != uEvents)) {
+		WLAN_OS_REPORT(("Event check: listener statistics mismatch\n"));
+		tDbg.uErrors++;
+	}
+
+	WLAN_OS_REPORT(("Event coalescing check: %d events, %d delivered, %d overflow flushes, %d errors\n",
+	                uEvents, tDbg.uReceived, (pListener != NULL) ? pListener->uOverflowFlushes : 0, tDbg.uErrors));
+
+	/* restore the real registrations */
+	pEvDbgListener = NULL;
+	os_memoryCopy (pEvHandler->hOs, pEvHandler, pSaved, sizeof(TEvHandlerObj));
+	os_memoryFree (pEvHandler->hOs, pSaved, sizeof(TEvHandlerObj));
+}
+#endif
+
 /* ************************** Bottom Interface End **********************************/
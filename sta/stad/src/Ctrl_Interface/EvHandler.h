@@ -36,6 +36,7 @@
 
 
 #include "TI_IPC_Api.h"
+#include "paramOut.h"
 
 
 typedef struct {
@@ -45,17 +46,69 @@ typedef struct {
 	TI_UINT32       Counter;
 } EV_CYCL_ARRAY, *PEV_CYCL_ARRAY;
 
+/* Push event coalescing policies */
+typedef enum {
+	EV_POLICY_IMMEDIATE = 0,    /* critical event: flush the listener ring and deliver now */
+	EV_POLICY_BATCH,            /* queue and deliver when the batch timer expires */
+	EV_POLICY_LATEST,           /* queue, a pending event with the same key is overwritten (latest value wins) */
+	EV_POLICY_COUNT,            /* queue, a pending identical event is counted instead of queued again */
+	EV_POLICY_NUM
+} EEvPolicy;
+
+typedef struct {
+	EEvPolicy           ePolicy;
+	TI_UINT8            uKeyOffset; /* EV_POLICY_LATEST: the event data bytes that identify the value, */
+	TI_UINT8            uKeyLen;    /* a zero length key means one pending value per event type */
+} TEvCoalesceRule;
+
+#define EV_LISTENER_RING_SIZE   16
+
+/* Push listener (a process ID and user handle pair) with its pending events ring */
+typedef struct {
+	TI_BOOL             bInUse;
+	TI_UINT32           uProcessID;
+	TI_HANDLE           hUserParam;
+	IPC_EV_DATA         aRing[EV_LISTENER_RING_SIZE];
+	TI_UINT32           uHead;      /* oldest pending event */
+	TI_UINT32           uCount;     /* number of pending events */
+	TI_UINT32           uSequence;  /* sequence number of the last delivered event */
+
+	/* statistics */
+	TI_UINT32           uQueued;
+	TI_UINT32           uDelivered;
+	TI_UINT32           uCoalesced;
+	TI_UINT32           uOverflowFlushes;
+	TI_UINT32           uSendFailures;
+} TEvListener;
+
 typedef struct {
 	TI_HANDLE		   hOs;
 	IPC_EVENT_PARAMS   RegistrationArray[IPC_EVENT_MAX][MAX_REGISTERED_MODULES];
 	EV_CYCL_ARRAY      SendEventArray;
 	TI_UINT32          LastUMEventType;
 
+	/* push events coalescing */
+	TI_HANDLE          hBatchTimer;
+	TI_UINT32          uBatchIntervalMs;    /* 0 - coalescing disabled, all events are delivered immediately */
+	TI_BOOL            bBatchTimerRunning;
+	TI_UINT32          uBatchStartTime;
+	TI_UINT32          uBatchFlushes;
+	TEvCoalesceRule    aRules[IPC_EVENT_MAX];
+	TEvListener        aListeners[MAX_REGISTERED_MODULES];
+
 } TEvHandlerObj;
 
 /* Upper Interface*/
 TI_HANDLE EvHandler_Create         (TI_HANDLE hOs);
 
+void      EvHandler_Init           (TI_HANDLE hEvHandler, TI_HANDLE hTimer);
+
+void      EvHandler_SetDefaults    (TI_HANDLE hEvHandler, TEvHandlerInitParams *pInitParams);
+
+TI_STATUS EvHandler_SetCoalesceRule(TI_HANDLE hEvHandler, TI_UINT32 uEventType, TEvCoalesceRule *pRule);
+
+void      EvHandler_FlushEvents    (TI_HANDLE hEvHandler);
+
 TI_UINT32 EvHandlerUnload          (TI_HANDLE hEvHandler);
 
 TI_UINT32 EvHandlerRegisterEvent   (TI_HANDLE hEvHandler, TI_UINT8* pData,   TI_UINT32 Length);
@@ -71,5 +124,11 @@ TI_UINT32 EvHandlerGetEventData    (TI_HANDLE hEvHandler, TI_UINT8* pData, TI_UI
 
 TI_UINT32 EvHandlerSendEvent       (TI_HANDLE hEvHandler, TI_UINT32 EvType, TI_UINT8* pData, TI_UINT32 Length);
 
+#ifdef TI_DBG
+void      EvHandler_PrintStats     (TI_HANDLE hEvHandler);
+
+void      EvHandler_DbgCheckCoalescing (TI_HANDLE hEvHandler, TI_UINT32 uEvents);
+#endif
+
 
 #endif
@@ -131,6 +131,7 @@ void rxData_printRxCounters(TI_HANDLE hRxData);
 void rxData_startRxThroughputTimer(TI_HANDLE hRxData);
 void rxData_stopRxThroughputTimer(TI_HANDLE hRxData);
 void rxData_printRxDataFilter(TI_HANDLE hRxData);
+void rxData_benchRxDataFilters(TI_HANDLE hRxData, TI_UINT32 uIterations);
 
 
 
@@ -75,11 +75,27 @@
 #define RX_DATA_FILTER_FLAG_IP_HEADER           0
 #define RX_DATA_FILTER_FLAG_ETHERNET_HEADER     2
 #define RX_DATA_FILTER_ETHERNET_HEADER_BOUNDARY 14
+#define RX_DATA_FILTER_FIELD_HDR_LEN            4       /* offset, length and flag of a FW field pattern */
+#define RX_DATA_FILTER_RULE_MATCH_ALL           (RX_DATA_FILTER_RULE_MATCH_PATTERN | RX_DATA_FILTER_RULE_MATCH_ETHERTYPE | \
+                                                 RX_DATA_FILTER_RULE_MATCH_IP_PROTO | RX_DATA_FILTER_RULE_MATCH_SRC_PORT | \
+                                                 RX_DATA_FILTER_RULE_MATCH_DST_PORT)
+
+/* 802.3 frame offsets used by the host Rx data filters */
+#define RX_HOST_FILTER_ETHERTYPE_OFFSET         12
+#define RX_HOST_FILTER_IP_FRAG_OFFSET           20
+#define RX_HOST_FILTER_IP_PROTO_OFFSET          23
+#define RX_HOST_FILTER_IP_PROTO_TCP             6
+#define RX_HOST_FILTER_IP_PROTO_UDP             17
 
 #define PADDING_ETH_PACKET_SIZE                 2
 
 #define MSDU_DATA_LEN_LIMIT                     5000  /* some arbitrary big number to protect from buffer overflow */
 
+#ifdef TI_DBG
+#define RX_BENCH_NUM_FRAMES                     8
+#define RX_BENCH_FRAME_LEN                      64
+#endif
+
 
 /* CallBack for recieving packet from rxXfer */
 static void rxData_ReceivePacket (TI_HANDLE   hRxData,  void  *pBuffer);
@@ -105,6 +121,10 @@ static void rxData_rcvPacketData (TI_HANDLE hRxData, void *pBuffer, TRxAttr* pRx
 static TI_STATUS rxData_enableDisableRxDataFilters(TI_HANDLE hRxData, TI_BOOL enabled);
 static TI_STATUS rxData_addRxDataFilter(TI_HANDLE hRxData, TRxDataFilterRequest* request);
 static TI_STATUS rxData_removeRxDataFilter(TI_HANDLE hRxData, TRxDataFilterRequest* request);
+static TI_STATUS rxData_addRxDataFilterRule(TI_HANDLE hRxData, TRxDataFilterRule* pRule);
+static TI_STATUS rxData_removeRxDataFilterRule(TI_HANDLE hRxData, TRxDataFilterRule* pRule);
+static TI_BOOL   rxData_hostFilterPass(rxData_t *pRxData, void *pBuffer);
+static void      rxData_hostFilterRebalance(TI_HANDLE hRxData, TI_BOOL bTwdInitOccured);
 
 
 #ifdef XCC_MODULE_INCLUDED
@@ -245,7 +265,15 @@ TI_STATUS rxData_SetDefaults (TI_HANDLE hRxData, rxDataInitParams_t * rxDataInit
 	/* init rx data filters */
 	pRxData->filteringEnabled = rxDataInitParams->rxDataFiltersEnabled;
 	pRxData->filteringDefaultAction = rxDataInitParams->rxDataFiltersDefaultAction;
-	TWD_CfgEnableRxDataFilter (pRxData->hTWD, pRxData->filteringEnabled, pRxData->filteringDefaultAction);
+	pRxData->fwDefaultAction = pRxData->filteringDefaultAction;
+	TWD_CfgEnableRxDataFilter (pRxData->hTWD, pRxData->filteringEnabled, pRxData->fwDefaultAction);
+
+	pRxData->hHostFilterTimer = tmr_CreateTimer (pRxData->hTimer);
+	if (pRxData->hHostFilterTimer == NULL) {
+		WLAN_OS_REPORT(("rxData_SetDefaults(): Failed to create hHostFilterTimer!\n"));
+		return TI_NOK;
+	}
+	pRxData->hostFilterTimerRunning = TI_FALSE;
 
 	for (i = 0; i < MAX_DATA_FILTERS; ++i) {
 		if (rxDataInitParams->rxDataFilterRequests[i].maskLength > 0) {
@@ -316,6 +344,10 @@ TI_STATUS rxData_unLoad(TI_HANDLE hRxData)
 		tmr_DestroyTimer (pRxData->reAuthActiveTimer);
 	}
 
+	if (pRxData->hHostFilterTimer) {
+		tmr_DestroyTimer (pRxData->hHostFilterTimer);
+	}
+
 	/* free Rx Data controll block */
 	os_memoryFree(pRxData->hOs, pRxData, sizeof(rxData_t));
 
@@ -483,6 +515,12 @@ TI_STATUS rxData_setParam(TI_HANDLE hRxData, paramInfo_t *pParamInfo)
 		return rxData_removeRxDataFilter(hRxData, pRequest);
 	}
 
+	case RX_DATA_ADD_RX_DATA_FILTER_RULE:
+		return rxData_addRxDataFilterRule(hRxData, &pParamInfo->content.rxDataFilterRule);
+
+	case RX_DATA_REMOVE_RX_DATA_FILTER_RULE:
+		return rxData_removeRxDataFilterRule(hRxData, &pParamInfo->content.rxDataFilterRule);
+
 	case RX_DATA_GENERIC_ETHERTYPE_PARAM:
 		pRxData->genericEthertype = pParamInfo->content.rxGenericEthertype;
 		break;
@@ -522,39 +560,52 @@ static TI_STATUS rxData_enableDisableRxDataFilters(TI_HANDLE hRxData, TI_BOOL en
 
 	pRxData->filteringEnabled = enabled;
 
-	return TWD_CfgEnableRxDataFilter (pRxData->hTWD, pRxData->filteringEnabled, pRxData->filteringDefaultAction);
+	return TWD_CfgEnableRxDataFilter (pRxData->hTWD, pRxData->filteringEnabled, pRxData->fwDefaultAction);
 }
 
 /***************************************************************************
-*                          findFilterRequest                               *
+*                          findFilterRule                                  *
 ****************************************************************************
-* DESCRIPTION:
-*
-*
-* INPUTS:
-*
+* DESCRIPTION:  Look for a host filter rule identical to the given one
 *
+* INPUTS:       hRxData - the object
+*               pRule - the rule to look for
 *
 * OUTPUT:
 *
-* RETURNS:
+* RETURNS:      The rule index, or -1 if not found
 *
 ***************************************************************************/
-static int findFilterRequest(TI_HANDLE hRxData, TRxDataFilterRequest* request)
+static int findFilterRule(TI_HANDLE hRxData, TRxDataFilterRule* pRule)
 {
 	rxData_t * pRxData = (rxData_t *) hRxData;
-	int i;
-
-	for (i = 0; i < MAX_DATA_FILTERS; ++i) {
-		if (pRxData->isFilterSet[i]) {
-			if ((pRxData->filterRequests[i].offset == request->offset) &&
-			        (pRxData->filterRequests[i].maskLength == request->maskLength) &&
-			        (pRxData->filterRequests[i].patternLength == request->patternLength)) {
-				if ((os_memoryCompare(pRxData->hOs, pRxData->filterRequests[i].mask, request->mask, request->maskLength) == 0) &&
-				        (os_memoryCompare(pRxData->hOs, pRxData->filterRequests[i].pattern, request->pattern, request->patternLength) == 0))
-					return i;
-			}
+	TRxDataFilterRule *pCurr;
+	TI_UINT32 i;
+
+	for (i = 0; i < pRxData->hostFilters.uNumRules; ++i) {
+		pCurr = &pRxData->hostFilters.aRules[i].tRule;
+
+		if ((pCurr->uMatch != pRule->uMatch) || (pCurr->uAction != pRule->uAction))
+			continue;
+		if ((pRule->uMatch & RX_DATA_FILTER_RULE_MATCH_ETHERTYPE) && (pCurr->uEtherType != pRule->uEtherType))
+			continue;
+		if ((pRule->uMatch & RX_DATA_FILTER_RULE_MATCH_IP_PROTO) && (pCurr->uIpProto != pRule->uIpProto))
+			continue;
+		if ((pRule->uMatch & RX_DATA_FILTER_RULE_MATCH_SRC_PORT) && (pCurr->uSrcPort != pRule->uSrcPort))
+			continue;
+		if ((pRule->uMatch & RX_DATA_FILTER_RULE_MATCH_DST_PORT) && (pCurr->uDstPort != pRule->uDstPort))
+			continue;
+		if (pRule->uMatch & RX_DATA_FILTER_RULE_MATCH_PATTERN) {
+			if ((pCurr->tPattern.offset != pRule->tPattern.offset) ||
+			        (pCurr->tPattern.maskLength != pRule->tPattern.maskLength) ||
+			        (pCurr->tPattern.patternLength != pRule->tPattern.patternLength))
+				continue;
+			if ((os_memoryCompare(pRxData->hOs, pCurr->tPattern.mask, pRule->tPattern.mask, pRule->tPattern.maskLength) != 0) ||
+			        (os_memoryCompare(pRxData->hOs, pCurr->tPattern.pattern, pRule->tPattern.pattern, pRule->tPattern.patternLength) != 0))
+				continue;
 		}
+
+		return (int)i;
 	}
 
 	return -1;
@@ -705,109 +756,801 @@ static int parseRxDataFilterRequest(TI_HANDLE hRxData, TRxDataFilterRequest* req
 
 
 /***************************************************************************
-*                           rxData_setRxDataFilter                         *
+*                         rxData_hostFilterEtherType                       *
 ****************************************************************************
-* DESCRIPTION:
+* DESCRIPTION:  Get the ethertype a host filter rule is bound to
 *
+* INPUTS:       pRule - the rule
 *
-* INPUTS:
+* OUTPUT:       pEtherType - the ethertype (IPv4 for IP protocol and port rules)
+*
+* RETURNS:      TI_TRUE if the rule is bound to an ethertype
 *
+***************************************************************************/
+static TI_BOOL rxData_hostFilterEtherType (TRxDataFilterRule *pRule, TI_UINT16 *pEtherType)
+{
+	if (pRule->uMatch & RX_DATA_FILTER_RULE_MATCH_ETHERTYPE) {
+		*pEtherType = pRule->uEtherType;
+		return TI_TRUE;
+	}
+	if (pRule->uMatch & RX_DATA_FILTER_RULE_MATCH_IP_PROTO) {
+		*pEtherType = ETHERTYPE_IP;
+		return TI_TRUE;
+	}
+	return TI_FALSE;
+}
+
+/***************************************************************************
+*                        rxData_hostFilterAddField                         *
+****************************************************************************
+* DESCRIPTION:  Append a single field pattern to the FW filter request
 *
+* INPUTS:       pRxData - the object
+*               uOffset - the field offset from the start of the 802.3 header
+*               pValue - the field value
+*               uLength - the field length
 *
-* OUTPUT:
+* OUTPUT:       numFieldPatterns, lenFieldPatterns, fieldPatterns - the FW request
 *
-* RETURNS:
+* RETURNS:      TI_OK, or TI_NOK if the request is full
 *
 ***************************************************************************/
-static TI_STATUS rxData_addRxDataFilter (TI_HANDLE hRxData, TRxDataFilterRequest* request)
+static TI_STATUS rxData_hostFilterAddField (rxData_t *pRxData, TI_UINT16 uOffset, TI_UINT8 *pValue, TI_UINT8 uLength,
+                                            TI_UINT8 *numFieldPatterns, TI_UINT8 *lenFieldPatterns, TI_UINT8 *fieldPatterns)
 {
-	rxData_t * pRxData = (rxData_t *) hRxData;
+	rxDataFilterFieldPattern_t fieldPattern;
 
-	/* firmware request fields */
-	TI_UINT8 index = 0;
-	TI_UINT8 numFieldPatterns = 0;
-	TI_UINT8 lenFieldPatterns = 0;
-	TI_UINT8 fieldPatterns[MAX_DATA_FILTER_SIZE];
+	if ((*numFieldPatterns >= RX_DATA_FILTER_MAX_FIELD_PATTERNS) ||
+	        (*lenFieldPatterns + RX_DATA_FILTER_FIELD_HDR_LEN + uLength > MAX_DATA_FILTER_SIZE)) {
+		return TI_NOK;
+	}
 
-	/* does the filter already exist? */
-	if (findFilterRequest(hRxData, request) >= 0) {
+	fieldPattern.flag = RX_DATA_FILTER_FLAG_NO_BIT_MASK;
+	if (uOffset < RX_DATA_FILTER_ETHERNET_HEADER_BOUNDARY) {
+		fieldPattern.flag |= RX_DATA_FILTER_FLAG_ETHERNET_HEADER;
+		fieldPattern.offset = uOffset;
+	} else {
+		fieldPattern.flag |= RX_DATA_FILTER_FLAG_IP_HEADER;
+		fieldPattern.offset = uOffset - RX_DATA_FILTER_ETHERNET_HEADER_BOUNDARY;
+	}
+	fieldPattern.length = uLength;
+	os_memoryCopy(pRxData->hOs, fieldPattern.pattern, pValue, uLength);
 
-		return RX_FILTER_ALREADY_EXISTS;
+	++(*numFieldPatterns);
+	closeFieldPattern(pRxData, &fieldPattern, fieldPatterns, lenFieldPatterns);
+
+	return TI_OK;
+}
+
+/***************************************************************************
+*                      rxData_hostFilterFwPatterns                         *
+****************************************************************************
+* DESCRIPTION:  Build the FW field patterns of a host filter rule.
+*               Port matches depend on the IP header length, which the
+*               FW field patterns can't follow, so port rules aren't offloaded.
+*
+* INPUTS:       pRxData - the object
+*               pRule - the rule
+*
+* OUTPUT:       numFieldPatterns, lenFieldPatterns, fieldPatterns - the FW request
+*
+* RETURNS:      TI_OK, or TI_NOK if the rule can't be offloaded
+*
+***************************************************************************/
+static TI_STATUS rxData_hostFilterFwPatterns (rxData_t *pRxData, TRxDataFilterRule *pRule,
+                                              TI_UINT8 *numFieldPatterns, TI_UINT8 *lenFieldPatterns, TI_UINT8 *fieldPatterns)
+{
+	TI_UINT16 uEtherType;
+	TI_UINT8  aValue[2];
+
+	*numFieldPatterns = 0;
+	*lenFieldPatterns = 0;
+
+	if (pRule->uMatch & (RX_DATA_FILTER_RULE_MATCH_SRC_PORT | RX_DATA_FILTER_RULE_MATCH_DST_PORT)) {
+		return TI_NOK;
 	}
 
-	/* find place for insertion */
-	for (index = 0; index < MAX_DATA_FILTERS; ++index) {
-		if (pRxData->isFilterSet[index] == TI_FALSE)
-			break;
+	if (pRule->uMatch & RX_DATA_FILTER_RULE_MATCH_PATTERN) {
+		if (parseRxDataFilterRequest(pRxData, &pRule->tPattern, numFieldPatterns, lenFieldPatterns, fieldPatterns) != TI_OK)
+			return TI_NOK;
 	}
 
-	/* are all filter slots taken? */
-	if (index == MAX_DATA_FILTERS) {
+	if (rxData_hostFilterEtherType(pRule, &uEtherType)) {
+		aValue[0] = (TI_UINT8)(uEtherType >> 8);
+		aValue[1] = (TI_UINT8)uEtherType;
+		if (rxData_hostFilterAddField(pRxData, RX_HOST_FILTER_ETHERTYPE_OFFSET, aValue, 2,
+		                              numFieldPatterns, lenFieldPatterns, fieldPatterns) != TI_OK)
+			return TI_NOK;
+	}
 
-		return RX_NO_AVAILABLE_FILTERS;
+	if (pRule->uMatch & RX_DATA_FILTER_RULE_MATCH_IP_PROTO) {
+		aValue[0] = pRule->uIpProto;
+		if (rxData_hostFilterAddField(pRxData, RX_HOST_FILTER_IP_PROTO_OFFSET, aValue, 1,
+		                              numFieldPatterns, lenFieldPatterns, fieldPatterns) != TI_OK)
+			return TI_NOK;
 	}
 
+	return (*numFieldPatterns > 0) ? TI_OK : TI_NOK;
+}
+
+/***************************************************************************
+*                         rxData_hostFilterBuild                           *
+****************************************************************************
+* DESCRIPTION:  Validate a host filter rule and compile its pattern into
+*               byte tests
+*
+* INPUTS:       pRxData - the object
+*               pRule - the rule
+*
+* OUTPUT:       pFilter - the compiled rule
+*
+* RETURNS:      TI_OK, or TI_NOK if the rule is invalid
+*
+***************************************************************************/
+static TI_STATUS rxData_hostFilterBuild (rxData_t *pRxData, TRxDataFilterRule *pRule, TRxHostFilter *pFilter)
+{
+	TI_UINT8 numFieldPatterns;
+	TI_UINT8 lenFieldPatterns;
+	TI_UINT8 fieldPatterns[MAX_DATA_FILTER_SIZE];
+	TI_UINT16 uEtherType;
+	int maskIter;
 
-	/* parse the filter request into discrete field patterns */
-	if (parseRxDataFilterRequest(hRxData, request, &numFieldPatterns, &lenFieldPatterns, fieldPatterns) != TI_OK)
+	if ((pRule->uMatch == 0) || (pRule->uMatch & ~RX_DATA_FILTER_RULE_MATCH_ALL) ||
+	        ((pRule->uAction != FILTER_DROP) && (pRule->uAction != FILTER_SIGNAL))) {
 		return TI_NOK;
+	}
 
-	if (numFieldPatterns == 0)
+	/* IP protocol and port rules are IPv4 rules, and ports exist only for TCP and UDP */
+	if (pRule->uMatch & (RX_DATA_FILTER_RULE_MATCH_SRC_PORT | RX_DATA_FILTER_RULE_MATCH_DST_PORT)) {
+		if (((pRule->uMatch & RX_DATA_FILTER_RULE_MATCH_IP_PROTO) == 0) ||
+		        ((pRule->uIpProto != RX_HOST_FILTER_IP_PROTO_TCP) && (pRule->uIpProto != RX_HOST_FILTER_IP_PROTO_UDP))) {
+			return TI_NOK;
+		}
+	}
+	if ((pRule->uMatch & RX_DATA_FILTER_RULE_MATCH_IP_PROTO) && (pRule->uMatch & RX_DATA_FILTER_RULE_MATCH_ETHERTYPE) &&
+	        (pRule->uEtherType != ETHERTYPE_IP)) {
 		return TI_NOK;
+	}
+
+	os_memoryZero(pRxData->hOs, pFilter, sizeof(TRxHostFilter));
+	os_memoryCopy(pRxData->hOs, &pFilter->tRule, pRule, sizeof(TRxDataFilterRule));
+	pFilter->uFwSlot = RX_HOST_FILTER_NO_FW_SLOT;
 
-	/* Store configuration for future manipulation */
-	pRxData->isFilterSet[index] = TI_TRUE;
-	os_memoryCopy(pRxData->hOs, &pRxData->filterRequests[index], request, sizeof(pRxData->filterRequests[index]));
+	if (pRule->uMatch & RX_DATA_FILTER_RULE_MATCH_PATTERN) {
+		if ((pRule->tPattern.maskLength == 0) || (pRule->tPattern.maskLength > RX_DATA_FILTER_MAX_MASK_SIZE) ||
+		        (pRule->tPattern.patternLength > RX_DATA_FILTER_MAX_PATTERN_SIZE)) {
+			return TI_NOK;
+		}
+
+		/* the FW request parsing also checks the pattern against the mask */
+		numFieldPatterns = 0;
+		lenFieldPatterns = 0;
+		if ((parseRxDataFilterRequest(pRxData, &pRule->tPattern, &numFieldPatterns, &lenFieldPatterns, fieldPatterns) != TI_OK) ||
+		        (numFieldPatterns == 0)) {
+			return TI_NOK;
+		}
+
+		for (maskIter = 0; maskIter < pRule->tPattern.maskLength * 8; ++maskIter) {
+			if (pRule->tPattern.mask[maskIter / 8] & (1 << (maskIter % 8))) {
+				pFilter->aTests[pFilter->uNumTests].uOffset = pRule->tPattern.offset + maskIter;
+				pFilter->aTests[pFilter->uNumTests].uValue = pRule->tPattern.pattern[pFilter->uNumTests];
+				pFilter->uNumTests++;
+			}
+		}
+		pFilter->uMinLen = pFilter->aTests[pFilter->uNumTests - 1].uOffset + 1;
+	}
 
-	/* Send configuration to firmware */
-	return TWD_CfgRxDataFilter (pRxData->hTWD,
-	                            index,
-	                            ADD_FILTER,
-	                            FILTER_SIGNAL,
-	                            numFieldPatterns,
-	                            lenFieldPatterns,
-	                            fieldPatterns);
+	/* the tree checks the ethertype and protocol, make sure they are in the frame */
+	if (rxData_hostFilterEtherType(pRule, &uEtherType) && (pFilter->uMinLen < ETHERNET_HDR_LEN)) {
+		pFilter->uMinLen = ETHERNET_HDR_LEN;
+	}
 
+	pFilter->bOffloadable = (rxData_hostFilterFwPatterns(pRxData, pRule, &numFieldPatterns, &lenFieldPatterns, fieldPatterns) == TI_OK);
 
+	return TI_OK;
 }
 
 /***************************************************************************
-*                         rxData_removeRxDataFilter                        *
+*                        rxData_hostFilterLeafBuild                        *
 ****************************************************************************
-* DESCRIPTION:
+* DESCRIPTION:  Fill a decision tree leaf with the rules, in priority
+*               order, that a frame reaching it has to be tested against
 *
+* INPUTS:       pTable - the host filters table
+*               bEther - the leaf is bound to uEtherType
+*               uEtherType - the leaf ethertype
+*               bProto - the leaf is bound to uIpProto
+*               uIpProto - the leaf IPv4 protocol
 *
-* INPUTS:
+* OUTPUT:       pSpan - the leaf rules
+*               puList - next free entry in aRuleList
+*
+* RETURNS:
 *
+***************************************************************************/
+static void rxData_hostFilterLeafBuild (TRxHostFilterTable *pTable, TRxHostFilterSpan *pSpan, TI_UINT32 *puList,
+                                        TI_BOOL bEther, TI_UINT16 uEtherType, TI_BOOL bProto, TI_UINT8 uIpProto)
+{
+	TRxDataFilterRule *pRule;
+	TI_UINT16 uRuleEtherType;
+	TI_UINT32 i;
+
+	pSpan->uFirst = (TI_UINT16)*puList;
+	for (i = 0; i < pTable->uNumRules; i++) {
+		pRule = &pTable->aRules[i].tRule;
+
+		if (rxData_hostFilterEtherType(pRule, &uRuleEtherType)) {
+			if ((bEther == TI_FALSE) || (uRuleEtherType != uEtherType))
+				continue;
+			if ((pRule->uMatch & RX_DATA_FILTER_RULE_MATCH_IP_PROTO) && ((bProto == TI_FALSE) || (pRule->uIpProto != uIpProto)))
+				continue;
+		}
+		pTable->aRuleList[(*puList)++] = (TI_UINT8)i;
+	}
+	pSpan->uCount = (TI_UINT8)(*puList - pSpan->uFirst);
+}
+
+/***************************************************************************
+*                        rxData_hostFilterTreeBuild                        *
+****************************************************************************
+* DESCRIPTION:  Compile the host filter rules into the decision tree: an
+*               ethertype node per ethertype the rules use, and an IPv4
+*               protocol node per protocol they use. Every node holds the
+*               complete list of rules a frame reaching it can match,
+*               including the rules that apply to any frame.
 *
+* INPUTS:       pTable - the host filters table
 *
 * OUTPUT:
 *
 * RETURNS:
 *
 ***************************************************************************/
-static TI_STATUS rxData_removeRxDataFilter (TI_HANDLE hRxData, TRxDataFilterRequest* request)
+static void rxData_hostFilterTreeBuild (TRxHostFilterTable *pTable)
+{
+	TRxHostFilterEtherNode *pEther;
+	TRxDataFilterRule *pRule;
+	TI_UINT32 uList = 0;
+	TI_UINT32 i, j, n;
+	TI_UINT16 uEtherType, uOtherType;
+
+	pTable->uNumEtherNodes = 0;
+	pTable->uNumProtoNodes = 0;
+
+	pTable->uNumLeadingDrops = 0;
+	while ((pTable->uNumLeadingDrops < pTable->uNumRules) &&
+	        (pTable->aRules[pTable->uNumLeadingDrops].tRule.uAction == FILTER_DROP)) {
+		pTable->uNumLeadingDrops++;
+	}
+
+	/* frames of other ethertypes */
+	rxData_hostFilterLeafBuild(pTable, &pTable->tWildcard, &uList, TI_FALSE, 0, TI_FALSE, 0);
+
+	for (i = 0; i < pTable->uNumRules; i++) {
+		if (rxData_hostFilterEtherType(&pTable->aRules[i].tRule, &uEtherType) == TI_FALSE) {
+			continue;
+		}
+		for (n = 0; n < pTable->uNumEtherNodes; n++) {
+			if (pTable->aEtherNodes[n].uEtherType == uEtherType)
+				break;
+		}
+		if (n < pTable->uNumEtherNodes) {
+			continue;
+		}
+
+		/* frames of this ethertype, and IPv4 frames of other protocols */
+		pEther = &pTable->aEtherNodes[pTable->uNumEtherNodes++];
+		pEther->uEtherType = uEtherType;
+		rxData_hostFilterLeafBuild(pTable, &pEther->tAnyProto, &uList, TI_TRUE, uEtherType, TI_FALSE, 0);
+
+		pEther->uFirstProto = (TI_UINT8)pTable->uNumProtoNodes;
+		pEther->uNumProtos = 0;
+		for (j = i; j < pTable->uNumRules; j++) {
+			pRule = &pTable->aRules[j].tRule;
+			if (((pRule->uMatch & RX_DATA_FILTER_RULE_MATCH_IP_PROTO) == 0) ||
+			        (rxData_hostFilterEtherType(pRule, &uOtherType) == TI_FALSE) || (uOtherType != uEtherType)) {
+				continue;
+			}
+			for (n = pEther->uFirstProto; n < pTable->uNumProtoNodes; n++) {
+				if (pTable->aProtoNodes[n].uIpProto == pRule->uIpProto)
+					break;
+			}
+			if (n < pTable->uNumProtoNodes) {
+				continue;
+			}
+
+			pTable->aProtoNodes[pTable->uNumProtoNodes].uIpProto = pRule->uIpProto;
+			rxData_hostFilterLeafBuild(pTable, &pTable->aProtoNodes[pTable->uNumProtoNodes].tRules, &uList,
+			                           TI_TRUE, uEtherType, TI_TRUE, pRule->uIpProto);
+			pTable->uNumProtoNodes++;
+			pEther->uNumProtos++;
+		}
+	}
+}
+
+/***************************************************************************
+*                          rxData_hostFilterMatch                          *
+****************************************************************************
+* DESCRIPTION:  Check a frame against the pattern and ports of a rule.
+*               The ethertype and protocol were already checked by the tree.
+*
+* INPUTS:       pFilter - the compiled rule
+*               pData - the frame, starting at the 802.3 header
+*               uLen - the frame length
+*
+* OUTPUT:
+*
+* RETURNS:      TI_TRUE if the frame matches
+*
+***************************************************************************/
+static TI_BOOL rxData_hostFilterMatch (TRxHostFilter *pFilter, TI_UINT8 *pData, TI_UINT32 uLen)
+{
+	TI_UINT32 uL4Offset;
+	TI_UINT32 i;
+
+	if (uLen < pFilter->uMinLen) {
+		return TI_FALSE;
+	}
+
+	for (i = 0; i < pFilter->uNumTests; i++) {
+		if (pData[pFilter->aTests[i].uOffset] != pFilter->aTests[i].uValue)
+			return TI_FALSE;
+	}
+
+	if (pFilter->tRule.uMatch & (RX_DATA_FILTER_RULE_MATCH_SRC_PORT | RX_DATA_FILTER_RULE_MATCH_DST_PORT)) {
+		/* non first fragments carry no ports */
+		if (((pData[RX_HOST_FILTER_IP_FRAG_OFFSET] & 0x1F) | pData[RX_HOST_FILTER_IP_FRAG_OFFSET + 1]) != 0) {
+			return TI_FALSE;
+		}
+
+		uL4Offset = ETHERNET_HDR_LEN + ((pData[ETHERNET_HDR_LEN] & 0x0F) << 2);
+		if (uLen < uL4Offset + 4) {
+			return TI_FALSE;
+		}
+
+		if ((pFilter->tRule.uMatch & RX_DATA_FILTER_RULE_MATCH_SRC_PORT) &&
+		        ((((TI_UINT16)pData[uL4Offset] << 8) | pData[uL4Offset + 1]) != pFilter->tRule.uSrcPort)) {
+			return TI_FALSE;
+		}
+		if ((pFilter->tRule.uMatch & RX_DATA_FILTER_RULE_MATCH_DST_PORT) &&
+		        ((((TI_UINT16)pData[uL4Offset + 2] << 8) | pData[uL4Offset + 3]) != pFilter->tRule.uDstPort)) {
+			return TI_FALSE;
+		}
+	}
+
+	return TI_TRUE;
+}
+
+/***************************************************************************
+*                          rxData_hostFilterLookup                         *
+****************************************************************************
+* DESCRIPTION:  Find the first rule that matches a frame. The frame's
+*               ethertype and protocol select a tree node, and only the
+*               rules of that node are tested.
+*
+* INPUTS:       pTable - the host filters table
+*               pData - the frame, starting at the 802.3 header
+*               uLen - the frame length
+*
+* OUTPUT:
+*
+* RETURNS:      The matching rule index, or -1 if no rule matches
+*
+***************************************************************************/
+static TI_INT32 rxData_hostFilterLookup (TRxHostFilterTable *pTable, TI_UINT8 *pData, TI_UINT32 uLen)
+{
+	TRxHostFilterSpan *pSpan = &pTable->tWildcard;
+	TRxHostFilterEtherNode *pEther;
+	TI_UINT8 *pRuleIndex;
+	TI_UINT32 i, uEnd;
+	TI_UINT16 uEtherType;
+
+	if (uLen >= ETHERNET_HDR_LEN) {
+		uEtherType = ((TI_UINT16)pData[RX_HOST_FILTER_ETHERTYPE_OFFSET] << 8) | pData[RX_HOST_FILTER_ETHERTYPE_OFFSET + 1];
+
+		for (i = 0; i < pTable->uNumEtherNodes; i++) {
+			if (pTable->aEtherNodes[i].uEtherType == uEtherType)
+				break;
+		}
+
+		if (i < pTable->uNumEtherNodes) {
+			pEther = &pTable->aEtherNodes[i];
+			pSpan = &pEther->tAnyProto;
+
+			if ((pEther->uNumProtos > 0) && (uEtherType == ETHERTYPE_IP) &&
+			        (uLen > RX_HOST_FILTER_IP_PROTO_OFFSET) && ((pData[ETHERNET_HDR_LEN] >> 4) == 4)) {
+				uEnd = pEther->uFirstProto + pEther->uNumProtos;
+				for (i = pEther->uFirstProto; i < uEnd; i++) {
+					if (pTable->aProtoNodes[i].uIpProto == pData[RX_HOST_FILTER_IP_PROTO_OFFSET]) {
+						pSpan = &pTable->aProtoNodes[i].tRules;
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	pRuleIndex = &pTable->aRuleList[pSpan->uFirst];
+	for (i = 0; i < pSpan->uCount; i++) {
+		if (rxData_hostFilterMatch(&pTable->aRules[pRuleIndex[i]], pData, uLen)) {
+			return (TI_INT32)pRuleIndex[i];
+		}
+	}
+
+	return -1;
+}
+
+/***************************************************************************
+*                         rxData_hostFilterOffload                         *
+****************************************************************************
+* DESCRIPTION:  Configure the FW filter slots from the host filter rules.
+*               If all the rules can be offloaded, fit in the slots and have
+*               the same action they all go to the FW with the configured
+*               default action, as the order the FW checks its slots in then
+*               can't change the outcome. Otherwise the FW passes everything by
+*               default and the host applies the rules. The FW slots then
+*               hold the drop rules with the highest hit rate that come
+*               before the first pass rule, so dropping them early can't
+*               change the outcome. While the host applies the rules the
+*               slots are rebalanced periodically (rxData_hostFilterRebalance).
+*
+* INPUTS:       pRxData - the object
+*
+* OUTPUT:
+*
+* RETURNS:      TI_OK or TI_NOK
+*
+***************************************************************************/
+static TI_STATUS rxData_hostFilterOffload (rxData_t *pRxData)
+{
+	TRxHostFilterTable *pTable = &pRxData->hostFilters;
+	TI_INT32  aSlotRule[MAX_DATA_FILTERS];
+	TI_UINT8  aCand[RX_DATA_FILTER_MAX_RULES];
+	TI_UINT32 uNumCand = 0;
+	TI_UINT32 i, j, uBest, uSlot;
+	TI_UINT8  uTemp;
+	TI_BOOL   bEnforce = (pTable->uNumRules > MAX_DATA_FILTERS);
+	filter_e  eFwDefault = pRxData->filteringDefaultAction;
+	TI_UINT8  numFieldPatterns;
+	TI_UINT8  lenFieldPatterns;
+	TI_UINT8  fieldPatterns[MAX_DATA_FILTER_SIZE];
+	TI_STATUS eStatus = TI_OK;
+
+	/* mixed actions depend on the rules order, so they are applied on the host */
+	for (i = 0; (i < pTable->uNumRules) && (bEnforce == TI_FALSE); i++) {
+		if ((pTable->aRules[i].bOffloadable == TI_FALSE) ||
+		        (pTable->aRules[i].tRule.uAction != pTable->aRules[0].tRule.uAction))
+			bEnforce = TI_TRUE;
+	}
+
+	if (bEnforce == TI_FALSE) {
+		for (i = 0; i < pTable->uNumRules; i++) {
+			aCand[uNumCand++] = (TI_UINT8)i;
+		}
+	} else {
+		eFwDefault = FILTER_SIGNAL;
+		for (i = 0; i < pTable->uNumLeadingDrops; i++) {
+			if (pTable->aRules[i].bOffloadable)
+				aCand[uNumCand++] = (TI_UINT8)i;
+		}
+		/* keep the most hit candidates, on a tie prefer the ones already in the FW */
+		for (i = 0; (i < MAX_DATA_FILTERS) && (i < uNumCand); i++) {
+			uBest = i;
+			for (j = i + 1; j < uNumCand; j++) {
+				if ((pTable->aRules[aCand[j]].uRate > pTable->aRules[aCand[uBest]].uRate) ||
+				        ((pTable->aRules[aCand[j]].uRate == pTable->aRules[aCand[uBest]].uRate) &&
+				         (pTable->aRules[aCand[j]].uFwSlot != RX_HOST_FILTER_NO_FW_SLOT) &&
+				         (pTable->aRules[aCand[uBest]].uFwSlot == RX_HOST_FILTER_NO_FW_SLOT)))
+					uBest = j;
+			}
+			uTemp = aCand[i];
+			aCand[i] = aCand[uBest];
+			aCand[uBest] = uTemp;
+		}
+		if (uNumCand > MAX_DATA_FILTERS) {
+			uNumCand = MAX_DATA_FILTERS;
+		}
+	}
+
+	for (uSlot = 0; uSlot < MAX_DATA_FILTERS; uSlot++) {
+		aSlotRule[uSlot] = -1;
+	}
+	/* the order doesn't matter, leave offloaded rules in their slots */
+	for (i = 0; i < uNumCand; i++) {
+		if (pTable->aRules[aCand[i]].uFwSlot != RX_HOST_FILTER_NO_FW_SLOT) {
+			aSlotRule[pTable->aRules[aCand[i]].uFwSlot] = aCand[i];
+		}
+	}
+	uSlot = 0;
+	for (i = 0; i < uNumCand; i++) {
+		if (pTable->aRules[aCand[i]].uFwSlot == RX_HOST_FILTER_NO_FW_SLOT) {
+			while (aSlotRule[uSlot] != -1)
+				uSlot++;
+			aSlotRule[uSlot] = aCand[i];
+		}
+	}
+
+	/* start passing everything before the FW rules change */
+	if ((eFwDefault == FILTER_SIGNAL) && (pRxData->fwDefaultAction != FILTER_SIGNAL)) {
+		pRxData->fwDefaultAction = eFwDefault;
+		eStatus = TWD_CfgEnableRxDataFilter (pRxData->hTWD, pRxData->filteringEnabled, pRxData->fwDefaultAction);
+	}
+	pRxData->hostFilterEnforce = bEnforce;
+
+	if (bEnforce && (pRxData->hostFilterTimerRunning == TI_FALSE)) {
+		pRxData->hostFilterTimerRunning = TI_TRUE;
+		tmr_StartTimer (pRxData->hHostFilterTimer,
+		                rxData_hostFilterRebalance,
+		                (TI_HANDLE)pRxData,
+		                RX_HOST_FILTER_REBALANCE_PERIOD,
+		                TI_TRUE);
+	} else if ((bEnforce == TI_FALSE) && pRxData->hostFilterTimerRunning) {
+		pRxData->hostFilterTimerRunning = TI_FALSE;
+		tmr_StopTimer (pRxData->hHostFilterTimer);
+	}
+
+	for (i = 0; i < pTable->uNumRules; i++) {
+		uSlot = pTable->aRules[i].uFwSlot;
+		if ((uSlot != RX_HOST_FILTER_NO_FW_SLOT) && (aSlotRule[uSlot] != (TI_INT32)i)) {
+			pTable->aRules[i].uFwSlot = RX_HOST_FILTER_NO_FW_SLOT;
+			eStatus = TWD_CfgRxDataFilter (pRxData->hTWD, (TI_UINT8)uSlot, REMOVE_FILTER, FILTER_SIGNAL, 0, 0, NULL);
+		}
+	}
+
+	for (uSlot = 0; uSlot < MAX_DATA_FILTERS; uSlot++) {
+		if ((aSlotRule[uSlot] == -1) || (pTable->aRules[aSlotRule[uSlot]].uFwSlot == uSlot)) {
+			continue;
+		}
+		rxData_hostFilterFwPatterns(pRxData, &pTable->aRules[aSlotRule[uSlot]].tRule, &numFieldPatterns, &lenFieldPatterns, fieldPatterns);
+		pTable->aRules[aSlotRule[uSlot]].uFwSlot = (TI_UINT8)uSlot;
+		eStatus = TWD_CfgRxDataFilter (pRxData->hTWD,
+		                               (TI_UINT8)uSlot,
+		                               ADD_FILTER,
+		                               (filter_e)pTable->aRules[aSlotRule[uSlot]].tRule.uAction,
+		                               numFieldPatterns,
+		                               lenFieldPatterns,
+		                               fieldPatterns);
+	}
+
+	if (eFwDefault != pRxData->fwDefaultAction) {
+		pRxData->fwDefaultAction = eFwDefault;
+		eStatus = TWD_CfgEnableRxDataFilter (pRxData->hTWD, pRxData->filteringEnabled, pRxData->fwDefaultAction);
+	}
+
+	return eStatus;
+}
+
+/***************************************************************************
+*                        rxData_hostFilterRebalance                        *
+****************************************************************************
+* DESCRIPTION:  Periodic timer callback while the host applies the rules.
+*               Each rule's hit rate is the number of hits in the last period.
+*               An offloaded rule stops getting hits, as the FW drops its
+*               frames, so its rate is the last one measured on the host,
+*               halved every period. A drop rule applied on the host whose
+*               rate is clearly higher than the lowest offloaded rate takes
+*               that FW slot. A decayed rule that still gets the traffic thus
+*               comes back to the host for a period, and wins its slot back
+*               if it is still the busier one. At most one reconfiguration
+*               is done per period, and never from the Rx path.
+*
+* INPUTS:       hRxData - the object
+*               bTwdInitOccured - not used
+*
+* OUTPUT:
+*
+* RETURNS:
+*
+***************************************************************************/
+static void rxData_hostFilterRebalance (TI_HANDLE hRxData, TI_BOOL bTwdInitOccured)
+{
+	rxData_t *pRxData = (rxData_t *)hRxData;
+	TRxHostFilterTable *pTable = &pRxData->hostFilters;
+	TRxHostFilter *pFilter;
+	TI_UINT32 uMinRate = 0xFFFFFFFF;
+	TI_UINT32 uMaxRate = 0;
+	TI_UINT32 i;
+
+	if (pRxData->hostFilterEnforce == TI_FALSE) {
+		return;
+	}
+
+	for (i = 0; i < pTable->uNumRules; i++) {
+		pFilter = &pTable->aRules[i];
+		if (pFilter->uFwSlot == RX_HOST_FILTER_NO_FW_SLOT) {
+			pFilter->uRate = pFilter->uPeriodHits;
+			if ((i < pTable->uNumLeadingDrops) && pFilter->bOffloadable && (pFilter->uRate > uMaxRate))
+				uMaxRate = pFilter->uRate;
+		} else {
+			pFilter->uRate >>= 1;
+			if (pFilter->uRate < uMinRate)
+				uMinRate = pFilter->uRate;
+		}
+		pFilter->uPeriodHits = 0;
+	}
+
+	/* free FW slots are always filled, so only a replacement is checked */
+	if ((uMinRate != 0xFFFFFFFF) && (uMaxRate > uMinRate + RX_HOST_FILTER_REBALANCE_MARGIN)) {
+		rxData_hostFilterOffload(pRxData);
+	}
+}
+
+/***************************************************************************
+*                          rxData_hostFilterPass                           *
+****************************************************************************
+* DESCRIPTION:  Apply the host filter rules to a received data frame.
+*               Called only while the host applies the rules (when the FW
+*               holds all of them it already filtered the frame). Only the
+*               hit counters are updated here, the FW slots are rebalanced
+*               by rxData_hostFilterRebalance.
+*
+* INPUTS:       pRxData - the object
+*               pBuffer - the received Buffer, in 802.3 format
+*
+* OUTPUT:
+*
+* RETURNS:      TI_TRUE to deliver the frame, TI_FALSE to drop it
+*
+***************************************************************************/
+static TI_BOOL rxData_hostFilterPass (rxData_t *pRxData, void *pBuffer)
+{
+	TRxHostFilterTable *pTable = &pRxData->hostFilters;
+	TRxHostFilter *pFilter;
+	TI_INT32 iRule;
+	filter_e eAction;
+
+	iRule = rxData_hostFilterLookup(pTable, (TI_UINT8 *)RX_ETH_PKT_DATA(pBuffer), RX_ETH_PKT_LEN(pBuffer));
+
+	if (iRule < 0) {
+		pRxData->hostFilterDefaultHits++;
+		eAction = pRxData->filteringDefaultAction;
+	} else {
+		pFilter = &pTable->aRules[iRule];
+		pFilter->uHits++;
+		pFilter->uPeriodHits++;
+		eAction = (filter_e)pFilter->tRule.uAction;
+	}
+
+	if (eAction != FILTER_DROP) {
+		return TI_TRUE;
+	}
+
+	pRxData->hostFilterDropped++;
+	return TI_FALSE;
+}
+
+/***************************************************************************
+*                        rxData_addRxDataFilterRule                        *
+****************************************************************************
+* DESCRIPTION:  Add a host filter rule, after the existing ones
+*
+* INPUTS:       hRxData - the object
+*               pRule - the rule
+*
+* OUTPUT:
+*
+* RETURNS:      TI_OK, RX_FILTER_ALREADY_EXISTS, RX_NO_AVAILABLE_FILTERS or TI_NOK
+*
+***************************************************************************/
+static TI_STATUS rxData_addRxDataFilterRule (TI_HANDLE hRxData, TRxDataFilterRule* pRule)
 {
 	rxData_t * pRxData = (rxData_t *) hRxData;
+	TRxHostFilterTable *pTable = &pRxData->hostFilters;
+
+	/* does the rule already exist? */
+	if (findFilterRule(hRxData, pRule) >= 0) {
 
-	int index = findFilterRequest(hRxData, request);
+		return RX_FILTER_ALREADY_EXISTS;
+	}
+
+	/* are all rules taken? */
+	if (pTable->uNumRules == RX_DATA_FILTER_MAX_RULES) {
+
+		return RX_NO_AVAILABLE_FILTERS;
+	}
+
+	if (rxData_hostFilterBuild(pRxData, pRule, &pTable->aRules[pTable->uNumRules]) != TI_OK)
+		return TI_NOK;
+
+	pTable->uNumRules++;
+	rxData_hostFilterTreeBuild(pTable);
+
+	return rxData_hostFilterOffload(pRxData);
+}
+
+/***************************************************************************
+*                       rxData_removeRxDataFilterRule                      *
+****************************************************************************
+* DESCRIPTION:  Remove a host filter rule
+*
+* INPUTS:       hRxData - the object
+*               pRule - the rule
+*
+* OUTPUT:
+*
+* RETURNS:      TI_OK, RX_FILTER_DOES_NOT_EXIST or TI_NOK
+*
+***************************************************************************/
+static TI_STATUS rxData_removeRxDataFilterRule (TI_HANDLE hRxData, TRxDataFilterRule* pRule)
+{
+	rxData_t * pRxData = (rxData_t *) hRxData;
+	TRxHostFilterTable *pTable = &pRxData->hostFilters;
+	int index = findFilterRule(hRxData, pRule);
 
-	/* does the filter exist? */
+	/* does the rule exist? */
 	if (index < 0) {
 
 		return RX_FILTER_DOES_NOT_EXIST;
 	}
 
+	if (pTable->aRules[index].uFwSlot != RX_HOST_FILTER_NO_FW_SLOT) {
+		TWD_CfgRxDataFilter (pRxData->hTWD, pTable->aRules[index].uFwSlot, REMOVE_FILTER, FILTER_SIGNAL, 0, 0, NULL);
+	}
+
+	pTable->uNumRules--;
+	for (; index < (int)pTable->uNumRules; index++) {
+		os_memoryCopy(pRxData->hOs, &pTable->aRules[index], &pTable->aRules[index + 1], sizeof(TRxHostFilter));
+	}
+	rxData_hostFilterTreeBuild(pTable);
+
+	return rxData_hostFilterOffload(pRxData);
+}
+
+
+/***************************************************************************
+*                           rxData_setRxDataFilter                         *
+****************************************************************************
+* DESCRIPTION:  Add a pass filter, as a host filter rule
+*
+*
+* INPUTS:
+*
+*
+*
+* OUTPUT:
+*
+* RETURNS:
+*
+***************************************************************************/
+static TI_STATUS rxData_addRxDataFilter (TI_HANDLE hRxData, TRxDataFilterRequest* request)
+{
+	rxData_t * pRxData = (rxData_t *) hRxData;
+	TRxDataFilterRule tRule;
 
-	pRxData->isFilterSet[index] = TI_FALSE;
+	os_memoryZero(pRxData->hOs, &tRule, sizeof(tRule));
+	tRule.uMatch = RX_DATA_FILTER_RULE_MATCH_PATTERN;
+	tRule.uAction = FILTER_SIGNAL;
+	os_memoryCopy(pRxData->hOs, &tRule.tPattern, request, sizeof(TRxDataFilterRequest));
 
-	return TWD_CfgRxDataFilter (pRxData->hTWD,
-	                            index,
-	                            REMOVE_FILTER,
-	                            FILTER_SIGNAL,
-	                            0,
-	                            0,
-	                            NULL);
+	return rxData_addRxDataFilterRule(hRxData, &tRule);
+}
+
+/***************************************************************************
+*                         rxData_removeRxDataFilter                        *
+****************************************************************************
+* DESCRIPTION:  Remove a pass filter added by rxData_addRxDataFilter
+*
+*
+* INPUTS:
+*
+*
+*
+* OUTPUT:
+*
+* RETURNS:
+*
+***************************************************************************/
+static TI_STATUS rxData_removeRxDataFilter (TI_HANDLE hRxData, TRxDataFilterRequest* request)
+{
+	rxData_t * pRxData = (rxData_t *) hRxData;
+	TRxDataFilterRule tRule;
+
+	os_memoryZero(pRxData->hOs, &tRule, sizeof(tRule));
+	tRule.uMatch = RX_DATA_FILTER_RULE_MATCH_PATTERN;
+	tRule.uAction = FILTER_SIGNAL;
+	os_memoryCopy(pRxData->hOs, &tRule.tPattern, request, sizeof(TRxDataFilterRequest));
+
+	return rxData_removeRxDataFilterRule(hRxData, &tRule);
 }
 
 /***************************************************************************
@@ -1184,6 +1927,13 @@ static void rxData_rcvPacketData(TI_HANDLE hRxData, void *pBuffer, TRxAttr* pRxA
 		}
 	}
 
+	/* apply the host Rx data filters before the frame is counted and delivered (unless the FW holds them all) */
+	if ((pRxData->filteringEnabled) && (pRxData->hostFilterEnforce) &&
+	        (rxData_hostFilterPass(pRxData, pBuffer) == TI_FALSE)) {
+		RxBufFree(pRxData->hOs, pBuffer);
+		return;
+	}
+
 	/* update traffic monitor parameters */
 	pRxData->rxDataCounters.RecvOk++;
 	EventMask |= RECV_OK;
@@ -1534,6 +2284,7 @@ static void rxData_ReceivePacket (TI_HANDLE   hRxData,
 
 		case RX_DESC_STATUS_DECRYPT_FAIL: {
 
+			TRACE1(pRxData->hReport, REPORT_SEVERITY_WARNING, "rxData_ReceivePacket: decrypt failure, frame control 0x%x\n", pHdr->fc);
 			RxBufFree(pRxData->hOs, pBuffer);
 			return;
 		}
@@ -1599,6 +2350,8 @@ static void rxData_ReceivePacket (TI_HANDLE   hRxData,
 		               sizeof(pRxParams->timestamp) );
 		RxAttr.TimeStamp = ENDIAN_HANDLE_LONG(RxAttr.TimeStamp);
 
+		TRACE4(pRxData->hReport, REPORT_SEVERITY_INFORMATION, "rxData_ReceivePacket: class %d, rate %d, rssi %d, channel %d\n",
+		       RxAttr.ePacketType, RxAttr.Rate, RxAttr.Rssi, RxAttr.channel);
 
 		rxData_receivePacketFromWlan (hRxData, pBuffer, &RxAttr);
 
@@ -1783,18 +2536,203 @@ static void rxData_printRxThroughput (TI_HANDLE hRxData, TI_BOOL bTwdInitOccured
 
 void rxData_printRxDataFilter (TI_HANDLE hRxData)
 {
+	rxData_t *pRxData = (rxData_t *)hRxData;
+	TRxHostFilterTable *pTable = &pRxData->hostFilters;
+	TRxHostFilter *pFilter;
 	TI_UINT32 index;
+
+	WLAN_OS_REPORT (("Rx data filters %s, default action %d, FW default action %d, rules applied by the %s\n",
+	                 pRxData->filteringEnabled ? "enabled" : "disabled", pRxData->filteringDefaultAction,
+	                 pRxData->fwDefaultAction, pRxData->hostFilterEnforce ? "host" : "FW"));
+	WLAN_OS_REPORT (("%d rules, %d wildcard, %d ethertype nodes, %d protocol nodes\n",
+	                 pTable->uNumRules, pTable->tWildcard.uCount, pTable->uNumEtherNodes, pTable->uNumProtoNodes));
+	WLAN_OS_REPORT (("Default action hits = %d, dropped on host = %d\n",
+	                 pRxData->hostFilterDefaultHits, pRxData->hostFilterDropped));
+
+	for (index = 0; index < pTable->uNumRules; index++) {
+		pFilter = &pTable->aRules[index];
+		WLAN_OS_REPORT (("index=%2d, %s, match 0x%02x, ethertype 0x%04x, proto %3d, ports %5d/%5d, FW slot %3d, hits %d, rate %d\n",
+		                 index, (pFilter->tRule.uAction == FILTER_DROP) ? "drop" : "pass", pFilter->tRule.uMatch,
+		                 pFilter->tRule.uEtherType, pFilter->tRule.uIpProto, pFilter->tRule.uSrcPort, pFilter->tRule.uDstPort,
+		                 (pFilter->uFwSlot == RX_HOST_FILTER_NO_FW_SLOT) ? -1 : pFilter->uFwSlot, pFilter->uHits, pFilter->uRate));
+		if (pFilter->tRule.uMatch & RX_DATA_FILTER_RULE_MATCH_PATTERN) {
+			WLAN_OS_REPORT (("offset=%d, pattern & mask\n", pFilter->tRule.tPattern.offset));
+			report_PrintDump(pFilter->tRule.tPattern.pattern, pFilter->tRule.tPattern.patternLength);
+			report_PrintDump(pFilter->tRule.tPattern.mask, pFilter->tRule.tPattern.maskLength);
+		}
+	}
+}
+
+/* Reference for the benchmark: check every rule in order, including the ethertype and protocol */
+static TI_INT32 rxData_hostFilterLookupLinear (TRxHostFilterTable *pTable, TI_UINT8 *pData, TI_UINT32 uLen)
+{
+	TRxDataFilterRule *pRule;
+	TI_UINT16 uEtherType;
+	TI_UINT32 i;
+
+	for (i = 0; i < pTable->uNumRules; i++) {
+		pRule = &pTable->aRules[i].tRule;
+		if (rxData_hostFilterEtherType(pRule, &uEtherType)) {
+			if ((uLen < ETHERNET_HDR_LEN) ||
+			        ((((TI_UINT16)pData[RX_HOST_FILTER_ETHERTYPE_OFFSET] << 8) | pData[RX_HOST_FILTER_ETHERTYPE_OFFSET + 1]) != uEtherType))
+				continue;
+		}
+		if (pRule->uMatch & RX_DATA_FILTER_RULE_MATCH_IP_PROTO) {
+			if ((uLen <= RX_HOST_FILTER_IP_PROTO_OFFSET) || ((pData[ETHERNET_HDR_LEN] >> 4) != 4) ||
+			        (pData[RX_HOST_FILTER_IP_PROTO_OFFSET] != pRule->uIpProto))
+				continue;
+		}
+		if (rxData_hostFilterMatch(&pTable->aRules[i], pData, uLen))
+			return (TI_INT32)i;
+	}
+
+	return -1;
+}
+
+/**
+ * \fn     rxData_benchRxDataFilters
+ * \brief  Benchmark the host Rx data filters lookup
+ *
+ * Compile 32 rules (UDP and TCP ports, ethertypes and IP address patterns) into a
+ * private table, check the tree lookup against a linear scan of the rules on a set
+ * of frames, and print the time both take. The active filters are not touched.
+ *
+ * \note
+ * \param  hRxData     - The object
+ * \param  uIterations - Number of passes over the frames (0 for 10000)
+ * \return void
+ * \sa
+ */
+void rxData_benchRxDataFilters (TI_HANDLE hRxData, TI_UINT32 uIterations)
+{
 	rxData_t *pRxData = (rxData_t *)hRxData;
+	TRxHostFilterTable *pTable;
+	TRxDataFilterRule tRule;
+	TI_UINT8 aFrames[RX_BENCH_NUM_FRAMES][RX_BENCH_FRAME_LEN];
+	TI_INT32 iTree, iLinear;
+	TI_UINT32 uStart, uTreeUs, uLinearUs;
+	TI_UINT32 uMismatches = 0, uMatched = 0;
+	TI_UINT32 i, j;
+
+	if (uIterations == 0) {
+		uIterations = 10000;
+	}
 
-	for (index=0; index<MAX_DATA_FILTERS; index++) {
-		if (pRxData->isFilterSet[index]) {
-			WLAN_OS_REPORT (("index=%d, pattern & mask\n", index));
-			report_PrintDump(pRxData->filterRequests[index].pattern, pRxData->filterRequests[index].patternLength);
-			report_PrintDump(pRxData->filterRequests[index].mask, pRxData->filterRequests[index].maskLength);
-		} else {
-			WLAN_OS_REPORT (("No Filter defined for index-%d\n", index));
+	pTable = os_memoryAlloc(pRxData->hOs, sizeof(TRxHostFilterTable));
+	if (pTable == NULL) {
+		WLAN_OS_REPORT(("Rx data filters benchmark: memory allocation failed\n"));
+		return;
+	}
+	os_memoryZero(pRxData->hOs, pTable, sizeof(TRxHostFilterTable));
+
+	for (i = 0; i < RX_DATA_FILTER_MAX_RULES; i++) {
+		os_memoryZero(pRxData->hOs, &tRule, sizeof(tRule));
+		tRule.uAction = FILTER_DROP;
+		switch (i % 4) {
+		case 0:
+			tRule.uMatch = RX_DATA_FILTER_RULE_MATCH_IP_PROTO | RX_DATA_FILTER_RULE_MATCH_DST_PORT;
+			tRule.uIpProto = RX_HOST_FILTER_IP_PROTO_UDP;
+			tRule.uDstPort = (TI_UINT16)(5000 + i);
+			break;
+		case 1:
+			tRule.uMatch = RX_DATA_FILTER_RULE_MATCH_IP_PROTO | RX_DATA_FILTER_RULE_MATCH_SRC_PORT;
+			tRule.uIpProto = RX_HOST_FILTER_IP_PROTO_TCP;
+			tRule.uSrcPort = (TI_UINT16)(8000 + i);
+			break;
+		case 2:
+			tRule.uMatch = RX_DATA_FILTER_RULE_MATCH_ETHERTYPE;
+			tRule.uEtherType = (TI_UINT16)(0x8800 + i);
+			tRule.uAction = FILTER_SIGNAL;
+			break;
+		default:
+			/* IPv4 source address 10.0.i.1 */
+			tRule.uMatch = RX_DATA_FILTER_RULE_MATCH_ETHERTYPE | RX_DATA_FILTER_RULE_MATCH_PATTERN;
+			tRule.uEtherType = ETHERTYPE_IP;
+			tRule.tPattern.offset = 26;
+			tRule.tPattern.maskLength = 1;
+			tRule.tPattern.mask[0] = 0x0F;
+			tRule.tPattern.patternLength = 4;
+			tRule.tPattern.pattern[0] = 10;
+			tRule.tPattern.pattern[1] = 0;
+			tRule.tPattern.pattern[2] = (TI_UINT8)i;
+			tRule.tPattern.pattern[3] = 1;
+			break;
+		}
+		if (rxData_hostFilterBuild(pRxData, &tRule, &pTable->aRules[pTable->uNumRules]) == TI_OK) {
+			pTable->uNumRules++;
+		}
+	}
+	rxData_hostFilterTreeBuild(pTable);
+
+	/* IPv4 UDP and TCP frames hitting early, late and no rules, and ARP frames */
+	os_memoryZero(pRxData->hOs, aFrames, sizeof(aFrames));
+	for (i = 0; i < RX_BENCH_NUM_FRAMES; i++) {
+		TI_UINT8 *pFrame = aFrames[i];
+		TI_UINT16 uPort;
+
+		pFrame[RX_HOST_FILTER_ETHERTYPE_OFFSET] = (TI_UINT8)(ETHERTYPE_IP >> 8);
+		pFrame[RX_HOST_FILTER_ETHERTYPE_OFFSET + 1] = (TI_UINT8)ETHERTYPE_IP;
+		pFrame[ETHERNET_HDR_LEN] = 0x45;
+		pFrame[RX_HOST_FILTER_IP_PROTO_OFFSET] = (i & 1) ? RX_HOST_FILTER_IP_PROTO_TCP : RX_HOST_FILTER_IP_PROTO_UDP;
+		pFrame[26] = 10;
+		pFrame[28] = (TI_UINT8)(i * 4 + 3);
+		pFrame[29] = (i < 4) ? 2 : 1;
+		uPort = (TI_UINT16)((i & 1) ? (8000 + (i * 4 + 1)) : (5000 + (i * 4)));
+		pFrame[34 + ((i & 1) ? 0 : 2)] = (TI_UINT8)(uPort >> 8);
+		pFrame[35 + ((i & 1) ? 0 : 2)] = (TI_UINT8)uPort;
+		if (i % 3 == 2) {
+			/* another port, so only the address rules may match */
+			pFrame[37] ^= 0x80;
+			pFrame[35] ^= 0x80;
+		}
+		if (i >= RX_BENCH_NUM_FRAMES - 2) {
+			pFrame[RX_HOST_FILTER_ETHERTYPE_OFFSET] = 0x08;
+			pFrame[RX_HOST_FILTER_ETHERTYPE_OFFSET + 1] = 0x06;
 		}
 	}
+
+	for (j = 0; j < RX_BENCH_NUM_FRAMES; j++) {
+		iTree = rxData_hostFilterLookup(pTable, aFrames[j], RX_BENCH_FRAME_LEN);
+		iLinear = rxData_hostFilterLookupLinear(pTable, aFrames[j], RX_BENCH_FRAME_LEN);
+		if (iTree != iLinear) {
+			WLAN_OS_REPORT(("Mismatch: frame %d, tree rule %d, linear rule %d\n", j, iTree, iLinear));
+			uMismatches++;
+		}
+		if (iTree >= 0) {
+			uMatched++;
+		}
+	}
+
+	uStart = os_timeStampUs(pRxData->hOs);
+	for (i = 0; i < uIterations; i++) {
+		for (j = 0; j < RX_BENCH_NUM_FRAMES; j++) {
+			iTree = rxData_hostFilterLookup(pTable, aFrames[j], RX_BENCH_FRAME_LEN);
+			if (iTree >= 0) {
+				pTable->aRules[iTree].uHits++;
+			}
+		}
+	}
+	uTreeUs = os_timeStampUs(pRxData->hOs) - uStart;
+
+	uStart = os_timeStampUs(pRxData->hOs);
+	for (i = 0; i < uIterations; i++) {
+		for (j = 0; j < RX_BENCH_NUM_FRAMES; j++) {
+			iLinear = rxData_hostFilterLookupLinear(pTable, aFrames[j], RX_BENCH_FRAME_LEN);
+			if (iLinear >= 0) {
+				pTable->aRules[iLinear].uHits++;
+			}
+		}
+	}
+	uLinearUs = os_timeStampUs(pRxData->hOs) - uStart;
+
+	WLAN_OS_REPORT(("Rx data filters benchmark: %d rules, %d frames (%d matched) x %d iterations, %d mismatches\n",
+	                pTable->uNumRules, RX_BENCH_NUM_FRAMES, uMatched, uIterations, uMismatches));
+	WLAN_OS_REPORT(("Tree lookup:   %d us (%d ns per frame)\n", uTreeUs,
+	                (uTreeUs * 1000) / (uIterations * RX_BENCH_NUM_FRAMES)));
+	WLAN_OS_REPORT(("Linear lookup: %d us (%d ns per frame)\n", uLinearUs,
+	                (uLinearUs * 1000) / (uIterations * RX_BENCH_NUM_FRAMES)));
+
+	os_memoryFree(pRxData->hOs, pTable, sizeof(TRxHostFilterTable));
 }
 
 #endif /*TI_DBG*/
@@ -76,6 +76,67 @@ typedef enum {
 typedef void (*rxData_pBufferDispatchert) (TI_HANDLE hRxData , void *pBuffer, TRxAttr *pRxAttr);
 
 
+/* Host Rx data filters */
+#define RX_HOST_FILTER_NO_FW_SLOT           0xFF
+#define RX_HOST_FILTER_REBALANCE_PERIOD     2000    /* msec between FW slot rebalances while the host applies the rules */
+#define RX_HOST_FILTER_REBALANCE_MARGIN     32      /* hits per period a host rule needs above an offloaded one to replace it */
+
+typedef struct {
+	TI_UINT16           uOffset;        /* offset from the start of the 802.3 header */
+	TI_UINT8            uValue;
+} TRxHostFilterTest;
+
+typedef struct {
+	TRxDataFilterRule   tRule;
+	TRxHostFilterTest   aTests[RX_DATA_FILTER_MAX_PATTERN_SIZE];    /* pattern bytes, by ascending offset */
+	TI_UINT8            uNumTests;
+	TI_UINT16           uMinLen;        /* shortest frame the pattern tests fit in */
+	TI_BOOL             bOffloadable;   /* can be expressed as FW field patterns */
+	TI_UINT8            uFwSlot;        /* FW filter index or RX_HOST_FILTER_NO_FW_SLOT */
+	TI_UINT32           uHits;          /* frames matched on the host */
+	TI_UINT32           uPeriodHits;    /* frames matched on the host in the current rebalance period */
+	TI_UINT32           uRate;          /* hits in the last period; decays while offloaded (the FW drops the frames) */
+} TRxHostFilter;
+
+typedef struct {
+	TI_UINT16           uFirst;         /* first entry in aRuleList */
+	TI_UINT8            uCount;
+} TRxHostFilterSpan;
+
+typedef struct {
+	TI_UINT16           uEtherType;
+	TRxHostFilterSpan   tAnyProto;      /* rules for frames of this ethertype, but not of one of its protocols */
+	TI_UINT8            uFirstProto;    /* first entry in aProtoNodes */
+	TI_UINT8            uNumProtos;
+} TRxHostFilterEtherNode;
+
+typedef struct {
+	TI_UINT8            uIpProto;
+	TRxHostFilterSpan   tRules;
+} TRxHostFilterProtoNode;
+
+/*
+ * The rules are kept in priority order. Compiling them builds a two level decision tree
+ * (ethertype, then IPv4 protocol) whose nodes hold the ordered list of the rules a frame
+ * reaching them can match, so a frame is never tested against rules of other ethertypes
+ * or protocols. A rule that applies to any frame appears in every node.
+ */
+#define RX_HOST_FILTER_MAX_RULE_LIST        (RX_DATA_FILTER_MAX_RULES * (1 + 2 * RX_DATA_FILTER_MAX_RULES))
+
+typedef struct {
+	TRxHostFilter           aRules[RX_DATA_FILTER_MAX_RULES];
+	TI_UINT32               uNumRules;
+
+	TI_UINT8                aRuleList[RX_HOST_FILTER_MAX_RULE_LIST];
+	TRxHostFilterSpan       tWildcard;
+	TRxHostFilterEtherNode  aEtherNodes[RX_DATA_FILTER_MAX_RULES];
+	TI_UINT32               uNumEtherNodes;
+	TRxHostFilterProtoNode  aProtoNodes[RX_DATA_FILTER_MAX_RULES];
+	TI_UINT32               uNumProtoNodes;
+	TI_UINT32               uNumLeadingDrops;   /* rules before the first pass rule */
+} TRxHostFilterTable;
+
+
 typedef struct {
 	/* Handles */
 	TI_HANDLE	 		hCtrlData;
@@ -101,8 +162,13 @@ typedef struct {
 	/* Rx Data Filters */
 	filter_e            filteringDefaultAction;
 	TI_BOOL             filteringEnabled;
-	TI_BOOL             isFilterSet[MAX_DATA_FILTERS];
-	TRxDataFilterRequest filterRequests[MAX_DATA_FILTERS];
+	filter_e            fwDefaultAction;        /* default action configured in the FW */
+	TI_BOOL             hostFilterEnforce;      /* FW doesn't hold all the rules, the host applies them */
+	TRxHostFilterTable  hostFilters;
+	TI_HANDLE           hHostFilterTimer;       /* periodic FW slot rebalance while the host applies the rules */
+	TI_BOOL             hostFilterTimerRunning;
+	TI_UINT32           hostFilterDefaultHits;
+	TI_UINT32           hostFilterDropped;
 
 	/* Counters */
 	rxDataCounters_t	rxDataCounters;
@@ -130,9 +130,13 @@ static inline TI_UINT16 txCtrl_TranslateLengthToFw (TTxCtrlBlk *pPktCtrlBlk)
 static inline void txCtrl_TranslateTimeToFw (txCtrl_t *pTxCtrl, TTxCtrlBlk *pPktCtrlBlk, TI_UINT16 uLifeTime)
 {
 	TI_UINT32 uPktStartTime = pPktCtrlBlk->tTxDescriptor.startTime;  /* Contains host start time */
+	TI_UINT32 uHostTime = os_timeStampMs (pTxCtrl->hOs);
 
 	/* Save host packet handling time until this point (for statistics) */
-	pPktCtrlBlk->tTxPktParams.uDriverDelay = os_timeStampMs (pTxCtrl->hOs) - uPktStartTime;
+	pPktCtrlBlk->tTxPktParams.uDriverDelay = uHostTime - uPktStartTime;
+
+	/* Save the transfer time in host format (for the Tx stuck check) */
+	pTxCtrl->aXferTime[pPktCtrlBlk->tTxDescriptor.descID] = uHostTime;
 
 	/* Translate packet timestamp to FW time and undate descriptor */
 	uPktStartTime = TWD_TranslateToFwTime (pTxCtrl->hTWD, uPktStartTime);
@@ -593,9 +597,17 @@ static void txCtrl_TxCompleteCb (TI_HANDLE hTxCtrl, TxResultDescriptor_t *pTxRes
 	}
 #endif
 
+	TRACE4(pTxCtrl->hReport, REPORT_SEVERITY_INFORMATION, "txCtrl_TxCompleteCb: desc %d, status %d, retries %d, ac %d\n",
+	       pTxResultInfo->descID, pTxResultInfo->status, pTxResultInfo->ackFailures, ac);
+
 	/* Add the medium usage time for the specific queue. */
 	pTxCtrl->totalUsedTime[ac] += (TI_UINT32)ENDIAN_HANDLE_WORD(pTxResultInfo->mediumUsage);
 
+	/* Save the last successful data Tx time per AC (used to defer the keep-alive messages) */
+	if (bIsDataPkt && (pTxResultInfo->status == TX_SUCCESS)) {
+		pTxCtrl->aLastTxTime[ac] = os_timeStampMs (pTxCtrl->hOs);
+	}
+
 	/* update TX counters for txDistributer */
 	{
 		txCtrl_UpdateTxCounters (pTxCtrl, pTxResultInfo, pPktCtrlBlk, ac, bIsDataPkt);
@@ -1242,14 +1254,24 @@ TI_STATUS txCtrl_NotifyFwReset (TI_HANDLE hTxCtrl)
 ****************************************************************************
 * DESCRIPTION:  Check if there are stale packets in the TxCtrlTable.
 * The criterion for staleness is function of life time (2 times the longest life time)
-* Note that only packets that were not sent to the FW are checked for simplicity!
+* Note that only packets that were sent to the FW are checked, since the FW must complete
+*     or drop them within their life time. Packets held in the host queues (e.g. while the
+*     port is closed, during scan or while the queues are stopped) are not a Tx stuck.
 ***************************************************************************/
 TI_STATUS txCtrl_CheckForTxStuck (TI_HANDLE hTxCtrl)
 {
 	txCtrl_t   *pTxCtrl = (txCtrl_t *)hTxCtrl;
 	TI_UINT32  entry;
 	TTxCtrlBlk *pPktCtrlBlk;
-	TI_UINT32  uPktAge;		/* Time in uSec since packet start time. */
+	TI_UINT32  uPktAge;		/* Time in mSec since packet transfer to the FW. */
+	TI_UINT32  uMaxLifeTimeTu = MGMT_PKT_LIFETIME_TU;
+	TI_UINT32  uAc;
+
+	for (uAc = 0; uAc < MAX_NUM_OF_AC; uAc++) {
+		if (pTxCtrl->aMsduLifeTimeTu[uAc] > uMaxLifeTimeTu) {
+			uMaxLifeTimeTu = pTxCtrl->aMsduLifeTimeTu[uAc];
+		}
+	}
 
 	for (entry = 0; entry < CTRL_BLK_ENTRIES_NUM-1; entry++) {
 		/* Get packet ctrl-block by desc-ID. */
@@ -1257,11 +1279,11 @@ TI_STATUS txCtrl_CheckForTxStuck (TI_HANDLE hTxCtrl)
 
 		/* If entry is in use */
 		if (pPktCtrlBlk->pNextFreeEntry == 0) {
-			/* If the packet wasn't sent to the FW yet (time is in host format) */
-			if ((pPktCtrlBlk->tTxPktParams.uFlags & TX_CTRL_FLAG_SENT_TO_FW) == 0) {
-				/* If packet age is more than twice the maximum lifetime, return NOK */
-				uPktAge = os_timeStampMs (pTxCtrl->hOs) - pPktCtrlBlk->tTxDescriptor.startTime;
-				if (uPktAge > ((MGMT_PKT_LIFETIME_TU << SHIFT_BETWEEN_TU_AND_USEC) * 2)) {
+			/* If the packet was sent to the FW and is waiting for its Tx-Complete */
+			if (pPktCtrlBlk->tTxPktParams.uFlags & TX_CTRL_FLAG_SENT_TO_FW) {
+				/* If packet age in the FW is more than twice the maximum lifetime, return NOK */
+				uPktAge = os_timeStampMs (pTxCtrl->hOs) - pTxCtrl->aXferTime[entry];
+				if (uPktAge > (TUs_TO_MSECs(uMaxLifeTimeTu) * 2)) {
 					return TI_NOK; /* call for recovery */
 				}
 			}
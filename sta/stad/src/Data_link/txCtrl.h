@@ -138,6 +138,8 @@ typedef struct {
                                                             pkt, and covert to msec on user request. */
 	TI_UINT32           currentConsecutiveRetryFail; /* current consecutive number of tx failures due to max retry */
 	ERate               eCurrentTxRate;                 /* Save last data Tx rate for applications' query */
+	TI_UINT32           aLastTxTime[MAX_NUM_OF_AC];     /* Host time (ms) of the last acknowledged data packet per AC */
+	TI_UINT32           aXferTime[CTRL_BLK_ENTRIES_NUM]; /* Host time (ms) each packet was transfered to the FW, per desc-ID */
 
 	/* credit calculation parameters */
 	TI_BOOL				bCreditCalcTimerEnabled;        /* credit timer is enabled from registry */
@@ -553,6 +553,34 @@ ERate txCtrlParams_GetTxRate (TI_HANDLE hTxCtrl)
 }
 
 
+/***********************************************************************
+ *                        txCtrlParams_GetLastTxTime
+ ***********************************************************************
+DESCRIPTION:    Provide the host time (ms) of the last acknowledged data
+                packet on the given AC (0 if none was sent yet).
+************************************************************************/
+TI_UINT32 txCtrlParams_GetLastTxTime (TI_HANDLE hTxCtrl, TI_UINT32 uAc)
+{
+	txCtrl_t *pTxCtrl = (txCtrl_t *)hTxCtrl;
+
+	return pTxCtrl->aLastTxTime[uAc];
+}
+
+
+/***********************************************************************
+ *                        txCtrlParams_GetTxCounters
+ ***********************************************************************
+DESCRIPTION:    Provide the Tx data counters of the given AC (for
+                statistics collection without copying all ACs).
+************************************************************************/
+const TTxDataCounters *txCtrlParams_GetTxCounters (TI_HANDLE hTxCtrl, TI_UINT32 uAc)
+{
+	txCtrl_t *pTxCtrl = (txCtrl_t *)hTxCtrl;
+
+	return &(pTxCtrl->txDataCounters[uAc]);
+}
+
+
 /***********************************************************************
  *                        txCtrlParams_setAcAdmissionStatus
  ***********************************************************************
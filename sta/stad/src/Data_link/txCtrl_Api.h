@@ -118,6 +118,8 @@ void txCtrlParams_getCurrentEncryptionInfo (TI_HANDLE hTxCtrl,
         TI_BOOL    *pCurrentPrivacyInvokedMode,
         TI_UINT8   *pEncryptionFieldSize);
 ERate txCtrlParams_GetTxRate (TI_HANDLE hTxCtrl);
+TI_UINT32 txCtrlParams_GetLastTxTime (TI_HANDLE hTxCtrl, TI_UINT32 uAc);
+const TTxDataCounters *txCtrlParams_GetTxCounters (TI_HANDLE hTxCtrl, TI_UINT32 uAc);
 void txCtrlParams_setAcAdmissionStatus (TI_HANDLE hTxCtrl,
                                         TI_UINT8 ac,
                                         EAdmissionState admissionRequired,
@@ -686,6 +686,8 @@ static void txDataQ_RunScheduler (TI_HANDLE hTxDataQ)
 
 		/* Send the packet */
 		eStatus = txCtrl_XmitData (pTxDataQ->hTxCtrl, pPktCtrlBlk);
+		TRACE3(pTxDataQ->hReport, REPORT_SEVERITY_INFORMATION, "txDataQ_RunScheduler: queue %d, tid %d, status %d\n",
+		       uQueId, pPktCtrlBlk->tTxDescriptor.tid, eStatus);
 
 		/*
 		 * If the return status is busy it means that the packet was not sent
@@ -110,12 +110,22 @@ typedef enum {
 #define ARE_ALL_MGMT_QUEUES_EMPTY(aQueues)	( (que_Size(aQueues[QUEUE_TYPE_MGMT] ) == 0)  &&  \
 											  (que_Size(aQueues[QUEUE_TYPE_EAPOL]) == 0) )
 
+/* Queueing delay statistics types: the 16 mgmt subtypes and all EAPOL-queue packets */
+#define NUM_OF_MGMT_SUBTYPES	16
+#define DELAY_TYPE_EAPOL_QUEUE	NUM_OF_MGMT_SUBTYPES
+#define NUM_OF_DELAY_TYPES		(NUM_OF_MGMT_SUBTYPES + 1)
+
 typedef struct {
 	TI_UINT32 aEnqueuePackets[NUM_OF_MGMT_QUEUES];
 	TI_UINT32 aDequeuePackets[NUM_OF_MGMT_QUEUES];
 	TI_UINT32 aRequeuePackets[NUM_OF_MGMT_QUEUES];
 	TI_UINT32 aDroppedPackets[NUM_OF_MGMT_QUEUES];
 	TI_UINT32 aXmittedPackets[NUM_OF_MGMT_QUEUES];
+	TI_UINT32 aDelayPackets[NUM_OF_DELAY_TYPES];	/* Xmitted packets per delay type */
+	TI_UINT32 aDelaySumMs[NUM_OF_DELAY_TYPES];		/* Accumulated queueing delay (msec) per delay type */
+	TI_UINT32 aDelayMaxMs[NUM_OF_DELAY_TYPES];		/* Maximum queueing delay (msec) per delay type */
+	TI_UINT32 uSchedulerBursts;						/* Scheduler passes that sent at least one packet */
+	TI_UINT32 uMaxBurstPackets;						/* Maximum packets sent in one scheduler pass */
 } TDbgCount;
 
 /* The module object. */
@@ -132,6 +142,7 @@ typedef struct {
 	ESmState		eSmState;	    /* The current state of the SM. */
 	ETxConnState	eTxConnState;   /* See typedef in module API. */
 	TI_UINT32       uContextId;     /* ID allocated to this module on registration to context module */
+	TI_BOOL			bSchedPending;  /* QUEUES_NOT_EMPTY event deferred to the context engine */
 
 	/* Mgmt aQueues */
 	TI_HANDLE   	aQueues[NUM_OF_MGMT_QUEUES];		   /* The mgmt-aQueues handles. */
@@ -148,6 +159,7 @@ static void mgmtQueuesSM (TTxMgmtQ *pTxMgmtQ, ESmEvent smEvent);
 static void runSchedulerNotFromSm (TTxMgmtQ *pTxMgmtQ);
 static void runScheduler (TTxMgmtQ *pTxMgmtQ);
 static void updateQueuesBusyMap (TTxMgmtQ *pTxMgmtQ, TI_UINT32 tidBitMap);
+static void updateDelayStatistics (TTxMgmtQ *pTxMgmtQ, TTxCtrlBlk *pPktCtrlBlk, TI_UINT32 uQueId, TI_UINT32 uDelayMs);
 
 /*******************************************************************************
 *                       PUBLIC  FUNCTIONS  IMPLEMENTATION					   *
@@ -342,7 +354,9 @@ void txMgmtQ_ClearQueues (TI_HANDLE hTxMgmtQ)
  * EAPOL packets may be inserted from the network stack context, so it requires switching
  *   to the driver's context (after the packet is enqueued).
  * If the selected queue was empty before the packet insertion, the SM is called
- *   with QUEUES_NOT_EMPTY event (in case of external context, only after the context switch).
+ *   with QUEUES_NOT_EMPTY event through the context engine, also when already in the
+ *   driver's context, so all packets queued in the current driver-task pass are
+ *   scheduled together and sent to the TxXfer as one aggregation.
  *
  * \note
  * \param  hTxMgmtQ         - The module's object
@@ -380,17 +394,16 @@ TI_STATUS txMgmtQ_Xmit (TI_HANDLE hTxMgmtQ, TTxCtrlBlk *pPktCtrlBlk, TI_BOOL bEx
 	if (eStatus == TI_OK) {
 		pTxMgmtQ->tDbgCounters.aEnqueuePackets[uQueId]++;
 
-		/* If selected queue was empty before packet insertion */
+		/*
+		 * If selected queue was empty before packet insertion, request the context engine to call
+		 *   the SM with QUEUES_NOT_EMPTY event (if called from external context, this is also the
+		 *   switch to the driver's context). Packets queued until then are sent in one scheduler pass.
+		 */
 		if (uQueSize == 1) {
-			/* If called from external context (EAPOL from network), request switch to the driver's context. */
-			if (bExternalContext) {
-				context_RequestSchedule (pTxMgmtQ->hContext, pTxMgmtQ->uContextId);
-			}
-
-			/* If already in the driver's context, call the SM with QUEUES_NOT_EMPTY event. */
-			else {
-				mgmtQueuesSM(pTxMgmtQ, SM_EVENT_QUEUES_NOT_EMPTY);
+			if (!bExternalContext) {
+				pTxMgmtQ->bSchedPending = TI_TRUE;
 			}
+			context_RequestSchedule (pTxMgmtQ->hContext, pTxMgmtQ->uContextId);
 		}
 	}
 
@@ -421,6 +434,8 @@ void txMgmtQ_QueuesNotEmpty (TI_HANDLE hTxMgmtQ)
 {
 	TTxMgmtQ  *pTxMgmtQ = (TTxMgmtQ *)hTxMgmtQ;
 
+	pTxMgmtQ->bSchedPending = TI_FALSE;
+
 	/* Call the SM with QUEUES_NOT_EMPTY event. */
 	mgmtQueuesSM(pTxMgmtQ, SM_EVENT_QUEUES_NOT_EMPTY);
 }
@@ -537,6 +552,15 @@ void txMgmtQ_SetConnState (TI_HANDLE hTxMgmtQ, ETxConnState eTxConnState)
 {
 	TTxMgmtQ *pTxMgmtQ = (TTxMgmtQ *)hTxMgmtQ;
 
+	/*
+	 * If packets were queued in the driver's context and their QUEUES_NOT_EMPTY event is still
+	 *   deferred, handle it first so they are scheduled according to the current state.
+	 */
+	if (pTxMgmtQ->bSchedPending) {
+		pTxMgmtQ->bSchedPending = TI_FALSE;
+		mgmtQueuesSM(pTxMgmtQ, SM_EVENT_QUEUES_NOT_EMPTY);
+	}
+
 	pTxMgmtQ->eTxConnState = eTxConnState;
 
 	/* Call the SM with the current event. */
@@ -756,6 +780,8 @@ static void runScheduler (TTxMgmtQ *pTxMgmtQ)
 	TI_STATUS  eStatus;
 	TTxCtrlBlk *pPktCtrlBlk;
 	TI_UINT32  uQueId = 0; /* start from highest priority queue */
+	TI_UINT32  uBurstPackets = 0;
+	TI_UINT32  uDelayMs;
 
 	while (1) {
 		/* If the Mgmt port is closed exit. */
@@ -773,6 +799,9 @@ static void runScheduler (TTxMgmtQ *pTxMgmtQ)
 			if (pPktCtrlBlk) {
 				pTxMgmtQ->tDbgCounters.aDequeuePackets[uQueId]++;
 
+				/* Get the queueing delay before the start time is converted for the FW */
+				uDelayMs = os_timeStampMs (pTxMgmtQ->hOs) - pPktCtrlBlk->tTxDescriptor.startTime;
+
 				/* Send the packet */
 				eStatus = txCtrl_XmitMgmt (pTxMgmtQ->hTxCtrl, pPktCtrlBlk);
 
@@ -790,6 +819,8 @@ static void runScheduler (TTxMgmtQ *pTxMgmtQ)
 				/* The packet was handled by the lower Tx layers. */
 				else {
 					pTxMgmtQ->tDbgCounters.aXmittedPackets[uQueId]++;
+					updateDelayStatistics (pTxMgmtQ, pPktCtrlBlk, uQueId, uDelayMs);
+					uBurstPackets++;
 
 					/* Successful delivery so start next tx from the high priority queue (mgmt),
 					 *	 giving it strict priority over the lower queue.
@@ -810,6 +841,13 @@ static void runScheduler (TTxMgmtQ *pTxMgmtQ)
 		} else {
 			/* We couldn't send from both queues so indicate end of packets burst and exit. */
 			TWD_txXfer_EndOfBurst (pTxMgmtQ->hTWD);
+
+			if (uBurstPackets) {
+				pTxMgmtQ->tDbgCounters.uSchedulerBursts++;
+				if (uBurstPackets > pTxMgmtQ->tDbgCounters.uMaxBurstPackets) {
+					pTxMgmtQ->tDbgCounters.uMaxBurstPackets = uBurstPackets;
+				}
+			}
 			return;
 		}
 
@@ -847,6 +885,42 @@ static void updateQueuesBusyMap (TTxMgmtQ *pTxMgmtQ, TI_UINT32 uTidBitMap)
 
 
 
+/**
+ * \fn     updateDelayStatistics
+ * \brief  Update queueing delay statistics (static function)
+ *
+ * Update the queueing delay statistics of a transmitted packet, per mgmt subtype
+ *    for Mgmt-queue packets, and in one entry for all EAPOL-queue packets.
+ *
+ * \note
+ * \param  pTxMgmtQ    - The module's object
+ * \param  pPktCtrlBlk - The transmitted packet
+ * \param  uQueId      - The queue the packet was sent from
+ * \param  uDelayMs    - The packet queueing delay in msec
+ * \return void
+ * \sa
+ */
+static void updateDelayStatistics (TTxMgmtQ *pTxMgmtQ, TTxCtrlBlk *pPktCtrlBlk, TI_UINT32 uQueId, TI_UINT32 uDelayMs)
+{
+	TI_UINT16 uFc;
+	TI_UINT32 uType;
+
+	if (uQueId == QUEUE_TYPE_MGMT) {
+		COPY_WLAN_WORD (&uFc, &((dot11_mgmtHeader_t *)(pPktCtrlBlk->aPktHdr))->fc);
+		uType = (uFc & DOT11_FC_SUB_MASK) >> 4;
+	} else {
+		uType = DELAY_TYPE_EAPOL_QUEUE;
+	}
+
+	pTxMgmtQ->tDbgCounters.aDelayPackets[uType]++;
+	pTxMgmtQ->tDbgCounters.aDelaySumMs[uType] += uDelayMs;
+	if (uDelayMs > pTxMgmtQ->tDbgCounters.aDelayMaxMs[uType]) {
+		pTxMgmtQ->tDbgCounters.aDelayMaxMs[uType] = uDelayMs;
+	}
+}
+
+
+
 /*******************************************************************************
 *                       DEBUG  FUNCTIONS  IMPLEMENTATION					   *
 ********************************************************************************/
@@ -913,6 +987,7 @@ void txMgmtQ_PrintQueueStatistics (TI_HANDLE hTxMgmtQ)
 #ifdef REPORT_LOG
 	TTxMgmtQ *pTxMgmtQ = (TTxMgmtQ *)hTxMgmtQ;
 	TI_UINT32 uQueId;
+	TI_UINT32 uType;
 
 	WLAN_OS_REPORT(("-------------- Mgmt Queues Statistics  -------------------\n"));
 	WLAN_OS_REPORT(("==========================================================\n"));
@@ -937,6 +1012,24 @@ void txMgmtQ_PrintQueueStatistics (TI_HANDLE hTxMgmtQ)
 	for (uQueId = 0; uQueId < NUM_OF_MGMT_QUEUES; uQueId++)
 		WLAN_OS_REPORT(("Que[%d]:  %d\n", uQueId, pTxMgmtQ->tDbgCounters.aDroppedPackets[uQueId]));
 
+	WLAN_OS_REPORT(("-------------- Queueing Delay (msec) ---------------------\n"));
+	for (uType = 0; uType < NUM_OF_DELAY_TYPES; uType++) {
+		if (pTxMgmtQ->tDbgCounters.aDelayPackets[uType] == 0)
+			continue;
+		if (uType == DELAY_TYPE_EAPOL_QUEUE)
+			WLAN_OS_REPORT(("EAPOL-Que:  "));
+		else
+			WLAN_OS_REPORT(("Subtype %2d: ", uType));
+		WLAN_OS_REPORT(("Packets=%d, Avg=%d, Max=%d\n",
+		                pTxMgmtQ->tDbgCounters.aDelayPackets[uType],
+		                pTxMgmtQ->tDbgCounters.aDelaySumMs[uType] / pTxMgmtQ->tDbgCounters.aDelayPackets[uType],
+		                pTxMgmtQ->tDbgCounters.aDelayMaxMs[uType]));
+	}
+
+	WLAN_OS_REPORT(("-------------- Scheduler Bursts --------------------------\n"));
+	WLAN_OS_REPORT(("Bursts = %d, Max packets per burst = %d\n",
+	                pTxMgmtQ->tDbgCounters.uSchedulerBursts, pTxMgmtQ->tDbgCounters.uMaxBurstPackets));
+
 	WLAN_OS_REPORT(("==========================================================\n\n"));
 #endif
 }
@@ -95,6 +95,9 @@ static TI_STATUS    powerMgrNullPacketRateConfiguration(TI_HANDLE hPowerMgr);
 static PowerMgr_PowerMode_e powerMgrGetHighestPriority(TI_HANDLE hPowerMgr);
 static TI_STATUS	powerMgrStartSuspendPS(TI_HANDLE hPowerMgr);
 static TI_STATUS    powerMgrNOP(TI_HANDLE hPowerMgr);
+#ifndef AVOID_KEEPALIVE_RECONFIGURATION
+static void         powerMgrUpdateKeepAlive(TI_HANDLE hPowerMgr, TKeepAliveConfig *pNewConfig, TKeepAliveConfig *pOldConfig);
+#endif
 /*****************************************************************************
  **         Public Function prototypes                                      **
  *****************************************************************************/
@@ -362,7 +365,7 @@ TI_STATUS PowerMgr_SetDefaults (TI_HANDLE hPowerMgr, PowerMgrInitParams_t* pPowe
 
 
 	/* set defaults for the power manager keep-alive sub module */
-	powerMgrKL_setDefaults (pPowerMgr->hPowerMgrKeepAlive);
+	powerMgrKL_setDefaults (pPowerMgr->hPowerMgrKeepAlive, pPowerMgrInitParams);
 
 	return TI_OK;
 }
@@ -641,6 +644,28 @@ PowerMgr_PowerMode_e PowerMgr_getPowerMode(TI_HANDLE hPowerMgr)
 }
 
 
+/****************************************************************************************
+ *                        PowerMgr_GetPsTransactionCount                                                *
+ ****************************************************************************************
+DESCRIPTION: Get the number of PS requests that completed with the given result.
+
+INPUT:          - hPowerMgr             - Handle to the Power Manager
+            - eResult               - PS request result (enter / exit, success / fail).
+OUTPUT:
+RETURN:    TI_UINT32 - number of PS requests (since the driver was loaded).\n
+****************************************************************************************/
+TI_UINT32 PowerMgr_GetPsTransactionCount(TI_HANDLE hPowerMgr, EventsPowerSave_e eResult)
+{
+	PowerMgr_t *pPowerMgr = (PowerMgr_t*)hPowerMgr;
+
+	if (eResult >= POWER_SAVE_STATUS_NUMBER) {
+		return 0;
+	}
+
+	return pPowerMgr->aPsTransactionCount[eResult];
+}
+
+
 TI_STATUS powerMgr_setParam(TI_HANDLE thePowerMgrHandle,
                             paramInfo_t *theParamP)
 {
@@ -755,9 +780,6 @@ TI_STATUS powerMgr_suspend(TI_HANDLE thePowerMgrHandle)
 	TI_BOOL bEnterPS = TI_FALSE;
         TI_STATUS status = TI_OK;
 	paramInfo_t param;
-#ifndef AVOID_KEEPALIVE_RECONFIGURATION
-	int i;
-#endif
 
 	powerSuspensionValues_t *pSavedSettings = &pPowerMgr->lastSavedSuspensionValues;
 	powerSuspensionValues_t *pSuspensionSettings = &pPowerMgr->suspensionValues;
@@ -809,18 +831,8 @@ TI_STATUS powerMgr_suspend(TI_HANDLE thePowerMgrHandle)
 	siteMgr_setParam(pPowerMgr->hSiteMgr, &param);
 
 #ifndef AVOID_KEEPALIVE_RECONFIGURATION
-	/* set keep alive templates */
-	if (pSuspensionSettings->keepAliveConfig.enaDisFlag != pSavedSettings->keepAliveConfig.enaDisFlag) {
-		param.paramType = POWER_MGR_KEEP_ALIVE_ENA_DIS;
-		param.content.powerMgrKeepAliveEnaDis = pSuspensionSettings->keepAliveConfig.enaDisFlag;
-		powerMgr_setParam(thePowerMgrHandle, &param);
-	}
-
-	for (i=0; i<KEEP_ALIVE_MAX_USER_MESSAGES; i++) {
-		param.paramType = POWER_MGR_KEEP_ALIVE_ADD_REM;
-		param.content.pPowerMgrKeepAliveTemplate = &pSuspensionSettings->keepAliveConfig.templates[i];
-		powerMgr_setParam(thePowerMgrHandle, &param);
-	}
+	/* set keep alive templates (only the ones that differ from the current configuration) */
+	powerMgrUpdateKeepAlive(thePowerMgrHandle, &pSuspensionSettings->keepAliveConfig, &pSavedSettings->keepAliveConfig);
 #endif
 
 	/* set PM mode */
@@ -853,9 +865,6 @@ TI_STATUS powerMgr_resume(TI_HANDLE thePowerMgrHandle)
 	paramInfo_t param;
 	PowerMgr_PowerMode_e newPowerMode;
 	powerSuspensionValues_t *pSavedSettings = &pPowerMgr->lastSavedSuspensionValues;
-#ifndef AVOID_KEEPALIVE_RECONFIGURATION
-	int i;
-#endif
 
 	TWD_CfgEnableMulticastMACFixup(pPowerMgr->hTWD, FIXUP_MULTICAST_DISABLED);
 
@@ -865,18 +874,8 @@ TI_STATUS powerMgr_resume(TI_HANDLE thePowerMgrHandle)
 	siteMgr_setParam(pPowerMgr->hSiteMgr, &param);
 
 #ifndef AVOID_KEEPALIVE_RECONFIGURATION
-	/* set keep-alive templates */
-	if (pPowerMgr->suspensionValues.keepAliveConfig.enaDisFlag != pSavedSettings->keepAliveConfig.enaDisFlag) {
-		param.paramType = POWER_MGR_KEEP_ALIVE_ENA_DIS;
-		param.content.powerMgrKeepAliveEnaDis = pSavedSettings->keepAliveConfig.enaDisFlag;
-		powerMgr_setParam(thePowerMgrHandle, &param);
-	}
-
-	for (i=0; i<KEEP_ALIVE_MAX_USER_MESSAGES; i++) {
-		param.paramType = POWER_MGR_KEEP_ALIVE_ADD_REM;
-		param.content.pPowerMgrKeepAliveTemplate = &pSavedSettings->keepAliveConfig.templates[i];
-		powerMgr_setParam(thePowerMgrHandle, &param);
-	}
+	/* set keep-alive templates (only the ones that were changed by the suspension) */
+	powerMgrUpdateKeepAlive(thePowerMgrHandle, &pSavedSettings->keepAliveConfig, &pPowerMgr->suspensionValues.keepAliveConfig);
 #endif
 
 	/* set DTIM listen interval */
@@ -924,6 +923,10 @@ static void powerSaveCompleteCB(TI_HANDLE hPowerMgr,TI_UINT8 PSMode,TI_UINT8 tra
 {
 	PowerMgr_t *pPowerMgr = (PowerMgr_t*)hPowerMgr;
 
+	if (transStatus < POWER_SAVE_STATUS_NUMBER) {
+		pPowerMgr->aPsTransactionCount[transStatus]++;
+	}
+
 	/* Handling the event*/
 	switch ( (EventsPowerSave_e)transStatus ) {
 	case ENTER_POWER_SAVE_FAIL:
@@ -1461,6 +1464,61 @@ TI_BOOL PowerMgr_getReAuthActivePriority(TI_HANDLE thePowerMgrHandle)
 	return pPowerMgr->reAuthActivePriority;
 }
 
+/****************************************************************************************
+ *                        PowerMgr_StartNullDataKeepAlive                               *
+ ****************************************************************************************
+DESCRIPTION: Called by the current BSS module when it configures the null-data keep-alive.
+             Returns the keep-alive interval to use, adapted to the AP.
+
+INPUT:      - hPowerMgr - Handle to the Power Manager
+            - uIndex - FW keep-alive index of the null-data message
+            - pBssid - the AP BSSID
+            - uDefaultIntervalMs - the static keep-alive interval
+OUTPUT:
+RETURN:     The keep-alive interval (ms)
+****************************************************************************************/
+TI_UINT32 PowerMgr_StartNullDataKeepAlive (TI_HANDLE hPowerMgr, TI_UINT8 uIndex,
+        TMacAddr *pBssid, TI_UINT32 uDefaultIntervalMs)
+{
+	PowerMgr_t *pPowerMgr = (PowerMgr_t*)hPowerMgr;
+
+	return powerMgrKL_startNullData (pPowerMgr->hPowerMgrKeepAlive, uIndex, pBssid, uDefaultIntervalMs);
+}
+
+/****************************************************************************************
+ *                        PowerMgr_StopNullDataKeepAlive                                *
+ ****************************************************************************************
+DESCRIPTION: Called by the current BSS module when it disables the null-data keep-alive.
+
+INPUT:      - hPowerMgr - Handle to the Power Manager
+OUTPUT:
+RETURN:     void
+****************************************************************************************/
+void PowerMgr_StopNullDataKeepAlive (TI_HANDLE hPowerMgr)
+{
+	PowerMgr_t *pPowerMgr = (PowerMgr_t*)hPowerMgr;
+
+	powerMgrKL_stopNullData (pPowerMgr->hPowerMgrKeepAlive);
+}
+
+/****************************************************************************************
+ *                        PowerMgr_ReportApDisconnect                                   *
+ ****************************************************************************************
+DESCRIPTION: Called by the AP connection module when a disassociation or deauthentication
+             frame is received from the AP, so the keep-alive can learn the AP inactivity timeout.
+
+INPUT:      - hPowerMgr - Handle to the Power Manager
+            - uReasonCode - the 802.11 reason code
+OUTPUT:
+RETURN:     void
+****************************************************************************************/
+void PowerMgr_ReportApDisconnect (TI_HANDLE hPowerMgr, TI_UINT16 uReasonCode)
+{
+	PowerMgr_t *pPowerMgr = (PowerMgr_t*)hPowerMgr;
+
+	powerMgrKL_reportApDisconnect (pPowerMgr->hPowerMgrKeepAlive, uReasonCode);
+}
+
 
 static void PowerMgr_SuspendCompletedCB(TI_HANDLE hPowerMgr,TI_UINT8 PSMode,TI_UINT8 transStatus)
 {
@@ -1527,3 +1585,39 @@ static TI_STATUS powerMgrNOP(TI_HANDLE hPowerMgr)
 
 	return TI_OK;
 }
+
+#ifndef AVOID_KEEPALIVE_RECONFIGURATION
+/****************************************************************************************
+ *                        powerMgrUpdateKeepAlive                                       *
+ ****************************************************************************************
+DESCRIPTION: Apply a keep-alive configuration, sending only the enable flag and the
+             templates that differ from the configuration currently in the FW.
+
+INPUT:          - hPowerMgr             - Handle to the Power Manager
+                - pNewConfig            - The keep-alive configuration to apply
+                - pOldConfig            - The keep-alive configuration currently applied
+OUTPUT:
+RETURN:    void.\n
+****************************************************************************************/
+static void powerMgrUpdateKeepAlive(TI_HANDLE hPowerMgr, TKeepAliveConfig *pNewConfig, TKeepAliveConfig *pOldConfig)
+{
+	PowerMgr_t *pPowerMgr = (PowerMgr_t*)hPowerMgr;
+	paramInfo_t param;
+	int i;
+
+	if (pNewConfig->enaDisFlag != pOldConfig->enaDisFlag) {
+		param.paramType = POWER_MGR_KEEP_ALIVE_ENA_DIS;
+		param.content.powerMgrKeepAliveEnaDis = pNewConfig->enaDisFlag;
+		powerMgr_setParam(hPowerMgr, &param);
+	}
+
+	for (i=0; i<KEEP_ALIVE_MAX_USER_MESSAGES; i++) {
+		if (os_memoryCompare(pPowerMgr->hOS, (TI_UINT8*)&pNewConfig->templates[i],
+		                     (TI_UINT8*)&pOldConfig->templates[i], sizeof(TKeepAliveTemplate)) != 0) {
+			param.paramType = POWER_MGR_KEEP_ALIVE_ADD_REM;
+			param.content.pPowerMgrKeepAliveTemplate = &pNewConfig->templates[i];
+			powerMgr_setParam(hPowerMgr, &param);
+		}
+	}
+}
+#endif
@@ -42,20 +42,69 @@
 #include "TWDriver.h"
 #include "STADExternalIf.h"
 #include "txCtrl_Api.h"
+#include "timer.h"
+#include "paramOut.h"
+#include "PowerMgrKeepAlive.h"
+
+#define KEEP_ALIVE_AP_HISTORY_SIZE      8       /* number of APs whose inactivity behaviour is remembered */
+#define KEEP_ALIVE_MIN_INTERVAL_MS      1000    /* minimum keep-alive interval accepted by the FW */
+#define KEEP_ALIVE_TIMEOUT_MARGIN       2       /* the interval is kept below the learned AP timeout divided by this */
+#define KEEP_ALIVE_PROBE_PERIODS        8       /* idle keep-alive periods survived before the interval is lengthened */
+#define KEEP_ALIVE_CHECKS_PER_PERIOD    2       /* accounting checks per keep-alive period */
+
+/* 802.11 reason codes sent by an AP that aged out our association */
+#define KEEP_ALIVE_REASON_INACTIVITY    4
+#define KEEP_ALIVE_REASON_CLASS2_FRAME  6
+#define KEEP_ALIVE_REASON_CLASS3_FRAME  7
+
+/* Inactivity history of a single AP */
+typedef struct {
+	TMacAddr            tBssid;
+	TI_UINT32           uTimeoutMs;         /* learned inactivity timeout (upper bound), 0 if unknown */
+	TI_UINT32           uSafeIntervalMs;    /* longest keep-alive interval the AP was seen to tolerate */
+	TI_UINT32           uInactivityDeauths; /* number of inactivity disconnections from this AP */
+	TI_UINT32           uLastUsed;          /* host time (ms) of the last connection, for replacement */
+} TKeepAliveApHistory;
+
+/* Null-data keep-alive statistics */
+typedef struct {
+	TI_UINT32           uKeepAlivesSent;    /* keep-alives sent by the FW (estimated from the Tx history) */
+	TI_UINT32           uKeepAlivesDeferred;/* keep-alive periods in which data traffic refreshed the AP instead */
+	TI_UINT32           uConnectedMs;       /* total time the null-data keep-alive was active */
+	TI_UINT32           uInactivityDeauths; /* disconnections due to AP inactivity timeout */
+	TI_UINT32           uIntervalUpdates;   /* interval changes configured while connected */
+} TKeepAliveStats;
 
 typedef struct {
 	TI_HANDLE           hTWD;
 	TI_HANDLE           hReport;
 	TI_HANDLE           hOs;
 	TI_HANDLE           hTxCtrl;
+	TI_HANDLE           hTimer;
+	TI_HANDLE           hAdaptTimer;
 	TKeepAliveConfig    tCurrentConfig;
 	TI_BOOL             bConnected;
 	TI_UINT8            wlanHeader[ WLAN_WITH_SNAP_QOS_HEADER_MAX_SIZE + AES_AFTER_HEADER_FIELD_SIZE ];
 	TI_UINT32           wlanHeaderLength;
 	TI_UINT8            tempBuffer[ KEEP_ALIVE_TEMPLATE_MAX_LENGTH + WLAN_WITH_SNAP_QOS_HEADER_MAX_SIZE + AES_AFTER_HEADER_FIELD_SIZE ];
+
+	/* adaptive null-data keep-alive */
+	TI_BOOL             bAdaptive;          /* adapt the null-data keep-alive interval (from registry) */
+	TI_UINT32           uMaxIntervalMs;     /* longest null-data keep-alive interval allowed (from registry) */
+	TI_BOOL             bNullDataActive;    /* null-data keep-alive is configured in the FW */
+	TI_UINT8            uNullDataIndex;     /* FW keep-alive index of the null-data message */
+	TI_UINT32           uDefaultIntervalMs; /* static interval requested by the current BSS module */
+	TI_UINT32           uIntervalMs;        /* interval currently configured in the FW */
+	TI_UINT32           uCurrAp;            /* index of the current AP in the history table */
+	TI_UINT32           uLastCheckTime;     /* host time (ms) of the last accounting */
+	TI_UINT32           uLastFrameTime;     /* host time (ms) the AP last heard from us (estimated) */
+	TI_UINT32           uIdlePeriods;       /* idle keep-alive periods survived at the current interval */
+	TKeepAliveApHistory aApHistory[ KEEP_ALIVE_AP_HISTORY_SIZE ];
+	TKeepAliveStats     tStats;
 } TPowerMgrKL;
 
 TI_STATUS powerMgrKLConfigureMessage (TI_HANDLE hPowerMgrKL, TI_UINT32 uMessageIndex);
+static void powerMgrKLAdaptTimeout (TI_HANDLE hPowerMgrKL, TI_BOOL bTwdInitOccured);
 
 /**
  * \fn     powerMgrKL_create
@@ -77,6 +126,8 @@ TI_HANDLE powerMgrKL_create (TI_HANDLE hOS)
 		return NULL;
 	}
 
+	os_memoryZero (hOS, pPowerMgrKL, sizeof(TPowerMgrKL));
+
 	/* store OS handle */
 	pPowerMgrKL->hOs = hOS;
 
@@ -97,6 +148,10 @@ void powerMgrKL_destroy (TI_HANDLE hPowerMgrKL)
 {
 	TPowerMgrKL     *pPowerMgrKL = (TPowerMgrKL*)hPowerMgrKL;
 
+	if (NULL != pPowerMgrKL->hAdaptTimer) {
+		tmr_DestroyTimer (pPowerMgrKL->hAdaptTimer);
+	}
+
 	os_memoryFree (pPowerMgrKL->hOs, hPowerMgrKL, sizeof(TPowerMgrKL));
 }
 
@@ -122,6 +177,7 @@ void powerMgrKL_init (TI_HANDLE hPowerMgrKL,
 	pPowerMgrKL->hTWD       = pStadHandles->hTWD;
 	pPowerMgrKL->hReport    = pStadHandles->hReport;
 	pPowerMgrKL->hTxCtrl    = pStadHandles->hTxCtrl;
+	pPowerMgrKL->hTimer     = pStadHandles->hTimer;
 }
 
 /**
@@ -131,10 +187,11 @@ void powerMgrKL_init (TI_HANDLE hPowerMgrKL,
  * Set powr-manager keep-aive default initialization values
  *
  * \param  hPowerMgrKL - handle to the power-manager keep-alive object
+ * \param  pInitParams - the power manager initialization parameters
  * \return None
  * \sa     powerMgrKL_init
  */
-void powerMgrKL_setDefaults (TI_HANDLE hPowerMgrKL)
+void powerMgrKL_setDefaults (TI_HANDLE hPowerMgrKL, PowerMgrInitParams_t *pInitParams)
 {
 	TPowerMgrKL     *pPowerMgrKL = (TPowerMgrKL*)hPowerMgrKL;
 	TI_UINT32       uIndex;
@@ -154,6 +211,17 @@ void powerMgrKL_setDefaults (TI_HANDLE hPowerMgrKL)
 
 	/* mark STA as disconnected */
 	pPowerMgrKL->bConnected = TI_FALSE;
+
+	/* adaptive null-data keep-alive configuration */
+	pPowerMgrKL->bAdaptive = pInitParams->bKeepAliveAdaptive;
+	pPowerMgrKL->uMaxIntervalMs = pInitParams->uKeepAliveMaxPeriod * 1000;
+	pPowerMgrKL->bNullDataActive = TI_FALSE;
+
+	pPowerMgrKL->hAdaptTimer = tmr_CreateTimer (pPowerMgrKL->hTimer);
+	if (NULL == pPowerMgrKL->hAdaptTimer) {
+		WLAN_OS_REPORT(("powerMgrKL_setDefaults: failed to create the keep-alive timer, adaptive keep-alive disabled\n"));
+		pPowerMgrKL->bAdaptive = TI_FALSE;
+	}
 }
 
 /**
@@ -372,3 +440,596 @@ TI_STATUS powerMgrKLConfigureMessage (TI_HANDLE hPowerMgrKL, TI_UINT32 uMessageI
 
 	return status;
 }
+
+/**
+ * \fn     powerMgrKLFindAp
+ * \brief  Finds the history entry of an AP
+ *
+ * Finds the history entry of the given BSSID. If the AP is not found, the least recently
+ * used entry is cleared and assigned to it.
+ *
+ * \param  pPowerMgrKL - pointer to the power-manager keep-alive object
+ * \param  pBssid - the AP BSSID
+ * \param  uNow - current host time (ms)
+ * \return The AP index in the history table
+ * \sa     powerMgrKLConnect
+ */
+static TI_UINT32 powerMgrKLFindAp (TPowerMgrKL *pPowerMgrKL, TMacAddr *pBssid, TI_UINT32 uNow)
+{
+	TKeepAliveApHistory *pAp;
+	TI_UINT32           uIndex, uOldest = 0;
+
+	for (uIndex = 0; uIndex < KEEP_ALIVE_AP_HISTORY_SIZE; uIndex++) {
+		pAp = &(pPowerMgrKL->aApHistory[ uIndex ]);
+		if (MAC_EQUAL (pAp->tBssid, *pBssid)) {
+			pAp->uLastUsed = uNow;
+			return uIndex;
+		}
+		if ((uNow - pAp->uLastUsed) > (uNow - pPowerMgrKL->aApHistory[ uOldest ].uLastUsed)) {
+			uOldest = uIndex;
+		}
+	}
+
+	/* not found - replace the least recently used AP */
+	pAp = &(pPowerMgrKL->aApHistory[ uOldest ]);
+	os_memoryZero (pPowerMgrKL->hOs, pAp, sizeof(TKeepAliveApHistory));
+	MAC_COPY (pAp->tBssid, *pBssid);
+	pAp->uLastUsed = uNow;
+
+	return uOldest;
+}
+
+/**
+ * \fn     powerMgrKLIntervalLimit
+ * \brief  Returns the longest null-data keep-alive interval allowed for the current AP
+ *
+ * The limit is the registry maximum, reduced below the AP inactivity timeout if it was learned.
+ * The default interval is kept if the AP timeout is longer than it. An interval advertised by
+ * the AP is never exceeded.
+ *
+ * \param  pPowerMgrKL - pointer to the power-manager keep-alive object
+ * \return The interval limit in ms
+ * \sa     powerMgrKLSelectInterval
+ */
+static TI_UINT32 powerMgrKLIntervalLimit (TPowerMgrKL *pPowerMgrKL)
+{
+	TKeepAliveApHistory *pAp = &(pPowerMgrKL->aApHistory[ pPowerMgrKL->uCurrAp ]);
+	TI_UINT32           uLimit, uLearned;
+
+	uLimit = pPowerMgrKL->uMaxIntervalMs;
+	if (uLimit < pPowerMgrKL->uDefaultIntervalMs) {
+		uLimit = pPowerMgrKL->uDefaultIntervalMs;
+	}
+	if (0 != pAp->uTimeoutMs) {
+		uLearned = pAp->uTimeoutMs / KEEP_ALIVE_TIMEOUT_MARGIN;
+		/* don't go below the default interval unless the AP timed out at it */
+		if ((pAp->uTimeoutMs > pPowerMgrKL->uDefaultIntervalMs) && (uLearned < pPowerMgrKL->uDefaultIntervalMs)) {
+			uLearned = pPowerMgrKL->uDefaultIntervalMs;
+		}
+		if (uLearned < uLimit) {
+			uLimit = uLearned;
+		}
+	}
+	if (uLimit < KEEP_ALIVE_MIN_INTERVAL_MS) {
+		uLimit = KEEP_ALIVE_MIN_INTERVAL_MS;
+	}
+
+	return uLimit;
+}
+
+/**
+ * \fn     powerMgrKLSelectInterval
+ * \brief  Selects the null-data keep-alive interval for a new connection
+ *
+ * Starts from the longest interval the AP is known to tolerate (at least the default interval),
+ * limited by the learned AP inactivity timeout.
+ *
+ * \param  pPowerMgrKL - pointer to the power-manager keep-alive object
+ * \return The interval in ms
+ * \sa     powerMgrKLConnect
+ */
+static TI_UINT32 powerMgrKLSelectInterval (TPowerMgrKL *pPowerMgrKL)
+{
+	TKeepAliveApHistory *pAp = &(pPowerMgrKL->aApHistory[ pPowerMgrKL->uCurrAp ]);
+	TI_UINT32           uInterval, uLimit;
+
+	if (TI_FALSE == pPowerMgrKL->bAdaptive) {
+		return pPowerMgrKL->uDefaultIntervalMs;
+	}
+
+	uLimit = powerMgrKLIntervalLimit (pPowerMgrKL);
+	uInterval = pPowerMgrKL->uDefaultIntervalMs;
+	if (pAp->uSafeIntervalMs > uInterval) {
+		uInterval = pAp->uSafeIntervalMs;
+	}
+
+	return (uInterval > uLimit) ? uLimit : uInterval;
+}
+
+/**
+ * \fn     powerMgrKLConnect
+ * \brief  Starts null-data keep-alive accounting for a new connection
+ *
+ * \param  pPowerMgrKL - pointer to the power-manager keep-alive object
+ * \param  pBssid - the AP BSSID
+ * \param  uDefaultIntervalMs - the static keep-alive interval
+ * \param  uNow - current host time (ms)
+ * \return None
+ * \sa     powerMgrKLDisconnect, powerMgrKL_startNullData
+ */
+static void powerMgrKLConnect (TPowerMgrKL *pPowerMgrKL, TMacAddr *pBssid,
+                               TI_UINT32 uDefaultIntervalMs, TI_UINT32 uNow)
+{
+	pPowerMgrKL->uDefaultIntervalMs = uDefaultIntervalMs;
+	pPowerMgrKL->uCurrAp = powerMgrKLFindAp (pPowerMgrKL, pBssid, uNow);
+	pPowerMgrKL->uIntervalMs = powerMgrKLSelectInterval (pPowerMgrKL);
+	pPowerMgrKL->uLastCheckTime = uNow;
+	pPowerMgrKL->uLastFrameTime = uNow; /* the connection itself refreshed the AP */
+	pPowerMgrKL->uIdlePeriods = 0;
+	pPowerMgrKL->bNullDataActive = TI_TRUE;
+}
+
+/**
+ * \fn     powerMgrKLAccount
+ * \brief  Accounts the keep-alive periods since the last check and adapts the interval
+ *
+ * The FW restarts the keep-alive period on each transmission (KEEP_ALIVE_TRIG_TYPE_NO_TX),
+ * so the keep-alives it sent are derived from the last data Tx time. A period in which data
+ * was sent is counted as deferred. After the AP tolerated KEEP_ALIVE_PROBE_PERIODS idle
+ * periods the interval is lengthened by the default interval, up to the limit (which never
+ * exceeds an interval advertised by the AP).
+ *
+ * \param  pPowerMgrKL - pointer to the power-manager keep-alive object
+ * \param  uNow - current host time (ms)
+ * \param  uLastTx - host time (ms) of the last acknowledged data packet
+ * \return TI_TRUE if the interval was changed, TI_FALSE otherwise
+ * \sa     powerMgrKLAdaptTimeout
+ */
+static TI_BOOL powerMgrKLAccount (TPowerMgrKL *pPowerMgrKL, TI_UINT32 uNow, TI_UINT32 uLastTx)
+{
+	TKeepAliveApHistory *pAp = &(pPowerMgrKL->aApHistory[ pPowerMgrKL->uCurrAp ]);
+	TI_BOOL             bTraffic = TI_FALSE;
+	TI_UINT32           uSent, uNewInterval;
+
+	/* data sent since the AP last heard from us restarts the FW keep-alive period */
+	if ((TI_INT32)(uLastTx - pPowerMgrKL->uLastFrameTime) > 0) {
+		pPowerMgrKL->uLastFrameTime = uLastTx;
+		bTraffic = TI_TRUE;
+	}
+
+	uSent = (uNow - pPowerMgrKL->uLastFrameTime) / pPowerMgrKL->uIntervalMs;
+	if (uSent > 0) {
+		pPowerMgrKL->uLastFrameTime += uSent * pPowerMgrKL->uIntervalMs;
+		pPowerMgrKL->tStats.uKeepAlivesSent += uSent;
+		pPowerMgrKL->uIdlePeriods += uSent;
+	} else if (bTraffic) {
+		pPowerMgrKL->tStats.uKeepAlivesDeferred++;
+	}
+
+	pPowerMgrKL->tStats.uConnectedMs += uNow - pPowerMgrKL->uLastCheckTime;
+	pPowerMgrKL->uLastCheckTime = uNow;
+
+	if ((TI_FALSE == pPowerMgrKL->bAdaptive) || (pPowerMgrKL->uIdlePeriods < KEEP_ALIVE_PROBE_PERIODS)) {
+		return TI_FALSE;
+	}
+
+	/* the AP tolerated the current interval - try a longer one */
+	pPowerMgrKL->uIdlePeriods = 0;
+	if (pAp->uSafeIntervalMs < pPowerMgrKL->uIntervalMs) {
+		pAp->uSafeIntervalMs = pPowerMgrKL->uIntervalMs;
+	}
+
+	uNewInterval = pPowerMgrKL->uIntervalMs + pPowerMgrKL->uDefaultIntervalMs;
+	if (uNewInterval > powerMgrKLIntervalLimit (pPowerMgrKL)) {
+		uNewInterval = powerMgrKLIntervalLimit (pPowerMgrKL);
+	}
+	if (uNewInterval == pPowerMgrKL->uIntervalMs) {
+		return TI_FALSE;
+	}
+
+	pPowerMgrKL->uIntervalMs = uNewInterval;
+	pPowerMgrKL->tStats.uIntervalUpdates++;
+	return TI_TRUE;
+}
+
+/**
+ * \fn     powerMgrKLLearn
+ * \brief  Learns the AP inactivity timeout from a disconnection
+ *
+ * On an inactivity disassociation the AP timeout is the silence it saw, which is at most the
+ * keep-alive interval. For class 2/3 frame errors the AP dropped us earlier, and only the
+ * interval bounds the timeout.
+ *
+ * \param  pPowerMgrKL - pointer to the power-manager keep-alive object
+ * \param  uNow - current host time (ms)
+ * \param  uLastTx - host time (ms) of the last acknowledged data packet
+ * \param  uReasonCode - the 802.11 disassociation / deauthentication reason code
+ * \return None
+ * \sa     powerMgrKL_reportApDisconnect
+ */
+static void powerMgrKLLearn (TPowerMgrKL *pPowerMgrKL, TI_UINT32 uNow, TI_UINT32 uLastTx, TI_UINT16 uReasonCode)
+{
+	TKeepAliveApHistory *pAp = &(pPowerMgrKL->aApHistory[ pPowerMgrKL->uCurrAp ]);
+	TI_UINT32           uTimeout;
+
+	if ((KEEP_ALIVE_REASON_INACTIVITY != uReasonCode) &&
+	        (KEEP_ALIVE_REASON_CLASS2_FRAME != uReasonCode) &&
+	        (KEEP_ALIVE_REASON_CLASS3_FRAME != uReasonCode)) {
+		return;
+	}
+
+	powerMgrKLAccount (pPowerMgrKL, uNow, uLastTx);
+
+	uTimeout = pPowerMgrKL->uIntervalMs;
+	if ((KEEP_ALIVE_REASON_INACTIVITY == uReasonCode) && ((uNow - pPowerMgrKL->uLastFrameTime) < uTimeout)) {
+		uTimeout = uNow - pPowerMgrKL->uLastFrameTime;
+	}
+	if (uTimeout < KEEP_ALIVE_MIN_INTERVAL_MS) {
+		uTimeout = KEEP_ALIVE_MIN_INTERVAL_MS;
+	}
+
+	if ((0 == pAp->uTimeoutMs) || (uTimeout < pAp->uTimeoutMs)) {
+		pAp->uTimeoutMs = uTimeout;
+	}
+	if (pAp->uSafeIntervalMs >= pAp->uTimeoutMs) {
+		pAp->uSafeIntervalMs = 0;
+	}
+	pAp->uInactivityDeauths++;
+	pPowerMgrKL->tStats.uInactivityDeauths++;
+}
+
+/**
+ * \fn     powerMgrKLGetLastTxTime
+ * \brief  Returns the host time of the last acknowledged data packet on any AC
+ *
+ * \param  pPowerMgrKL - pointer to the power-manager keep-alive object
+ * \param  uNow - current host time (ms)
+ * \return The last data Tx time (ms)
+ * \sa     powerMgrKLAdaptTimeout
+ */
+static TI_UINT32 powerMgrKLGetLastTxTime (TPowerMgrKL *pPowerMgrKL, TI_UINT32 uNow)
+{
+	TI_UINT32   uAc, uTxTime, uLastTx = pPowerMgrKL->uLastFrameTime;
+
+	for (uAc = 0; uAc < MAX_NUM_OF_AC; uAc++) {
+		uTxTime = txCtrlParams_GetLastTxTime (pPowerMgrKL->hTxCtrl, uAc);
+		if ((uNow - uTxTime) < (uNow - uLastTx)) {
+			uLastTx = uTxTime;
+		}
+	}
+
+	return uLastTx;
+}
+
+/**
+ * \fn     powerMgrKLAdaptTimeout
+ * \brief  Keep-alive accounting timer callback
+ *
+ * Accounts the last keep-alive period and reconfigures the null-data keep-alive
+ * if its interval was changed.
+ *
+ * \param  hPowerMgrKL - handle to the power-manager keep-alive object
+ * \param  bTwdInitOccured - Indicates if TWDriver recovery occured since timer started
+ * \return None
+ * \sa     powerMgrKL_startNullData
+ */
+static void powerMgrKLAdaptTimeout (TI_HANDLE hPowerMgrKL, TI_BOOL bTwdInitOccured)
+{
+	TPowerMgrKL         *pPowerMgrKL = (TPowerMgrKL*)hPowerMgrKL;
+	TKeepAliveParams    tKeepAliveParams;
+	TI_UINT32           uNow = os_timeStampMs (pPowerMgrKL->hOs);
+
+	if ((TI_FALSE == pPowerMgrKL->bNullDataActive) || (TI_FALSE == pPowerMgrKL->bAdaptive)) {
+		return;
+	}
+
+	if (TI_TRUE == powerMgrKLAccount (pPowerMgrKL, uNow, powerMgrKLGetLastTxTime (pPowerMgrKL, uNow))) {
+		tKeepAliveParams.index = pPowerMgrKL->uNullDataIndex;
+		tKeepAliveParams.enaDisFlag = TI_TRUE;
+		tKeepAliveParams.trigType = KEEP_ALIVE_TRIG_TYPE_NO_TX;
+		tKeepAliveParams.interval = pPowerMgrKL->uIntervalMs;
+		TWD_CfgKeepAlive (pPowerMgrKL->hTWD, &tKeepAliveParams);
+
+		tmr_StopTimer (pPowerMgrKL->hAdaptTimer);
+		tmr_StartTimer (pPowerMgrKL->hAdaptTimer, powerMgrKLAdaptTimeout, hPowerMgrKL,
+		                pPowerMgrKL->uIntervalMs / KEEP_ALIVE_CHECKS_PER_PERIOD, TI_TRUE);
+	}
+}
+
+/**
+ * \fn     powerMgrKL_startNullData
+ * \brief  Notifies the power-manager keep-alive that the null-data keep-alive is configured
+ *
+ * Selects the null-data keep-alive interval for the AP and starts the keep-alive accounting.
+ * The caller configures the null-data keep-alive with the returned interval and with the
+ * KEEP_ALIVE_TRIG_TYPE_NO_TX trigger.
+ *
+ * \param  hPowerMgrKL - handle to the power-manager keep-alive object
+ * \param  uIndex - FW keep-alive index of the null-data message
+ * \param  pBssid - the AP BSSID
+ * \param  uDefaultIntervalMs - the static keep-alive interval
+ * \return The interval to configure (ms)
+ * \sa     powerMgrKL_stopNullData
+ */
+TI_UINT32 powerMgrKL_startNullData (TI_HANDLE hPowerMgrKL, TI_UINT8 uIndex, TMacAddr *pBssid,
+                                    TI_UINT32 uDefaultIntervalMs)
+{
+	TPowerMgrKL     *pPowerMgrKL = (TPowerMgrKL*)hPowerMgrKL;
+
+	pPowerMgrKL->uNullDataIndex = uIndex;
+	powerMgrKLConnect (pPowerMgrKL, pBssid, uDefaultIntervalMs, os_timeStampMs (pPowerMgrKL->hOs));
+
+	/* the interval is only checked periodically when it is adapted (the static one is accounted on stop) */
+	if (TI_TRUE == pPowerMgrKL->bAdaptive) {
+		tmr_StartTimer (pPowerMgrKL->hAdaptTimer, powerMgrKLAdaptTimeout, hPowerMgrKL,
+		                pPowerMgrKL->uIntervalMs / KEEP_ALIVE_CHECKS_PER_PERIOD, TI_TRUE);
+	}
+
+	return pPowerMgrKL->uIntervalMs;
+}
+
+/**
+ * \fn     powerMgrKL_stopNullData
+ * \brief  Notifies the power-manager keep-alive that the null-data keep-alive is disabled
+ *
+ * \param  hPowerMgrKL - handle to the power-manager keep-alive object
+ * \return None
+ * \sa     powerMgrKL_startNullData
+ */
+void powerMgrKL_stopNullData (TI_HANDLE hPowerMgrKL)
+{
+	TPowerMgrKL     *pPowerMgrKL = (TPowerMgrKL*)hPowerMgrKL;
+	TI_UINT32       uNow;
+
+	if (TI_FALSE == pPowerMgrKL->bNullDataActive) {
+		return;
+	}
+
+	uNow = os_timeStampMs (pPowerMgrKL->hOs);
+	powerMgrKLAccount (pPowerMgrKL, uNow, powerMgrKLGetLastTxTime (pPowerMgrKL, uNow));
+	pPowerMgrKL->bNullDataActive = TI_FALSE;
+
+	if (NULL != pPowerMgrKL->hAdaptTimer) {
+		tmr_StopTimer (pPowerMgrKL->hAdaptTimer);
+	}
+}
+
+/**
+ * \fn     powerMgrKL_reportApDisconnect
+ * \brief  Notifies the power-manager keep-alive of a disassociation / deauthentication from the AP
+ *
+ * Learns the AP inactivity timeout if the AP disconnected us due to inactivity.
+ *
+ * \param  hPowerMgrKL - handle to the power-manager keep-alive object
+ * \param  uReasonCode - the 802.11 reason code
+ * \return None
+ * \sa     powerMgrKL_startNullData
+ */
+void powerMgrKL_reportApDisconnect (TI_HANDLE hPowerMgrKL, TI_UINT16 uReasonCode)
+{
+	TPowerMgrKL     *pPowerMgrKL = (TPowerMgrKL*)hPowerMgrKL;
+	TI_UINT32       uNow;
+
+	if (TI_FALSE == pPowerMgrKL->bNullDataActive) {
+		return;
+	}
+
+	uNow = os_timeStampMs (pPowerMgrKL->hOs);
+	powerMgrKLLearn (pPowerMgrKL, uNow, powerMgrKLGetLastTxTime (pPowerMgrKL, uNow), uReasonCode);
+}
+
+#ifdef TI_DBG
+
+#define KEEP_ALIVE_SIM_STEP_MS          100
+#define KEEP_ALIVE_SIM_DURATION_MS      (4 * 3600 * 1000)
+#define KEEP_ALIVE_SIM_PACKET_PERIOD_MS 500
+
+/* Results of a single simulation run */
+typedef struct {
+	TI_UINT32   uKeepAlives;        /* keep-alives sent by the simulated FW */
+	TI_UINT32   uEstimated;         /* keep-alives estimated by the accounting */
+	TI_UINT32   uDeauths;           /* inactivity disconnections */
+	TI_UINT32   uLateDeauths;       /* inactivity disconnections after the AP timeout was learned */
+	TI_UINT32   uLearnedTimeout;
+	TI_UINT32   uFinalInterval;
+} TKeepAliveSimResult;
+
+/**
+ * \fn     powerMgrKLSimRand
+ * \brief  Returns the next pseudo random number for the AP timeout simulation
+ */
+static TI_UINT32 powerMgrKLSimRand (TI_UINT32 *pSeed)
+{
+	*pSeed = (*pSeed * 1664525) + 1013904223;
+	return (*pSeed >> 8);
+}
+
+/**
+ * \fn     powerMgrKLSimulate
+ * \brief  Runs the keep-alive engine against a simulated FW and AP
+ *
+ * The simulated FW sends a keep-alive after an interval without transmissions. The simulated
+ * AP disconnects with an inactivity reason when it heard nothing for its timeout, after which
+ * the STA reconnects. Traffic is random bursts of packets.
+ *
+ * \param  pPowerMgrKL - pointer to the power-manager keep-alive object (state is overwritten)
+ * \param  bAdaptive - run with or without the adaptive interval
+ * \param  uDefaultIntervalMs - the static keep-alive interval
+ * \param  uApTimeoutMs - the simulated AP inactivity timeout
+ * \param  uSeed - traffic generator seed
+ * \param  pResult - the simulation results
+ * \return None
+ */
+static void powerMgrKLSimulate (TPowerMgrKL *pPowerMgrKL, TI_BOOL bAdaptive, TI_UINT32 uDefaultIntervalMs,
+                                TI_UINT32 uApTimeoutMs, TI_UINT32 uSeed, TKeepAliveSimResult *pResult)
+{
+	TMacAddr    tBssid = { 0x00, 0x12, 0x34, 0x56, 0x78, 0x9a };
+	TI_UINT32   uNow = 0, uLastTx = 0, uFwLastFrame = 0, uApLastHeard = 0, uBurstEnd = 0, uNextCheck;
+
+	os_memoryZero (pPowerMgrKL->hOs, pResult, sizeof(TKeepAliveSimResult));
+	os_memoryZero (pPowerMgrKL->hOs, pPowerMgrKL->aApHistory, sizeof(pPowerMgrKL->aApHistory));
+	os_memoryZero (pPowerMgrKL->hOs, &(pPowerMgrKL->tStats), sizeof(TKeepAliveStats));
+	pPowerMgrKL->bAdaptive = bAdaptive;
+
+	powerMgrKLConnect (pPowerMgrKL, &tBssid, uDefaultIntervalMs, uNow);
+	uNextCheck = uNow + (pPowerMgrKL->uIntervalMs / KEEP_ALIVE_CHECKS_PER_PERIOD);
+
+	for (uNow = KEEP_ALIVE_SIM_STEP_MS; uNow < KEEP_ALIVE_SIM_DURATION_MS; uNow += KEEP_ALIVE_SIM_STEP_MS) {
+		/* traffic - a burst of 1 to 30 seconds starts every 20 seconds on average */
+		if (uNow >= uBurstEnd) {
+			if (0 == (powerMgrKLSimRand (&uSeed) % 200)) {
+				uBurstEnd = uNow + 1000 + (powerMgrKLSimRand (&uSeed) % 29000);
+			}
+		} else if (0 == (uNow % KEEP_ALIVE_SIM_PACKET_PERIOD_MS)) {
+			uLastTx = uFwLastFrame = uApLastHeard = uNow;
+		}
+
+		/* FW - keep-alive after an interval without transmissions */
+		if ((uNow - uFwLastFrame) >= pPowerMgrKL->uIntervalMs) {
+			uFwLastFrame = uApLastHeard = uNow;
+			pResult->uKeepAlives++;
+		}
+
+		/* AP - inactivity disconnection and reconnection */
+		if ((uNow - uApLastHeard) > uApTimeoutMs) {
+			pResult->uDeauths++;
+			if (0 != pPowerMgrKL->aApHistory[ pPowerMgrKL->uCurrAp ].uTimeoutMs) {
+				pResult->uLateDeauths++;
+			}
+			powerMgrKLLearn (pPowerMgrKL, uNow, uLastTx, KEEP_ALIVE_REASON_INACTIVITY);
+
+			uLastTx = uFwLastFrame = uApLastHeard = uNow;
+			powerMgrKLConnect (pPowerMgrKL, &tBssid, uDefaultIntervalMs, uNow);
+			uNextCheck = uNow + (pPowerMgrKL->uIntervalMs / KEEP_ALIVE_CHECKS_PER_PERIOD);
+		}
+
+		/* accounting timer */
+		if (uNow >= uNextCheck) {
+			powerMgrKLAccount (pPowerMgrKL, uNow, uLastTx);
+			uNextCheck = uNow + (pPowerMgrKL->uIntervalMs / KEEP_ALIVE_CHECKS_PER_PERIOD);
+		}
+	}
+	powerMgrKLAccount (pPowerMgrKL, uNow, uLastTx);
+
+	pResult->uEstimated = pPowerMgrKL->tStats.uKeepAlivesSent;
+	pResult->uLearnedTimeout = pPowerMgrKL->aApHistory[ pPowerMgrKL->uCurrAp ].uTimeoutMs;
+	pResult->uFinalInterval = pPowerMgrKL->uIntervalMs;
+}
+
+/**
+ * \fn     powerMgrKL_simulateApTimeout
+ * \brief  Validates the adaptive keep-alive against simulated AP inactivity timeouts
+ *
+ * Runs four hours of simulated random traffic with a fixed and with an adaptive interval, and
+ * checks that the adaptive engine is disconnected at most once per AP (before the timeout is
+ * learned) and never sends more keep-alives than the fixed interval if that one keeps the
+ * association. The keep-alive object state is restored when done.
+ *
+ * \param  hPowerMgrKL - handle to the power-manager keep-alive object
+ * \param  uApTimeoutSec - the simulated AP inactivity timeout, 0 for a set of typical timeouts
+ * \return None
+ */
+void powerMgrKL_simulateApTimeout (TI_HANDLE hPowerMgrKL, TI_UINT32 uApTimeoutSec)
+{
+	TPowerMgrKL         *pPowerMgrKL = (TPowerMgrKL*)hPowerMgrKL;
+	TPowerMgrKL         *pSaved;
+	TKeepAliveSimResult tFixed, tAdaptive;
+	TI_UINT32           aTimeouts[] = { 5, 30, 120, 300 };
+	TI_UINT32           uNumTimeouts = sizeof(aTimeouts) / sizeof(aTimeouts[0]);
+	TI_UINT32           uDefaultIntervalMs, uSeed, uIndex, uFailures = 0;
+
+	if (0 != uApTimeoutSec) {
+		aTimeouts[ 0 ] = uApTimeoutSec;
+		uNumTimeouts = 1;
+	}
+
+	pSaved = os_memoryAlloc (pPowerMgrKL->hOs, sizeof(TPowerMgrKL));
+	if (NULL == pSaved) {
+		WLAN_OS_REPORT(("Keep-alive simulation: memory allocation failed\n"));
+		return;
+	}
+	os_memoryCopy (pPowerMgrKL->hOs, pSaved, pPowerMgrKL, sizeof(TPowerMgrKL));
+
+	/* the simulation must not be disturbed by the real accounting */
+	if (NULL != pPowerMgrKL->hAdaptTimer) {
+		tmr_StopTimer (pPowerMgrKL->hAdaptTimer);
+	}
+
+	uDefaultIntervalMs = (0 != pSaved->uDefaultIntervalMs) ? pSaved->uDefaultIntervalMs : (NULL_KL_PERIOD_DEF * 1000);
+	WLAN_OS_REPORT(("Keep-alive simulation: default interval %d ms, maximum interval %d ms\n",
+	                uDefaultIntervalMs, pSaved->uMaxIntervalMs));
+
+	for (uIndex = 0; uIndex < uNumTimeouts; uIndex++) {
+		uSeed = os_timeStampMs (pPowerMgrKL->hOs);
+		powerMgrKLSimulate (pPowerMgrKL, TI_FALSE, uDefaultIntervalMs, aTimeouts[ uIndex ] * 1000, uSeed, &tFixed);
+		powerMgrKLSimulate (pPowerMgrKL, TI_TRUE, uDefaultIntervalMs, aTimeouts[ uIndex ] * 1000, uSeed, &tAdaptive);
+
+		WLAN_OS_REPORT(("AP timeout %4d s: fixed %6d keep-alives %4d deauths | adaptive %6d keep-alives (estimated %6d) %4d deauths, learned %d ms, interval %d ms\n",
+		                aTimeouts[ uIndex ], tFixed.uKeepAlives, tFixed.uDeauths,
+		                tAdaptive.uKeepAlives, tAdaptive.uEstimated, tAdaptive.uDeauths,
+		                tAdaptive.uLearnedTimeout, tAdaptive.uFinalInterval));
+
+		if ((0 != tAdaptive.uLateDeauths) ||
+		        ((0 == tFixed.uDeauths) && (tAdaptive.uKeepAlives > tFixed.uKeepAlives))) {
+			WLAN_OS_REPORT(("AP timeout %d s: FAILED (%d deauths after learning)\n",
+			                aTimeouts[ uIndex ], tAdaptive.uLateDeauths));
+			uFailures++;
+		}
+	}
+
+	/* restore the keep-alive state */
+	os_memoryCopy (pPowerMgrKL->hOs, pPowerMgrKL, pSaved, sizeof(TPowerMgrKL));
+	os_memoryFree (pPowerMgrKL->hOs, pSaved, sizeof(TPowerMgrKL));
+	if ((TI_TRUE == pPowerMgrKL->bNullDataActive) && (TI_TRUE == pPowerMgrKL->bAdaptive)) {
+		tmr_StartTimer (pPowerMgrKL->hAdaptTimer, powerMgrKLAdaptTimeout, hPowerMgrKL,
+		                pPowerMgrKL->uIntervalMs / KEEP_ALIVE_CHECKS_PER_PERIOD, TI_TRUE);
+	}
+
+	WLAN_OS_REPORT(("Keep-alive simulation: %d of %d AP timeouts passed\n", uNumTimeouts - uFailures, uNumTimeouts));
+}
+
+/**
+ * \fn     powerMgrKL_printStats
+ * \brief  Prints the null-data keep-alive statistics and AP history
+ *
+ * \param  hPowerMgrKL - handle to the power-manager keep-alive object
+ * \return None
+ */
+void powerMgrKL_printStats (TI_HANDLE hPowerMgrKL)
+{
+	TPowerMgrKL         *pPowerMgrKL = (TPowerMgrKL*)hPowerMgrKL;
+	TKeepAliveApHistory *pAp;
+	TI_UINT32           uIndex, uBaseline = 0, uSaved = 0;
+
+	if (0 != pPowerMgrKL->uDefaultIntervalMs) {
+		uBaseline = pPowerMgrKL->tStats.uConnectedMs / pPowerMgrKL->uDefaultIntervalMs;
+	}
+	if (uBaseline > pPowerMgrKL->tStats.uKeepAlivesSent) {
+		uSaved = uBaseline - pPowerMgrKL->tStats.uKeepAlivesSent;
+	}
+
+	WLAN_OS_REPORT(("------------- Null-Data Keep-Alive -------------\n"));
+	WLAN_OS_REPORT(("Adaptive          = %d\n", pPowerMgrKL->bAdaptive));
+	WLAN_OS_REPORT(("Active            = %d\n", pPowerMgrKL->bNullDataActive));
+	WLAN_OS_REPORT(("Default interval  = %d ms\n", pPowerMgrKL->uDefaultIntervalMs));
+	WLAN_OS_REPORT(("Maximum interval  = %d ms\n", pPowerMgrKL->uMaxIntervalMs));
+	WLAN_OS_REPORT(("Current interval  = %d ms\n", pPowerMgrKL->uIntervalMs));
+	WLAN_OS_REPORT(("Connected time    = %d ms\n", pPowerMgrKL->tStats.uConnectedMs));
+	WLAN_OS_REPORT(("Keep-alives sent  = %d (%d with a fixed period)\n", pPowerMgrKL->tStats.uKeepAlivesSent, uBaseline));
+	WLAN_OS_REPORT(("Deferred by data  = %d\n", pPowerMgrKL->tStats.uKeepAlivesDeferred));
+	WLAN_OS_REPORT(("Wakeups saved     = %d\n", uSaved));
+	WLAN_OS_REPORT(("Inactivity deauth = %d\n", pPowerMgrKL->tStats.uInactivityDeauths));
+	WLAN_OS_REPORT(("Interval updates  = %d\n", pPowerMgrKL->tStats.uIntervalUpdates));
+
+	for (uIndex = 0; uIndex < KEEP_ALIVE_AP_HISTORY_SIZE; uIndex++) {
+		pAp = &(pPowerMgrKL->aApHistory[ uIndex ]);
+		if (MAC_NULL (pAp->tBssid)) {
+			continue;
+		}
+		WLAN_OS_REPORT(("AP %02x:%02x:%02x:%02x:%02x:%02x: timeout %d ms, safe interval %d ms, %d inactivity deauths\n",
+		                pAp->tBssid[0], pAp->tBssid[1], pAp->tBssid[2], pAp->tBssid[3], pAp->tBssid[4], pAp->tBssid[5],
+		                pAp->uTimeoutMs, pAp->uSafeIntervalMs, pAp->uInactivityDeauths));
+	}
+}
+
+#endif /* TI_DBG */
@@ -43,11 +43,19 @@
 TI_HANDLE powerMgrKL_create (TI_HANDLE hOS);
 void powerMgrKL_destroy (TI_HANDLE hPowerMgrKL);
 void powerMgrKL_init (TI_HANDLE hPowerMgrKL, TStadHandlesList *pStadHandles);
-void powerMgrKL_setDefaults (TI_HANDLE hPowerMgrKL);
+void powerMgrKL_setDefaults (TI_HANDLE hPowerMgrKL, PowerMgrInitParams_t *pInitParams);
 TI_STATUS powerMgrKL_start (TI_HANDLE hPowerMgrKL);
-TI_STATUS powerMgrKL_stop (TI_HANDLE hPowerMgrKL, TI_BOOL bDisconnect);
+void powerMgrKL_stop (TI_HANDLE hPowerMgrKL, TI_BOOL bDisconnect);
 TI_STATUS powerMgrKL_setParam (TI_HANDLE hPowerMgrKL, paramInfo_t *pParam);
 TI_STATUS powerMgrKL_getParam (TI_HANDLE hPowerMgrKL, paramInfo_t *pParam);
+TI_UINT32 powerMgrKL_startNullData (TI_HANDLE hPowerMgrKL, TI_UINT8 uIndex, TMacAddr *pBssid,
+                                    TI_UINT32 uDefaultIntervalMs);
+void powerMgrKL_stopNullData (TI_HANDLE hPowerMgrKL);
+void powerMgrKL_reportApDisconnect (TI_HANDLE hPowerMgrKL, TI_UINT16 uReasonCode);
+#ifdef TI_DBG
+void powerMgrKL_simulateApTimeout (TI_HANDLE hPowerMgrKL, TI_UINT32 uApTimeoutSec);
+void powerMgrKL_printStats (TI_HANDLE hPowerMgrKL);
+#endif
 
 #endif /* __POWER_MGR_KEEP_ALIVE_H__ */
 
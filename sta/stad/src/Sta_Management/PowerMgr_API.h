@@ -192,6 +192,19 @@ TI_STATUS PowerMgr_setPowerMode(TI_HANDLE thePowerMgrHandle);
  */
 PowerMgr_PowerMode_e PowerMgr_getPowerMode(TI_HANDLE thePowerMgrHandle);
 
+
+/**
+ * \
+ * \brief Get the number of PS requests that completed with the given result.
+ *
+ * Function Scope \e Public.\n
+ * Parameters:\n
+ * 1) TI_HANDLE - handle to the PowerMgr object.\n
+ * 2) EventsPowerSave_e - the PS request result (enter / exit, success / fail).\n
+ * Return Value: TI_UINT32 - number of PS requests since the driver was loaded.\n
+ */
+TI_UINT32 PowerMgr_GetPsTransactionCount(TI_HANDLE thePowerMgrHandle, EventsPowerSave_e eResult);
+
 TI_STATUS powerMgr_getParam(TI_HANDLE thePowerMgrHandle,
                             paramInfo_t *theParamP);
 TI_STATUS powerMgr_setParam(TI_HANDLE thePowerMgrHandle,
@@ -224,6 +237,17 @@ TI_STATUS PowerMgr_notifyFWReset(TI_HANDLE hPowerMgr);
 
 TI_BOOL PowerMgr_getReAuthActivePriority(TI_HANDLE thePowerMgrHandle);
 
+/**
+ * \brief Start / stop the adaptive null-data keep-alive and report AP disconnections to it.
+ *
+ * Function Scope \e Public.\n
+ * PowerMgr_StartNullDataKeepAlive returns the keep-alive interval (ms) to configure.\n
+ */
+TI_UINT32 PowerMgr_StartNullDataKeepAlive (TI_HANDLE hPowerMgr, TI_UINT8 uIndex,
+        TMacAddr *pBssid, TI_UINT32 uDefaultIntervalMs);
+void PowerMgr_StopNullDataKeepAlive (TI_HANDLE hPowerMgr);
+void PowerMgr_ReportApDisconnect (TI_HANDLE hPowerMgr, TI_UINT16 uReasonCode);
+
 TI_STATUS powerMgr_suspend(TI_HANDLE thePowerMgrHandle);
 TI_STATUS powerMgr_resume(TI_HANDLE thePowerMgrHandle);
 
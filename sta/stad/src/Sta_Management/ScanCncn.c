@@ -189,6 +189,8 @@ void scanCncn_Init (TStadHandlesList *pStadHandles)
 	pScanCncn->eCurrentRunningAppScanClient = SCAN_SCC_NO_CLIENT;
 	pScanCncn->uOSScanLastTimeStamp = 0;
 	pScanCncn->bOSScanRunning = TI_FALSE;
+	pScanCncn->uResultRecordSeq = 0;
+	pScanCncn->uResultStreamId = 0;
 
 	/* initialize client objects */
 	scanCncnSm_Init (pScanCncn->pScanClients[ SCAN_SCC_ROAMING_IMMED ], pScanCncn->hReport, pScanCncn->hTWD,
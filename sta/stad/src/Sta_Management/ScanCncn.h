@@ -222,6 +222,7 @@ TI_STATUS               scanCncnApp_SetParam (TI_HANDLE hScanCncn, paramInfo_t *
 TI_STATUS               scanCncnApp_GetParam (TI_HANDLE hScanCncn, paramInfo_t *pParam);
 void                    scanCncn_AppScanResultCB (TI_HANDLE hScanCncn, EScanCncnResultStatus status,
         TScanFrameInfo* frameInfo, TI_UINT16 SPSStatus);
+void                    scanCncnApp_EndResultStream (TI_HANDLE hScanCncn);
 void                    scanCncn_PeriodicScanCompleteCB (TI_HANDLE hScanCncn, char* str, TI_UINT32 strLen);
 void                    scanCncn_PeriodicScanReportCB (TI_HANDLE hScanCncn, char* str, TI_UINT32 strLen);
 
@@ -228,6 +228,12 @@ TI_STATUS scanCncnApp_GetParam (TI_HANDLE hScanCncn, paramInfo_t *pParam)
 		return scanResultTable_GetBssidSupportedRatesList (pScanCncn->hScanResultTable, pParam->content.pRateList,
 		        &pParam->paramLength);
 
+	case SCAN_CNCN_BSSID_LIST_GENERATION_PARAM:
+		/* retrieve the scan result table generation, so callers can tell if a copy of the list is still valid */
+		pParam->paramLength = sizeof(TI_UINT32);
+		pParam->content.uBssidListGeneration = scanResultTable_GetUpdateCount (pScanCncn->hScanResultTable);
+		break;
+
 	default:
 		return PARAM_NOT_SUPPORTED;
 	}
@@ -235,6 +241,66 @@ TI_STATUS scanCncnApp_GetParam (TI_HANDLE hScanCncn, paramInfo_t *pParam)
 	return TI_OK;
 }
 
+/**
+ * \fn     scanCncnApp_SendResultRecord
+ * \brief  Sends a result table change to the user as a compact record
+ *
+ * Builds a TScanResultRecord from a result table entry (or an end of stream record when no entry
+ * is given) and sends it with the next sequence number, so clients can apply scan results as they
+ * arrive instead of reading the whole table when the scan completes.
+ *
+ * \param  pScanCncn - the scan concentrator object
+ * \param  pSite - the inserted or updated result table entry, NULL for an end record
+ * \param  uFlags - SCAN_RESULT_RECORD_xxx flags for the record
+ * \return None
+ */
+static void scanCncnApp_SendResultRecord (TScanCncn *pScanCncn, TSiteEntry *pSite, TI_UINT8 uFlags)
+{
+	TScanResultRecord   tRecord;
+
+	os_memoryZero (pScanCncn->hOS, &tRecord, sizeof (TScanResultRecord));
+
+	tRecord.uSequence = ++pScanCncn->uResultRecordSeq;
+	tRecord.uStreamId = pScanCncn->uResultStreamId;
+	tRecord.uFlags = uFlags;
+
+	if (NULL != pSite) {
+		tRecord.uBand = (TI_UINT8)pSite->eBand;
+		MAC_COPY (tRecord.tBssid, pSite->bssid);
+		tRecord.uChannel = pSite->channel;
+		tRecord.iRssi = (TI_INT8)pSite->rssi;
+		tRecord.iSnr = pSite->snr;
+		tRecord.uBeaconInterval = pSite->beaconInterval;
+		tRecord.uCapabilities = pSite->capabilities;
+		tRecord.uBssType = (TI_UINT8)pSite->bssType;
+		tRecord.uSsidLen = (TI_UINT8)pSite->ssid.len;
+		os_memoryCopy (pScanCncn->hOS, tRecord.aSsid, pSite->ssid.str, pSite->ssid.len);
+		tRecord.uSupportedRatesMask = pSite->rateMask.supportedRateMask;
+	}
+
+	EvHandlerSendEvent (pScanCncn->hEvHandler, IPC_EVENT_SCAN_RESULT_RECORD, (TI_UINT8 *)&tRecord, sizeof(TScanResultRecord));
+}
+
+/**
+ * \fn     scanCncnApp_EndResultStream
+ * \brief  Closes the result record stream of the current app scan
+ *
+ * Sends the end record of the current stream (when result streaming is enabled) and starts a new
+ * stream for the next scan. Called whenever the app scan result table is moved to stable state.
+ *
+ * \param  hScanCncn - handle to the scan concentrator object
+ * \return None
+ */
+void scanCncnApp_EndResultStream (TI_HANDLE hScanCncn)
+{
+	TScanCncn   *pScanCncn = (TScanCncn*)hScanCncn;
+
+	if (TI_TRUE == pScanCncn->tInitParams.bResultStreaming) {
+		scanCncnApp_SendResultRecord (pScanCncn, NULL, SCAN_RESULT_RECORD_END);
+		pScanCncn->uResultStreamId++;
+	}
+}
+
 /**
  * \fn     scanCncn_AppScanResultCB
  * \brief  Scan result callback for application scan
@@ -252,14 +318,24 @@ void scanCncn_AppScanResultCB (TI_HANDLE hScanCncn, EScanCncnResultStatus status
 {
 	TScanCncn   *pScanCncn = (TScanCncn*)hScanCncn;
 	TI_UINT32	statusData;
+	TSiteEntry  *pSite;
+	TI_BOOL     bNewEntry;
 
 	/* Since in Manual Mode the app and the SME use the same table
 	 * there is no need to forward data to SME */
 
 	switch (status) {
 	case SCAN_CRS_RECEIVED_FRAME:
+		if (TI_TRUE == pScanCncn->tInitParams.bResultStreaming) {
+			/* Save the result in the app scan result table, and send the changed entry to the user */
+			if ((TI_OK == scanResultTable_UpdateEntryEx (pScanCncn->hScanResultTable, frameInfo->bssId, frameInfo,
+			              &pSite, &bNewEntry)) && (NULL != pSite)) {
+				scanCncnApp_SendResultRecord (pScanCncn, pSite,
+				                              bNewEntry ? SCAN_RESULT_RECORD_NEW : SCAN_RESULT_RECORD_UPDATED);
+			}
+		}
 		/* Save the result in the app scan result table */
-		if (TI_OK != scanResultTable_UpdateEntry (pScanCncn->hScanResultTable, frameInfo->bssId, frameInfo)) {
+		else if (TI_OK != scanResultTable_UpdateEntry (pScanCncn->hScanResultTable, frameInfo->bssId, frameInfo)) {
 		}
 		break;
 
@@ -273,6 +349,7 @@ void scanCncn_AppScanResultCB (TI_HANDLE hScanCncn, EScanCncnResultStatus status
 		} else {
 			/* move the scan result table to stable state */
 			scanResultTable_SetStableState (pScanCncn->hScanResultTable);
+			scanCncnApp_EndResultStream (hScanCncn);
 
 			/* mark that no app scan is running */
 			pScanCncn->eCurrentRunningAppScanClient = SCAN_SCC_NO_CLIENT;
@@ -295,6 +372,7 @@ void scanCncn_AppScanResultCB (TI_HANDLE hScanCncn, EScanCncnResultStatus status
 		} else {
 			/* move the scan result table to stable state */
 			scanResultTable_SetStableState (pScanCncn->hScanResultTable);
+			scanCncnApp_EndResultStream (hScanCncn);
 
 			/* mark that no app scan is running */
 			pScanCncn->eCurrentRunningAppScanClient = SCAN_SCC_NO_CLIENT;
@@ -321,6 +399,7 @@ void scanCncn_AppScanResultCB (TI_HANDLE hScanCncn, EScanCncnResultStatus status
 		} else {
 			/* move the scan result table to stable state */
 			scanResultTable_SetStableState (pScanCncn->hScanResultTable);
+			scanCncnApp_EndResultStream (hScanCncn);
 
 			/* mark that no app scan is running */
 			pScanCncn->eCurrentRunningAppScanClient = SCAN_SCC_NO_CLIENT;
@@ -360,6 +360,7 @@ void scanCncnOsSm_ActionCompleteScan (TI_HANDLE hScanCncn)
 		 * scan request will be received
 		 */
 		scanResultTable_SetStableState (pScanCncn->hScanResultTable);
+		scanCncnApp_EndResultStream (hScanCncn);
 	} else {
 		pScanCncn->pScanClients[ pScanCncn->eCurrentRunningAppScanClient ]->bScanRejectedOn2_4 = TI_FALSE;
 	}
@@ -88,6 +88,8 @@ typedef struct {
 	TI_UINT32               uOSScanLastTimeStamp;
 	TI_BOOL                 bOSScanRunning;
 	TScanParams             tOsScanParams;
+	TI_UINT32               uResultRecordSeq; /* sequence number of the last result record event */
+	TI_UINT16               uResultStreamId; /* result record stream, advanced at every scan end */
 
 } TScanCncn;
 
@@ -89,6 +89,7 @@
 #include "siteMgrApi.h"
 #include "connApi.h"
 #include "roamingMngrTypes.h"
+#include "PowerMgr_API.h"
 
 /* Constants */
 #define TRIGGER_LOW_RSSI_PACING 1000
@@ -97,6 +98,16 @@
 #define TRIGGER_BG_SCAN_HYSTERESIS 3
 static const TI_UINT32 KEEP_ALIVE_NULL_DATA_INDEX = 3;
 
+/* CRC-32 (IEEE 802.3) table, processing 4 bits at a time */
+static const TI_UINT32 aCrc32NibbleTable[16] = {
+	0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+	0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+#define CRC32_UPDATE(uCrc, uByte)                                                     \
+	uCrc = aCrc32NibbleTable[(uCrc ^ (uByte)) & 0xF] ^ (uCrc >> 4);                    \
+	uCrc = aCrc32NibbleTable[(uCrc ^ ((uByte) >> 4)) & 0xF] ^ (uCrc >> 4)
+
 /* Enumerations */
 
 
@@ -117,6 +128,8 @@ static void currBSS_consecTxErrors(currBSS_t *hCurrBSS, TI_UINT8 *data, TI_UINT8
 static void currBSS_BssLost (currBSS_t *hCurrBSS, TI_UINT8 *data, TI_UINT8 dataLength);
 static void currBSS_reportRoamingEvent(currBSS_t *hCurrBSS, apConn_roamingTrigger_e roamingEventType, roamingEventData_u *pRoamingEventData);
 static void currBSS_updateBSSLoss(currBSS_t *pCurrBSS);
+static TI_STATUS currBSS_refreshConnState(currBSS_t *pCurrBSS);
+static TI_UINT32 currBSS_beaconFingerprint(TI_UINT8 *pIes, TI_UINT16 uIesLen);
 
 static TI_STATUS currBss_HandleTriggerEvent(TI_HANDLE hCurrBSS, TI_UINT8 *data, TI_UINT8 dataLength, TI_UINT8 eventID);
 static triggerDesc_t* currBss_findEmptyUserTrigger(TI_HANDLE hCurrBSS, TI_UINT16 clientID, TI_UINT8* triggerIdx);
@@ -276,6 +289,10 @@ TI_STATUS currBSS_SetDefaults (TI_HANDLE hCurrBSS, TCurrBssInitParams *pInitPara
 	pCurrBSS->type = BSS_ANY;
 	pCurrBSS->currAPInfo.RSSI = 0;
 	pCurrBSS->bUseSGParams = TI_FALSE;
+	pCurrBSS->bConnStateValid = TI_FALSE;
+	pCurrBSS->bBeaconFpValid = TI_FALSE;
+	pCurrBSS->uBeaconsReceived = 0;
+	pCurrBSS->uBeaconsUnchanged = 0;
 	pCurrBSS->uDefaultKeepAlivePeriod = pInitParams->uNullDataKeepAlivePeriod;
 
 
@@ -716,6 +733,8 @@ TI_STATUS currBSS_probRespReceivedCallb(TI_HANDLE hCurrBSS,
 * Callback function, provided to MLME module. Called each time Beacon received.
 * This function verifies that the Probe response was sent by current AP, and then
 * updates current AP database.
+* If the beacon IEs fingerprint is the same as of the last applied beacon, only
+* the RSSI and TSF are updated.
 *
 * \b ARGS:
 *
@@ -735,62 +754,180 @@ TI_STATUS currBSS_beaconReceivedCallb(TI_HANDLE hCurrBSS,
                                       TI_UINT16 bufLength)
 {
 	currBSS_t           *pCurrBSS = (currBSS_t *)hCurrBSS;
-	paramInfo_t         *pParam;
-	ScanBssType_e       eFrameBssType, eCurrentBSSType;
-	TMacAddr            desiredBSSID;
+	ScanBssType_e       eFrameBssType;
+	TI_BOOL             bFramePrivacy = TI_FALSE;
+	TI_UINT32           uCrc;
+
+	if (!pCurrBSS->isConnected) {
+		return TI_OK;
+	}
+
+	/* Get the current BSS type, BSSID and privacy, only when changed */
+	if (!pCurrBSS->bConnStateValid) {
+		if (currBSS_refreshConnState (pCurrBSS) != TI_OK) {
+			return TI_NOK;
+		}
+	}
+
+	eFrameBssType = ((pFrameInfo->content.iePacket.capabilities >> CAP_ESS_SHIFT) & CAP_ESS_MASK) ? BSS_INFRASTRUCTURE : BSS_INDEPENDENT;
+
+	if (pCurrBSS->eConnBssType != eFrameBssType) {
+		return TI_OK;
+	}
+
+	/* if the bss type is ibss save set the current site privacy (the beacons transimted by STA)
+	   and set the privacy from the received frame, so that if the privacy is different there will
+	   be no connection */
+	if (eFrameBssType == BSS_INDEPENDENT) {
+		bFramePrivacy = ((pFrameInfo->content.iePacket.capabilities >> CAP_PRIVACY_SHIFT) & CAP_PRIVACY_MASK) ? TI_TRUE : TI_FALSE;
+	}
+
+	if (MAC_EQUAL(pCurrBSS->tConnBssid, *bssid)) {
+		if ((eFrameBssType == BSS_INFRASTRUCTURE) ||
+		        ((eFrameBssType == BSS_INDEPENDENT) && (pCurrBSS->bConnPrivacy == bFramePrivacy)) ) {
+			pCurrBSS->uBeaconsReceived++;
+			pCurrBSS->currAPInfo.lastRSSI = pRxAttr->Rssi;
+
+			/* If the beacon content is the same as the last one applied, only update its timing */
+			uCrc = currBSS_beaconFingerprint (dataBuffer, bufLength);
+			if (pCurrBSS->bBeaconFpValid &&
+			        (pCurrBSS->uBeaconFpCrc == uCrc) &&
+			        (pCurrBSS->uBeaconFpCapabilities == pFrameInfo->content.iePacket.capabilities) &&
+			        (siteMgr_updateBeaconTsf (pCurrBSS->hSiteMgr, bssid, pFrameInfo) == TI_OK)) {
+				pCurrBSS->uBeaconsUnchanged++;
+				return TI_OK;
+			}
+
+			siteMgr_updateSite(pCurrBSS->hSiteMgr, bssid, pFrameInfo, pRxAttr->channel, (ERadioBand)pRxAttr->band, TI_FALSE);
+			/* Save the IE part of the beacon buffer in the site table */
+			siteMgr_saveBeaconBuffer(pCurrBSS->hSiteMgr, bssid, (TI_UINT8 *)dataBuffer, bufLength);
+
+			pCurrBSS->uBeaconFpCrc = uCrc;
+			pCurrBSS->uBeaconFpCapabilities = pFrameInfo->content.iePacket.capabilities;
+			pCurrBSS->bBeaconFpValid = TI_TRUE;
+		}
+	} else if (eFrameBssType == BSS_INDEPENDENT) {
+		/* Check if the Station sending the beacon uses privacy for the ibss and
+		    compare it to the self site. If privacy usage mathces, merge ibss
+		    and if not continue using self site */
+		if (pCurrBSS->bConnPrivacy == bFramePrivacy) {
+			siteMgr_IbssMerge(pCurrBSS->hSiteMgr, pCurrBSS->tConnBssid, *bssid,
+			                  pFrameInfo, pRxAttr->channel, (ERadioBand)pRxAttr->band);
+			siteMgr_updateSite(pCurrBSS->hSiteMgr, bssid, pFrameInfo, pRxAttr->channel, (ERadioBand)pRxAttr->band, TI_FALSE);
+			siteMgr_saveBeaconBuffer(pCurrBSS->hSiteMgr, bssid, (TI_UINT8 *)dataBuffer, bufLength);
+
+			/* The current BSSID has changed */
+			pCurrBSS->bConnStateValid = TI_FALSE;
+			pCurrBSS->bBeaconFpValid = TI_FALSE;
+		}
+	}
+
+	return TI_OK;
+}
+
+
+/**
+*
+* currBSS_refreshConnState
+*
+* \b Description:
+*
+* Read from the site manager the current BSS type, BSSID and privacy used by the beacon path.
+* They are kept until the connection state or the IBSS BSSID changes.
+*
+* \b ARGS:
+*
+*  I   - pCurrBSS - Current BSS object \n
+*
+* \b RETURNS:
+*
+*  TI_OK on success, TI_NOK on failure.
+*
+* \sa
+*/
+static TI_STATUS currBSS_refreshConnState(currBSS_t *pCurrBSS)
+{
+	paramInfo_t *pParam;
 
 	pParam = (paramInfo_t *)os_memoryAlloc(pCurrBSS->hOs, sizeof(paramInfo_t));
 	if (!pParam) {
 		return TI_NOK;
 	}
 
-	eFrameBssType = ((pFrameInfo->content.iePacket.capabilities >> CAP_ESS_SHIFT) & CAP_ESS_MASK) ? BSS_INFRASTRUCTURE : BSS_INDEPENDENT;
-
 	/* Get current BSS type */
 	pParam->paramType = SITE_MGR_CURRENT_BSS_TYPE_PARAM;
 	siteMgr_getParam (pCurrBSS->hSiteMgr, pParam);
-	eCurrentBSSType = pParam->content.siteMgrCurrentBSSType; /* Save parameter because the next line overrides it */
+	pCurrBSS->eConnBssType = pParam->content.siteMgrCurrentBSSType;
 
-	/* Get current BSSID */
+	/* Get current BSSID, if there is no primary site yet keep the state invalid */
 	pParam->paramType = SITE_MGR_CURRENT_BSSID_PARAM;
+	if (siteMgr_getParam(pCurrBSS->hSiteMgr, pParam) != TI_OK) {
+		os_memoryFree(pCurrBSS->hOs, pParam, sizeof(paramInfo_t));
+		return TI_NOK;
+	}
+	MAC_COPY(pCurrBSS->tConnBssid, pParam->content.siteMgrDesiredBSSID);
+
+	/* Get current site privacy */
+	pParam->paramType = SITE_MGR_SITE_CAPABILITY_PARAM;
 	siteMgr_getParam(pCurrBSS->hSiteMgr, pParam);
-	MAC_COPY(desiredBSSID, pParam->content.siteMgrDesiredBSSID);
-
-	if (pCurrBSS->isConnected && (eCurrentBSSType == eFrameBssType)) {
-		TI_BOOL bFramePrivacy = 0, bCurrentSitePrivacy = 0;
-		/* if the bss type is ibss save set the current site privacy (the beacons transimted by STA)
-		   and set the privacy from the received frame, so that if the privacy is different there will
-		   be no connection */
-		if (eFrameBssType == BSS_INDEPENDENT) {
-			pParam->paramType = SITE_MGR_SITE_CAPABILITY_PARAM;
-			siteMgr_getParam(pCurrBSS->hSiteMgr, pParam);
-
-			bCurrentSitePrivacy = ((pParam->content.siteMgrSiteCapability >> CAP_PRIVACY_SHIFT) & CAP_PRIVACY_MASK) ? TI_TRUE : TI_FALSE;
-			bFramePrivacy       = ((pFrameInfo->content.iePacket.capabilities >> CAP_PRIVACY_SHIFT) & CAP_PRIVACY_MASK) ? TI_TRUE : TI_FALSE;
+	pCurrBSS->bConnPrivacy = ((pParam->content.siteMgrSiteCapability >> CAP_PRIVACY_SHIFT) & CAP_PRIVACY_MASK) ? TI_TRUE : TI_FALSE;
+
+	pCurrBSS->bConnStateValid = TI_TRUE;
+
+	os_memoryFree(pCurrBSS->hOs, pParam, sizeof(paramInfo_t));
+	return TI_OK;
+}
+
+
+/**
+*
+* currBSS_beaconFingerprint
+*
+* \b Description:
+*
+* Calculate a CRC over the beacon IEs, used to detect beacons that carry no new information.
+* The TIM is excluded except for its DTIM period, as its DTIM count and bitmap change from
+* beacon to beacon. The timestamp is not part of the IEs buffer.
+*
+* \b ARGS:
+*
+*  I   - pIes - The beacon IEs \n
+*  I   - uIesLen - The IEs length \n
+*
+* \b RETURNS:
+*
+*  The CRC of the IEs.
+*
+* \sa
+*/
+static TI_UINT32 currBSS_beaconFingerprint(TI_UINT8 *pIes, TI_UINT16 uIesLen)
+{
+	TI_UINT32 uCrc = 0xFFFFFFFF;
+	TI_UINT32 uIeLen;
+	TI_UINT32 i;
+
+	while (uIesLen >= 2) {
+		uIeLen = 2 + pIes[1];
+		if (uIeLen > uIesLen) {
+			uIeLen = uIesLen;
 		}
 
-		if (MAC_EQUAL(desiredBSSID, *bssid)) {
-			if ((eFrameBssType == BSS_INFRASTRUCTURE) ||
-			        ((eFrameBssType == BSS_INDEPENDENT) && (bCurrentSitePrivacy == bFramePrivacy)) ) {
-				siteMgr_updateSite(pCurrBSS->hSiteMgr, bssid, pFrameInfo, pRxAttr->channel, (ERadioBand)pRxAttr->band, TI_FALSE);
-				/* Save the IE part of the beacon buffer in the site table */
-				siteMgr_saveBeaconBuffer(pCurrBSS->hSiteMgr, bssid, (TI_UINT8 *)dataBuffer, bufLength);
+		if (pIes[0] == TIM_IE_ID) {
+			CRC32_UPDATE(uCrc, pIes[0]);
+			if (uIeLen > 3) {
+				CRC32_UPDATE(uCrc, pIes[3]); /* DTIM period */
 			}
-		} else if (eFrameBssType == BSS_INDEPENDENT) {
-			/* Check if the Station sending the beacon uses privacy for the ibss and
-			    compare it to the self site. If privacy usage mathces, merge ibss
-			    and if not continue using self site */
-			if (bCurrentSitePrivacy == bFramePrivacy) {
-				siteMgr_IbssMerge(pCurrBSS->hSiteMgr, desiredBSSID, *bssid,
-				                  pFrameInfo, pRxAttr->channel, (ERadioBand)pRxAttr->band);
-				siteMgr_updateSite(pCurrBSS->hSiteMgr, bssid, pFrameInfo, pRxAttr->channel, (ERadioBand)pRxAttr->band, TI_FALSE);
-				siteMgr_saveBeaconBuffer(pCurrBSS->hSiteMgr, bssid, (TI_UINT8 *)dataBuffer, bufLength);
+		} else {
+			for (i = 0; i < uIeLen; i++) {
+				CRC32_UPDATE(uCrc, pIes[i]);
 			}
 		}
+
+		pIes += uIeLen;
+		uIesLen -= (TI_UINT16)uIeLen;
 	}
 
-	os_memoryFree(pCurrBSS->hOs, pParam, sizeof(paramInfo_t));
-	return TI_OK;
+	return ~uCrc;
 }
 
 
@@ -821,6 +958,10 @@ void currBSS_updateConnectedState(TI_HANDLE hCurrBSS, TI_BOOL isConnected, ScanB
 	pCurrBSS->type = type;
 	pCurrBSS->isConnected = isConnected;
 
+	/* The cached connection state and beacon fingerprint are refreshed on the next beacon */
+	pCurrBSS->bConnStateValid = TI_FALSE;
+	pCurrBSS->bBeaconFpValid = TI_FALSE;
+
 	if (isConnected) {
 		/*** Store the info of current AP ***/
 		paramInfo_t  *pParam;
@@ -891,6 +1032,10 @@ void currBSS_updateConnectedState(TI_HANDLE hCurrBSS, TI_BOOL isConnected, ScanB
 			 */
 			if (0 != uKeepAlivePreiod) {
 
+				/* let the power manager adapt the interval to the AP */
+				uKeepAlivePreiod = PowerMgr_StartNullDataKeepAlive (pCurrBSS->hPowerMngr, KEEP_ALIVE_NULL_DATA_INDEX,
+				                   &(pCurrBSS->currAPInfo.BSSID), uKeepAlivePreiod);
+
 				/* build null-data template */
 				tKeepAliveTemplate.ptr = &(pCurrBSS->keepAliveBuffer[ 0 ]);
 				if ( TI_OK != txCtrlServ_buildNullFrame (pCurrBSS->hTxCtrl,
@@ -917,6 +1062,8 @@ void currBSS_updateConnectedState(TI_HANDLE hCurrBSS, TI_BOOL isConnected, ScanB
 		if (type == BSS_INFRASTRUCTURE) {
 			TKeepAliveParams    tKeepAliveParams;
 
+			PowerMgr_StopNullDataKeepAlive (pCurrBSS->hPowerMngr);
+
 			/* disable NULL-data keep-palive template */
 			tKeepAliveParams.index = KEEP_ALIVE_NULL_DATA_INDEX;
 			tKeepAliveParams.enaDisFlag = TI_FALSE; /* disabled */
@@ -1467,3 +1614,17 @@ void currBss_DbgPrintTriggersTable(TI_HANDLE hCurrBSS)
 	WLAN_OS_REPORT(("\n --------------------------------------------------------------- \n"));
 #endif
 }
+
+void currBss_DbgPrintBeaconStats(TI_HANDLE hCurrBSS)
+{
+#ifdef REPORT_LOG
+	currBSS_t *pCurrBSS = (currBSS_t *)hCurrBSS;
+
+	WLAN_OS_REPORT(("\n -------------------  Current BSS Beacons -------------------- \n"));
+	WLAN_OS_REPORT(("Beacons received  = %u\n", pCurrBSS->uBeaconsReceived));
+	WLAN_OS_REPORT(("Beacons unchanged = %u (%u%%)\n", pCurrBSS->uBeaconsUnchanged,
+	                (pCurrBSS->uBeaconsReceived ? (pCurrBSS->uBeaconsUnchanged * 100) / pCurrBSS->uBeaconsReceived : 0)));
+	WLAN_OS_REPORT(("Fingerprint valid = %d, CRC = 0x%08x\n", pCurrBSS->bBeaconFpValid, pCurrBSS->uBeaconFpCrc));
+	WLAN_OS_REPORT(("\n --------------------------------------------------------------- \n"));
+#endif
+}
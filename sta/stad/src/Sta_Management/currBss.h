@@ -120,6 +120,21 @@ typedef struct _currBSS_t {
 	triggerDesc_t aTriggersDesc[MAX_NUM_OF_RSSI_SNR_TRIGGERS]; /* static table to be used for trigger event registration*/
 	TI_UINT8	  RoamingOperationalMode;                      /* 0 - manual , 1 - Auto */
 
+	/* Connection state cached for the beacon path, refreshed from site manager when invalidated */
+	TI_BOOL       bConnStateValid;        /**< Whether the cached connection state below is valid */
+	ScanBssType_e eConnBssType;           /**< Cached current BSS type */
+	TMacAddr      tConnBssid;             /**< Cached current BSSID */
+	TI_BOOL       bConnPrivacy;           /**< Cached current site privacy (used for IBSS) */
+
+	/* Fingerprint of the last beacon fully applied to the site table */
+	TI_BOOL       bBeaconFpValid;         /**< Whether the fingerprint below is valid */
+	TI_UINT32     uBeaconFpCrc;           /**< CRC over the beacon IEs, excluding TIM bitmap and timestamp */
+	TI_UINT16     uBeaconFpCapabilities;  /**< Capabilities of the fingerprinted beacon */
+
+	/* Beacon path statistics */
+	TI_UINT32     uBeaconsReceived;       /**< Beacons received from the current BSS */
+	TI_UINT32     uBeaconsUnchanged;      /**< Beacons handled by the fast path (only RSSI and TSF updated) */
+
 	/* Handlers of other modules used by AP Connection */
 	TI_HANDLE   hOs;
 	TI_HANDLE   hPowerMngr;
@@ -184,5 +199,7 @@ void currBSS_GetDefaultKeepAlivePeriod(TI_HANDLE hCurrBSS, TI_UINT8* uDefaultKee
 
 void currBss_DbgPrintTriggersTable(TI_HANDLE hCurrBSS);
 
+void currBss_DbgPrintBeaconStats(TI_HANDLE hCurrBSS);
+
 #endif /*  _CURR_BSS_H_*/
 
@@ -60,6 +60,23 @@
 #include "DrvMainModules.h"
 #include "TWDriverInternal.h"
 #include "WlanDrvCommon.h"
+#include "txCtrl_Api.h"
+
+
+/* Time after a data-path reset, at which its success is verified */
+#define HEALTH_MONITOR_DATA_PATH_VERIFY_MS     1000
+
+/* A failure recurring within this time after a data-path reset is handled by a full recovery */
+#define HEALTH_MONITOR_DATA_PATH_RETRY_MS      10000
+
+/* Recovery statistics per tier */
+typedef struct {
+	TI_UINT32            uAttempts;              /* Number of recoveries started */
+	TI_UINT32            uSuccesses;             /* Number of recoveries completed successfully */
+	TI_UINT32            uTotalMs;               /* Accumulated time-to-recover of successful recoveries */
+	TI_UINT32            uMaxMs;                 /* Maximum time-to-recover of successful recoveries */
+
+} TRecoveryTierStat;
 
 
 typedef struct {
@@ -79,6 +96,7 @@ typedef struct {
 
 	/* Timers handles */
 	TI_HANDLE            hFailTimer;             /* failure event timer */
+	TI_HANDLE            hVerifyTimer;           /* data-path reset verification timer */
 
 	/* Management variables */
 	TI_UINT32            numOfHealthTests;       /* number of health tests performed counter */
@@ -95,10 +113,26 @@ typedef struct {
 	/* Number of times each recovery trigger occured */
 	TI_UINT32            numOfRecoveryPerformed; /* number of recoveries performed */
 
+	/* Tiered recovery */
+	TI_UINT32            dataPathFailureEvent;   /* failure handled by the data-path reset being verified */
+	TI_UINT32            uFailureTs;             /* time the last failure event was sent */
+	TI_UINT32            uDataPathResetTs;       /* time the last data-path reset was done */
+	TI_UINT32            uRecoveryStartTs;       /* time the failure handled by the current recovery was sent */
+	TI_BOOL              bFullRecoveryPending;   /* full recovery started by this module is in progress */
+	TRecoveryTierStat    aTierStat [MAX_RECOVERY_TIERS];
+	TI_UINT32            uEscalations;           /* data-path resets escalated to full recovery */
+	TI_BOOL              bDataPathResetFail;     /* fault injection - fail data-path reset verification */
+	TI_BOOL              bDataPathFwResponse;    /* the FW completed the health check sent by the data-path reset */
+
 } THealthMonitor;
 
 
 static void healthMonitor_proccessFailureEvent (TI_HANDLE hHealthMonitor, TI_BOOL bTwdInitOccured);
+static void healthMonitor_StartFullRecovery (THealthMonitor *pHealthMonitor, TI_UINT32 uStartTs);
+static TI_BOOL healthMonitor_StartDataPathReset (THealthMonitor *pHealthMonitor, TI_UINT32 failureEvent);
+static void healthMonitor_VerifyDataPathReset (TI_HANDLE hHealthMonitor, TI_BOOL bTwdInitOccured);
+static void healthMonitor_DataPathHealthCheckCb (TI_HANDLE hHealthMonitor, TI_UINT16 uStatus);
+static void healthMonitor_UpdateTierStat (THealthMonitor *pHealthMonitor, ERecoveryTier eTier, TI_BOOL bSuccess);
 
 
 #ifdef REPORT_LOG
@@ -115,6 +149,11 @@ static char* sRecoveryTriggersNames [MAX_FAILURE_EVENTS] = {
 	"HW_WD_EXPIRE",
 	"RX_XFER_FAILURE"
 };
+
+static char* sRecoveryTiersNames [MAX_RECOVERY_TIERS] = {
+	"DATA_PATH_RESET",
+	"FULL_RECOVERY"
+};
 #endif
 
 
@@ -176,6 +215,7 @@ void healthMonitor_init (TStadHandlesList *pStadHandles)
 
 	pHealthMonitor->state           = HEALTH_MONITOR_STATE_DISCONNECTED;
 	pHealthMonitor->failureEvent    = (TI_UINT32)NO_FAILURE;
+	pHealthMonitor->dataPathFailureEvent = (TI_UINT32)NO_FAILURE;
 
 	/* Register the failure event callback */
 	TWD_RegisterCb (pHealthMonitor->hTWD,
@@ -215,6 +255,12 @@ TI_STATUS healthMonitor_SetDefaults (TI_HANDLE    hHealthMonitor, healthMonitorI
 		return TI_NOK;
 	}
 
+	/* Create data-path reset verification timer */
+	pHealthMonitor->hVerifyTimer = tmr_CreateTimer (pHealthMonitor->hTimer);
+	if (pHealthMonitor->hVerifyTimer == NULL) {
+		return TI_NOK;
+	}
+
 	return TI_OK;
 }
 
@@ -242,6 +288,9 @@ TI_STATUS healthMonitor_unload (TI_HANDLE hHealthMonitor)
 			/* Release the timer */
 			tmr_DestroyTimer (pHealthMonitor->hFailTimer);
 		}
+		if (NULL != pHealthMonitor->hVerifyTimer) {
+			tmr_DestroyTimer (pHealthMonitor->hVerifyTimer);
+		}
 
 		/* Freeing the object should be called last !!!!!!!!!!!! */
 		os_memoryFree (pHealthMonitor->hOs, pHealthMonitor, sizeof(THealthMonitor));
@@ -293,7 +342,12 @@ void healthMonitor_PerformTest (TI_HANDLE hHealthMonitor, TI_BOOL bTwdInitOccure
 	pHealthMonitor->numOfHealthTests++;
 
 	/* Send health-check command to FW, just to ensure command complete is accepted */
-	TWD_CmdHealthCheck (pHealthMonitor->hTWD);
+	TWD_CmdHealthCheck (pHealthMonitor->hTWD, NULL, NULL);
+
+	/* Check for stale packets in the Tx path */
+	if (txCtrl_CheckForTxStuck (pHealthMonitor->hTxCtrl) != TI_OK) {
+		healthMonitor_sendFailureEvent (hHealthMonitor, TX_STUCK);
+	}
 }
 
 
@@ -317,6 +371,7 @@ void healthMonitor_sendFailureEvent (TI_HANDLE hHealthMonitor, EFailureEvent fai
 
 	if (pHealthMonitor->recoveryTriggerEnabled[failureEvent]) {
 		pHealthMonitor->failureEvent = failureEvent;
+		pHealthMonitor->uFailureTs = os_timeStampMs (pHealthMonitor->hOs);
 		/*
 		 * NOTE: start timer with minimum expiry (1 msec) for recovery will start
 		 *       from the top of the stack
@@ -336,6 +391,9 @@ void healthMonitor_sendFailureEvent (TI_HANDLE hHealthMonitor, EFailureEvent fai
 DESCRIPTION:    this is the central error function - will be passed as call back
                 to the TnetWDriver modules. it will parse the error and dispatch the
                 relevant action (recovery or not)
+                Tx stuck is first handled by a data-path reset, unless it was already
+                tried shortly before. Other failures (including disconnect timeout, which
+                means the FW didn't complete a command) are handled by a full recovery.
 
 INPUT:      hHealthMonitor - health monitor handle
             bTwdInitOccured -   Indicates if TWDriver recovery occured since timer started
@@ -356,8 +414,9 @@ void healthMonitor_proccessFailureEvent (TI_HANDLE hHealthMonitor, TI_BOOL bTwdI
 		WLAN_OS_REPORT (("***** recovery trigger: %s *****, ts=%d\n", sRecoveryTriggersNames[pHealthMonitor->failureEvent], os_timeStampMs(pHealthMonitor->hOs)));
 
 		if (TWD_RecoveryEnabled (pHealthMonitor->hTWD)) {
-			pHealthMonitor->numOfRecoveryPerformed ++;
-			drvMain_Recovery (pHealthMonitor->hDrvMain);
+			if (!healthMonitor_StartDataPathReset (pHealthMonitor, pHealthMonitor->failureEvent)) {
+				healthMonitor_StartFullRecovery (pHealthMonitor, pHealthMonitor->uFailureTs);
+			}
 		} else {
 			wlanDrvIf_UpdateDriverState(pHealthMonitor->hOs, DRV_STATE_FAILED);
 			WLAN_OS_REPORT(("healthMonitor_proccessFailureEvent: Recovery is disabled in tiwlan.ini, abort recovery process\n"));
@@ -368,6 +427,237 @@ void healthMonitor_proccessFailureEvent (TI_HANDLE hHealthMonitor, TI_BOOL bTwdI
 }
 
 
+/***********************************************************************
+ *                        healthMonitor_StartFullRecovery
+ ***********************************************************************
+DESCRIPTION:    Start a full recovery (driver stop, FW reload and re-init).
+                Its completion is reported by DrvMain in healthMonitor_RecoveryComplete.
+
+INPUT:      pHealthMonitor - health monitor object
+            uStartTs       - time the handled failure was sent
+
+OUTPUT:
+
+RETURN:
+
+************************************************************************/
+static void healthMonitor_StartFullRecovery (THealthMonitor *pHealthMonitor, TI_UINT32 uStartTs)
+{
+	/*
+	 * A data-path reset waiting for verification is superseded by the full recovery,
+	 *   and its failure time is used, so the time-to-recover includes the failed reset.
+	 */
+	if (pHealthMonitor->dataPathFailureEvent != (TI_UINT32)NO_FAILURE) {
+		tmr_StopTimer (pHealthMonitor->hVerifyTimer);
+		pHealthMonitor->dataPathFailureEvent = (TI_UINT32)NO_FAILURE;
+		healthMonitor_UpdateTierStat (pHealthMonitor, RECOVERY_TIER_DATA_PATH, TI_FALSE);
+		pHealthMonitor->uEscalations++;
+		uStartTs = pHealthMonitor->uRecoveryStartTs;
+	}
+
+	pHealthMonitor->numOfRecoveryPerformed ++;
+
+	/* Nested recoveries are accounted as one */
+	if (!pHealthMonitor->bFullRecoveryPending) {
+		pHealthMonitor->bFullRecoveryPending = TI_TRUE;
+		pHealthMonitor->uRecoveryStartTs = uStartTs;
+		pHealthMonitor->aTierStat[RECOVERY_TIER_FULL].uAttempts++;
+	}
+
+	drvMain_Recovery (pHealthMonitor->hDrvMain);
+}
+
+
+/***********************************************************************
+ *                        healthMonitor_StartDataPathReset
+ ***********************************************************************
+DESCRIPTION:    Try to handle a failure by a data-path reset, send a health check
+                to the FW and start a timer to verify it. Used for Tx stuck, if no
+                data-path reset was done in the last HEALTH_MONITOR_DATA_PATH_RETRY_MS.
+
+INPUT:      pHealthMonitor - health monitor object
+            failureEvent   - the failure to handle
+
+OUTPUT:
+
+RETURN:     TI_TRUE if a data-path reset was done, TI_FALSE if a full recovery is needed
+
+************************************************************************/
+static TI_BOOL healthMonitor_StartDataPathReset (THealthMonitor *pHealthMonitor, TI_UINT32 failureEvent)
+{
+	if (failureEvent != TX_STUCK) {
+		return TI_FALSE;
+	}
+
+	/* If a data-path reset is already being verified or didn't help, escalate */
+	if (pHealthMonitor->dataPathFailureEvent != (TI_UINT32)NO_FAILURE) {
+		return TI_FALSE;
+	}
+	if ((pHealthMonitor->aTierStat[RECOVERY_TIER_DATA_PATH].uAttempts > 0) &&
+	        (pHealthMonitor->uFailureTs - pHealthMonitor->uDataPathResetTs < HEALTH_MONITOR_DATA_PATH_RETRY_MS)) {
+		pHealthMonitor->uEscalations++;
+		return TI_FALSE;
+	}
+
+	if (drvMain_DataPathReset (pHealthMonitor->hDrvMain) != TI_OK) {
+		return TI_FALSE;
+	}
+
+	pHealthMonitor->aTierStat[RECOVERY_TIER_DATA_PATH].uAttempts++;
+	pHealthMonitor->uDataPathResetTs = os_timeStampMs (pHealthMonitor->hOs);
+	pHealthMonitor->uRecoveryStartTs = pHealthMonitor->uFailureTs;
+	pHealthMonitor->dataPathFailureEvent = failureEvent;
+	pHealthMonitor->bDataPathFwResponse = TI_FALSE;
+
+	/* The reset is successful only if the FW responds to this command before verification */
+	TWD_CmdHealthCheck (pHealthMonitor->hTWD, (void *)healthMonitor_DataPathHealthCheckCb, (TI_HANDLE)pHealthMonitor);
+
+	tmr_StartTimer (pHealthMonitor->hVerifyTimer,
+	                healthMonitor_VerifyDataPathReset,
+	                (TI_HANDLE)pHealthMonitor,
+	                HEALTH_MONITOR_DATA_PATH_VERIFY_MS,
+	                TI_FALSE);
+
+	return TI_TRUE;
+}
+
+
+/***********************************************************************
+ *                        healthMonitor_VerifyDataPathReset
+ ***********************************************************************
+DESCRIPTION:    Verification timer callback. The data-path reset succeeded if the FW
+                completed the health check sent by the reset, no FW reset occured since,
+                and no stale packets are left. Otherwise, a full recovery is started.
+
+INPUT:      hHealthMonitor  - health monitor handle
+            bTwdInitOccured - Indicates if TWDriver recovery occured since timer started
+
+OUTPUT:
+
+RETURN:
+
+************************************************************************/
+static void healthMonitor_VerifyDataPathReset (TI_HANDLE hHealthMonitor, TI_BOOL bTwdInitOccured)
+{
+	THealthMonitor *pHealthMonitor = (THealthMonitor*)hHealthMonitor;
+	TI_BOOL        bSuccess = TI_TRUE;
+
+	if (pHealthMonitor->dataPathFailureEvent == (TI_UINT32)NO_FAILURE) {
+		return;
+	}
+
+	if (bTwdInitOccured || pHealthMonitor->bDataPathResetFail || !pHealthMonitor->bDataPathFwResponse) {
+		bSuccess = TI_FALSE;
+	} else if (txCtrl_CheckForTxStuck (pHealthMonitor->hTxCtrl) != TI_OK) {
+		bSuccess = TI_FALSE;
+	}
+
+	pHealthMonitor->dataPathFailureEvent = (TI_UINT32)NO_FAILURE;
+
+	if (bSuccess) {
+		healthMonitor_UpdateTierStat (pHealthMonitor, RECOVERY_TIER_DATA_PATH, TI_TRUE);
+		return;
+	}
+
+	healthMonitor_UpdateTierStat (pHealthMonitor, RECOVERY_TIER_DATA_PATH, TI_FALSE);
+	pHealthMonitor->uEscalations++;
+
+	/* If the FW was already reset, there is nothing more to do */
+	if (!bTwdInitOccured) {
+		WLAN_OS_REPORT (("healthMonitor_VerifyDataPathReset: data-path reset failed, starting full recovery\n"));
+		healthMonitor_StartFullRecovery (pHealthMonitor, pHealthMonitor->uRecoveryStartTs);
+	}
+}
+
+
+/***********************************************************************
+ *                        healthMonitor_DataPathHealthCheckCb
+ ***********************************************************************
+DESCRIPTION:    Completion of the health check sent by the data-path reset.
+
+INPUT:      hHealthMonitor - health monitor handle
+            uStatus        - the FW command status
+
+OUTPUT:
+
+RETURN:
+
+************************************************************************/
+static void healthMonitor_DataPathHealthCheckCb (TI_HANDLE hHealthMonitor, TI_UINT16 uStatus)
+{
+	THealthMonitor *pHealthMonitor = (THealthMonitor*)hHealthMonitor;
+
+	if ((pHealthMonitor->dataPathFailureEvent != (TI_UINT32)NO_FAILURE) && (uStatus == CMD_STATUS_SUCCESS)) {
+		pHealthMonitor->bDataPathFwResponse = TI_TRUE;
+	}
+}
+
+
+/***********************************************************************
+ *                        healthMonitor_RecoveryComplete
+ ***********************************************************************
+DESCRIPTION:    Called by DrvMain when a full recovery is completed or given up.
+
+INPUT:      hHealthMonitor - health monitor handle
+            bSuccess       - TI_TRUE if the driver is operational again
+
+OUTPUT:
+
+RETURN:
+
+************************************************************************/
+void healthMonitor_RecoveryComplete (TI_HANDLE hHealthMonitor, TI_BOOL bSuccess)
+{
+	THealthMonitor *pHealthMonitor = (THealthMonitor*)hHealthMonitor;
+
+	/* Ignore recoveries that were not started by this module (e.g. from CLI) */
+	if (!pHealthMonitor->bFullRecoveryPending) {
+		return;
+	}
+
+	pHealthMonitor->bFullRecoveryPending = TI_FALSE;
+	healthMonitor_UpdateTierStat (pHealthMonitor, RECOVERY_TIER_FULL, bSuccess);
+}
+
+
+/***********************************************************************
+ *                        healthMonitor_UpdateTierStat
+ ***********************************************************************
+DESCRIPTION:    Update the statistics of a recovery tier upon its completion.
+
+INPUT:      pHealthMonitor - health monitor object
+            eTier          - the recovery tier
+            bSuccess       - TI_TRUE if the recovery succeeded
+
+OUTPUT:
+
+RETURN:
+
+************************************************************************/
+static void healthMonitor_UpdateTierStat (THealthMonitor *pHealthMonitor, ERecoveryTier eTier, TI_BOOL bSuccess)
+{
+	TRecoveryTierStat *pStat = &pHealthMonitor->aTierStat[eTier];
+	TI_UINT32         uTimeMs;
+
+	if (!bSuccess) {
+		return;
+	}
+
+	/* Time-to-recover is from the failure event; for data-path reset it excludes the verification time */
+	if (eTier == RECOVERY_TIER_DATA_PATH) {
+		uTimeMs = pHealthMonitor->uDataPathResetTs - pHealthMonitor->uRecoveryStartTs;
+	} else {
+		uTimeMs = os_timeStampMs (pHealthMonitor->hOs) - pHealthMonitor->uRecoveryStartTs;
+	}
+
+	pStat->uSuccesses++;
+	pStat->uTotalMs += uTimeMs;
+	if (uTimeMs > pStat->uMaxMs) {
+		pStat->uMaxMs = uTimeMs;
+	}
+}
+
+
 /***********************************************************************
  *                        healthMonitor_printFailureEvents
  ***********************************************************************
@@ -394,11 +684,65 @@ void healthMonitor_printFailureEvents(TI_HANDLE hHealthMonitor)
 	WLAN_OS_REPORT(("Maximum number of commands in mailbox queue = %u\n", TWD_GetMaxNumberOfCommandsInQueue(pHealthMonitor->hTWD)));
 	WLAN_OS_REPORT(("Health Test Performed       = %d\n", pHealthMonitor->numOfHealthTests));
 	WLAN_OS_REPORT(("\n"));
+	WLAN_OS_REPORT(("-------------- STA Recovery Tiers Statistics ---------------\n"));
+	for (i = 0; i < MAX_RECOVERY_TIERS; i++) {
+		TRecoveryTierStat *pStat = &pHealthMonitor->aTierStat[i];
+
+		WLAN_OS_REPORT(("%16s: attempts=%u, successes=%u, avg time=%u ms, max time=%u ms\n",
+		                sRecoveryTiersNames[i], pStat->uAttempts, pStat->uSuccesses,
+		                (pStat->uSuccesses ? pStat->uTotalMs / pStat->uSuccesses : 0), pStat->uMaxMs));
+	}
+	WLAN_OS_REPORT(("Escalations to full recovery = %u\n", pHealthMonitor->uEscalations));
+	WLAN_OS_REPORT(("Data-path reset fault injection = %d\n", pHealthMonitor->bDataPathResetFail));
+	WLAN_OS_REPORT(("\n"));
 #endif
 #endif /* TI_DBG */
 }
 
 
+#ifdef TI_DBG
+/***********************************************************************
+ *                        healthMonitor_SetDataPathResetFail
+ ***********************************************************************
+DESCRIPTION:    Fault injection - when set, data-path reset verification fails,
+                so the escalation to full recovery can be tested.
+
+INPUT:      hHealthMonitor - health monitor handle
+            bFail          - TI_TRUE to fail data-path resets
+
+OUTPUT:
+
+RETURN:
+************************************************************************/
+void healthMonitor_SetDataPathResetFail (TI_HANDLE hHealthMonitor, TI_BOOL bFail)
+{
+	THealthMonitor *pHealthMonitor = (THealthMonitor*)hHealthMonitor;
+
+	pHealthMonitor->bDataPathResetFail = bFail;
+}
+
+
+/***********************************************************************
+ *                        healthMonitor_ResetRecoveryStats
+ ***********************************************************************
+DESCRIPTION:    Clear the recovery tiers statistics.
+
+INPUT:      hHealthMonitor - health monitor handle
+
+OUTPUT:
+
+RETURN:
+************************************************************************/
+void healthMonitor_ResetRecoveryStats (TI_HANDLE hHealthMonitor)
+{
+	THealthMonitor *pHealthMonitor = (THealthMonitor*)hHealthMonitor;
+
+	os_memoryZero (pHealthMonitor->hOs, pHealthMonitor->aTierStat, sizeof(pHealthMonitor->aTierStat));
+	pHealthMonitor->uEscalations = 0;
+}
+#endif /* TI_DBG */
+
+
 /***********************************************************************
  *                        healthMonitor_SetParam
  ***********************************************************************
@@ -58,6 +58,14 @@ typedef enum healthMonitorState_e {
 
 } healthMonitorState_e;
 
+/* Recovery tiers, from the lightest to the heaviest */
+typedef enum {
+	RECOVERY_TIER_DATA_PATH,	/* Host Tx data-path reset, the FW keeps running */
+	RECOVERY_TIER_FULL,			/* Driver stop, FW reload and re-init (drvMain_Recovery) */
+	MAX_RECOVERY_TIERS
+
+} ERecoveryTier;
+
 
 /* Public Functions Prototypes */
 TI_HANDLE healthMonitor_create         (TI_HANDLE hOs);
@@ -68,6 +76,11 @@ void healthMonitor_PerformTest         (TI_HANDLE hHealthMonitor, TI_BOOL bTwdIn
 void healthMonitor_setState            (TI_HANDLE hHealthMonitor, healthMonitorState_e state);
 void healthMonitor_sendFailureEvent    (TI_HANDLE hHealthMonitor, EFailureEvent failureEvent);
 void healthMonitor_printFailureEvents  (TI_HANDLE hHealthMonitor);
+void healthMonitor_RecoveryComplete    (TI_HANDLE hHealthMonitor, TI_BOOL bSuccess);
+#ifdef TI_DBG
+void healthMonitor_SetDataPathResetFail (TI_HANDLE hHealthMonitor, TI_BOOL bFail);
+void healthMonitor_ResetRecoveryStats  (TI_HANDLE hHealthMonitor);
+#endif
 TI_STATUS healthMonitor_SetParam       (TI_HANDLE hHealthMonitor, paramInfo_t *pParam);
 TI_STATUS healthMonitor_GetParam       (TI_HANDLE hHealthMonitor, paramInfo_t *pParam);
 
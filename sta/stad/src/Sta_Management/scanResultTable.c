@@ -135,6 +135,10 @@ typedef struct {
 	TI_UINT32       uSraThreshold;          /**< Rssi threshold for frame filtering */
 	TI_BOOL         bStable;                /**< table status (updating / stable) */
 	EScanResultTableClear  eClearTable;     /** inicates if table should be cleared at scan */
+	TI_UINT32       uUpdateCount;           /**< incremented whenever sites are inserted, updated or removed */
+	TI_UINT32       uLayoutCount;           /**< incremented whenever sites are removed or moved in the table */
+	TI_UINT32       *pDirtySites;           /**< indexes of the sites inserted or updated since SME last checked them */
+	TI_UINT32       uDirtySitesNum;         /**< number of indexes in pDirtySites */
 } TScanResultTable;
 
 static TSiteEntry  *scanResultTbale_AllocateNewEntry (TI_HANDLE hScanResultTable);
@@ -143,6 +147,8 @@ static void         scanResultTable_updateRates(TI_HANDLE hScanResultTable, TSit
 static void         scanResultTable_UpdateWSCParams (TSiteEntry *pSite, TScanFrameInfo *pFrame);
 static TI_STATUS    scanResultTable_CheckRxSignalValidity(TScanResultTable *pScanResultTable, siteEntry_t *pSite, TI_INT8 rxLevel, TI_UINT8 channel);
 static void         scanResultTable_RemoveEntry(TI_HANDLE hScanResultTable, TI_UINT32 uIndex);
+static void         scanResultTable_MarkDirty (TScanResultTable *pScanResultTable, TSiteEntry *pSite);
+static void         scanResultTable_LayoutChanged (TScanResultTable *pScanResultTable);
 
 
 /**
@@ -179,6 +185,16 @@ TI_HANDLE scanResultTable_Create (TI_HANDLE hOS, TI_UINT32 uEntriesNumber)
 	}
 	pScanResultTable->uEntriesNumber = uEntriesNumber;
 	os_memoryZero(pScanResultTable->hOS, pScanResultTable->pTable, sizeof(TSiteEntry) * uEntriesNumber);
+
+	/* allocate memory for the changed sites list (a site is listed at most once) */
+	pScanResultTable->pDirtySites =
+	    (TI_UINT32 *)os_memoryAlloc (pScanResultTable->hOS, sizeof (TI_UINT32) * uEntriesNumber);
+	if (NULL == pScanResultTable->pDirtySites) {
+		os_memoryFree(pScanResultTable->hOS, pScanResultTable->pTable, sizeof (TSiteEntry) * uEntriesNumber);
+		os_memoryFree(pScanResultTable->hOS, pScanResultTable, sizeof(TScanResultTable));
+		return NULL;
+	}
+	pScanResultTable->uDirtySitesNum = 0;
 	return (TI_HANDLE)pScanResultTable;
 }
 
@@ -208,6 +224,9 @@ void        scanResultTable_Init (TI_HANDLE hScanResultTable, TStadHandlesList *
 	pScanResultTable->bStable = TI_TRUE;
 	pScanResultTable->uIterator = 0;
 	pScanResultTable->eClearTable = eClearTable;
+	pScanResultTable->uUpdateCount = 0;
+	pScanResultTable->uLayoutCount = 0;
+	pScanResultTable->uDirtySitesNum = 0;
 	/* default Scan Result Aging threshold is 60 second */
 	pScanResultTable->uSraThreshold = 60;
 }
@@ -234,6 +253,12 @@ void        scanResultTable_Destroy (TI_HANDLE hScanResultTable)
 		               sizeof (TSiteEntry) * pScanResultTable->uEntriesNumber);
 	}
 
+	/* free the changed sites list memory */
+	if (NULL != pScanResultTable->pDirtySites) {
+		os_memoryFree (pScanResultTable->hOS, (void*)pScanResultTable->pDirtySites,
+		               sizeof (TI_UINT32) * pScanResultTable->uEntriesNumber);
+	}
+
 	/* free scan result table object memeory */
 	os_memoryFree (pScanResultTable->hOS, (void*)hScanResultTable, sizeof (TScanResultTable));
 }
@@ -265,14 +290,41 @@ void scanResultTable_SetSraThreshold(TI_HANDLE hScanResultTable, TI_UINT32 uSraT
  * \param  pBssid - a pointer to the site BSSID
  * \param  pframe - a pointer to the received frame data
  * \return TI_OK if entry was inseretd or updated successfuly, TI_NOK if table is full
- * \sa     scanResultTable_SetStableState
+ * \sa     scanResultTable_SetStableState, scanResultTable_UpdateEntryEx
  */
 TI_STATUS scanResultTable_UpdateEntry (TI_HANDLE hScanResultTable, TMacAddr *pBssid, TScanFrameInfo* pFrame)
+{
+	return scanResultTable_UpdateEntryEx (hScanResultTable, pBssid, pFrame, NULL, NULL);
+}
+
+/**
+ * \fn     scanResultTable_UpdateEntryEx
+ * \brief  Update or insert a site data, and return the changed entry.
+ *
+ * Same as scanResultTable_UpdateEntry, but also returns the entry that was inserted or updated,
+ * so the caller can report the change without searching the table again.
+ *
+ * \param  hScanResultTable - handle to the scan result table object
+ * \param  pBssid - a pointer to the site BSSID
+ * \param  pframe - a pointer to the received frame data
+ * \param  ppSite - optional, returns the changed entry, or NULL if no entry was changed
+ * \param  pbNewEntry - optional, returns TI_TRUE if the entry was inserted by this frame
+ * \return TI_OK if entry was inseretd or updated successfuly, TI_NOK if table is full
+ * \sa     scanResultTable_UpdateEntry
+ */
+TI_STATUS scanResultTable_UpdateEntryEx (TI_HANDLE hScanResultTable, TMacAddr *pBssid, TScanFrameInfo* pFrame,
+        TSiteEntry **ppSite, TI_BOOL *pbNewEntry)
 {
 	TScanResultTable    *pScanResultTable = (TScanResultTable*)hScanResultTable;
 	TSiteEntry          *pSite;
 	TSsid               tTempSsid;
 
+	if (NULL != ppSite) {
+		*ppSite = NULL;
+	}
+	if (NULL != pbNewEntry) {
+		*pbNewEntry = TI_FALSE;
+	}
 
 	/* check if the table is in stable state */
 	if (TI_TRUE == pScanResultTable->bStable) {
@@ -281,7 +333,9 @@ TI_STATUS scanResultTable_UpdateEntry (TI_HANDLE hScanResultTable, TMacAddr *pBs
 
 		if (SCAN_RESULT_TABLE_CLEAR == pScanResultTable->eClearTable) {
 			/* clear table contents */
+			scanResultTable_LayoutChanged (pScanResultTable);
 			pScanResultTable->uCurrentSiteNumber = 0;
+			pScanResultTable->uUpdateCount++;
 		}
 	}
 
@@ -308,6 +362,9 @@ TI_STATUS scanResultTable_UpdateEntry (TI_HANDLE hScanResultTable, TMacAddr *pBs
 		if (TI_NOK != scanResultTable_CheckRxSignalValidity(pScanResultTable, pSite, pFrame->rssi, pFrame->channel)) {
 			/* BSSID exists: update its data */
 			scanResultTable_UpdateSiteData (hScanResultTable, pSite, pFrame);
+			if (NULL != ppSite) {
+				*ppSite = pSite;
+			}
 		}
 	} else {
 		/* BSSID doesn't exist: allocate a new entry for it */
@@ -320,6 +377,12 @@ TI_STATUS scanResultTable_UpdateEntry (TI_HANDLE hScanResultTable, TMacAddr *pBs
 		scanResultTable_UpdateSiteData (hScanResultTable,
 		                                pSite,
 		                                pFrame);
+		if (NULL != ppSite) {
+			*ppSite = pSite;
+		}
+		if (NULL != pbNewEntry) {
+			*pbNewEntry = TI_TRUE;
+		}
 	}
 
 	return TI_OK;
@@ -345,7 +408,9 @@ void    scanResultTable_SetStableState (TI_HANDLE hScanResultTable)
 	/* if also asked to clear the table, if it is at Stable mode means that no results were received, clear it! */
 	if ((TI_TRUE == pScanResultTable->bStable) && (SCAN_RESULT_TABLE_CLEAR == pScanResultTable->eClearTable)) {
 
+		scanResultTable_LayoutChanged (pScanResultTable);
 		pScanResultTable->uCurrentSiteNumber = 0;
+		pScanResultTable->uUpdateCount++;
 	}
 
 	/* set stable state */
@@ -505,6 +570,9 @@ void   scanResultTable_RemoveEntry(TI_HANDLE hScanResultTable, TI_UINT32 uIndex)
 		return;
 	}
 
+	/* the last entry is moved, so listed indexes are no longer valid */
+	scanResultTable_LayoutChanged (pScanResultTable);
+
 	/* if uIndex is not the last entry, then copy the last entry in the table to the uIndex entry */
 	if (uIndex < (pScanResultTable->uCurrentSiteNumber - 1)) {
 		os_memoryCopy(pScanResultTable->hOS,
@@ -517,6 +585,7 @@ void   scanResultTable_RemoveEntry(TI_HANDLE hScanResultTable, TI_UINT32 uIndex)
 	os_memoryZero(pScanResultTable->hOS, &(pScanResultTable->pTable[pScanResultTable->uCurrentSiteNumber - 1]), sizeof(TSiteEntry));
 	/* decrease the current table size */
 	pScanResultTable->uCurrentSiteNumber--;
+	pScanResultTable->uUpdateCount++;
 }
 
 /**
@@ -538,6 +607,9 @@ TSiteEntry *scanResultTbale_AllocateNewEntry (TI_HANDLE hScanResultTable)
 		/* replace hidden SSID entry with the new result */
 		if (scanResultTable_FindHidden(pScanResultTable, &uHiddenSsidIndex) == TI_OK) {
 
+			/* the entry is replaced by another site */
+			scanResultTable_LayoutChanged (pScanResultTable);
+
 			/* Nullify new site data */
 			os_memoryZero(pScanResultTable->hOS, &(pScanResultTable->pTable[ uHiddenSsidIndex ]), sizeof (TSiteEntry));
 
@@ -590,6 +662,10 @@ void scanResultTable_UpdateSiteData (TI_HANDLE hScanResultTable, TSiteEntry *pSi
 
 	/* Since a new scan was initiated the entry can be selected again */
 	pSite->bConsideredForSelect = TI_FALSE;
+	/* and its cached select verdict is no longer valid */
+	pSite->uSelectProfileGen = 0;
+	scanResultTable_MarkDirty (pScanResultTable, pSite);
+	pScanResultTable->uUpdateCount++;
 	UPDATE_LOCAL_TIMESTAMP(pSite, pScanResultTable->hOS);
 
 	UPDATE_BSSID (pSite, pFrame);
@@ -822,6 +898,134 @@ TI_UINT32 scanResultTable_GetNumOfBSSIDInTheList (TI_HANDLE hScanResultTable)
 	return ((TScanResultTable*)hScanResultTable)->uCurrentSiteNumber;
 }
 
+/**
+ * \fn     scanResultTable_GetUpdateCount
+ * \brief  Returns the table update count
+ *
+ * Returns a counter which is incremented whenever sites are inserted, updated or removed,
+ * so users keeping references to table entries can tell whether they are still valid.
+ *
+ * \param  hScanResultTable - handle to the scan result table object
+ * \return The table update count
+ */
+TI_UINT32 scanResultTable_GetUpdateCount (TI_HANDLE hScanResultTable)
+{
+	return ((TScanResultTable*)hScanResultTable)->uUpdateCount;
+}
+
+/**
+ * \fn     scanResultTable_GetLayoutCount
+ * \brief  Returns the table layout count
+ *
+ * Returns a counter which is incremented whenever sites are removed or moved in the table,
+ * or the table is cleared. While it doesn't change, pointers to table entries remain valid,
+ * and sites changes are reported through scanResultTable_GetDirtySite.
+ *
+ * \param  hScanResultTable - handle to the scan result table object
+ * \return The table layout count
+ * \sa     scanResultTable_GetDirtySite
+ */
+TI_UINT32 scanResultTable_GetLayoutCount (TI_HANDLE hScanResultTable)
+{
+	return ((TScanResultTable*)hScanResultTable)->uLayoutCount;
+}
+
+/**
+ * \fn     scanResultTable_GetDirtySite
+ * \brief  Retrieves a site inserted or updated since it was last retrieved
+ *
+ * Retrieves a site that was inserted or updated since it was last retrieved, and removes it from
+ * the changed sites list. The list is emptied when the table layout count changes.
+ *
+ * \param  hScanResultTable - handle to the scan result table object
+ * \return A pointer to the changed site, NULL if no site changed
+ * \sa     scanResultTable_GetLayoutCount
+ */
+TSiteEntry *scanResultTable_GetDirtySite (TI_HANDLE hScanResultTable)
+{
+	TScanResultTable    *pScanResultTable = (TScanResultTable*)hScanResultTable;
+	TSiteEntry          *pSite;
+
+	if (0 == pScanResultTable->uDirtySitesNum) {
+		return NULL;
+	}
+
+	pScanResultTable->uDirtySitesNum--;
+	pSite = &(pScanResultTable->pTable[ pScanResultTable->pDirtySites[ pScanResultTable->uDirtySitesNum ] ]);
+	pSite->bSelectDirty = TI_FALSE;
+	return pSite;
+}
+
+/**
+ * \fn     scanResultTable_MarkDirty
+ * \brief  Adds a site to the changed sites list
+ *
+ * Adds a site to the changed sites list, unless it is already listed.
+ *
+ * \param  pScanResultTable - the scan result table object
+ * \param  pSite - the site that was inserted or updated
+ * \return None
+ * \sa     scanResultTable_GetDirtySite
+ */
+static void scanResultTable_MarkDirty (TScanResultTable *pScanResultTable, TSiteEntry *pSite)
+{
+	if (TI_TRUE == pSite->bSelectDirty) {
+		return;
+	}
+
+	/* a site is listed at most once, so the list can't overflow, but be safe */
+	if (pScanResultTable->uDirtySitesNum >= pScanResultTable->uEntriesNumber) {
+		scanResultTable_LayoutChanged (pScanResultTable);
+		return;
+	}
+
+	pSite->bSelectDirty = TI_TRUE;
+	pScanResultTable->pDirtySites[ pScanResultTable->uDirtySitesNum ] = (TI_UINT32)(pSite - pScanResultTable->pTable);
+	pScanResultTable->uDirtySitesNum++;
+}
+
+/**
+ * \fn     scanResultTable_LayoutChanged
+ * \brief  Indicates that table entries are about to be removed or moved
+ *
+ * Empties the changed sites list, since the listed indexes will no longer be valid, and increments
+ * the layout count so users keeping pointers to table entries rebuild their references.
+ *
+ * \param  pScanResultTable - the scan result table object
+ * \return None
+ * \sa     scanResultTable_GetLayoutCount
+ */
+static void scanResultTable_LayoutChanged (TScanResultTable *pScanResultTable)
+{
+	TI_UINT32           uIndex;
+
+	for (uIndex = 0; uIndex < pScanResultTable->uDirtySitesNum; uIndex++) {
+		pScanResultTable->pTable[ pScanResultTable->pDirtySites[ uIndex ] ].bSelectDirty = TI_FALSE;
+	}
+	pScanResultTable->uDirtySitesNum = 0;
+	pScanResultTable->uLayoutCount++;
+}
+
+#ifdef TI_DBG
+/**
+ * \fn     scanResultTable_AllocateDbgEntry
+ * \brief  Allocates an empty entry (debug)
+ *
+ * Allocates an empty entry, to be filled directly by debug code building synthetic tables.
+ *
+ * \param  hScanResultTable - handle to the scan result table object
+ * \return Pointer to the site entry (NULL if the table is full)
+ */
+TSiteEntry *scanResultTable_AllocateDbgEntry (TI_HANDLE hScanResultTable)
+{
+	TScanResultTable    *pScanResultTable = (TScanResultTable*)hScanResultTable;
+
+	scanResultTable_LayoutChanged (pScanResultTable);
+	pScanResultTable->uUpdateCount++;
+	return scanResultTbale_AllocateNewEntry (hScanResultTable);
+}
+#endif /* TI_DBG */
+
 /**
  * \fn     scanResultTable_CalculateBssidListSize
  * \brief  Calculates the size required for BSSID list storage
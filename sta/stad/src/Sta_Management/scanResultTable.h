@@ -63,6 +63,10 @@ typedef struct {
 	/* end of fields  are used for entry management at the SiteMng */
 
 	TI_BOOL                    bConsideredForSelect;
+	TI_UINT32                  uSelectProfileGen;   /* SME profile generation of bSelectMatch, 0 if not evaluated */
+	TI_BOOL                    bSelectMatch;        /* cached SME select match verdict */
+	TI_BOOL                    bSelectDirty;        /* the site is listed as changed since SME last checked it */
+	TI_UINT32                  uCandHeapIndex;      /* SME candidate heap index, valid only if that heap entry is this site */
 	ERadioBand                 eBand;
 	TI_UINT8                   tsfTimeStamp[ TIME_STAMP_LEN ];
 
@@ -148,18 +152,26 @@ TI_HANDLE   scanResultTable_Create (TI_HANDLE hOS, TI_UINT32 uEntriesNumber);
 void        scanResultTable_Init (TI_HANDLE hScanResultTable, TStadHandlesList *pStadHandles, EScanResultTableClear eClearTable);
 void        scanResultTable_Destroy (TI_HANDLE hScanResultTable);
 TI_STATUS   scanResultTable_UpdateEntry (TI_HANDLE hScanResultTable, TMacAddr *pBssid, TScanFrameInfo* pFrame);
+TI_STATUS   scanResultTable_UpdateEntryEx (TI_HANDLE hScanResultTable, TMacAddr *pBssid, TScanFrameInfo* pFrame,
+        TSiteEntry **ppSite, TI_BOOL *pbNewEntry);
 void        scanResultTable_SetStableState (TI_HANDLE hScanResultTable);
 TSiteEntry  *scanResultTable_GetFirst (TI_HANDLE hScanResultTable);
 TSiteEntry  *scanResultTable_GetNext (TI_HANDLE hScanResultTable);
 TSiteEntry  *scanResultTable_GetBySsidBssidPair (TI_HANDLE hScanResultTable, TSsid *pSsid, TMacAddr *pBssid);
 TI_UINT32   scanResultTable_CalculateBssidListSize (TI_HANDLE hScanResultTable, TI_BOOL bAllVarIes);
 TI_UINT32 scanResultTable_GetNumOfBSSIDInTheList (TI_HANDLE hScanResultTable);
+TI_UINT32   scanResultTable_GetUpdateCount (TI_HANDLE hScanResultTable);
+TI_UINT32   scanResultTable_GetLayoutCount (TI_HANDLE hScanResultTable);
+TSiteEntry  *scanResultTable_GetDirtySite (TI_HANDLE hScanResultTable);
 TI_STATUS   scanResultTable_GetBssidList (TI_HANDLE hScanResultTable, OS_802_11_BSSID_LIST_EX *pBssidList,
         TI_UINT32 *pLength, TI_BOOL bAllVarIes);
 TI_STATUS scanResultTable_GetBssidSupportedRatesList (TI_HANDLE hScanResultTable, OS_802_11_N_RATES *pRateList, TI_UINT32 *pLength);
 
 void        scanResultTable_PerformAging(TI_HANDLE hScanResultTable);
 void        scanResultTable_SetSraThreshold(TI_HANDLE hScanResultTable, TI_UINT32 uSraThreshold);
+#ifdef TI_DBG
+TSiteEntry  *scanResultTable_AllocateDbgEntry (TI_HANDLE hScanResultTable);
+#endif
 
 #endif /* __SCAN_RESULT_TABLE_H__ */
 
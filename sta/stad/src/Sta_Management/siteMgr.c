@@ -224,6 +224,8 @@ static TI_UINT16 incrementTxSessionCount(siteMgr_t *pSiteMgr);
 static void siteMgr_TxPowerAdaptation(TI_HANDLE hSiteMgr, RssiEventDir_e highLowEdge);
 static void siteMgr_TxPowerLowThreshold(TI_HANDLE hSiteMgr, TI_UINT8 *data, TI_UINT8 dataLength);
 static void siteMgr_TxPowerHighThreshold(TI_HANDLE hSiteMgr, TI_UINT8 *data, TI_UINT8 dataLength);
+static void siteMgr_getTiWlanCounters(siteMgr_t *pSiteMgr, paramInfo_t *pParam);
+static TI_STATUS siteMgr_getStatsSnapshot(siteMgr_t *pSiteMgr, paramInfo_t *pParam);
 
 /************************************************************************
 *                        siteMgr_setTemporaryTxPower                    *
@@ -871,6 +873,11 @@ TI_STATUS siteMgr_setParam(TI_HANDLE        hSiteMgr,
 			return NO_SITE_SELECTED_YET;
 		}
 		pPrimarySite->channel = pParam->content.siteMgrCurrentChannel;
+
+		/* the serving channel was switched (the caller's parameter is reused for the notification) */
+		pParam->paramType = REGULATORY_DOMAIN_SERVING_CHANNEL_CHANGED_PARAM;
+		regulatoryDomain_setParam(pSiteMgr->hRegulatoryDomain, pParam);
+		pParam->paramType = SITE_MGR_CURRENT_CHANNEL_PARAM;
 		break;
 
 	case SITE_MGR_CURRENT_SIGNAL_PARAM:
@@ -918,6 +925,172 @@ TI_STATUS siteMgr_setParam(TI_HANDLE        hSiteMgr,
 	return TI_OK;
 }
 
+/***********************************************************************
+ *                        siteMgr_getTiWlanCounters
+ ***********************************************************************
+DESCRIPTION: Collect the TI WLAN counters from the Rx data, TWD, auth,
+             MLME and assoc modules into pParam->content.siteMgrTiWlanCounters.
+             Note that pParam->paramType is overwritten.
+
+INPUT:      pSiteMgr    -   site mgr handle.
+            pParam      -   Pointer to the parameter
+
+OUTPUT:
+
+RETURN:
+
+************************************************************************/
+static void siteMgr_getTiWlanCounters(siteMgr_t *pSiteMgr, paramInfo_t *pParam)
+{
+	TTwdParamInfo   tTwdParam;
+
+	pParam->paramType = RX_DATA_COUNTERS_PARAM;
+	rxData_getParam(pSiteMgr->hRxData, pParam);
+
+	tTwdParam.paramType = TWD_COUNTERS_PARAM_ID;
+	TWD_GetParam (pSiteMgr->hTWD, &tTwdParam);
+	pParam->content.siteMgrTiWlanCounters.RecvNoBuffer = tTwdParam.content.halCtrlCounters.RecvNoBuffer;
+	pParam->content.siteMgrTiWlanCounters.FragmentsRecv = tTwdParam.content.halCtrlCounters.FragmentsRecv;
+	pParam->content.siteMgrTiWlanCounters.FrameDuplicates = tTwdParam.content.halCtrlCounters.FrameDuplicates;
+	pParam->content.siteMgrTiWlanCounters.FcsErrors = tTwdParam.content.halCtrlCounters.FcsErrors;
+	pParam->content.siteMgrTiWlanCounters.RecvError = tTwdParam.content.halCtrlCounters.RecvError;
+
+	pParam->paramType = AUTH_COUNTERS_PARAM;
+	auth_getParam(pSiteMgr->hAuth, pParam);
+
+	pParam->paramType = MLME_BEACON_RECV;
+	mlme_getParam(pSiteMgr->hMlmeSm, pParam);
+
+	pParam->paramType = ASSOC_COUNTERS_PARAM;
+	assoc_getParam(pSiteMgr->hAssoc, pParam);
+	pParam->content.siteMgrTiWlanCounters.BeaconsXmit = pSiteMgr->beaconSentCount;
+}
+
+/***********************************************************************
+ *                        siteMgr_addStatsSection
+ ***********************************************************************
+DESCRIPTION: Append a section header to the statistics snapshot.
+
+INPUT:      pHdr        -   The snapshot header.
+            ppPos       -   The current write position (advanced past the section).
+            uId         -   Section ID (EStatsSnapshotSection).
+            uNumCounters-   Number of counters in the section.
+
+OUTPUT:
+
+RETURN:     Pointer to the section counters (to be filled by the caller)
+
+************************************************************************/
+static TI_UINT32 *siteMgr_addStatsSection(TStatsSnapshotHdr *pHdr, TI_UINT8 **ppPos, TI_UINT16 uId, TI_UINT16 uNumCounters)
+{
+	TStatsSnapshotSection *pSection = (TStatsSnapshotSection *)*ppPos;
+
+	pSection->uId          = uId;
+	pSection->uNumCounters = uNumCounters;
+	*ppPos += sizeof(TStatsSnapshotSection) + uNumCounters * sizeof(TI_UINT32);
+	pHdr->uNumSections++;
+
+	return (TI_UINT32 *)(pSection + 1);
+}
+
+/***********************************************************************
+ *                        siteMgr_getStatsSnapshot
+ ***********************************************************************
+DESCRIPTION: Build the statistics snapshot blob (TStatsSnapshotHdr) in
+             pParam->content.pSiteMgrStatsSnapshot.
+             All counters are read in this single call (driver context),
+             so they are consistent with each other.
+
+INPUT:      pSiteMgr    -   site mgr handle.
+            pParam      -   Pointer to the parameter, paramLength holds the buffer length
+
+OUTPUT:     pParam->paramLength - the snapshot length (or the required length on failure)
+
+RETURN:     TI_OK on success, TI_NOK otherwise
+
+************************************************************************/
+static TI_STATUS siteMgr_getStatsSnapshot(siteMgr_t *pSiteMgr, paramInfo_t *pParam)
+{
+	TI_UINT8              *pBuf = pParam->content.pSiteMgrStatsSnapshot;
+	TStatsSnapshotHdr     *pHdr = (TStatsSnapshotHdr *)pBuf;
+	TI_UINT8              *pPos;
+	TI_UINT32             *pCounters;
+	paramInfo_t           *pCntParam;
+	const TTxDataCounters *pTxCounters;
+	TTwdXferStats          tXferStats;
+	TI_UINT32              uLen;
+	TI_UINT32              uAc;
+
+	uLen = sizeof(TStatsSnapshotHdr) + 4 * sizeof(TStatsSnapshotSection) +
+	       sizeof(TIWLN_COUNTERS) +
+	       (STATS_TX_NUM_COUNTERS + STATS_XFER_NUM_COUNTERS + STATS_POWER_NUM_COUNTERS) * sizeof(TI_UINT32);
+
+	if ((pBuf == NULL) || (pParam->paramLength < uLen)) {
+		pParam->paramLength = uLen;
+		return TI_NOK;
+	}
+
+	pCntParam = (paramInfo_t *)os_memoryAlloc(pSiteMgr->hOs, sizeof(paramInfo_t));
+	if (pCntParam == NULL) {
+		return TI_NOK;
+	}
+
+	os_memoryZero(pSiteMgr->hOs, pBuf, uLen);
+	pHdr->uMagic       = STATS_SNAPSHOT_MAGIC;
+	pHdr->uVersion     = STATS_SNAPSHOT_VERSION;
+	pHdr->uLength      = (TI_UINT16)uLen;
+	pHdr->uTimestampMs = os_timeStampMs(pSiteMgr->hOs);
+	pPos = pBuf + sizeof(TStatsSnapshotHdr);
+
+	/* WLAN counters - same as SITE_MGR_TI_WLAN_COUNTERS_PARAM */
+	pCounters = siteMgr_addStatsSection(pHdr, &pPos, STATS_SECTION_WLAN, sizeof(TIWLN_COUNTERS) / sizeof(TI_UINT32));
+	siteMgr_getTiWlanCounters(pSiteMgr, pCntParam);
+	os_memoryCopy(pSiteMgr->hOs, pCounters, &pCntParam->content.siteMgrTiWlanCounters, sizeof(TIWLN_COUNTERS));
+	os_memoryFree(pSiteMgr->hOs, pCntParam, sizeof(paramInfo_t));
+
+	/* Tx data counters, summed over all ACs */
+	pCounters = siteMgr_addStatsSection(pHdr, &pPos, STATS_SECTION_TX, STATS_TX_NUM_COUNTERS);
+	for (uAc = 0; uAc < MAX_NUM_OF_AC; uAc++) {
+		pTxCounters = txCtrlParams_GetTxCounters(pSiteMgr->hTxCtrl, uAc);
+		pCounters[STATS_TX_XMIT_OK]          += pTxCounters->XmitOk;
+		pCounters[STATS_TX_DIRECTED_BYTES]   += pTxCounters->DirectedBytesXmit;
+		pCounters[STATS_TX_DIRECTED_FRAMES]  += pTxCounters->DirectedFramesXmit;
+		pCounters[STATS_TX_MULTICAST_BYTES]  += pTxCounters->MulticastBytesXmit;
+		pCounters[STATS_TX_MULTICAST_FRAMES] += pTxCounters->MulticastFramesXmit;
+		pCounters[STATS_TX_BROADCAST_BYTES]  += pTxCounters->BroadcastBytesXmit;
+		pCounters[STATS_TX_BROADCAST_FRAMES] += pTxCounters->BroadcastFramesXmit;
+		pCounters[STATS_TX_RETRY_FAIL]       += pTxCounters->RetryFailCounter;
+		pCounters[STATS_TX_TIMEOUT]          += pTxCounters->TxTimeoutCounter;
+		pCounters[STATS_TX_NO_LINK]          += pTxCounters->NoLinkCounter;
+		pCounters[STATS_TX_OTHER_FAIL]       += pTxCounters->OtherFailCounter;
+		pCounters[STATS_TX_NUM_PACKETS]      += pTxCounters->NumPackets;
+		pCounters[STATS_TX_SUM_FW_DELAY_US]  += pTxCounters->SumFWDelayUs;
+		pCounters[STATS_TX_SUM_MAC_DELAY_US] += pTxCounters->SumMacDelayUs;
+	}
+
+	/* Bus transfer and FW interrupt counters */
+	pCounters = siteMgr_addStatsSection(pHdr, &pPos, STATS_SECTION_XFER, STATS_XFER_NUM_COUNTERS);
+	TWD_GetXferStats(pSiteMgr->hTWD, &tXferStats);
+	pCounters[STATS_XFER_FW_INTERRUPTS] = tXferStats.uFwInterrupts;
+	pCounters[STATS_XFER_RX_PACKETS]    = tXferStats.uRxPkts;
+	pCounters[STATS_XFER_RX_XFERS]      = tXferStats.uRxXfers;
+	pCounters[STATS_XFER_TX_PACKETS]    = tXferStats.uTxPkts;
+	pCounters[STATS_XFER_TX_XFERS]      = tXferStats.uTxXfers;
+
+	/* Power save state and transactions */
+	pCounters = siteMgr_addStatsSection(pHdr, &pPos, STATS_SECTION_POWER, STATS_POWER_NUM_COUNTERS);
+	pCounters[STATS_POWER_MODE]          = PowerMgr_getPowerMode(pSiteMgr->hPowerMgr);
+	pCounters[STATS_POWER_PS_STATUS]     = PowerMgr_getPsStatus(pSiteMgr->hPowerMgr);
+	pCounters[STATS_POWER_ENTER_PS_OK]   = PowerMgr_GetPsTransactionCount(pSiteMgr->hPowerMgr, ENTER_POWER_SAVE_SUCCESS);
+	pCounters[STATS_POWER_ENTER_PS_FAIL] = PowerMgr_GetPsTransactionCount(pSiteMgr->hPowerMgr, ENTER_POWER_SAVE_FAIL);
+	pCounters[STATS_POWER_EXIT_PS_OK]    = PowerMgr_GetPsTransactionCount(pSiteMgr->hPowerMgr, EXIT_POWER_SAVE_SUCCESS);
+	pCounters[STATS_POWER_EXIT_PS_FAIL]  = PowerMgr_GetPsTransactionCount(pSiteMgr->hPowerMgr, EXIT_POWER_SAVE_FAIL);
+
+	pParam->paramLength = uLen;
+
+	return TI_OK;
+}
+
 TI_STATUS siteMgr_getParamWSC(TI_HANDLE hSiteMgr, TIWLN_SIMPLE_CONFIG_MODE *wscParam)
 { /* SITE_MGR_SIMPLE_CONFIG_MODE: - Retrieving the WiFiSimpleConfig mode */
 	siteMgr_t       *pSiteMgr = (siteMgr_t *)hSiteMgr;
@@ -952,7 +1125,6 @@ TI_STATUS siteMgr_getParam(TI_HANDLE        hSiteMgr,
 	siteEntry_t     *pPrimarySite = pSiteMgr->pSitesMgmtParams->pPrimarySite;
 	TI_STATUS       status = TI_OK;
 	TI_UINT8           siteEntryIndex;
-	TTwdParamInfo   tTwdParam;
 
 	if (pSiteMgr == NULL) {
 		return TI_NOK;
@@ -1156,26 +1328,11 @@ TI_STATUS siteMgr_getParam(TI_HANDLE        hSiteMgr,
 
 
 	case SITE_MGR_TI_WLAN_COUNTERS_PARAM:
-		pParam->paramType = RX_DATA_COUNTERS_PARAM;
-		rxData_getParam(pSiteMgr->hRxData, pParam);
-
-		tTwdParam.paramType = TWD_COUNTERS_PARAM_ID;
-		TWD_GetParam (pSiteMgr->hTWD, &tTwdParam);
-		pParam->content.siteMgrTiWlanCounters.RecvNoBuffer = tTwdParam.content.halCtrlCounters.RecvNoBuffer;
-		pParam->content.siteMgrTiWlanCounters.FragmentsRecv = tTwdParam.content.halCtrlCounters.FragmentsRecv;
-		pParam->content.siteMgrTiWlanCounters.FrameDuplicates = tTwdParam.content.halCtrlCounters.FrameDuplicates;
-		pParam->content.siteMgrTiWlanCounters.FcsErrors = tTwdParam.content.halCtrlCounters.FcsErrors;
-		pParam->content.siteMgrTiWlanCounters.RecvError = tTwdParam.content.halCtrlCounters.RecvError;
-
-		pParam->paramType = AUTH_COUNTERS_PARAM;
-		auth_getParam(pSiteMgr->hAuth, pParam);
-
-		pParam->paramType = MLME_BEACON_RECV;
-		mlme_getParam(pSiteMgr->hMlmeSm, pParam);
-
-		pParam->paramType = ASSOC_COUNTERS_PARAM;
-		assoc_getParam(pSiteMgr->hAssoc, pParam);
-		pParam->content.siteMgrTiWlanCounters.BeaconsXmit = pSiteMgr->beaconSentCount;
+		siteMgr_getTiWlanCounters(pSiteMgr, pParam);
+		break;
+
+	case SITE_MGR_STATS_SNAPSHOT_PARAM:
+		status = siteMgr_getStatsSnapshot(pSiteMgr, pParam);
 		break;
 
 	case SITE_MGR_FIRMWARE_VERSION_PARAM: {
@@ -3462,6 +3619,38 @@ TI_STATUS siteMgr_saveBeaconBuffer(TI_HANDLE hSiteMgr, TMacAddr *bssid, TI_UINT8
 	return TI_OK;
 }
 
+/***********************************************************************
+ *                        siteMgr_updateBeaconTsf
+ ***********************************************************************
+DESCRIPTION: Update only the timing of a site from a beacon whose other
+             content is known to be unchanged (see currBSS_beaconReceivedCallb).
+
+INPUT:      hSiteMgr    -   site mgr handle.
+            bssid       -   BSSID received
+            pFrameInfo  -   Frame content after the parsing
+
+OUTPUT:
+
+RETURN:     TI_OK on success, TI_NOK if the site is not in the site table
+
+************************************************************************/
+TI_STATUS siteMgr_updateBeaconTsf(TI_HANDLE hSiteMgr, TMacAddr *bssid, mlmeFrameInfo_t *pFrameInfo)
+{
+	siteEntry_t *pSite;
+	siteMgr_t   *pSiteMgr = (siteMgr_t *)hSiteMgr;
+
+	pSite = findSiteEntry(pSiteMgr, bssid);
+	if (pSite == NULL) {
+		return TI_NOK;
+	}
+
+	UPDATE_LOCAL_TIME_STAMP(pSiteMgr, pSite, pFrameInfo);
+	UPDATE_BEACON_RECV(pSite);
+	UPDATE_BEACON_TIMESTAMP(pSiteMgr, pSite, pFrameInfo);
+
+	return TI_OK;
+}
+
 void siteMgr_IsERP_Needed(TI_HANDLE hSiteMgr,TI_BOOL *useProtection,TI_BOOL *NonErpPresent,TI_BOOL *barkerPreambleType)
 {
 	siteMgr_t       *pSiteMgr = (siteMgr_t*)hSiteMgr;
@@ -249,6 +249,26 @@ typedef enum {
 																									* GET Bit: ON	\n
 																									* SET Bit: OFF	\n
 																									*/
+	DRIVER_BATCH_PARAM                          =	SET_BIT | GET_BIT | DRIVER_MODULE_PARAM | 0x05, /**< Driver Batch Parameter (Driver General Set/Get Command): \n
+																									* Used for executing an array of ti_private_cmd_batch_entry_t Commands in one driver task pass,\n
+																									* returning a status per entry. Entries may not be Async or Driver Module Commands\n
+																									* Parameter Number:	0x05\n
+																									* Module Number: Driver Module Number \n
+																									* Async Bit: OFF	\n
+																									* Allocate Bit: OFF	\n
+																									* GET Bit: ON	\n
+																									* SET Bit: ON	\n
+																									*/
+	DRIVER_INIT_TABLE_PARAM                     =	          GET_BIT | DRIVER_MODULE_PARAM | 0x06, /**< Driver Init Table Parameter (Driver General Get Command): \n
+																									* Used for compiling the loaded ini-file to an init table blob (TInitTableBlobHdr, TInitTable image and ini-file text).\n
+																									* Allowed only before the driver is started. Done Sync with no memory allocation\n
+																									* Parameter Number:	0x06\n
+																									* Module Number: Driver Module Number \n
+																									* Async Bit: OFF	\n
+																									* Allocate Bit: OFF	\n
+																									* GET Bit: ON	\n
+																									* SET Bit: OFF	\n
+																									*/
 
 	/* Site manager section */
 	SITE_MGR_DESIRED_CHANNEL_PARAM				=	SET_BIT | GET_BIT | SITE_MGR_MODULE_PARAM | 0x01,	/**< Site Manager Desired Channel Parameter (Site Manager Module Set/Get Command):\n
@@ -460,6 +480,16 @@ typedef enum {
 																										* GET Bit: ON	\n
 																										* SET Bit: OFF	\n
 																										*/
+	SITE_MGR_STATS_SNAPSHOT_PARAM				=             GET_BIT | SITE_MGR_MODULE_PARAM | 0x44 | ALLOC_NEEDED_PARAM,	/**< Site Manager Statistics Snapshot Parameter (Site Manager Module Get Command): \n
+																										* Used for Getting a versioned binary snapshot of the Rx, Tx, bus transfer and power counters (TStatsSnapshotHdr)\n
+																										* Done Sync with memory allocation (buffer of up to STATS_SNAPSHOT_MAX_LEN bytes)\n
+																										* Parameter Number:	0x44	\n
+																										* Module Number: Site Manager Module Number \n
+																										* Async Bit: OFF	\n
+																										* Allocate Bit: ON	\n
+																										* GET Bit: ON	\n
+																										* SET Bit: OFF	\n
+																										*/
 
 	/* CTRL data section */
 	CTRL_DATA_CURRENT_BSS_TYPE_PARAM			=	SET_BIT | GET_BIT | CTRL_DATA_MODULE_PARAM | 0x04,	/**< Control Data Primary BSS Type Parameter (Control Data Module Set/Get Command): \n
@@ -696,6 +726,16 @@ typedef enum {
 																														* GET Bit: OFF	\n
 																														* SET Bit: ON	\n
 																														*/
+	SCAN_CNCN_BSSID_LIST_GENERATION_PARAM       =   GET_BIT |           SCAN_CNCN_PARAM | 0x0C,							/**< Scan Concentrator BSSID List Generation Parameter (Scan Concentrator Module Get Command): \n
+																														* Used for retrieving the scan result table generation, which changes whenever the BSSID list changes\n
+																														* Done Sync with no memory allocation\n
+																														* Parameter Number:	0x0C	\n
+																														* Module Number: Scan Concentrator Module Number \n
+																														* Async Bit: OFF	\n
+																														* Allocate Bit: OFF	\n
+																														* GET Bit: ON	\n
+																														* SET Bit: OFF	\n
+																														*/
 
 	/* Scan Manager module */
 	SCAN_MNGR_SET_CONFIGURATION                 =	SET_BIT |           SCAN_MNGR_PARAM | 0x01 | ALLOC_NEEDED_PARAM,	/**< Scan Manager Set Configuration Parameter (Scan Manager Module Set Command): \n
@@ -1377,6 +1417,17 @@ typedef enum {
 																									* GET Bit: ON	\n
 																									* SET Bit: ON	\n
 																									*/
+	REPORT_TRACE_POINT_PARAM                    =   SET_BIT | REPORT_MODULE_PARAM | 0x08,	/**< Report Trace Point Parameter (Report Module Set Command): \n
+																									* Used for enabling or disabling a single report site (file ID and line, or all the sites of a file)\n
+																									* regardless of the files and severities tables, or for removing such an override\n
+																									* Done Sync with no memory allocation\n
+																									* Parameter Number:	0x08	\n
+																									* Module Number: Report Module Number \n
+																									* Async Bit: OFF	\n
+																									* Allocate Bit: OFF	\n
+																									* GET Bit: OFF	\n
+																									* SET Bit: ON	\n
+																									*/
 
 
 	/* TX data section */
@@ -1463,6 +1514,26 @@ typedef enum {
 																															* GET Bit: ON	\n
 																															* SET Bit: OFF	\n
 																															*/
+	RX_DATA_ADD_RX_DATA_FILTER_RULE            	=   SET_BIT           | RX_DATA_MODULE_PARAM | 0x0A,						/**< RX Data Add Filter Rule Parameter (RX Data Module Set Command): \n
+																															* Used for adding a host RX Data Filter Rule (TRxDataFilterRule), offloaded to FW when possible\n
+																															* Done Sync with no memory allocation\n
+																															* Parameter Number:	0x0A	\n
+																															* Module Number: RX Data Module Number \n
+																															* Async Bit: OFF	\n
+																															* Allocate Bit: OFF	\n
+																															* GET Bit: OFF	\n
+																															* SET Bit: ON	\n
+																															*/
+	RX_DATA_REMOVE_RX_DATA_FILTER_RULE         	=   SET_BIT           | RX_DATA_MODULE_PARAM | 0x0B,						/**< RX Data Remove Filter Rule Parameter (RX Data Module Set Command): \n
+																															* Used for removing a host RX Data Filter Rule (TRxDataFilterRule)\n
+																															* Done Sync with no memory allocation\n
+																															* Parameter Number:	0x0B	\n
+																															* Module Number: RX Data Module Number \n
+																															* Async Bit: OFF	\n
+																															* Allocate Bit: OFF	\n
+																															* GET Bit: OFF	\n
+																															* SET Bit: ON	\n
+																															*/
 
 
 	/* measurement section */
@@ -41,96 +41,120 @@
 #include "tidef.h"
 #include "rate.h"
 
-ERate rate_NetToDrv (TI_UINT32 rate)
-{
-	switch (rate) {
-	case NET_RATE_1M:
-	case NET_RATE_1M_BASIC:
-		return DRV_RATE_1M;
-
-	case NET_RATE_2M:
-	case NET_RATE_2M_BASIC:
-		return DRV_RATE_2M;
-
-	case NET_RATE_5_5M:
-	case NET_RATE_5_5M_BASIC:
-		return DRV_RATE_5_5M;
-
-	case NET_RATE_11M:
-	case NET_RATE_11M_BASIC:
-		return DRV_RATE_11M;
-
-	case NET_RATE_22M:
-	case NET_RATE_22M_BASIC:
-		return DRV_RATE_22M;
-
-	case NET_RATE_6M:
-	case NET_RATE_6M_BASIC:
-		return DRV_RATE_6M;
-
-	case NET_RATE_9M:
-	case NET_RATE_9M_BASIC:
-		return DRV_RATE_9M;
-
-	case NET_RATE_12M:
-	case NET_RATE_12M_BASIC:
-		return DRV_RATE_12M;
-
-	case NET_RATE_18M:
-	case NET_RATE_18M_BASIC:
-		return DRV_RATE_18M;
-
-	case NET_RATE_24M:
-	case NET_RATE_24M_BASIC:
-		return DRV_RATE_24M;
-
-	case NET_RATE_36M:
-	case NET_RATE_36M_BASIC:
-		return DRV_RATE_36M;
-
-	case NET_RATE_48M:
-	case NET_RATE_48M_BASIC:
-		return DRV_RATE_48M;
-
-	case NET_RATE_54M:
-	case NET_RATE_54M_BASIC:
-		return DRV_RATE_54M;
-
-	case NET_RATE_MCS0:
-	case NET_RATE_MCS0_BASIC:
-		return DRV_RATE_MCS_0;
-
-	case NET_RATE_MCS1:
-	case NET_RATE_MCS1_BASIC:
-		return DRV_RATE_MCS_1;
-
-	case NET_RATE_MCS2:
-	case NET_RATE_MCS2_BASIC:
-		return DRV_RATE_MCS_2;
-
-	case NET_RATE_MCS3:
-	case NET_RATE_MCS3_BASIC:
-		return DRV_RATE_MCS_3;
+/*
+ * Rate translation tables - built by the compiler from the rate enums, so the conversions
+ *   on the association, rate policy and Rx paths are plain lookups.
+ */
 
-	case NET_RATE_MCS4:
-	case NET_RATE_MCS4_BASIC:
-		return DRV_RATE_MCS_4;
+/* All the driver rate bitmap bits (1M - MCS7) */
+#define RATE_DRV_BITMAP_ALL     (RATE_TO_MASK(DRV_RATE_MAX + 1) - 1)
 
-	case NET_RATE_MCS5:
-	case NET_RATE_MCS5_BASIC:
-		return DRV_RATE_MCS_5;
+/* Index of the highest set bit of a non zero bitmap */
+#ifdef __GNUC__
+#define RATE_HIGHEST_BIT(uMask)     (31 - __builtin_clz (uMask))
+#else
+static TI_UINT32 rate_HighestBit (TI_UINT32 uMask)
+{
+	TI_UINT32 uBit = 0;
 
-	case NET_RATE_MCS6:
-	case NET_RATE_MCS6_BASIC:
-		return DRV_RATE_MCS_6;
+	while (uMask >>= 1) {
+		uBit++;
+	}
+	return uBit;
+}
+#define RATE_HIGHEST_BIT(uMask)     rate_HighestBit (uMask)
+#endif
+
+/* Driver rate to network rate */
+static const TI_UINT8 aDrvToNetRate[DRV_RATE_MAX + 1] = {
+	NET_RATE_AUTO,  NET_RATE_1M,    NET_RATE_2M,    NET_RATE_5_5M,  NET_RATE_11M,
+	NET_RATE_22M,   NET_RATE_6M,    NET_RATE_9M,    NET_RATE_12M,   NET_RATE_18M,
+	NET_RATE_24M,   NET_RATE_36M,   NET_RATE_48M,   NET_RATE_54M,   NET_RATE_MCS0,
+	NET_RATE_MCS1,  NET_RATE_MCS2,  NET_RATE_MCS3,  NET_RATE_MCS4,  NET_RATE_MCS5,
+	NET_RATE_MCS6,  NET_RATE_MCS7
+};
+
+/* Driver rate to rate number (Mbps) */
+static const TI_UINT8 aDrvToRateNumber[DRV_RATE_MAX + 1] = {
+	0,  1,  2,  5,  11, 22, 6,  9,  12, 18, 24,
+	36, 48, 54, 6,  13, 19, 26, 39, 52, 58, 65
+};
+
+/* Network rate (with or without the basic bit) to driver rate, 0 for an invalid network rate */
+#define RATE_NET_TO_DRV(eNetRate, eDrvRate) \
+	[eNetRate] = eDrvRate, [(eNetRate) | NET_BASIC_MASK] = eDrvRate
+
+static const TI_UINT8 aNetToDrvRate[256] = {
+	RATE_NET_TO_DRV (NET_RATE_1M,   DRV_RATE_1M),
+	RATE_NET_TO_DRV (NET_RATE_2M,   DRV_RATE_2M),
+	RATE_NET_TO_DRV (NET_RATE_5_5M, DRV_RATE_5_5M),
+	RATE_NET_TO_DRV (NET_RATE_11M,  DRV_RATE_11M),
+	RATE_NET_TO_DRV (NET_RATE_22M,  DRV_RATE_22M),
+	RATE_NET_TO_DRV (NET_RATE_6M,   DRV_RATE_6M),
+	RATE_NET_TO_DRV (NET_RATE_9M,   DRV_RATE_9M),
+	RATE_NET_TO_DRV (NET_RATE_12M,  DRV_RATE_12M),
+	RATE_NET_TO_DRV (NET_RATE_18M,  DRV_RATE_18M),
+	RATE_NET_TO_DRV (NET_RATE_24M,  DRV_RATE_24M),
+	RATE_NET_TO_DRV (NET_RATE_36M,  DRV_RATE_36M),
+	RATE_NET_TO_DRV (NET_RATE_48M,  DRV_RATE_48M),
+	RATE_NET_TO_DRV (NET_RATE_54M,  DRV_RATE_54M),
+	RATE_NET_TO_DRV (NET_RATE_MCS0, DRV_RATE_MCS_0),
+	RATE_NET_TO_DRV (NET_RATE_MCS1, DRV_RATE_MCS_1),
+	RATE_NET_TO_DRV (NET_RATE_MCS2, DRV_RATE_MCS_2),
+	RATE_NET_TO_DRV (NET_RATE_MCS3, DRV_RATE_MCS_3),
+	RATE_NET_TO_DRV (NET_RATE_MCS4, DRV_RATE_MCS_4),
+	RATE_NET_TO_DRV (NET_RATE_MCS5, DRV_RATE_MCS_5),
+	RATE_NET_TO_DRV (NET_RATE_MCS6, DRV_RATE_MCS_6),
+	RATE_NET_TO_DRV (NET_RATE_MCS7, DRV_RATE_MCS_7)
+};
+
+/* Driver rate bitmap to HW rate bitmap, per bitmap byte */
+#define RATE_DRV_TO_HW_BIT(uDrvMask, eDrvMask, eHwBit)  (((uDrvMask) & (eDrvMask)) ? (eHwBit) : 0)
+#define RATE_DRV_TO_HW(uDrvMask)                                                \
+	(RATE_DRV_TO_HW_BIT (uDrvMask, DRV_RATE_MASK_1_BARKER,   HW_BIT_RATE_1MBPS)   | \
+	 RATE_DRV_TO_HW_BIT (uDrvMask, DRV_RATE_MASK_2_BARKER,   HW_BIT_RATE_2MBPS)   | \
+	 RATE_DRV_TO_HW_BIT (uDrvMask, DRV_RATE_MASK_5_5_CCK,    HW_BIT_RATE_5_5MBPS) | \
+	 RATE_DRV_TO_HW_BIT (uDrvMask, DRV_RATE_MASK_11_CCK,     HW_BIT_RATE_11MBPS)  | \
+	 RATE_DRV_TO_HW_BIT (uDrvMask, DRV_RATE_MASK_22_PBCC,    HW_BIT_RATE_22MBPS)  | \
+	 RATE_DRV_TO_HW_BIT (uDrvMask, DRV_RATE_MASK_6_OFDM,     HW_BIT_RATE_6MBPS)   | \
+	 RATE_DRV_TO_HW_BIT (uDrvMask, DRV_RATE_MASK_9_OFDM,     HW_BIT_RATE_9MBPS)   | \
+	 RATE_DRV_TO_HW_BIT (uDrvMask, DRV_RATE_MASK_12_OFDM,    HW_BIT_RATE_12MBPS)  | \
+	 RATE_DRV_TO_HW_BIT (uDrvMask, DRV_RATE_MASK_18_OFDM,    HW_BIT_RATE_18MBPS)  | \
+	 RATE_DRV_TO_HW_BIT (uDrvMask, DRV_RATE_MASK_24_OFDM,    HW_BIT_RATE_24MBPS)  | \
+	 RATE_DRV_TO_HW_BIT (uDrvMask, DRV_RATE_MASK_36_OFDM,    HW_BIT_RATE_36MBPS)  | \
+	 RATE_DRV_TO_HW_BIT (uDrvMask, DRV_RATE_MASK_48_OFDM,    HW_BIT_RATE_48MBPS)  | \
+	 RATE_DRV_TO_HW_BIT (uDrvMask, DRV_RATE_MASK_54_OFDM,    HW_BIT_RATE_54MBPS)  | \
+	 RATE_DRV_TO_HW_BIT (uDrvMask, DRV_RATE_MASK_MCS_0_OFDM, HW_BIT_RATE_MCS_0)   | \
+	 RATE_DRV_TO_HW_BIT (uDrvMask, DRV_RATE_MASK_MCS_1_OFDM, HW_BIT_RATE_MCS_1)   | \
+	 RATE_DRV_TO_HW_BIT (uDrvMask, DRV_RATE_MASK_MCS_2_OFDM, HW_BIT_RATE_MCS_2)   | \
+	 RATE_DRV_TO_HW_BIT (uDrvMask, DRV_RATE_MASK_MCS_3_OFDM, HW_BIT_RATE_MCS_3)   | \
+	 RATE_DRV_TO_HW_BIT (uDrvMask, DRV_RATE_MASK_MCS_4_OFDM, HW_BIT_RATE_MCS_4)   | \
+	 RATE_DRV_TO_HW_BIT (uDrvMask, DRV_RATE_MASK_MCS_5_OFDM, HW_BIT_RATE_MCS_5)   | \
+	 RATE_DRV_TO_HW_BIT (uDrvMask, DRV_RATE_MASK_MCS_6_OFDM, HW_BIT_RATE_MCS_6)   | \
+	 RATE_DRV_TO_HW_BIT (uDrvMask, DRV_RATE_MASK_MCS_7_OFDM, HW_BIT_RATE_MCS_7))
+
+#define RATE_TABLE_2(M, n, s)      M((TI_UINT32)(n) << (s)), M((TI_UINT32)((n) + 1) << (s))
+#define RATE_TABLE_4(M, n, s)      RATE_TABLE_2(M, n, s),   RATE_TABLE_2(M, (n) + 2, s)
+#define RATE_TABLE_8(M, n, s)      RATE_TABLE_4(M, n, s),   RATE_TABLE_4(M, (n) + 4, s)
+#define RATE_TABLE_16(M, n, s)     RATE_TABLE_8(M, n, s),   RATE_TABLE_8(M, (n) + 8, s)
+#define RATE_TABLE_32(M, n, s)     RATE_TABLE_16(M, n, s),  RATE_TABLE_16(M, (n) + 16, s)
+#define RATE_TABLE_64(M, n, s)     RATE_TABLE_32(M, n, s),  RATE_TABLE_32(M, (n) + 32, s)
+#define RATE_TABLE_128(M, n, s)    RATE_TABLE_64(M, n, s),  RATE_TABLE_64(M, (n) + 64, s)
+#define RATE_TABLE_256(M, n, s)    RATE_TABLE_128(M, n, s), RATE_TABLE_128(M, (n) + 128, s)
+
+static const TI_UINT32 aDrvByte0ToHwBitmap[256] = { RATE_TABLE_256 (RATE_DRV_TO_HW, 0, 0) };
+static const TI_UINT32 aDrvByte1ToHwBitmap[256] = { RATE_TABLE_256 (RATE_DRV_TO_HW, 0, 8) };
+/* Only 5 bits (MCS3 - MCS7) are used in the third byte */
+static const TI_UINT32 aDrvByte2ToHwBitmap[32]  = { RATE_TABLE_32 (RATE_DRV_TO_HW, 0, 16) };
 
-	case NET_RATE_MCS7:
-	case NET_RATE_MCS7_BASIC:
-		return DRV_RATE_MCS_7;
 
-	default:
+ERate rate_NetToDrv (TI_UINT32 rate)
+{
+	if (rate > 0xFF || aNetToDrvRate[rate] == 0) {
 		return DRV_RATE_INVALID;
 	}
+
+	return (ERate)aNetToDrvRate[rate];
 }
 
 /************************************************************************
@@ -148,173 +172,50 @@ RETURN:     Network rate if the input rate is valid, otherwise returns 0.
 ************************************************************************/
 ENetRate rate_DrvToNet (ERate rate)
 {
-	switch (rate) {
-	case DRV_RATE_AUTO:
-		return NET_RATE_AUTO;
-
-	case DRV_RATE_1M:
-		return NET_RATE_1M;
-
-	case DRV_RATE_2M:
-		return NET_RATE_2M;
-
-	case DRV_RATE_5_5M:
-		return NET_RATE_5_5M;
-
-	case DRV_RATE_11M:
-		return NET_RATE_11M;
-
-	case DRV_RATE_22M:
-		return NET_RATE_22M;
-
-	case DRV_RATE_6M:
-		return NET_RATE_6M;
-
-	case DRV_RATE_9M:
-		return NET_RATE_9M;
-
-	case DRV_RATE_12M:
-		return NET_RATE_12M;
-
-	case DRV_RATE_18M:
-		return NET_RATE_18M;
-
-	case DRV_RATE_24M:
-		return NET_RATE_24M;
-
-	case DRV_RATE_36M:
-		return NET_RATE_36M;
-
-	case DRV_RATE_48M:
-		return NET_RATE_48M;
-
-	case DRV_RATE_54M:
-		return NET_RATE_54M;
-
-	case DRV_RATE_MCS_0:
-		return NET_RATE_MCS0;
-
-	case DRV_RATE_MCS_1:
-		return NET_RATE_MCS1;
-
-	case DRV_RATE_MCS_2:
-		return NET_RATE_MCS2;
-
-	case DRV_RATE_MCS_3:
-		return NET_RATE_MCS3;
-
-	case DRV_RATE_MCS_4:
-		return NET_RATE_MCS4;
-
-	case DRV_RATE_MCS_5:
-		return NET_RATE_MCS5;
-
-	case DRV_RATE_MCS_6:
-		return NET_RATE_MCS6;
-
-	case DRV_RATE_MCS_7:
-		return NET_RATE_MCS7;
-
-	default:
+	if ((TI_UINT32)rate > DRV_RATE_MAX) {
 		return NET_RATE_AUTO;
 	}
+
+	return (ENetRate)aDrvToNetRate[rate];
 }
 
 /***************************************************************************
 *                   getMaxActiveRatefromBitmap                             *
 ****************************************************************************
-* DESCRIPTION:
+* DESCRIPTION:  Returns the highest rate (by throughput) in a driver rates bitmap.
+*               From 24M up the bitmap is ordered by throughput, so the highest
+*               set bit is the max rate. Below it, 22M and 11M are out of order.
 *
-* INPUTS:       hCtrlData - the object
+* INPUTS:       uRateBitMap - driver rates bitmap
 *
 * OUTPUT:
 *
-* RETURNS:
+* RETURNS:      The max rate, DRV_RATE_INVALID if the bitmap is empty
 ***************************************************************************/
 ERate rate_GetMaxFromDrvBitmap (TI_UINT32 uRateBitMap)
 {
-	if (uRateBitMap & DRV_RATE_MASK_MCS_7_OFDM) {
-		return DRV_RATE_MCS_7;
-	}
-
-	if (uRateBitMap & DRV_RATE_MASK_MCS_6_OFDM) {
-		return DRV_RATE_MCS_6;
-	}
-
-	if (uRateBitMap & DRV_RATE_MASK_MCS_5_OFDM) {
-		return DRV_RATE_MCS_5;
-	}
-
-	if (uRateBitMap & DRV_RATE_MASK_MCS_4_OFDM) {
-		return DRV_RATE_MCS_4;
-	}
-
-	if (uRateBitMap & DRV_RATE_MASK_MCS_3_OFDM) {
-		return DRV_RATE_MCS_3;
-	}
-
-	if (uRateBitMap & DRV_RATE_MASK_MCS_2_OFDM) {
-		return DRV_RATE_MCS_2;
-	}
-
-	if (uRateBitMap & DRV_RATE_MASK_MCS_1_OFDM) {
-		return DRV_RATE_MCS_1;
-	}
-
-	if (uRateBitMap & DRV_RATE_MASK_MCS_0_OFDM) {
-		return DRV_RATE_MCS_0;
-	}
-
-	if (uRateBitMap & DRV_RATE_MASK_54_OFDM) {
-		return DRV_RATE_54M;
-	}
-
-	if (uRateBitMap & DRV_RATE_MASK_48_OFDM) {
-		return DRV_RATE_48M;
-	}
-
-	if (uRateBitMap & DRV_RATE_MASK_36_OFDM) {
-		return DRV_RATE_36M;
-	}
+	TI_UINT32 uMask = uRateBitMap & RATE_DRV_BITMAP_ALL;
+	TI_UINT32 uHighMask = uMask & ~(DRV_RATE_MASK_24_OFDM - 1);
 
-	if (uRateBitMap & DRV_RATE_MASK_24_OFDM) {
-		return DRV_RATE_24M;
+	if (uHighMask) {
+		return (ERate)(RATE_HIGHEST_BIT (uHighMask) + 1);
 	}
 
-	if (uRateBitMap & DRV_RATE_MASK_22_PBCC) {
+	if (uMask & DRV_RATE_MASK_22_PBCC) {
 		return DRV_RATE_22M;
 	}
 
-	if (uRateBitMap & DRV_RATE_MASK_18_OFDM) {
-		return DRV_RATE_18M;
-	}
-
-	if (uRateBitMap & DRV_RATE_MASK_12_OFDM) {
-		return DRV_RATE_12M;
+	if (uMask & (DRV_RATE_MASK_18_OFDM | DRV_RATE_MASK_12_OFDM)) {
+		return (ERate)(RATE_HIGHEST_BIT (uMask) + 1);
 	}
 
-	if (uRateBitMap & DRV_RATE_MASK_11_CCK) {
+	if (uMask & DRV_RATE_MASK_11_CCK) {
 		return DRV_RATE_11M;
 	}
 
-	if (uRateBitMap & DRV_RATE_MASK_9_OFDM) {
-		return DRV_RATE_9M;
-	}
-
-	if (uRateBitMap & DRV_RATE_MASK_6_OFDM) {
-		return DRV_RATE_6M;
-	}
-
-	if (uRateBitMap & DRV_RATE_MASK_5_5_CCK) {
-		return DRV_RATE_5_5M;
-	}
-
-	if (uRateBitMap & DRV_RATE_MASK_2_BARKER) {
-		return DRV_RATE_2M;
-	}
-
-	if (uRateBitMap & DRV_RATE_MASK_1_BARKER) {
-		return DRV_RATE_1M;
+	/* 9M, 6M, 5.5M, 2M and 1M are ordered by throughput */
+	if (uMask) {
+		return (ERate)(RATE_HIGHEST_BIT (uMask) + 1);
 	}
 
 	return DRV_RATE_INVALID;
@@ -423,73 +324,11 @@ ENetRate rate_GetMaxActiveFromStr (TI_UINT8 *pRatesString, TI_UINT32 len, ENetRa
 
 TI_UINT32 rate_DrvToNumber (ERate eRate)
 {
-	switch (eRate) {
-	case DRV_RATE_1M:
-		return 1;
-
-	case DRV_RATE_2M:
-		return 2;
-
-	case DRV_RATE_5_5M:
-		return 5;
-
-	case DRV_RATE_11M:
-		return 11;
-
-	case DRV_RATE_22M:
-		return 22;
-
-	case DRV_RATE_6M:
-		return 6;
-
-	case DRV_RATE_9M:
-		return 9;
-
-	case DRV_RATE_12M:
-		return 12;
-
-	case DRV_RATE_18M:
-		return 18;
-
-	case DRV_RATE_24M:
-		return 24;
-
-	case DRV_RATE_36M:
-		return 36;
-
-	case DRV_RATE_48M:
-		return 48;
-
-	case DRV_RATE_54M:
-		return 54;
-
-	case DRV_RATE_MCS_0:
-		return 6;
-
-	case DRV_RATE_MCS_1:
-		return 13;
-
-	case DRV_RATE_MCS_2:
-		return 19;
-
-	case DRV_RATE_MCS_3:
-		return 26;
-
-	case DRV_RATE_MCS_4:
-		return 39;
-
-	case DRV_RATE_MCS_5:
-		return 52;
-
-	case DRV_RATE_MCS_6:
-		return 58;
-
-	case DRV_RATE_MCS_7:
-		return 65;
-
-	default:
+	if ((TI_UINT32)eRate > DRV_RATE_MAX) {
 		return 0;
 	}
+
+	return aDrvToRateNumber[eRate];
 }
 
 /************************************************************************
@@ -738,121 +577,18 @@ RETURN:     None
 TI_STATUS rate_NetStrToDrvBitmap (TI_UINT32 *pBitMap, TI_UINT8 *string, TI_UINT32 len)
 {
 	TI_UINT32   i;
-
-	*pBitMap = 0;
+	TI_UINT32   uBitMap = 0;
+	TI_UINT8    uDrvRate;
 
 	for (i = 0; i < len; i++) {
-		switch (string[i]) {
-		case NET_RATE_1M:
-		case NET_RATE_1M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_1_BARKER;
-			break;
-
-		case NET_RATE_2M:
-		case NET_RATE_2M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_2_BARKER;
-			break;
-
-		case NET_RATE_5_5M:
-		case NET_RATE_5_5M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_5_5_CCK;
-			break;
-
-		case NET_RATE_11M:
-		case NET_RATE_11M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_11_CCK;
-			break;
-
-		case NET_RATE_22M:
-		case NET_RATE_22M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_22_PBCC;
-			break;
-
-		case NET_RATE_6M:
-		case NET_RATE_6M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_6_OFDM;
-			break;
-
-		case NET_RATE_9M:
-		case NET_RATE_9M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_9_OFDM;
-			break;
-
-		case NET_RATE_12M:
-		case NET_RATE_12M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_12_OFDM;
-			break;
-
-		case NET_RATE_18M:
-		case NET_RATE_18M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_18_OFDM;
-			break;
-
-		case NET_RATE_24M:
-		case NET_RATE_24M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_24_OFDM;
-			break;
-
-		case NET_RATE_36M:
-		case NET_RATE_36M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_36_OFDM;
-			break;
-
-		case NET_RATE_48M:
-		case NET_RATE_48M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_48_OFDM;
-			break;
-
-		case NET_RATE_54M:
-		case NET_RATE_54M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_54_OFDM;
-			break;
-
-		case NET_RATE_MCS0:
-		case NET_RATE_MCS0_BASIC:
-			*pBitMap |= DRV_RATE_MASK_MCS_0_OFDM;
-			break;
-
-		case NET_RATE_MCS1:
-		case NET_RATE_MCS1_BASIC:
-			*pBitMap |= DRV_RATE_MASK_MCS_1_OFDM;
-			break;
-
-		case NET_RATE_MCS2:
-		case NET_RATE_MCS2_BASIC:
-			*pBitMap |= DRV_RATE_MASK_MCS_2_OFDM;
-			break;
-
-		case NET_RATE_MCS3:
-		case NET_RATE_MCS3_BASIC:
-			*pBitMap |= DRV_RATE_MASK_MCS_3_OFDM;
-			break;
-
-		case NET_RATE_MCS4:
-		case NET_RATE_MCS4_BASIC:
-			*pBitMap |= DRV_RATE_MASK_MCS_4_OFDM;
-			break;
-
-		case NET_RATE_MCS5:
-		case NET_RATE_MCS5_BASIC:
-			*pBitMap |= DRV_RATE_MASK_MCS_5_OFDM;
-			break;
-
-		case NET_RATE_MCS6:
-		case NET_RATE_MCS6_BASIC:
-			*pBitMap |= DRV_RATE_MASK_MCS_6_OFDM;
-			break;
-
-		case NET_RATE_MCS7:
-		case NET_RATE_MCS7_BASIC:
-			*pBitMap |= DRV_RATE_MASK_MCS_7_OFDM;
-			break;
-
-		default:
-			break;
+		uDrvRate = aNetToDrvRate[string[i]];
+		if (uDrvRate != 0) {
+			uBitMap |= RATE_TO_MASK(uDrvRate);
 		}
 	}
 
+	*pBitMap = uBitMap;
+
 	return TI_OK;
 }
 
@@ -872,100 +608,20 @@ RETURN:     None
 TI_STATUS rate_NetBasicStrToDrvBitmap (TI_UINT32 *pBitMap, TI_UINT8 *string, TI_UINT32 len)
 {
 	TI_UINT32   i;
-
-	*pBitMap = 0;
+	TI_UINT32   uBitMap = 0;
+	TI_UINT8    uDrvRate;
 
 	for (i = 0; i < len; i++) {
-		switch (string[i]) {
-		case NET_RATE_1M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_1_BARKER;
-			break;
-
-		case NET_RATE_2M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_2_BARKER;
-			break;
-
-		case NET_RATE_5_5M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_5_5_CCK;
-			break;
-
-		case NET_RATE_11M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_11_CCK;
-			break;
-
-		case NET_RATE_22M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_22_PBCC;
-			break;
-
-		case NET_RATE_6M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_6_OFDM;
-			break;
-
-		case NET_RATE_9M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_9_OFDM;
-			break;
-
-		case NET_RATE_12M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_12_OFDM;
-			break;
-
-		case NET_RATE_18M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_18_OFDM;
-			break;
-
-		case NET_RATE_24M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_24_OFDM;
-			break;
-
-		case NET_RATE_36M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_36_OFDM;
-			break;
-
-		case NET_RATE_48M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_48_OFDM;
-			break;
-
-		case NET_RATE_54M_BASIC:
-			*pBitMap |= DRV_RATE_MASK_54_OFDM;
-			break;
-
-		case NET_RATE_MCS0_BASIC:
-			*pBitMap |= DRV_RATE_MASK_MCS_0_OFDM;
-			break;
-
-		case NET_RATE_MCS1_BASIC:
-			*pBitMap |= DRV_RATE_MASK_MCS_1_OFDM;
-			break;
-
-		case NET_RATE_MCS2_BASIC:
-			*pBitMap |= DRV_RATE_MASK_MCS_2_OFDM;
-			break;
-
-		case NET_RATE_MCS3_BASIC:
-			*pBitMap |= DRV_RATE_MASK_MCS_3_OFDM;
-			break;
-
-		case NET_RATE_MCS4_BASIC:
-			*pBitMap |= DRV_RATE_MASK_MCS_4_OFDM;
-			break;
-
-		case NET_RATE_MCS5_BASIC:
-			*pBitMap |= DRV_RATE_MASK_MCS_5_OFDM;
-			break;
-
-		case NET_RATE_MCS6_BASIC:
-			*pBitMap |= DRV_RATE_MASK_MCS_6_OFDM;
-			break;
-
-		case NET_RATE_MCS7_BASIC:
-			*pBitMap |= DRV_RATE_MASK_MCS_7_OFDM;
-			break;
-
-		default:
-			break;
+		if (NET_BASIC_RATE (string[i])) {
+			uDrvRate = aNetToDrvRate[string[i]];
+			if (uDrvRate != 0) {
+				uBitMap |= RATE_TO_MASK(uDrvRate);
+			}
 		}
 	}
 
+	*pBitMap = uBitMap;
+
 	return TI_OK;
 }
 
@@ -996,93 +652,9 @@ TI_STATUS rate_McsNetStrToDrvBitmap (TI_UINT32 *pBitMap, TI_UINT8 *string)
 
 TI_STATUS rate_DrvBitmapToHwBitmap (TI_UINT32 uDrvBitMap, TI_UINT32 *pHwBitmap)
 {
-	TI_UINT32   uHwBitMap = 0;
-
-	if (uDrvBitMap & DRV_RATE_MASK_1_BARKER) {
-		uHwBitMap |= HW_BIT_RATE_1MBPS;
-	}
-
-	if (uDrvBitMap & DRV_RATE_MASK_2_BARKER) {
-		uHwBitMap |= HW_BIT_RATE_2MBPS;
-	}
-
-	if (uDrvBitMap & DRV_RATE_MASK_5_5_CCK) {
-		uHwBitMap |= HW_BIT_RATE_5_5MBPS;
-	}
-
-	if (uDrvBitMap & DRV_RATE_MASK_11_CCK) {
-		uHwBitMap |= HW_BIT_RATE_11MBPS;
-	}
-
-	if (uDrvBitMap & DRV_RATE_MASK_22_PBCC) {
-		uHwBitMap |= HW_BIT_RATE_22MBPS;
-	}
-
-	if (uDrvBitMap & DRV_RATE_MASK_6_OFDM) {
-		uHwBitMap |= HW_BIT_RATE_6MBPS;
-	}
-
-	if (uDrvBitMap & DRV_RATE_MASK_9_OFDM) {
-		uHwBitMap |= HW_BIT_RATE_9MBPS;
-	}
-
-	if (uDrvBitMap & DRV_RATE_MASK_12_OFDM) {
-		uHwBitMap |= HW_BIT_RATE_12MBPS;
-	}
-
-	if (uDrvBitMap & DRV_RATE_MASK_18_OFDM) {
-		uHwBitMap |= HW_BIT_RATE_18MBPS;
-	}
-
-	if (uDrvBitMap & DRV_RATE_MASK_24_OFDM) {
-		uHwBitMap |= HW_BIT_RATE_24MBPS;
-	}
-
-	if (uDrvBitMap & DRV_RATE_MASK_36_OFDM) {
-		uHwBitMap |= HW_BIT_RATE_36MBPS;
-	}
-
-	if (uDrvBitMap & DRV_RATE_MASK_48_OFDM) {
-		uHwBitMap |= HW_BIT_RATE_48MBPS;
-	}
-
-	if (uDrvBitMap & DRV_RATE_MASK_54_OFDM) {
-		uHwBitMap |= HW_BIT_RATE_54MBPS;
-	}
-
-	if (uDrvBitMap & DRV_RATE_MASK_MCS_0_OFDM) {
-		uHwBitMap |= HW_BIT_RATE_MCS_0;
-	}
-
-	if (uDrvBitMap & DRV_RATE_MASK_MCS_1_OFDM) {
-		uHwBitMap |= HW_BIT_RATE_MCS_1;
-	}
-
-	if (uDrvBitMap & DRV_RATE_MASK_MCS_2_OFDM) {
-		uHwBitMap |= HW_BIT_RATE_MCS_2;
-	}
-
-	if (uDrvBitMap & DRV_RATE_MASK_MCS_3_OFDM) {
-		uHwBitMap |= HW_BIT_RATE_MCS_3;
-	}
-
-	if (uDrvBitMap & DRV_RATE_MASK_MCS_4_OFDM) {
-		uHwBitMap |= HW_BIT_RATE_MCS_4;
-	}
-
-	if (uDrvBitMap & DRV_RATE_MASK_MCS_5_OFDM) {
-		uHwBitMap |= HW_BIT_RATE_MCS_5;
-	}
-
-	if (uDrvBitMap & DRV_RATE_MASK_MCS_6_OFDM) {
-		uHwBitMap |= HW_BIT_RATE_MCS_6;
-	}
-
-	if (uDrvBitMap & DRV_RATE_MASK_MCS_7_OFDM) {
-		uHwBitMap |= HW_BIT_RATE_MCS_7;
-	}
-
-	*pHwBitmap = uHwBitMap;
+	*pHwBitmap = aDrvByte0ToHwBitmap[uDrvBitMap & 0xFF] |
+	             aDrvByte1ToHwBitmap[(uDrvBitMap >> 8) & 0xFF] |
+	             aDrvByte2ToHwBitmap[(uDrvBitMap >> 16) & 0x1F];
 
 	return TI_OK;
 }
@@ -46,6 +46,9 @@
 #include "CmdInterfaceCodes.h"
 
 
+static void report_UpdateTracePoints (TReport *pReport);
+static TI_STATUS report_SetTracePointOverride (TReport *pReport, TReportTracePointParam *pParam);
+
 
 
 /************************************************************************
@@ -64,6 +67,15 @@ TI_HANDLE report_Create (TI_HANDLE hOs)
 
 	os_memoryZero(hOs, pReport->aSeverityTable, sizeof(pReport->aSeverityTable));
 	os_memoryZero(hOs, pReport->aFileEnable, sizeof(pReport->aFileEnable));
+	pReport->pTracePoints = NULL;
+	pReport->uNumTracePoints = 0;
+	pReport->uNumTpOverrides = 0;
+
+	pReport->hProtect = os_protectCreate(hOs);
+	if (!pReport->hProtect) {
+		os_memoryFree(hOs, pReport, sizeof(TReport));
+		return NULL;
+	}
 
 
 #ifdef PRINTF_ROLLBACK
@@ -261,6 +273,18 @@ TI_STATUS report_Unload (TI_HANDLE hReport)
 	closeMyFile();
 #endif
 
+	/* the sites are static - let them register again with the next report object */
+	os_protectLock(pReport->hOs, pReport->hProtect);
+	while (pReport->pTracePoints) {
+		TReportTracePoint *pTracePoint = pReport->pTracePoints;
+
+		pReport->pTracePoints = pTracePoint->pNext;
+		pTracePoint->pNext = NULL;
+		pTracePoint->uState = REPORT_TP_STATE_UNREGISTERED;
+	}
+	os_protectUnlock(pReport->hOs, pReport->hProtect);
+
+	os_protectDestroy(pReport->hOs, pReport->hProtect);
 	os_memoryFree(pReport->hOs, pReport, sizeof(TReport));
 	return TI_OK;
 }
@@ -273,6 +297,7 @@ TI_STATUS report_SetReportModule(TI_HANDLE hReport, TI_UINT8 module_index)
 	}
 
 	((TReport *)hReport)->aFileEnable[module_index] = 1;
+	report_UpdateTracePoints ((TReport *)hReport);
 
 	return TI_OK;
 }
@@ -285,6 +310,7 @@ TI_STATUS report_ClearReportModule(TI_HANDLE hReport, TI_UINT8 module_index)
 	}
 
 	((TReport *)hReport)->aFileEnable[module_index] = 0;
+	report_UpdateTracePoints ((TReport *)hReport);
 
 	return TI_OK;
 }
@@ -328,6 +354,7 @@ TI_STATUS report_SetReportFilesTable(TI_HANDLE hReport, TI_UINT8 *pFiles)
 	              (void *)(((TReport *)hReport)->aFileEnable),
 	              (void *)pFiles,
 	              sizeof(((TReport *)hReport)->aFileEnable));
+	report_UpdateTracePoints ((TReport *)hReport);
 
 	return TI_OK;
 }
@@ -372,6 +399,7 @@ TI_STATUS report_SetReportSeverityTable(TI_HANDLE hReport, TI_UINT8 *pSeverities
 	              (void *)(((TReport *)hReport)->aSeverityTable),
 	              (void *)pSeverities,
 	              sizeof(((TReport *)hReport)->aSeverityTable));
+	report_UpdateTracePoints ((TReport *)hReport);
 
 	return TI_OK;
 }
@@ -415,6 +443,9 @@ TI_STATUS report_SetParam (TI_HANDLE hReport, TReportParamInfo *pParam)
 		os_setDebugOutputToLogger(TI_FALSE);
 		break;
 
+	case REPORT_TRACE_POINT_PARAM:
+		return report_SetTracePointOverride((TReport *)hReport, &pParam->content.tTracePoint);
+
 	default:
 		return PARAM_NOT_SUPPORTED;
 	}
@@ -448,6 +479,251 @@ TI_STATUS report_GetParam (TI_HANDLE hReport, TReportParamInfo *pParam)
 }
 
 
+/************************************************************************
+ *                        report_UpdateTracePoint                       *
+ ************************************************************************
+ * Set the trace point state from the files and severities tables, unless
+ * it is overridden (an exact line override wins over a whole file one).
+ ************************************************************************/
+static void report_UpdateTracePoint (TReport *pReport, TReportTracePoint *pTracePoint)
+{
+	TI_UINT32 uOverride = REPORT_TP_OVERRIDE_NONE;
+	TI_BOOL   bEnabled;
+	TI_UINT32 i;
+
+	for (i = 0; i < pReport->uNumTpOverrides; i++) {
+		TReportTracePointParam *pOverride = &pReport->aTpOverride[i];
+
+		if (pOverride->uFileId != pTracePoint->uFileId) {
+			continue;
+		}
+		if (pOverride->uLine == pTracePoint->uLine) {
+			uOverride = pOverride->uOverride;
+			break;
+		}
+		if (pOverride->uLine == 0) {
+			uOverride = pOverride->uOverride;
+		}
+	}
+
+	if (uOverride == REPORT_TP_OVERRIDE_NONE) {
+		bEnabled = (pTracePoint->uFileId < REPORT_FILES_NUM) &&
+		           (pTracePoint->uSeverity < REPORT_SEVERITY_MAX) &&
+		           pReport->aFileEnable[pTracePoint->uFileId] &&
+		           pReport->aSeverityTable[pTracePoint->uSeverity];
+	} else {
+		bEnabled = (uOverride == REPORT_TP_OVERRIDE_ON);
+	}
+
+	pTracePoint->uState = bEnabled ? REPORT_TP_STATE_ON : REPORT_TP_STATE_OFF;
+}
+
+/************************************************************************
+ *                        report_UpdateTracePoints                      *
+ ************************************************************************/
+static void report_UpdateTracePoints (TReport *pReport)
+{
+	TReportTracePoint *pTracePoint;
+
+	os_protectLock(pReport->hOs, pReport->hProtect);
+	for (pTracePoint = pReport->pTracePoints; pTracePoint; pTracePoint = pTracePoint->pNext) {
+		report_UpdateTracePoint (pReport, pTracePoint);
+	}
+	os_protectUnlock(pReport->hOs, pReport->hProtect);
+}
+
+/************************************************************************
+ *                        report_SetTracePointOverrideTable             *
+ ************************************************************************
+ * Add, update or remove an override (called with the report lock held)
+ ************************************************************************/
+static TI_STATUS report_SetTracePointOverrideTable (TReport *pReport, TReportTracePointParam *pParam)
+{
+	TI_UINT32 i;
+
+	for (i = 0; i < pReport->uNumTpOverrides; i++) {
+		if ((pReport->aTpOverride[i].uFileId == pParam->uFileId) && (pReport->aTpOverride[i].uLine == pParam->uLine)) {
+			break;
+		}
+	}
+
+	if (pParam->uOverride == REPORT_TP_OVERRIDE_NONE) {
+		/* remove the override (keep the table packed) */
+		if (i < pReport->uNumTpOverrides) {
+			pReport->uNumTpOverrides--;
+			pReport->aTpOverride[i] = pReport->aTpOverride[pReport->uNumTpOverrides];
+		}
+	} else {
+		if (i == pReport->uNumTpOverrides) {
+			if (pReport->uNumTpOverrides == REPORT_TP_MAX_OVERRIDES) {
+				return TI_NOK;
+			}
+			pReport->uNumTpOverrides++;
+		}
+		pReport->aTpOverride[i] = *pParam;
+	}
+
+	return TI_OK;
+}
+
+/************************************************************************
+ *                        report_SetTracePointOverride                  *
+ ************************************************************************/
+static TI_STATUS report_SetTracePointOverride (TReport *pReport, TReportTracePointParam *pParam)
+{
+	TReportTracePoint *pTracePoint;
+	TI_STATUS          eStatus;
+
+	if ((pParam->uFileId >= REPORT_FILES_NUM) || (pParam->uOverride > REPORT_TP_OVERRIDE_OFF)) {
+		return TI_NOK;
+	}
+
+	/* the overrides are read by the sites registration, so they are changed under the lock */
+	os_protectLock(pReport->hOs, pReport->hProtect);
+	eStatus = report_SetTracePointOverrideTable (pReport, pParam);
+	if (eStatus == TI_OK) {
+		for (pTracePoint = pReport->pTracePoints; pTracePoint; pTracePoint = pTracePoint->pNext) {
+			report_UpdateTracePoint (pReport, pTracePoint);
+		}
+	}
+	os_protectUnlock(pReport->hOs, pReport->hProtect);
+
+	return eStatus;
+}
+
+/************************************************************************
+ *                        report_TracePointEnabled                      *
+ ************************************************************************/
+TI_BOOL report_TracePointEnabled (TI_HANDLE hReport, TReportTracePoint *pTracePoint)
+{
+	TReport *pReport = (TReport *)hReport;
+
+	if (NULL == pReport) {
+		return TI_FALSE;
+	}
+
+	/* first execution of the site - register it (a site may be reached concurrently from several contexts) */
+	if (pTracePoint->uState == REPORT_TP_STATE_UNREGISTERED) {
+		os_protectLock(pReport->hOs, pReport->hProtect);
+		if (pTracePoint->uState == REPORT_TP_STATE_UNREGISTERED) {
+			pTracePoint->pNext = pReport->pTracePoints;
+			pReport->pTracePoints = pTracePoint;
+			pReport->uNumTracePoints++;
+			report_UpdateTracePoint (pReport, pTracePoint);
+		}
+		os_protectUnlock(pReport->hOs, pReport->hProtect);
+	}
+
+	return (pTracePoint->uState == REPORT_TP_STATE_ON) ? TI_TRUE : TI_FALSE;
+}
+
+#ifdef TI_DBG
+/************************************************************************
+ *                        report_PrintTracePoints                       *
+ ************************************************************************/
+void report_PrintTracePoints (TI_HANDLE hReport)
+{
+	TReport           *pReport = (TReport *)hReport;
+	TReportTracePoint *pTracePoint;
+	TI_UINT32          uEnabled = 0;
+	TI_UINT32          i;
+
+	WLAN_OS_REPORT(("Registered trace points: %d\n", pReport->uNumTracePoints));
+	for (pTracePoint = pReport->pTracePoints; pTracePoint; pTracePoint = pTracePoint->pNext) {
+		if (pTracePoint->uState == REPORT_TP_STATE_ON) {
+			WLAN_OS_REPORT(("  file %3d line %5d severity %d - enabled\n",
+			                pTracePoint->uFileId, pTracePoint->uLine, pTracePoint->uSeverity));
+			uEnabled++;
+		}
+	}
+	WLAN_OS_REPORT(("Enabled trace points: %d\n", uEnabled));
+
+	for (i = 0; i < pReport->uNumTpOverrides; i++) {
+		WLAN_OS_REPORT(("Override: file %d line %d %s\n", pReport->aTpOverride[i].uFileId, pReport->aTpOverride[i].uLine,
+		                (pReport->aTpOverride[i].uOverride == REPORT_TP_OVERRIDE_ON) ? "on" : "off"));
+	}
+}
+
+/* The report site check used before trace points: called with evaluated arguments, looks up both tables */
+static void report_DbgTableTrace (TI_HANDLE hReport, TI_UINT32 uFileId, TI_UINT32 uSeverity,
+                                  TI_UINT32 uParam1, TI_UINT32 uParam2, TI_UINT32 *pHits)
+{
+	if (hReport && ((TReport *)hReport)->aSeverityTable[uSeverity] && ((TReport *)hReport)->aFileEnable[uFileId]) {
+		*pHits += uParam1 + uParam2;
+	}
+}
+
+/* A data path packet handler with the typical per packet report sites */
+static void report_DbgPacket (TI_HANDLE hReport, TI_UINT32 uPacket, TI_BOOL bTracePoints, TI_UINT32 *pHits)
+{
+	TI_UINT32 uLen = 64 + (uPacket & 0x3FF);
+	TI_UINT32 uTid = uPacket & 7;
+
+	if (bTracePoints) {
+		REPORT_TRACE_DO(hReport, REPORT_SEVERITY_INFORMATION, *pHits += uLen + uTid);
+		REPORT_TRACE_DO(hReport, REPORT_SEVERITY_INFORMATION, *pHits += (uLen >> 2) + uPacket);
+		REPORT_TRACE_DO(hReport, REPORT_SEVERITY_WARNING, *pHits += uTid);
+		REPORT_TRACE_DO(hReport, REPORT_SEVERITY_ERROR, *pHits += uLen);
+	} else {
+		report_DbgTableTrace (hReport, __FILE_ID__, REPORT_SEVERITY_INFORMATION, uLen, uTid, pHits);
+		report_DbgTableTrace (hReport, __FILE_ID__, REPORT_SEVERITY_INFORMATION, uLen >> 2, uPacket, pHits);
+		report_DbgTableTrace (hReport, __FILE_ID__, REPORT_SEVERITY_WARNING, uTid, 0, pHits);
+		report_DbgTableTrace (hReport, __FILE_ID__, REPORT_SEVERITY_ERROR, uLen, 0, pHits);
+	}
+}
+
+/************************************************************************
+ *                        report_TracePointBenchmark                    *
+ ************************************************************************/
+void report_TracePointBenchmark (TI_HANDLE hReport, TI_UINT32 uPackets)
+{
+	TReport   *pReport = (TReport *)hReport;
+	TI_UINT8   aSavedSeverities[REPORT_SEVERITY_MAX];
+	TI_UINT32  uStartUs, uOffUs, uDefaultUs, uTableUs;
+	TI_UINT32  uHitsOff = 0, uHitsDefault = 0, uHitsTable = 0;
+	TI_UINT32  i;
+
+	if (uPackets == 0) {
+		uPackets = 100000;
+	}
+
+	/* register the benchmark sites */
+	report_DbgPacket (hReport, 0, TI_TRUE, &uHitsOff);
+	uHitsOff = 0;
+
+	/* reporting fully off */
+	os_memoryCopy (pReport->hOs, aSavedSeverities, pReport->aSeverityTable, sizeof(aSavedSeverities));
+	os_memoryZero (pReport->hOs, pReport->aSeverityTable, sizeof(pReport->aSeverityTable));
+	report_UpdateTracePoints (pReport);
+	uStartUs = os_timeStampUs (pReport->hOs);
+	for (i = 0; i < uPackets; i++) {
+		report_DbgPacket (hReport, i, TI_TRUE, &uHitsOff);
+	}
+	uOffUs = os_timeStampUs (pReport->hOs) - uStartUs;
+	os_memoryCopy (pReport->hOs, pReport->aSeverityTable, aSavedSeverities, sizeof(aSavedSeverities));
+	report_UpdateTracePoints (pReport);
+
+	/* current (default) levels */
+	uStartUs = os_timeStampUs (pReport->hOs);
+	for (i = 0; i < uPackets; i++) {
+		report_DbgPacket (hReport, i, TI_TRUE, &uHitsDefault);
+	}
+	uDefaultUs = os_timeStampUs (pReport->hOs) - uStartUs;
+
+	/* current levels with the tables lookup on every site */
+	uStartUs = os_timeStampUs (pReport->hOs);
+	for (i = 0; i < uPackets; i++) {
+		report_DbgPacket (hReport, i, TI_FALSE, &uHitsTable);
+	}
+	uTableUs = os_timeStampUs (pReport->hOs) - uStartUs;
+
+	WLAN_OS_REPORT(("Report sites benchmark: %d packets, 4 sites per packet\n", uPackets));
+	WLAN_OS_REPORT(("  trace points, reporting off : %d us, %d ns/packet\n", uOffUs, (uOffUs * 1000) / uPackets));
+	WLAN_OS_REPORT(("  trace points, default levels: %d us, %d ns/packet (hits %d)\n", uDefaultUs, (uDefaultUs * 1000) / uPackets, uHitsDefault));
+	WLAN_OS_REPORT(("  tables lookup, default levels: %d us, %d ns/packet (hits %d)\n", uTableUs, (uTableUs * 1000) / uPackets, uHitsTable));
+}
+#endif /* TI_DBG */
+
 /************************************************************************
  *                        report_Dump                                 *
  ************************************************************************/
@@ -51,6 +51,8 @@
  * Only if both flags are enabled, the message is printed. \n
  * The report flags of all file are indicated in a bit map Table which is contained in the report module handle	\n
  * The report flags of all severities  are indicated in a bit map Table which is contained in the report module handle	\n
+ * Report sites written with TRACEn keep a static trace point descriptor, which caches the result of both tables	\n
+ * (and of a per site override), so a disabled site costs a single flag test and its arguments are not evaluated. \n
  */
 
 /* in order to work without the driver logger use that definition here
@@ -257,6 +259,57 @@ typedef enum {
 	PROBLEM_MAX_VALUE
 
 } EProblemType;
+
+/** \enum ETracePointState
+ * \brief Report trace point states (see TReportTracePoint)
+ */
+typedef enum {
+	REPORT_TP_STATE_OFF            =  0,	/**< Site disabled - skipped without calling the report module		*/
+	REPORT_TP_STATE_ON             =  1,	/**< Site enabled													*/
+	REPORT_TP_STATE_UNREGISTERED   =  2		/**< Site not reached yet - registered on its first execution		*/
+
+} ETracePointState;
+
+/** \enum ETracePointOverride
+ * \brief Per site override of the files and severities tables (see REPORT_TRACE_POINT_PARAM)
+ */
+typedef enum {
+	REPORT_TP_OVERRIDE_NONE        =  0,	/**< Follow the files and severities tables	(removes an override)	*/
+	REPORT_TP_OVERRIDE_ON          =  1,	/**< Always report															*/
+	REPORT_TP_OVERRIDE_OFF         =  2		/**< Never report															*/
+
+} ETracePointOverride;
+
+#define REPORT_TP_MAX_OVERRIDES    16
+
+/** \struct TReportTracePoint
+ * \brief Report Trace Point
+ *
+ * \par Description
+ * Static descriptor of a TRACEn / REPORT_TRACE_DO site. The site tests only uState, which is rewritten by the report module
+ * whenever the files table, the severities table or the site override change.
+ *
+ * \sa	REPORT_TRACE_DO
+ */
+typedef struct TReportTracePoint {
+	struct TReportTracePoint *pNext;					/**< Next registered trace point			*/
+	TI_UINT16       uFileId;							/**< Site file ID (__FILE_ID__)			*/
+	TI_UINT16       uLine;								/**< Site line number						*/
+	TI_UINT8        uSeverity;							/**< Site severity (EReportSeverity)		*/
+	volatile TI_UINT8 uState;							/**< ETracePointState						*/
+
+} TReportTracePoint;
+
+/** \struct TReportTracePointParam
+ * \brief Per site override, set with REPORT_TRACE_POINT_PARAM
+ */
+typedef struct {
+	TI_UINT16       uFileId;							/**< Site file ID							*/
+	TI_UINT16       uLine;								/**< Site line number, 0 for all the sites of the file	*/
+	TI_UINT32       uOverride;							/**< ETracePointOverride					*/
+
+} TReportTracePointParam;
+
 /** \struct TReport
  * \brief Report Module Object
  *
@@ -275,6 +328,12 @@ typedef struct {
 	char            aFileName[REPORT_FILES_NUM][MAX_STRING_LEN];	    /**< Files names table inserted in the file's reported messages		 */
 #endif
 
+	TI_HANDLE               hProtect;										/**< Protects the trace points list and their state	 */
+	TReportTracePoint      *pTracePoints;									/**< Registered trace points list	 */
+	TI_UINT32               uNumTracePoints;								/**< Number of registered trace points	 */
+	TReportTracePointParam  aTpOverride[REPORT_TP_MAX_OVERRIDES];			/**< Per site overrides	 */
+	TI_UINT32               uNumTpOverrides;								/**< Number of per site overrides	 */
+
 } TReport;
 
 /** \struct TReportParamInfo
@@ -305,6 +364,7 @@ typedef struct {
 															* User can Set/Get this Tabel
 															*/
 		TI_UINT32   uReportPPMode;							/**< Used by user for Indicating if Debug Module should be enabled/disabled																	*/
+		TReportTracePointParam tTracePoint;				/**< Per site override of the files and severities tables												*/
 
 	} content;
 
@@ -377,9 +437,59 @@ variable contained in the report handle*/
 */
 #define WLAN_INIT_REPORT(msg)
 #endif
+/** \def REPORT_TRACE_DO
+* \brief Macro which performs an action if the site is enabled for reporting.
+* The site is registered with the report module (under its lock) the first time it is reached and from then on,
+* while it is disabled, it costs one flag test (no report module call and no arguments evaluation).
+* Note: the registration takes the OS protection lock, so don't use it inside a critical section.
+*/
+#define REPORT_TRACE_DO(hReport, eSeverity, action)                                                                 \
+	do { static TReportTracePoint tTracePoint = { NULL, __FILE_ID__, __LINE__, eSeverity, REPORT_TP_STATE_UNREGISTERED }; \
+		if (TI_UNLIKELY(tTracePoint.uState) && report_TracePointEnabled (hReport, &tTracePoint)) { action; } } while (0)
+
+/** \def REPORT_TRACE_MSG
+* \brief Macro which writes a trace message of an enabled site.
+* The message is sent to the logger (os_Trace) as the site file and line and its parameters, from which the logger
+* restores the text. With PRINTF_ROLLBACK (working without the logger) it is printed.
+*/
+#ifdef PRINTF_ROLLBACK
+#define REPORT_TRACE_MSG(hReport, level, str, num, ...)               \
+	os_printf (str, ##__VA_ARGS__)
+#else
+#define REPORT_TRACE_MSG(hReport, level, str, num, ...)               \
+	os_Trace (((TReport *)(hReport))->hOs, level, __FILE_ID__, __LINE__, num, ##__VA_ARGS__)
+#endif
+
+/** \def TRACE0
+* \brief Macros which write a trace message with 0..8 parameters if the file and severity of the site are
+* enabled for reporting. The parameters are 32 bit values.
+*/
+#define TRACE0(hReport, level, str) \
+	REPORT_TRACE_DO(hReport, level, REPORT_TRACE_MSG(hReport, level, str, 0))
+#define TRACE1(hReport, level, str, p1) \
+	REPORT_TRACE_DO(hReport, level, REPORT_TRACE_MSG(hReport, level, str, 1, (TI_UINT32)(p1)))
+#define TRACE2(hReport, level, str, p1, p2) \
+	REPORT_TRACE_DO(hReport, level, REPORT_TRACE_MSG(hReport, level, str, 2, (TI_UINT32)(p1), (TI_UINT32)(p2)))
+#define TRACE3(hReport, level, str, p1, p2, p3) \
+	REPORT_TRACE_DO(hReport, level, REPORT_TRACE_MSG(hReport, level, str, 3, (TI_UINT32)(p1), (TI_UINT32)(p2), (TI_UINT32)(p3)))
+#define TRACE4(hReport, level, str, p1, p2, p3, p4) \
+	REPORT_TRACE_DO(hReport, level, REPORT_TRACE_MSG(hReport, level, str, 4, (TI_UINT32)(p1), (TI_UINT32)(p2), (TI_UINT32)(p3), \
+	                                                 (TI_UINT32)(p4)))
+#define TRACE5(hReport, level, str, p1, p2, p3, p4, p5) \
+	REPORT_TRACE_DO(hReport, level, REPORT_TRACE_MSG(hReport, level, str, 5, (TI_UINT32)(p1), (TI_UINT32)(p2), (TI_UINT32)(p3), \
+	                                                 (TI_UINT32)(p4), (TI_UINT32)(p5)))
+#define TRACE6(hReport, level, str, p1, p2, p3, p4, p5, p6) \
+	REPORT_TRACE_DO(hReport, level, REPORT_TRACE_MSG(hReport, level, str, 6, (TI_UINT32)(p1), (TI_UINT32)(p2), (TI_UINT32)(p3), \
+	                                                 (TI_UINT32)(p4), (TI_UINT32)(p5), (TI_UINT32)(p6)))
+#define TRACE7(hReport, level, str, p1, p2, p3, p4, p5, p6, p7) \
+	REPORT_TRACE_DO(hReport, level, REPORT_TRACE_MSG(hReport, level, str, 7, (TI_UINT32)(p1), (TI_UINT32)(p2), (TI_UINT32)(p3), \
+	                                                 (TI_UINT32)(p4), (TI_UINT32)(p5), (TI_UINT32)(p6), (TI_UINT32)(p7)))
+#define TRACE8(hReport, level, str, p1, p2, p3, p4, p5, p6, p7, p8) \
+	REPORT_TRACE_DO(hReport, level, REPORT_TRACE_MSG(hReport, level, str, 8, (TI_UINT32)(p1), (TI_UINT32)(p2), (TI_UINT32)(p3), \
+	                                                 (TI_UINT32)(p4), (TI_UINT32)(p5), (TI_UINT32)(p6), (TI_UINT32)(p7), (TI_UINT32)(p8)))
+
 #define TRACE_INFO_HEX(hReport, data, datalen) \
-	do { if (hReport && (((TReport *)hReport)->aSeverityTable[REPORT_SEVERITY_INFORMATION]) && (((TReport *)hReport)->aFileEnable[__FILE_ID__])) \
-{ report_PrintDump (data, datalen); } } while(0)
+	REPORT_TRACE_DO(hReport, REPORT_SEVERITY_INFORMATION, report_PrintDump (data, datalen))
 
 
 #else   /* REPORT_LOG */
@@ -399,6 +509,19 @@ variable contained in the report handle*/
 	do { } while (0)
 
 
+#define REPORT_TRACE_DO(hReport, eSeverity, action)                 \
+	do { } while (0)
+
+#define TRACE0(hReport, level, str)                                                 do { } while (0)
+#define TRACE1(hReport, level, str, p1)                                             do { } while (0)
+#define TRACE2(hReport, level, str, p1, p2)                                         do { } while (0)
+#define TRACE3(hReport, level, str, p1, p2, p3)                                     do { } while (0)
+#define TRACE4(hReport, level, str, p1, p2, p3, p4)                                 do { } while (0)
+#define TRACE5(hReport, level, str, p1, p2, p3, p4, p5)                             do { } while (0)
+#define TRACE6(hReport, level, str, p1, p2, p3, p4, p5, p6)                         do { } while (0)
+#define TRACE7(hReport, level, str, p1, p2, p3, p4, p5, p6, p7)                     do { } while (0)
+#define TRACE8(hReport, level, str, p1, p2, p3, p4, p5, p6, p7, p8)                 do { } while (0)
+
 #define TRACE_INFO_HEX(hReport, data, datalen) \
 	do { } while (0)
 
@@ -543,6 +666,36 @@ TI_STATUS report_Dump 					(TI_UINT8 *pBuffer, char *pString, TI_UINT32 size);
  * Performs HEX dump of input Data buffer. Used for debug only!
  */
 TI_STATUS report_PrintDump 				(TI_UINT8 *pData, TI_UINT32 datalen);
+/** \brief Report Trace Point Enabled
+ * \param  hReport   	- Report module object handle
+ * \param  pTracePoint	- Pointer to the site trace point descriptor
+ * \return TI_TRUE if the site should report
+ *
+ * \par Description
+ * Called by TRACEn sites which are enabled or not registered yet. Registers the site on its
+ * first call and sets its state according to the files and severities tables and the site overrides.
+ */
+TI_BOOL report_TracePointEnabled 		(TI_HANDLE hReport, TReportTracePoint *pTracePoint);
+#ifdef TI_DBG
+/** \brief Report Print Trace Points
+ * \param  hReport   	- Report module object handle
+ * \return void
+ *
+ * \par Description
+ * Prints the registered trace points which are enabled and the per site overrides
+ */
+void report_PrintTracePoints 			(TI_HANDLE hReport);
+/** \brief Report Trace Points Benchmark
+ * \param  hReport   	- Report module object handle
+ * \param  uPackets  	- Number of simulated packets (0 for 100000)
+ * \return void
+ *
+ * \par Description
+ * Measures the per packet cost of data path report sites with reporting fully off, at the current
+ * (default) levels, and with the per call files and severities tables lookup used before trace points
+ */
+void report_TracePointBenchmark 		(TI_HANDLE hReport, TI_UINT32 uPackets);
+#endif
 
 /** \brief Sets bRedirectOutputToLogger
 * \param  value  	    - True if to direct output to remote PC
@@ -104,6 +104,11 @@ ifdef CONFIG_WPS
 L_CFLAGS += -DCONFIG_WPS
 endif
 
+# Scan results cache self check (DRIVER scan-cache-check), not in user builds
+ifneq ($(TARGET_BUILD_VARIANT),user)
+L_CFLAGS += -DTI_SCAN_CACHE_CHECK
+endif
+
 ########################
 
 include $(CLEAR_VARS)
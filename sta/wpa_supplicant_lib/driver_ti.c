@@ -39,19 +39,258 @@
 	}
 
 
-static struct wpa_scan_res **prev_results;
-static int prev_num;
+/* The scan cache check is built by the Android.mk in non-user builds, and in any TI_DBG build */
+#if defined(TI_DBG) && !defined(TI_SCAN_CACHE_CHECK)
+#define TI_SCAN_CACHE_CHECK
+#endif
+
+#ifdef TI_SCAN_CACHE_CHECK
+static unsigned int scan_cache_allocs;	/* Allocations done for scan results (debug) */
+#define SCAN_CACHE_COUNT_ALLOC()	(scan_cache_allocs++)
+#else
+#define SCAN_CACHE_COUNT_ALLOC()
+#endif
+
+/*-----------------------------------------------------------------------------
+Scan results cache
+The results of previous scans are kept once per BSSID and sorted by level, so
+results of a specific SSID scan can be completed with the other BSSs. Results
+are merged in place: an entry is reallocated only if its IEs grew, and moved
+in the sorted array only if its level changed. A BSS is dropped after it was
+missed by more than TI_SCAN_CACHE_MAX_AGE full scans.
+-----------------------------------------------------------------------------*/
+static inline int scan_cache_hash(const u8 *bssid)
+{
+	return (bssid[4] ^ bssid[5]) & (TI_SCAN_CACHE_HASH_SIZE - 1);
+}
+
+static struct ti_scan_res_entry *scan_cache_find(struct ti_scan_cache *cache,
+						  const u8 *bssid)
+{
+	struct ti_scan_res_entry *entry;
+
+	for (entry = cache->hash[scan_cache_hash(bssid)]; entry; entry = entry->next) {
+		if (os_memcmp(entry->res.bssid, bssid, ETH_ALEN) == 0)
+			return entry;
+	}
+	return NULL;
+}
+
+/* Returns the position of a new entry with the given level in the sorted array */
+static int scan_cache_sorted_pos(struct ti_scan_res_entry **sorted, int num,
+				 int level)
+{
+	int low = 0, high = num;
+
+	while (low < high) {
+		int mid = (low + high) / 2;
+
+		if (sorted[mid]->res.level >= level)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	return low;
+}
+
+static void scan_cache_sorted_remove(struct ti_scan_cache *cache,
+				     struct ti_scan_res_entry *entry)
+{
+	int i;
+
+	for (i = 0; cache->sorted[i] != entry; i++)
+		;
+	os_memmove(&cache->sorted[i], &cache->sorted[i + 1],
+		   (cache->num - i - 1) * sizeof(cache->sorted[0]));
+	cache->num--;
+}
+
+static void scan_cache_sorted_insert(struct ti_scan_cache *cache,
+				     struct ti_scan_res_entry *entry)
+{
+	int i = scan_cache_sorted_pos(cache->sorted, cache->num, entry->res.level);
+
+	os_memmove(&cache->sorted[i + 1], &cache->sorted[i],
+		   (cache->num - i) * sizeof(cache->sorted[0]));
+	cache->sorted[i] = entry;
+	cache->num++;
+}
+
+static void scan_cache_remove(struct ti_scan_cache *cache,
+			      struct ti_scan_res_entry *entry)
+{
+	struct ti_scan_res_entry **prev = &cache->hash[scan_cache_hash(entry->res.bssid)];
+
+	while (*prev != entry)
+		prev = &(*prev)->next;
+	*prev = entry->next;
+	scan_cache_sorted_remove(cache, entry);
+	os_free(entry);
+}
+
+static int scan_cache_insert(struct ti_scan_cache *cache,
+			     struct ti_scan_res_entry *entry)
+{
+	int bucket = scan_cache_hash(entry->res.bssid);
+
+	if (cache->num == cache->size) {
+		int size = cache->size ? cache->size * 2 : TI_SCAN_CACHE_HASH_SIZE;
+		struct ti_scan_res_entry **sorted;
+
+		sorted = os_realloc(cache->sorted, size * sizeof(cache->sorted[0]));
+		SCAN_CACHE_COUNT_ALLOC();
+		if (!sorted)
+			return -1;
+		cache->sorted = sorted;
+		cache->size = size;
+	}
+	entry->next = cache->hash[bucket];
+	cache->hash[bucket] = entry;
+	scan_cache_sorted_insert(cache, entry);
+	return 0;
+}
+
+/* Inserts or updates the cache entry of a scan result */
+static int scan_cache_update(struct ti_scan_cache *cache, struct wpa_scan_res *res)
+{
+	struct ti_scan_res_entry *entry = scan_cache_find(cache, res->bssid);
+
+	if (!entry || entry->ie_size < res->ie_len) {
+		struct ti_scan_res_entry *new_entry;
+
+		/* The stale entry is dropped even if the new one can't be allocated */
+		if (entry)
+			scan_cache_remove(cache, entry);
+		new_entry = os_malloc(sizeof(*new_entry) + res->ie_len);
+		SCAN_CACHE_COUNT_ALLOC();
+		if (!new_entry)
+			return -1;
+		new_entry->ie_size = res->ie_len;
+		os_memcpy(&new_entry->res, res, sizeof(*res) + res->ie_len);
+		if (scan_cache_insert(cache, new_entry) < 0) {
+			os_free(new_entry);
+			return -1;
+		}
+		entry = new_entry;
+	} else if (entry->res.level != res->level) {
+		scan_cache_sorted_remove(cache, entry);
+		os_memcpy(&entry->res, res, sizeof(*res) + res->ie_len);
+		scan_cache_sorted_insert(cache, entry);
+	} else {
+		os_memcpy(&entry->res, res, sizeof(*res) + res->ie_len);
+	}
 
-static inline int copy_res(struct wpa_scan_res **dst,
-			   struct wpa_scan_res **src,
-			   int num)
+	entry->scan_id = cache->scan_id;
+	entry->age = 0;
+	return 0;
+}
+
+/* Ages the entries missed by the last (full) scan */
+static void scan_cache_age(struct ti_scan_cache *cache)
+{
+	int i;
+
+	for (i = cache->num - 1; i >= 0; i--) {
+		struct ti_scan_res_entry *entry = cache->sorted[i];
+
+		if ((entry->scan_id != cache->scan_id) &&
+		    (++entry->age > TI_SCAN_CACHE_MAX_AGE))
+			scan_cache_remove(cache, entry);
+	}
+}
+
+/*
+ * Completes the results of the last (specific) scan with copies of the cached
+ * BSSs it missed, and sorts them by level. The cached BSSs are appended in
+ * level order, then the new results are inserted one by one.
+ */
+static int scan_cache_merge(struct ti_scan_cache *cache, struct wpa_scan_results *res)
+{
+	struct wpa_scan_res **tmp;
+	int i, num_old = 0, num = res->num;
+
+	for (i = 0; i < cache->num; i++) {
+		if (cache->sorted[i]->scan_id != cache->scan_id)
+			num_old++;
+	}
+
+	if (num_old) {
+		tmp = os_realloc(res->res, (res->num + num_old) * sizeof(struct wpa_scan_res *));
+		SCAN_CACHE_COUNT_ALLOC();
+		if (!tmp)
+			return -1;
+		res->res = tmp;
+
+		for (i = 0; i < cache->num; i++) {
+			struct ti_scan_res_entry *entry = cache->sorted[i];
+
+			if (entry->scan_id == cache->scan_id)
+				continue;
+			tmp[num] = os_malloc(sizeof(entry->res) + entry->res.ie_len);
+			SCAN_CACHE_COUNT_ALLOC();
+			if (!tmp[num]) {
+				while (num > (int)res->num)
+					os_free(tmp[--num]);
+				return -1;
+			}
+			os_memcpy(tmp[num], &entry->res, sizeof(entry->res) + entry->res.ie_len);
+			num++;
+		}
+	}
+
+	/* tmp[i + 1 .. num) is sorted, insert the new result before it */
+	for (i = res->num - 1; i >= 0; i--) {
+		struct wpa_scan_res *new_res = res->res[i];
+		int pos = i + 1;
+
+		while ((pos < num) && (res->res[pos]->level >= new_res->level))
+			pos++;
+		os_memmove(&res->res[i], &res->res[i + 1],
+			   (pos - i - 1) * sizeof(struct wpa_scan_res *));
+		res->res[pos - 1] = new_res;
+	}
+
+	res->num = num;
+	return num_old;
+}
+
+static void scan_cache_flush(struct ti_scan_cache *cache)
+{
+	int i;
+
+	for (i = 0; i < cache->num; i++)
+		os_free(cache->sorted[i]);
+	os_free(cache->sorted);
+	os_memset(cache, 0, sizeof(*cache));
+}
+
+#ifdef TI_SCAN_CACHE_CHECK
+/*-----------------------------------------------------------------------------
+Scan results cache check
+Feeds synthetic scan results to the scan results cache and to the previous
+implementation (copy of the last full scan results, merged by reallocating and
+sorting), and compares the merged results and the number of allocations.
+-----------------------------------------------------------------------------*/
+#define SCAN_CHECK_NUM_BSS	64
+#define SCAN_CHECK_ROUNDS	50
+#define SCAN_CHECK_MAX_IES	200
+
+static int scan_ref_compare(const void *a, const void *b)
+{
+	const struct wpa_scan_res **wa = (const struct wpa_scan_res **)a;
+	const struct wpa_scan_res **wb = (const struct wpa_scan_res **)b;
+
+	return( (*wb)->level - (*wa)->level );
+}
+
+static int scan_ref_copy(struct wpa_scan_res **dst, struct wpa_scan_res **src, int num)
 {
 	int i;
 
 	for (i = 0; i < num; i++) {
 		dst[i] = os_malloc(sizeof(src[i][0]) + src[i]->ie_len);
+		SCAN_CACHE_COUNT_ALLOC();
 		if (!dst[i]) {
-			/* clean up and return error */
 			int j;
 			for (j = 0; j < i; j++)
 				os_free(dst[j]);
@@ -62,16 +301,213 @@ static inline int copy_res(struct wpa_scan_res **dst,
 	return 0;
 }
 
-static inline void free_res(struct wpa_scan_res **res, int num)
+static void scan_ref_free(struct wpa_scan_res **res, int num)
 {
 	int i;
 
 	for (i = 0; i < num; i++)
 		os_free(res[i]);
-
 	os_free(res);
 }
 
+/* The previous merging of the scan results */
+static void scan_ref_get(struct wpa_scan_results *res, int specific_scan,
+			 struct wpa_scan_res ***prev_results, int *prev_num)
+{
+	if (specific_scan && *prev_results) {
+		struct wpa_scan_res **tmp = os_realloc(res->res,
+				(res->num + *prev_num) * sizeof(struct wpa_scan_res *));
+		SCAN_CACHE_COUNT_ALLOC();
+		if (tmp && !scan_ref_copy(&tmp[res->num], *prev_results, *prev_num)) {
+			res->num += *prev_num;
+			qsort(tmp, res->num, sizeof(struct wpa_scan_res *), scan_ref_compare);
+		}
+		if (tmp)
+			res->res = tmp;
+	}
+
+	if (!specific_scan) {
+		if (*prev_results)
+			scan_ref_free(*prev_results, *prev_num);
+		*prev_num = 0;
+		*prev_results = os_malloc(sizeof(**prev_results) * res->num);
+		SCAN_CACHE_COUNT_ALLOC();
+		if (*prev_results) {
+			if (scan_ref_copy(*prev_results, res->res, res->num) < 0) {
+				os_free(*prev_results);
+				*prev_results = NULL;
+			} else
+				*prev_num = res->num;
+		}
+	}
+}
+
+static u32 scan_check_rand(u32 *seed)
+{
+	*seed = (*seed * 1664525) + 1013904223;
+	return *seed >> 8;
+}
+
+static void scan_check_free(struct wpa_scan_results *res)
+{
+	if (res) {
+		scan_ref_free(res->res, res->num);
+		os_free(res);
+	}
+}
+
+/* Builds scan results of the BSSs set in the mask, the way driver_wext returns them */
+static struct wpa_scan_results *scan_check_build(struct wpa_scan_res **pool, const u8 *mask)
+{
+	struct wpa_scan_results *res = os_zalloc(sizeof(*res));
+	int i;
+
+	if (!res)
+		return NULL;
+	res->res = os_zalloc(SCAN_CHECK_NUM_BSS * sizeof(struct wpa_scan_res *));
+	if (!res->res) {
+		os_free(res);
+		return NULL;
+	}
+	for (i = 0; i < SCAN_CHECK_NUM_BSS; i++) {
+		if (!mask[i])
+			continue;
+		res->res[res->num] = os_malloc(sizeof(*pool[i]) + pool[i]->ie_len);
+		if (!res->res[res->num]) {
+			scan_check_free(res);
+			return NULL;
+		}
+		os_memcpy(res->res[res->num], pool[i], sizeof(*pool[i]) + pool[i]->ie_len);
+		res->num++;
+	}
+	return res;
+}
+
+/*
+ * Checks the merged results against the previous implementation. Its old copies of BSSs
+ * found again by the specific scan are skipped, and the cache may add BSSs missed by the
+ * last full scan, which are not dropped yet.
+ */
+static int scan_check_compare(struct wpa_scan_results *res, struct wpa_scan_results *ref,
+			      struct ti_scan_cache *cache, const u8 *mask,
+			      struct wpa_scan_res **pool)
+{
+	size_t i, j, num_ref = 0, num_aged = 0;
+	struct ti_scan_res_entry *entry;
+
+	for (i = 0; i < res->num; i++) {
+		if ((i > 0) && (res->res[i]->level > res->res[i - 1]->level))
+			return -1;
+		entry = scan_cache_find(cache, res->res[i]->bssid);
+		if (entry && (entry->age > 0))
+			num_aged++;
+	}
+	for (j = 0; j < ref->num; j++) {
+		int bss = ref->res[j]->bssid[5];
+
+		if (mask[bss] && ((ref->res[j]->ie_len != pool[bss]->ie_len) ||
+				  os_memcmp(ref->res[j], pool[bss], sizeof(*pool[bss]) + pool[bss]->ie_len)))
+			continue;
+		num_ref++;
+		for (i = 0; i < res->num; i++) {
+			if (os_memcmp(res->res[i]->bssid, ref->res[j]->bssid, ETH_ALEN) == 0)
+				break;
+		}
+		if ((i == res->num) || (res->res[i]->ie_len != ref->res[j]->ie_len) ||
+		    os_memcmp(res->res[i], ref->res[j], sizeof(*res->res[i]) + res->res[i]->ie_len))
+			return -1;
+	}
+	return (num_ref + num_aged == res->num) ? 0 : -1;
+}
+
+static int wpa_driver_tista_scan_cache_check(char *buf, size_t buf_len)
+{
+	struct ti_scan_cache cache;
+	struct wpa_scan_res *pool[SCAN_CHECK_NUM_BSS];
+	struct wpa_scan_res **prev_results = NULL;
+	struct wpa_scan_results *res, *ref;
+	u8 mask[SCAN_CHECK_NUM_BSS];
+	unsigned int cache_allocs = 0, ref_allocs = 0;
+	int prev_num = 0, round, specific, i, mismatches = 0, failures = 0;
+	u32 seed = 1;
+
+	os_memset(&cache, 0, sizeof(cache));
+	for (i = 0; i < SCAN_CHECK_NUM_BSS; i++) {
+		pool[i] = os_zalloc(sizeof(*pool[i]) + SCAN_CHECK_MAX_IES);
+		if (!pool[i]) {
+			while (i > 0)
+				os_free(pool[--i]);
+			return -1;
+		}
+		pool[i]->bssid[0] = 0x02;
+		pool[i]->bssid[5] = (u8)i;
+		pool[i]->freq = 2412 + 5 * (i % 11);
+		pool[i]->beacon_int = 100;
+	}
+
+	for (round = 0; round < SCAN_CHECK_ROUNDS * 2; round++) {
+		specific = round & 1;
+
+		/* A full scan finds most BSSs, a specific scan finds up to 3 */
+		for (i = 0; i < SCAN_CHECK_NUM_BSS; i++) {
+			mask[i] = specific ? ((scan_check_rand(&seed) % SCAN_CHECK_NUM_BSS) < 3) :
+				  ((scan_check_rand(&seed) % 8) != 0);
+			if (mask[i]) {
+				pool[i]->level = -30 - (int)(scan_check_rand(&seed) % 64);
+				/* the IEs of a BSS rarely change size */
+				if ((pool[i]->ie_len == 0) || ((scan_check_rand(&seed) % 8) == 0))
+					pool[i]->ie_len = 20 + scan_check_rand(&seed) % (SCAN_CHECK_MAX_IES - 20);
+				os_memset(pool[i] + 1, round, pool[i]->ie_len);
+			}
+		}
+
+		res = scan_check_build(pool, mask);
+		ref = scan_check_build(pool, mask);
+		if (!res || !ref) {
+			scan_check_free(res);
+			scan_check_free(ref);
+			failures++;
+			break;
+		}
+
+		scan_cache_allocs = 0;
+		scan_ref_get(ref, specific, &prev_results, &prev_num);
+		ref_allocs += scan_cache_allocs;
+
+		scan_cache_allocs = 0;
+		cache.scan_id++;
+		for (i = 0; i < (int)res->num; i++) {
+			if (scan_cache_update(&cache, res->res[i]) < 0)
+				failures++;
+		}
+		if (specific) {
+			if (scan_cache_merge(&cache, res) < 0)
+				failures++;
+		} else {
+			scan_cache_age(&cache);
+		}
+		cache_allocs += scan_cache_allocs;
+
+		if (specific && scan_check_compare(res, ref, &cache, mask, pool))
+			mismatches++;
+
+		scan_check_free(res);
+		scan_check_free(ref);
+	}
+
+	if (prev_results)
+		scan_ref_free(prev_results, prev_num);
+	scan_cache_flush(&cache);
+	for (i = 0; i < SCAN_CHECK_NUM_BSS; i++)
+		os_free(pool[i]);
+
+	wpa_printf(MSG_INFO, "Scan cache check: %d mismatches, %d failures, "
+		   "%u allocations (previous implementation %u)",
+		   mismatches, failures, cache_allocs, ref_allocs);
+	return snprintf(buf, buf_len, "ScanCacheCheck: mismatches %d allocations %u previous %u\n",
+			mismatches + failures, cache_allocs, ref_allocs);
+}
+#endif /* TI_SCAN_CACHE_CHECK */
 
 /*-----------------------------------------------------------------------------
 Routine Name: check_and_get_build_channels
@@ -190,6 +626,47 @@ static int wpa_driver_tista_private_send( void *priv, u32 ioctl_cmd, void *bufIn
 	return 0;
 }
 
+/*-----------------------------------------------------------------------------
+Routine Name: wpa_driver_tista_private_batch
+Routine Description: Send several private commands to the driver in one ioctl.
+  The driver executes them in order and returns a status per entry.
+
+Arguments:
+   priv - pointer to private data structure
+   entries - commands array, updated with the status of each command
+   num - number of commands (up to PRIVATE_CMD_BATCH_MAX)
+Return Value: 0 if all commands succeeded, -1 otherwise.
+-----------------------------------------------------------------------------*/
+static int wpa_driver_tista_private_batch( void *priv, ti_private_cmd_batch_entry_t *entries, u32 num )
+{
+	u32 i;
+
+	if (0 != wpa_driver_tista_private_send(priv, DRIVER_BATCH_PARAM,
+	                                       entries, num * sizeof(ti_private_cmd_batch_entry_t),
+	                                       entries, num * sizeof(ti_private_cmd_batch_entry_t)))
+		return -1;
+
+	for (i = 0; i < num; i++) {
+		if (entries[i].status != 0) {
+			wpa_printf(MSG_ERROR, "ERROR - batched command %x failed (status = %d)",
+			           entries[i].cmd.cmd, entries[i].status);
+			return -1;
+		}
+	}
+	return 0;
+}
+
+static void batch_add_get( ti_private_cmd_batch_entry_t *entries, u32 *num, u32 ioctl_cmd, void *bufOut, u32 sizeOut )
+{
+	ti_private_cmd_batch_entry_t *entry = &entries[(*num)++];
+
+	os_memset(entry, 0, sizeof(*entry));
+	entry->cmd.cmd = ioctl_cmd;
+	entry->cmd.flags = PRIVATE_CMD_GET_FLAG;
+	entry->cmd.out_buffer = bufOut;
+	entry->cmd.out_buffer_len = sizeOut;
+}
+
 /*-----------------------------------------------------------------------------
 Routine Name: check_driver_hang
 Routine Description: Check if driver is alive by sending a command to it. This
@@ -725,6 +1202,25 @@ static int wpa_driver_tista_driver_cmd( void *priv, char *cmd, char *buf, size_t
 		drv->link_speed = wpa_s->link_speed / 1000000;
 		ret = sprintf(buf,"LinkSpeed %u\n", drv->link_speed);
 		wpa_printf(MSG_DEBUG, "buf %s", buf);
+	} else if ( os_strcasecmp(cmd, "stats") == 0 ) {
+		ti_private_cmd_batch_entry_t entries[4];
+		TIWLN_COUNTERS counters;
+		u32 num = 0, power_mode = 0;
+		u8 tx_rate = 0, rx_rate = 0;
+
+		wpa_printf(MSG_DEBUG,"Statistics command");
+		batch_add_get(entries, &num, TIWLN_802_11_CURRENT_RATES_GET, &tx_rate, sizeof(tx_rate));
+		batch_add_get(entries, &num, TIWLN_GET_RX_DATA_RATE, &rx_rate, sizeof(rx_rate));
+		batch_add_get(entries, &num, TIWLN_802_11_POWER_MODE_GET, &power_mode, sizeof(power_mode));
+		batch_add_get(entries, &num, SITE_MGR_TI_WLAN_COUNTERS_PARAM, &counters, sizeof(counters));
+		if (0 == wpa_driver_tista_private_batch(priv, entries, num)) {
+			ret = snprintf(buf, buf_len, "TxRate %u RxRate %u PowerMode %u RecvOk %u RecvError %u "
+			               "FcsErrors %u BeaconsRecv %u\n", tx_rate, rx_rate, power_mode,
+			               counters.RecvOk, counters.RecvError, counters.FcsErrors, counters.BeaconsRecv);
+			if (ret >= (int)buf_len)
+				ret = -1;
+			wpa_printf(MSG_DEBUG, "buf %s", buf);
+		}
 	} else if ( os_strncasecmp(cmd, "scan-channels", 13) == 0 ) {
 		if (os_strlen(cmd) == 13) {
 			wpa_printf(MSG_INFO, "Get Scan Channels command");
@@ -859,6 +1355,11 @@ static int wpa_driver_tista_driver_cmd( void *priv, char *cmd, char *buf, size_t
 				}
 			}
 		}
+#ifdef TI_SCAN_CACHE_CHECK
+	} else if ( os_strcasecmp(cmd, "scan-cache-check") == 0 ) {
+		wpa_printf(MSG_DEBUG,"Scan Cache Check command");
+		ret = wpa_driver_tista_scan_cache_check(buf, buf_len);
+#endif
 	} else {
 		wpa_printf(MSG_DEBUG,"Unsupported command");
 	}
@@ -1009,8 +1510,7 @@ void wpa_driver_tista_deinit(void *priv)
 {
 	struct wpa_driver_ti_data *drv = priv;
 
-	if (prev_results)
-		free_res(prev_results, prev_num);
+	scan_cache_flush(&drv->scan_cache);
 
 	eloop_cancel_timeout(wpa_driver_wext_scan_timeout, drv, drv->ctx);
 	wpa_driver_wext_deinit(drv->wext);
@@ -1252,19 +1752,10 @@ static int wpa_driver_tista_set_gen_ie(void *priv, const u8 *ie, size_t ie_len)
 	return ret;
 }
 
-static int wpa_driver_tista_scan_res_compare(const void *a, const void *b)
-{
-	const struct wpa_scan_res **wa = a;
-	const struct wpa_scan_res **wb = b;
-
-	return( (*wb)->level - (*wa)->level );
-}
-
 static struct wpa_scan_results *wpa_driver_tista_get_scan_results(void *priv) {
 	struct wpa_driver_ti_data *drv = priv;
 	struct wpa_scan_results *res;
-	struct wpa_scan_res **tmp;
-	unsigned ap_num;
+	size_t i;
 
 	TI_CHECK_DRIVER( drv->driver_is_loaded, NULL );
 	res = wpa_driver_wext_get_scan_results(drv->wext);
@@ -1272,38 +1763,26 @@ static struct wpa_scan_results *wpa_driver_tista_get_scan_results(void *priv) {
 	if (res == NULL)
 		return NULL;
 
-	wpa_printf(MSG_DEBUG, "specific scan %d", drv->specific_scan);
-	if (drv->specific_scan && prev_results) {
-		struct wpa_scan_res **tmp = os_realloc(res->res,
-                         (res->num + prev_num) * sizeof(struct wpa_scan_res *));
-		if (tmp &&
-		    !copy_res(&tmp[res->num], prev_results, prev_num)) {
-			wpa_printf(MSG_DEBUG, "merged %d new with %d old",
-				res->num, prev_num);
-			res->num += prev_num;
-			qsort(tmp, res->num, sizeof(struct wpa_scan_res *),
-			      wpa_driver_tista_scan_res_compare);
-			res->res = tmp;
-		} else
+	/* Update the cache with the new results */
+	drv->scan_cache.scan_id++;
+	for (i = 0; i < res->num; i++) {
+		if (scan_cache_update(&drv->scan_cache, res->res[i]) < 0)
 			wpa_printf(MSG_INFO, "couldn't allocate memory "
-				"for merged results");
+				"to save scan results");
 	}
 
-	if (!drv->specific_scan) {
-		if (prev_results)
-			free_res(prev_results, prev_num);
-		prev_results = os_malloc(sizeof(*prev_results) * res->num);
-		if (prev_results) {
-			if (copy_res(prev_results, res->res, res->num) < 0) {
-				os_free(prev_results);
-				prev_results = NULL;
-			} else
-				prev_num = res->num;
-		} else {
-			prev_num = 0;
+	wpa_printf(MSG_DEBUG, "specific scan %d", drv->specific_scan);
+	if (drv->specific_scan) {
+		int num_old = scan_cache_merge(&drv->scan_cache, res);
+
+		if (num_old >= 0)
+			wpa_printf(MSG_DEBUG, "merged %d new with %d old",
+				res->num - num_old, num_old);
+		else
 			wpa_printf(MSG_INFO, "couldn't allocate memory "
-				"to save scan results");
-		}
+				"for merged results");
+	} else {
+		scan_cache_age(&drv->scan_cache);
 	}
 
 	wpa_printf(MSG_DEBUG, "got %d scan results for type %d",
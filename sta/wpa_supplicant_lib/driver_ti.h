@@ -47,12 +47,33 @@
 
 #define MAX_NUMBER_SEQUENTIAL_ERRORS	4
 
+#define TI_SCAN_CACHE_HASH_SIZE		32	/* Number of BSSID hash buckets (power of 2) */
+#define TI_SCAN_CACHE_MAX_AGE		1	/* Number of full scans a BSS may be missed by before it is dropped */
+
 typedef enum {
 	BLUETOOTH_COEXISTENCE_MODE_ENABLED = 0,
 	BLUETOOTH_COEXISTENCE_MODE_DISABLED,
 	BLUETOOTH_COEXISTENCE_MODE_SENSE
 } EUIBTCoexMode;
 
+/* Scan results cache entry, holding the last result of a BSS */
+struct ti_scan_res_entry {
+	struct ti_scan_res_entry *next;	/* Next entry in the BSSID hash bucket */
+	unsigned int scan_id;		/* Last scan the BSS was seen by */
+	int age;			/* Number of full scans the BSS was missed by */
+	size_t ie_size;			/* Room allocated for the IEs */
+	struct wpa_scan_res res;	/* Must be last: the IEs follow it */
+};
+
+/* Scan results cache, keyed by BSSID and sorted by level */
+struct ti_scan_cache {
+	struct ti_scan_res_entry *hash[TI_SCAN_CACHE_HASH_SIZE];
+	struct ti_scan_res_entry **sorted;	/* Entries in descending level order */
+	int num;				/* Number of entries */
+	int size;				/* Allocated size of the sorted array */
+	unsigned int scan_id;			/* Id of the last scan merged */
+};
+
 struct wpa_driver_ti_data {
 	void *wext; /* private data for driver_wext */
 	void *ctx;
@@ -70,5 +91,6 @@ struct wpa_driver_ti_data {
 #endif
 	int errors;			/* Number of sequential errors */
 	int specific_scan;		/* Scan for specific AP? */
+	struct ti_scan_cache scan_cache;	/* Results of previous scans */
 };
 #endif